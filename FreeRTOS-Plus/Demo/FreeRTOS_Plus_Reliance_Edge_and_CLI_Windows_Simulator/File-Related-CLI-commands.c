@@ -184,6 +184,16 @@ static BaseType_t prvTESTFSCommand( char * pcWriteBuffer,
                                     size_t xWriteBufferLen,
                                     const char * pcCommandString );
 
+#if REDCONF_STATISTICS == 1
+
+/*
+ * Implements the STATS command.
+ */
+    static BaseType_t prvSTATSCommand( char * pcWriteBuffer,
+                                       size_t xWriteBufferLen,
+                                       const char * pcCommandString );
+#endif
+
 
 /* Structure that defines the DIR command line command, which lists all the
  * files in the current directory. */
@@ -352,6 +362,20 @@ static const CLI_Command_Definition_t xTEST_FS =
     0                 /* No parameters are expected. */
 };
 
+#if REDCONF_STATISTICS == 1
+
+/* Structure that defines the STATS command line command, which shows the
+ * file system statistics.  REDCONF_STATISTICS is set in the project's
+ * preprocessor definitions, since redconf.h is generated. */
+    static const CLI_Command_Definition_t xSTATS =
+    {
+        "stats",         /* The command string to type. */
+        "\r\nstats:\r\n Show file system call latencies, cache and disk statistics\r\n",
+        prvSTATSCommand, /* The function to run. */
+        0                /* No parameters are expected. */
+    };
+#endif
+
 /*-----------------------------------------------------------*/
 
 void vRegisterFileSystemCLICommands( void )
@@ -374,6 +398,10 @@ void vRegisterFileSystemCLICommands( void )
     FreeRTOS_CLIRegisterCommand( &xTRANSMASKSET );
     FreeRTOS_CLIRegisterCommand( &xABORT );
     FreeRTOS_CLIRegisterCommand( &xTEST_FS );
+
+    #if REDCONF_STATISTICS == 1
+        FreeRTOS_CLIRegisterCommand( &xSTATS );
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -1541,6 +1569,117 @@ static BaseType_t prvTESTFSCommand( char * pcWriteBuffer,
 }
 /*-----------------------------------------------------------*/
 
+#if REDCONF_STATISTICS == 1
+    static BaseType_t prvSTATSCommand( char * pcWriteBuffer,
+                                       size_t xWriteBufferLen,
+                                       const char * pcCommandString )
+    {
+        static const char * const pcOpNames[ RED_STATOP_COUNT ] =
+        {
+            "mount", "umount",  "format",    "transact", "statvfs", "open",    "unlink",
+            "mkdir", "rmdir",   "rename",    "link",     "close",   "read",    "write",
+            "fsync", "lseek",   "ftruncate", "fstat",    "opendir", "readdir", "closedir",
+            "fallocate"
+        };
+        static REDSTATS xStats;
+        static UBaseType_t uxLine = 0;
+        const REDLATSTAT * pxLat = NULL;
+        const char * pcName = NULL;
+        BaseType_t xReturn = pdTRUE;
+        size_t xLen;
+        UBaseType_t uxBucket;
+
+        /* Avoid compiler warnings. */
+        ( void ) pcCommandString;
+
+        /* Ensure the buffer leaves space for the \r\n. */
+        configASSERT( xWriteBufferLen > ( strlen( cliNEW_LINE ) * 2 ) );
+        xWriteBufferLen -= strlen( cliNEW_LINE );
+
+        if( uxLine == 0 )
+        {
+            /* This is the first time this function has been executed since the
+             * stats command was run.  Take a snapshot of the statistics, then
+             * print one line at a time. */
+            if( red_getstats( &xStats, pdFALSE ) == -1 )
+            {
+                snprintf( pcWriteBuffer, xWriteBufferLen, "Error %d querying statistics.", ( int ) red_errno );
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                snprintf( pcWriteBuffer, xWriteBufferLen,
+                          "Disk: %lu reads (%lu KB), %lu writes (%lu KB), %lu flushes, %lu discards (%lu KB)\r\n"
+                          "Cache: meta %lu hits %lu misses, data %lu hits %lu misses, %lu evictions, %lu read ahead\r\n"
+                          "Mount: last took %lu us, %lu mounts loaded the saved allocation summary",
+                          ( unsigned long ) xStats.io.ulReads, ( unsigned long ) ( xStats.io.ullReadBytes >> 10 ),
+                          ( unsigned long ) xStats.io.ulWrites, ( unsigned long ) ( xStats.io.ullWriteBytes >> 10 ),
+                          ( unsigned long ) xStats.io.ulFlushes, ( unsigned long ) xStats.io.ulDiscards,
+                          ( unsigned long ) ( xStats.io.ullDiscardBytes >> 10 ),
+                          ( unsigned long ) xStats.buf.ulMetaHits, ( unsigned long ) xStats.buf.ulMetaMisses,
+                          ( unsigned long ) xStats.buf.ulDataHits, ( unsigned long ) xStats.buf.ulDataMisses,
+                          ( unsigned long ) xStats.buf.ulEvictions, ( unsigned long ) xStats.buf.ulReadAheadBlocks,
+                          ( unsigned long ) xStats.ulLastMountUsecs, ( unsigned long ) xStats.ulSummaryMounts );
+                uxLine++;
+            }
+        }
+        else
+        {
+            /* Skip the operations which were never called. */
+            while( ( uxLine <= RED_STATOP_COUNT ) && ( xStats.aOp[ uxLine - 1 ].ulCount == 0 ) )
+            {
+                uxLine++;
+            }
+
+            if( uxLine <= RED_STATOP_COUNT )
+            {
+                pxLat = &xStats.aOp[ uxLine - 1 ];
+                pcName = pcOpNames[ uxLine - 1 ];
+                uxLine++;
+            }
+            else
+            {
+                /* The transaction points are last. */
+                pxLat = &xStats.transact;
+                pcName = "(commit)";
+                uxLine = 0;
+                xReturn = pdFALSE;
+            }
+
+            snprintf( pcWriteBuffer, xWriteBufferLen, "%-9s %lu calls %lu errors, avg %lu us, max %lu us;",
+                      pcName, ( unsigned long ) pxLat->ulCount, ( unsigned long ) pxLat->ulErrors,
+                      ( unsigned long ) ( ( pxLat->ulCount == 0 ) ? 0 : ( pxLat->ullTotalUsecs / pxLat->ulCount ) ),
+                      ( unsigned long ) pxLat->ulMaxUsecs );
+
+            /* Append the nonzero histogram buckets, labelled with the upper
+             * bound of each. */
+            for( uxBucket = 0; uxBucket < RED_STAT_HIST_BUCKETS; uxBucket++ )
+            {
+                if( pxLat->aulHist[ uxBucket ] != 0 )
+                {
+                    xLen = strlen( pcWriteBuffer );
+
+                    if( uxBucket == ( RED_STAT_HIST_BUCKETS - 1 ) )
+                    {
+                        snprintf( &pcWriteBuffer[ xLen ], xWriteBufferLen - xLen, " >=%lu:%lu",
+                                  1UL << ( uxBucket - 1 ), ( unsigned long ) pxLat->aulHist[ uxBucket ] );
+                    }
+                    else
+                    {
+                        snprintf( &pcWriteBuffer[ xLen ], xWriteBufferLen - xLen, " <%lu:%lu",
+                                  1UL << uxBucket, ( unsigned long ) pxLat->aulHist[ uxBucket ] );
+                    }
+                }
+            }
+        }
+
+        strcat( pcWriteBuffer, cliNEW_LINE );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+#endif /* REDCONF_STATISTICS == 1 */
+
 static BaseType_t prvPerformCopy( int32_t lSourceFildes,
                                   int32_t lDestinationFiledes,
                                   char * pxWriteBuffer,
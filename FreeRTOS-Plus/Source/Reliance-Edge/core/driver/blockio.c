@@ -41,6 +41,12 @@
 #include <redcore.h>
 
 
+static REDSTATUS IoRead( uint8_t bVolNum,
+                         uint32_t ulBlockStart,
+                         uint32_t ulBlockCount,
+                         void * pBuffer );
+
+
 /** @brief Read a range of logical blocks.
  *
  *  @param bVolNum      The volume whose block device is being read from.
@@ -59,37 +65,9 @@ REDSTATUS RedIoRead( uint8_t bVolNum,
                      uint32_t ulBlockCount,
                      void * pBuffer )
 {
-    REDSTATUS ret = 0;
+    REDSTATUS ret;
 
-    if( ( bVolNum >= REDCONF_VOLUME_COUNT ) ||
-        ( ulBlockStart >= gaRedVolume[ bVolNum ].ulBlockCount ) ||
-        ( ( gaRedVolume[ bVolNum ].ulBlockCount - ulBlockStart ) < ulBlockCount ) ||
-        ( ulBlockCount == 0U ) ||
-        ( pBuffer == NULL ) )
-    {
-        REDERROR();
-        ret = -RED_EINVAL;
-    }
-    else
-    {
-        uint8_t bSectorShift = gaRedVolume[ bVolNum ].bBlockSectorShift;
-        uint64_t ullSectorStart = ( uint64_t ) ulBlockStart << bSectorShift;
-        uint32_t ulSectorCount = ulBlockCount << bSectorShift;
-        uint8_t bRetryIdx;
-
-        REDASSERT( bSectorShift < 32U );
-        REDASSERT( ( ulSectorCount >> bSectorShift ) == ulBlockCount );
-
-        for( bRetryIdx = 0U; bRetryIdx <= gpRedVolConf->bBlockIoRetries; bRetryIdx++ )
-        {
-            ret = RedOsBDevRead( bVolNum, ullSectorStart, ulSectorCount, pBuffer );
-
-            if( ret == 0 )
-            {
-                break;
-            }
-        }
-    }
+    ret = IoRead( bVolNum, ulBlockStart, ulBlockCount, pBuffer );
 
     CRITICAL_ASSERT( ret == 0 );
 
@@ -97,6 +75,35 @@ REDSTATUS RedIoRead( uint8_t bVolNum,
 }
 
 
+#if REDCONF_READ_AHEAD_BLOCKS > 0U
+
+/** @brief Read a range of logical blocks which nobody has asked for yet.
+ *
+ *  Like RedIoRead(), except that a failure is not a critical error: the blocks
+ *  were only being read ahead, and any error will be reported if and when they
+ *  are actually read.
+ *
+ *  @param bVolNum      The volume whose block device is being read from.
+ *  @param ulBlockStart The first block to read.
+ *  @param ulBlockCount The number of blocks to read.
+ *  @param pBuffer      The buffer to populate with the data read.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EINVAL Invalid parameters.
+ */
+    REDSTATUS RedIoReadAhead( uint8_t bVolNum,
+                              uint32_t ulBlockStart,
+                              uint32_t ulBlockCount,
+                              void * pBuffer )
+    {
+        return IoRead( bVolNum, ulBlockStart, ulBlockCount, pBuffer );
+    }
+#endif /* REDCONF_READ_AHEAD_BLOCKS > 0U */
+
+
 #if REDCONF_READ_ONLY == 0
 
 /** @brief Write a range of logical blocks.
@@ -138,6 +145,10 @@ REDSTATUS RedIoRead( uint8_t bVolNum,
             REDASSERT( bSectorShift < 32U );
             REDASSERT( ( ulSectorCount >> bSectorShift ) == ulBlockCount );
 
+            #if REDCONF_STATISTICS == 1
+                RedStatIo( STATIO_WRITE, ulBlockCount );
+            #endif
+
             for( bRetryIdx = 0U; bRetryIdx <= gpRedVolConf->bBlockIoRetries; bRetryIdx++ )
             {
                 ret = RedOsBDevWrite( bVolNum, ullSectorStart, ulSectorCount, pBuffer );
@@ -179,6 +190,10 @@ REDSTATUS RedIoRead( uint8_t bVolNum,
         {
             uint8_t bRetryIdx;
 
+            #if REDCONF_STATISTICS == 1
+                RedStatIo( STATIO_FLUSH, 0U );
+            #endif
+
             for( bRetryIdx = 0U; bRetryIdx <= gpRedVolConf->bBlockIoRetries; bRetryIdx++ )
             {
                 ret = RedOsBDevFlush( bVolNum );
@@ -195,3 +210,108 @@ REDSTATUS RedIoRead( uint8_t bVolNum,
         return ret;
     }
 #endif /* REDCONF_READ_ONLY == 0 */
+
+
+#if REDCONF_DISCARD_EXTENTS > 0U
+
+/** @brief Tell the block device that a range of logical blocks is unused.
+ *
+ *  Unlike a failed write or flush, a failed discard is not a critical error:
+ *  the blocks simply remain in use as far as the block device knows.
+ *
+ *  @param bVolNum      The volume whose block device is being discarded from.
+ *  @param ulBlockStart The first block to discard.
+ *  @param ulBlockCount The number of blocks to discard.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EINVAL Invalid parameters.
+ */
+    REDSTATUS RedIoDiscard( uint8_t bVolNum,
+                            uint32_t ulBlockStart,
+                            uint32_t ulBlockCount )
+    {
+        REDSTATUS ret;
+
+        if( ( bVolNum >= REDCONF_VOLUME_COUNT ) ||
+            ( ulBlockStart >= gaRedVolume[ bVolNum ].ulBlockCount ) ||
+            ( ( gaRedVolume[ bVolNum ].ulBlockCount - ulBlockStart ) < ulBlockCount ) ||
+            ( ulBlockCount == 0U ) )
+        {
+            REDERROR();
+            ret = -RED_EINVAL;
+        }
+        else
+        {
+            uint8_t bSectorShift = gaRedVolume[ bVolNum ].bBlockSectorShift;
+
+            #if REDCONF_STATISTICS == 1
+                RedStatIo( STATIO_DISCARD, ulBlockCount );
+            #endif
+
+            ret = RedOsBDevDiscard( bVolNum, ( uint64_t ) ulBlockStart << bSectorShift, ulBlockCount << bSectorShift );
+        }
+
+        return ret;
+    }
+#endif /* REDCONF_DISCARD_EXTENTS > 0U */
+
+
+/** @brief Read a range of logical blocks, with retries.
+ *
+ *  @param bVolNum      The volume whose block device is being read from.
+ *  @param ulBlockStart The first block to read.
+ *  @param ulBlockCount The number of blocks to read.
+ *  @param pBuffer      The buffer to populate with the data read.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EINVAL Invalid parameters.
+ */
+static REDSTATUS IoRead( uint8_t bVolNum,
+                         uint32_t ulBlockStart,
+                         uint32_t ulBlockCount,
+                         void * pBuffer )
+{
+    REDSTATUS ret = 0;
+
+    if( ( bVolNum >= REDCONF_VOLUME_COUNT ) ||
+        ( ulBlockStart >= gaRedVolume[ bVolNum ].ulBlockCount ) ||
+        ( ( gaRedVolume[ bVolNum ].ulBlockCount - ulBlockStart ) < ulBlockCount ) ||
+        ( ulBlockCount == 0U ) ||
+        ( pBuffer == NULL ) )
+    {
+        REDERROR();
+        ret = -RED_EINVAL;
+    }
+    else
+    {
+        uint8_t bSectorShift = gaRedVolume[ bVolNum ].bBlockSectorShift;
+        uint64_t ullSectorStart = ( uint64_t ) ulBlockStart << bSectorShift;
+        uint32_t ulSectorCount = ulBlockCount << bSectorShift;
+        uint8_t bRetryIdx;
+
+        REDASSERT( bSectorShift < 32U );
+        REDASSERT( ( ulSectorCount >> bSectorShift ) == ulBlockCount );
+
+        #if REDCONF_STATISTICS == 1
+            RedStatIo( STATIO_READ, ulBlockCount );
+        #endif
+
+        for( bRetryIdx = 0U; bRetryIdx <= gaRedVolConf[ bVolNum ].bBlockIoRetries; bRetryIdx++ )
+        {
+            ret = RedOsBDevRead( bVolNum, ullSectorStart, ulSectorCount, pBuffer );
+
+            if( ret == 0 )
+            {
+                break;
+            }
+        }
+    }
+
+    return ret;
+}
@@ -32,9 +32,13 @@
  *  by both block number and volume number: this cache is shared among all
  *  volumes).  Block buffers may be either dirty or clean.  Most I/O passes
  *  through this module.  When a buffer is needed for a block which is not in
- *  the cache, a "victim" is selected via a simple LRU scheme.
+ *  the cache, a "victim" is selected via the replacement policy configured by
+ *  REDCONF_BUFFER_POLICY: either a simple LRU scheme, or a scan-resistant
+ *  2Q scheme which keeps metadata and frequently used blocks resident while
+ *  large sequential file I/O streams through the cache.
  */
 #include <redfs.h>
+#include <redcoreapi.h>
 #include <redcore.h>
 
 
@@ -92,6 +96,22 @@
     #error "REDCONF_BUFFER_COUNT is too low for the configuration"
 #endif
 
+/*  With fine-grained locking, one operation at a time may wait on an unlocked
+ *  read while holding the buffers of one inode, and another operation must be
+ *  able to run to completion in the meantime.
+ */
+#if ( REDCONF_FINE_LOCKING == 1 ) && ( REDCONF_BUFFER_COUNT < ( MINIMUM_BUFFER_COUNT + INODE_BUFFERS + REDCONF_READ_LEASES ) )
+    #error "REDCONF_BUFFER_COUNT is too low for REDCONF_FINE_LOCKING"
+#endif
+
+/*  A leased buffer is unavailable to other operations until the lease is
+ *  released, so there must be enough buffers left over for any operation even
+ *  when the maximum number of leases are outstanding.
+ */
+#if REDCONF_BUFFER_COUNT < ( MINIMUM_BUFFER_COUNT + REDCONF_READ_LEASES )
+    #error "REDCONF_BUFFER_COUNT is too low for REDCONF_READ_LEASES"
+#endif
+
 
 /*  A note on the typecasts in the below macros: Operands to bitwise operators
  *  are subject to the "usual arithmetic conversions".  This means that the
@@ -103,12 +123,116 @@
 #define BFLAG_META_MASK    ( uint16_t ) ( ( uint32_t ) BFLAG_META_MASTER | BFLAG_META_IMAP | BFLAG_META_INODE | BFLAG_META_INDIR | BFLAG_META_DINDIR )
 #define BFLAG_MASK         ( uint16_t ) ( ( uint32_t ) BFLAG_DIRTY | BFLAG_NEW | BFLAG_META_MASK )
 
+#if REDCONF_FINE_LOCKING == 1
+
+/*  Internal buffer flag, never passed to RedBufferGet(): the block is being
+ *  read into the buffer by an unlocked read, and the buffer contents are not
+ *  yet valid.
+ */
+    #define BFLAG_READING    ( ( uint16_t ) 0x0100U )
+#endif
+
+#if REDCONF_READ_LEASES > 0U
+
+/*  Internal buffer flag, never passed to RedBufferGet(): the buffer is on loan
+ *  to a reader by RedBufferLease().  It is not associated with any block, and
+ *  its single reference belongs to the lease.
+ */
+    #define BFLAG_LEASED    ( ( uint16_t ) 0x0200U )
+#endif
+
 
 /*  An invalid block number.  Used to indicate buffers which are not currently
  *  in use.
  */
 #define BBLK_INVALID    UINT32_MAX
 
+/*  An invalid buffer index.  Used to terminate the MRU list and the hash
+ *  chains.  REDCONF_BUFFER_COUNT is at most 255, so no buffer has this index.
+ */
+#define BIDX_NONE       UINT8_MAX
+
+
+/*  Possible values for REDCONF_BUFFER_POLICY.
+ */
+#define BUFFER_POLICY_LRU    ( 0U )
+#define BUFFER_POLICY_2Q     ( 1U )
+
+#if REDCONF_BUFFER_POLICY == BUFFER_POLICY_LRU
+
+/*  A single list orders every buffer from most to least recently used.
+ */
+    #define BUFFER_LISTS          1U
+#elif REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+
+/*  The 2Q policy (Johnson and Shasha, 1994) keeps two lists.  Blocks which
+ *  have been referenced once enter a short FIFO probation list; blocks which
+ *  are referenced again after they leave it, along with all metadata blocks,
+ *  live in the main LRU list.  A stream of blocks which are each used only
+ *  once thus cycles through the probation list without evicting anything in
+ *  the main list.
+ */
+    #define BUFFER_LISTS          2U
+
+/*  Target size of the probation list.  When the list holds no more than this
+ *  many buffers, victims are taken from the main list instead.
+ */
+    #define BUFFER_2Q_KIN         ( ( REDCONF_BUFFER_COUNT >= 8U ) ? ( REDCONF_BUFFER_COUNT / 4U ) : 1U )
+
+/*  Number of blocks evicted from the probation list which are remembered, so
+ *  that a block which is referenced again soon after it left the cache is
+ *  admitted to the main list.
+ */
+    #define BUFFER_2Q_GHOSTS      ( ( REDCONF_BUFFER_COUNT >= 2U ) ? ( REDCONF_BUFFER_COUNT / 2U ) : 1U )
+#else /* if REDCONF_BUFFER_POLICY == BUFFER_POLICY_LRU */
+    #error "REDCONF_BUFFER_POLICY must be set to BUFFER_POLICY_LRU or BUFFER_POLICY_2Q"
+#endif /* if REDCONF_BUFFER_POLICY == BUFFER_POLICY_LRU */
+
+#define BLIST_MAIN            0U /* The LRU list; the main list with 2Q. */
+#define BLIST_PROBATION       1U /* The 2Q probation list. */
+
+
+/*  Size, in blocks, of the bounce buffer, which is shared by write gathering
+ *  in RedBufferFlush() and by RedBufferReadAhead().
+ */
+#if ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_BUFFER_WRITE_GATHER > 1 ) && ( REDCONF_BUFFER_WRITE_GATHER > REDCONF_READ_AHEAD_BLOCKS )
+    #define BUFFER_BOUNCE_BLOCKS    REDCONF_BUFFER_WRITE_GATHER
+#else
+    #define BUFFER_BOUNCE_BLOCKS    REDCONF_READ_AHEAD_BLOCKS
+#endif
+
+
+/*  Bytes by which the buffer memory is oversized, so that it can be aligned to
+ *  REDCONF_BUFFER_ALIGNMENT: the compiler only guarantees 64-bit alignment.
+ */
+#define BUFFER_ALIGN_SLACK    ( REDCONF_BUFFER_ALIGNMENT - 8U )
+
+/*  Address of block buffer idx, and of block idx within the bounce buffer.
+ */
+#define BUFFER_DATA( idx )    ( &gBufCtx.pbBuffer[ ( uint32_t ) ( idx ) * REDCONF_BLOCK_SIZE ] )
+#define BOUNCE_DATA( idx )    ( &gBufCtx.pbBounce[ ( uint32_t ) ( idx ) * REDCONF_BLOCK_SIZE ] )
+
+
+#if REDCONF_BUFFER_HASH == 1
+
+/*  The number of hash buckets is the smallest power of two which is no less
+ *  than the number of buffers, so that chains are short on average.
+ */
+    #if REDCONF_BUFFER_COUNT <= 16U
+        #define BUFFER_HASH_SHIFT    4U
+    #elif REDCONF_BUFFER_COUNT <= 32U
+        #define BUFFER_HASH_SHIFT    5U
+    #elif REDCONF_BUFFER_COUNT <= 64U
+        #define BUFFER_HASH_SHIFT    6U
+    #elif REDCONF_BUFFER_COUNT <= 128U
+        #define BUFFER_HASH_SHIFT    7U
+    #else
+        #define BUFFER_HASH_SHIFT    8U
+    #endif
+
+    #define BUFFER_HASH_BUCKETS      ( 1U << BUFFER_HASH_SHIFT )
+#endif /* REDCONF_BUFFER_HASH == 1 */
+
 
 /** @brief Metadata stored for each block buffer.
  *
@@ -124,6 +248,31 @@ typedef struct
 } BUFFERHEAD;
 
 
+/** @brief A doubly linked list of buffers, ordered by recency.
+ *
+ *  The links themselves are stored in the abMruNext and abMruPrev arrays of
+ *  the BUFFERCTX structure.
+ */
+typedef struct
+{
+    uint8_t bHead;  /**< Index of the most recently used buffer; BIDX_NONE if empty. */
+    uint8_t bTail;  /**< Index of the least recently used buffer; BIDX_NONE if empty. */
+    uint8_t bCount; /**< Number of buffers on the list. */
+} BUFFERLIST;
+
+
+#if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+
+/** @brief A block recently evicted from the 2Q probation list.
+ */
+    typedef struct
+    {
+        uint32_t ulBlock; /**< Block number; BBLK_INVALID if the entry is unused. */
+        uint8_t bVolNum;  /**< Volume the block resides on. */
+    } BUFFERGHOST;
+#endif
+
+
 /** @brief State information for the block buffer module.
  */
 typedef struct
@@ -132,24 +281,120 @@ typedef struct
      */
     uint16_t uNumUsed;
 
-    /** MRU array.  Each element of the array stores a buffer index; each buffer
-     *  index appears in the array once and only once.  The first element of the
-     *  array is the most-recently-used (MRU) buffer, followed by the next most
-     *  recently used, and so on, till the last element, which is the least-
+    /** MRU lists.  Each buffer appears on one list, once and only once.  The
+     *  head of a list is its most-recently-used (MRU) buffer, followed by the
+     *  next most recently used, and so on, till the tail, which is the least-
      *  recently-used (LRU) buffer.
      */
-    uint8_t abMRU[ REDCONF_BUFFER_COUNT ];
+    BUFFERLIST aList[ BUFFER_LISTS ];
+
+    /** For each buffer, the index of the next less recently used buffer on the
+     *  same list, or BIDX_NONE for the LRU buffer.
+     */
+    uint8_t abMruNext[ REDCONF_BUFFER_COUNT ];
+
+    /** For each buffer, the index of the next more recently used buffer on the
+     *  same list, or BIDX_NONE for the MRU buffer.
+     */
+    uint8_t abMruPrev[ REDCONF_BUFFER_COUNT ];
+
+    #if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+
+        /** For each buffer, which list (BLIST_MAIN or BLIST_PROBATION) it is on.
+         */
+        uint8_t abList[ REDCONF_BUFFER_COUNT ];
+
+        /** Ring of blocks recently evicted from the probation list.
+         */
+        BUFFERGHOST aGhost[ BUFFER_2Q_GHOSTS ];
+
+        /** Index of the aGhost entry to be overwritten next.
+         */
+        uint8_t bGhostNext;
+    #endif
+
+    /** Buffer cache statistics.
+     */
+    REDBUFSTAT stat;
+
+    #if REDCONF_BUFFER_HASH == 1
+
+        /** Hash index of the buffered blocks.  Each bucket stores the index of
+         *  the first buffer in its chain, or BIDX_NONE if the chain is empty.
+         *  Only buffers with a valid block number are linked into a chain.
+         */
+        uint8_t abHashBucket[ BUFFER_HASH_BUCKETS ];
+
+        /** For each buffer, the index of the next buffer in the same hash chain,
+         *  or BIDX_NONE at the end of the chain.
+         */
+        uint8_t abHashNext[ REDCONF_BUFFER_COUNT ];
+    #endif
+
+    #if REDCONF_READ_ONLY == 0
+
+        /** Scratch space for RedBufferFlush(): the indices of the buffers to be
+         *  written, sorted by block number.
+         */
+        uint8_t abFlush[ REDCONF_BUFFER_COUNT ];
+    #endif
+
+    #if REDCONF_FINE_LOCKING == 1
+
+        /** Index of the buffer flagged with BFLAG_READING whose read has not
+         *  been finished by BufferReadFinish(), or BIDX_NONE.
+         */
+        uint8_t bReadIdx;
+
+        /** The BFLAG_META_* flags of the block being read into bReadIdx.
+         */
+        uint16_t uReadFlags;
+
+        /** Result of the read into bReadIdx.  Written without holding the FS
+         *  mutex, and only valid once RED_SEM_IO_DONE has been taken.
+         */
+        REDSTATUS iReadRet;
+    #endif
+
+    #if REDCONF_READ_LEASES > 0U
+
+        /** Number of buffers flagged with BFLAG_LEASED.
+         */
+        uint8_t bNumLeased;
+    #endif
 
     /** Buffer heads, storing metadata for each buffer.
      */
     BUFFERHEAD aHead[ REDCONF_BUFFER_COUNT ];
 
-    /** Array of memory for the block buffers themselves.
+    /** Memory for the block buffers themselves, with enough slack to align
+     *  the first buffer to REDCONF_BUFFER_ALIGNMENT; see pbBuffer.
      *
-     *  Force 64-bit alignment of the aabBuffer array to ensure that it is safe
-     *  to cast buffer pointers to node structure pointers.
+     *  Force 64-bit alignment of the array to ensure that it is safe to cast
+     *  buffer pointers to node structure pointers.
+     */
+    ALIGNED_BYTE_ARRAY( b, ab, ( REDCONF_BUFFER_COUNT * REDCONF_BLOCK_SIZE ) + BUFFER_ALIGN_SLACK );
+
+    /** The first block buffer, aligned to REDCONF_BUFFER_ALIGNMENT within b.ab.
+     *  The other buffers follow it contiguously; see BUFFER_DATA().
      */
-    ALIGNED_2D_BYTE_ARRAY( b, aabBuffer, REDCONF_BUFFER_COUNT, REDCONF_BLOCK_SIZE );
+    uint8_t * pbBuffer;
+
+    #if BUFFER_BOUNCE_BLOCKS > 0U
+
+        /** Bounce buffer into which RedBufferFlush() gathers dirty buffers for
+         *  adjacent blocks which are not adjacent in memory, so that they can
+         *  be written with a single request; and into which RedBufferReadAhead()
+         *  reads adjacent blocks with a single request, before distributing
+         *  them among the buffers.  Aligned like the block buffers.
+         */
+        ALIGNED_BYTE_ARRAY( g, ab, ( BUFFER_BOUNCE_BLOCKS * REDCONF_BLOCK_SIZE ) + BUFFER_ALIGN_SLACK );
+
+        /** The start of the bounce buffer, aligned to REDCONF_BUFFER_ALIGNMENT
+         *  within g.ab; see BOUNCE_DATA().
+         */
+        uint8_t * pbBounce;
+    #endif
 } BUFFERCTX;
 
 
@@ -157,15 +402,58 @@ static bool BufferIsValid( const uint8_t * pbBuffer,
                            uint16_t uFlags );
 static bool BufferToIdx( const void * pBuffer,
                          uint8_t * pbIdx );
+static REDSTATUS BufferRead( uint8_t bIdx,
+                             uint32_t ulBlock,
+                             uint16_t uFlags );
+static REDSTATUS BufferReadVerify( uint8_t bIdx,
+                                   uint16_t uFlags );
+#if REDCONF_FINE_LOCKING == 1
+    static void BufferReadFinish( void );
+    static bool BufferSlotTake( void );
+    static void BufferUnlock( void );
+    static void BufferRelock( uint8_t bVolNum );
+#endif
 #if REDCONF_READ_ONLY == 0
+    static uint8_t BufferFlushRun( uint8_t bPos,
+                                   uint8_t bCount,
+                                   bool * pfContig );
+    static REDSTATUS BufferWriteRun( const uint8_t * pabIdx,
+                                     uint8_t bRunLen,
+                                     bool fContig );
     static REDSTATUS BufferWrite( uint8_t bIdx );
     static REDSTATUS BufferFinalize( uint8_t * pbBuffer,
                                      uint16_t uFlags );
 #endif
 static void BufferMakeLRU( uint8_t bIdx );
 static void BufferMakeMRU( uint8_t bIdx );
+static void BufferPromote( uint8_t bIdx,
+                           bool fHit );
+static uint8_t BufferVictim( void );
+static uint8_t BufferListLastFree( uint8_t bList );
+static void BufferListInsert( uint8_t bIdx,
+                              uint8_t bList,
+                              bool fHead );
+static void BufferListRemove( uint8_t bIdx );
+#if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+    static void BufferGhostAdd( uint8_t bIdx );
+    static bool BufferGhostRemove( uint8_t bVolNum,
+                                   uint32_t ulBlock );
+#endif
+static REDSTATUS BufferEvict( uint8_t bIdx );
+#if REDCONF_READ_LEASES > 0U
+    static REDSTATUS BufferLeaseSpare( const void * pSrc,
+                                       uint8_t * pbIdx );
+#endif
+static REDSTATUS BufferDiscardIdx( uint8_t bIdx );
 static bool BufferFind( uint32_t ulBlock,
                         uint8_t * pbIdx );
+static void BufferSetBlock( uint8_t bIdx,
+                            uint8_t bVolNum,
+                            uint32_t ulBlock );
+#if REDCONF_BUFFER_HASH == 1
+    static uint8_t BufferHash( uint8_t bVolNum,
+                               uint32_t ulBlock );
+#endif
 
 #ifdef REDCONF_ENDIAN_SWAP
     static void BufferEndianSwap( const void * pBuffer,
@@ -180,6 +468,13 @@ static bool BufferFind( uint32_t ulBlock,
 
 static BUFFERCTX gBufCtx;
 
+#if REDCONF_FINE_LOCKING == 1
+
+/*  Whether the operation which holds the FS mutex allows unlocked reads.
+ */
+    static bool gfUnlockedReads;
+#endif
+
 
 /** @brief Initialize the buffers.
  */
@@ -189,13 +484,52 @@ void RedBufferInit( void )
 
     RedMemSet( &gBufCtx, 0U, sizeof( gBufCtx ) );
 
+    /*  Align the buffers so that block device drivers can transfer directly
+     *  to and from them with DMA.
+     */
+    gBufCtx.pbBuffer = &gBufCtx.b.ab[ PTR_ALIGN_PAD( &gBufCtx.b.ab[ 0U ], REDCONF_BUFFER_ALIGNMENT ) ];
+    REDASSERT( PTR_ALIGN_PAD( gBufCtx.pbBuffer, REDCONF_BUFFER_ALIGNMENT ) == 0U );
+
+    #if BUFFER_BOUNCE_BLOCKS > 0U
+        gBufCtx.pbBounce = &gBufCtx.g.ab[ PTR_ALIGN_PAD( &gBufCtx.g.ab[ 0U ], REDCONF_BUFFER_ALIGNMENT ) ];
+    #endif
+
+    for( bIdx = 0U; bIdx < BUFFER_LISTS; bIdx++ )
+    {
+        gBufCtx.aList[ bIdx ].bHead = BIDX_NONE;
+        gBufCtx.aList[ bIdx ].bTail = BIDX_NONE;
+    }
+
+    #if REDCONF_BUFFER_HASH == 1
+        RedMemSet( gBufCtx.abHashBucket, BIDX_NONE, sizeof( gBufCtx.abHashBucket ) );
+    #endif
+
+    #if REDCONF_FINE_LOCKING == 1
+        gBufCtx.bReadIdx = BIDX_NONE;
+    #endif
+
+    #if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+        for( bIdx = 0U; bIdx < BUFFER_2Q_GHOSTS; bIdx++ )
+        {
+            gBufCtx.aGhost[ bIdx ].ulBlock = BBLK_INVALID;
+        }
+    #endif
+
     for( bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++ )
     {
+        gBufCtx.aHead[ bIdx ].ulBlock = BBLK_INVALID;
+
         /*  When the buffers have been freshly initialized, acquire the buffers
-         *  in the order in which they appear in the array.
+         *  in the order in which they appear in the array: each buffer is
+         *  pushed onto the head of a list, leaving buffer zero as LRU.  With
+         *  2Q, unused buffers start on the probation list, from which victims
+         *  are taken first.
          */
-        gBufCtx.abMRU[ bIdx ] = ( uint8_t ) ( ( REDCONF_BUFFER_COUNT - bIdx ) - 1U );
-        gBufCtx.aHead[ bIdx ].ulBlock = BBLK_INVALID;
+        #if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+            BufferListInsert( bIdx, BLIST_PROBATION, true );
+        #else
+            BufferListInsert( bIdx, BLIST_MAIN, true );
+        #endif
     }
 }
 
@@ -219,6 +553,7 @@ REDSTATUS RedBufferGet( uint32_t ulBlock,
 {
     REDSTATUS ret = 0;
     uint8_t bIdx;
+    bool fHit = false;
 
     if( ( ulBlock >= gpRedVolume->ulBlockCount ) || ( ( uFlags & BFLAG_MASK ) != uFlags ) || ( ppBuffer == NULL ) )
     {
@@ -227,8 +562,21 @@ REDSTATUS RedBufferGet( uint32_t ulBlock,
     }
     else
     {
+        #if REDCONF_FINE_LOCKING == 1
+            if( BufferFind( ulBlock, &bIdx ) && ( ( gBufCtx.aHead[ bIdx ].uFlags & BFLAG_READING ) != 0U ) )
+            {
+                /*  Another task is reading the block with the FS mutex
+                 *  released.  Wait for that read to finish; if it failed, the
+                 *  buffer is invalidated, and the block is read again below.
+                 */
+                BufferReadFinish();
+            }
+        #endif
+
         if( BufferFind( ulBlock, &bIdx ) )
         {
+            fHit = true;
+
             /*  Error if the buffer exists and BFLAG_NEW was specified, since
              *  the new flag is used when a block is newly allocated/created, so
              *  the block was previously free and and there should never be an
@@ -243,6 +591,14 @@ REDSTATUS RedBufferGet( uint32_t ulBlock,
                 CRITICAL_ERROR();
                 ret = -RED_EFUBAR;
             }
+            else if( ( uFlags & BFLAG_META ) != 0U )
+            {
+                gBufCtx.stat.ulMetaHits++;
+            }
+            else
+            {
+                gBufCtx.stat.ulDataHits++;
+            }
         }
         else if( gBufCtx.uNumUsed == REDCONF_BUFFER_COUNT )
         {
@@ -254,38 +610,12 @@ REDSTATUS RedBufferGet( uint32_t ulBlock,
         }
         else
         {
-            BUFFERHEAD * pHead;
-
-            /*  Search for the least recently used buffer which is not
-             *  referenced.
+            /*  Select an unreferenced buffer to repurpose, as determined by the
+             *  replacement policy.
              */
-            for( bIdx = ( uint8_t ) ( REDCONF_BUFFER_COUNT - 1U ); bIdx > 0U; bIdx-- )
-            {
-                if( gBufCtx.aHead[ gBufCtx.abMRU[ bIdx ] ].bRefCount == 0U )
-                {
-                    break;
-                }
-            }
-
-            bIdx = gBufCtx.abMRU[ bIdx ];
-            pHead = &gBufCtx.aHead[ bIdx ];
+            bIdx = BufferVictim();
 
-            if( pHead->bRefCount == 0U )
-            {
-                /*  If the LRU buffer is valid and dirty, write it out before
-                 *  repurposing it.
-                 */
-                if( ( ( pHead->uFlags & BFLAG_DIRTY ) != 0U ) && ( pHead->ulBlock != BBLK_INVALID ) )
-                {
-                    #if REDCONF_READ_ONLY == 1
-                        CRITICAL_ERROR();
-                        ret = -RED_EFUBAR;
-                    #else
-                        ret = BufferWrite( bIdx );
-                    #endif
-                }
-            }
-            else
+            if( bIdx == BIDX_NONE )
             {
                 /*  All the buffers are used, which should have been caught by
                  *  checking gBufCtx.uNumUsed.
@@ -293,64 +623,62 @@ REDSTATUS RedBufferGet( uint32_t ulBlock,
                 CRITICAL_ERROR();
                 ret = -RED_EBUSY;
             }
-
-            if( ret == 0 )
+            else
             {
-                if( ( uFlags & BFLAG_NEW ) == 0U )
+                BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+
+                ret = BufferEvict( bIdx );
+
+                if( ret == 0 )
                 {
-                    /*  Invalidate the LRU buffer.  If the read fails, we do not
-                     *  want the buffer head to continue to refer to the old
-                     *  block number, since the read, even if it fails, may have
-                     *  partially overwritten the buffer data (consider the case
-                     *  where block size exceeds sector size, and some but not
-                     *  all of the sectors are read successfully), and if the
-                     *  buffer were to be used subsequently with its partially
-                     *  erroneous contents, bad things could happen.
+                    /*  Drop the victim's flags now, while the FS mutex is held:
+                     *  once an unlocked read finishes, other tasks may flag the
+                     *  buffer before this one references it.
                      */
-                    pHead->ulBlock = BBLK_INVALID;
-
-                    ret = RedIoRead( gbRedVolNum, ulBlock, 1U, gBufCtx.b.aabBuffer[ bIdx ] );
+                    pHead->uFlags = 0U;
 
-                    if( ( ret == 0 ) && ( ( uFlags & BFLAG_META ) != 0U ) )
+                    if( ( uFlags & BFLAG_NEW ) == 0U )
                     {
-                        if( !BufferIsValid( gBufCtx.b.aabBuffer[ bIdx ], uFlags ) )
+                        /*  Invalidate the victim buffer.  If the read fails, we
+                         *  do not want the buffer head to continue to refer to
+                         *  the old block number, since the read, even if it
+                         *  fails, may have partially overwritten the buffer
+                         *  data (consider the case where block size exceeds
+                         *  sector size, and some but not all of the sectors are
+                         *  read successfully), and if the buffer were to be
+                         *  used subsequently with its partially erroneous
+                         *  contents, bad things could happen.
+                         */
+                        BufferSetBlock( bIdx, pHead->bVolNum, BBLK_INVALID );
+
+                        if( ( uFlags & BFLAG_META ) != 0U )
                         {
-                            /*  A corrupt metadata node is usually a critical
-                             *  error.  The master block is an exception since
-                             *  it might be invalid because the volume is not
-                             *  mounted; that condition is expected and should
-                             *  not result in an assertion.
-                             */
-                            CRITICAL_ASSERT( ( uFlags & BFLAG_META_MASTER ) == BFLAG_META_MASTER );
-                            ret = -RED_EIO;
+                            gBufCtx.stat.ulMetaMisses++;
                         }
-                    }
-
-                    #ifdef REDCONF_ENDIAN_SWAP
-                        if( ret == 0 )
+                        else
                         {
-                            BufferEndianSwap( gBufCtx.b.aabBuffer[ bIdx ], uFlags );
+                            gBufCtx.stat.ulDataMisses++;
                         }
-                    #endif
+
+                        ret = BufferRead( bIdx, ulBlock, uFlags );
+                    }
+                    else
+                    {
+                        RedMemSet( BUFFER_DATA( bIdx ), 0U, REDCONF_BLOCK_SIZE );
+                    }
                 }
-                else
+
+                if( ret == 0 )
                 {
-                    RedMemSet( gBufCtx.b.aabBuffer[ bIdx ], 0U, REDCONF_BLOCK_SIZE );
+                    BufferSetBlock( bIdx, gbRedVolNum, ulBlock );
                 }
             }
-
-            if( ret == 0 )
-            {
-                pHead->bVolNum = gbRedVolNum;
-                pHead->ulBlock = ulBlock;
-                pHead->uFlags = 0U;
-            }
         }
 
-        /*  Reference the buffer, update its flags, and promote it to MRU.  This
-         *  happens both when BufferFind() found an existing buffer for the
-         *  block and when the LRU buffer was repurposed to create a buffer for
-         *  the block.
+        /*  Reference the buffer, update its flags, and promote it according to
+         *  the replacement policy.  This happens both when BufferFind() found
+         *  an existing buffer for the block and when a victim buffer was
+         *  repurposed to create a buffer for the block.
          */
         if( ret == 0 )
         {
@@ -367,11 +695,18 @@ REDSTATUS RedBufferGet( uint32_t ulBlock,
              *  reading it from disk; it has no meaning later on, and thus is
              *  not saved.
              */
+            #if REDCONF_TRANSACT_BACKGROUND == 1
+                if( ( ( uFlags & BFLAG_DIRTY ) != 0U ) && ( ( pHead->uFlags & BFLAG_DIRTY ) == 0U ) )
+                {
+                    RedVolBufferDirtied();
+                }
+            #endif
+
             pHead->uFlags |= ( uFlags & ( ~BFLAG_NEW ) );
 
-            BufferMakeMRU( bIdx );
+            BufferPromote( bIdx, fHit );
 
-            *ppBuffer = gBufCtx.b.aabBuffer[ bIdx ];
+            *ppBuffer = BUFFER_DATA( bIdx );
         }
     }
 
@@ -405,213 +740,1036 @@ void RedBufferPut( const void * pBuffer )
 }
 
 
-#if REDCONF_READ_ONLY == 0
+#if REDCONF_READ_LEASES > 0U
 
-/** @brief Flush all buffers for the active volume in the given range of blocks.
+/** @brief Lend a buffer to a reader.
  *
- *  @param ulBlockStart Starting block number to flush.
- *  @param ulBlockCount Count of blocks, starting at @p ulBlockStart, to flush.
- *                      Must not be zero.
+ *  The leased buffer is detached from its block: if it is dirty it is written
+ *  out first, and then it is removed from the cache, so that later changes to
+ *  the block cannot modify the data out from under the reader.  The buffer
+ *  stays referenced until RedBufferLeaseRelease(), so that it is not reused.
+ *
+ *  If anyone else holds a reference to @p pBuffer, its data is copied into an
+ *  unused buffer, and that buffer is leased instead.
+ *
+ *  @param pBuffer  The buffer to lease, which the caller has referenced with
+ *                  RedBufferGet(); or `NULL` to lease a buffer of zeroes.  On
+ *                  success, the caller's reference is consumed: the caller
+ *                  must not release it with RedBufferPut().
+ *  @param ppLeased On success, populated with the leased buffer.
  *
  *  @return A negated ::REDSTATUS code indicating the operation result.
  *
  *  @retval 0           Operation was successful.
- *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EBUSY  The maximum number of leases are outstanding.
  *  @retval -RED_EINVAL Invalid parameters.
+ *  @retval -RED_EIO    A disk I/O error occurred.
  */
-    REDSTATUS RedBufferFlush( uint32_t ulBlockStart,
-                              uint32_t ulBlockCount )
+    REDSTATUS RedBufferLease( const void * pBuffer,
+                              const void ** ppLeased )
     {
         REDSTATUS ret = 0;
+        uint8_t bIdx = BIDX_NONE;
 
-        if( ( ulBlockStart >= gpRedVolume->ulBlockCount ) ||
-            ( ( gpRedVolume->ulBlockCount - ulBlockStart ) < ulBlockCount ) ||
-            ( ulBlockCount == 0U ) )
+        if( ppLeased == NULL )
         {
             REDERROR();
             ret = -RED_EINVAL;
         }
-        else
+        else if( ( pBuffer != NULL ) && !BufferToIdx( pBuffer, &bIdx ) )
         {
-            uint8_t bIdx;
+            REDERROR();
+            ret = -RED_EINVAL;
+        }
+        else if( gBufCtx.bNumLeased >= REDCONF_READ_LEASES )
+        {
+            ret = -RED_EBUSY;
+        }
+        else if( ( bIdx == BIDX_NONE ) || ( gBufCtx.aHead[ bIdx ].bRefCount > 1U ) )
+        {
+            ret = BufferLeaseSpare( pBuffer, &bIdx );
 
-            for( bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++ )
+            if( ( ret == 0 ) && ( pBuffer != NULL ) )
             {
-                BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
-
-                if( ( pHead->bVolNum == gbRedVolNum ) &&
-                    ( pHead->ulBlock != BBLK_INVALID ) &&
-                    ( ( pHead->uFlags & BFLAG_DIRTY ) != 0U ) &&
-                    ( pHead->ulBlock >= ulBlockStart ) &&
-                    ( pHead->ulBlock < ( ulBlockStart + ulBlockCount ) ) )
+                RedBufferPut( pBuffer );
+            }
+        }
+        else
+        {
+            #if REDCONF_READ_ONLY == 0
+                if( ( gBufCtx.aHead[ bIdx ].uFlags & BFLAG_DIRTY ) != 0U )
                 {
                     ret = BufferWrite( bIdx );
-
-                    if( ret == 0 )
-                    {
-                        pHead->uFlags &= ( ~BFLAG_DIRTY );
-                    }
-                    else
-                    {
-                        break;
-                    }
                 }
+            #endif
+
+            if( ret == 0 )
+            {
+                BufferSetBlock( bIdx, gBufCtx.aHead[ bIdx ].bVolNum, BBLK_INVALID );
             }
         }
 
-        return ret;
-    }
-
+        if( ret == 0 )
+        {
+            REDASSERT( gBufCtx.aHead[ bIdx ].bRefCount == 1U );
 
-/** @brief Mark a buffer dirty
- *
- *  @param pBuffer  The buffer to mark dirty.
- */
-    void RedBufferDirty( const void * pBuffer )
-    {
-        uint8_t bIdx;
+            gBufCtx.aHead[ bIdx ].uFlags = BFLAG_LEASED;
+            gBufCtx.bNumLeased++;
 
-        if( !BufferToIdx( pBuffer, &bIdx ) )
-        {
-            REDERROR();
+            *ppLeased = BUFFER_DATA( bIdx );
         }
-        else
-        {
-            REDASSERT( gBufCtx.aHead[ bIdx ].bRefCount > 0U );
 
-            gBufCtx.aHead[ bIdx ].uFlags |= BFLAG_DIRTY;
-        }
+        return ret;
     }
 
 
-/** @brief Branch a buffer, marking it dirty and assigning a new block number.
+    #if REDCONF_INODE_INLINE_DATA == 1
+
+/** @brief Lend a reader a copy of a buffer.
  *
- *  @param pBuffer      The buffer to branch.
- *  @param ulBlockNew   The new block number for the buffer.
+ *  Unlike RedBufferLease(), the caller keeps its reference to @p pBuffer, which
+ *  stays associated with its block.  Used for inline file data, which lives in
+ *  an inode buffer that the cached inode still needs.
+ *
+ *  @param pBuffer  The buffer to copy, which the caller has referenced with
+ *                  RedBufferGet().
+ *  @param ppLeased On success, populated with the leased copy.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBUSY  The maximum number of leases are outstanding.
+ *  @retval -RED_EINVAL Invalid parameters.
+ *  @retval -RED_EIO    A disk I/O error occurred.
  */
-    void RedBufferBranch( const void * pBuffer,
-                          uint32_t ulBlockNew )
-    {
-        uint8_t bIdx;
-
+        REDSTATUS RedBufferLeaseCopy( const void * pBuffer,
+                                      const void ** ppLeased )
+        {
+            REDSTATUS ret;
+            uint8_t bIdx;
+
+            if( ( pBuffer == NULL ) || ( ppLeased == NULL ) || !BufferToIdx( pBuffer, &bIdx ) )
+            {
+                REDERROR();
+                ret = -RED_EINVAL;
+            }
+            else if( gBufCtx.bNumLeased >= REDCONF_READ_LEASES )
+            {
+                ret = -RED_EBUSY;
+            }
+            else
+            {
+                ret = BufferLeaseSpare( pBuffer, &bIdx );
+
+                if( ret == 0 )
+                {
+                    gBufCtx.aHead[ bIdx ].uFlags = BFLAG_LEASED;
+                    gBufCtx.bNumLeased++;
+
+                    *ppLeased = BUFFER_DATA( bIdx );
+                }
+            }
+
+            return ret;
+        }
+    #endif /* REDCONF_INODE_INLINE_DATA == 1 */
+
+
+/** @brief Release a buffer leased by RedBufferLease().
+ *
+ *  @param pData    A pointer into the leased buffer.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL @p pData does not point into a leased buffer.
+ */
+    REDSTATUS RedBufferLeaseRelease( const void * pData )
+    {
+        REDSTATUS ret = -RED_EINVAL;
+
+        if( pData != NULL )
+        {
+            uintptr_t ulOffset = PTR_BYTE_DISTANCE( pData, BUFFER_DATA( 0U ) );
+
+            /*  Like BufferToIdx(), but the pointer may be anywhere within the
+             *  buffer, since the lease is usually for data in the middle of a
+             *  block.  The computed index and offset are only trusted once the
+             *  address they give compares equal to the original pointer.
+             */
+            if( ulOffset < ( ( uintptr_t ) REDCONF_BUFFER_COUNT * REDCONF_BLOCK_SIZE ) )
+            {
+                uint8_t bIdx = ( uint8_t ) ( ulOffset >> BLOCK_SIZE_P2 );
+                uint32_t ulByte = ( uint32_t ) ulOffset & ( REDCONF_BLOCK_SIZE - 1U );
+                BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+
+                if( CAST_VOID_PTR_TO_CONST_UINT8_PTR( pData ) != &BUFFER_DATA( bIdx )[ ulByte ] )
+                {
+                    REDERROR();
+                }
+                else if( ( pHead->uFlags & BFLAG_LEASED ) != 0U )
+                {
+                    REDASSERT( pHead->bRefCount == 1U );
+                    REDASSERT( gBufCtx.bNumLeased > 0U );
+                    REDASSERT( gBufCtx.uNumUsed > 0U );
+
+                    pHead->bRefCount = 0U;
+                    pHead->uFlags = 0U;
+                    gBufCtx.bNumLeased--;
+                    gBufCtx.uNumUsed--;
+
+                    BufferMakeLRU( bIdx );
+
+                    ret = 0;
+                }
+                else
+                {
+                    /*  The buffer is not leased.
+                     */
+                }
+            }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Determine whether any leased buffers belong to the current volume.
+ *
+ *  @return Whether a lease on the current volume is outstanding.
+ */
+    bool RedBufferLeased( void )
+    {
+        bool fLeased = false;
+        uint8_t bIdx;
+
+        if( gBufCtx.bNumLeased > 0U )
+        {
+            for( bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++ )
+            {
+                if( ( ( gBufCtx.aHead[ bIdx ].uFlags & BFLAG_LEASED ) != 0U ) &&
+                    ( gBufCtx.aHead[ bIdx ].bVolNum == gbRedVolNum ) )
+                {
+                    fLeased = true;
+                    break;
+                }
+            }
+        }
+
+        return fLeased;
+    }
+#endif /* REDCONF_READ_LEASES > 0U */
+
+
+#if REDCONF_READ_ONLY == 0
+
+/** @brief Flush all buffers for the active volume in the given range of blocks.
+ *
+ *  The dirty buffers are written in order of block number, and buffers for
+ *  adjacent blocks are combined into a single write request where possible:
+ *  directly, when the buffers are also adjacent in memory, or otherwise by
+ *  gathering them into a bounce buffer of REDCONF_BUFFER_WRITE_GATHER blocks.
+ *
+ *  @param ulBlockStart Starting block number to flush.
+ *  @param ulBlockCount Count of blocks, starting at @p ulBlockStart, to flush.
+ *                      Must not be zero.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EINVAL Invalid parameters.
+ */
+    REDSTATUS RedBufferFlush( uint32_t ulBlockStart,
+                              uint32_t ulBlockCount )
+    {
+        REDSTATUS ret = 0;
+
+        if( ( ulBlockStart >= gpRedVolume->ulBlockCount ) ||
+            ( ( gpRedVolume->ulBlockCount - ulBlockStart ) < ulBlockCount ) ||
+            ( ulBlockCount == 0U ) )
+        {
+            REDERROR();
+            ret = -RED_EINVAL;
+        }
+        else
+        {
+            uint8_t bCount = 0U;
+            uint8_t bIdx;
+            uint8_t bPos;
+
+            /*  Collect the dirty buffers in the range, using an insertion sort
+             *  to order them by block number.  The number of dirty buffers is
+             *  small enough that this is cheaper than the I/O it saves.
+             */
+            for( bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++ )
+            {
+                const BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+
+                if( ( pHead->bVolNum == gbRedVolNum ) &&
+                    ( pHead->ulBlock != BBLK_INVALID ) &&
+                    ( ( pHead->uFlags & BFLAG_DIRTY ) != 0U ) &&
+                    ( pHead->ulBlock >= ulBlockStart ) &&
+                    ( pHead->ulBlock < ( ulBlockStart + ulBlockCount ) ) )
+                {
+                    bPos = bCount;
+
+                    while( ( bPos > 0U ) && ( gBufCtx.aHead[ gBufCtx.abFlush[ bPos - 1U ] ].ulBlock > pHead->ulBlock ) )
+                    {
+                        gBufCtx.abFlush[ bPos ] = gBufCtx.abFlush[ bPos - 1U ];
+                        bPos--;
+                    }
+
+                    gBufCtx.abFlush[ bPos ] = bIdx;
+                    bCount++;
+                }
+            }
+
+            bPos = 0U;
+
+            while( ( ret == 0 ) && ( bPos < bCount ) )
+            {
+                bool fContig;
+                uint8_t bRunLen = BufferFlushRun( bPos, bCount, &fContig );
+
+                ret = BufferWriteRun( &gBufCtx.abFlush[ bPos ], bRunLen, fContig );
+
+                if( ret == 0 )
+                {
+                    uint8_t bRunIdx;
+
+                    for( bRunIdx = 0U; bRunIdx < bRunLen; bRunIdx++ )
+                    {
+                        gBufCtx.aHead[ gBufCtx.abFlush[ bPos + bRunIdx ] ].uFlags &= ( ~BFLAG_DIRTY );
+                    }
+
+                    bPos += bRunLen;
+                }
+            }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Mark a buffer dirty
+ *
+ *  @param pBuffer  The buffer to mark dirty.
+ */
+    void RedBufferDirty( const void * pBuffer )
+    {
+        uint8_t bIdx;
+
+        if( !BufferToIdx( pBuffer, &bIdx ) )
+        {
+            REDERROR();
+        }
+        else
+        {
+            REDASSERT( gBufCtx.aHead[ bIdx ].bRefCount > 0U );
+
+            #if REDCONF_TRANSACT_BACKGROUND == 1
+                if( ( gBufCtx.aHead[ bIdx ].uFlags & BFLAG_DIRTY ) == 0U )
+                {
+                    RedVolBufferDirtied();
+                }
+            #endif
+
+            gBufCtx.aHead[ bIdx ].uFlags |= BFLAG_DIRTY;
+        }
+    }
+
+
+/** @brief Branch a buffer, marking it dirty and assigning a new block number.
+ *
+ *  @param pBuffer      The buffer to branch.
+ *  @param ulBlockNew   The new block number for the buffer.
+ */
+    void RedBufferBranch( const void * pBuffer,
+                          uint32_t ulBlockNew )
+    {
+        uint8_t bIdx;
+
         if( !BufferToIdx( pBuffer, &bIdx ) ||
             ( ulBlockNew >= gpRedVolume->ulBlockCount ) )
         {
-            REDERROR();
+            REDERROR();
+        }
+        else
+        {
+            BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+
+            REDASSERT( pHead->bRefCount > 0U );
+            REDASSERT( ( pHead->uFlags & BFLAG_DIRTY ) == 0U );
+
+            #if REDCONF_TRANSACT_BACKGROUND == 1
+                RedVolBufferDirtied();
+            #endif
+
+            pHead->uFlags |= BFLAG_DIRTY;
+            BufferSetBlock( bIdx, pHead->bVolNum, ulBlockNew );
+        }
+    }
+
+
+    #if ( REDCONF_API_POSIX == 1 ) || FORMAT_SUPPORTED
+
+/** @brief Discard a buffer, releasing it and marking it invalid.
+ *
+ *  @param pBuffer  The buffer to discard.
+ */
+        void RedBufferDiscard( const void * pBuffer )
+        {
+            uint8_t bIdx;
+
+            if( !BufferToIdx( pBuffer, &bIdx ) )
+            {
+                REDERROR();
+            }
+            else
+            {
+                REDASSERT( gBufCtx.aHead[ bIdx ].bRefCount == 1U );
+                REDASSERT( gBufCtx.uNumUsed > 0U );
+
+                gBufCtx.aHead[ bIdx ].bRefCount = 0U;
+                BufferSetBlock( bIdx, gBufCtx.aHead[ bIdx ].bVolNum, BBLK_INVALID );
+
+                gBufCtx.uNumUsed--;
+
+                BufferMakeLRU( bIdx );
+            }
+        }
+    #endif /* if ( REDCONF_API_POSIX == 1 ) || FORMAT_SUPPORTED */
+#endif /* REDCONF_READ_ONLY == 0 */
+
+
+/** @brief Discard a range of buffers, marking them invalid.
+ *
+ *  @param ulBlockStart The starting block number to discard
+ *  @param ulBlockCount The number of blocks, starting at @p ulBlockStart, to
+ *                      discard.  Must not be zero.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL Invalid parameters.
+ *  @retval -RED_EBUSY  A block in the desired range is referenced.
+ */
+REDSTATUS RedBufferDiscardRange( uint32_t ulBlockStart,
+                                 uint32_t ulBlockCount )
+{
+    REDSTATUS ret = 0;
+
+    if( ( ulBlockStart >= gpRedVolume->ulBlockCount ) ||
+        ( ( gpRedVolume->ulBlockCount - ulBlockStart ) < ulBlockCount ) ||
+        ( ulBlockCount == 0U ) )
+    {
+        REDERROR();
+        ret = -RED_EINVAL;
+    }
+    else
+    {
+        uint8_t bIdx;
+
+        #if REDCONF_BUFFER_HASH == 1
+            if( ulBlockCount < REDCONF_BUFFER_COUNT )
+            {
+                uint32_t ulBlock;
+
+                /*  For short ranges, such as a single block which has become
+                 *  free, probing the hash index for each block is cheaper than
+                 *  examining every buffer head.
+                 */
+                for( ulBlock = ulBlockStart; ulBlock < ( ulBlockStart + ulBlockCount ); ulBlock++ )
+                {
+                    if( BufferFind( ulBlock, &bIdx ) )
+                    {
+                        ret = BufferDiscardIdx( bIdx );
+
+                        if( ret != 0 )
+                        {
+                            break;
+                        }
+                    }
+                }
+            }
+            else
+        #endif /* if REDCONF_BUFFER_HASH == 1 */
+        {
+            for( bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++ )
+            {
+                const BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+
+                if( ( pHead->bVolNum == gbRedVolNum ) &&
+                    ( pHead->ulBlock != BBLK_INVALID ) &&
+                    ( pHead->ulBlock >= ulBlockStart ) &&
+                    ( pHead->ulBlock < ( ulBlockStart + ulBlockCount ) ) )
+                {
+                    ret = BufferDiscardIdx( bIdx );
+
+                    if( ret != 0 )
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+
+#if REDCONF_READ_AHEAD_BLOCKS > 0U
+
+/** @brief Read ahead a range of blocks into the buffers.
+ *
+ *  The blocks are read with a single request, starting with @p ulBlockStart
+ *  and stopping before the first block which is already buffered.  Fewer
+ *  blocks than requested may be read, so that read-ahead never takes more
+ *  than half of the unreferenced buffers.
+ *
+ *  @param ulBlockStart The first block to read.
+ *  @param ulBlockCount The maximum number of blocks to read.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EINVAL Invalid parameters.
+ */
+    REDSTATUS RedBufferReadAhead( uint32_t ulBlockStart,
+                                  uint32_t ulBlockCount )
+    {
+        REDSTATUS ret = 0;
+
+        if( ( ulBlockStart >= gpRedVolume->ulBlockCount ) ||
+            ( ( gpRedVolume->ulBlockCount - ulBlockStart ) < ulBlockCount ) )
+        {
+            REDERROR();
+            ret = -RED_EINVAL;
+        }
+        else
+        {
+            uint32_t ulMaxCount = REDMIN( ulBlockCount, ( REDCONF_BUFFER_COUNT - ( uint32_t ) gBufCtx.uNumUsed ) / 2U );
+            uint32_t ulCount = 0U;
+            uint8_t bIdx;
+
+            ulMaxCount = REDMIN( ulMaxCount, BUFFER_BOUNCE_BLOCKS );
+
+            while( ( ulCount < ulMaxCount ) && !BufferFind( ulBlockStart + ulCount, &bIdx ) )
+            {
+                ulCount++;
+            }
+
+            if( ulCount > 0U )
+            {
+                /*  Since none of the blocks are buffered, none of them can have
+                 *  dirty buffers, so the data on disk is current.
+                 */
+                ret = RedIoReadAhead( gbRedVolNum, ulBlockStart, ulCount, BOUNCE_DATA( 0U ) );
+            }
+
+            if( ret == 0 )
+            {
+                uint32_t ulIdx;
+
+                for( ulIdx = 0U; ulIdx < ulCount; ulIdx++ )
+                {
+                    bIdx = BufferVictim();
+
+                    if( bIdx == BIDX_NONE )
+                    {
+                        REDERROR();
+                        ret = -RED_EBUSY;
+                    }
+                    else
+                    {
+                        ret = BufferEvict( bIdx );
+                    }
+
+                    if( ret != 0 )
+                    {
+                        break;
+                    }
+
+                    RedMemCpy( BUFFER_DATA( bIdx ), BOUNCE_DATA( ulIdx ), REDCONF_BLOCK_SIZE );
+                    BufferSetBlock( bIdx, gbRedVolNum, ulBlockStart + ulIdx );
+                    gBufCtx.aHead[ bIdx ].uFlags = 0U;
+                    BufferPromote( bIdx, false );
+
+                    gBufCtx.stat.ulReadAheadBlocks++;
+                }
+            }
+        }
+
+        return ret;
+    }
+#endif /* REDCONF_READ_AHEAD_BLOCKS > 0U */
+
+
+/** @brief Retrieve the buffer cache statistics.
+ *
+ *  @param pStat    Populated with the buffer cache statistics.
+ *  @param fReset   Whether to reset the statistics to zero after they have
+ *                  been retrieved.
+ */
+void RedBufferStat( REDBUFSTAT * pStat,
+                    bool fReset )
+{
+    if( pStat == NULL )
+    {
+        REDERROR();
+    }
+    else
+    {
+        *pStat = gBufCtx.stat;
+
+        if( fReset )
+        {
+            RedMemSet( &gBufCtx.stat, 0U, sizeof( gBufCtx.stat ) );
+        }
+    }
+}
+
+
+#if REDCONF_FINE_LOCKING == 1
+
+/** @brief Enable or disable unlocked reads for the operation in progress.
+ *
+ *  See RedCoreUnlockedReads().
+ *
+ *  @param fEnable  Whether unlocked reads are allowed.
+ */
+    void RedBufferUnlockedReads( bool fEnable )
+    {
+        gfUnlockedReads = fEnable;
+    }
+
+
+/** @brief Read blocks directly into a caller-supplied buffer.
+ *
+ *  If unlocked reads are enabled, the FS mutex is released while the read is
+ *  in progress.  The caller is responsible for making sure that the blocks do
+ *  not have dirty buffers.
+ *
+ *  @param ulBlockStart The first block to read.
+ *  @param ulBlockCount The number of blocks to read.
+ *  @param pBuffer      The buffer to read into.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EINVAL Invalid parameters.
+ */
+    REDSTATUS RedBufferReadDirect( uint32_t ulBlockStart,
+                                   uint32_t ulBlockCount,
+                                   void * pBuffer )
+    {
+        REDSTATUS ret;
+        uint8_t bVolNum = gbRedVolNum;
+
+        if( BufferSlotTake() )
+        {
+            BufferUnlock();
+
+            ret = RedIoRead( bVolNum, ulBlockStart, ulBlockCount, pBuffer );
+
+            BufferRelock( bVolNum );
+            RedOsSemaphoreGive( RED_SEM_IO_SLOT );
+        }
+        else
+        {
+            ret = RedIoRead( bVolNum, ulBlockStart, ulBlockCount, pBuffer );
+        }
+
+        return ret;
+    }
+#endif /* REDCONF_FINE_LOCKING == 1 */
+
+
+/** @brief Prepare an unreferenced buffer to be repurposed for another block.
+ *
+ *  If the buffer is dirty, it is written out.
+ *
+ *  @param bIdx The index of the buffer to evict.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EINVAL Invalid parameters.
+ */
+static REDSTATUS BufferEvict( uint8_t bIdx )
+{
+    REDSTATUS ret = 0;
+    const BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+
+    REDASSERT( pHead->bRefCount == 0U );
+
+    if( pHead->ulBlock != BBLK_INVALID )
+    {
+        gBufCtx.stat.ulEvictions++;
+
+        #if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+            if( gBufCtx.abList[ bIdx ] == BLIST_PROBATION )
+            {
+                BufferGhostAdd( bIdx );
+            }
+        #endif
+
+        if( ( pHead->uFlags & BFLAG_DIRTY ) != 0U )
+        {
+            gBufCtx.stat.ulWritebacks++;
+
+            #if REDCONF_READ_ONLY == 1
+                CRITICAL_ERROR();
+                ret = -RED_EFUBAR;
+            #else
+                ret = BufferWrite( bIdx );
+            #endif
+        }
+    }
+
+    return ret;
+}
+
+
+#if REDCONF_READ_LEASES > 0U
+
+/** @brief Take an unused buffer to be leased, filling it with a copy of a
+ *         block or with zeroes.
+ *
+ *  @param pSrc     The data to copy into the buffer; or `NULL` to zero it.
+ *  @param pbIdx    On success, populated with the index of the buffer, which
+ *                  is referenced once and not associated with any block.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBUSY  All buffers are referenced.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+    static REDSTATUS BufferLeaseSpare( const void * pSrc,
+                                       uint8_t * pbIdx )
+    {
+        REDSTATUS ret;
+        uint8_t bIdx = BufferVictim();
+
+        if( bIdx == BIDX_NONE )
+        {
+            /*  The buffer count checks, which reserve a buffer for each lease,
+             *  should prevent this.
+             */
+            CRITICAL_ERROR();
+            ret = -RED_EBUSY;
         }
         else
         {
-            BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+            ret = BufferEvict( bIdx );
 
-            REDASSERT( pHead->bRefCount > 0U );
-            REDASSERT( ( pHead->uFlags & BFLAG_DIRTY ) == 0U );
+            if( ret == 0 )
+            {
+                BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
 
-            pHead->uFlags |= BFLAG_DIRTY;
-            pHead->ulBlock = ulBlockNew;
+                BufferSetBlock( bIdx, gbRedVolNum, BBLK_INVALID );
+                pHead->uFlags = 0U;
+                pHead->bRefCount = 1U;
+                gBufCtx.uNumUsed++;
+
+                if( pSrc == NULL )
+                {
+                    RedMemSet( BUFFER_DATA( bIdx ), 0U, REDCONF_BLOCK_SIZE );
+                }
+                else
+                {
+                    RedMemCpy( BUFFER_DATA( bIdx ), pSrc, REDCONF_BLOCK_SIZE );
+                }
+
+                *pbIdx = bIdx;
+            }
         }
+
+        return ret;
     }
+#endif /* REDCONF_READ_LEASES > 0U */
 
 
-    #if ( REDCONF_API_POSIX == 1 ) || FORMAT_SUPPORTED
+/** @brief Discard a buffer which is in a range being discarded.
+ *
+ *  @param bIdx The index of the buffer to discard.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBUSY  The buffer is referenced.
+ */
+static REDSTATUS BufferDiscardIdx( uint8_t bIdx )
+{
+    REDSTATUS ret = 0;
 
-/** @brief Discard a buffer, releasing it and marking it invalid.
+    if( gBufCtx.aHead[ bIdx ].bRefCount == 0U )
+    {
+        BufferSetBlock( bIdx, gBufCtx.aHead[ bIdx ].bVolNum, BBLK_INVALID );
+
+        BufferMakeLRU( bIdx );
+    }
+    else
+    {
+        /*  This should never happen.  There are three general cases when
+         *  RedBufferDiscardRange() is used:
+         *
+         *  1) Discarding every block, as happens during unmount and at the end
+         *     of format.  There should no longer be any referenced buffers at
+         *     those points.
+         *  2) Discarding a block which has become free.  All buffers for such
+         *     blocks should be put or branched beforehand.
+         *  3) Discarding of blocks that were just written straight to disk,
+         *     leaving stale data in the buffer.  The write code should never
+         *     reference buffers for these blocks, since they would not be
+         *     needed or used.
+         */
+        CRITICAL_ERROR();
+        ret = -RED_EBUSY;
+    }
+
+    return ret;
+}
+
+
+/** @brief Read a block into a buffer which is being repurposed for it.
  *
- *  @param pBuffer  The buffer to discard.
+ *  @param bIdx     The index of the buffer, which must be unreferenced and
+ *                  invalidated.
+ *  @param ulBlock  The block to read.
+ *  @param uFlags   The buffer flags provided by the caller.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
  */
-        void RedBufferDiscard( const void * pBuffer )
+static REDSTATUS BufferRead( uint8_t bIdx,
+                             uint32_t ulBlock,
+                             uint16_t uFlags )
+{
+    REDSTATUS ret;
+
+    #if REDCONF_FINE_LOCKING == 1
+        BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+        uint8_t bVolNum = gbRedVolNum;
+
+        /*  The reference keeps the buffer from being repurposed while the FS
+         *  mutex is released.  It is dropped at the end; the caller references
+         *  the buffer again if the read succeeded.
+         */
+        BufferSetBlock( bIdx, bVolNum, ulBlock );
+        pHead->bRefCount++;
+        gBufCtx.uNumUsed++;
+
+        if( BufferSlotTake() )
         {
-            uint8_t bIdx;
+            /*  Flag the buffer as being read, so that other tasks which need
+             *  the block wait for the read rather than using its contents.
+             */
+            pHead->uFlags = BFLAG_READING;
+            gBufCtx.bReadIdx = bIdx;
+            gBufCtx.uReadFlags = uFlags;
 
-            if( !BufferToIdx( pBuffer, &bIdx ) )
+            BufferUnlock();
+
+            gBufCtx.iReadRet = RedIoRead( bVolNum, ulBlock, 1U, BUFFER_DATA( bIdx ) );
+            RedOsSemaphoreGive( RED_SEM_IO_DONE );
+
+            BufferRelock( bVolNum );
+
+            /*  Unless a task which needed the block already did so, finish the
+             *  read before allowing another unlocked read.
+             */
+            if( gBufCtx.bReadIdx == bIdx )
             {
-                REDERROR();
+                BufferReadFinish();
             }
-            else
-            {
-                REDASSERT( gBufCtx.aHead[ bIdx ].bRefCount == 1U );
-                REDASSERT( gBufCtx.uNumUsed > 0U );
 
-                gBufCtx.aHead[ bIdx ].bRefCount = 0U;
-                gBufCtx.aHead[ bIdx ].ulBlock = BBLK_INVALID;
+            RedOsSemaphoreGive( RED_SEM_IO_SLOT );
 
-                gBufCtx.uNumUsed--;
+            /*  BufferReadFinish() invalidates the buffer if the read failed.
+             */
+            ret = ( pHead->ulBlock == ulBlock ) ? 0 : -RED_EIO;
+        }
+        else
+        {
+            ret = RedIoRead( bVolNum, ulBlock, 1U, BUFFER_DATA( bIdx ) );
 
-                BufferMakeLRU( bIdx );
+            if( ret == 0 )
+            {
+                ret = BufferReadVerify( bIdx, uFlags );
+            }
+
+            if( ret != 0 )
+            {
+                BufferSetBlock( bIdx, bVolNum, BBLK_INVALID );
             }
         }
-    #endif /* if ( REDCONF_API_POSIX == 1 ) || FORMAT_SUPPORTED */
-#endif /* REDCONF_READ_ONLY == 0 */
 
+        /*  The FS mutex was released for the read, so other tasks may have
+         *  referenced the buffer and flagged it dirty or leased since; only
+         *  the read flag and this reference belong to this function.
+         */
+        pHead->uFlags &= ( ~BFLAG_READING );
+        pHead->bRefCount--;
 
-/** @brief Discard a range of buffers, marking them invalid.
+        if( pHead->bRefCount == 0U )
+        {
+            gBufCtx.uNumUsed--;
+        }
+    #else /* if REDCONF_FINE_LOCKING == 1 */
+        ret = RedIoRead( gbRedVolNum, ulBlock, 1U, BUFFER_DATA( bIdx ) );
+
+        if( ret == 0 )
+        {
+            ret = BufferReadVerify( bIdx, uFlags );
+        }
+    #endif /* if REDCONF_FINE_LOCKING == 1 */
+
+    return ret;
+}
+
+
+/** @brief Validate a block which has just been read into a buffer, and convert
+ *         it to native endianness.
  *
- *  @param ulBlockStart The starting block number to discard
- *  @param ulBlockCount The number of blocks, starting at @p ulBlockStart, to
- *                      discard.  Must not be zero.
+ *  @param bIdx     The index of the buffer.
+ *  @param uFlags   The buffer flags provided by the caller.
  *
  *  @return A negated ::REDSTATUS code indicating the operation result.
  *
  *  @retval 0           Operation was successful.
- *  @retval -RED_EINVAL Invalid parameters.
- *  @retval -RED_EBUSY  A block in the desired range is referenced.
+ *  @retval -RED_EIO    The block is metadata and it is invalid.
  */
-REDSTATUS RedBufferDiscardRange( uint32_t ulBlockStart,
-                                 uint32_t ulBlockCount )
+static REDSTATUS BufferReadVerify( uint8_t bIdx,
+                                   uint16_t uFlags )
 {
     REDSTATUS ret = 0;
 
-    if( ( ulBlockStart >= gpRedVolume->ulBlockCount ) ||
-        ( ( gpRedVolume->ulBlockCount - ulBlockStart ) < ulBlockCount ) ||
-        ( ulBlockCount == 0U ) )
+    if( ( uFlags & BFLAG_META ) != 0U )
     {
-        REDERROR();
-        ret = -RED_EINVAL;
+        if( !BufferIsValid( BUFFER_DATA( bIdx ), uFlags ) )
+        {
+            /*  A corrupt metadata node is usually a critical error.  The master
+             *  block is an exception since it might be invalid because the
+             *  volume is not mounted; that condition is expected and should not
+             *  result in an assertion.
+             */
+            CRITICAL_ASSERT( ( uFlags & BFLAG_META_MASTER ) == BFLAG_META_MASTER );
+            ret = -RED_EIO;
+        }
     }
-    else
+
+    #ifdef REDCONF_ENDIAN_SWAP
+        if( ret == 0 )
+        {
+            BufferEndianSwap( BUFFER_DATA( bIdx ), uFlags );
+        }
+    #endif
+
+    return ret;
+}
+
+
+#if REDCONF_FINE_LOCKING == 1
+
+/** @brief Finish the pending unlocked read into a buffer.
+ *
+ *  Waits for the read to complete, if necessary, then validates the buffer
+ *  contents.  The buffer is left flagged as referenced by the task which
+ *  started the read; if the read failed, it is invalidated.  Must be called
+ *  with the FS mutex held.
+ */
+    static void BufferReadFinish( void )
     {
-        uint8_t bIdx;
+        uint8_t bIdx = gBufCtx.bReadIdx;
+        BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+        REDSTATUS ret;
+
+        REDASSERT( bIdx < REDCONF_BUFFER_COUNT );
+        REDASSERT( ( pHead->uFlags & BFLAG_READING ) != 0U );
 
-        for( bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++ )
+        ( void ) RedOsSemaphoreTake( RED_SEM_IO_DONE, true );
+
+        ret = gBufCtx.iReadRet;
+
+        if( ret == 0 )
         {
-            BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+            ret = BufferReadVerify( bIdx, gBufCtx.uReadFlags );
+        }
 
-            if( ( pHead->bVolNum == gbRedVolNum ) &&
-                ( pHead->ulBlock != BBLK_INVALID ) &&
-                ( pHead->ulBlock >= ulBlockStart ) &&
-                ( pHead->ulBlock < ( ulBlockStart + ulBlockCount ) ) )
-            {
-                if( pHead->bRefCount == 0U )
-                {
-                    pHead->ulBlock = BBLK_INVALID;
+        if( ret == 0 )
+        {
+            pHead->uFlags = ( uint16_t ) ( gBufCtx.uReadFlags & BFLAG_META_MASK );
+        }
+        else
+        {
+            BufferSetBlock( bIdx, pHead->bVolNum, BBLK_INVALID );
+            pHead->uFlags = 0U;
+        }
 
-                    BufferMakeLRU( bIdx );
-                }
-                else
-                {
-                    /*  This should never happen.  There are three general cases
-                     *  when this function is used:
-                     *
-                     *  1) Discarding every block, as happens during unmount
-                     *     and at the end of format.  There should no longer be
-                     *     any referenced buffers at those points.
-                     *  2) Discarding a block which has become free.  All
-                     *     buffers for such blocks should be put or branched
-                     *     beforehand.
-                     *  3) Discarding of blocks that were just written straight
-                     *     to disk, leaving stale data in the buffer.  The write
-                     *     code should never reference buffers for these blocks,
-                     *     since they would not be needed or used.
-                     */
-                    CRITICAL_ERROR();
-                    ret = -RED_EBUSY;
-                    break;
-                }
-            }
+        gBufCtx.bReadIdx = BIDX_NONE;
+    }
+
+
+/** @brief Take the slot for an unlocked read, if allowed.
+ *
+ *  Only one unlocked read is in progress at a time, so that the buffers which
+ *  are referenced by the operation waiting on it are bounded.  If the slot is
+ *  taken, the read is done with the FS mutex held.
+ *
+ *  @return Whether the slot was taken.  If so, the caller must call
+ *          BufferUnlock(), read, call BufferRelock(), and then give the
+ *          RED_SEM_IO_SLOT semaphore.
+ */
+    static bool BufferSlotTake( void )
+    {
+        bool fTaken = false;
+
+        if( gfUnlockedReads )
+        {
+            fTaken = RedOsSemaphoreTake( RED_SEM_IO_SLOT, false );
         }
+
+        return fTaken;
     }
 
-    return ret;
-}
+
+/** @brief Release the FS mutex for an unlocked read.
+ */
+    static void BufferUnlock( void )
+    {
+        /*  The next task to acquire the FS mutex decides for itself whether
+         *  unlocked reads are allowed.
+         */
+        gfUnlockedReads = false;
+        RedOsMutexRelease();
+    }
+
+
+/** @brief Reacquire the FS mutex after an unlocked read.
+ *
+ *  @param bVolNum  The volume which was current before the FS mutex was
+ *                  released.
+ */
+    static void BufferRelock( uint8_t bVolNum )
+    {
+        RedOsMutexAcquire();
+
+        /*  Other tasks may have changed the current volume.
+         */
+        ( void ) RedCoreVolSetCurrent( bVolNum );
+
+        gfUnlockedReads = true;
+    }
+#endif /* REDCONF_FINE_LOCKING == 1 */
 
 
 /** Determine whether a metadata buffer is valid.
@@ -717,61 +1875,236 @@ static bool BufferIsValid( const uint8_t * pbBuffer,
                  */
             }
         }
-    }
+    }
+
+    return fValid;
+}
+
+
+/** @brief Derive the index of the buffer.
+ *
+ *  @param pBuffer  The buffer to derive the index of.
+ *  @param pbIdx    On success, populated with the index of the buffer.
+ *
+ *  @return Boolean indicating result.
+ *
+ *  @retval true    Success.
+ *  @retval false   Failure.  @p pBuffer is not a valid buffer pointer.
+ */
+static bool BufferToIdx( const void * pBuffer,
+                         uint8_t * pbIdx )
+{
+    bool fRet = false;
+
+    if( ( pBuffer != NULL ) && ( pbIdx != NULL ) )
+    {
+        uint8_t bIdx;
+
+        #if REDCONF_BUFFER_HASH == 1
+            uintptr_t ulOffset = PTR_BYTE_DISTANCE( pBuffer, BUFFER_DATA( 0U ) );
+
+            /*  With a large number of buffers, comparing against each of them
+             *  is too slow, so compute the index from the buffer address and
+             *  then confirm it.  A pointer before the first buffer yields a
+             *  huge (wrapped) offset and fails the range check.
+             */
+            if( ulOffset < ( ( uintptr_t ) REDCONF_BUFFER_COUNT * REDCONF_BLOCK_SIZE ) )
+            {
+                bIdx = ( uint8_t ) ( ulOffset >> BLOCK_SIZE_P2 );
+
+                if( pBuffer != BUFFER_DATA( bIdx ) )
+                {
+                    bIdx = REDCONF_BUFFER_COUNT;
+                }
+            }
+            else
+            {
+                bIdx = REDCONF_BUFFER_COUNT;
+            }
+        #else /* if REDCONF_BUFFER_HASH == 1 */
+
+            /*  pBuffer should be a pointer to one of the block buffers.
+             *
+             *  A good compiler should optimize this loop into a bounds check and
+             *  an alignment check, although GCC has been observed to not do so;
+             *  if the number of buffers is small, it should not make much
+             *  difference.  The alternative is to use pointer comparisons, but
+             *  this both deviates from MISRA-C:2012 and involves undefined
+             *  behavior.
+             */
+            for( bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++ )
+            {
+                if( pBuffer == BUFFER_DATA( bIdx ) )
+                {
+                    break;
+                }
+            }
+        #endif /* if REDCONF_BUFFER_HASH == 1 */
+
+        if( ( bIdx < REDCONF_BUFFER_COUNT ) &&
+            ( gBufCtx.aHead[ bIdx ].ulBlock != BBLK_INVALID ) &&
+            ( gBufCtx.aHead[ bIdx ].bVolNum == gbRedVolNum ) )
+        {
+            *pbIdx = bIdx;
+            fRet = true;
+        }
+    }
+
+    return fRet;
+}
+
+
+#if REDCONF_READ_ONLY == 0
+
+/** @brief Determine the next run of buffers to be written by RedBufferFlush().
+ *
+ *  A run is a sequence of buffers for adjacent blocks which can be written with
+ *  a single request: either the buffers are adjacent in memory, or there are
+ *  few enough of them to be gathered into the bounce buffer.
+ *
+ *  @param bPos     Position in gBufCtx.abFlush of the first buffer in the run.
+ *  @param bCount   Number of buffers in gBufCtx.abFlush.
+ *  @param pfContig Populated with whether the buffers in the run are adjacent
+ *                  in memory.
+ *
+ *  @return The number of buffers in the run, which is at least one.
+ */
+    static uint8_t BufferFlushRun( uint8_t bPos,
+                                   uint8_t bCount,
+                                   bool * pfContig )
+    {
+        uint8_t bRunLen = 1U;
+        bool fContig = true;
+
+        while( ( bPos + bRunLen ) < bCount )
+        {
+            uint8_t bPrevIdx = gBufCtx.abFlush[ ( bPos + bRunLen ) - 1U ];
+            uint8_t bNextIdx = gBufCtx.abFlush[ bPos + bRunLen ];
+
+            if( gBufCtx.aHead[ bNextIdx ].ulBlock != ( gBufCtx.aHead[ bPrevIdx ].ulBlock + 1U ) )
+            {
+                break;
+            }
+
+            if( !fContig || ( bNextIdx != ( bPrevIdx + 1U ) ) )
+            {
+                #if REDCONF_BUFFER_WRITE_GATHER > 1
+
+                    /*  Buffers which are not adjacent in memory must fit in
+                     *  the bounce buffer.  A run which is adjacent in memory is
+                     *  ended instead if it is already too long to be gathered.
+                     */
+                    if( bRunLen >= REDCONF_BUFFER_WRITE_GATHER )
+                    {
+                        break;
+                    }
+
+                    fContig = false;
+                #else
+                    break;
+                #endif
+            }
+
+            bRunLen++;
+        }
 
-    return fValid;
-}
+        *pfContig = fContig;
 
+        return bRunLen;
+    }
 
-/** @brief Derive the index of the buffer.
+
+/** @brief Write out a run of dirty buffers for adjacent blocks.
  *
- *  @param pBuffer  The buffer to derive the index of.
- *  @param pbIdx    On success, populated with the index of the buffer.
+ *  @param pabIdx   Array of the indices of the buffers to write, in order of
+ *                  block number.
+ *  @param bRunLen  The number of buffers in @p pabIdx.
+ *  @param fContig  Whether the buffers are adjacent in memory.  If false,
+ *                  @p bRunLen must not exceed REDCONF_BUFFER_WRITE_GATHER.
  *
- *  @return Boolean indicating result.
+ *  @return A negated ::REDSTATUS code indicating the operation result.
  *
- *  @retval true    Success.
- *  @retval false   Failure.  @p pBuffer is not a valid buffer pointer.
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EINVAL Invalid parameters.
  */
-static bool BufferToIdx( const void * pBuffer,
-                         uint8_t * pbIdx )
-{
-    bool fRet = false;
-
-    if( ( pBuffer != NULL ) && ( pbIdx != NULL ) )
+    static REDSTATUS BufferWriteRun( const uint8_t * pabIdx,
+                                     uint8_t bRunLen,
+                                     bool fContig )
     {
-        uint8_t bIdx;
+        REDSTATUS ret = 0;
 
-        /*  pBuffer should be a pointer to one of the block buffers.
-         *
-         *  A good compiler should optimize this loop into a bounds check and an
-         *  alignment check, although GCC has been observed to not do so; if the
-         *  number of buffers is small, it should not make much difference.  The
-         *  alternative is to use pointer comparisons, but this both deviates
-         *  from MISRA-C:2012 and involves undefined behavior.
-         */
-        for( bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++ )
+        if( bRunLen == 1U )
         {
-            if( pBuffer == &gBufCtx.b.aabBuffer[ bIdx ][ 0U ] )
+            ret = BufferWrite( pabIdx[ 0U ] );
+        }
+        else
+        {
+            const BUFFERHEAD * pFirst = &gBufCtx.aHead[ pabIdx[ 0U ] ];
+            uint8_t bFinalized;
+
+            for( bFinalized = 0U; bFinalized < bRunLen; bFinalized++ )
             {
-                break;
+                uint8_t bIdx = pabIdx[ bFinalized ];
+
+                REDASSERT( ( gBufCtx.aHead[ bIdx ].uFlags & BFLAG_DIRTY ) != 0U );
+
+                if( ( gBufCtx.aHead[ bIdx ].uFlags & BFLAG_META ) != 0U )
+                {
+                    ret = BufferFinalize( BUFFER_DATA( bIdx ), gBufCtx.aHead[ bIdx ].uFlags );
+
+                    if( ret != 0 )
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if( ret == 0 )
+            {
+                if( fContig )
+                {
+                    ret = RedIoWrite( pFirst->bVolNum, pFirst->ulBlock, bRunLen, BUFFER_DATA( pabIdx[ 0U ] ) );
+                }
+                else
+                {
+                    #if REDCONF_BUFFER_WRITE_GATHER > 1
+                        uint8_t bRunIdx;
+
+                        REDASSERT( bRunLen <= REDCONF_BUFFER_WRITE_GATHER );
+
+                        for( bRunIdx = 0U; bRunIdx < bRunLen; bRunIdx++ )
+                        {
+                            RedMemCpy( BOUNCE_DATA( bRunIdx ), BUFFER_DATA( pabIdx[ bRunIdx ] ), REDCONF_BLOCK_SIZE );
+                        }
+
+                        ret = RedIoWrite( pFirst->bVolNum, pFirst->ulBlock, bRunLen, BOUNCE_DATA( 0U ) );
+                    #else
+                        REDERROR();
+                        ret = -RED_EINVAL;
+                    #endif
+                }
+
             }
+
+            #ifdef REDCONF_ENDIAN_SWAP
+                while( bFinalized > 0U )
+                {
+                    bFinalized--;
+                    BufferEndianSwap( BUFFER_DATA( pabIdx[ bFinalized ] ), gBufCtx.aHead[ pabIdx[ bFinalized ] ].uFlags );
+                }
+            #endif
         }
 
-        if( ( bIdx < REDCONF_BUFFER_COUNT ) &&
-            ( gBufCtx.aHead[ bIdx ].ulBlock != BBLK_INVALID ) &&
-            ( gBufCtx.aHead[ bIdx ].bVolNum == gbRedVolNum ) )
+        if( ret == 0 )
         {
-            *pbIdx = bIdx;
-            fRet = true;
+            gBufCtx.stat.ulFlushWrites++;
+            gBufCtx.stat.ulFlushBlocks += bRunLen;
         }
-    }
-
-    return fRet;
-}
 
+        return ret;
+    }
 
-#if REDCONF_READ_ONLY == 0
 
 /** @brief Write out a dirty buffer.
  *
@@ -795,15 +2128,15 @@ static bool BufferToIdx( const void * pBuffer,
 
             if( ( pHead->uFlags & BFLAG_META ) != 0U )
             {
-                ret = BufferFinalize( gBufCtx.b.aabBuffer[ bIdx ], pHead->uFlags );
+                ret = BufferFinalize( BUFFER_DATA( bIdx ), pHead->uFlags );
             }
 
             if( ret == 0 )
             {
-                ret = RedIoWrite( pHead->bVolNum, pHead->ulBlock, 1U, gBufCtx.b.aabBuffer[ bIdx ] );
+                ret = RedIoWrite( pHead->bVolNum, pHead->ulBlock, 1U, BUFFER_DATA( bIdx ) );
 
                 #ifdef REDCONF_ENDIAN_SWAP
-                    BufferEndianSwap( gBufCtx.b.aabBuffer[ bIdx ], pHead->uFlags );
+                    BufferEndianSwap( BUFFER_DATA( bIdx ), pHead->uFlags );
                 #endif
             }
         }
@@ -1043,9 +2376,17 @@ static bool BufferToIdx( const void * pBuffer,
                 pInode->ulPInode = RedRev32( pInode->ulPInode );
             #endif
 
-            for( ulIdx = 0; ulIdx < INODE_ENTRIES; ulIdx++ )
+            #if REDCONF_INODE_INLINE_DATA == 1
+
+                /*  Inline file data is a byte array, which is never swapped.
+                 */
+                if( !INODE_IS_INLINE( pInode ) )
+            #endif
             {
-                pInode->aulEntries[ ulIdx ] = RedRev32( pInode->aulEntries[ ulIdx ] );
+                for( ulIdx = 0; ulIdx < INODE_ENTRIES; ulIdx++ )
+                {
+                    pInode->aulEntries[ ulIdx ] = RedRev32( pInode->aulEntries[ ulIdx ] );
+                }
             }
         }
     }
@@ -1081,6 +2422,9 @@ static bool BufferToIdx( const void * pBuffer,
 
 
 /** @brief Mark a buffer as least recently used.
+ *
+ *  With 2Q, the buffer is moved to the tail of the probation list, so that it
+ *  is the next victim.
  *
  *  @param bIdx The index of the buffer to make LRU.
  */
@@ -1090,88 +2434,294 @@ static void BufferMakeLRU( uint8_t bIdx )
     {
         REDERROR();
     }
-    else if( bIdx != gBufCtx.abMRU[ REDCONF_BUFFER_COUNT - 1U ] )
+    else
     {
-        uint8_t bMruIdx;
+        BufferListRemove( bIdx );
 
-        /*  Find the current position of the buffer in the MRU array.  We do not
-         *  need to check the last slot, since we already know from the above
-         *  check that the index is not there.
-         */
-        for( bMruIdx = 0U; bMruIdx < ( REDCONF_BUFFER_COUNT - 1U ); bMruIdx++ )
+        #if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+            BufferListInsert( bIdx, BLIST_PROBATION, false );
+        #else
+            BufferListInsert( bIdx, BLIST_MAIN, false );
+        #endif
+    }
+}
+
+
+/** @brief Mark a buffer as most recently used on the list it is already on.
+ *
+ *  @param bIdx The index of the buffer to make MRU.
+ */
+static void BufferMakeMRU( uint8_t bIdx )
+{
+    if( bIdx >= REDCONF_BUFFER_COUNT )
+    {
+        REDERROR();
+    }
+    else
+    {
+        uint8_t bList;
+
+        #if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+            bList = gBufCtx.abList[ bIdx ];
+        #else
+            bList = BLIST_MAIN;
+        #endif
+
+        if( gBufCtx.aList[ bList ].bHead != bIdx )
+        {
+            BufferListRemove( bIdx );
+            BufferListInsert( bIdx, bList, true );
+        }
+    }
+}
+
+
+/** @brief Update the position of a buffer which has just been referenced.
+ *
+ *  With LRU, the buffer becomes MRU.  With 2Q, a block read into the cache is
+ *  placed at the head of the probation list, unless it is metadata or it was
+ *  recently evicted from the probation list, in which case it goes to the
+ *  head of the main list.  A hit on the probation list does not move the
+ *  buffer, since the probation list is a FIFO; a hit on the main list makes
+ *  the buffer MRU.
+ *
+ *  @param bIdx The index of the buffer which was referenced.
+ *  @param fHit Whether the block was already buffered.
+ */
+static void BufferPromote( uint8_t bIdx,
+                           bool fHit )
+{
+    #if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+        if( fHit )
         {
-            if( bIdx == gBufCtx.abMRU[ bMruIdx ] )
+            if( gBufCtx.abList[ bIdx ] == BLIST_MAIN )
             {
-                break;
+                BufferMakeMRU( bIdx );
             }
         }
-
-        if( bMruIdx < ( REDCONF_BUFFER_COUNT - 1U ) )
+        else
         {
-            /*  Move the buffer index to the back of the MRU array, making it
-             *  the LRU buffer.
+            const BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+            uint8_t bList = BLIST_PROBATION;
+
+            /*  BufferGhostRemove() is called even for metadata, so that the
+             *  ghost entry, if any, is not left behind.
              */
-            RedMemMove( &gBufCtx.abMRU[ bMruIdx ], &gBufCtx.abMRU[ bMruIdx + 1U ], REDCONF_BUFFER_COUNT - ( ( uint32_t ) bMruIdx + 1U ) );
-            gBufCtx.abMRU[ REDCONF_BUFFER_COUNT - 1U ] = bIdx;
+            if( BufferGhostRemove( pHead->bVolNum, pHead->ulBlock ) || ( ( pHead->uFlags & BFLAG_META ) != 0U ) )
+            {
+                bList = BLIST_MAIN;
+            }
+
+            BufferListRemove( bIdx );
+            BufferListInsert( bIdx, bList, true );
+        }
+    #else /* if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q */
+        ( void ) fHit;
+
+        BufferMakeMRU( bIdx );
+    #endif /* if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q */
+}
+
+
+/** @brief Select a buffer to be repurposed.
+ *
+ *  With LRU, this is the least recently used buffer which is not referenced.
+ *  With 2Q, the victim comes from the probation list when it holds more than
+ *  its target number of buffers, when its oldest buffer is unused, or when
+ *  every buffer on the main list is referenced; otherwise, the victim is the
+ *  least recently used unreferenced buffer on the main list.
+ *
+ *  @return The index of the victim buffer, or BIDX_NONE if every buffer is
+ *          referenced.
+ */
+static uint8_t BufferVictim( void )
+{
+    uint8_t bIdx;
+
+    #if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+        uint8_t bProbation = BufferListLastFree( BLIST_PROBATION );
+
+        if( ( bProbation != BIDX_NONE ) &&
+            ( ( gBufCtx.aHead[ bProbation ].ulBlock == BBLK_INVALID ) ||
+              ( gBufCtx.aList[ BLIST_PROBATION ].bCount > BUFFER_2Q_KIN ) ) )
+        {
+            bIdx = bProbation;
         }
         else
         {
-            REDERROR();
+            bIdx = BufferListLastFree( BLIST_MAIN );
+
+            if( bIdx == BIDX_NONE )
+            {
+                bIdx = bProbation;
+            }
         }
+    #else /* if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q */
+        bIdx = BufferListLastFree( BLIST_MAIN );
+    #endif /* if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q */
+
+    return bIdx;
+}
+
+
+/** @brief Find the least recently used unreferenced buffer on a list.
+ *
+ *  @param bList    The list to search.
+ *
+ *  @return The index of the buffer, or BIDX_NONE if every buffer on the list
+ *          is referenced.
+ */
+static uint8_t BufferListLastFree( uint8_t bList )
+{
+    uint8_t bIdx = gBufCtx.aList[ bList ].bTail;
+
+    while( ( bIdx != BIDX_NONE ) && ( gBufCtx.aHead[ bIdx ].bRefCount != 0U ) )
+    {
+        bIdx = gBufCtx.abMruPrev[ bIdx ];
+    }
+
+    return bIdx;
+}
+
+
+/** @brief Insert a buffer into a list.
+ *
+ *  The buffer must not be on any list.
+ *
+ *  @param bIdx     The index of the buffer to insert.
+ *  @param bList    The list into which the buffer is inserted.
+ *  @param fHead    Whether to insert the buffer at the head (MRU) of the list;
+ *                  if false, it is inserted at the tail (LRU).
+ */
+static void BufferListInsert( uint8_t bIdx,
+                              uint8_t bList,
+                              bool fHead )
+{
+    BUFFERLIST * pList = &gBufCtx.aList[ bList ];
+
+    if( pList->bHead == BIDX_NONE )
+    {
+        gBufCtx.abMruNext[ bIdx ] = BIDX_NONE;
+        gBufCtx.abMruPrev[ bIdx ] = BIDX_NONE;
+        pList->bHead = bIdx;
+        pList->bTail = bIdx;
+    }
+    else if( fHead )
+    {
+        gBufCtx.abMruNext[ bIdx ] = pList->bHead;
+        gBufCtx.abMruPrev[ bIdx ] = BIDX_NONE;
+        gBufCtx.abMruPrev[ pList->bHead ] = bIdx;
+        pList->bHead = bIdx;
     }
     else
     {
-        /*  Buffer already LRU, nothing to do.
-         */
+        gBufCtx.abMruPrev[ bIdx ] = pList->bTail;
+        gBufCtx.abMruNext[ bIdx ] = BIDX_NONE;
+        gBufCtx.abMruNext[ pList->bTail ] = bIdx;
+        pList->bTail = bIdx;
     }
+
+    pList->bCount++;
+
+    #if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+        gBufCtx.abList[ bIdx ] = bList;
+    #endif
 }
 
 
-/** @brief Mark a buffer as most recently used.
+/** @brief Remove a buffer from the list it is on.
  *
- *  @param bIdx The index of the buffer to make MRU.
+ *  The buffer must be reinserted into a list by the caller.
+ *
+ *  @param bIdx The index of the buffer to remove.
  */
-static void BufferMakeMRU( uint8_t bIdx )
+static void BufferListRemove( uint8_t bIdx )
 {
-    if( bIdx >= REDCONF_BUFFER_COUNT )
+    uint8_t bNext = gBufCtx.abMruNext[ bIdx ];
+    uint8_t bPrev = gBufCtx.abMruPrev[ bIdx ];
+    BUFFERLIST * pList;
+
+    #if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+        pList = &gBufCtx.aList[ gBufCtx.abList[ bIdx ] ];
+    #else
+        pList = &gBufCtx.aList[ BLIST_MAIN ];
+    #endif
+
+    if( bPrev == BIDX_NONE )
     {
-        REDERROR();
+        pList->bHead = bNext;
     }
-    else if( bIdx != gBufCtx.abMRU[ 0U ] )
+    else
     {
-        uint8_t bMruIdx;
+        gBufCtx.abMruNext[ bPrev ] = bNext;
+    }
 
-        /*  Find the current position of the buffer in the MRU array.  We do not
-         *  need to check the first slot, since we already know from the above
-         *  check that the index is not there.
-         */
-        for( bMruIdx = 1U; bMruIdx < REDCONF_BUFFER_COUNT; bMruIdx++ )
+    if( bNext == BIDX_NONE )
+    {
+        pList->bTail = bPrev;
+    }
+    else
+    {
+        gBufCtx.abMruPrev[ bNext ] = bPrev;
+    }
+
+    REDASSERT( pList->bCount > 0U );
+    pList->bCount--;
+}
+
+
+#if REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q
+
+/** @brief Remember a block which is being evicted from the probation list.
+ *
+ *  @param bIdx The index of the buffer being evicted.
+ */
+    static void BufferGhostAdd( uint8_t bIdx )
+    {
+        BUFFERGHOST * pGhost = &gBufCtx.aGhost[ gBufCtx.bGhostNext ];
+
+        pGhost->ulBlock = gBufCtx.aHead[ bIdx ].ulBlock;
+        pGhost->bVolNum = gBufCtx.aHead[ bIdx ].bVolNum;
+
+        gBufCtx.bGhostNext++;
+
+        if( gBufCtx.bGhostNext == BUFFER_2Q_GHOSTS )
+        {
+            gBufCtx.bGhostNext = 0U;
+        }
+    }
+
+
+/** @brief Determine whether a block was recently evicted from the probation
+ *         list, forgetting it if so.
+ *
+ *  @param bVolNum  The volume number of the block.
+ *  @param ulBlock  The block number.
+ *
+ *  @return Whether the block was recently evicted from the probation list.
+ */
+    static bool BufferGhostRemove( uint8_t bVolNum,
+                                   uint32_t ulBlock )
+    {
+        bool fFound = false;
+        uint8_t bGhost;
+
+        for( bGhost = 0U; bGhost < BUFFER_2Q_GHOSTS; bGhost++ )
         {
-            if( bIdx == gBufCtx.abMRU[ bMruIdx ] )
+            BUFFERGHOST * pGhost = &gBufCtx.aGhost[ bGhost ];
+
+            if( ( pGhost->ulBlock == ulBlock ) && ( pGhost->bVolNum == bVolNum ) )
             {
+                pGhost->ulBlock = BBLK_INVALID;
+                fFound = true;
                 break;
             }
         }
 
-        if( bMruIdx < REDCONF_BUFFER_COUNT )
-        {
-            /*  Move the buffer index to the front of the MRU array, making it
-             *  the MRU buffer.
-             */
-            RedMemMove( &gBufCtx.abMRU[ 1U ], &gBufCtx.abMRU[ 0U ], bMruIdx );
-            gBufCtx.abMRU[ 0U ] = bIdx;
-        }
-        else
-        {
-            REDERROR();
-        }
-    }
-    else
-    {
-        /*  Buffer already MRU, nothing to do.
-         */
+        return fFound;
     }
-}
+
+#endif /* REDCONF_BUFFER_POLICY == BUFFER_POLICY_2Q */
 
 
 /** @brief Find a block in the buffers.
@@ -1199,7 +2749,13 @@ static bool BufferFind( uint32_t ulBlock,
     {
         uint8_t bIdx;
 
-        for( bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++ )
+        #if REDCONF_BUFFER_HASH == 1
+            for( bIdx = gBufCtx.abHashBucket[ BufferHash( gbRedVolNum, ulBlock ) ];
+                 bIdx != BIDX_NONE;
+                 bIdx = gBufCtx.abHashNext[ bIdx ] )
+        #else
+            for( bIdx = 0U; bIdx < REDCONF_BUFFER_COUNT; bIdx++ )
+        #endif
         {
             const BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
 
@@ -1214,3 +2770,76 @@ static bool BufferFind( uint32_t ulBlock,
 
     return ret;
 }
+
+
+/** @brief Associate a buffer with a block.
+ *
+ *  All changes to the block number of a buffer go through this function, so
+ *  that the hash index (when enabled) always reflects the buffer heads.
+ *
+ *  @param bIdx     The index of the buffer to update.
+ *  @param bVolNum  The volume the block resides on.
+ *  @param ulBlock  The block number, or BBLK_INVALID to mark the buffer as not
+ *                  associated with any block.
+ */
+static void BufferSetBlock( uint8_t bIdx,
+                            uint8_t bVolNum,
+                            uint32_t ulBlock )
+{
+    BUFFERHEAD * pHead = &gBufCtx.aHead[ bIdx ];
+
+    #if REDCONF_BUFFER_HASH == 1
+        if( pHead->ulBlock != BBLK_INVALID )
+        {
+            uint8_t * pbLink = &gBufCtx.abHashBucket[ BufferHash( pHead->bVolNum, pHead->ulBlock ) ];
+
+            /*  Unlink the buffer from the chain for its old block.
+             */
+            while( ( *pbLink != bIdx ) && ( *pbLink != BIDX_NONE ) )
+            {
+                pbLink = &gBufCtx.abHashNext[ *pbLink ];
+            }
+
+            REDASSERT( *pbLink == bIdx );
+
+            if( *pbLink == bIdx )
+            {
+                *pbLink = gBufCtx.abHashNext[ bIdx ];
+            }
+        }
+
+        if( ulBlock != BBLK_INVALID )
+        {
+            uint8_t bBucket = BufferHash( bVolNum, ulBlock );
+
+            gBufCtx.abHashNext[ bIdx ] = gBufCtx.abHashBucket[ bBucket ];
+            gBufCtx.abHashBucket[ bBucket ] = bIdx;
+        }
+    #endif /* if REDCONF_BUFFER_HASH == 1 */
+
+    pHead->bVolNum = bVolNum;
+    pHead->ulBlock = ulBlock;
+}
+
+
+#if REDCONF_BUFFER_HASH == 1
+
+/** @brief Compute the hash bucket for a block.
+ *
+ *  Uses Fibonacci (multiplicative) hashing, which spreads the runs of
+ *  consecutive block numbers that are typical of file data and metadata
+ *  across all the buckets.
+ *
+ *  @param bVolNum  The volume the block resides on.
+ *  @param ulBlock  The block number.
+ *
+ *  @return The index of the hash bucket for the block.
+ */
+    static uint8_t BufferHash( uint8_t bVolNum,
+                               uint32_t ulBlock )
+    {
+        uint32_t ulKey = ulBlock ^ ( ( uint32_t ) bVolNum << 24U );
+
+        return ( uint8_t ) ( ( ulKey * 0x9E3779B1U ) >> ( 32U - BUFFER_HASH_SHIFT ) );
+    }
+#endif /* REDCONF_BUFFER_HASH == 1 */
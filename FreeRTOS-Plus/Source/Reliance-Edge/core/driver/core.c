@@ -65,11 +65,28 @@
                                     uint64_t ullStart,
                                     uint32_t * pulLen,
                                     const void * pBuffer );
+    static REDSTATUS CoreFileWritev( uint32_t ulInode,
+                                     uint64_t ullStart,
+                                     const REDIOVEC * paIov,
+                                     uint32_t ulIovCount,
+                                     uint32_t * pulLen );
 #endif
+static REDSTATUS CoreIovTotal( const REDIOVEC * paIov,
+                               uint32_t ulIovCount,
+                               uint32_t * pulTotal );
 #if TRUNCATE_SUPPORTED
     static REDSTATUS CoreFileTruncate( uint32_t ulInode,
                                        uint64_t ullSize );
 #endif
+#if REDCONF_READ_ONLY == 0
+    static REDSTATUS CoreFileAllocate( uint32_t ulInode,
+                                       uint64_t ullStart,
+                                       uint64_t ullLen );
+#endif
+#if REDCONF_FINE_LOCKING == 1
+    static REDSTATUS CoreSemaphoresInit( void );
+    static void CoreSemaphoresUninit( uint8_t bSemCount );
+#endif
 
 
 VOLUME gaRedVolume[ REDCONF_VOLUME_COUNT ];
@@ -119,6 +136,9 @@ REDSTATUS RedCoreInit( void )
 
     RedMemSet( gaRedVolume, 0U, sizeof( gaRedVolume ) );
     RedMemSet( gaCoreVol, 0U, sizeof( gaCoreVol ) );
+    #if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+        RedDcacheInit();
+    #endif
 
     RedBufferInit();
 
@@ -290,6 +310,18 @@ REDSTATUS RedCoreInit( void )
             {
                 ret = RedOsMutexInit();
 
+                #if REDCONF_FINE_LOCKING == 1
+                    if( ret == 0 )
+                    {
+                        ret = CoreSemaphoresInit();
+
+                        if( ret != 0 )
+                        {
+                            ( void ) RedOsMutexUninit();
+                        }
+                    }
+                #endif
+
                 if( ret != 0 )
                 {
                     ( void ) RedOsClockUninit();
@@ -321,6 +353,10 @@ REDSTATUS RedCoreUninit( void )
     REDSTATUS ret;
 
     #if REDCONF_TASK_COUNT > 1U
+        #if REDCONF_FINE_LOCKING == 1
+            CoreSemaphoresUninit( RED_SEM_COUNT );
+        #endif
+
         ret = RedOsMutexUninit();
 
         if( ret == 0 )
@@ -427,14 +463,30 @@ REDSTATUS RedCoreVolMount( void )
  *  @return A negated ::REDSTATUS code indicating the operation result.
  *
  *  @retval 0           Operation was successful.
+ *  @retval -RED_EBUSY  A read lease on the volume has not been released; or a
+ *                      snapshot of the volume is open.
  *  @retval -RED_EIO    I/O error during unmount automatic transaction point.
  */
 REDSTATUS RedCoreVolUnmount( void )
 {
     REDSTATUS ret = 0;
 
+    #if REDCONF_READ_LEASES > 0U
+        if( RedBufferLeased() )
+        {
+            ret = -RED_EBUSY;
+        }
+    #endif
+
+    #if REDCONF_SNAPSHOTS > 0U
+        if( ( ret == 0 ) && RedSnapInUse() )
+        {
+            ret = -RED_EBUSY;
+        }
+    #endif
+
     #if REDCONF_READ_ONLY == 0
-        if( !gpRedVolume->fReadOnly && ( ( gpRedVolume->ulTransMask & RED_TRANSACT_UMOUNT ) != 0U ) )
+        if( ( ret == 0 ) && !gpRedVolume->fReadOnly && ( ( gpRedVolume->ulTransMask & RED_TRANSACT_UMOUNT ) != 0U ) )
         {
             ret = RedVolTransact();
         }
@@ -445,6 +497,27 @@ REDSTATUS RedCoreVolUnmount( void )
         ret = RedBufferDiscardRange( 0U, gpRedVolume->ulBlockCount );
     }
 
+    #if ( REDCONF_API_POSIX == 1 ) && ( REDCONF_DIR_INDEX_DIRS > 0U )
+        if( ret == 0 )
+        {
+            RedDirIndexDiscard();
+        }
+    #endif
+
+    #if REDCONF_READ_AHEAD_BLOCKS > 0U
+        if( ret == 0 )
+        {
+            RedInodeReadAheadDiscard();
+        }
+    #endif
+
+    #if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+        if( ret == 0 )
+        {
+            RedDcacheDiscard();
+        }
+    #endif
+
     if( ret == 0 )
     {
         ret = RedOsBDevClose( gbRedVolNum );
@@ -497,9 +570,79 @@ REDSTATUS RedCoreVolUnmount( void )
 
         return ret;
     }
+
+
+/** @brief Commit a transaction point for an automatic transaction event.
+ *
+ *  Same as RedCoreVolTransact(), except that with background transactions the
+ *  transaction point is deferred to the commit task.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The volume is not mounted.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EROFS  The file system volume is read-only.
+ */
+    REDSTATUS RedCoreVolTransactAuto( void )
+    {
+        REDSTATUS ret;
+
+        if( !gpRedVolume->fMounted )
+        {
+            ret = -RED_EINVAL;
+        }
+        else if( gpRedVolume->fReadOnly )
+        {
+            ret = -RED_EROFS;
+        }
+        else
+        {
+            ret = RedVolTransactAuto();
+        }
+
+        return ret;
+    }
 #endif /* REDCONF_READ_ONLY == 0 */
 
 
+#if REDCONF_TRANSACT_BACKGROUND == 1
+
+/** @brief Commit the transaction point deferred to the background commit task,
+ *         if there is one.
+ *
+ *  Once this returns successfully, every automatic transaction event which
+ *  occurred beforehand is durable.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The volume is not mounted.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+    REDSTATUS RedCoreVolTransactPending( void )
+    {
+        REDSTATUS ret = 0;
+
+        if( !gpRedVolume->fMounted )
+        {
+            ret = -RED_EINVAL;
+        }
+        else if( gpRedCoreVol->fTransactPending && !gpRedVolume->fReadOnly )
+        {
+            ret = RedVolTransact();
+        }
+        else
+        {
+            /*  Nothing to commit.
+             */
+        }
+
+        return ret;
+    }
+#endif /* REDCONF_TRANSACT_BACKGROUND == 1 */
+
+
 #if REDCONF_API_POSIX == 1
 
 /** @brief Query file system status information.
@@ -526,9 +669,9 @@ REDSTATUS RedCoreVolUnmount( void )
             pStatFS->f_frsize = REDCONF_BLOCK_SIZE;
             pStatFS->f_blocks = gpRedVolume->ulBlockCount;
             #if RESERVED_BLOCKS > 0U
-                pStatFS->f_bfree = ( gpRedMR->ulFreeBlocks > RESERVED_BLOCKS ) ? ( gpRedMR->ulFreeBlocks - RESERVED_BLOCKS ) : 0U;
+                pStatFS->f_bfree = ( RedImapFreeCount() > RESERVED_BLOCKS ) ? ( RedImapFreeCount() - RESERVED_BLOCKS ) : 0U;
             #else
-                pStatFS->f_bfree = gpRedMR->ulFreeBlocks;
+                pStatFS->f_bfree = RedImapFreeCount();
             #endif
             pStatFS->f_bavail = pStatFS->f_bfree;
             pStatFS->f_files = gpRedVolConf->ulInodeCount;
@@ -555,6 +698,108 @@ REDSTATUS RedCoreVolUnmount( void )
 #endif /* REDCONF_API_POSIX == 1 */
 
 
+#if REDCONF_FINE_LOCKING == 1
+
+/** @brief Enable or disable unlocked reads for the operation in progress.
+ *
+ *  An unlocked read is a block device read during which the FS mutex is
+ *  released, so that other tasks can use the file system while the read is in
+ *  progress.  The caller must hold the lock for the current volume shared when
+ *  enabling unlocked reads, so that no other task modifies the volume in the
+ *  meantime; and must disable them before releasing the FS mutex.
+ *
+ *  @param fEnable  Whether unlocked reads are allowed.
+ */
+    void RedCoreUnlockedReads( bool fEnable )
+    {
+        RedBufferUnlockedReads( fEnable );
+    }
+#endif /* REDCONF_FINE_LOCKING == 1 */
+
+
+/** @brief Query block buffer cache statistics.
+ *
+ *  The block buffers are shared by all volumes, so the statistics are not
+ *  specific to the current volume.
+ *
+ *  @param pStat    The buffer to populate with the statistics.
+ *  @param fReset   Whether to reset the statistics to zero after they have
+ *                  been retrieved.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL @p pStat is `NULL`.
+ */
+REDSTATUS RedCoreBufferStat( REDBUFSTAT * pStat,
+                             bool fReset )
+{
+    REDSTATUS ret;
+
+    if( pStat == NULL )
+    {
+        ret = -RED_EINVAL;
+    }
+    else
+    {
+        RedBufferStat( pStat, fReset );
+        ret = 0;
+    }
+
+    return ret;
+}
+
+
+#if REDCONF_STATISTICS == 1
+
+/** @brief Record the completion of an API call in the statistics.
+ *
+ *  @param bOp      The operation: one of the RED_STATOP_* values.
+ *  @param tsStart  The timestamp from when the call started, before it
+ *                  acquired any locks.
+ *  @param iResult  The result of the call.
+ */
+    void RedCoreStatOp( uint8_t bOp,
+                        REDTIMESTAMP tsStart,
+                        REDSTATUS iResult )
+    {
+        RedStatOp( bOp, tsStart, iResult != 0 );
+    }
+
+
+/** @brief Query the file system statistics.
+ *
+ *  The statistics are not specific to the current volume.
+ *
+ *  @param pStats   The buffer to populate with the statistics.
+ *  @param fReset   Whether to reset the statistics to zero after they have
+ *                  been retrieved.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL @p pStats is `NULL`.
+ */
+    REDSTATUS RedCoreStats( REDSTATS * pStats,
+                            bool fReset )
+    {
+        REDSTATUS ret;
+
+        if( pStats == NULL )
+        {
+            ret = -RED_EINVAL;
+        }
+        else
+        {
+            RedStatGet( pStats, fReset );
+            ret = 0;
+        }
+
+        return ret;
+    }
+#endif /* REDCONF_STATISTICS == 1 */
+
+
 #if ( REDCONF_READ_ONLY == 0 ) && ( ( REDCONF_API_POSIX == 1 ) || ( REDCONF_API_FSE_TRANSMASKSET == 1 ) )
 
 /** @brief Update the transaction mask.
@@ -719,11 +964,11 @@ REDSTATUS RedCoreVolUnmount( void )
             {
                 if( fDir && ( ( gpRedVolume->ulTransMask & RED_TRANSACT_MKDIR ) != 0U ) )
                 {
-                    ret = RedVolTransact();
+                    ret = RedVolTransactAuto();
                 }
                 else if( !fDir && ( ( gpRedVolume->ulTransMask & RED_TRANSACT_CREAT ) != 0U ) )
                 {
-                    ret = RedVolTransact();
+                    ret = RedVolTransactAuto();
                 }
                 else
                 {
@@ -814,6 +1059,17 @@ REDSTATUS RedCoreVolUnmount( void )
 
                 RedInodePut( &pino, ( ret == 0 ) ? ( uint8_t ) ( IPUT_UPDATE_MTIME | IPUT_UPDATE_CTIME ) : 0U );
             }
+
+            #if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+                if( ret == 0 )
+                {
+                    RedDcacheInsert( ulPInode, pszName, *pulInode );
+                }
+                else
+                {
+                    RedDcacheInvalidate( ulPInode, pszName );
+                }
+            #endif
         }
 
         return ret;
@@ -890,7 +1146,7 @@ REDSTATUS RedCoreVolUnmount( void )
 
             if( ( ret == 0 ) && ( ( gpRedVolume->ulTransMask & RED_TRANSACT_LINK ) != 0U ) )
             {
-                ret = RedVolTransact();
+                ret = RedVolTransactAuto();
             }
         }
 
@@ -986,6 +1242,17 @@ REDSTATUS RedCoreVolUnmount( void )
 
                 RedInodePut( &pino, ( ret == 0 ) ? ( uint8_t ) ( IPUT_UPDATE_MTIME | IPUT_UPDATE_CTIME ) : 0U );
             }
+
+            #if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+                if( ret == 0 )
+                {
+                    RedDcacheInsert( ulPInode, pszName, ulInode );
+                }
+                else
+                {
+                    RedDcacheInvalidate( ulPInode, pszName );
+                }
+            #endif
         }
 
         return ret;
@@ -1065,7 +1332,7 @@ REDSTATUS RedCoreVolUnmount( void )
 
             if( ( ret == 0 ) && ( ( gpRedVolume->ulTransMask & RED_TRANSACT_UNLINK ) != 0U ) )
             {
-                ret = RedVolTransact();
+                ret = RedVolTransactAuto();
             }
         }
 
@@ -1160,6 +1427,17 @@ REDSTATUS RedCoreVolUnmount( void )
 
                                 ret = RedInodeLinkDec( &ino );
                                 CRITICAL_ASSERT( ret == 0 );
+
+                                #if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+                                    if( ino.fDirectory )
+                                    {
+                                        /*  The directory was empty, but there
+                                         *  may be cached lookups of names which
+                                         *  did not exist in it.
+                                         */
+                                        RedDcachePurge( ulInode );
+                                    }
+                                #endif
                             }
                         }
 
@@ -1169,6 +1447,10 @@ REDSTATUS RedCoreVolUnmount( void )
 
                 RedInodePut( &pino, ( ret == 0 ) ? ( uint8_t ) ( IPUT_UPDATE_MTIME | IPUT_UPDATE_CTIME ) : 0U );
             }
+
+            #if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+                RedDcacheInvalidate( ulPInode, pszName );
+            #endif
         }
 
         return ret;
@@ -1208,16 +1490,51 @@ REDSTATUS RedCoreVolUnmount( void )
         }
         else
         {
-            CINODE ino;
-
-            ino.ulInode = ulPInode;
-            ret = RedInodeMount( &ino, FTYPE_DIR, false );
+            #if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+                uint32_t ulCachedInode;
 
-            if( ret == 0 )
+                if( RedDcacheLookup( ulPInode, pszName, &ulCachedInode ) )
+                {
+                    if( ulCachedInode == INODE_INVALID )
+                    {
+                        ret = -RED_ENOENT;
+                    }
+                    else
+                    {
+                        *pulInode = ulCachedInode;
+                        ret = 0;
+                    }
+                }
+                else
+            #endif /* if REDCONF_DENTRY_CACHE_ENTRIES > 0U */
             {
-                ret = RedDirEntryLookup( &ino, pszName, NULL, pulInode );
+                CINODE ino;
 
-                RedInodePut( &ino, 0U );
+                ino.ulInode = ulPInode;
+                ret = RedInodeMount( &ino, FTYPE_DIR, false );
+
+                if( ret == 0 )
+                {
+                    ret = RedDirEntryLookup( &ino, pszName, NULL, pulInode );
+
+                    RedInodePut( &ino, 0U );
+                }
+
+                #if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+                    if( ret == 0 )
+                    {
+                        RedDcacheInsert( ulPInode, pszName, *pulInode );
+                    }
+                    else if( ret == -RED_ENOENT )
+                    {
+                        RedDcacheInsert( ulPInode, pszName, INODE_INVALID );
+                    }
+                    else
+                    {
+                        /*  Errors other than a missing name are not cached.
+                         */
+                    }
+                #endif
             }
         }
 
@@ -1316,7 +1633,7 @@ REDSTATUS RedCoreVolUnmount( void )
 
             if( ( ret == 0 ) && ( ( gpRedVolume->ulTransMask & RED_TRANSACT_RENAME ) != 0U ) )
             {
-                ret = RedVolTransact();
+                ret = RedVolTransactAuto();
             }
         }
 
@@ -1429,6 +1746,16 @@ REDSTATUS RedCoreVolUnmount( void )
                     }
 
                     #if REDCONF_RENAME_ATOMIC == 1
+                        #if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+                            if( fUpdateTimestamps && ( DstInode.ulInode != INODE_INVALID ) && DstInode.fDirectory )
+                            {
+                                /*  The replaced destination was an empty
+                                 *  directory, and has been deleted.
+                                 */
+                                RedDcachePurge( DstInode.ulInode );
+                            }
+                        #endif
+
                         RedInodePut( &DstInode, 0U );
                     #endif
 
@@ -1442,6 +1769,11 @@ REDSTATUS RedCoreVolUnmount( void )
             }
 
             RedInodePut( &SrcPInode, fUpdateTimestamps ? ( uint8_t ) ( IPUT_UPDATE_MTIME | IPUT_UPDATE_CTIME ) : 0U );
+
+            #if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+                RedDcacheInvalidate( ulSrcPInode, pszSrcName );
+                RedDcacheInvalidate( ulDstPInode, pszDstName );
+            #endif
         }
 
         return ret;
@@ -1488,7 +1820,7 @@ REDSTATUS RedCoreVolUnmount( void )
 
                 pStat->st_dev = gbRedVolNum;
                 pStat->st_ino = ulInode;
-                pStat->st_mode = ino.pInodeBuf->uMode;
+                pStat->st_mode = ( uint16_t ) ( ino.pInodeBuf->uMode & ~INODE_MODE_INLINE );
                 #if REDCONF_API_POSIX_LINK == 1
                     pStat->st_nlink = ino.pInodeBuf->uNLink;
                 #else
@@ -1623,53 +1955,288 @@ REDSTATUS RedCoreFileRead( uint32_t ulInode,
 }
 
 
-#if REDCONF_READ_ONLY == 0
-
-/** @brief Write to a file.
- *
- *  If the write extends beyond the end-of-file, the file size will be
- *  increased.
+/** @brief Read from a file into several buffers.
  *
- *  A short write -- where the number of bytes written is less than requested
- *  -- indicates either that the file system ran out of space but was still
- *  able to write some of the request; or that the request would have caused
- *  the file to exceed the maximum file size, but some of the data could be
- *  written prior to the file size limit.
- *
- *  If an error is returned, either none of the data was written or a critical
- *  error occurred (like an I/O error) and the file system volume will be
- *  read-only.
+ *  Equivalent to reading into each buffer in turn with RedCoreFileRead(),
+ *  starting each read where the last one ended, except that the inode is
+ *  mounted once for the whole request.  The read stops early at the
+ *  end-of-file.
  *
- *  @param ulInode  The file number of the file to write.
- *  @param ullStart The file offset to write at.
- *  @param pulLen   On entry, the number of bytes to write; on successful exit,
- *                  the number of bytes actually written.
- *  @param pBuffer  The buffer containing the data to be written.  Must big
- *                  enough for the write request.
+ *  @param ulInode      The file number of the file to read.
+ *  @param ullStart     The file offset to read from.
+ *  @param paIov        The buffers to populate with the data read.
+ *  @param ulIovCount   The number of elements in @p paIov.
+ *  @param pulLen       On successful exit, the total number of bytes read.
  *
  *  @return A negated ::REDSTATUS code indicating the operation result.
  *
  *  @retval 0           Operation was successful.
- *  @retval -RED_EBADF  @p ulInode is not a valid file number.
- *  @retval -RED_EFBIG  No data can be written to the given file offset since
- *                      the resulting file size would exceed the maximum file
- *                      size.
- *  @retval -RED_EINVAL The volume is not mounted; or @p pBuffer is `NULL`.
+ *  @retval -RED_EBADF  @p ulInode is not a valid inode number.
+ *  @retval -RED_EINVAL The volume is not mounted; or @p paIov or @p pulLen is
+ *                      `NULL`; or @p ulIovCount is zero; or a buffer with a
+ *                      nonzero length is `NULL`; or the total length exceeds
+ *                      INT32_MAX.
  *  @retval -RED_EIO    A disk I/O error occurred.
  *  @retval -RED_EISDIR The inode is a directory inode.
- *  @retval -RED_ENOSPC No data can be written because there is insufficient
- *                      free space.
- *  @retval -RED_EROFS  The file system volume is read-only.
  */
-    REDSTATUS RedCoreFileWrite( uint32_t ulInode,
-                                uint64_t ullStart,
-                                uint32_t * pulLen,
-                                const void * pBuffer )
+REDSTATUS RedCoreFileReadv( uint32_t ulInode,
+                            uint64_t ullStart,
+                            const REDIOVEC * paIov,
+                            uint32_t ulIovCount,
+                            uint32_t * pulLen )
+{
+    uint32_t ulRequested = 0U;
+    REDSTATUS ret;
+
+    if( !gpRedVolume->fMounted || ( pulLen == NULL ) )
     {
-        REDSTATUS ret;
+        ret = -RED_EINVAL;
+    }
+    else
+    {
+        ret = CoreIovTotal( paIov, ulIovCount, &ulRequested );
+    }
 
-        if( !gpRedVolume->fMounted )
-        {
+    if( ret == 0 )
+    {
+        #if ( REDCONF_ATIME == 1 ) && ( REDCONF_READ_ONLY == 0 )
+            bool fUpdateAtime = ( ulRequested > 0U ) && !gpRedVolume->fReadOnly;
+        #else
+            bool fUpdateAtime = false;
+        #endif
+        CINODE ino;
+
+        ino.ulInode = ulInode;
+        ret = RedInodeMount( &ino, FTYPE_FILE, fUpdateAtime );
+
+        if( ret == 0 )
+        {
+            uint32_t ulTotal = 0U;
+            uint32_t ulIov;
+
+            for( ulIov = 0U; ulIov < ulIovCount; ulIov++ )
+            {
+                uint32_t ulLen = paIov[ ulIov ].iov_len;
+
+                if( ulLen > 0U )
+                {
+                    ret = RedInodeDataRead( &ino, ullStart + ulTotal, &ulLen, paIov[ ulIov ].iov_base );
+
+                    if( ret != 0 )
+                    {
+                        break;
+                    }
+
+                    ulTotal += ulLen;
+
+                    if( ulLen < paIov[ ulIov ].iov_len )
+                    {
+                        /*  Reached the end-of-file.
+                         */
+                        break;
+                    }
+                }
+            }
+
+            if( ret == 0 )
+            {
+                *pulLen = ulTotal;
+            }
+
+            #if ( REDCONF_ATIME == 1 ) && ( REDCONF_READ_ONLY == 0 )
+                RedInodePut( &ino, ( ( ret == 0 ) && fUpdateAtime ) ? IPUT_UPDATE_ATIME : 0U );
+            #else
+                RedInodePut( &ino, 0U );
+            #endif
+        }
+    }
+
+    return ret;
+}
+
+
+#if REDCONF_READ_LEASES > 0U
+
+/** @brief Lease data from a file, without copying it.
+ *
+ *  The data is lent from the buffer cache: at most the rest of the block
+ *  containing @p ullStart is leased, and the buffer remains unavailable to
+ *  the file system until RedCoreLeaseRelease() is called.  The leased data is
+ *  a private snapshot: it is unaffected by later changes to the file.
+ *
+ *  @param ulInode  The inode number of the file to read.
+ *  @param ullStart The file offset to read from.
+ *  @param pulLen   On entry, contains the maximum number of bytes to lease; on
+ *                  successful exit, contains the number of bytes leased, which
+ *                  is zero at or beyond the end-of-file.
+ *  @param ppData   On successful exit with a nonzero length, populated with a
+ *                  pointer to the leased data.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBADF  @p ulInode is not a valid inode number.
+ *  @retval -RED_EBUSY  The maximum number of leases are outstanding.
+ *  @retval -RED_EINVAL The volume is not mounted; or @p pulLen or @p ppData
+ *                      is `NULL`.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EISDIR The inode is a directory inode.
+ */
+    REDSTATUS RedCoreFileLease( uint32_t ulInode,
+                                uint64_t ullStart,
+                                uint32_t * pulLen,
+                                const void ** ppData )
+    {
+        REDSTATUS ret;
+
+        if( !gpRedVolume->fMounted || ( pulLen == NULL ) )
+        {
+            ret = -RED_EINVAL;
+        }
+        else
+        {
+            #if ( REDCONF_ATIME == 1 ) && ( REDCONF_READ_ONLY == 0 )
+                bool fUpdateAtime = ( *pulLen > 0U ) && !gpRedVolume->fReadOnly;
+            #else
+                bool fUpdateAtime = false;
+            #endif
+            CINODE ino;
+
+            ino.ulInode = ulInode;
+            ret = RedInodeMount( &ino, FTYPE_FILE, fUpdateAtime );
+
+            if( ret == 0 )
+            {
+                ret = RedInodeDataLease( &ino, ullStart, pulLen, ppData );
+
+                #if ( REDCONF_ATIME == 1 ) && ( REDCONF_READ_ONLY == 0 )
+                    RedInodePut( &ino, ( ( ret == 0 ) && fUpdateAtime ) ? IPUT_UPDATE_ATIME : 0U );
+                #else
+                    RedInodePut( &ino, 0U );
+                #endif
+            }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Release data leased by RedCoreFileLease().
+ *
+ *  @param pData    The pointer returned by RedCoreFileLease().
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL @p pData is not leased data.
+ */
+    REDSTATUS RedCoreLeaseRelease( const void * pData )
+    {
+        return RedBufferLeaseRelease( pData );
+    }
+#endif /* REDCONF_READ_LEASES > 0U */
+
+
+/** @brief Validate the buffers of a vectored read or write and total their
+ *         lengths.
+ *
+ *  @param paIov        The buffers.
+ *  @param ulIovCount   The number of elements in @p paIov.
+ *  @param pulTotal     On successful exit, the total length of the buffers.
+ *                      May be `NULL` if the total is not needed.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           The buffers are valid.
+ *  @retval -RED_EINVAL @p paIov is `NULL`; or @p ulIovCount is zero; or a
+ *                      buffer with a nonzero length is `NULL`; or the total
+ *                      length exceeds INT32_MAX, and so could not be returned
+ *                      by the APIs.
+ */
+static REDSTATUS CoreIovTotal( const REDIOVEC * paIov,
+                               uint32_t ulIovCount,
+                               uint32_t * pulTotal )
+{
+    REDSTATUS ret = 0;
+
+    if( ( paIov == NULL ) || ( ulIovCount == 0U ) )
+    {
+        ret = -RED_EINVAL;
+    }
+    else
+    {
+        uint32_t ulTotal = 0U;
+        uint32_t ulIov;
+
+        for( ulIov = 0U; ulIov < ulIovCount; ulIov++ )
+        {
+            if( ( paIov[ ulIov ].iov_len > ( ( uint32_t ) INT32_MAX - ulTotal ) ) ||
+                ( ( paIov[ ulIov ].iov_base == NULL ) && ( paIov[ ulIov ].iov_len > 0U ) ) )
+            {
+                ret = -RED_EINVAL;
+                break;
+            }
+
+            ulTotal += paIov[ ulIov ].iov_len;
+        }
+
+        if( ( ret == 0 ) && ( pulTotal != NULL ) )
+        {
+            *pulTotal = ulTotal;
+        }
+    }
+
+    return ret;
+}
+
+
+#if REDCONF_READ_ONLY == 0
+
+/** @brief Write to a file.
+ *
+ *  If the write extends beyond the end-of-file, the file size will be
+ *  increased.
+ *
+ *  A short write -- where the number of bytes written is less than requested
+ *  -- indicates either that the file system ran out of space but was still
+ *  able to write some of the request; or that the request would have caused
+ *  the file to exceed the maximum file size, but some of the data could be
+ *  written prior to the file size limit.
+ *
+ *  If an error is returned, either none of the data was written or a critical
+ *  error occurred (like an I/O error) and the file system volume will be
+ *  read-only.
+ *
+ *  @param ulInode  The file number of the file to write.
+ *  @param ullStart The file offset to write at.
+ *  @param pulLen   On entry, the number of bytes to write; on successful exit,
+ *                  the number of bytes actually written.
+ *  @param pBuffer  The buffer containing the data to be written.  Must big
+ *                  enough for the write request.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBADF  @p ulInode is not a valid file number.
+ *  @retval -RED_EFBIG  No data can be written to the given file offset since
+ *                      the resulting file size would exceed the maximum file
+ *                      size.
+ *  @retval -RED_EINVAL The volume is not mounted; or @p pBuffer is `NULL`.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EISDIR The inode is a directory inode.
+ *  @retval -RED_ENOSPC No data can be written because there is insufficient
+ *                      free space.
+ *  @retval -RED_EROFS  The file system volume is read-only.
+ */
+    REDSTATUS RedCoreFileWrite( uint32_t ulInode,
+                                uint64_t ullStart,
+                                uint32_t * pulLen,
+                                const void * pBuffer )
+    {
+        REDSTATUS ret;
+
+        if( !gpRedVolume->fMounted )
+        {
             ret = -RED_EINVAL;
         }
         else if( gpRedVolume->fReadOnly )
@@ -1693,8 +2260,95 @@ REDSTATUS RedCoreFileRead( uint32_t ulInode,
             }
 
             if( ( ret == 0 ) && ( ( gpRedVolume->ulTransMask & RED_TRANSACT_WRITE ) != 0U ) )
+            {
+                ret = RedVolTransactAuto();
+            }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Write to a file from several buffers.
+ *
+ *  Equivalent to writing each buffer in turn with RedCoreFileWrite(), starting
+ *  each write where the last one ended, except that the inode is mounted once
+ *  and the #RED_TRANSACT_WRITE automatic transaction, if enabled, happens once
+ *  for the whole request.
+ *
+ *  A short write -- where the number of bytes written is less than requested
+ *  -- indicates either that the file system ran out of space but was still
+ *  able to write some of the request; or that the request would have caused
+ *  the file to exceed the maximum file size, but some of the data could be
+ *  written prior to the file size limit.
+ *
+ *  If an error is returned, either none of the data was written or a critical
+ *  error occurred (like an I/O error) and the file system volume will be
+ *  read-only.
+ *
+ *  @param ulInode      The file number of the file to write.
+ *  @param ullStart     The file offset to write at.
+ *  @param paIov        The buffers containing the data to be written.
+ *  @param ulIovCount   The number of elements in @p paIov.
+ *  @param pulLen       On successful exit, the total number of bytes written.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBADF  @p ulInode is not a valid file number.
+ *  @retval -RED_EFBIG  No data can be written to the given file offset since
+ *                      the resulting file size would exceed the maximum file
+ *                      size.
+ *  @retval -RED_EINVAL The volume is not mounted; or @p paIov or @p pulLen is
+ *                      `NULL`; or @p ulIovCount is zero; or a buffer with a
+ *                      nonzero length is `NULL`; or the total length exceeds
+ *                      INT32_MAX.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EISDIR The inode is a directory inode.
+ *  @retval -RED_ENOSPC No data can be written because there is insufficient
+ *                      free space.
+ *  @retval -RED_EROFS  The file system volume is read-only.
+ */
+    REDSTATUS RedCoreFileWritev( uint32_t ulInode,
+                                 uint64_t ullStart,
+                                 const REDIOVEC * paIov,
+                                 uint32_t ulIovCount,
+                                 uint32_t * pulLen )
+    {
+        REDSTATUS ret;
+
+        if( !gpRedVolume->fMounted || ( pulLen == NULL ) )
+        {
+            ret = -RED_EINVAL;
+        }
+        else if( gpRedVolume->fReadOnly )
+        {
+            ret = -RED_EROFS;
+        }
+        else
+        {
+            ret = CoreIovTotal( paIov, ulIovCount, NULL );
+        }
+
+        if( ret == 0 )
+        {
+            ret = CoreFileWritev( ulInode, ullStart, paIov, ulIovCount, pulLen );
+
+            if( ( ret == -RED_ENOSPC ) &&
+                ( ( gpRedVolume->ulTransMask & RED_TRANSACT_VOLFULL ) != 0U ) &&
+                ( gpRedCoreVol->ulAlmostFreeBlocks > 0U ) )
             {
                 ret = RedVolTransact();
+
+                if( ret == 0 )
+                {
+                    ret = CoreFileWritev( ulInode, ullStart, paIov, ulIovCount, pulLen );
+                }
+            }
+
+            if( ( ret == 0 ) && ( ( gpRedVolume->ulTransMask & RED_TRANSACT_WRITE ) != 0U ) )
+            {
+                ret = RedVolTransactAuto();
             }
         }
 
@@ -1752,6 +2406,95 @@ REDSTATUS RedCoreFileRead( uint32_t ulInode,
 
         return ret;
     }
+
+
+/** @brief Write to a file from several buffers.
+ *
+ *  @param ulInode      The file number of the file to write.
+ *  @param ullStart     The file offset to write at.
+ *  @param paIov        The buffers containing the data to be written.
+ *  @param ulIovCount   The number of elements in @p paIov.
+ *  @param pulLen       On successful exit, the total number of bytes written.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBADF  @p ulInode is not a valid file number.
+ *  @retval -RED_EFBIG  No data can be written to the given file offset since
+ *                      the resulting file size would exceed the maximum file
+ *                      size.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EISDIR The inode is a directory inode.
+ *  @retval -RED_ENOSPC No data can be written because there is insufficient
+ *                      free space.
+ *  @retval -RED_EROFS  The file system volume is read-only.
+ */
+    static REDSTATUS CoreFileWritev( uint32_t ulInode,
+                                     uint64_t ullStart,
+                                     const REDIOVEC * paIov,
+                                     uint32_t ulIovCount,
+                                     uint32_t * pulLen )
+    {
+        REDSTATUS ret;
+
+        if( gpRedVolume->fReadOnly )
+        {
+            ret = -RED_EROFS;
+        }
+        else
+        {
+            CINODE ino;
+
+            ino.ulInode = ulInode;
+            ret = RedInodeMount( &ino, FTYPE_FILE, true );
+
+            if( ret == 0 )
+            {
+                uint32_t ulTotal = 0U;
+                uint32_t ulIov;
+
+                for( ulIov = 0U; ulIov < ulIovCount; ulIov++ )
+                {
+                    uint32_t ulLen = paIov[ ulIov ].iov_len;
+
+                    if( ulLen > 0U )
+                    {
+                        ret = RedInodeDataWrite( &ino, ullStart + ulTotal, &ulLen, paIov[ ulIov ].iov_base );
+
+                        if( ret != 0 )
+                        {
+                            /*  Running out of space or reaching the maximum
+                             *  file size after some data was written is a
+                             *  short write, not an error.
+                             */
+                            if( ( ulTotal > 0U ) && ( ( ret == -RED_ENOSPC ) || ( ret == -RED_EFBIG ) ) )
+                            {
+                                ret = 0;
+                            }
+
+                            break;
+                        }
+
+                        ulTotal += ulLen;
+
+                        if( ulLen < paIov[ ulIov ].iov_len )
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                if( ret == 0 )
+                {
+                    *pulLen = ulTotal;
+                }
+
+                RedInodePut( &ino, ( ret == 0 ) ? ( uint8_t ) ( IPUT_UPDATE_MTIME | IPUT_UPDATE_CTIME ) : 0U );
+            }
+        }
+
+        return ret;
+    }
 #endif /* REDCONF_READ_ONLY == 0 */
 
 
@@ -1810,7 +2553,7 @@ REDSTATUS RedCoreFileRead( uint32_t ulInode,
 
             if( ( ret == 0 ) && ( ( gpRedVolume->ulTransMask & RED_TRANSACT_TRUNCATE ) != 0U ) )
             {
-                ret = RedVolTransact();
+                ret = RedVolTransactAuto();
             }
         }
 
@@ -1870,6 +2613,111 @@ REDSTATUS RedCoreFileRead( uint32_t ulInode,
 #endif /* TRUNCATE_SUPPORTED */
 
 
+#if REDCONF_READ_ONLY == 0
+
+/** @brief Allocate the data blocks for a range of a file.
+ *
+ *  Sparse blocks in the range are allocated as contiguous extents where free
+ *  space allows and filled with zeroes; existing data is not changed.  If the
+ *  range ends beyond the end of the file, the file size is increased to the
+ *  end of the range.
+ *
+ *  Committed blocks are never overwritten, so the allocation only saves work
+ *  for writes into the range made before the next transaction point; for this
+ *  reason, allocating does not trigger an automatic transaction point.
+ *
+ *  @param ulInode  The inode of the file.
+ *  @param ullStart The file offset at which the range starts.
+ *  @param ullLen   The length of the range, in bytes.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBADF  @p ulInode is not a valid inode number.
+ *  @retval -RED_EFBIG  The range extends beyond the maximum file size.
+ *  @retval -RED_EINVAL The volume is not mounted.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EISDIR The inode is a directory inode.
+ *  @retval -RED_ENOSPC Insufficient free space to allocate the whole range.
+ *  @retval -RED_EROFS  The file system volume is read-only.
+ */
+    REDSTATUS RedCoreFileAllocate( uint32_t ulInode,
+                                   uint64_t ullStart,
+                                   uint64_t ullLen )
+    {
+        REDSTATUS ret;
+
+        if( !gpRedVolume->fMounted )
+        {
+            ret = -RED_EINVAL;
+        }
+        else if( gpRedVolume->fReadOnly )
+        {
+            ret = -RED_EROFS;
+        }
+        else
+        {
+            ret = CoreFileAllocate( ulInode, ullStart, ullLen );
+
+            if( ( ret == -RED_ENOSPC ) &&
+                ( ( gpRedVolume->ulTransMask & RED_TRANSACT_VOLFULL ) != 0U ) &&
+                ( gpRedCoreVol->ulAlmostFreeBlocks > 0U ) )
+            {
+                ret = RedVolTransact();
+
+                if( ret == 0 )
+                {
+                    ret = CoreFileAllocate( ulInode, ullStart, ullLen );
+                }
+            }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Allocate the data blocks for a range of a file.
+ *
+ *  @param ulInode  The inode of the file.
+ *  @param ullStart The file offset at which the range starts.
+ *  @param ullLen   The length of the range, in bytes.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBADF  @p ulInode is not a valid inode number.
+ *  @retval -RED_EFBIG  The range extends beyond the maximum file size.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EISDIR The inode is a directory inode.
+ *  @retval -RED_ENOSPC Insufficient free space to allocate the whole range.
+ */
+    static REDSTATUS CoreFileAllocate( uint32_t ulInode,
+                                       uint64_t ullStart,
+                                       uint64_t ullLen )
+    {
+        REDSTATUS ret;
+        CINODE ino;
+
+        ino.ulInode = ulInode;
+        ret = RedInodeMount( &ino, FTYPE_FILE, true );
+
+        if( ret == 0 )
+        {
+            uint64_t ullOldSize = ino.pInodeBuf->ullSize;
+
+            ret = RedInodeDataAllocate( &ino, ullStart, ullLen );
+
+            /*  Blocks may have been allocated even if the whole range could not
+             *  be, so the timestamps follow the size rather than the result.
+             */
+            RedInodePut( &ino, ( ino.pInodeBuf->ullSize != ullOldSize ) ? ( uint8_t ) ( IPUT_UPDATE_MTIME | IPUT_UPDATE_CTIME ) : 0U );
+        }
+
+        return ret;
+    }
+#endif /* REDCONF_READ_ONLY == 0 */
+
+
 #if ( REDCONF_API_POSIX == 1 ) && ( REDCONF_API_POSIX_READDIR == 1 )
 
 /** @brief Read from a directory.
@@ -1936,3 +2784,79 @@ REDSTATUS RedCoreFileRead( uint32_t ulInode,
         return ret;
     }
 #endif /* (REDCONF_API_POSIX == 1) && (REDCONF_API_POSIX_READDIR == 1) */
+
+
+#if REDCONF_FINE_LOCKING == 1
+
+/** @brief Initialize the semaphores used for fine-grained locking.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_ENOMEM A semaphore could not be allocated.
+ */
+    static REDSTATUS CoreSemaphoresInit( void )
+    {
+        REDSTATUS ret = 0;
+        uint8_t bSem;
+
+        for( bSem = 0U; bSem < RED_SEM_COUNT; bSem++ )
+        {
+            uint32_t ulCount;
+
+            if( bSem == RED_SEM_IO_SLOT )
+            {
+                ulCount = 1U;
+            }
+            else if( bSem == RED_SEM_IO_DONE )
+            {
+                ulCount = 0U;
+            }
+
+            #if REDCONF_STATISTICS == 1
+                else if( bSem == RED_SEM_STATS )
+                {
+                    ulCount = 1U;
+                }
+            #endif
+            else if( ( bSem % 2U ) == 0U )
+            {
+                /*  The tokens of a reader/writer lock.
+                 */
+                ulCount = REDCONF_TASK_COUNT;
+            }
+            else
+            {
+                /*  The writer semaphore of a reader/writer lock.
+                 */
+                ulCount = 1U;
+            }
+
+            ret = RedOsSemaphoreInit( bSem, ulCount );
+
+            if( ret != 0 )
+            {
+                CoreSemaphoresUninit( bSem );
+                break;
+            }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Uninitialize the semaphores used for fine-grained locking.
+ *
+ *  @param bSemCount    The number of semaphores to uninitialize, starting with
+ *                      semaphore zero.
+ */
+    static void CoreSemaphoresUninit( uint8_t bSemCount )
+    {
+        uint8_t bSem;
+
+        for( bSem = 0U; bSem < bSemCount; bSem++ )
+        {
+            ( void ) RedOsSemaphoreUninit( bSem );
+        }
+    }
+#endif /* REDCONF_FINE_LOCKING == 1 */
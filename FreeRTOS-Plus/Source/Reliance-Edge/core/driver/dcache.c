@@ -0,0 +1,241 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Implements the cache of directory entry lookups.
+ *
+ *  The cache records the result of looking up a name in a directory, including
+ *  the absence of a name, so that repeated path lookups need not read the
+ *  directory.  It is kept coherent by the core operations which change the
+ *  namespace, and is discarded when the volume is unmounted.
+ */
+#include <redfs.h>
+
+#if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+
+    #include <redcoreapi.h>
+    #include <redcore.h>
+
+
+/** @brief Cached result of looking up a name in a directory.
+ */
+    typedef struct
+    {
+        uint32_t ulPInode;              /**< Parent directory inode number; INODE_INVALID if the entry is unused. */
+        uint32_t ulInode;               /**< Inode named by acName; INODE_INVALID if the name does not exist. */
+        uint32_t ulHash;                /**< Hash of acName. */
+        uint32_t ulStamp;               /**< Time of last use, for least-recently-used replacement. */
+        uint8_t bVolNum;                /**< Volume containing the parent directory. */
+        char acName[ REDCONF_NAME_MAX ]; /**< Name; not null terminated if of the maximum length. */
+    } DCACHEENTRY;
+
+
+    static DCACHEENTRY * DcacheFind( uint32_t ulPInode,
+                                     const char * pszName );
+
+
+    static DCACHEENTRY gaDcache[ REDCONF_DENTRY_CACHE_ENTRIES ];
+    static uint32_t gulDcacheStamp;
+
+
+/** @brief Initialize the cache, for all volumes.
+ */
+    void RedDcacheInit( void )
+    {
+        RedMemSet( gaDcache, 0U, sizeof( gaDcache ) );
+    }
+
+
+/** @brief Look up a name in a directory in the cache.
+ *
+ *  @param ulPInode The inode number of the parent directory.
+ *  @param pszName  The name, terminated by a null or a path separator.
+ *  @param pulInode On successful return, populated with the inode number named
+ *                  by @p pszName, or INODE_INVALID if the name is cached as not
+ *                  existing.
+ *
+ *  @return Whether the lookup is cached.
+ */
+    bool RedDcacheLookup( uint32_t ulPInode,
+                          const char * pszName,
+                          uint32_t * pulInode )
+    {
+        const DCACHEENTRY * pEntry = DcacheFind( ulPInode, pszName );
+
+        if( pEntry != NULL )
+        {
+            *pulInode = pEntry->ulInode;
+        }
+
+        return pEntry != NULL;
+    }
+
+
+/** @brief Cache the result of looking up a name in a directory.
+ *
+ *  @param ulPInode The inode number of the parent directory.
+ *  @param pszName  The name, terminated by a null or a path separator.
+ *  @param ulInode  The inode number named by @p pszName, or INODE_INVALID if
+ *                  the name does not exist.
+ */
+    void RedDcacheInsert( uint32_t ulPInode,
+                          const char * pszName,
+                          uint32_t ulInode )
+    {
+        uint32_t ulNameLen = RedNameLen( pszName );
+
+        if( ( ulNameLen > 0U ) && ( ulNameLen <= REDCONF_NAME_MAX ) )
+        {
+            DCACHEENTRY * pEntry = DcacheFind( ulPInode, pszName );
+
+            if( pEntry == NULL )
+            {
+                uint32_t ulIdx;
+
+                /*  Use an unused entry if there is one, otherwise replace the
+                 *  least recently used entry.
+                 */
+                pEntry = &gaDcache[ 0U ];
+
+                for( ulIdx = 1U; ( ulIdx < REDCONF_DENTRY_CACHE_ENTRIES ) && ( pEntry->ulPInode != INODE_INVALID ); ulIdx++ )
+                {
+                    if( ( gaDcache[ ulIdx ].ulPInode == INODE_INVALID ) ||
+                        ( ( gulDcacheStamp - gaDcache[ ulIdx ].ulStamp ) > ( gulDcacheStamp - pEntry->ulStamp ) ) )
+                    {
+                        pEntry = &gaDcache[ ulIdx ];
+                    }
+                }
+
+                RedMemSet( pEntry->acName, 0U, sizeof( pEntry->acName ) );
+                RedStrNCpy( pEntry->acName, pszName, ulNameLen );
+                pEntry->ulHash = RedNameHash( pszName, ulNameLen );
+                pEntry->ulPInode = ulPInode;
+                pEntry->bVolNum = gbRedVolNum;
+
+                gulDcacheStamp++;
+                pEntry->ulStamp = gulDcacheStamp;
+            }
+
+            pEntry->ulInode = ulInode;
+        }
+    }
+
+
+    #if REDCONF_READ_ONLY == 0
+
+/** @brief Remove the cached result of looking up a name in a directory, if
+ *         there is one.
+ *
+ *  @param ulPInode The inode number of the parent directory.
+ *  @param pszName  The name, terminated by a null or a path separator.
+ */
+        void RedDcacheInvalidate( uint32_t ulPInode,
+                                  const char * pszName )
+        {
+            DCACHEENTRY * pEntry = DcacheFind( ulPInode, pszName );
+
+            if( pEntry != NULL )
+            {
+                pEntry->ulPInode = INODE_INVALID;
+            }
+        }
+
+
+/** @brief Remove the cached lookups of all names in a directory.
+ *
+ *  @param ulPInode The inode number of the directory.
+ */
+        void RedDcachePurge( uint32_t ulPInode )
+        {
+            uint32_t ulIdx;
+
+            for( ulIdx = 0U; ulIdx < REDCONF_DENTRY_CACHE_ENTRIES; ulIdx++ )
+            {
+                if( ( gaDcache[ ulIdx ].ulPInode == ulPInode ) && ( gaDcache[ ulIdx ].bVolNum == gbRedVolNum ) )
+                {
+                    gaDcache[ ulIdx ].ulPInode = INODE_INVALID;
+                }
+            }
+        }
+    #endif /* REDCONF_READ_ONLY == 0 */
+
+
+/** @brief Remove all cached lookups for the current volume.
+ */
+    void RedDcacheDiscard( void )
+    {
+        uint32_t ulIdx;
+
+        for( ulIdx = 0U; ulIdx < REDCONF_DENTRY_CACHE_ENTRIES; ulIdx++ )
+        {
+            if( gaDcache[ ulIdx ].bVolNum == gbRedVolNum )
+            {
+                gaDcache[ ulIdx ].ulPInode = INODE_INVALID;
+            }
+        }
+    }
+
+
+/** @brief Find the cached result of looking up a name in a directory.
+ *
+ *  @param ulPInode The inode number of the parent directory.
+ *  @param pszName  The name, terminated by a null or a path separator.
+ *
+ *  @return A pointer to the cache entry, or `NULL` if the lookup is not cached.
+ */
+    static DCACHEENTRY * DcacheFind( uint32_t ulPInode,
+                                     const char * pszName )
+    {
+        DCACHEENTRY * pEntry = NULL;
+        uint32_t ulNameLen = RedNameLen( pszName );
+
+        if( ( ulNameLen > 0U ) && ( ulNameLen <= REDCONF_NAME_MAX ) )
+        {
+            uint32_t ulHash = RedNameHash( pszName, ulNameLen );
+            uint32_t ulIdx;
+
+            for( ulIdx = 0U; ulIdx < REDCONF_DENTRY_CACHE_ENTRIES; ulIdx++ )
+            {
+                DCACHEENTRY * pThisEntry = &gaDcache[ ulIdx ];
+
+                if( ( pThisEntry->ulHash == ulHash ) &&
+                    ( pThisEntry->ulPInode == ulPInode ) &&
+                    ( pThisEntry->bVolNum == gbRedVolNum ) &&
+                    ( RedStrNCmp( pThisEntry->acName, pszName, ulNameLen ) == 0 ) &&
+                    ( ( ulNameLen == REDCONF_NAME_MAX ) || ( pThisEntry->acName[ ulNameLen ] == '\0' ) ) )
+                {
+                    gulDcacheStamp++;
+                    pThisEntry->ulStamp = gulDcacheStamp;
+                    pEntry = pThisEntry;
+                    break;
+                }
+            }
+        }
+
+        return pEntry;
+    }
+
+#endif /* REDCONF_DENTRY_CACHE_ENTRIES > 0U */
@@ -34,41 +34,46 @@
     #include <redcore.h>
 
 
-    #define DIR_INDEX_INVALID     UINT32_MAX
+    #define DIR_INDEX_INVALID    UINT32_MAX
+    #define DIRENTS_MAX          ( uint32_t ) REDMIN( UINT32_MAX, UINT64_SUFFIX( 1 ) * INODE_DATA_BLOCKS * DIRENTS_PER_BLOCK )
 
-    #if ( REDCONF_NAME_MAX % 4U ) != 0U
-        #define DIRENT_PADDING    ( 4U - ( REDCONF_NAME_MAX % 4U ) )
-    #else
-        #define DIRENT_PADDING    ( 0U )
-    #endif
-    #define DIRENT_SIZE           ( 4U + REDCONF_NAME_MAX + DIRENT_PADDING )
-    #define DIRENTS_PER_BLOCK     ( REDCONF_BLOCK_SIZE / DIRENT_SIZE )
-    #define DIRENTS_MAX           ( uint32_t ) REDMIN( UINT32_MAX, UINT64_SUFFIX( 1 ) * INODE_DATA_BLOCKS * DIRENTS_PER_BLOCK )
 
+    #if REDCONF_DIR_INDEX_DIRS > 0U
 
-/** @brief On-disk directory entry.
+/*  Maximum number of in-use entries in an indexed directory, chosen to keep the
+ *  probe sequences of the hash table short.
  */
-    typedef struct
-    {
-        /** The inode number that the directory entry points at.  If the directory
-         *  entry is available, this holds INODE_INVALID.
-         */
-        uint32_t ulInode;
+        #define DIR_INDEX_LOAD_MAX    ( ( ( uint32_t ) REDCONF_DIR_INDEX_ENTRIES * 3U ) / 4U )
 
-        /** The name of the directory entry.  For names shorter than
-         *  REDCONF_NAME_MAX, unused bytes in the array are zeroed.  For names of
-         *  the maximum length, the string is not null terminated.
-         */
-        char acName[ REDCONF_NAME_MAX ];
 
-        #if DIRENT_PADDING > 0U
+/** @brief Slot in the hash table of a directory index.
+ */
+        typedef struct
+        {
+            uint32_t ulHash;     /**< Hash of the name in the directory entry. */
+            uint32_t ulEntryIdx; /**< Directory entry index; DIR_INDEX_INVALID if the slot is empty. */
+        } DIRINDEXSLOT;
 
-            /** Unused padding so that ulInode is always aligned on a four-byte
-             *  boundary.
-             */
-            uint8_t abPadding[ DIRENT_PADDING ];
-        #endif
-    } DIRENT;
+
+/** @brief In-memory name-hash index of a directory.
+ *
+ *  The index maps the hash of each name in the directory to the position of
+ *  its entry.  It is an exact mirror of the directory contents: any change to
+ *  the directory which is not reflected in the index causes the index to be
+ *  dropped.
+ */
+        typedef struct
+        {
+            uint32_t ulInode;       /**< Directory inode number; INODE_INVALID if unused. */
+            uint32_t ulDirentCount; /**< Directory size, in entries, when the index was last updated. */
+            uint32_t ulUsed;        /**< Number of in-use entries in the directory. */
+            uint32_t ulFreeHint;    /**< No entry below this position is free. */
+            uint32_t ulStamp;       /**< Time of last use, for least-recently-used replacement. */
+            uint8_t bVolNum;        /**< Volume containing the directory. */
+            bool fOverflow;         /**< Directory has too many entries to be indexed. */
+            DIRINDEXSLOT aSlot[ REDCONF_DIR_INDEX_ENTRIES ];
+        } DIRINDEX;
+    #endif /* REDCONF_DIR_INDEX_DIRS > 0U */
 
 
     #if ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_API_POSIX_RENAME == 1 )
@@ -83,7 +88,51 @@
                                         uint32_t ulNameLen );
         static uint64_t DirEntryIndexToOffset( uint32_t ulIdx );
     #endif
+    static REDSTATUS DirEntryLookupLinear( CINODE * pPInode,
+                                           const char * pszName,
+                                           uint32_t ulNameLen,
+                                           uint32_t * pulEntryIdx,
+                                           uint32_t * pulInode );
     static uint32_t DirOffsetToEntryIndex( uint64_t ullOffset );
+    #if REDCONF_DIR_INDEX_DIRS > 0U
+        static REDSTATUS DirIndexGet( CINODE * pPInode,
+                                      DIRINDEX ** ppIndex );
+        static REDSTATUS DirIndexBuild( CINODE * pPInode,
+                                        DIRINDEX * pIndex );
+        static REDSTATUS DirIndexLookup( CINODE * pPInode,
+                                         DIRINDEX * pIndex,
+                                         const char * pszName,
+                                         uint32_t ulNameLen,
+                                         uint32_t * pulEntryIdx,
+                                         uint32_t * pulInode );
+        static REDSTATUS DirIndexFreeEntry( CINODE * pPInode,
+                                            DIRINDEX * pIndex,
+                                            uint32_t * pulEntryIdx );
+        #if REDCONF_READ_ONLY == 0
+            static DIRINDEX * DirIndexFind( const CINODE * pPInode );
+            static REDSTATUS DirIndexUpdateStart( CINODE * pPInode,
+                                                  uint32_t ulIdx,
+                                                  DIRINDEX ** ppIndex );
+            static void DirIndexUpdateEnd( const CINODE * pPInode,
+                                           DIRINDEX * pIndex,
+                                           REDSTATUS status,
+                                           uint32_t ulIdx,
+                                           const char * pszName,
+                                           uint32_t ulNameLen );
+            static bool DirIndexRemove( DIRINDEX * pIndex,
+                                        uint32_t ulHash,
+                                        uint32_t ulIdx );
+        #endif
+        static void DirIndexInsert( DIRINDEX * pIndex,
+                                    uint32_t ulHash,
+                                    uint32_t ulIdx );
+    #endif /* REDCONF_DIR_INDEX_DIRS > 0U */
+
+
+    #if REDCONF_DIR_INDEX_DIRS > 0U
+        static DIRINDEX gaDirIndex[ REDCONF_DIR_INDEX_DIRS ];
+        static uint32_t gulDirIndexStamp;
+    #endif
 
 
     #if REDCONF_READ_ONLY == 0
@@ -264,7 +313,20 @@
                  */
                 if( ret == 0 )
                 {
-                    ret = RedInodeDataTruncate( pPInode, DirEntryIndexToOffset( ulTruncIdx ) );
+                    #if REDCONF_DIR_INDEX_DIRS > 0U
+                        DIRINDEX * pIndex;
+
+                        ret = DirIndexUpdateStart( pPInode, ulDeleteIdx, &pIndex );
+
+                        if( ret == 0 )
+                    #endif
+                    {
+                        ret = RedInodeDataTruncate( pPInode, DirEntryIndexToOffset( ulTruncIdx ) );
+                    }
+
+                    #if REDCONF_DIR_INDEX_DIRS > 0U
+                        DirIndexUpdateEnd( pPInode, pIndex, ret, ulDeleteIdx, "", 0U );
+                    #endif
                 }
             }
             else
@@ -340,121 +402,164 @@
             }
             else
             {
-                uint32_t ulIdx = 0U;
-                uint32_t ulDirentCount = DirOffsetToEntryIndex( pPInode->pInodeBuf->ullSize );
-                uint32_t ulFreeIdx = DIR_INDEX_INVALID; /* Index of first free dirent. */
+                #if REDCONF_DIR_INDEX_DIRS > 0U
+                    DIRINDEX * pIndex;
 
-                /*  Loop over the directory blocks, searching each block for a
-                 *  dirent that matches the given name.
-                 */
-                while( ( ret == 0 ) && ( ulIdx < ulDirentCount ) )
-                {
-                    ret = RedInodeDataSeekAndRead( pPInode, ulIdx / DIRENTS_PER_BLOCK );
+                    ret = DirIndexGet( pPInode, &pIndex );
 
-                    if( ret == 0 )
+                    if( ( ret == 0 ) && ( pIndex != NULL ) )
                     {
-                        const DIRENT * pDirents = CAST_CONST_DIRENT_PTR( pPInode->pbData );
-                        uint32_t ulBlockLastIdx = REDMIN( DIRENTS_PER_BLOCK, ulDirentCount - ulIdx );
-                        uint32_t ulBlockIdx;
+                        ret = DirIndexLookup( pPInode, pIndex, pszName, ulNameLen, pulEntryIdx, pulInode );
+                    }
+                    else
+                #endif
+                {
+                    ret = DirEntryLookupLinear( pPInode, pszName, ulNameLen, pulEntryIdx, pulInode );
+                }
+            }
+        }
 
-                        for( ulBlockIdx = 0U; ulBlockIdx < ulBlockLastIdx; ulBlockIdx++ )
-                        {
-                            const DIRENT * pDirent = &pDirents[ ulBlockIdx ];
+        return ret;
+    }
 
-                            if( pDirent->ulInode != INODE_INVALID )
-                            {
-                                /*  The name in the dirent will not be null
-                                 *  terminated if it is of the maximum length, so
-                                 *  use a bounded string compare and then make sure
-                                 *  there is nothing more to the name.
-                                 */
-                                if( ( RedStrNCmp( pDirent->acName, pszName, ulNameLen ) == 0 ) &&
-                                    ( ( ulNameLen == REDCONF_NAME_MAX ) || ( pDirent->acName[ ulNameLen ] == '\0' ) ) )
-                                {
-                                    /*  Found a matching dirent, stop and return its
-                                     *  information.
-                                     */
-                                    if( pulInode != NULL )
-                                    {
-                                        *pulInode = pDirent->ulInode;
-
-                                        #ifdef REDCONF_ENDIAN_SWAP
-                                            *pulInode = RedRev32( *pulInode );
-                                        #endif
-                                    }
-
-                                    ulIdx += ulBlockIdx;
-                                    break;
-                                }
-                            }
-                            else if( ulFreeIdx == DIR_INDEX_INVALID )
-                            {
-                                ulFreeIdx = ulIdx + ulBlockIdx;
-                            }
-                            else
-                            {
-                                /*  The directory entry is free, but we already found a free one, so there's
-                                 *  nothing to do here.
-                                 */
-                            }
-                        }
 
-                        if( ulBlockIdx < ulBlockLastIdx )
+/** @brief Search a directory for a given name by examining every entry.
+ *
+ *  @param pPInode      A pointer to the cached inode structure of the directory
+ *                      to search.
+ *  @param pszName      The name of the desired entry, terminated by either a
+ *                      null or a path separator.
+ *  @param ulNameLen    The length of @p pszName.
+ *  @param pulEntryIdx  See RedDirEntryLookup().
+ *  @param pulInode     See RedDirEntryLookup().
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0               Operation was successful.
+ *  @retval -RED_EIO        A disk I/O error occurred.
+ *  @retval -RED_ENOENT     @p pszName does not name an existing file or
+ *                          directory.
+ */
+    static REDSTATUS DirEntryLookupLinear( CINODE * pPInode,
+                                           const char * pszName,
+                                           uint32_t ulNameLen,
+                                           uint32_t * pulEntryIdx,
+                                           uint32_t * pulInode )
+    {
+        REDSTATUS ret = 0;
+        uint32_t ulIdx = 0U;
+        uint32_t ulDirentCount = DirOffsetToEntryIndex( pPInode->pInodeBuf->ullSize );
+        uint32_t ulFreeIdx = DIR_INDEX_INVALID; /* Index of first free dirent. */
+
+        /*  Loop over the directory blocks, searching each block for a
+         *  dirent that matches the given name.
+         */
+        while( ( ret == 0 ) && ( ulIdx < ulDirentCount ) )
+        {
+            ret = RedInodeDataSeekAndRead( pPInode, ulIdx / DIRENTS_PER_BLOCK );
+
+            if( ret == 0 )
+            {
+                const DIRENT * pDirents = CAST_CONST_DIRENT_PTR( pPInode->pbData );
+                uint32_t ulBlockLastIdx = REDMIN( DIRENTS_PER_BLOCK, ulDirentCount - ulIdx );
+                uint32_t ulBlockIdx;
+
+                for( ulBlockIdx = 0U; ulBlockIdx < ulBlockLastIdx; ulBlockIdx++ )
+                {
+                    const DIRENT * pDirent = &pDirents[ ulBlockIdx ];
+
+                    if( pDirent->ulInode != INODE_INVALID )
+                    {
+                        /*  The name in the dirent will not be null
+                         *  terminated if it is of the maximum length, so
+                         *  use a bounded string compare and then make sure
+                         *  there is nothing more to the name.
+                         */
+                        if( ( RedStrNCmp( pDirent->acName, pszName, ulNameLen ) == 0 ) &&
+                            ( ( ulNameLen == REDCONF_NAME_MAX ) || ( pDirent->acName[ ulNameLen ] == '\0' ) ) )
                         {
-                            /*  If we broke out of the for loop, we found a matching
-                             *  dirent and can stop the search.
+                            /*  Found a matching dirent, stop and return its
+                             *  information.
                              */
+                            if( pulInode != NULL )
+                            {
+                                *pulInode = pDirent->ulInode;
+
+                                #ifdef REDCONF_ENDIAN_SWAP
+                                    *pulInode = RedRev32( *pulInode );
+                                #endif
+                            }
+
+                            ulIdx += ulBlockIdx;
                             break;
                         }
-
-                        ulIdx += ulBlockLastIdx;
                     }
-                    else if( ret == -RED_ENODATA )
+                    else if( ulFreeIdx == DIR_INDEX_INVALID )
                     {
-                        if( ulFreeIdx == DIR_INDEX_INVALID )
-                        {
-                            ulFreeIdx = ulIdx;
-                        }
-
-                        ret = 0;
-                        ulIdx += DIRENTS_PER_BLOCK;
+                        ulFreeIdx = ulIdx + ulBlockIdx;
                     }
                     else
                     {
-                        /*  Unexpected error, let the loop terminate, no action
-                         *  here.
+                        /*  The directory entry is free, but we already found a free one, so there's
+                         *  nothing to do here.
                          */
                     }
                 }
 
-                if( ret == 0 )
+                if( ulBlockIdx < ulBlockLastIdx )
                 {
-                    /*  If we made it all the way to the end of the directory
-                     *  without stopping, then the given name does not exist in the
-                     *  directory.
+                    /*  If we broke out of the for loop, we found a matching
+                     *  dirent and can stop the search.
                      */
-                    if( ulIdx == ulDirentCount )
-                    {
-                        /*  If the directory had no sparse dirents, then the first
-                         *  free dirent is beyond the end of the directory.  If the
-                         *  directory is already the maximum size, then there is no
-                         *  free dirent.
-                         */
-                        if( ( ulFreeIdx == DIR_INDEX_INVALID ) && ( ulDirentCount < DIRENTS_MAX ) )
-                        {
-                            ulFreeIdx = ulDirentCount;
-                        }
+                    break;
+                }
 
-                        ulIdx = ulFreeIdx;
+                ulIdx += ulBlockLastIdx;
+            }
+            else if( ret == -RED_ENODATA )
+            {
+                if( ulFreeIdx == DIR_INDEX_INVALID )
+                {
+                    ulFreeIdx = ulIdx;
+                }
 
-                        ret = -RED_ENOENT;
-                    }
+                ret = 0;
+                ulIdx += DIRENTS_PER_BLOCK;
+            }
+            else
+            {
+                /*  Unexpected error, let the loop terminate, no action
+                 *  here.
+                 */
+            }
+        }
 
-                    if( pulEntryIdx != NULL )
-                    {
-                        *pulEntryIdx = ulIdx;
-                    }
+        if( ret == 0 )
+        {
+            /*  If we made it all the way to the end of the directory
+             *  without stopping, then the given name does not exist in the
+             *  directory.
+             */
+            if( ulIdx == ulDirentCount )
+            {
+                /*  If the directory had no sparse dirents, then the first
+                 *  free dirent is beyond the end of the directory.  If the
+                 *  directory is already the maximum size, then there is no
+                 *  free dirent.
+                 */
+                if( ( ulFreeIdx == DIR_INDEX_INVALID ) && ( ulDirentCount < DIRENTS_MAX ) )
+                {
+                    ulFreeIdx = ulDirentCount;
                 }
+
+                ulIdx = ulFreeIdx;
+
+                ret = -RED_ENOENT;
+            }
+
+            if( pulEntryIdx != NULL )
+            {
+                *pulEntryIdx = ulIdx;
             }
         }
 
@@ -902,6 +1007,10 @@
                 uint32_t ulLen = DIRENT_SIZE;
                 static DIRENT de;
 
+                #if REDCONF_DIR_INDEX_DIRS > 0U
+                    DIRINDEX * pIndex;
+                #endif
+
                 RedMemSet( &de, 0U, sizeof( de ) );
 
                 de.ulInode = ulInode;
@@ -912,7 +1021,18 @@
 
                 RedStrNCpy( de.acName, pszName, ulNameLen );
 
-                ret = RedInodeDataWrite( pPInode, ullOffset, &ulLen, &de );
+                #if REDCONF_DIR_INDEX_DIRS > 0U
+                    ret = DirIndexUpdateStart( pPInode, ulIdx, &pIndex );
+
+                    if( ret == 0 )
+                #endif
+                {
+                    ret = RedInodeDataWrite( pPInode, ullOffset, &ulLen, &de );
+                }
+
+                #if REDCONF_DIR_INDEX_DIRS > 0U
+                    DirIndexUpdateEnd( pPInode, pIndex, ret, ulIdx, pszName, ulNameLen );
+                #endif
             }
 
             return ret;
@@ -963,4 +1083,631 @@
     }
 
 
+    #if REDCONF_DIR_INDEX_DIRS > 0U
+
+/** @brief Discard the directory indexes for the current volume.
+ *
+ *  Called when the volume is unmounted, since the working state of the volume,
+ *  which the indexes mirror, is discarded at that point.
+ */
+        void RedDirIndexDiscard( void )
+        {
+            uint32_t ulIdx;
+
+            for( ulIdx = 0U; ulIdx < REDCONF_DIR_INDEX_DIRS; ulIdx++ )
+            {
+                if( gaDirIndex[ ulIdx ].bVolNum == gbRedVolNum )
+                {
+                    gaDirIndex[ ulIdx ].ulInode = INODE_INVALID;
+                }
+            }
+        }
+
+
+/** @brief Get the index for a directory, building it if necessary.
+ *
+ *  @param pPInode  A pointer to the cached inode structure of the directory.
+ *  @param ppIndex  On successful return, populated with a pointer to the index
+ *                  for the directory; or with `NULL` if the directory is not
+ *                  indexed, either because it fits in one block or because it
+ *                  has too many entries.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+        static REDSTATUS DirIndexGet( CINODE * pPInode,
+                                      DIRINDEX ** ppIndex )
+        {
+            REDSTATUS ret = 0;
+            uint32_t ulDirentCount = DirOffsetToEntryIndex( pPInode->pInodeBuf->ullSize );
+            DIRINDEX * pIndex = NULL;
+            uint32_t ulIdx;
+
+            for( ulIdx = 0U; ulIdx < REDCONF_DIR_INDEX_DIRS; ulIdx++ )
+            {
+                if( ( gaDirIndex[ ulIdx ].ulInode == pPInode->ulInode ) && ( gaDirIndex[ ulIdx ].bVolNum == gbRedVolNum ) )
+                {
+                    pIndex = &gaDirIndex[ ulIdx ];
+                    break;
+                }
+            }
+
+            if( pIndex != NULL )
+            {
+                if( pIndex->fOverflow && ( ulDirentCount > DIR_INDEX_LOAD_MAX ) )
+                {
+                    /*  The directory is still too large to be indexed.
+                     */
+                    pIndex = NULL;
+                }
+                else if( pIndex->fOverflow || ( pIndex->ulDirentCount != ulDirentCount ) )
+                {
+                    ret = DirIndexBuild( pPInode, pIndex );
+                }
+                else
+                {
+                    /*  The index is up to date.
+                     */
+                }
+            }
+            else if( ulDirentCount > DIRENTS_PER_BLOCK )
+            {
+                /*  Use an unused index if there is one, otherwise replace the
+                 *  least recently used index.
+                 */
+                pIndex = &gaDirIndex[ 0U ];
+
+                for( ulIdx = 1U; ( ulIdx < REDCONF_DIR_INDEX_DIRS ) && ( pIndex->ulInode != INODE_INVALID ); ulIdx++ )
+                {
+                    if( ( gaDirIndex[ ulIdx ].ulInode == INODE_INVALID ) ||
+                        ( ( gulDirIndexStamp - gaDirIndex[ ulIdx ].ulStamp ) > ( gulDirIndexStamp - pIndex->ulStamp ) ) )
+                    {
+                        pIndex = &gaDirIndex[ ulIdx ];
+                    }
+                }
+
+                pIndex->ulInode = pPInode->ulInode;
+                pIndex->bVolNum = gbRedVolNum;
+
+                ret = DirIndexBuild( pPInode, pIndex );
+            }
+            else
+            {
+                /*  Small directories are searched quickly enough without an
+                 *  index.
+                 */
+            }
+
+            if( ( ret == 0 ) && ( pIndex != NULL ) )
+            {
+                if( pIndex->fOverflow )
+                {
+                    pIndex = NULL;
+                }
+                else
+                {
+                    gulDirIndexStamp++;
+                    pIndex->ulStamp = gulDirIndexStamp;
+                }
+            }
+
+            *ppIndex = ( ret == 0 ) ? pIndex : NULL;
+
+            return ret;
+        }
+
+
+/** @brief Build the index for a directory from its entries.
+ *
+ *  @param pPInode  A pointer to the cached inode structure of the directory.
+ *  @param pIndex   The index to populate.  If the directory has too many entries
+ *                  to be indexed, the index is flagged as overflowed; if an
+ *                  error occurs, the index is left unused.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+        static REDSTATUS DirIndexBuild( CINODE * pPInode,
+                                        DIRINDEX * pIndex )
+        {
+            REDSTATUS ret = 0;
+            uint32_t ulDirentCount = DirOffsetToEntryIndex( pPInode->pInodeBuf->ullSize );
+            uint32_t ulIdx = 0U;
+
+            for( ulIdx = 0U; ulIdx < REDCONF_DIR_INDEX_ENTRIES; ulIdx++ )
+            {
+                pIndex->aSlot[ ulIdx ].ulEntryIdx = DIR_INDEX_INVALID;
+            }
+
+            pIndex->ulDirentCount = ulDirentCount;
+            pIndex->ulUsed = 0U;
+            pIndex->ulFreeHint = ulDirentCount;
+            pIndex->fOverflow = false;
+
+            ulIdx = 0U;
+
+            while( ( ret == 0 ) && ( ulIdx < ulDirentCount ) && !pIndex->fOverflow )
+            {
+                ret = RedInodeDataSeekAndRead( pPInode, ulIdx / DIRENTS_PER_BLOCK );
+
+                if( ret == 0 )
+                {
+                    const DIRENT * pDirents = CAST_CONST_DIRENT_PTR( pPInode->pbData );
+                    uint32_t ulBlockLastIdx = REDMIN( DIRENTS_PER_BLOCK, ulDirentCount - ulIdx );
+                    uint32_t ulBlockIdx;
+
+                    for( ulBlockIdx = 0U; ulBlockIdx < ulBlockLastIdx; ulBlockIdx++ )
+                    {
+                        const DIRENT * pDirent = &pDirents[ ulBlockIdx ];
+
+                        if( pDirent->ulInode == INODE_INVALID )
+                        {
+                            pIndex->ulFreeHint = REDMIN( pIndex->ulFreeHint, ulIdx + ulBlockIdx );
+                        }
+                        else if( pIndex->ulUsed == DIR_INDEX_LOAD_MAX )
+                        {
+                            pIndex->fOverflow = true;
+                            break;
+                        }
+                        else
+                        {
+                            DirIndexInsert( pIndex, RedNameHash( pDirent->acName, REDCONF_NAME_MAX ), ulIdx + ulBlockIdx );
+                            pIndex->ulUsed++;
+                        }
+                    }
+
+                    ulIdx += ulBlockLastIdx;
+                }
+                else if( ret == -RED_ENODATA )
+                {
+                    pIndex->ulFreeHint = REDMIN( pIndex->ulFreeHint, ulIdx );
+
+                    ret = 0;
+                    ulIdx += DIRENTS_PER_BLOCK;
+                }
+                else
+                {
+                    /*  Unexpected error, loop will terminate; nothing else to do.
+                     */
+                }
+            }
+
+            if( ret != 0 )
+            {
+                pIndex->ulInode = INODE_INVALID;
+            }
+
+            return ret;
+        }
+
+
+/** @brief Search an indexed directory for a given name.
+ *
+ *  @param pPInode      A pointer to the cached inode structure of the
+ *                      directory to search.
+ *  @param pIndex       The index for the directory.
+ *  @param pszName      The name of the desired entry, terminated by either a
+ *                      null or a path separator.
+ *  @param ulNameLen    The length of @p pszName.
+ *  @param pulEntryIdx  See RedDirEntryLookup().
+ *  @param pulInode     See RedDirEntryLookup().
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0               Operation was successful.
+ *  @retval -RED_EIO        A disk I/O error occurred.
+ *  @retval -RED_ENOENT     @p pszName does not name an existing file or
+ *                          directory.
+ */
+        static REDSTATUS DirIndexLookup( CINODE * pPInode,
+                                         DIRINDEX * pIndex,
+                                         const char * pszName,
+                                         uint32_t ulNameLen,
+                                         uint32_t * pulEntryIdx,
+                                         uint32_t * pulInode )
+        {
+            REDSTATUS ret = 0;
+            uint32_t ulHash = RedNameHash( pszName, ulNameLen );
+            uint32_t ulSlot = ulHash % REDCONF_DIR_INDEX_ENTRIES;
+            uint32_t ulEntryIdx = DIR_INDEX_INVALID;
+
+            /*  Examine each entry whose name has the same hash, until a name
+             *  matches or the probe sequence ends.  The table is never full, so
+             *  the probe sequence always ends at an empty slot.
+             */
+            while( ( ret == 0 ) && ( ulEntryIdx == DIR_INDEX_INVALID ) && ( pIndex->aSlot[ ulSlot ].ulEntryIdx != DIR_INDEX_INVALID ) )
+            {
+                if( pIndex->aSlot[ ulSlot ].ulHash == ulHash )
+                {
+                    uint32_t ulIdx = pIndex->aSlot[ ulSlot ].ulEntryIdx;
+
+                    ret = RedInodeDataSeekAndRead( pPInode, ulIdx / DIRENTS_PER_BLOCK );
+
+                    if( ret == 0 )
+                    {
+                        const DIRENT * pDirent = &CAST_CONST_DIRENT_PTR( pPInode->pbData )[ ulIdx % DIRENTS_PER_BLOCK ];
+
+                        if( ( RedStrNCmp( pDirent->acName, pszName, ulNameLen ) == 0 ) &&
+                            ( ( ulNameLen == REDCONF_NAME_MAX ) || ( pDirent->acName[ ulNameLen ] == '\0' ) ) )
+                        {
+                            if( pulInode != NULL )
+                            {
+                                *pulInode = pDirent->ulInode;
+
+                                #ifdef REDCONF_ENDIAN_SWAP
+                                    *pulInode = RedRev32( *pulInode );
+                                #endif
+                            }
+
+                            ulEntryIdx = ulIdx;
+                        }
+                    }
+                    else if( ret == -RED_ENODATA )
+                    {
+                        /*  The index says there is an entry in a sparse block.
+                         */
+                        CRITICAL_ERROR();
+                        ret = -RED_EFUBAR;
+                    }
+                    else
+                    {
+                        /*  Unexpected error, loop will terminate; nothing else
+                         *  to be done.
+                         */
+                    }
+                }
+
+                ulSlot = ( ulSlot + 1U ) % REDCONF_DIR_INDEX_ENTRIES;
+            }
+
+            if( ( ret == 0 ) && ( ulEntryIdx == DIR_INDEX_INVALID ) )
+            {
+                if( pulEntryIdx != NULL )
+                {
+                    ret = DirIndexFreeEntry( pPInode, pIndex, &ulEntryIdx );
+                }
+
+                if( ret == 0 )
+                {
+                    ret = -RED_ENOENT;
+                }
+            }
+
+            if( ( ( ret == 0 ) || ( ret == -RED_ENOENT ) ) && ( pulEntryIdx != NULL ) )
+            {
+                *pulEntryIdx = ulEntryIdx;
+            }
+
+            return ret;
+        }
+
+
+/** @brief Find the first available entry in an indexed directory.
+ *
+ *  @param pPInode      A pointer to the cached inode structure of the
+ *                      directory.
+ *  @param pIndex       The index for the directory.
+ *  @param pulEntryIdx  On successful return, populated with the position of the
+ *                      first available entry, or with DIR_INDEX_INVALID if the
+ *                      directory is full.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+        static REDSTATUS DirIndexFreeEntry( CINODE * pPInode,
+                                            DIRINDEX * pIndex,
+                                            uint32_t * pulEntryIdx )
+        {
+            REDSTATUS ret = 0;
+            uint32_t ulDirentCount = pIndex->ulDirentCount;
+
+            if( pIndex->ulUsed == ulDirentCount )
+            {
+                /*  No entries are free, so the first available entry is beyond
+                 *  the end of the directory, unless the directory is already the
+                 *  maximum size.
+                 */
+                *pulEntryIdx = ( ulDirentCount < DIRENTS_MAX ) ? ulDirentCount : DIR_INDEX_INVALID;
+            }
+            else
+            {
+                uint32_t ulIdx = pIndex->ulFreeHint;
+                bool fFound = false;
+
+                /*  There is a free entry at or after the hint.
+                 */
+                while( ( ret == 0 ) && !fFound && ( ulIdx < ulDirentCount ) )
+                {
+                    ret = RedInodeDataSeekAndRead( pPInode, ulIdx / DIRENTS_PER_BLOCK );
+
+                    if( ret == 0 )
+                    {
+                        const DIRENT * pDirents = CAST_CONST_DIRENT_PTR( pPInode->pbData );
+                        uint32_t ulBlockLastIdx = REDMIN( DIRENTS_PER_BLOCK, ulDirentCount - ( ulIdx - ( ulIdx % DIRENTS_PER_BLOCK ) ) );
+                        uint32_t ulBlockIdx;
+
+                        for( ulBlockIdx = ulIdx % DIRENTS_PER_BLOCK; ulBlockIdx < ulBlockLastIdx; ulBlockIdx++ )
+                        {
+                            if( pDirents[ ulBlockIdx ].ulInode == INODE_INVALID )
+                            {
+                                fFound = true;
+                                break;
+                            }
+
+                            ulIdx++;
+                        }
+                    }
+                    else if( ret == -RED_ENODATA )
+                    {
+                        /*  Every entry in a sparse block is available.
+                         */
+                        ret = 0;
+                        fFound = true;
+                    }
+                    else
+                    {
+                        /*  Unexpected error, loop will terminate; nothing else to
+                         *  do.
+                         */
+                    }
+                }
+
+                if( ( ret == 0 ) && !fFound )
+                {
+                    CRITICAL_ERROR();
+                    ret = -RED_EFUBAR;
+                }
+
+                if( ret == 0 )
+                {
+                    pIndex->ulFreeHint = ulIdx;
+                    *pulEntryIdx = ulIdx;
+                }
+            }
+
+            return ret;
+        }
+
+
+        #if REDCONF_READ_ONLY == 0
+
+/** @brief Find the index for a directory, if it is up to date.
+ *
+ *  @param pPInode  A pointer to the cached inode structure of the directory.
+ *
+ *  @return A pointer to the index for the directory, or `NULL` if the directory
+ *          has no index or the index is out of date.
+ */
+            static DIRINDEX * DirIndexFind( const CINODE * pPInode )
+            {
+                DIRINDEX * pIndex = NULL;
+                uint32_t ulIdx;
+
+                for( ulIdx = 0U; ulIdx < REDCONF_DIR_INDEX_DIRS; ulIdx++ )
+                {
+                    DIRINDEX * pThisIndex = &gaDirIndex[ ulIdx ];
+
+                    if( ( pThisIndex->ulInode == pPInode->ulInode ) &&
+                        ( pThisIndex->bVolNum == gbRedVolNum ) &&
+                        !pThisIndex->fOverflow &&
+                        ( pThisIndex->ulDirentCount == DirOffsetToEntryIndex( pPInode->pInodeBuf->ullSize ) ) )
+                    {
+                        pIndex = pThisIndex;
+                        break;
+                    }
+                }
+
+                return pIndex;
+            }
+
+
+/** @brief Prepare to update a directory entry, removing it from the index.
+ *
+ *  Must be followed by a call to DirIndexUpdateEnd().
+ *
+ *  @param pPInode  A pointer to the cached inode structure of the directory.
+ *  @param ulIdx    The position of the entry which is about to be updated.
+ *  @param ppIndex  Populated with the index for the directory, or `NULL` if
+ *                  the directory has no up-to-date index.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+            static REDSTATUS DirIndexUpdateStart( CINODE * pPInode,
+                                                  uint32_t ulIdx,
+                                                  DIRINDEX ** ppIndex )
+            {
+                REDSTATUS ret = 0;
+                DIRINDEX * pIndex = DirIndexFind( pPInode );
+
+                if( ( pIndex != NULL ) && ( ulIdx < pIndex->ulDirentCount ) )
+                {
+                    ret = RedInodeDataSeekAndRead( pPInode, ulIdx / DIRENTS_PER_BLOCK );
+
+                    if( ret == 0 )
+                    {
+                        const DIRENT * pDirent = &CAST_CONST_DIRENT_PTR( pPInode->pbData )[ ulIdx % DIRENTS_PER_BLOCK ];
+
+                        if( pDirent->ulInode != INODE_INVALID )
+                        {
+                            if( DirIndexRemove( pIndex, RedNameHash( pDirent->acName, REDCONF_NAME_MAX ), ulIdx ) )
+                            {
+                                pIndex->ulUsed--;
+                                pIndex->ulFreeHint = REDMIN( pIndex->ulFreeHint, ulIdx );
+                            }
+                            else
+                            {
+                                /*  The index does not match the directory, so
+                                 *  stop using it.
+                                 */
+                                REDERROR();
+                                pIndex->ulInode = INODE_INVALID;
+                                pIndex = NULL;
+                            }
+                        }
+                    }
+                    else if( ret == -RED_ENODATA )
+                    {
+                        ret = 0;
+                    }
+                    else
+                    {
+                        pIndex->ulInode = INODE_INVALID;
+                        pIndex = NULL;
+                    }
+                }
+
+                *ppIndex = pIndex;
+
+                return ret;
+            }
+
+
+/** @brief Finish updating a directory entry, adding it to the index.
+ *
+ *  @param pPInode      A pointer to the cached inode structure of the
+ *                      directory.
+ *  @param pIndex       The index populated by DirIndexUpdateStart().  May be
+ *                      `NULL`, in which case this function does nothing.
+ *  @param status       The result of the update.  If nonzero, the index is
+ *                      discarded.
+ *  @param ulIdx        The position of the updated entry.
+ *  @param pszName      The name now in the entry.
+ *  @param ulNameLen    The length of @p pszName; zero if the entry is now
+ *                      available.
+ */
+            static void DirIndexUpdateEnd( const CINODE * pPInode,
+                                           DIRINDEX * pIndex,
+                                           REDSTATUS status,
+                                           uint32_t ulIdx,
+                                           const char * pszName,
+                                           uint32_t ulNameLen )
+            {
+                if( pIndex != NULL )
+                {
+                    if( status != 0 )
+                    {
+                        pIndex->ulInode = INODE_INVALID;
+                    }
+                    else
+                    {
+                        if( ulNameLen > 0U )
+                        {
+                            if( pIndex->ulUsed == DIR_INDEX_LOAD_MAX )
+                            {
+                                pIndex->fOverflow = true;
+                            }
+                            else
+                            {
+                                DirIndexInsert( pIndex, RedNameHash( pszName, ulNameLen ), ulIdx );
+                                pIndex->ulUsed++;
+
+                                if( pIndex->ulFreeHint == ulIdx )
+                                {
+                                    pIndex->ulFreeHint++;
+                                }
+                            }
+                        }
+
+                        pIndex->ulDirentCount = DirOffsetToEntryIndex( pPInode->pInodeBuf->ullSize );
+                        pIndex->ulFreeHint = REDMIN( pIndex->ulFreeHint, pIndex->ulDirentCount );
+                    }
+                }
+            }
+
+
+/** @brief Remove an entry from the hash table of a directory index.
+ *
+ *  @param pIndex   The directory index.
+ *  @param ulHash   The hash of the name in the entry.
+ *  @param ulIdx    The position of the entry in the directory.
+ *
+ *  @return Whether the entry was found in the hash table.
+ */
+            static bool DirIndexRemove( DIRINDEX * pIndex,
+                                        uint32_t ulHash,
+                                        uint32_t ulIdx )
+            {
+                uint32_t ulHole = ulHash % REDCONF_DIR_INDEX_ENTRIES;
+                bool fFound = false;
+
+                while( !fFound && ( pIndex->aSlot[ ulHole ].ulEntryIdx != DIR_INDEX_INVALID ) )
+                {
+                    if( ( pIndex->aSlot[ ulHole ].ulHash == ulHash ) && ( pIndex->aSlot[ ulHole ].ulEntryIdx == ulIdx ) )
+                    {
+                        fFound = true;
+                    }
+                    else
+                    {
+                        ulHole = ( ulHole + 1U ) % REDCONF_DIR_INDEX_ENTRIES;
+                    }
+                }
+
+                if( fFound )
+                {
+                    uint32_t ulNext = ( ulHole + 1U ) % REDCONF_DIR_INDEX_ENTRIES;
+
+                    /*  Close the hole left by the removed slot, by moving back any
+                     *  later slot in the probe sequence whose home slot is at or
+                     *  before the hole.  This keeps every remaining slot reachable
+                     *  from its home slot without needing deletion markers.
+                     */
+                    while( pIndex->aSlot[ ulNext ].ulEntryIdx != DIR_INDEX_INVALID )
+                    {
+                        uint32_t ulHome = pIndex->aSlot[ ulNext ].ulHash % REDCONF_DIR_INDEX_ENTRIES;
+                        uint32_t ulHomeDist = ( ( ulNext + REDCONF_DIR_INDEX_ENTRIES ) - ulHome ) % REDCONF_DIR_INDEX_ENTRIES;
+                        uint32_t ulHoleDist = ( ( ulNext + REDCONF_DIR_INDEX_ENTRIES ) - ulHole ) % REDCONF_DIR_INDEX_ENTRIES;
+
+                        if( ulHomeDist >= ulHoleDist )
+                        {
+                            pIndex->aSlot[ ulHole ] = pIndex->aSlot[ ulNext ];
+                            ulHole = ulNext;
+                        }
+
+                        ulNext = ( ulNext + 1U ) % REDCONF_DIR_INDEX_ENTRIES;
+                    }
+
+                    pIndex->aSlot[ ulHole ].ulEntryIdx = DIR_INDEX_INVALID;
+                }
+
+                return fFound;
+            }
+        #endif /* REDCONF_READ_ONLY == 0 */
+
+
+/** @brief Add an entry to the hash table of a directory index.
+ *
+ *  The caller must ensure that the table has room for the entry.
+ *
+ *  @param pIndex   The directory index.
+ *  @param ulHash   The hash of the name in the entry.
+ *  @param ulIdx    The position of the entry in the directory.
+ */
+        static void DirIndexInsert( DIRINDEX * pIndex,
+                                    uint32_t ulHash,
+                                    uint32_t ulIdx )
+        {
+            uint32_t ulSlot = ulHash % REDCONF_DIR_INDEX_ENTRIES;
+
+            REDASSERT( pIndex->ulUsed < DIR_INDEX_LOAD_MAX );
+
+            while( pIndex->aSlot[ ulSlot ].ulEntryIdx != DIR_INDEX_INVALID )
+            {
+                ulSlot = ( ulSlot + 1U ) % REDCONF_DIR_INDEX_ENTRIES;
+            }
+
+            pIndex->aSlot[ ulSlot ].ulHash = ulHash;
+            pIndex->aSlot[ ulSlot ].ulEntryIdx = ulIdx;
+        }
+    #endif /* REDCONF_DIR_INDEX_DIRS > 0U */
+
+
 #endif /* REDCONF_API_POSIX == 1 */
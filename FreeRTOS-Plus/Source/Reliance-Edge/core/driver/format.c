@@ -117,6 +117,8 @@
                 #endif
                 gpRedMR->ulAllocNextBlock = gpRedCoreVol->ulFirstAllocableBN;
 
+                RedImapSummaryReset();
+
                 /*  The branched flag is typically set automatically when bits in
                  *  the imap change.  It is set here explicitly because the imap has
                  *  only been initialized, not changed.
@@ -126,6 +128,17 @@
                 ret = RedVolTransact();
             }
 
+            #if REDCONF_DISCARD_EXTENTS > 0U
+
+                /*  Every allocable block is free in the new file system, so the
+                 *  block device can forget their old contents.
+                 */
+                if( ret == 0 )
+                {
+                    ( void ) RedIoDiscard( gbRedVolNum, gpRedCoreVol->ulFirstAllocableBN, gpRedVolume->ulBlockCount - gpRedCoreVol->ulFirstAllocableBN );
+                }
+            #endif
+
             #if REDCONF_API_POSIX == 1
 
                 /*  Create the root directory.
@@ -206,6 +219,9 @@
                 #if ( REDCONF_API_POSIX == 1 ) && ( REDCONF_API_POSIX_LINK == 1 )
                     pMB->bFlags |= MBFLAG_INODE_NLINK;
                 #endif
+                #if REDCONF_INODE_INLINE_DATA == 1
+                    pMB->bFlags |= MBFLAG_INODE_INLINE;
+                #endif
 
                 ret = RedBufferFlush( BLOCK_NUM_MASTER, 1U );
 
@@ -233,6 +249,13 @@
             ret = RedBufferDiscardRange( 0U, gpRedVolume->ulBlockCount );
         }
 
+        /*  Whether or not formatting succeeded, the inodes of any readers being
+         *  tracked for read-ahead are gone.
+         */
+        #if REDCONF_READ_AHEAD_BLOCKS > 0U
+            RedInodeReadAheadDiscard();
+        #endif
+
         return ret;
     }
 
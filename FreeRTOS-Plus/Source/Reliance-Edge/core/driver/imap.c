@@ -35,6 +35,39 @@
 #include <redcore.h>
 
 
+#if REDCONF_READ_ONLY == 0
+    static REDSTATUS ImapFindFree( uint32_t ulStart,
+                                   uint32_t ulEnd,
+                                   uint32_t * pulBlock );
+    static uint32_t ImapRegion( uint32_t ulBlock );
+    #if ( REDCONF_DISCARD_EXTENTS > 0U ) || ( REDCONF_SNAPSHOTS > 0U )
+        static bool ImapExtentAdd( BLOCKEXTENT * paExtent,
+                                   uint8_t * pbCount,
+                                   uint8_t bMaxCount,
+                                   uint32_t ulBlock );
+    #endif
+    #if REDCONF_SNAPSHOTS > 0U
+        static void ImapHoldAdd( uint32_t ulBlock );
+        static uint32_t ImapHeldEnd( uint32_t ulBlock );
+    #endif
+    #if REDCONF_FAST_MOUNT == 1
+        static bool ImapSummaryFits( void );
+    #endif
+#endif
+
+
+#if REDCONF_FAST_MOUNT == 1
+
+/*  The allocation summary saved in the metaroot: the region-full bits, followed
+ *  by the low 32 bits of the metaroot sequence number, little-endian, which
+ *  shows that the summary was written along with the metaroot.  It occupies
+ *  the last bytes of the metaroot entries.
+ */
+    #define IMAP_SUMMARY_SAVED_BYTES    ( ( IMAP_SUMMARY_REGIONS / 8U ) + 4U )
+    #define IMAP_SUMMARY_SAVED_OFFSET   ( METAROOT_ENTRY_BYTES - IMAP_SUMMARY_SAVED_BYTES )
+#endif
+
+
 /** @brief Get the allocation bit of a block from either metaroot.
  *
  *  Will pass the call down either to the inline imap or to the external imap
@@ -183,10 +216,29 @@ REDSTATUS RedImapBlockGet( uint8_t bMR,
                     if( fWasAllocated )
                     {
                         gpRedCoreVol->ulAlmostFreeBlocks++;
+                        RedBitSet( gpRedCoreVol->abImapRegionAFree, ImapRegion( ulBlock ) );
+
+                        #if REDCONF_SNAPSHOTS > 0U
+                            ImapHoldAdd( ulBlock );
+                        #endif
+
+                        #if REDCONF_DISCARD_EXTENTS > 0U
+                            #if REDCONF_SNAPSHOTS > 0U
+
+                                /*  A snapshot may still read a held block, so
+                                 *  it must not be discarded.
+                                 */
+                                if( ImapHeldEnd( ulBlock ) == ulBlock )
+                            #endif
+                            {
+                                ( void ) ImapExtentAdd( gpRedCoreVol->aDiscard, &gpRedCoreVol->bDiscardCount, REDCONF_DISCARD_EXTENTS, ulBlock );
+                            }
+                        #endif
                     }
                     else
                     {
                         gpRedMR->ulFreeBlocks++;
+                        RedBitClear( gpRedCoreVol->abImapRegionFull, ImapRegion( ulBlock ) );
                     }
                 }
             }
@@ -209,45 +261,119 @@ REDSTATUS RedImapBlockGet( uint8_t bMR,
  *  @retval -RED_ENOSPC Insufficient free space to perform the allocation.
  */
     REDSTATUS RedImapAllocBlock( uint32_t * pulBlock )
+    {
+        uint32_t ulCount;
+
+        return RedImapAllocExtent( 1U, pulBlock, &ulCount );
+    }
+
+
+/** @brief Allocate a contiguous extent of blocks.
+ *
+ *  The extent starts at the first free block at or after the forward
+ *  allocation pointer, wrapping around to the start of the allocable blocks if
+ *  necessary, and includes as many of the free blocks which follow it as
+ *  possible, up to @p ulMaxCount.
+ *
+ *  @param ulMaxCount   The maximum number of blocks to allocate.  The caller
+ *                      must ensure that enough free blocks are available.
+ *  @param pulBlock     On successful return, populated with the first block
+ *                      number of the allocated extent.
+ *  @param pulCount     On successful return, populated with the number of blocks
+ *                      allocated, which is at least one.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL @p ulMaxCount is zero; or @p pulBlock or @p pulCount is
+ *                      `NULL`.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_ENOSPC Insufficient free space to perform the allocation.
+ */
+    REDSTATUS RedImapAllocExtent( uint32_t ulMaxCount,
+                                  uint32_t * pulBlock,
+                                  uint32_t * pulCount )
     {
         REDSTATUS ret;
 
-        if( pulBlock == NULL )
+        if( ( ulMaxCount == 0U ) || ( pulBlock == NULL ) || ( pulCount == NULL ) )
         {
             REDERROR();
             ret = -RED_EINVAL;
         }
-        else if( gpRedMR->ulFreeBlocks == 0U )
+        else if( RedImapFreeCount() == 0U )
         {
             ret = -RED_ENOSPC;
         }
         else
         {
-            uint32_t ulStopBlock = gpRedMR->ulAllocNextBlock;
-            bool fAllocated = false;
+            uint32_t ulBlock;
+
+            ret = ImapFindFree( gpRedMR->ulAllocNextBlock, gpRedVolume->ulBlockCount, &ulBlock );
 
-            do
+            if( ( ret == 0 ) && ( ulBlock == gpRedVolume->ulBlockCount ) )
             {
-                ALLOCSTATE state;
+                ret = ImapFindFree( gpRedCoreVol->ulFirstAllocableBN, gpRedMR->ulAllocNextBlock, &ulBlock );
 
-                ret = RedImapBlockState( gpRedMR->ulAllocNextBlock, &state );
-                CRITICAL_ASSERT( ret == 0 );
+                if( ( ret == 0 ) && ( ulBlock == gpRedMR->ulAllocNextBlock ) )
+                {
+                    /*  The free block count was already determined to be
+                     *  non-zero, no error occurred while looking for free
+                     *  blocks, but no free blocks were found.  This indicates
+                     *  metadata corruption.
+                     */
+                    CRITICAL_ERROR();
+                    ret = -RED_EFUBAR;
+                }
+            }
 
-                if( ret == 0 )
+            if( ret == 0 )
+            {
+                uint32_t ulCount = 0U;
+                bool fFree = true;
+
+                while( ( ret == 0 ) && fFree )
                 {
-                    if( state == ALLOCSTATE_FREE )
-                    {
-                        ret = RedImapBlockSet( gpRedMR->ulAllocNextBlock, true );
-                        CRITICAL_ASSERT( ret == 0 );
+                    ret = RedImapBlockSet( ulBlock + ulCount, true );
+                    CRITICAL_ASSERT( ret == 0 );
 
-                        *pulBlock = gpRedMR->ulAllocNextBlock;
-                        fAllocated = true;
+                    if( ret == 0 )
+                    {
+                        ulCount++;
+
+                        if( ( ulCount == ulMaxCount ) ||
+                            ( ( ulBlock + ulCount ) == gpRedVolume->ulBlockCount ) ||
+                            ( RedImapFreeCount() == 0U ) )
+                        {
+                            fFree = false;
+                        }
+                        else
+                        {
+                            ALLOCSTATE state;
+
+                            ret = RedImapBlockState( ulBlock + ulCount, &state );
+
+                            fFree = ( state == ALLOCSTATE_FREE );
+
+                            #if REDCONF_SNAPSHOTS > 0U
+                                if( fFree && ( ImapHeldEnd( ulBlock + ulCount ) != ( ulBlock + ulCount ) ) )
+                                {
+                                    fFree = false;
+                                }
+                            #endif
+                        }
                     }
+                }
+
+                if( ret == 0 )
+                {
+                    *pulBlock = ulBlock;
+                    *pulCount = ulCount;
 
-                    /*  Increment the next block number, wrapping it when the end of
-                     *  the volume is reached.
+                    /*  Advance the next block number past the extent, wrapping
+                     *  it when the end of the volume is reached.
                      */
-                    gpRedMR->ulAllocNextBlock++;
+                    gpRedMR->ulAllocNextBlock = ulBlock + ulCount;
 
                     if( gpRedMR->ulAllocNextBlock == gpRedVolume->ulBlockCount )
                     {
@@ -255,24 +381,453 @@ REDSTATUS RedImapBlockGet( uint8_t bMR,
                     }
                 }
             }
-            while( ( ret == 0 ) && !fAllocated && ( gpRedMR->ulAllocNextBlock != ulStopBlock ) );
+        }
+
+        return ret;
+    }
+
+
+/** @brief Reset the allocation summary of the current volume.
+ *
+ *  Called when the volume is mounted or formatted, after which the summary
+ *  knows nothing about which regions are full, and there are no almost free
+ *  blocks waiting to be discarded.
+ */
+    void RedImapSummaryReset( void )
+    {
+        uint32_t ulAllocable = gpRedVolume->ulBlockCount - gpRedCoreVol->ulFirstAllocableBN;
+
+        gpRedCoreVol->ulImapRegionBlocks = ( ulAllocable / IMAP_SUMMARY_REGIONS ) + 1U;
+
+        RedMemSet( gpRedCoreVol->abImapRegionFull, 0U, sizeof( gpRedCoreVol->abImapRegionFull ) );
+        RedMemSet( gpRedCoreVol->abImapRegionAFree, 0U, sizeof( gpRedCoreVol->abImapRegionAFree ) );
 
-            if( ( ret == 0 ) && !fAllocated )
+        #if REDCONF_DISCARD_EXTENTS > 0U
+            gpRedCoreVol->bDiscardCount = 0U;
+        #endif
+
+        #if REDCONF_SNAPSHOTS > 0U
+            RedImapHoldRelease();
+        #endif
+    }
+
+
+    #if REDCONF_FAST_MOUNT == 1
+
+/** @brief Load the allocation summary saved in the committed metaroot.
+ *
+ *  Called when the volume is mounted, after RedImapSummaryReset().  If the
+ *  summary was not saved by the transaction point which wrote the metaroot, or
+ *  there is no room for it in the metaroot, the summary stays reset.
+ *
+ *  @return Whether the saved summary was loaded.
+ */
+        bool RedImapSummaryLoad( void )
+        {
+            bool fLoaded = false;
+
+            if( ImapSummaryFits() )
             {
-                /*  The free block count was already determined to be non-zero, no
-                 *  error occurred while looking for free blocks, but no free blocks
-                 *  were found.  This indicates metadata corruption.
-                 */
-                CRITICAL_ERROR();
-                ret = -RED_EFUBAR;
+                const uint8_t * pbSaved = &gpRedMR->abEntries[ IMAP_SUMMARY_SAVED_OFFSET ];
+                uint32_t ulTag = ( uint32_t ) gpRedMR->hdr.ullSequence;
+                uint32_t ulIdx;
+
+                fLoaded = true;
+
+                for( ulIdx = 0U; ulIdx < 4U; ulIdx++ )
+                {
+                    if( pbSaved[ sizeof( gpRedCoreVol->abImapRegionFull ) + ulIdx ] != ( uint8_t ) ( ulTag >> ( ulIdx * 8U ) ) )
+                    {
+                        fLoaded = false;
+                    }
+                }
+
+                if( fLoaded )
+                {
+                    RedMemCpy( gpRedCoreVol->abImapRegionFull, pbSaved, sizeof( gpRedCoreVol->abImapRegionFull ) );
+                }
+            }
+
+            return fLoaded;
+        }
+
+
+/** @brief Save the allocation summary in the working metaroot.
+ *
+ *  Called by a transaction point once the sequence number of the metaroot is
+ *  known, before the metaroot CRC is computed.  The saved summary is the one
+ *  which RedImapSummaryTransact() will leave behind.
+ */
+        void RedImapSummarySave( void )
+        {
+            if( ImapSummaryFits() )
+            {
+                uint8_t * pbSaved = &gpRedMR->abEntries[ IMAP_SUMMARY_SAVED_OFFSET ];
+                uint32_t ulTag = ( uint32_t ) gpRedMR->hdr.ullSequence;
+                uint32_t ulIdx;
+
+                for( ulIdx = 0U; ulIdx < sizeof( gpRedCoreVol->abImapRegionFull ); ulIdx++ )
+                {
+                    pbSaved[ ulIdx ] = gpRedCoreVol->abImapRegionFull[ ulIdx ] & ( uint8_t ) ~gpRedCoreVol->abImapRegionAFree[ ulIdx ];
+                }
+
+                for( ulIdx = 0U; ulIdx < 4U; ulIdx++ )
+                {
+                    pbSaved[ sizeof( gpRedCoreVol->abImapRegionFull ) + ulIdx ] = ( uint8_t ) ( ulTag >> ( ulIdx * 8U ) );
+                }
+            }
+        }
+    #endif /* REDCONF_FAST_MOUNT == 1 */
+
+
+/** @brief Update the allocation summary of the current volume after a
+ *         transaction point.
+ *
+ *  Almost free blocks become free at a transaction point, so any region which
+ *  contained almost free blocks is no longer full.
+ */
+    void RedImapSummaryTransact( void )
+    {
+        uint32_t ulIdx;
+
+        for( ulIdx = 0U; ulIdx < sizeof( gpRedCoreVol->abImapRegionFull ); ulIdx++ )
+        {
+            gpRedCoreVol->abImapRegionFull[ ulIdx ] &= ( uint8_t ) ~gpRedCoreVol->abImapRegionAFree[ ulIdx ];
+            gpRedCoreVol->abImapRegionAFree[ ulIdx ] = 0U;
+        }
+    }
+
+
+    #if REDCONF_DISCARD_EXTENTS > 0U
+
+/** @brief Discard the blocks which became free at a transaction point.
+ *
+ *  Must be called once the transaction point has been committed: until then,
+ *  the committed state still uses the blocks.  Since almost free blocks cannot
+ *  be allocated until the transaction point, none of them can have been reused
+ *  yet.
+ *
+ *  Discarding is only advice to the block device, so errors are ignored.
+ */
+        void RedImapDiscardTransact( void )
+        {
+            uint8_t bIdx;
+
+            for( bIdx = 0U; bIdx < gpRedCoreVol->bDiscardCount; bIdx++ )
+            {
+                const BLOCKEXTENT * pExtent = &gpRedCoreVol->aDiscard[ bIdx ];
+
+                ( void ) RedIoDiscard( gbRedVolNum, pExtent->ulBlock, pExtent->ulCount );
             }
+
+            gpRedCoreVol->bDiscardCount = 0U;
+        }
+    #endif /* REDCONF_DISCARD_EXTENTS > 0U */
+
+
+    #if REDCONF_SNAPSHOTS > 0U
+
+/** @brief Update the blocks held for snapshots after a transaction point.
+ *
+ *  The held blocks which were almost free are now free, but they remain held.
+ */
+        void RedImapHoldTransact( void )
+        {
+            gpRedCoreVol->ulHeldFree = gpRedCoreVol->ulHeldBlocks;
         }
 
+
+/** @brief Release the blocks held for snapshots of the current volume.
+ *
+ *  Called when no snapshot of the volume remains which could read them.  The
+ *  free blocks can be allocated again right away; the almost free blocks
+ *  become free at the next transaction point, as usual.
+ */
+        void RedImapHoldRelease( void )
+        {
+            gpRedCoreVol->bHeldCount = 0U;
+            gpRedCoreVol->ulHeldBlocks = 0U;
+            gpRedCoreVol->ulHeldFree = 0U;
+        }
+    #endif /* REDCONF_SNAPSHOTS > 0U */
+
+
+/** @brief Find the first free block in a range of allocable blocks.
+ *
+ *  Regions which the allocation summary records as full are skipped; regions
+ *  which are examined in full and found to contain no free blocks are recorded
+ *  as full.
+ *
+ *  @param ulStart  The first block number to examine.
+ *  @param ulEnd    The block number after the last block to examine.
+ *  @param pulBlock On successful return, populated with the first free block
+ *                  in the range, or with @p ulEnd if there is none.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL Invalid parameters.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+    static REDSTATUS ImapFindFree( uint32_t ulStart,
+                                   uint32_t ulEnd,
+                                   uint32_t * pulBlock )
+    {
+        REDSTATUS ret = 0;
+        uint32_t ulBlock = ulStart;
+        uint32_t ulFound = ulEnd;
+
+        while( ( ret == 0 ) && ( ulBlock < ulEnd ) && ( ulFound == ulEnd ) )
+        {
+            uint32_t ulRegion = ImapRegion( ulBlock );
+            uint32_t ulRegionStart = gpRedCoreVol->ulFirstAllocableBN + ( ulRegion * gpRedCoreVol->ulImapRegionBlocks );
+            uint32_t ulRegionEnd = ulRegionStart + REDMIN( gpRedCoreVol->ulImapRegionBlocks, gpRedVolume->ulBlockCount - ulRegionStart );
+            uint32_t ulScanEnd = REDMIN( ulRegionEnd, ulEnd );
+
+            if( !RedBitGet( gpRedCoreVol->abImapRegionFull, ulRegion ) )
+            {
+                uint32_t ulFree;
+
+                #if ( REDCONF_IMAP_INLINE == 1 ) && ( REDCONF_IMAP_EXTERNAL == 1 )
+                    if( gpRedCoreVol->fImapInline )
+                    {
+                        ret = RedImapIFindFree( ulBlock, ulScanEnd, &ulFree );
+                    }
+                    else
+                    {
+                        ret = RedImapEFindFree( ulBlock, ulScanEnd, &ulFree );
+                    }
+                #elif REDCONF_IMAP_INLINE == 1
+                    ret = RedImapIFindFree( ulBlock, ulScanEnd, &ulFree );
+                #else
+                    ret = RedImapEFindFree( ulBlock, ulScanEnd, &ulFree );
+                #endif
+
+                if( ret == 0 )
+                {
+                    if( ulFree < ulScanEnd )
+                    {
+                        #if REDCONF_SNAPSHOTS > 0U
+                            uint32_t ulHeldEnd = ImapHeldEnd( ulFree );
+
+                            if( ulHeldEnd != ulFree )
+                            {
+                                /*  The block is held for a snapshot, so resume
+                                 *  the search after the held extent.
+                                 */
+                                ulScanEnd = REDMIN( ulHeldEnd, ulEnd );
+                            }
+                            else
+                        #endif
+                        {
+                            ulFound = ulFree;
+                        }
+                    }
+                    else if( ( ulBlock == ulRegionStart ) && ( ulScanEnd == ulRegionEnd ) )
+                    {
+                        RedBitSet( gpRedCoreVol->abImapRegionFull, ulRegion );
+                    }
+                    else
+                    {
+                        /*  Only part of the region was examined, so whether it
+                         *  is full remains unknown.
+                         */
+                    }
+                }
+            }
+
+            ulBlock = ulScanEnd;
+        }
+
+        *pulBlock = ulFound;
+
         return ret;
     }
+
+
+/** @brief Determine which region of the allocation summary contains a block.
+ *
+ *  @param ulBlock  An allocable block number.
+ *
+ *  @return The index of the region containing @p ulBlock.
+ */
+    static uint32_t ImapRegion( uint32_t ulBlock )
+    {
+        REDASSERT( ulBlock >= gpRedCoreVol->ulFirstAllocableBN );
+        REDASSERT( gpRedCoreVol->ulImapRegionBlocks > 0U );
+
+        return ( ulBlock - gpRedCoreVol->ulFirstAllocableBN ) / gpRedCoreVol->ulImapRegionBlocks;
+    }
+
+
+    #if REDCONF_FAST_MOUNT == 1
+
+/** @brief Determine whether the allocation summary can be saved in the
+ *         metaroot.
+ *
+ *  The summary is saved in the metaroot entries after the last byte used by
+ *  the imap: with the inline imap, that is the imap itself; with the external
+ *  imap, it is the bits which select between the two copies of each imap node.
+ *
+ *  @return Whether there is room for the summary.
+ */
+        static bool ImapSummaryFits( void )
+        {
+            uint32_t ulEntries;
+
+            #if ( REDCONF_IMAP_INLINE == 1 ) && ( REDCONF_IMAP_EXTERNAL == 1 )
+                if( gpRedCoreVol->fImapInline )
+                {
+                    ulEntries = gpRedVolume->ulBlockCount - gpRedCoreVol->ulInodeTableStartBN;
+                }
+                else
+                {
+                    ulEntries = gpRedCoreVol->ulImapNodeCount;
+                }
+            #elif REDCONF_IMAP_INLINE == 1
+                ulEntries = gpRedVolume->ulBlockCount - gpRedCoreVol->ulInodeTableStartBN;
+            #else /* if ( REDCONF_IMAP_INLINE == 1 ) && ( REDCONF_IMAP_EXTERNAL == 1 ) */
+                ulEntries = gpRedCoreVol->ulImapNodeCount;
+            #endif /* if ( REDCONF_IMAP_INLINE == 1 ) && ( REDCONF_IMAP_EXTERNAL == 1 ) */
+
+            return ( ( ulEntries + 7U ) / 8U ) <= IMAP_SUMMARY_SAVED_OFFSET;
+        }
+    #endif /* REDCONF_FAST_MOUNT == 1 */
+
+
+    #if ( REDCONF_DISCARD_EXTENTS > 0U ) || ( REDCONF_SNAPSHOTS > 0U )
+
+/** @brief Add a block to a list of extents.
+ *
+ *  Blocks tend to be freed in runs, in either direction, so the block is added
+ *  to an extent which it adjoins if there is one.  Otherwise, it starts a new
+ *  extent, if not every extent is in use.
+ *
+ *  @param paExtent     The extents.
+ *  @param pbCount      The number of extents in use in @p paExtent; updated if
+ *                      a new extent is started.
+ *  @param bMaxCount    The number of elements in @p paExtent.
+ *  @param ulBlock      The block to add.
+ *
+ *  @return Whether the block was added.
+ */
+        static bool ImapExtentAdd( BLOCKEXTENT * paExtent,
+                                   uint8_t * pbCount,
+                                   uint8_t bMaxCount,
+                                   uint32_t ulBlock )
+        {
+            bool fAdded = false;
+            uint8_t bIdx;
+
+            for( bIdx = 0U; bIdx < *pbCount; bIdx++ )
+            {
+                BLOCKEXTENT * pExtent = &paExtent[ bIdx ];
+
+                if( ( pExtent->ulBlock + pExtent->ulCount ) == ulBlock )
+                {
+                    pExtent->ulCount++;
+                    fAdded = true;
+                    break;
+                }
+
+                if( ( ulBlock + 1U ) == pExtent->ulBlock )
+                {
+                    pExtent->ulBlock = ulBlock;
+                    pExtent->ulCount++;
+                    fAdded = true;
+                    break;
+                }
+            }
+
+            if( ( !fAdded ) && ( *pbCount < bMaxCount ) )
+            {
+                paExtent[ *pbCount ].ulBlock = ulBlock;
+                paExtent[ *pbCount ].ulCount = 1U;
+                ( *pbCount )++;
+                fAdded = true;
+            }
+
+            return fAdded;
+        }
+    #endif /* ( REDCONF_DISCARD_EXTENTS > 0U ) || ( REDCONF_SNAPSHOTS > 0U ) */
+
+
+    #if REDCONF_SNAPSHOTS > 0U
+
+/** @brief Hold a block freed from the committed state, if it belongs to a file
+ *         with an open snapshot, so that it is not reallocated while the
+ *         snapshot might still read it.
+ *
+ *  If every extent is in use, the block cannot be held, so the open snapshots
+ *  are made stale instead; that releases the blocks held for them.
+ *
+ *  @param ulBlock  The block which is now almost free.
+ */
+        static void ImapHoldAdd( uint32_t ulBlock )
+        {
+            if( gpRedCoreVol->fSnapHold )
+            {
+                if( ImapExtentAdd( gpRedCoreVol->aHeld, &gpRedCoreVol->bHeldCount, REDCONF_SNAPSHOT_EXTENTS, ulBlock ) )
+                {
+                    gpRedCoreVol->ulHeldBlocks++;
+                }
+                else
+                {
+                    RedSnapStale();
+                }
+            }
+        }
+
+
+/** @brief Find the end of the held extent which contains a block.
+ *
+ *  @param ulBlock  The block number to look for.
+ *
+ *  @return The block number after the held extent which contains @p ulBlock;
+ *          or @p ulBlock itself, if the block is not held.
+ */
+        static uint32_t ImapHeldEnd( uint32_t ulBlock )
+        {
+            uint32_t ulEnd = ulBlock;
+            uint8_t bIdx;
+
+            for( bIdx = 0U; bIdx < gpRedCoreVol->bHeldCount; bIdx++ )
+            {
+                const BLOCKEXTENT * pExtent = &gpRedCoreVol->aHeld[ bIdx ];
+
+                if( ( ulBlock >= pExtent->ulBlock ) && ( ( ulBlock - pExtent->ulBlock ) < pExtent->ulCount ) )
+                {
+                    ulEnd = pExtent->ulBlock + pExtent->ulCount;
+                    break;
+                }
+            }
+
+            return ulEnd;
+        }
+    #endif /* REDCONF_SNAPSHOTS > 0U */
 #endif /* REDCONF_READ_ONLY == 0 */
 
 
+/** @brief Get the number of free blocks which can be allocated.
+ *
+ *  This is the free block count of the working metaroot, less any free blocks
+ *  which are held for snapshots.
+ *
+ *  @return The number of free blocks which can be allocated.
+ */
+uint32_t RedImapFreeCount( void )
+{
+    uint32_t ulFree = gpRedMR->ulFreeBlocks;
+
+    #if REDCONF_SNAPSHOTS > 0U
+        REDASSERT( ulFree >= gpRedCoreVol->ulHeldFree );
+        ulFree -= gpRedCoreVol->ulHeldFree;
+    #endif
+
+    return ulFree;
+}
+
+
 /** @brief Get the allocation state of a block.
  *
  *  Takes into account the allocation bits from both metaroots, and returns one
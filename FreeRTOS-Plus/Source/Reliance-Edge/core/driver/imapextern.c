@@ -40,6 +40,13 @@
 
 
     #if REDCONF_READ_ONLY == 0
+
+/*  Number of bytes of a branched imap node which RedImapEFindFree() examines at
+ *  a time.  The committed copy of the bytes is copied to the stack, since only
+ *  one imap node buffer may be referenced at a time.
+ */
+        #define IMAP_SCAN_CHUNK_BYTES    64U
+
         static REDSTATUS ImapNodeBranch( uint32_t ulImapNode,
                                          IMAPNODE ** ppImap );
         static bool ImapNodeIsBranched( uint32_t ulImapNode );
@@ -176,6 +183,120 @@
         }
 
 
+/** @brief Find the first free block in a range of blocks.
+ *
+ *  A block is free when its allocation bit is clear in both the working-state
+ *  and committed-state imaps.  The bitmaps are examined a word at a time.
+ *
+ *  @param ulStart  The first block number to examine.
+ *  @param ulEnd    The block number after the last block to examine.
+ *  @param pulBlock On successful return, populated with the first free block
+ *                  in the range, or with @p ulEnd if there is none.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The range is invalid; or @p pulBlock is `NULL`; or the
+ *                      current volume does not use the external imap.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+        REDSTATUS RedImapEFindFree( uint32_t ulStart,
+                                    uint32_t ulEnd,
+                                    uint32_t * pulBlock )
+        {
+            REDSTATUS ret = 0;
+
+            if( gpRedCoreVol->fImapInline ||
+                ( ulStart < gpRedCoreVol->ulInodeTableStartBN ) ||
+                ( ulStart > ulEnd ) ||
+                ( ulEnd > gpRedVolume->ulBlockCount ) ||
+                ( pulBlock == NULL ) )
+            {
+                REDERROR();
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                uint32_t ulOffset = ulStart - gpRedCoreVol->ulInodeTableStartBN;
+                uint32_t ulEndOffset = ulEnd - gpRedCoreVol->ulInodeTableStartBN;
+                bool fFound = false;
+
+                while( ( ret == 0 ) && !fFound && ( ulOffset < ulEndOffset ) )
+                {
+                    uint32_t ulImapNode = ulOffset / IMAPNODE_ENTRIES;
+                    uint32_t ulNodeOffset = ulImapNode * IMAPNODE_ENTRIES;
+                    uint32_t ulEntry = ulOffset - ulNodeOffset;
+                    uint32_t ulEntryEnd = REDMIN( ulEndOffset - ulNodeOffset, IMAPNODE_ENTRIES );
+                    uint32_t ulChunkEntry = 0U;
+                    uint8_t abCommitted[ IMAP_SCAN_CHUNK_BYTES ];
+                    const uint8_t * pbCommitted = NULL;
+                    IMAPNODE * pImap;
+
+                    if( ImapNodeIsBranched( ulImapNode ) )
+                    {
+                        /*  The committed copy of the node differs from the
+                         *  working copy, so examine one chunk of the node, using
+                         *  a copy of the committed bits.
+                         */
+                        uint32_t ulChunkBytes;
+
+                        ulChunkEntry = ulEntry & ~( ( IMAP_SCAN_CHUNK_BYTES * 8U ) - 1U );
+                        ulEntryEnd = REDMIN( ulEntryEnd, ulChunkEntry + ( IMAP_SCAN_CHUNK_BYTES * 8U ) );
+                        ulChunkBytes = ( ( ulEntryEnd + 7U ) >> 3U ) - ( ulChunkEntry >> 3U );
+
+                        ret = RedBufferGet( RedImapNodeBlock( 1U - gpRedCoreVol->bCurMR, ulImapNode ), BFLAG_META_IMAP, CAST_VOID_PTR_PTR( &pImap ) );
+
+                        if( ret == 0 )
+                        {
+                            RedMemCpy( abCommitted, &pImap->abEntries[ ulChunkEntry >> 3U ], ulChunkBytes );
+                            RedBufferPut( pImap );
+                            pbCommitted = abCommitted;
+                        }
+                    }
+
+                    if( ret == 0 )
+                    {
+                        ret = RedBufferGet( RedImapNodeBlock( gpRedCoreVol->bCurMR, ulImapNode ), BFLAG_META_IMAP, CAST_VOID_PTR_PTR( &pImap ) );
+                    }
+
+                    if( ret == 0 )
+                    {
+                        const uint8_t * pbWorking = &pImap->abEntries[ ulChunkEntry >> 3U ];
+                        uint32_t ulFound;
+
+                        /*  If the node is not branched, both copies are the same.
+                         */
+                        if( pbCommitted == NULL )
+                        {
+                            pbCommitted = pbWorking;
+                        }
+
+                        ulFound = RedBitFindClear( pbWorking, pbCommitted, ulEntry - ulChunkEntry, ulEntryEnd - ulChunkEntry ) + ulChunkEntry;
+
+                        RedBufferPut( pImap );
+
+                        if( ulFound < ulEntryEnd )
+                        {
+                            *pulBlock = gpRedCoreVol->ulInodeTableStartBN + ulNodeOffset + ulFound;
+                            fFound = true;
+                        }
+                        else
+                        {
+                            ulOffset = ulNodeOffset + ulEntryEnd;
+                        }
+                    }
+                }
+
+                if( ( ret == 0 ) && !fFound )
+                {
+                    *pulBlock = ulEnd;
+                }
+            }
+
+            return ret;
+        }
+
+
 /** @brief Branch an imap node and get a buffer for it.
  *
  *  If the imap node is already branched, it can be overwritten in its current
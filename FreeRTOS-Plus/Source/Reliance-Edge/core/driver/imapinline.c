@@ -128,6 +128,49 @@
 
             return ret;
         }
+
+
+/** @brief Find the first free block in a range of blocks.
+ *
+ *  A block is free when its allocation bit is clear in both metaroots.
+ *
+ *  @param ulStart  The first block number to examine.
+ *  @param ulEnd    The block number after the last block to examine.
+ *  @param pulBlock On successful return, populated with the first free block
+ *                  in the range, or with @p ulEnd if there is none.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The range is invalid; or @p pulBlock is `NULL`; or the
+ *                      current volume does not use the inline imap.
+ */
+        REDSTATUS RedImapIFindFree( uint32_t ulStart,
+                                    uint32_t ulEnd,
+                                    uint32_t * pulBlock )
+        {
+            REDSTATUS ret;
+
+            if( ( !gpRedCoreVol->fImapInline ) ||
+                ( ulStart < gpRedCoreVol->ulInodeTableStartBN ) ||
+                ( ulStart > ulEnd ) ||
+                ( ulEnd > gpRedVolume->ulBlockCount ) ||
+                ( pulBlock == NULL ) )
+            {
+                REDERROR();
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                uint32_t ulOffset = RedBitFindClear( gpRedCoreVol->aMR[ 0U ].abEntries, gpRedCoreVol->aMR[ 1U ].abEntries,
+                                                     ulStart - gpRedCoreVol->ulInodeTableStartBN, ulEnd - gpRedCoreVol->ulInodeTableStartBN );
+
+                *pulBlock = ulOffset + gpRedCoreVol->ulInodeTableStartBN;
+                ret = 0;
+            }
+
+            return ret;
+        }
     #endif /* if REDCONF_READ_ONLY == 0 */
 
 #endif /* REDCONF_IMAP_INLINE == 1 */
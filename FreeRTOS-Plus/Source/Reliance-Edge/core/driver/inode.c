@@ -31,6 +31,23 @@
 #include <redcore.h>
 
 
+#if REDCONF_INODE_CACHE_ENTRIES > 0U
+
+/** @brief Cached location of a mounted inode.
+ */
+    typedef struct
+    {
+        uint32_t ulInode;   /**< Inode number; INODE_INVALID if the entry is unused. */
+        uint32_t ulStamp;   /**< Time of last use, for least-recently-used replacement. */
+        uint8_t bVolNum;    /**< Volume containing the inode. */
+        uint8_t bWhich;     /**< Which copy of the inode (either 0 or 1) is current. */
+        #if REDCONF_READ_ONLY == 0
+            bool fBranched; /**< Whether the inode is branched. */
+        #endif
+    } ICACHEENTRY;
+#endif
+
+
 #if REDCONF_READ_ONLY == 0
     static REDSTATUS InodeIsBranched( uint32_t ulInode,
                                       bool * pfIsBranched );
@@ -51,6 +68,20 @@ static REDSTATUS InodeGetCurrentCopy( uint32_t ulInode,
 #endif
 static uint32_t InodeBlock( uint32_t ulInode,
                             uint8_t bWhich );
+#if REDCONF_INODE_CACHE_ENTRIES > 0U
+    static ICACHEENTRY * InodeCacheFind( uint32_t ulInode );
+    static void InodeCacheInsert( const CINODE * pInode,
+                                  uint8_t bWhich );
+    #if REDCONF_READ_ONLY == 0
+        static void InodeCacheInvalidate( uint32_t ulInode );
+    #endif
+#endif
+
+
+#if REDCONF_INODE_CACHE_ENTRIES > 0U
+    static ICACHEENTRY gaIcache[ REDCONF_INODE_CACHE_ENTRIES ];
+    static uint32_t gulIcacheStamp;
+#endif
 
 
 /** @brief Mount an existing inode.
@@ -109,20 +140,62 @@ REDSTATUS RedInodeMount( CINODE * pInode,
         uint32_t ulInode = pInode->ulInode;
         uint8_t bWhich = 0U; /* Init'd to quiet warnings. */
 
+        #if REDCONF_INODE_CACHE_ENTRIES > 0U
+            const ICACHEENTRY * pEntry;
+        #endif
+
         RedMemSet( pInode, 0U, sizeof( *pInode ) );
         pInode->ulInode = ulInode;
 
-        ret = InodeGetCurrentCopy( pInode->ulInode, &bWhich );
+        #if REDCONF_INODE_CACHE_ENTRIES > 0U
+            pEntry = InodeCacheFind( ulInode );
+
+            if( pEntry != NULL )
+            {
+                bWhich = pEntry->bWhich;
+            }
+            else
+        #endif
+        {
+            ret = InodeGetCurrentCopy( pInode->ulInode, &bWhich );
+        }
 
         if( ret == 0 )
         {
             ret = RedBufferGet( InodeBlock( pInode->ulInode, bWhich ), BFLAG_META_INODE, CAST_VOID_PTR_PTR( &pInode->pInodeBuf ) );
         }
 
+        /*  The FS mutex might have been released while the buffer was read, so
+         *  the cached entry, if any, is found again rather than reused, and
+         *  whether the inode is branched is only determined now.
+         */
         #if REDCONF_READ_ONLY == 0
             if( ret == 0 )
             {
-                ret = InodeIsBranched( pInode->ulInode, &pInode->fBranched );
+                #if REDCONF_INODE_CACHE_ENTRIES > 0U
+                    pEntry = InodeCacheFind( ulInode );
+
+                    if( ( pEntry != NULL ) && ( pEntry->bWhich == bWhich ) )
+                    {
+                        pInode->fBranched = pEntry->fBranched;
+                    }
+                    else
+                #endif
+                {
+                    ret = InodeIsBranched( pInode->ulInode, &pInode->fBranched );
+
+                    #if REDCONF_INODE_CACHE_ENTRIES > 0U
+                        if( ( ret == 0 ) && ( pEntry == NULL ) )
+                        {
+                            InodeCacheInsert( pInode, bWhich );
+                        }
+                    #endif
+                }
+            }
+        #elif REDCONF_INODE_CACHE_ENTRIES > 0U
+            if( ret == 0 )
+            {
+                InodeCacheInsert( pInode, bWhich );
             }
         #endif
 
@@ -223,6 +296,7 @@ REDSTATUS RedInodeMount( CINODE * pInode,
         else
         {
             uint32_t ulInode = pInode->ulInode;
+            uint8_t bWriteableWhich = 0U; /* Init'd to quiet warnings. */
 
             RedMemSet( pInode, 0U, sizeof( *pInode ) );
 
@@ -266,8 +340,6 @@ REDSTATUS RedInodeMount( CINODE * pInode,
 
             if( ret == 0 )
             {
-                uint8_t bWriteableWhich;
-
                 ret = InodeGetWriteableCopy( pInode->ulInode, &bWriteableWhich );
 
                 if( ret == 0 )
@@ -301,6 +373,16 @@ REDSTATUS RedInodeMount( CINODE * pInode,
 
                 pInode->pInodeBuf->uMode = uMode;
 
+                #if REDCONF_INODE_INLINE_DATA == 1
+
+                    /*  A new file is empty, so its data starts out inline.
+                     */
+                    if( RED_S_ISREG( uMode ) )
+                    {
+                        pInode->pInodeBuf->uMode = ( uint16_t ) ( uMode | INODE_MODE_INLINE );
+                    }
+                #endif
+
                 #if REDCONF_API_POSIX == 1
                     #if REDCONF_API_POSIX_LINK == 1
                         pInode->pInodeBuf->uNLink = 1U;
@@ -313,6 +395,10 @@ REDSTATUS RedInodeMount( CINODE * pInode,
                 pInode->fBranched = true;
                 pInode->fDirty = true;
 
+                #if REDCONF_INODE_CACHE_ENTRIES > 0U
+                    InodeCacheInsert( pInode, bWriteableWhich );
+                #endif
+
                 #if REDCONF_API_POSIX == 1
                     gpRedMR->ulFreeInodes--;
                 #endif
@@ -352,6 +438,13 @@ REDSTATUS RedInodeMount( CINODE * pInode,
                 ret = RedInodeDataTruncate( pInode, UINT64_SUFFIX( 0 ) );
             }
 
+            #if REDCONF_SNAPSHOTS > 0U
+                if( ret == 0 )
+                {
+                    RedSnapInodeDeleted( pInode->ulInode );
+                }
+            #endif
+
             if( ret == 0 )
             {
                 ret = RedInodeFree( pInode );
@@ -769,6 +862,13 @@ void RedInodePutData( CINODE * pInode )
                 ret = InodeBitSet( pInode->ulInode, bWhich, true );
             }
 
+            #if REDCONF_INODE_CACHE_ENTRIES > 0U
+                if( ret == 0 )
+                {
+                    InodeCacheInsert( pInode, bWhich );
+                }
+            #endif
+
             CRITICAL_ASSERT( ret == 0 );
         }
         else
@@ -1102,6 +1202,10 @@ REDSTATUS RedInodeBitGet( uint8_t bMR,
         }
         else
         {
+            #if REDCONF_INODE_CACHE_ENTRIES > 0U
+                InodeCacheInvalidate( ulInode );
+            #endif
+
             ret = RedImapBlockSet( InodeBlock( ulInode, bWhich ), fAllocated );
         }
 
@@ -1125,3 +1229,129 @@ static uint32_t InodeBlock( uint32_t ulInode,
 
     return gpRedCoreVol->ulInodeTableStartBN + ( ( ulInode - INODE_FIRST_VALID ) * 2U ) + bWhich;
 }
+
+
+#if REDCONF_INODE_CACHE_ENTRIES > 0U
+
+/** @brief Find the cached location of an inode on the current volume.
+ *
+ *  @param ulInode  The inode number.
+ *
+ *  @return A pointer to the cache entry, or `NULL` if the inode is not cached.
+ */
+    static ICACHEENTRY * InodeCacheFind( uint32_t ulInode )
+    {
+        ICACHEENTRY * pEntry = NULL;
+        uint32_t ulIdx;
+
+        for( ulIdx = 0U; ulIdx < REDCONF_INODE_CACHE_ENTRIES; ulIdx++ )
+        {
+            ICACHEENTRY * pThisEntry = &gaIcache[ ulIdx ];
+
+            if( ( pThisEntry->ulInode == ulInode ) && ( pThisEntry->bVolNum == gbRedVolNum ) )
+            {
+                gulIcacheStamp++;
+                pThisEntry->ulStamp = gulIcacheStamp;
+                pEntry = pThisEntry;
+                break;
+            }
+        }
+
+        return pEntry;
+    }
+
+
+/** @brief Cache the location of a mounted inode.
+ *
+ *  @param pInode   The mounted inode; its fBranched member must be accurate.
+ *  @param bWhich   Which copy of the inode (either 0 or 1) is current.
+ */
+    static void InodeCacheInsert( const CINODE * pInode,
+                                  uint8_t bWhich )
+    {
+        ICACHEENTRY * pEntry = InodeCacheFind( pInode->ulInode );
+
+        if( pEntry == NULL )
+        {
+            uint32_t ulIdx;
+
+            /*  Use an unused entry if there is one, otherwise replace the least
+             *  recently used entry.
+             */
+            pEntry = &gaIcache[ 0U ];
+
+            for( ulIdx = 1U; ( ulIdx < REDCONF_INODE_CACHE_ENTRIES ) && ( pEntry->ulInode != INODE_INVALID ); ulIdx++ )
+            {
+                if( ( gaIcache[ ulIdx ].ulInode == INODE_INVALID ) ||
+                    ( ( gulIcacheStamp - gaIcache[ ulIdx ].ulStamp ) > ( gulIcacheStamp - pEntry->ulStamp ) ) )
+                {
+                    pEntry = &gaIcache[ ulIdx ];
+                }
+            }
+
+            pEntry->ulInode = pInode->ulInode;
+            pEntry->bVolNum = gbRedVolNum;
+
+            gulIcacheStamp++;
+            pEntry->ulStamp = gulIcacheStamp;
+        }
+
+        pEntry->bWhich = bWhich;
+        #if REDCONF_READ_ONLY == 0
+            pEntry->fBranched = pInode->fBranched;
+        #endif
+    }
+
+
+    #if REDCONF_READ_ONLY == 0
+
+/** @brief Remove the cached location of an inode, if there is one.
+ *
+ *  @param ulInode  The inode number.
+ */
+        static void InodeCacheInvalidate( uint32_t ulInode )
+        {
+            ICACHEENTRY * pEntry = InodeCacheFind( ulInode );
+
+            if( pEntry != NULL )
+            {
+                pEntry->ulInode = INODE_INVALID;
+            }
+        }
+
+
+/** @brief Update the cached inode locations for a transaction point.
+ *
+ *  The working state has become the committed state, so the current copy of
+ *  each inode is unchanged but no inode is branched anymore.
+ */
+        void RedInodeCacheTransact( void )
+        {
+            uint32_t ulIdx;
+
+            for( ulIdx = 0U; ulIdx < REDCONF_INODE_CACHE_ENTRIES; ulIdx++ )
+            {
+                if( gaIcache[ ulIdx ].bVolNum == gbRedVolNum )
+                {
+                    gaIcache[ ulIdx ].fBranched = false;
+                }
+            }
+        }
+    #endif /* REDCONF_READ_ONLY == 0 */
+
+
+/** @brief Remove all cached inode locations for the current volume.
+ */
+    void RedInodeCacheDiscard( void )
+    {
+        uint32_t ulIdx;
+
+        for( ulIdx = 0U; ulIdx < REDCONF_INODE_CACHE_ENTRIES; ulIdx++ )
+        {
+            if( gaIcache[ ulIdx ].bVolNum == gbRedVolNum )
+            {
+                gaIcache[ ulIdx ].ulInode = INODE_INVALID;
+            }
+        }
+    }
+#endif /* REDCONF_INODE_CACHE_ENTRIES > 0U */
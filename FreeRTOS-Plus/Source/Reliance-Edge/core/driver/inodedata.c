@@ -55,6 +55,32 @@ typedef enum
 } BRANCHDEPTH;
 
 
+#if REDCONF_INODE_INLINE_DATA == 1
+
+/*  The inline file data of a cached inode, as a byte array.
+ */
+    #define INLINE_DATA( pInode )    ( CAST_VOID_PTR_TO_UINT8_PTR( ( pInode )->pInodeBuf->aulEntries ) )
+#endif
+
+
+#if REDCONF_READ_AHEAD_BLOCKS > 0U
+
+/*  Number of sequential readers which are tracked at once for read-ahead.
+ */
+    #define READAHEAD_STREAMS    4U
+
+/** @brief State of a reader being tracked for read-ahead.
+ */
+    typedef struct
+    {
+        uint32_t ulInode;     /**< Inode being read; INODE_INVALID if unused. */
+        uint32_t ulNextBlock; /**< File block offset which a sequential reader will read next. */
+        uint32_t ulWindowEnd; /**< File block offset just past the blocks which were read ahead. */
+        uint8_t bVolNum;      /**< Volume containing the inode. */
+    } READAHEAD;
+#endif
+
+
 #if REDCONF_READ_ONLY == 0
     #if DELETE_SUPPORTED || TRUNCATE_SUPPORTED
         static REDSTATUS Shrink( CINODE * pInode,
@@ -72,6 +98,9 @@ typedef enum
                                          bool fPropagate );
     #endif /* if DELETE_SUPPORTED || TRUNCATE_SUPPORTED */
     static REDSTATUS ExpandPrepare( CINODE * pInode );
+    #if REDCONF_INODE_INLINE_DATA == 1
+        static REDSTATUS InlineSpill( CINODE * pInode );
+    #endif
 #endif /* if REDCONF_READ_ONLY == 0 */
 static void SeekCoord( CINODE * pInode,
                        uint32_t ulBlock );
@@ -83,6 +112,10 @@ static REDSTATUS ReadAligned( CINODE * pInode,
                               uint32_t ulBlockStart,
                               uint32_t ulBlockCount,
                               uint8_t * pbBuffer );
+#if REDCONF_READ_AHEAD_BLOCKS > 0U
+    static void ReadAhead( CINODE * pInode,
+                           uint32_t ulBlock );
+#endif
 #if REDCONF_READ_ONLY == 0
     static REDSTATUS WriteUnaligned( CINODE * pInode,
                                      uint64_t ullStart,
@@ -111,6 +144,22 @@ static REDSTATUS GetExtent( CINODE * pInode,
 #endif /* if REDCONF_READ_ONLY == 0 */
 
 
+#if REDCONF_READ_AHEAD_BLOCKS > 0U
+    static READAHEAD gaReadAhead[ READAHEAD_STREAMS ];
+    static uint8_t gbReadAheadNext;
+#endif
+
+#if REDCONF_READ_ONLY == 0
+
+/*  Contiguous extent of blocks which WriteAligned() has allocated in advance
+ *  for file data.  While gulDataExtentLeft is nonzero, BranchOneBlock() takes
+ *  file data blocks from the extent rather than allocating them one at a time.
+ */
+    static uint32_t gulDataExtentNext;
+    static uint32_t gulDataExtentLeft;
+#endif
+
+
 /** @brief Read data from an inode.
  *
  *  @param pInode   A pointer to the cached inode structure of the inode from
@@ -148,6 +197,17 @@ REDSTATUS RedInodeDataRead( CINODE * pInode,
         /*  Do nothing, just return success.
          */
     }
+
+    #if REDCONF_INODE_INLINE_DATA == 1
+        else if( INODE_IS_INLINE( pInode->pInodeBuf ) )
+        {
+            uint32_t ulLen = REDMIN( *pulLen, ( uint32_t ) ( pInode->pInodeBuf->ullSize - ullStart ) );
+
+            RedMemCpy( pBuffer, &INLINE_DATA( pInode )[ ullStart ], ulLen );
+
+            *pulLen = ulLen;
+        }
+    #endif
     else
     {
         uint8_t * pbBuffer = CAST_VOID_PTR_TO_UINT8_PTR( pBuffer );
@@ -182,6 +242,27 @@ REDSTATUS RedInodeDataRead( CINODE * pInode,
             }
         }
 
+        #if REDCONF_READ_AHEAD_BLOCKS > 0U
+
+            /*  Whole blocks, when there are few enough of them that read-ahead
+             *  is worthwhile.  These are read through the buffers, like partial
+             *  blocks, so that a sequential reader can benefit from read-ahead.
+             */
+            if( ( ret == 0 ) && ( ulRemaining >= REDCONF_BLOCK_SIZE ) && ( ( ulRemaining >> BLOCK_SIZE_P2 ) < REDCONF_READ_AHEAD_BLOCKS ) )
+            {
+                while( ( ret == 0 ) && ( ulRemaining >= REDCONF_BLOCK_SIZE ) )
+                {
+                    ret = ReadUnaligned( pInode, ullStart + ulReadIndex, REDCONF_BLOCK_SIZE, &pbBuffer[ ulReadIndex ] );
+
+                    if( ret == 0 )
+                    {
+                        ulReadIndex += REDCONF_BLOCK_SIZE;
+                        ulRemaining -= REDCONF_BLOCK_SIZE;
+                    }
+                }
+            }
+        #endif
+
         /*  Whole blocks.
          */
         if( ( ret == 0 ) && ( ulRemaining >= REDCONF_BLOCK_SIZE ) )
@@ -220,6 +301,123 @@ REDSTATUS RedInodeDataRead( CINODE * pInode,
 }
 
 
+#if REDCONF_READ_LEASES > 0U
+
+/** @brief Lease data from an inode, without copying it.
+ *
+ *  The data is leased from the block buffer which contains it, and so never
+ *  extends past the end of the block containing @p ullStart.  Sparse data is
+ *  leased from a buffer of zeroes.
+ *
+ *  @param pInode   A pointer to the cached inode structure of the inode from
+ *                  which to read.
+ *  @param ullStart The file offset at which to read.
+ *  @param pulLen   On input, the maximum number of bytes to lease.  On
+ *                  successful return, populated with the number of bytes
+ *                  actually leased, which is zero at or beyond the
+ *                  end-of-file.
+ *  @param ppData   On successful return with a nonzero length, populated with
+ *                  a pointer to the leased data, which must be released with
+ *                  RedBufferLeaseRelease().
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBUSY  The maximum number of leases are outstanding.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_EINVAL @p pInode is not a mounted cached inode pointer; or
+ *                      @p pulLen is `NULL`; or @p ppData is `NULL`.
+ */
+    REDSTATUS RedInodeDataLease( CINODE * pInode,
+                                 uint64_t ullStart,
+                                 uint32_t * pulLen,
+                                 const void ** ppData )
+    {
+        REDSTATUS ret = 0;
+
+        if( !CINODE_IS_MOUNTED( pInode ) || ( pulLen == NULL ) || ( ppData == NULL ) )
+        {
+            ret = -RED_EINVAL;
+        }
+        else if( ( ullStart >= pInode->pInodeBuf->ullSize ) || ( *pulLen == 0U ) )
+        {
+            *pulLen = 0U;
+        }
+
+        #if REDCONF_INODE_INLINE_DATA == 1
+            else if( INODE_IS_INLINE( pInode->pInodeBuf ) )
+            {
+                uint32_t ulLen = REDMIN( *pulLen, ( uint32_t ) ( pInode->pInodeBuf->ullSize - ullStart ) );
+                const void * pLeased = NULL;
+
+                /*  The data is leased from a copy of the inode buffer, which the
+                 *  cached inode still needs.
+                 */
+                ret = RedBufferLeaseCopy( pInode->pInodeBuf, &pLeased );
+
+                if( ret == 0 )
+                {
+                    const INODE * pLeasedInode = pLeased;
+
+                    *ppData = &CAST_VOID_PTR_TO_CONST_UINT8_PTR( pLeasedInode->aulEntries )[ ullStart ];
+                    *pulLen = ulLen;
+                }
+            }
+        #endif
+        else
+        {
+            uint32_t ulBlock = ( uint32_t ) ( ullStart >> BLOCK_SIZE_P2 );
+            uint32_t ulOffset = ( uint32_t ) ( ullStart & ( REDCONF_BLOCK_SIZE - 1U ) );
+            uint32_t ulLen = REDMIN( *pulLen, REDCONF_BLOCK_SIZE - ulOffset );
+            const void * pLeased = NULL;
+
+            if( ( pInode->pInodeBuf->ullSize - ullStart ) < ulLen )
+            {
+                ulLen = ( uint32_t ) ( pInode->pInodeBuf->ullSize - ullStart );
+            }
+
+            ret = RedInodeDataSeekAndRead( pInode, ulBlock );
+
+            if( ret == 0 )
+            {
+                /*  The lease takes over the reference to the buffer.
+                 */
+                ret = RedBufferLease( pInode->pbData, &pLeased );
+
+                if( ret == 0 )
+                {
+                    pInode->pbData = NULL;
+                }
+            }
+            else if( ret == -RED_ENODATA )
+            {
+                ret = RedBufferLease( NULL, &pLeased );
+            }
+            else
+            {
+                /*  No action, just return the error.
+                 */
+            }
+
+            #if REDCONF_READ_AHEAD_BLOCKS > 0U
+                if( ret == 0 )
+                {
+                    ReadAhead( pInode, ulBlock );
+                }
+            #endif
+
+            if( ret == 0 )
+            {
+                *ppData = &CAST_VOID_PTR_TO_CONST_UINT8_PTR( pLeased )[ ulOffset ];
+                *pulLen = ulLen;
+            }
+        }
+
+        return ret;
+    }
+#endif /* REDCONF_READ_LEASES > 0U */
+
+
 #if REDCONF_READ_ONLY == 0
 
 /** @brief Write to an inode.
@@ -264,6 +462,18 @@ REDSTATUS RedInodeDataRead( CINODE * pInode,
             /*  Do nothing, just return success.
              */
         }
+
+        #if REDCONF_INODE_INLINE_DATA == 1
+            else if( INODE_IS_INLINE( pInode->pInodeBuf ) && ( ( ullStart + *pulLen ) <= INODE_INLINE_MAX ) )
+            {
+                RedMemCpy( &INLINE_DATA( pInode )[ ullStart ], pBuffer, *pulLen );
+
+                if( ( ullStart + *pulLen ) > pInode->pInodeBuf->ullSize )
+                {
+                    pInode->pInodeBuf->ullSize = ullStart + *pulLen;
+                }
+            }
+        #endif
         else
         {
             const uint8_t * pbBuffer = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pBuffer );
@@ -278,11 +488,18 @@ REDSTATUS RedInodeDataRead( CINODE * pInode,
 
             ulRemaining = ulLen;
 
+            #if REDCONF_INODE_INLINE_DATA == 1
+                if( INODE_IS_INLINE( pInode->pInodeBuf ) )
+                {
+                    ret = InlineSpill( pInode );
+                }
+            #endif
+
             /*  If the write is beyond the current end of the file, and the current
              *  end of the file is not block-aligned, then there may be some data
              *  that needs to be zeroed in the last block.
              */
-            if( ullStart > pInode->pInodeBuf->ullSize )
+            if( ( ret == 0 ) && ( ullStart > pInode->pInodeBuf->ullSize ) )
             {
                 ret = ExpandPrepare( pInode );
             }
@@ -375,6 +592,195 @@ REDSTATUS RedInodeDataRead( CINODE * pInode,
     }
 
 
+/** @brief Allocate the file data blocks for a range of an inode.
+ *
+ *  Sparse blocks in the range are allocated, one contiguous extent of free
+ *  space at a time, and filled with zeroes; blocks which already exist are left
+ *  as they are.  If the range ends beyond the end of the inode, the inode size
+ *  is increased to the end of the range.
+ *
+ *  The newly allocated blocks are in the working state, so writes into them
+ *  before the next transaction point need no further allocation.
+ *
+ *  @param pInode   A pointer to the cached inode structure.
+ *  @param ullStart The file offset at which the range starts.
+ *  @param ullLen   The length of the range, in bytes.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EFBIG  The range extends beyond the maximum file size.
+ *  @retval -RED_EINVAL @p pInode is not a mounted cached inode pointer.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_ENOSPC There is insufficient free space to allocate the whole
+ *                      range.  The blocks which could be allocated are kept,
+ *                      and the inode size is increased to cover them.
+ */
+    REDSTATUS RedInodeDataAllocate( CINODE * pInode,
+                                    uint64_t ullStart,
+                                    uint64_t ullLen )
+    {
+        REDSTATUS ret = 0;
+
+        if( !CINODE_IS_DIRTY( pInode ) )
+        {
+            ret = -RED_EINVAL;
+        }
+        else if( ( ullStart > INODE_SIZE_MAX ) || ( ullLen > ( INODE_SIZE_MAX - ullStart ) ) )
+        {
+            ret = -RED_EFBIG;
+        }
+        else if( ullLen == 0U )
+        {
+            /*  Do nothing, just return success.
+             */
+        }
+
+        #if REDCONF_INODE_INLINE_DATA == 1
+            else if( INODE_IS_INLINE( pInode->pInodeBuf ) && ( ( ullStart + ullLen ) <= INODE_INLINE_MAX ) )
+            {
+                /*  The range fits inline, which needs no blocks.
+                 */
+                if( ( ullStart + ullLen ) > pInode->pInodeBuf->ullSize )
+                {
+                    pInode->pInodeBuf->ullSize = ullStart + ullLen;
+                }
+            }
+        #endif
+        else
+        {
+            bool fFull = false;
+            uint32_t ulBlockStart = ( uint32_t ) ( ullStart >> BLOCK_SIZE_P2 );
+            uint32_t ulBlockCount = ( uint32_t ) ( ( ( ullStart + ullLen ) + ( REDCONF_BLOCK_SIZE - 1U ) ) >> BLOCK_SIZE_P2 ) - ulBlockStart;
+            uint32_t ulBlockIndex;
+            uint32_t ulDataCost = 0U;
+
+            #if REDCONF_INODE_INLINE_DATA == 1
+                if( INODE_IS_INLINE( pInode->pInodeBuf ) )
+                {
+                    ret = InlineSpill( pInode );
+                }
+            #endif
+
+            /*  If the range ends beyond the current end of the file, and the
+             *  current end of the file is not block-aligned, then there may be
+             *  some data that needs to be zeroed in the last block.
+             */
+            if( ( ret == 0 ) && ( ( ullStart + ullLen ) > pInode->pInodeBuf->ullSize ) )
+            {
+                ret = ExpandPrepare( pInode );
+            }
+
+            /*  Branch the file metadata for all of the sparse blocks in advance,
+             *  and count them.  As in WriteAligned(), the file data blocks are
+             *  allocated afterward, so that they are contiguous.
+             */
+            for( ulBlockIndex = 0U; ( ret == 0 ) && ( ulBlockIndex < ulBlockCount ) && !fFull; ulBlockIndex++ )
+            {
+                ret = RedInodeDataSeek( pInode, ulBlockStart + ulBlockIndex );
+
+                if( ret == -RED_ENODATA )
+                {
+                    uint32_t ulCost;
+
+                    ret = BranchBlockCost( pInode, BRANCHDEPTH_FILE_DATA, &ulCost );
+
+                    if( ( ret == 0 ) && ( ( ulCost + ulDataCost ) > FreeBlockCount() ) )
+                    {
+                        fFull = true;
+                    }
+                    else if( ret == 0 )
+                    {
+                        ret = BranchBlock( pInode, BRANCHDEPTH_INDIR, false );
+
+                        if( ret == 0 )
+                        {
+                            ulDataCost++;
+                        }
+                    }
+                    else
+                    {
+                        /*  Unexpected error, return it.
+                         */
+                    }
+                }
+            }
+
+            if( fFull )
+            {
+                ulBlockCount = ulBlockIndex - 1U;
+            }
+
+            /*  Allocate the sparse file data blocks, one contiguous extent of
+             *  free space at a time.  The buffers for the new blocks are zeroed
+             *  and dirty, so the zeroes reach the disk when they are flushed.
+             */
+            for( ulBlockIndex = 0U; ( ret == 0 ) && ( ulBlockIndex < ulBlockCount ) && ( ulDataCost > 0U ); ulBlockIndex++ )
+            {
+                ret = RedInodeDataSeek( pInode, ulBlockStart + ulBlockIndex );
+
+                if( ret == -RED_ENODATA )
+                {
+                    ret = 0;
+
+                    if( gulDataExtentLeft == 0U )
+                    {
+                        ret = RedImapAllocExtent( ulDataCost, &gulDataExtentNext, &gulDataExtentLeft );
+                    }
+
+                    if( ret == 0 )
+                    {
+                        ret = BranchBlock( pInode, BRANCHDEPTH_FILE_DATA, true );
+                    }
+
+                    if( ret == 0 )
+                    {
+                        RedInodePutData( pInode );
+                        ulDataCost--;
+                    }
+                }
+            }
+
+            /*  Only possible after an error: see WriteAligned().
+             */
+            while( gulDataExtentLeft > 0U )
+            {
+                REDSTATUS ret2 = RedImapBlockSet( gulDataExtentNext, false );
+
+                CRITICAL_ASSERT( ret2 == 0 );
+
+                if( ret == 0 )
+                {
+                    ret = ret2;
+                }
+
+                gulDataExtentNext++;
+                gulDataExtentLeft--;
+            }
+
+            if( ret == 0 )
+            {
+                uint64_t ullEnd = ullStart + ullLen;
+
+                if( fFull )
+                {
+                    /*  Only the blocks before the one which did not fit were
+                     *  allocated.
+                     */
+                    ullEnd = ( ulBlockCount == 0U ) ? 0U : ( ( uint64_t ) ulBlockStart + ulBlockCount ) << BLOCK_SIZE_P2;
+                    ret = -RED_ENOSPC;
+                }
+
+                if( ullEnd > pInode->pInodeBuf->ullSize )
+                {
+                    pInode->pInodeBuf->ullSize = ullEnd;
+                }
+            }
+        }
+
+        return ret;
+    }
+
     #if DELETE_SUPPORTED || TRUNCATE_SUPPORTED
 
 /** @brief Change the size of an inode.
@@ -409,6 +815,50 @@ REDSTATUS RedInodeDataRead( CINODE * pInode,
             }
             else
             {
+                #if REDCONF_SNAPSHOTS > 0U
+                    gpRedCoreVol->fSnapHold = RedSnapInodeOpen( pInode->ulInode );
+                #endif
+
+                #if REDCONF_INODE_INLINE_DATA == 1
+                    if( INODE_IS_INLINE( pInode->pInodeBuf ) )
+                    {
+                        if( ullSize > INODE_INLINE_MAX )
+                        {
+                            /*  The spilled data block is already zeroed beyond
+                             *  the old end of file, so there is nothing for
+                             *  ExpandPrepare() to do.
+                             */
+                            ret = InlineSpill( pInode );
+                        }
+                        else if( ullSize < pInode->pInodeBuf->ullSize )
+                        {
+                            RedMemSet( &INLINE_DATA( pInode )[ ullSize ], 0U, ( uint32_t ) ( pInode->pInodeBuf->ullSize - ullSize ) );
+                        }
+                        else
+                        {
+                            /*  Expanding inline: the data beyond the old end of
+                             *  file is already zeroed.
+                             */
+                        }
+                    }
+                    else if( ( ullSize == 0U ) && RED_S_ISREG( pInode->pInodeBuf->uMode ) )
+                    {
+                        /*  Once the file has no data blocks, its data can go
+                         *  back inline.  Shrink() is called even if the size is
+                         *  already zero, to free any blocks left beyond the end
+                         *  of file by an operation which ran out of space.
+                         */
+                        ret = Shrink( pInode, 0U );
+
+                        if( ret == 0 )
+                        {
+                            RedInodePutCoord( pInode );
+                            pInode->fCoordInited = false;
+                            pInode->pInodeBuf->uMode = ( uint16_t ) ( pInode->pInodeBuf->uMode | INODE_MODE_INLINE );
+                        }
+                    }
+                    else
+                #endif /* REDCONF_INODE_INLINE_DATA == 1 */
                 if( ullSize > pInode->pInodeBuf->ullSize )
                 {
                     ret = ExpandPrepare( pInode );
@@ -427,6 +877,10 @@ REDSTATUS RedInodeDataRead( CINODE * pInode,
                 {
                     pInode->pInodeBuf->ullSize = ullSize;
                 }
+
+                #if REDCONF_SNAPSHOTS > 0U
+                    gpRedCoreVol->fSnapHold = false;
+                #endif
             }
 
             return ret;
@@ -874,6 +1328,124 @@ REDSTATUS RedInodeDataRead( CINODE * pInode,
 
         return ret;
     }
+
+
+    #if REDCONF_INODE_INLINE_DATA == 1
+
+/** @brief Move the inline data of an inode into a file data block.
+ *
+ *  Afterward, the inode uses block pointers like any other, with the data which
+ *  was inline (if any) in block zero.
+ *
+ *  @param pInode   A pointer to the cached inode structure.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_ENOSPC Insufficient free space for the data block.
+ *  @retval -RED_EINVAL Invalid parameters.
+ */
+        static REDSTATUS InlineSpill( CINODE * pInode )
+        {
+            REDSTATUS ret = 0;
+
+            if( !CINODE_IS_DIRTY( pInode ) || !INODE_IS_INLINE( pInode->pInodeBuf ) )
+            {
+                REDERROR();
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                uint32_t ulSize = ( uint32_t ) pInode->pInodeBuf->ullSize;
+
+                REDASSERT( ulSize <= INODE_INLINE_MAX );
+                REDASSERT( gulDataExtentLeft == 0U );
+
+                RedInodePutCoord( pInode );
+                pInode->fCoordInited = false;
+
+                /*  The data is copied into the buffer for a new block before the
+                 *  inline data is overwritten with block pointers.
+                 */
+                if( ulSize > 0U )
+                {
+                    /*  Block zero needs an indirect if there are no direct
+                     *  pointers, and a double indirect as well if there are no
+                     *  indirect pointers.
+                     */
+                    #if REDCONF_DIRECT_POINTERS > 0U
+                        uint32_t ulCost = 1U;
+                    #elif REDCONF_INDIRECT_POINTERS > 0U
+                        uint32_t ulCost = 2U;
+                    #else
+                        uint32_t ulCost = 3U;
+                    #endif
+                    uint32_t ulBlock = BLOCK_SPARSE;
+                    uint8_t * pbData = NULL;
+
+                    if( ulCost > FreeBlockCount() )
+                    {
+                        ret = -RED_ENOSPC;
+                    }
+                    else
+                    {
+                        ret = RedImapAllocBlock( &ulBlock );
+                    }
+
+                    if( ret == 0 )
+                    {
+                        ret = RedBufferGet( ulBlock, ( uint16_t ) ( BFLAG_NEW | BFLAG_DIRTY ), CAST_VOID_PTR_PTR( &pbData ) );
+
+                        if( ret == 0 )
+                        {
+                            RedMemCpy( pbData, INLINE_DATA( pInode ), ulSize );
+                            RedBufferPut( pbData );
+
+                            /*  Hand the block to BranchBlock() as a one-block
+                             *  extent, as WriteAligned() does, so that it is
+                             *  linked in like any other file data block.
+                             */
+                            gulDataExtentNext = ulBlock;
+                            gulDataExtentLeft = 1U;
+                        }
+                        else
+                        {
+                            REDSTATUS ret2 = RedImapBlockSet( ulBlock, false );
+
+                            CRITICAL_ASSERT( ret2 == 0 );
+                        }
+                    }
+                }
+
+                if( ret == 0 )
+                {
+                    RedMemSet( pInode->pInodeBuf->aulEntries, 0U, sizeof( pInode->pInodeBuf->aulEntries ) );
+                    pInode->pInodeBuf->uMode = ( uint16_t ) ( pInode->pInodeBuf->uMode & ~INODE_MODE_INLINE );
+
+                    if( gulDataExtentLeft > 0U )
+                    {
+                        ret = RedInodeDataSeek( pInode, 0U );
+
+                        if( ret == -RED_ENODATA )
+                        {
+                            ret = BranchBlock( pInode, BRANCHDEPTH_FILE_DATA, false );
+                        }
+                        else
+                        {
+                            REDERROR();
+                            ret = -RED_EFUBAR;
+                        }
+
+                        CRITICAL_ASSERT( ret == 0 );
+                        REDASSERT( gulDataExtentLeft == 0U );
+                    }
+                }
+            }
+
+            return ret;
+        }
+    #endif /* REDCONF_INODE_INLINE_DATA == 1 */
 #endif /* REDCONF_READ_ONLY == 0 */
 
 
@@ -999,6 +1571,28 @@ REDSTATUS RedInodeDataSeek( CINODE * pInode,
 }
 
 
+#if REDCONF_READ_AHEAD_BLOCKS > 0U
+
+/** @brief Stop tracking the sequential readers of the current volume.
+ *
+ *  Called wherever the buffers of the volume are discarded, since the inodes
+ *  and blocks which the readers were tracked by no longer mean the same thing.
+ */
+    void RedInodeReadAheadDiscard( void )
+    {
+        uint8_t bStream;
+
+        for( bStream = 0U; bStream < READAHEAD_STREAMS; bStream++ )
+        {
+            if( gaReadAhead[ bStream ].bVolNum == gbRedVolNum )
+            {
+                gaReadAhead[ bStream ].ulInode = INODE_INVALID;
+            }
+        }
+    }
+#endif /* REDCONF_READ_AHEAD_BLOCKS > 0U */
+
+
 /** @brief Seek to the coordinates.
  *
  *  Compute the new coordinates, and put any buffers which are not needed or are
@@ -1190,6 +1784,10 @@ static REDSTATUS ReadUnaligned( CINODE * pInode,
         if( ret == 0 )
         {
             RedMemCpy( pbBuffer, &pInode->pbData[ ullStart & ( REDCONF_BLOCK_SIZE - 1U ) ], ulLen );
+
+            #if REDCONF_READ_AHEAD_BLOCKS > 0U
+                ReadAhead( pInode, ( uint32_t ) ( ullStart >> BLOCK_SIZE_P2 ) );
+            #endif
         }
         else if( ret == -RED_ENODATA )
         {
@@ -1259,7 +1857,11 @@ static REDSTATUS ReadAligned( CINODE * pInode,
                     if( ret == 0 )
                 #endif
                 {
-                    ret = RedIoRead( gbRedVolNum, ulExtentStart, ulExtentLen, &pbBuffer[ ulBlockIndex << BLOCK_SIZE_P2 ] );
+                    #if REDCONF_FINE_LOCKING == 1
+                        ret = RedBufferReadDirect( ulExtentStart, ulExtentLen, &pbBuffer[ ulBlockIndex << BLOCK_SIZE_P2 ] );
+                    #else
+                        ret = RedIoRead( gbRedVolNum, ulExtentStart, ulExtentLen, &pbBuffer[ ulBlockIndex << BLOCK_SIZE_P2 ] );
+                    #endif
 
                     if( ret == 0 )
                     {
@@ -1287,6 +1889,109 @@ static REDSTATUS ReadAligned( CINODE * pInode,
 }
 
 
+#if REDCONF_READ_AHEAD_BLOCKS > 0U
+
+/** @brief Detect a sequential reader and read ahead on its behalf.
+ *
+ *  Called after a file data block has been read through the buffers.  When
+ *  the reader has read successive blocks of the file and has reached the end
+ *  of the blocks which were previously read ahead, the next physically
+ *  contiguous extent of the file, up to REDCONF_READ_AHEAD_BLOCKS long, is
+ *  read into the buffers.
+ *
+ *  Reading ahead is only a hint, so errors are ignored: the read which called
+ *  this has already succeeded.  Blocks which could not be read ahead are read,
+ *  and any error reported, if and when the reader reaches them.
+ *
+ *  @param pInode   A pointer to the cached inode structure.  Its seek
+ *                  coordinates may be changed.
+ *  @param ulBlock  The file block offset which was read.
+ */
+    static void ReadAhead( CINODE * pInode,
+                           uint32_t ulBlock )
+    {
+        READAHEAD * pStream = NULL;
+        uint8_t bStream;
+
+        for( bStream = 0U; bStream < READAHEAD_STREAMS; bStream++ )
+        {
+            if( ( gaReadAhead[ bStream ].ulInode == pInode->ulInode ) && ( gaReadAhead[ bStream ].bVolNum == gbRedVolNum ) )
+            {
+                pStream = &gaReadAhead[ bStream ];
+                break;
+            }
+        }
+
+        if( pStream == NULL )
+        {
+            /*  Start tracking the reader, replacing the reader which has been
+             *  tracked the longest.
+             */
+            pStream = &gaReadAhead[ gbReadAheadNext ];
+            gbReadAheadNext = ( uint8_t ) ( ( gbReadAheadNext + 1U ) % READAHEAD_STREAMS );
+
+            pStream->ulInode = pInode->ulInode;
+            pStream->bVolNum = gbRedVolNum;
+            pStream->ulNextBlock = ulBlock + 1U;
+            pStream->ulWindowEnd = ulBlock + 1U;
+        }
+        else if( ( ulBlock + 1U ) == pStream->ulNextBlock )
+        {
+            /*  Another read within the same block: nothing to do.
+             */
+        }
+        else if( ulBlock == pStream->ulNextBlock )
+        {
+            pStream->ulNextBlock = ulBlock + 1U;
+
+            if( pStream->ulNextBlock >= pStream->ulWindowEnd )
+            {
+                uint32_t ulFileBlocks = ( uint32_t ) ( ( pInode->pInodeBuf->ullSize + ( REDCONF_BLOCK_SIZE - 1U ) ) >> BLOCK_SIZE_P2 );
+
+                if( pStream->ulNextBlock < ulFileBlocks )
+                {
+                    uint32_t ulExtentStart;
+                    uint32_t ulExtentLen = REDMIN( ulFileBlocks - pStream->ulNextBlock, REDCONF_READ_AHEAD_BLOCKS );
+                    REDSTATUS ret;
+
+                    ret = GetExtent( pInode, pStream->ulNextBlock, &ulExtentStart, &ulExtentLen );
+
+                    if( ret == 0 )
+                    {
+                        ret = RedBufferReadAhead( ulExtentStart, ulExtentLen );
+                    }
+                    else if( ret == -RED_ENODATA )
+                    {
+                        /*  Sparse blocks are not read from disk.
+                         */
+                        ulExtentLen = 1U;
+                        ret = 0;
+                    }
+                    else
+                    {
+                        /*  Leave the window where it is: reading ahead is
+                         *  tried again after the next sequential read.
+                         */
+                    }
+
+                    if( ret == 0 )
+                    {
+                        pStream->ulWindowEnd = pStream->ulNextBlock + ulExtentLen;
+                    }
+                }
+            }
+        }
+        else
+        {
+            /*  Not sequential, so restart the detection.
+             */
+            pStream->ulNextBlock = ulBlock + 1U;
+            pStream->ulWindowEnd = ulBlock + 1U;
+        }
+    }
+#endif /* REDCONF_READ_AHEAD_BLOCKS > 0U */
+
+
 #if REDCONF_READ_ONLY == 0
 
 /** @brief Write an unaligned portion of a block.
@@ -1372,8 +2077,12 @@ static REDSTATUS ReadAligned( CINODE * pInode,
             bool fFull = false;
             uint32_t ulBlockCount = *pulBlockCount;
             uint32_t ulBlockIndex;
+            uint32_t ulDataCost = 0U;
 
-            /*  Branch all of the file data blocks in advance.
+            /*  Branch the file metadata for all of the blocks in advance, and
+             *  count the file data blocks which need to be allocated.  The file
+             *  data blocks are allocated afterward, so that they are contiguous
+             *  rather than interleaved with newly allocated indirect nodes.
              */
             for( ulBlockIndex = 0U; ( ulBlockIndex < ulBlockCount ) && !fFull; ulBlockIndex++ )
             {
@@ -1381,16 +2090,33 @@ static REDSTATUS ReadAligned( CINODE * pInode,
 
                 if( ( ret == 0 ) || ( ret == -RED_ENODATA ) )
                 {
-                    ret = BranchBlock( pInode, BRANCHDEPTH_FILE_DATA, false );
+                    uint32_t ulCost;
+
+                    ret = BranchBlockCost( pInode, BRANCHDEPTH_FILE_DATA, &ulCost );
 
-                    if( ret == -RED_ENOSPC )
+                    if( ( ret == 0 ) && ( ( ulCost + ulDataCost ) > FreeBlockCount() ) )
+                    {
+                        ret = ( ulBlockIndex > 0U ) ? 0 : -RED_ENOSPC;
+                        fFull = true;
+                    }
+                    else if( ( ret == 0 ) && ( ulCost > 0U ) )
                     {
-                        if( ulBlockIndex > 0U )
+                        ret = BranchBlock( pInode, BRANCHDEPTH_INDIR, false );
+
+                        if( ret == 0 )
                         {
-                            ret = 0;
+                            ret = BranchBlockCost( pInode, BRANCHDEPTH_FILE_DATA, &ulCost );
                         }
 
-                        fFull = true;
+                        if( ret == 0 )
+                        {
+                            ulDataCost += ulCost;
+                        }
+                    }
+                    else
+                    {
+                        /*  Either an error, or the block is already branched.
+                         */
                     }
                 }
 
@@ -1401,13 +2127,68 @@ static REDSTATUS ReadAligned( CINODE * pInode,
             }
 
             ulBlockCount = ulBlockIndex;
-            ulBlockIndex = 0U;
 
             if( fFull )
             {
                 ulBlockCount--;
             }
 
+            /*  Allocate the file data blocks, one contiguous extent of free
+             *  space at a time.
+             */
+            for( ulBlockIndex = 0U; ( ret == 0 ) && ( ulBlockIndex < ulBlockCount ) && ( ulDataCost > 0U ); ulBlockIndex++ )
+            {
+                ret = RedInodeDataSeek( pInode, ulBlockStart + ulBlockIndex );
+
+                if( ( ret == 0 ) || ( ret == -RED_ENODATA ) )
+                {
+                    uint32_t ulCost;
+
+                    ret = BranchBlockCost( pInode, BRANCHDEPTH_FILE_DATA, &ulCost );
+
+                    if( ( ret == 0 ) && ( ulCost > 0U ) )
+                    {
+                        REDASSERT( ulCost == 1U );
+
+                        if( gulDataExtentLeft == 0U )
+                        {
+                            ret = RedImapAllocExtent( ulDataCost, &gulDataExtentNext, &gulDataExtentLeft );
+                        }
+
+                        if( ret == 0 )
+                        {
+                            ret = BranchBlock( pInode, BRANCHDEPTH_FILE_DATA, false );
+                        }
+
+                        if( ret == 0 )
+                        {
+                            ulDataCost--;
+                        }
+                    }
+                }
+            }
+
+            /*  The extent is sized to fit the blocks which need to be allocated,
+             *  so any blocks left over (only possible after an error) are no
+             *  longer needed.
+             */
+            while( gulDataExtentLeft > 0U )
+            {
+                REDSTATUS ret2 = RedImapBlockSet( gulDataExtentNext, false );
+
+                CRITICAL_ASSERT( ret2 == 0 );
+
+                if( ret == 0 )
+                {
+                    ret = ret2;
+                }
+
+                gulDataExtentNext++;
+                gulDataExtentLeft--;
+            }
+
+            ulBlockIndex = 0U;
+
             /*  Write the data to disk one contiguous extent at a time.
              */
             while( ( ret == 0 ) && ( ulBlockIndex < ulBlockCount ) )
@@ -1539,6 +2320,20 @@ static REDSTATUS GetExtent( CINODE * pInode,
         REDSTATUS ret;
         uint32_t ulCost = 0U; /* Init'd to quiet warnings. */
 
+        #if REDCONF_SNAPSHOTS > 0U
+            bool fSetHold = false;
+
+            /*  Blocks which are branched away from must stay put while a
+             *  snapshot of the file might still read them.  A caller which
+             *  frees blocks itself (truncate) may already hold them.
+             */
+            if( !gpRedCoreVol->fSnapHold && RedSnapInodeOpen( pInode->ulInode ) )
+            {
+                gpRedCoreVol->fSnapHold = true;
+                fSetHold = true;
+            }
+        #endif
+
         ret = BranchBlockCost( pInode, depth, &ulCost );
 
         if( ( ret == 0 ) && ( ulCost > FreeBlockCount() ) )
@@ -1637,6 +2432,13 @@ static REDSTATUS GetExtent( CINODE * pInode,
             CRITICAL_ASSERT( ret == 0 );
         }
 
+        #if REDCONF_SNAPSHOTS > 0U
+            if( fSetHold )
+            {
+                gpRedCoreVol->fSnapHold = false;
+            }
+        #endif
+
         return ret;
     }
 
@@ -1711,9 +2513,19 @@ static REDSTATUS GetExtent( CINODE * pInode,
                 else
                 {
                     /*  Block does not exist or is committed state, so allocate a
-                     *  new block for the branch.
+                     *  new block for the branch.  File data blocks come from the
+                     *  extent allocated by WriteAligned(), if there is one.
                      */
-                    ret = RedImapAllocBlock( pulBlock );
+                    if( ( uBFlag == 0U ) && ( gulDataExtentLeft > 0U ) )
+                    {
+                        *pulBlock = gulDataExtentNext;
+                        gulDataExtentNext++;
+                        gulDataExtentLeft--;
+                    }
+                    else
+                    {
+                        ret = RedImapAllocBlock( pulBlock );
+                    }
 
                     if( ret == 0 )
                     {
@@ -1915,7 +2727,10 @@ static REDSTATUS GetExtent( CINODE * pInode,
  */
     static uint32_t FreeBlockCount( void )
     {
-        uint32_t ulFreeBlocks = gpRedMR->ulFreeBlocks;
+        /*  Blocks in the file data extent are already allocated, but are
+         *  available for file data.
+         */
+        uint32_t ulFreeBlocks = RedImapFreeCount() + gulDataExtentLeft;
 
         #if RESERVED_BLOCKS > 0U
             if( !gpRedCoreVol->fUseReservedBlocks )
@@ -0,0 +1,715 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Implements read-only snapshots of files.
+ *
+ *  A snapshot keeps a copy of the committed inode of a file.  The committed
+ *  state is never overwritten, so the blocks which the inode points at can be
+ *  read straight from the block device, without the buffer cache and without
+ *  the FS mutex, as long as none of them is reallocated.  Blocks which are
+ *  freed from the committed state of a file while a snapshot of it is open are
+ *  held by the imap until every snapshot of the volume is closed; if they
+ *  cannot all be held, the snapshots are made stale.
+ *
+ *  Opening and closing a snapshot, and making it stale, are done with the FS
+ *  mutex held.  Reading a snapshot is not, so a snapshot must only be read by
+ *  one task at a time.
+ */
+#include <redfs.h>
+
+#if REDCONF_SNAPSHOTS > 0U
+
+    #include <redcoreapi.h>
+    #include <redcore.h>
+
+
+/** @brief An open snapshot.
+ */
+    typedef struct
+    {
+        uint32_t ulInode;        /**< Inode number; INODE_INVALID if the snapshot is not open. */
+        uint8_t bVolNum;         /**< Volume containing the inode. */
+        volatile bool fStale;    /**< Whether blocks of the snapshot may have been reallocated. */
+        bool fDeleted;           /**< Whether the inode was deleted; its number may have been reused. */
+        #if REDCONF_INODE_INLINE_DATA == 1
+            bool fInline;        /**< Whether the file data is stored in aulEntries. */
+        #endif
+        uint64_t ullSequence;    /**< Sequence number of the committed metaroot. */
+        uint64_t ullSize;        /**< Size of the file, in bytes. */
+        uint32_t aulEntries[ INODE_ENTRIES ]; /**< Block pointers (or data) copied from the inode. */
+        uint32_t ulNodeBlock;    /**< Block number of the indirect node in n.ab; BLOCK_SPARSE if none. */
+        uint32_t ulDataBlock;    /**< Block number of the data in d.ab; BLOCK_SPARSE if none. */
+        #if DINDIR_POINTERS > 0U
+            uint32_t ulDindirBlock; /**< Block number of the double indirect node in d.ab; BLOCK_SPARSE if none. */
+        #endif
+
+        /** The last indirect node read, so that each indirect node is read
+         *  once when the file is read sequentially.
+         */
+        ALIGNED_BYTE_ARRAY( n, ab, REDCONF_BLOCK_SIZE );
+
+        /** The last data block read for a partial block read, or the last
+         *  double indirect node read, whichever was read most recently.
+         */
+        ALIGNED_BYTE_ARRAY( d, ab, REDCONF_BLOCK_SIZE );
+    } SNAPSHOT;
+
+
+    static REDSTATUS SnapBlockLookup( SNAPSHOT * pSnap,
+                                      uint32_t ulBlockOffset,
+                                      uint32_t * pulBlock );
+    #if REDCONF_DIRECT_POINTERS < INODE_ENTRIES
+        static REDSTATUS SnapNodeRead( const SNAPSHOT * pSnap,
+                                       uint32_t ulBlock,
+                                       uint32_t ulSignature,
+                                       uint8_t * pbNode );
+        static uint32_t SnapNodeEntry( const uint8_t * pbNode,
+                                       uint32_t ulEntry );
+    #endif
+
+
+    static SNAPSHOT gaSnap[ REDCONF_SNAPSHOTS ];
+
+
+/** @brief Open a snapshot of a file.
+ *
+ *  If the file has been modified since the last transaction point, a
+ *  transaction point is committed first, so that the committed state includes
+ *  the modifications.
+ *
+ *  @param ulInode      The inode number of the file.
+ *  @param pulSnap      On successful return, populated with the snapshot
+ *                      number.
+ *  @param pullSequence On successful return, if non-NULL, populated with the
+ *                      sequence number of the committed metaroot which the
+ *                      snapshot was taken from.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0               Operation was successful.
+ *  @retval -RED_EBADF      @p ulInode is not a valid inode number.
+ *  @retval -RED_EINVAL     The volume is not mounted; or @p pulSnap is `NULL`.
+ *  @retval -RED_EIO        A disk I/O error occurred.
+ *  @retval -RED_EISDIR     The inode is a directory.
+ *  @retval -RED_EMFILE     #REDCONF_SNAPSHOTS snapshots are already open.
+ */
+    REDSTATUS RedCoreSnapOpen( uint32_t ulInode,
+                               uint32_t * pulSnap,
+                               uint64_t * pullSequence )
+    {
+        REDSTATUS ret = 0;
+        uint32_t ulSnap = 0U;
+
+        if( !gpRedVolume->fMounted || ( pulSnap == NULL ) )
+        {
+            ret = -RED_EINVAL;
+        }
+        else
+        {
+            while( ( ulSnap < REDCONF_SNAPSHOTS ) && ( gaSnap[ ulSnap ].ulInode != INODE_INVALID ) )
+            {
+                ulSnap++;
+            }
+
+            if( ulSnap == REDCONF_SNAPSHOTS )
+            {
+                ret = -RED_EMFILE;
+            }
+        }
+
+        if( ret == 0 )
+        {
+            CINODE ino;
+
+            ino.ulInode = ulInode;
+            ret = RedInodeMount( &ino, FTYPE_FILE, false );
+
+            /*  An unbranched inode, and everything it points at, is part of the
+             *  committed state.  Otherwise, commit the working state.
+             */
+            if( ( ret == 0 ) && ino.fBranched )
+            {
+                RedInodePut( &ino, 0U );
+
+                ret = RedVolTransact();
+
+                if( ret == 0 )
+                {
+                    ret = RedInodeMount( &ino, FTYPE_FILE, false );
+                }
+            }
+
+            if( ret == 0 )
+            {
+                SNAPSHOT * pSnap = &gaSnap[ ulSnap ];
+
+                REDASSERT( !ino.fBranched );
+
+                pSnap->ulInode = ulInode;
+                pSnap->bVolNum = gbRedVolNum;
+                pSnap->fStale = false;
+                pSnap->fDeleted = false;
+                #if REDCONF_INODE_INLINE_DATA == 1
+                    pSnap->fInline = INODE_IS_INLINE( ino.pInodeBuf );
+                #endif
+                pSnap->ullSequence = gpRedCoreVol->aMR[ 1U - gpRedCoreVol->bCurMR ].hdr.ullSequence;
+                pSnap->ullSize = ino.pInodeBuf->ullSize;
+                RedMemCpy( pSnap->aulEntries, ino.pInodeBuf->aulEntries, sizeof( pSnap->aulEntries ) );
+                pSnap->ulNodeBlock = BLOCK_SPARSE;
+                pSnap->ulDataBlock = BLOCK_SPARSE;
+                #if DINDIR_POINTERS > 0U
+                    pSnap->ulDindirBlock = BLOCK_SPARSE;
+                #endif
+
+                gpRedCoreVol->bSnapCount++;
+
+                RedInodePut( &ino, 0U );
+
+                *pulSnap = ulSnap;
+
+                if( pullSequence != NULL )
+                {
+                    *pullSequence = pSnap->ullSequence;
+                }
+            }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Read from a snapshot.
+ *
+ *  Called without the FS mutex: this reads only the snapshot and the block
+ *  device, never the state of the volume.
+ *
+ *  @param ulSnap   The snapshot number.
+ *  @param ullStart The file offset to read from.
+ *  @param pulLen   On entry, the number of bytes to read.  On successful
+ *                  return, the number of bytes read, which is less only at the
+ *                  end-of-file.
+ *  @param pBuffer  The buffer to read into.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0               Operation was successful.
+ *  @retval -RED_EBADF      @p ulSnap is not an open snapshot.
+ *  @retval -RED_EINVAL     @p pulLen or @p pBuffer is `NULL`.
+ *  @retval -RED_EIO        A disk I/O error occurred.
+ *  @retval -RED_ESTALE     Blocks of the snapshot may have been reallocated.
+ */
+    REDSTATUS RedCoreSnapRead( uint32_t ulSnap,
+                               uint64_t ullStart,
+                               uint32_t * pulLen,
+                               void * pBuffer )
+    {
+        REDSTATUS ret = 0;
+
+        if( ( pulLen == NULL ) || ( pBuffer == NULL ) )
+        {
+            ret = -RED_EINVAL;
+        }
+        else if( ( ulSnap >= REDCONF_SNAPSHOTS ) || ( gaSnap[ ulSnap ].ulInode == INODE_INVALID ) )
+        {
+            ret = -RED_EBADF;
+        }
+        else if( gaSnap[ ulSnap ].fStale )
+        {
+            ret = -RED_ESTALE;
+        }
+        else
+        {
+            SNAPSHOT * pSnap = &gaSnap[ ulSnap ];
+            uint8_t * pbBuffer = CAST_VOID_PTR_TO_UINT8_PTR( pBuffer );
+            uint32_t ulLen = 0U;
+            uint32_t ulDone = 0U;
+
+            if( ullStart < pSnap->ullSize )
+            {
+                ulLen = ( uint32_t ) REDMIN( pSnap->ullSize - ullStart, ( uint64_t ) *pulLen );
+            }
+
+            #if REDCONF_INODE_INLINE_DATA == 1
+                if( pSnap->fInline )
+                {
+                    const uint8_t * pbInline = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pSnap->aulEntries );
+
+                    /*  The size of an inline file never exceeds the inline
+                     *  capacity, but the copy must stay within aulEntries even
+                     *  if the inode was bad.
+                     */
+                    REDASSERT( pSnap->ullSize <= INODE_INLINE_MAX );
+
+                    if( ullStart >= INODE_INLINE_MAX )
+                    {
+                        ulLen = 0U;
+                    }
+                    else
+                    {
+                        ulLen = REDMIN( ulLen, INODE_INLINE_MAX - ( uint32_t ) ullStart );
+                        RedMemCpy( pbBuffer, &pbInline[ ( uint32_t ) ullStart ], ulLen );
+                    }
+
+                    ulDone = ulLen;
+                }
+            #endif
+
+            while( ( ret == 0 ) && ( ulDone < ulLen ) )
+            {
+                uint64_t ullPos = ullStart + ulDone;
+                uint32_t ulBlockOffset = ( uint32_t ) ( ullPos >> BLOCK_SIZE_P2 );
+                uint32_t ulOffsetInBlock = ( uint32_t ) ullPos & ( REDCONF_BLOCK_SIZE - 1U );
+                uint32_t ulThisLen = REDMIN( REDCONF_BLOCK_SIZE - ulOffsetInBlock, ulLen - ulDone );
+                uint32_t ulBlock;
+
+                ret = SnapBlockLookup( pSnap, ulBlockOffset, &ulBlock );
+
+                if( ret == 0 )
+                {
+                    if( ulBlock == BLOCK_SPARSE )
+                    {
+                        RedMemSet( &pbBuffer[ ulDone ], 0U, ulThisLen );
+                    }
+                    else if( ulThisLen == REDCONF_BLOCK_SIZE )
+                    {
+                        uint32_t ulRun = 1U;
+
+                        /*  Read whole blocks straight into the caller's buffer,
+                         *  as many as are contiguous on disk at once.
+                         */
+                        while( ( ret == 0 ) && ( ( ulLen - ulDone ) >= ( ( ulRun + 1U ) * REDCONF_BLOCK_SIZE ) ) )
+                        {
+                            uint32_t ulNext;
+
+                            ret = SnapBlockLookup( pSnap, ulBlockOffset + ulRun, &ulNext );
+
+                            if( ( ret == 0 ) && ( ulNext == ( ulBlock + ulRun ) ) )
+                            {
+                                ulRun++;
+                            }
+                            else
+                            {
+                                break;
+                            }
+                        }
+
+                        if( ret == 0 )
+                        {
+                            ret = RedIoRead( pSnap->bVolNum, ulBlock, ulRun, &pbBuffer[ ulDone ] );
+                            ulThisLen = ulRun << BLOCK_SIZE_P2;
+                        }
+                    }
+                    else
+                    {
+                        if( pSnap->ulDataBlock != ulBlock )
+                        {
+                            pSnap->ulDataBlock = BLOCK_SPARSE;
+                            #if DINDIR_POINTERS > 0U
+                                pSnap->ulDindirBlock = BLOCK_SPARSE;
+                            #endif
+
+                            ret = RedIoRead( pSnap->bVolNum, ulBlock, 1U, pSnap->d.ab );
+
+                            if( ret == 0 )
+                            {
+                                pSnap->ulDataBlock = ulBlock;
+                            }
+                        }
+
+                        if( ret == 0 )
+                        {
+                            RedMemCpy( &pbBuffer[ ulDone ], &pSnap->d.ab[ ulOffsetInBlock ], ulThisLen );
+                        }
+                    }
+                }
+
+                if( ret == 0 )
+                {
+                    ulDone += ulThisLen;
+                }
+            }
+
+            /*  The blocks were read without the FS mutex.  If the snapshot was
+             *  made stale in the meantime, they might have been reallocated
+             *  and overwritten before they were read.
+             */
+            if( pSnap->fStale )
+            {
+                ret = -RED_ESTALE;
+            }
+
+            if( ret == 0 )
+            {
+                *pulLen = ulLen;
+            }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Close a snapshot.
+ *
+ *  Once no snapshot of the volume is open, the blocks held for them are
+ *  released.
+ *
+ *  @param ulSnap   The snapshot number.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBADF  @p ulSnap is not an open snapshot.
+ */
+    REDSTATUS RedCoreSnapClose( uint32_t ulSnap )
+    {
+        REDSTATUS ret;
+
+        if( ( ulSnap >= REDCONF_SNAPSHOTS ) || ( gaSnap[ ulSnap ].ulInode == INODE_INVALID ) )
+        {
+            ret = -RED_EBADF;
+        }
+        else
+        {
+            SNAPSHOT * pSnap = &gaSnap[ ulSnap ];
+
+            ret = RedCoreVolSetCurrent( pSnap->bVolNum );
+
+            if( ret == 0 )
+            {
+                /*  Stale snapshots were already dropped from the count.
+                 */
+                if( !pSnap->fStale )
+                {
+                    REDASSERT( gpRedCoreVol->bSnapCount > 0U );
+                    gpRedCoreVol->bSnapCount--;
+
+                    if( gpRedCoreVol->bSnapCount == 0U )
+                    {
+                        RedImapHoldRelease();
+                    }
+                }
+
+                pSnap->ulInode = INODE_INVALID;
+            }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Make the open snapshots of the current volume stale.
+ *
+ *  Called when a block freed from the committed state cannot be held.  Reads
+ *  from a stale snapshot fail, so nothing needs to be held for it any longer.
+ */
+    void RedSnapStale( void )
+    {
+        uint32_t ulSnap;
+
+        for( ulSnap = 0U; ulSnap < REDCONF_SNAPSHOTS; ulSnap++ )
+        {
+            if( ( gaSnap[ ulSnap ].ulInode != INODE_INVALID ) && ( gaSnap[ ulSnap ].bVolNum == gbRedVolNum ) )
+            {
+                gaSnap[ ulSnap ].fStale = true;
+            }
+        }
+
+        gpRedCoreVol->bSnapCount = 0U;
+        gpRedCoreVol->fSnapHold = false;
+        RedImapHoldRelease();
+    }
+
+
+/** @brief Determine whether a snapshot of an inode on the current volume is
+ *         open.
+ *
+ *  Blocks freed from the committed state of such an inode must be held until
+ *  the snapshot is closed.
+ *
+ *  @param ulInode  The inode number.
+ *
+ *  @return Whether a snapshot of @p ulInode is open and not stale.
+ */
+    bool RedSnapInodeOpen( uint32_t ulInode )
+    {
+        bool fOpen = false;
+        uint32_t ulSnap;
+
+        for( ulSnap = 0U; ulSnap < REDCONF_SNAPSHOTS; ulSnap++ )
+        {
+            if( ( gaSnap[ ulSnap ].ulInode == ulInode ) && ( gaSnap[ ulSnap ].bVolNum == gbRedVolNum ) &&
+                !gaSnap[ ulSnap ].fStale && !gaSnap[ ulSnap ].fDeleted )
+            {
+                fOpen = true;
+                break;
+            }
+        }
+
+        return fOpen;
+    }
+
+
+/** @brief Note that an inode on the current volume is being deleted.
+ *
+ *  Called once all of its blocks have been freed, and held if need be, so
+ *  that a file which later reuses the inode number does not have its freed
+ *  blocks held for the snapshots of the deleted file.
+ *
+ *  @param ulInode  The inode number.
+ */
+    void RedSnapInodeDeleted( uint32_t ulInode )
+    {
+        uint32_t ulSnap;
+
+        for( ulSnap = 0U; ulSnap < REDCONF_SNAPSHOTS; ulSnap++ )
+        {
+            if( ( gaSnap[ ulSnap ].ulInode == ulInode ) && ( gaSnap[ ulSnap ].bVolNum == gbRedVolNum ) )
+            {
+                gaSnap[ ulSnap ].fDeleted = true;
+            }
+        }
+    }
+
+
+/** @brief Determine whether any snapshot of the current volume is open.
+ *
+ *  @return Whether a snapshot of the current volume is open, stale or not.
+ */
+    bool RedSnapInUse( void )
+    {
+        bool fInUse = false;
+        uint32_t ulSnap;
+
+        for( ulSnap = 0U; ulSnap < REDCONF_SNAPSHOTS; ulSnap++ )
+        {
+            if( ( gaSnap[ ulSnap ].ulInode != INODE_INVALID ) && ( gaSnap[ ulSnap ].bVolNum == gbRedVolNum ) )
+            {
+                fInUse = true;
+                break;
+            }
+        }
+
+        return fInUse;
+    }
+
+
+/** @brief Find the block which holds a given block of a snapshot's data.
+ *
+ *  @param pSnap            The snapshot.
+ *  @param ulBlockOffset    The block offset within the file; must be within
+ *                          the file size.
+ *  @param pulBlock         On successful return, populated with the block
+ *                          number; or BLOCK_SPARSE, if the block is sparse.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred, or an indirect node is
+ *                      invalid.
+ */
+    static REDSTATUS SnapBlockLookup( SNAPSHOT * pSnap,
+                                      uint32_t ulBlockOffset,
+                                      uint32_t * pulBlock )
+    {
+        REDSTATUS ret = 0;
+
+        #if REDCONF_DIRECT_POINTERS > 0U
+            if( ulBlockOffset < REDCONF_DIRECT_POINTERS )
+            {
+                *pulBlock = pSnap->aulEntries[ ulBlockOffset ];
+            }
+            else
+        #endif
+        {
+            #if REDCONF_DIRECT_POINTERS < INODE_ENTRIES
+                uint32_t ulOffset = ulBlockOffset - REDCONF_DIRECT_POINTERS;
+                uint32_t ulIndirBlock;
+
+                #if REDCONF_INDIRECT_POINTERS > 0U
+                    if( ulOffset < INODE_INDIR_BLOCKS )
+                    {
+                        ulIndirBlock = pSnap->aulEntries[ REDCONF_DIRECT_POINTERS + ( ulOffset / INDIR_ENTRIES ) ];
+                    }
+                    else
+                #endif
+                {
+                    #if DINDIR_POINTERS > 0U
+                        uint32_t ulDindirBlock;
+
+                        ulOffset -= INODE_INDIR_BLOCKS;
+                        ulDindirBlock = pSnap->aulEntries[ REDCONF_DIRECT_POINTERS + REDCONF_INDIRECT_POINTERS + ( ulOffset / DINDIR_DATA_BLOCKS ) ];
+                        ulIndirBlock = BLOCK_SPARSE;
+
+                        if( ( ulDindirBlock != BLOCK_SPARSE ) && ( ulDindirBlock != pSnap->ulDindirBlock ) )
+                        {
+                            /*  Double indirect nodes share the data block
+                             *  buffer, rather than having one of their own, so
+                             *  a partial block read in between means the node
+                             *  is read again.
+                             */
+                            pSnap->ulDataBlock = BLOCK_SPARSE;
+                            pSnap->ulDindirBlock = BLOCK_SPARSE;
+
+                            ret = SnapNodeRead( pSnap, ulDindirBlock, META_SIG_DINDIR, pSnap->d.ab );
+
+                            if( ret == 0 )
+                            {
+                                pSnap->ulDindirBlock = ulDindirBlock;
+                            }
+                        }
+
+                        if( ( ret == 0 ) && ( ulDindirBlock != BLOCK_SPARSE ) )
+                        {
+                            ulIndirBlock = SnapNodeEntry( pSnap->d.ab, ( ulOffset % DINDIR_DATA_BLOCKS ) / INDIR_ENTRIES );
+                        }
+                    #else
+                        REDERROR();
+                        ulIndirBlock = BLOCK_SPARSE;
+                    #endif
+                }
+
+                if( ( ret == 0 ) && ( ulIndirBlock != BLOCK_SPARSE ) && ( ulIndirBlock != pSnap->ulNodeBlock ) )
+                {
+                    pSnap->ulNodeBlock = BLOCK_SPARSE;
+
+                    ret = SnapNodeRead( pSnap, ulIndirBlock, META_SIG_INDIR, pSnap->n.ab );
+
+                    if( ret == 0 )
+                    {
+                        pSnap->ulNodeBlock = ulIndirBlock;
+                    }
+                }
+
+                if( ret == 0 )
+                {
+                    if( ulIndirBlock == BLOCK_SPARSE )
+                    {
+                        *pulBlock = BLOCK_SPARSE;
+                    }
+                    else
+                    {
+                        *pulBlock = SnapNodeEntry( pSnap->n.ab, ulOffset % INDIR_ENTRIES );
+                    }
+                }
+            #else /* if REDCONF_DIRECT_POINTERS < INODE_ENTRIES */
+                REDERROR();
+                ret = -RED_EINVAL;
+            #endif /* if REDCONF_DIRECT_POINTERS < INODE_ENTRIES */
+        }
+
+        return ret;
+    }
+
+
+    #if REDCONF_DIRECT_POINTERS < INODE_ENTRIES
+
+/** @brief Read and validate an indirect or double indirect node of a
+ *         snapshot.
+ *
+ *  Like the validation done by the buffer cache, except that the sequence
+ *  number is checked against the snapshot, not the volume, which might have
+ *  changed since.  The node is left in on-disk byte order.
+ *
+ *  @param pSnap        The snapshot.
+ *  @param ulBlock      The block number of the node.
+ *  @param ulSignature  The expected node signature: META_SIG_INDIR or
+ *                      META_SIG_DINDIR.
+ *  @param pbNode       The block buffer to read the node into.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred, or the node is invalid.
+ */
+        static REDSTATUS SnapNodeRead( const SNAPSHOT * pSnap,
+                                       uint32_t ulBlock,
+                                       uint32_t ulSignature,
+                                       uint8_t * pbNode )
+        {
+            REDSTATUS ret;
+
+            ret = RedIoRead( pSnap->bVolNum, ulBlock, 1U, pbNode );
+
+            if( ret == 0 )
+            {
+                NODEHEADER hdr;
+                uint32_t ulOwner;
+
+                /*  Casting pbNode to (NODEHEADER *) would run afoul MISRA-C:2012
+                 *  R11.3, so instead copy the fields out.
+                 */
+                RedMemCpy( &hdr.ulSignature, &pbNode[ NODEHEADER_OFFSET_SIG ], sizeof( hdr.ulSignature ) );
+                RedMemCpy( &hdr.ulCRC, &pbNode[ NODEHEADER_OFFSET_CRC ], sizeof( hdr.ulCRC ) );
+                RedMemCpy( &hdr.ullSequence, &pbNode[ NODEHEADER_OFFSET_SEQ ], sizeof( hdr.ullSequence ) );
+                RedMemCpy( &ulOwner, &pbNode[ NODEHEADER_SIZE ], sizeof( ulOwner ) );
+
+                #ifdef REDCONF_ENDIAN_SWAP
+                    hdr.ulSignature = RedRev32( hdr.ulSignature );
+                    hdr.ulCRC = RedRev32( hdr.ulCRC );
+                    hdr.ullSequence = RedRev64( hdr.ullSequence );
+                    ulOwner = RedRev32( ulOwner );
+                #endif
+
+                if( ( hdr.ulSignature != ulSignature ) ||
+                    ( hdr.ulCRC != RedCrcNode( pbNode ) ) ||
+                    ( hdr.ullSequence > pSnap->ullSequence ) ||
+                    ( ulOwner != pSnap->ulInode ) )
+                {
+                    ret = -RED_EIO;
+                }
+            }
+
+            return ret;
+        }
+
+
+/** @brief Get an entry of an indirect or double indirect node read by
+ *         SnapNodeRead().
+ *
+ *  @param pbNode   The node, in on-disk byte order.
+ *  @param ulEntry  The index of the entry.
+ *
+ *  @return The block number in the entry.
+ */
+        static uint32_t SnapNodeEntry( const uint8_t * pbNode,
+                                       uint32_t ulEntry )
+        {
+            uint32_t ulBlock;
+
+            REDASSERT( ulEntry < INDIR_ENTRIES );
+
+            RedMemCpy( &ulBlock, &pbNode[ INDIR_HEADER_SIZE + ( ulEntry * sizeof( ulBlock ) ) ], sizeof( ulBlock ) );
+
+            #ifdef REDCONF_ENDIAN_SWAP
+                ulBlock = RedRev32( ulBlock );
+            #endif
+
+            return ulBlock;
+        }
+    #endif /* REDCONF_DIRECT_POINTERS < INODE_ENTRIES */
+
+#endif /* REDCONF_SNAPSHOTS > 0U */
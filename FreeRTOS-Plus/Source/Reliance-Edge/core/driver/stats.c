@@ -0,0 +1,242 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Implements the statistics returned by red_getstats().
+ *
+ *  Everything but the block device statistics is only modified with the FS
+ *  mutex held.  With fine-grained locking, a block device read may be done with
+ *  the FS mutex released, so the block device statistics have a semaphore of
+ *  their own.
+ */
+#include <redfs.h>
+
+#if REDCONF_STATISTICS == 1
+
+    #include <redcore.h>
+
+
+    static uint32_t StatLatency( REDLATSTAT * pStat,
+                                 REDTIMESTAMP tsStart,
+                                 bool fError );
+
+
+    static REDLATSTAT gaOpStat[ RED_STATOP_COUNT ];
+    static REDLATSTAT gTransactStat;
+    static REDIOSTAT gIoStat;
+    static uint32_t gulLastMountUsecs;
+    static uint32_t gulSummaryMounts;
+
+
+/** @brief Record the completion of an API call.
+ *
+ *  @param bOp      The operation: one of the RED_STATOP_* values.
+ *  @param tsStart  The timestamp from when the call started.
+ *  @param fError   Whether the call failed.
+ */
+    void RedStatOp( uint8_t bOp,
+                    REDTIMESTAMP tsStart,
+                    bool fError )
+    {
+        if( bOp >= RED_STATOP_COUNT )
+        {
+            REDERROR();
+        }
+        else
+        {
+            uint32_t ulUsecs = StatLatency( &gaOpStat[ bOp ], tsStart, fError );
+
+            if( ( bOp == RED_STATOP_MOUNT ) && !fError )
+            {
+                gulLastMountUsecs = ulUsecs;
+            }
+        }
+    }
+
+
+/** @brief Record the completion of a transaction point.
+ *
+ *  @param tsStart  The timestamp from when the transaction point started.
+ *  @param fError   Whether the transaction point failed.
+ */
+    void RedStatTransact( REDTIMESTAMP tsStart,
+                          bool fError )
+    {
+        ( void ) StatLatency( &gTransactStat, tsStart, fError );
+    }
+
+
+/** @brief Count a block device request.
+ *
+ *  May be called without the FS mutex.
+ *
+ *  @param bKind        The kind of request: one of the STATIO_* values.
+ *  @param ulBlockCount The number of blocks transferred or discarded; ignored
+ *                      for flushes.
+ */
+    void RedStatIo( uint8_t bKind,
+                    uint32_t ulBlockCount )
+    {
+        uint64_t ullBytes = ( uint64_t ) ulBlockCount << BLOCK_SIZE_P2;
+
+        #if REDCONF_FINE_LOCKING == 1
+            ( void ) RedOsSemaphoreTake( RED_SEM_STATS, true );
+        #endif
+
+        switch( bKind )
+        {
+            case STATIO_READ:
+                gIoStat.ulReads++;
+                gIoStat.ullReadBytes += ullBytes;
+                break;
+
+            case STATIO_WRITE:
+                gIoStat.ulWrites++;
+                gIoStat.ullWriteBytes += ullBytes;
+                break;
+
+            case STATIO_FLUSH:
+                gIoStat.ulFlushes++;
+                break;
+
+            case STATIO_DISCARD:
+                gIoStat.ulDiscards++;
+                gIoStat.ullDiscardBytes += ullBytes;
+                break;
+
+            default:
+                REDERROR();
+                break;
+        }
+
+        #if REDCONF_FINE_LOCKING == 1
+            RedOsSemaphoreGive( RED_SEM_STATS );
+        #endif
+    }
+
+
+/** @brief Count a mount which loaded the saved allocation summary.
+ */
+    void RedStatSummaryMount( void )
+    {
+        gulSummaryMounts++;
+    }
+
+
+/** @brief Retrieve the statistics.
+ *
+ *  @param pStats   The buffer to populate with the statistics.
+ *  @param fReset   Whether to reset the statistics to zero after they have
+ *                  been retrieved.
+ */
+    void RedStatGet( REDSTATS * pStats,
+                     bool fReset )
+    {
+        if( pStats == NULL )
+        {
+            REDERROR();
+        }
+        else
+        {
+            RedMemCpy( pStats->aOp, gaOpStat, sizeof( pStats->aOp ) );
+            pStats->transact = gTransactStat;
+            pStats->ulLastMountUsecs = gulLastMountUsecs;
+            pStats->ulSummaryMounts = gulSummaryMounts;
+            RedBufferStat( &pStats->buf, fReset );
+
+            if( fReset )
+            {
+                RedMemSet( gaOpStat, 0U, sizeof( gaOpStat ) );
+                RedMemSet( &gTransactStat, 0U, sizeof( gTransactStat ) );
+                gulLastMountUsecs = 0U;
+                gulSummaryMounts = 0U;
+            }
+
+            #if REDCONF_FINE_LOCKING == 1
+                ( void ) RedOsSemaphoreTake( RED_SEM_STATS, true );
+            #endif
+
+            pStats->io = gIoStat;
+
+            if( fReset )
+            {
+                RedMemSet( &gIoStat, 0U, sizeof( gIoStat ) );
+            }
+
+            #if REDCONF_FINE_LOCKING == 1
+                RedOsSemaphoreGive( RED_SEM_STATS );
+            #endif
+        }
+    }
+
+
+/** @brief Add the time since a timestamp to latency statistics.
+ *
+ *  @param pStat    The latency statistics to update.
+ *  @param tsStart  The timestamp from when the operation started.
+ *  @param fError   Whether the operation failed.
+ *
+ *  @return The time taken by the operation, in microseconds.
+ */
+    static uint32_t StatLatency( REDLATSTAT * pStat,
+                                 REDTIMESTAMP tsStart,
+                                 bool fError )
+    {
+        uint64_t ullUsecs = RedOsTimePassed( tsStart );
+        uint32_t ulUsecs = ( ullUsecs > UINT32_MAX ) ? UINT32_MAX : ( uint32_t ) ullUsecs;
+        uint32_t ulBucket = 0U;
+
+        /*  Bucket n holds times with n significant bits, so bucket zero is for
+         *  times of zero and bucket one for times of one microsecond.
+         */
+        while( ( ulUsecs >> ulBucket ) != 0U )
+        {
+            ulBucket++;
+        }
+
+        if( ulBucket >= RED_STAT_HIST_BUCKETS )
+        {
+            ulBucket = RED_STAT_HIST_BUCKETS - 1U;
+        }
+
+        pStat->ulCount++;
+        pStat->ullTotalUsecs += ulUsecs;
+        pStat->aulHist[ ulBucket ]++;
+
+        if( fError )
+        {
+            pStat->ulErrors++;
+        }
+
+        if( ulUsecs > pStat->ulMaxUsecs )
+        {
+            pStat->ulMaxUsecs = ulUsecs;
+        }
+
+        return ulUsecs;
+    }
+
+#endif /* REDCONF_STATISTICS == 1 */
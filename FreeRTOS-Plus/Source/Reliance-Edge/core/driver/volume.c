@@ -70,6 +70,9 @@ REDSTATUS RedVolMount( void )
              *  confusion that could be caused by stale or corrupt metadata.
              */
             ( void ) RedBufferDiscardRange( 0U, gpRedVolume->ulBlockCount );
+            #if REDCONF_READ_AHEAD_BLOCKS > 0U
+                RedInodeReadAheadDiscard();
+            #endif
             ( void ) RedOsBDevClose( gbRedVolNum );
         }
     }
@@ -112,7 +115,8 @@ REDSTATUS RedVolMountMaster( void )
             ( pMB->bBlockSizeP2 != BLOCK_SIZE_P2 ) ||
             ( ( ( pMB->bFlags & MBFLAG_API_POSIX ) != 0U ) != ( REDCONF_API_POSIX == 1 ) ) ||
             ( ( ( pMB->bFlags & MBFLAG_INODE_TIMESTAMPS ) != 0U ) != ( REDCONF_INODE_TIMESTAMPS == 1 ) ) ||
-            ( ( ( pMB->bFlags & MBFLAG_INODE_BLOCKS ) != 0U ) != ( REDCONF_INODE_BLOCKS == 1 ) ) )
+            ( ( ( pMB->bFlags & MBFLAG_INODE_BLOCKS ) != 0U ) != ( REDCONF_INODE_BLOCKS == 1 ) ) ||
+            ( ( ( pMB->bFlags & MBFLAG_INODE_INLINE ) != 0U ) != ( REDCONF_INODE_INLINE_DATA == 1 ) ) )
         {
             ret = -RED_EIO;
         }
@@ -258,6 +262,16 @@ REDSTATUS RedVolMountMetaroot( void )
         gpRedVolume->fMounted = true;
         #if REDCONF_READ_ONLY == 0
             gpRedVolume->fReadOnly = false;
+            RedImapSummaryReset();
+        #endif
+
+        #if ( REDCONF_FAST_MOUNT == 1 ) && ( REDCONF_STATISTICS == 1 )
+            if( RedImapSummaryLoad() )
+            {
+                RedStatSummaryMount();
+            }
+        #elif REDCONF_FAST_MOUNT == 1
+            ( void ) RedImapSummaryLoad();
         #endif
 
         #if RESERVED_BLOCKS > 0U
@@ -265,6 +279,15 @@ REDSTATUS RedVolMountMetaroot( void )
         #endif
         gpRedCoreVol->ulAlmostFreeBlocks = 0U;
 
+        #if REDCONF_INODE_CACHE_ENTRIES > 0U
+            RedInodeCacheDiscard();
+        #endif
+
+        #if REDCONF_TRANSACT_BACKGROUND == 1
+            gpRedCoreVol->fTransactPending = false;
+            gpRedCoreVol->ulBuffersDirtied = 0U;
+        #endif
+
         gpRedCoreVol->aMR[ 1U - gpRedCoreVol->bCurMR ] = *gpRedMR;
         gpRedCoreVol->bCurMR = 1U - gpRedCoreVol->bCurMR;
         gpRedMR = &gpRedCoreVol->aMR[ gpRedCoreVol->bCurMR ];
@@ -364,6 +387,10 @@ static bool MetarootIsValid( METAROOT * pMR,
 
         if( gpRedCoreVol->fBranched )
         {
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
+
             gpRedMR->ulFreeBlocks += gpRedCoreVol->ulAlmostFreeBlocks;
             gpRedCoreVol->ulAlmostFreeBlocks = 0U;
 
@@ -374,6 +401,10 @@ static bool MetarootIsValid( METAROOT * pMR,
                 gpRedMR->hdr.ulSignature = META_SIG_METAROOT;
                 gpRedMR->hdr.ullSequence = gpRedVolume->ullSequence;
 
+                #if REDCONF_FAST_MOUNT == 1
+                    RedImapSummarySave();
+                #endif
+
                 ret = RedVolSeqNumIncrement();
             }
 
@@ -445,16 +476,106 @@ static bool MetarootIsValid( METAROOT * pMR,
                 gpRedMR = &gpRedCoreVol->aMR[ gpRedCoreVol->bCurMR ];
 
                 gpRedCoreVol->fBranched = false;
+
+                /*  Almost free blocks are now free.
+                 */
+                RedImapSummaryTransact();
+
+                #if REDCONF_DISCARD_EXTENTS > 0U
+                    RedImapDiscardTransact();
+                #endif
+
+                #if REDCONF_SNAPSHOTS > 0U
+                    RedImapHoldTransact();
+                #endif
+
+                #if REDCONF_INODE_CACHE_ENTRIES > 0U
+                    RedInodeCacheTransact();
+                #endif
             }
 
+            #if REDCONF_STATISTICS == 1
+                RedStatTransact( tsStart, ret != 0 );
+            #endif
+
             CRITICAL_ASSERT( ret == 0 );
         }
 
+        #if REDCONF_TRANSACT_BACKGROUND == 1
+            if( ret == 0 )
+            {
+                /*  This transaction point covers any which was deferred.
+                 */
+                gpRedCoreVol->fTransactPending = false;
+                gpRedCoreVol->ulBuffersDirtied = 0U;
+            }
+        #endif
+
+        return ret;
+    }
+
+
+/** @brief Commit a transaction point for an automatic transaction event.
+ *
+ *  With background transactions, the transaction point is only requested from
+ *  the commit task; otherwise, it is committed right away.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+    REDSTATUS RedVolTransactAuto( void )
+    {
+        REDSTATUS ret;
+
+        #if REDCONF_TRANSACT_BACKGROUND == 1
+            RedVolTransactDefer();
+            ret = 0;
+        #else
+            ret = RedVolTransact();
+        #endif
+
         return ret;
     }
 #endif /* if REDCONF_READ_ONLY == 0 */
 
 
+#if REDCONF_TRANSACT_BACKGROUND == 1
+
+/** @brief Request a transaction point from the background commit task.
+ */
+    void RedVolTransactDefer( void )
+    {
+        if( !gpRedCoreVol->fTransactPending )
+        {
+            gpRedCoreVol->fTransactPending = true;
+            RedOsCommitTaskWake();
+        }
+    }
+
+
+/** @brief Note that a buffer of the current volume has become dirty.
+ *
+ *  Requests a background transaction point once REDCONF_TRANSACT_WATERMARK
+ *  buffers have been dirtied since the last one, unless the volume is using
+ *  manual transactions: then only the application may commit.
+ */
+    void RedVolBufferDirtied( void )
+    {
+        gpRedCoreVol->ulBuffersDirtied++;
+
+        #if REDCONF_TRANSACT_WATERMARK > 0
+            if( ( gpRedCoreVol->ulBuffersDirtied == REDCONF_TRANSACT_WATERMARK ) &&
+                ( gpRedVolume->ulTransMask != RED_TRANSACT_MANUAL ) )
+            {
+                RedVolTransactDefer();
+            }
+        #endif
+    }
+#endif /* REDCONF_TRANSACT_BACKGROUND == 1 */
+
+
 #ifdef REDCONF_ENDIAN_SWAP
     static void MetaRootEndianSwap( METAROOT * pMetaRoot )
     {
@@ -35,6 +35,7 @@
 #include "rednodes.h"
 #include "redcoremacs.h"
 #include "redcorevol.h"
+#include "reddcache.h"
 
 
 #define META_SIG_MASTER      ( 0x5453414DU ) /* 'MAST' */
@@ -49,6 +50,12 @@ REDSTATUS RedIoRead( uint8_t bVolNum,
                      uint32_t ulBlockStart,
                      uint32_t ulBlockCount,
                      void * pBuffer );
+#if REDCONF_READ_AHEAD_BLOCKS > 0U
+    REDSTATUS RedIoReadAhead( uint8_t bVolNum,
+                              uint32_t ulBlockStart,
+                              uint32_t ulBlockCount,
+                              void * pBuffer );
+#endif
 #if REDCONF_READ_ONLY == 0
     REDSTATUS RedIoWrite( uint8_t bVolNum,
                           uint32_t ulBlockStart,
@@ -56,6 +63,11 @@ REDSTATUS RedIoRead( uint8_t bVolNum,
                           const void * pBuffer );
     REDSTATUS RedIoFlush( uint8_t bVolNum );
 #endif
+#if REDCONF_DISCARD_EXTENTS > 0U
+    REDSTATUS RedIoDiscard( uint8_t bVolNum,
+                            uint32_t ulBlockStart,
+                            uint32_t ulBlockCount );
+#endif
 
 
 /** Indicates a block buffer is dirty (its contents are different than the
@@ -113,6 +125,28 @@ void RedBufferPut( const void * pBuffer );
 #endif
 REDSTATUS RedBufferDiscardRange( uint32_t ulBlockStart,
                                  uint32_t ulBlockCount );
+#if REDCONF_READ_AHEAD_BLOCKS > 0U
+    REDSTATUS RedBufferReadAhead( uint32_t ulBlockStart,
+                                  uint32_t ulBlockCount );
+#endif
+void RedBufferStat( REDBUFSTAT * pStat,
+                    bool fReset );
+#if REDCONF_READ_LEASES > 0U
+    REDSTATUS RedBufferLease( const void * pBuffer,
+                              const void ** ppLeased );
+    REDSTATUS RedBufferLeaseRelease( const void * pData );
+    bool RedBufferLeased( void );
+    #if REDCONF_INODE_INLINE_DATA == 1
+        REDSTATUS RedBufferLeaseCopy( const void * pBuffer,
+                                      const void ** ppLeased );
+    #endif
+#endif
+#if REDCONF_FINE_LOCKING == 1
+    void RedBufferUnlockedReads( bool fEnable );
+    REDSTATUS RedBufferReadDirect( uint32_t ulBlockStart,
+                                   uint32_t ulBlockCount,
+                                   void * pBuffer );
+#endif
 
 
 /** @brief Allocation state of a block.
@@ -132,7 +166,24 @@ REDSTATUS RedImapBlockGet( uint8_t bMR,
     REDSTATUS RedImapBlockSet( uint32_t ulBlock,
                                bool fAllocated );
     REDSTATUS RedImapAllocBlock( uint32_t * pulBlock );
+    REDSTATUS RedImapAllocExtent( uint32_t ulMaxCount,
+                                  uint32_t * pulBlock,
+                                  uint32_t * pulCount );
+    void RedImapSummaryReset( void );
+    void RedImapSummaryTransact( void );
+    #if REDCONF_FAST_MOUNT == 1
+        bool RedImapSummaryLoad( void );
+        void RedImapSummarySave( void );
+    #endif
+    #if REDCONF_DISCARD_EXTENTS > 0U
+        void RedImapDiscardTransact( void );
+    #endif
+    #if REDCONF_SNAPSHOTS > 0U
+        void RedImapHoldTransact( void );
+        void RedImapHoldRelease( void );
+    #endif
 #endif
+uint32_t RedImapFreeCount( void );
 REDSTATUS RedImapBlockState( uint32_t ulBlock,
                              ALLOCSTATE * pState );
 
@@ -142,6 +193,9 @@ REDSTATUS RedImapBlockState( uint32_t ulBlock,
                                 bool * pfAllocated );
     REDSTATUS RedImapIBlockSet( uint32_t ulBlock,
                                 bool fAllocated );
+    REDSTATUS RedImapIFindFree( uint32_t ulStart,
+                                uint32_t ulEnd,
+                                uint32_t * pulBlock );
 #endif
 
 #if REDCONF_IMAP_EXTERNAL == 1
@@ -150,6 +204,9 @@ REDSTATUS RedImapBlockState( uint32_t ulBlock,
                                 bool * pfAllocated );
     REDSTATUS RedImapEBlockSet( uint32_t ulBlock,
                                 bool fAllocated );
+    REDSTATUS RedImapEFindFree( uint32_t ulStart,
+                                uint32_t ulEnd,
+                                uint32_t * pulBlock );
     uint32_t RedImapNodeBlock( uint8_t bMR,
                                uint32_t ulImapNode );
 #endif
@@ -245,6 +302,12 @@ REDSTATUS RedInodeBitGet( uint8_t bMR,
                           uint32_t ulInode,
                           uint8_t bWhich,
                           bool * pfAllocated );
+#if REDCONF_INODE_CACHE_ENTRIES > 0U
+    #if REDCONF_READ_ONLY == 0
+        void RedInodeCacheTransact( void );
+    #endif
+    void RedInodeCacheDiscard( void );
+#endif
 
 REDSTATUS RedInodeDataRead( CINODE * pInode,
                             uint64_t ullStart,
@@ -255,15 +318,27 @@ REDSTATUS RedInodeDataRead( CINODE * pInode,
                                  uint64_t ullStart,
                                  uint32_t * pulLen,
                                  const void * pBuffer );
+    REDSTATUS RedInodeDataAllocate( CINODE * pInode,
+                                    uint64_t ullStart,
+                                    uint64_t ullLen );
     #if DELETE_SUPPORTED || TRUNCATE_SUPPORTED
         REDSTATUS RedInodeDataTruncate( CINODE * pInode,
                                         uint64_t ullSize );
     #endif
 #endif
+#if REDCONF_READ_LEASES > 0U
+    REDSTATUS RedInodeDataLease( CINODE * pInode,
+                                 uint64_t ullStart,
+                                 uint32_t * pulLen,
+                                 const void ** ppData );
+#endif
 REDSTATUS RedInodeDataSeekAndRead( CINODE * pInode,
                                    uint32_t ulBlock );
 REDSTATUS RedInodeDataSeek( CINODE * pInode,
                             uint32_t ulBlock );
+#if REDCONF_READ_AHEAD_BLOCKS > 0U
+    void RedInodeReadAheadDiscard( void );
+#endif
 
 #if REDCONF_API_POSIX == 1
     #if REDCONF_READ_ONLY == 0
@@ -293,6 +368,9 @@ REDSTATUS RedInodeDataSeek( CINODE * pInode,
                                      const char * pszDstName,
                                      CINODE * pDstInode );
     #endif
+    #if REDCONF_DIR_INDEX_DIRS > 0U
+        void RedDirIndexDiscard( void );
+    #endif
 #endif /* if REDCONF_API_POSIX == 1 */
 
 REDSTATUS RedVolMount( void );
@@ -300,11 +378,44 @@ REDSTATUS RedVolMountMaster( void );
 REDSTATUS RedVolMountMetaroot( void );
 #if REDCONF_READ_ONLY == 0
     REDSTATUS RedVolTransact( void );
+    REDSTATUS RedVolTransactAuto( void );
+#endif
+#if REDCONF_TRANSACT_BACKGROUND == 1
+    void RedVolTransactDefer( void );
+    void RedVolBufferDirtied( void );
 #endif
 void RedVolCriticalError( const char * pszFileName,
                           uint32_t ulLineNum );
 REDSTATUS RedVolSeqNumIncrement( void );
 
+#if REDCONF_STATISTICS == 1
+
+/*  Kinds of block device request, for RedStatIo().
+ */
+    #define STATIO_READ       0U
+    #define STATIO_WRITE      1U
+    #define STATIO_FLUSH      2U
+    #define STATIO_DISCARD    3U
+
+    void RedStatOp( uint8_t bOp,
+                    REDTIMESTAMP tsStart,
+                    bool fError );
+    void RedStatTransact( REDTIMESTAMP tsStart,
+                          bool fError );
+    void RedStatIo( uint8_t bKind,
+                    uint32_t ulBlockCount );
+    void RedStatSummaryMount( void );
+    void RedStatGet( REDSTATS * pStats,
+                     bool fReset );
+#endif /* REDCONF_STATISTICS == 1 */
+
+#if REDCONF_SNAPSHOTS > 0U
+    void RedSnapStale( void );
+    bool RedSnapInUse( void );
+    bool RedSnapInodeOpen( uint32_t ulInode );
+    void RedSnapInodeDeleted( uint32_t ulInode );
+#endif
+
 #if FORMAT_SUPPORTED
     REDSTATUS RedVolFormat( void );
 #endif
@@ -30,6 +30,25 @@
 #define REDCOREVOL_H
 
 
+/*  Number of regions into which the allocable blocks are divided for the
+ *  allocation summary.  Must be a multiple of 8.
+ */
+#define IMAP_SUMMARY_REGIONS    64U
+
+
+#if ( REDCONF_DISCARD_EXTENTS > 0U ) || ( REDCONF_SNAPSHOTS > 0U )
+
+/** @brief An extent of blocks: to be discarded after the next transaction
+ *         point, or held for the open snapshots.
+ */
+    typedef struct
+    {
+        uint32_t ulBlock; /**< First block of the extent. */
+        uint32_t ulCount; /**< Number of blocks in the extent. */
+    } BLOCKEXTENT;
+#endif
+
+
 /** @brief Per-volume run-time data specific to the core.
  */
 typedef struct
@@ -75,6 +94,82 @@ typedef struct
      */
     uint32_t ulAlmostFreeBlocks;
 
+    #if REDCONF_READ_ONLY == 0
+
+        /** The number of allocable blocks in each region of the allocation
+         *  summary, except perhaps the last.
+         */
+        uint32_t ulImapRegionBlocks;
+
+        /** Allocation summary: a bit for each region, which is set when the
+         *  region is known to contain no free blocks, so that allocation can
+         *  skip it without examining the imap.
+         */
+        uint8_t abImapRegionFull[ IMAP_SUMMARY_REGIONS / 8U ];
+
+        /** A bit for each region, which is set when the region contains blocks
+         *  which will become free after the next transaction.
+         */
+        uint8_t abImapRegionAFree[ IMAP_SUMMARY_REGIONS / 8U ];
+    #endif
+
+    #if REDCONF_DISCARD_EXTENTS > 0U
+
+        /** Extents of almost free blocks, which are discarded once they become
+         *  free at the next transaction point.
+         */
+        BLOCKEXTENT aDiscard[ REDCONF_DISCARD_EXTENTS ];
+
+        /** The number of extents in use in aDiscard.
+         */
+        uint8_t bDiscardCount;
+    #endif
+
+    #if REDCONF_SNAPSHOTS > 0U
+
+        /** The number of snapshots of this volume which are open and not
+         *  stale.
+         */
+        uint8_t bSnapCount;
+
+        /** Whether blocks freed from the committed state must be held: set
+         *  while blocks of a file with an open snapshot are being branched or
+         *  truncated.
+         */
+        bool fSnapHold;
+
+        /** Extents of blocks which were freed from the committed state of a
+         *  file while a snapshot of it was open, and which must not be
+         *  reallocated until the snapshot is closed.
+         */
+        BLOCKEXTENT aHeld[ REDCONF_SNAPSHOT_EXTENTS ];
+
+        /** The number of extents in use in aHeld.
+         */
+        uint8_t bHeldCount;
+
+        /** The number of blocks in aHeld.
+         */
+        uint32_t ulHeldBlocks;
+
+        /** The number of blocks in aHeld which are free, rather than almost
+         *  free, and so are included in the free block count of the metaroot.
+         */
+        uint32_t ulHeldFree;
+    #endif
+
+    #if REDCONF_TRANSACT_BACKGROUND == 1
+
+        /** Whether an automatic transaction point has been deferred to the
+         *  background commit task.
+         */
+        bool fTransactPending;
+
+        /** The number of buffers dirtied since the last transaction point.
+         */
+        uint32_t ulBuffersDirtied;
+    #endif
+
     #if RESERVED_BLOCKS > 0U
 
         /** Whether to use the blocks reserved for operations that create free
@@ -0,0 +1,51 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Interfaces of the cache of directory entry lookups.
+ */
+#ifndef REDDCACHE_H
+#define REDDCACHE_H
+
+
+#if REDCONF_DENTRY_CACHE_ENTRIES > 0U
+    void RedDcacheInit( void );
+    bool RedDcacheLookup( uint32_t ulPInode,
+                          const char * pszName,
+                          uint32_t * pulInode );
+    void RedDcacheInsert( uint32_t ulPInode,
+                          const char * pszName,
+                          uint32_t ulInode );
+    #if REDCONF_READ_ONLY == 0
+        void RedDcacheInvalidate( uint32_t ulPInode,
+                                  const char * pszName );
+        void RedDcachePurge( uint32_t ulPInode );
+    #endif
+    void RedDcacheDiscard( void );
+#endif /* REDCONF_DENTRY_CACHE_ENTRIES > 0U */
+
+
+#endif /* ifndef REDDCACHE_H */
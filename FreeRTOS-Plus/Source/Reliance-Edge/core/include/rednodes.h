@@ -57,6 +57,9 @@ typedef struct
 /** Flag set in the master block when (REDCONF_API_POSIX == 1) && (REDCONF_API_POSIX_LINK == 1). */
 #define MBFLAG_INODE_NLINK         ( 0x08U )
 
+/** Flag set in the master block when REDCONF_INODE_INLINE_DATA == 1. */
+#define MBFLAG_INODE_INLINE        ( 0x10U )
+
 
 /** @brief Node which identifies the volume and stores static volume information.
  */
@@ -131,6 +134,19 @@ typedef struct
       ( ( REDCONF_INODE_TIMESTAMPS == 1 ) ? 12U : 0U ) + 4U + ( ( REDCONF_API_POSIX == 1 ) ? 4U : 0U ) )
 #define INODE_ENTRIES    ( ( REDCONF_BLOCK_SIZE - INODE_HEADER_SIZE ) / 4U )
 
+/*  Number of bytes of file data which can be stored inline, in place of the
+ *  INODE::aulEntries array.
+ */
+#define INODE_INLINE_MAX     ( INODE_ENTRIES * 4U )
+
+/*  Flag set in INODE::uMode when the file data is stored inline.  Only used
+ *  with REDCONF_INODE_INLINE_DATA == 1; never reported to applications.  A bit
+ *  is set in each byte, so that the flag can be tested in either byte order,
+ *  as BufferEndianSwapInode() must.
+ */
+#define INODE_MODE_INLINE     ( 0x0101U )
+#define INODE_IS_INLINE( pInodeBuf )    ( ( ( pInodeBuf )->uMode & INODE_MODE_INLINE ) == INODE_MODE_INLINE )
+
 #if ( REDCONF_DIRECT_POINTERS < 0 ) || ( REDCONF_DIRECT_POINTERS > ( INODE_ENTRIES - REDCONF_INDIRECT_POINTERS ) )
     #error "Configuration error: invalid value of REDCONF_DIRECT_POINTERS"
 #endif
@@ -169,6 +185,9 @@ typedef struct
      *  pointers; the number allocated to each is static but user-configurable.
      *  For all types, an array slot is zero if the range is sparse or beyond
      *  the end of file.
+     *
+     *  If #INODE_MODE_INLINE is set in uMode, the array instead holds the file
+     *  data, with every byte beyond the end of file zeroed.
      */
     uint32_t aulEntries[ INODE_ENTRIES ];
 } INODE;
@@ -194,4 +213,42 @@ typedef struct
 } INDIR, DINDIR;
 
 
+#if REDCONF_API_POSIX == 1
+    #if ( REDCONF_NAME_MAX % 4U ) != 0U
+        #define DIRENT_PADDING    ( 4U - ( REDCONF_NAME_MAX % 4U ) )
+    #else
+        #define DIRENT_PADDING    ( 0U )
+    #endif
+    #define DIRENT_SIZE           ( 4U + REDCONF_NAME_MAX + DIRENT_PADDING )
+    #define DIRENTS_PER_BLOCK     ( REDCONF_BLOCK_SIZE / DIRENT_SIZE )
+
+/** @brief On-disk directory entry.
+ *
+ *  Directory data is an array of these, packed into each block with any space
+ *  left over at the end of the block unused.
+ */
+    typedef struct
+    {
+        /** The inode number that the directory entry points at.  If the directory
+         *  entry is available, this holds INODE_INVALID.
+         */
+        uint32_t ulInode;
+
+        /** The name of the directory entry.  For names shorter than
+         *  REDCONF_NAME_MAX, unused bytes in the array are zeroed.  For names of
+         *  the maximum length, the string is not null terminated.
+         */
+        char acName[ REDCONF_NAME_MAX ];
+
+        #if DIRENT_PADDING > 0U
+
+            /** Unused padding so that ulInode is always aligned on a four-byte
+             *  boundary.
+             */
+            uint8_t abPadding[ DIRENT_PADDING ];
+        #endif
+    } DIRENT;
+#endif /* REDCONF_API_POSIX == 1 */
+
+
 #endif /* ifndef REDNODES_H */
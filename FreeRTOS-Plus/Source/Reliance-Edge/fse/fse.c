@@ -333,6 +333,58 @@
     }
 
 
+/** @brief Read from a file into several buffers.
+ *
+ *  Like RedFseRead(), except that the data is scattered into the buffers of
+ *  @p paIov, in order, filling each one before moving on to the next.  The
+ *  whole request is a single file system operation.
+ *
+ *  @param bVolNum          The volume number of the file to read.
+ *  @param ulFileNum        The file number of the file to read.
+ *  @param ullFileOffset    The file offset to read from.
+ *  @param paIov            The buffers to populate with the data read.
+ *  @param ulIovCount       The number of elements in @p paIov.
+ *
+ *  @return The number of bytes read (nonnegative) or a negated ::REDSTATUS
+ *          code indicating the operation result (negative).
+ *
+ *  @retval >=0         The number of bytes read from the file.
+ *  @retval -RED_EBADF  @p ulFileNum is not a valid file number.
+ *  @retval -RED_EINVAL @p bVolNum is an invalid volume number or not mounted;
+ *                      or @p paIov is `NULL`; or @p ulIovCount is zero; or a
+ *                      buffer with a nonzero length is `NULL`; or the total
+ *                      length of the buffers exceeds INT32_MAX and cannot be
+ *                      returned properly.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+    int32_t RedFseReadv( uint8_t bVolNum,
+                         uint32_t ulFileNum,
+                         uint64_t ullFileOffset,
+                         const REDIOVEC * paIov,
+                         uint32_t ulIovCount )
+    {
+        int32_t ret;
+
+        ret = FseEnter( bVolNum );
+
+        if( ret == 0 )
+        {
+            uint32_t ulReadLen = 0U;
+
+            ret = RedCoreFileReadv( ulFileNum, ullFileOffset, paIov, ulIovCount, &ulReadLen );
+
+            FseLeave();
+
+            if( ret == 0 )
+            {
+                ret = ( int32_t ) ulReadLen;
+            }
+        }
+
+        return ret;
+    }
+
+
     #if REDCONF_READ_ONLY == 0
 
 /** @brief Write to a file.
@@ -406,6 +458,65 @@
 
             return ret;
         }
+
+
+/** @brief Write to a file from several buffers.
+ *
+ *  Like RedFseWrite(), except that the data is gathered from the buffers of
+ *  @p paIov, in order.  The whole request is a single file system operation,
+ *  and a #RED_TRANSACT_WRITE automatic transaction point, if enabled, happens
+ *  once for the whole request.
+ *
+ *  @param bVolNum          The volume number of the file to write.
+ *  @param ulFileNum        The file number of the file to write.
+ *  @param ullFileOffset    The file offset to write at.
+ *  @param paIov            The buffers containing the data to be written.
+ *  @param ulIovCount       The number of elements in @p paIov.
+ *
+ *  @return The number of bytes written (nonnegative) or a negated ::REDSTATUS
+ *          code indicating the operation result (negative).
+ *
+ *  @retval >=0         The number of bytes written to the file.
+ *  @retval -RED_EBADF  @p ulFileNum is not a valid file number.
+ *  @retval -RED_EFBIG  No data can be written to the given file offset since
+ *                      the resulting file size would exceed the maximum file
+ *                      size.
+ *  @retval -RED_EINVAL @p bVolNum is an invalid volume number or not mounted;
+ *                      or @p paIov is `NULL`; or @p ulIovCount is zero; or a
+ *                      buffer with a nonzero length is `NULL`; or the total
+ *                      length of the buffers exceeds INT32_MAX and cannot be
+ *                      returned properly.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_ENOSPC No data can be written because there is insufficient
+ *                      free space.
+ *  @retval -RED_EROFS  The file system volume is read-only.
+ */
+        int32_t RedFseWritev( uint8_t bVolNum,
+                              uint32_t ulFileNum,
+                              uint64_t ullFileOffset,
+                              const REDIOVEC * paIov,
+                              uint32_t ulIovCount )
+        {
+            int32_t ret;
+
+            ret = FseEnter( bVolNum );
+
+            if( ret == 0 )
+            {
+                uint32_t ulWriteLen = 0U;
+
+                ret = RedCoreFileWritev( ulFileNum, ullFileOffset, paIov, ulIovCount, &ulWriteLen );
+
+                FseLeave();
+
+                if( ret == 0 )
+                {
+                    ret = ( int32_t ) ulWriteLen;
+                }
+            }
+
+            return ret;
+        }
     #endif /* if REDCONF_READ_ONLY == 0 */
 
 
@@ -460,6 +571,58 @@
     #endif /* if ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_API_FSE_TRUNCATE == 1 ) */
 
 
+    #if REDCONF_READ_ONLY == 0
+
+/** @brief Reserve space for a range of a file.
+ *
+ *  Blocks in the range which are sparse are allocated and filled with zeroes,
+ *  taking contiguous extents of free space where possible.  Existing data in
+ *  the range is not changed.  If the range ends beyond the end of the file,
+ *  the file size is increased to the end of the range.
+ *
+ *  The reserved blocks can only be written in place until the next transaction
+ *  point, since Reliance Edge never overwrites committed data; so the range
+ *  should be written before transacting.  This function does not trigger an
+ *  automatic transaction point.
+ *
+ *  @param bVolNum          The volume number of the file.
+ *  @param ulFileNum        The file number of the file.
+ *  @param ullFileOffset    The file offset at which the range starts.
+ *  @param ullLength        The length of the range, in bytes.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EBADF  @p ulFileNum is not a valid file number.
+ *  @retval -RED_EFBIG  The range extends beyond the maximum file size.
+ *  @retval -RED_EINVAL @p bVolNum is an invalid volume number or not mounted.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ *  @retval -RED_ENOSPC Insufficient free space to reserve the whole range.  The
+ *                      blocks which could be reserved remain so, and the file
+ *                      size covers them.
+ *  @retval -RED_EROFS  The file system volume is read-only.
+ */
+        REDSTATUS RedFseReserve( uint8_t bVolNum,
+                                 uint32_t ulFileNum,
+                                 uint64_t ullFileOffset,
+                                 uint64_t ullLength )
+        {
+            REDSTATUS ret;
+
+            ret = FseEnter( bVolNum );
+
+            if( ret == 0 )
+            {
+                ret = RedCoreFileAllocate( ulFileNum, ullFileOffset, ullLength );
+
+                FseLeave();
+            }
+
+            return ret;
+        }
+    #endif /* REDCONF_READ_ONLY == 0 */
+
+
 /** @brief Retrieve the size of a file.
  *
  *  @param bVolNum      The volume number of the file whose size is being read.
@@ -176,6 +176,210 @@
     #error "Configuration error: REDCONF_CHECKER must be defined."
 #endif
 
+/*  The options below are not emitted by version 2.0 of the configuration
+ *  utility.  When a redconf.h does not define them, they take the values given
+ *  here, which preserve the behavior of earlier releases.
+ */
+
+/** Whether the block buffer cache keeps a hash index of the buffered blocks.
+ *  When enabled, looking up a buffer takes constant time regardless of
+ *  REDCONF_BUFFER_COUNT, at the cost of REDCONF_BUFFER_COUNT bytes plus one
+ *  byte per hash bucket of RAM.  Recommended for buffer counts above 32.
+ */
+#ifndef REDCONF_BUFFER_HASH
+    #define REDCONF_BUFFER_HASH    0
+#endif
+
+/** Replacement policy for the block buffer cache: BUFFER_POLICY_LRU or
+ *  BUFFER_POLICY_2Q.  The 2Q policy keeps metadata and repeatedly used blocks
+ *  cached while large sequential reads and writes pass through; it costs
+ *  about 5 * REDCONF_BUFFER_COUNT bytes of additional RAM.
+ */
+#ifndef REDCONF_BUFFER_POLICY
+    #define REDCONF_BUFFER_POLICY    BUFFER_POLICY_LRU
+#endif
+
+/** Size, in blocks, of a bounce buffer used when flushing dirty buffers, as at
+ *  a transaction point.  Dirty buffers for adjacent blocks are always written
+ *  with a single request when they are also adjacent in memory; with a bounce
+ *  buffer, up to this many dirty buffers for adjacent blocks are gathered into
+ *  a single request even when they are not.  Zero disables the bounce buffer.
+ */
+#ifndef REDCONF_BUFFER_WRITE_GATHER
+    #define REDCONF_BUFFER_WRITE_GATHER    0
+#endif
+
+/** Maximum number of file data blocks to read ahead, into the block buffers,
+ *  when a file is being read sequentially in small pieces.  Read-ahead uses a
+ *  bounce buffer of this many blocks, shared with REDCONF_BUFFER_WRITE_GATHER.
+ *  Zero disables read-ahead.
+ */
+#ifndef REDCONF_READ_AHEAD_BLOCKS
+    #define REDCONF_READ_AHEAD_BLOCKS    0
+#endif
+
+/** Alignment, in bytes, of the block buffers and of the read-ahead and write
+ *  gathering bounce buffer.  Block device drivers which transfer with DMA can
+ *  then use buffers from the buffer cache directly; raise this to the DMA or
+ *  data cache line alignment of the target when that exceeds 8 bytes.  Costs
+ *  up to twice this many bytes of RAM beyond the default.
+ */
+#ifndef REDCONF_BUFFER_ALIGNMENT
+    #define REDCONF_BUFFER_ALIGNMENT    8U
+#endif
+
+/** Number of directories for which an in-memory name-hash index is kept.  The
+ *  index is built when a directory larger than one block is first searched and
+ *  is not stored on disk, so the on-disk format is unchanged.  Zero disables
+ *  directory indexing.
+ */
+#ifndef REDCONF_DIR_INDEX_DIRS
+    #define REDCONF_DIR_INDEX_DIRS    0
+#endif
+
+/** Number of hash table slots in each directory index.  A directory with more
+ *  entries than three quarters of this number is searched linearly.  Each slot
+ *  costs eight bytes of RAM per indexed directory.
+ */
+#ifndef REDCONF_DIR_INDEX_ENTRIES
+    #define REDCONF_DIR_INDEX_ENTRIES    256
+#endif
+
+/** Number of entries in the cache of name lookups, which maps a parent
+ *  directory and a name to the inode it names, or to the absence of that name.
+ *  Path resolution consults the cache before searching a directory.  Each entry
+ *  costs about REDCONF_NAME_MAX + 20 bytes of RAM.  Zero disables the cache.
+ */
+#ifndef REDCONF_DENTRY_CACHE_ENTRIES
+    #define REDCONF_DENTRY_CACHE_ENTRIES    0
+#endif
+
+/** Number of entries in the cache of inode locations, which remembers which of
+ *  the two copies of an inode is current and whether the inode is branched.
+ *  Mounting a cached inode skips the imap lookups which would otherwise find
+ *  these, so repeated operations on the same files are cheaper.  Each entry
+ *  costs 12 bytes of RAM.  Zero disables the cache.
+ */
+#ifndef REDCONF_INODE_CACHE_ENTRIES
+    #define REDCONF_INODE_CACHE_ENTRIES    0
+#endif
+
+/** Whether the POSIX-like API locks each volume separately, with reader/writer
+ *  semantics, rather than serializing all file system calls with one mutex.
+ *  Reads, lseeks, and fstats share the lock of their volume; and a task whose
+ *  read is waiting on the block device does not prevent other tasks from using
+ *  the file system.  Requires counting semaphores from the OS.
+ */
+#ifndef REDCONF_FINE_LOCKING
+    #define REDCONF_FINE_LOCKING    0
+#endif
+
+/** Whether automatic transaction points are committed by a background task
+ *  rather than by the task whose operation triggered them.  Transaction points
+ *  are still synchronous for red_fsync(), red_transact(), unmount, and when the
+ *  volume is full; red_transactwait() commits any deferred transaction point.
+ *  If the commit task fails a transaction point, it stays pending until
+ *  red_transactwait() or red_transact() commits it and reports the error.  The
+ *  commit task counts toward REDCONF_TASK_COUNT.
+ */
+#ifndef REDCONF_TRANSACT_BACKGROUND
+    #define REDCONF_TRANSACT_BACKGROUND    0
+#endif
+
+/** With background transactions, the number of buffers dirtied since the last
+ *  transaction point at which the commit task is woken, even if no automatic
+ *  transaction event has occurred.  Keeps the buffer cache from filling with
+ *  dirty buffers which foreground tasks would have to write out.  Ignored while
+ *  a volume's transaction mask is #RED_TRANSACT_MANUAL.  Zero disables the
+ *  watermark.
+ */
+#ifndef REDCONF_TRANSACT_WATERMARK
+    #define REDCONF_TRANSACT_WATERMARK    ( REDCONF_BUFFER_COUNT / 2U )
+#endif
+
+/** Whether every CRC algorithm is compiled, rather than only the one selected
+ *  by REDCONF_CRC_ALGORITHM, so that the CRC benchmark can compare them.  This
+ *  adds about 30 KB of tables and code; it is meant for host and evaluation
+ *  builds.
+ */
+#ifndef REDCONF_CRC_BENCHMARK
+    #define REDCONF_CRC_BENCHMARK    0
+#endif
+
+/** Maximum number of read leases, from red_readlease(), which may be
+ *  outstanding at once.  Each lease holds a block buffer until it is released,
+ *  so REDCONF_BUFFER_COUNT must allow for them.  Zero disables read leases.
+ */
+#ifndef REDCONF_READ_LEASES
+    #define REDCONF_READ_LEASES    0
+#endif
+
+/** Number of extents of freed blocks which are remembered between transaction
+ *  points, so that the block device can be told (via RedOsBDevDiscard()) that
+ *  they are no longer in use once the transaction point which frees them has
+ *  been committed.  Adjacent blocks share an extent; blocks freed once every
+ *  extent is in use are not discarded.  Zero disables discards.
+ */
+#ifndef REDCONF_DISCARD_EXTENTS
+    #define REDCONF_DISCARD_EXTENTS    0
+#endif
+
+/** Whether to collect statistics, retrieved with red_getstats(): call counts
+ *  and latency histograms for the POSIX-like API, block device request counts,
+ *  and transaction point durations.  Timing each call costs two calls to
+ *  RedOsTimestamp(), and the statistics take about 2.5 KB of RAM.
+ *
+ *  The configuration utility does not generate this option, so a project which
+ *  wants statistics defines it to 1 in its compiler preprocessor definitions,
+ *  as the Windows simulator demo does, rather than editing redconf.h.
+ */
+#ifndef REDCONF_STATISTICS
+    #define REDCONF_STATISTICS    0
+#endif
+
+/** Whether each transaction point saves the allocation summary (which regions
+ *  of the volume have no free blocks) in spare space at the end of the
+ *  metaroot, so that after a mount the allocator can skip the full regions
+ *  right away, rather than reading imap nodes to rediscover them.  The summary
+ *  is covered by the metaroot CRC and is ignored if it was not written with
+ *  the metaroot; volumes remain compatible with drivers which lack this option.
+ */
+#ifndef REDCONF_FAST_MOUNT
+    #define REDCONF_FAST_MOUNT    0
+#endif
+
+/** Whether the data of small files is stored in the inode, in the space which
+ *  otherwise holds block pointers, rather than in a data block.  Updating such
+ *  a file writes only the inode.  A file moves to a data block when it grows
+ *  beyond the space available in the inode, and moves back into the inode when
+ *  it is truncated to zero.  Volumes formatted with this option cannot be
+ *  mounted by drivers without it, and vice versa.
+ */
+#ifndef REDCONF_INODE_INLINE_DATA
+    #define REDCONF_INODE_INLINE_DATA    0
+#endif
+
+/** Maximum number of snapshots, from red_snapopen(), which may be open at once.
+ *  A snapshot is a read-only view of a file as of the last transaction point,
+ *  read with red_snapread() straight from the block device, without the FS
+ *  mutex, so that it never waits for writers.  Each snapshot costs about three
+ *  blocks of RAM.  The block device must allow a read to run concurrently
+ *  with other requests to it.  Zero disables snapshots.
+ */
+#ifndef REDCONF_SNAPSHOTS
+    #define REDCONF_SNAPSHOTS    0
+#endif
+
+/** With snapshots, the number of extents of blocks, freed from files with open
+ *  snapshots, which are kept from being reallocated until every snapshot of
+ *  the volume is closed.  Adjacent blocks share an extent.  If a block is freed
+ *  once every extent is in use, the open snapshots of the volume are made
+ *  stale, and further reads from them fail with #RED_ESTALE.
+ */
+#ifndef REDCONF_SNAPSHOT_EXTENTS
+    #define REDCONF_SNAPSHOT_EXTENTS    16
+#endif
+
 
 #if ( REDCONF_READ_ONLY != 0 ) && ( REDCONF_READ_ONLY != 1 )
     #error "Configuration error: REDCONF_READ_ONLY must be either 0 or 1"
@@ -334,6 +538,118 @@
     #error "REDCONF_BUFFER_COUNT cannot be greater than 255"
 #endif
 
+#if ( REDCONF_BUFFER_HASH != 0 ) && ( REDCONF_BUFFER_HASH != 1 )
+    #error "Configuration error: REDCONF_BUFFER_HASH must be either 0 or 1."
+#endif
+
+#if ( REDCONF_BUFFER_WRITE_GATHER < 0 ) || ( REDCONF_BUFFER_WRITE_GATHER > REDCONF_BUFFER_COUNT )
+    #error "Configuration error: REDCONF_BUFFER_WRITE_GATHER must be between 0 and REDCONF_BUFFER_COUNT."
+#endif
+
+#if ( REDCONF_READ_AHEAD_BLOCKS < 0 ) || ( REDCONF_READ_AHEAD_BLOCKS > ( REDCONF_BUFFER_COUNT / 2U ) )
+    #error "Configuration error: REDCONF_READ_AHEAD_BLOCKS must be between 0 and half of REDCONF_BUFFER_COUNT."
+#endif
+
+#if ( REDCONF_BUFFER_ALIGNMENT < 8U ) || ( REDCONF_BUFFER_ALIGNMENT > REDCONF_BLOCK_SIZE ) || ( ( REDCONF_BUFFER_ALIGNMENT & ( REDCONF_BUFFER_ALIGNMENT - 1U ) ) != 0U )
+    #error "Configuration error: REDCONF_BUFFER_ALIGNMENT must be a power of two between 8 and REDCONF_BLOCK_SIZE."
+#endif
+
+#if ( REDCONF_DIR_INDEX_DIRS < 0 ) || ( REDCONF_DIR_INDEX_DIRS > 255 )
+    #error "Configuration error: REDCONF_DIR_INDEX_DIRS must be between 0 and 255."
+#endif
+
+#if ( REDCONF_DIR_INDEX_DIRS > 0 ) && ( REDCONF_API_POSIX == 0 )
+    #error "Configuration error: REDCONF_DIR_INDEX_DIRS must be 0 when REDCONF_API_POSIX is 0."
+#endif
+
+#if ( REDCONF_DIR_INDEX_ENTRIES < 4 ) || ( REDCONF_DIR_INDEX_ENTRIES > 65536 )
+    #error "Configuration error: REDCONF_DIR_INDEX_ENTRIES must be between 4 and 65536."
+#endif
+
+#if ( REDCONF_DENTRY_CACHE_ENTRIES < 0 ) || ( REDCONF_DENTRY_CACHE_ENTRIES > 65535 )
+    #error "Configuration error: REDCONF_DENTRY_CACHE_ENTRIES must be between 0 and 65535."
+#endif
+
+#if ( REDCONF_DENTRY_CACHE_ENTRIES > 0 ) && ( REDCONF_API_POSIX == 0 )
+    #error "Configuration error: REDCONF_DENTRY_CACHE_ENTRIES must be 0 when REDCONF_API_POSIX is 0."
+#endif
+
+#if ( REDCONF_INODE_CACHE_ENTRIES < 0 ) || ( REDCONF_INODE_CACHE_ENTRIES > 65535 )
+    #error "Configuration error: REDCONF_INODE_CACHE_ENTRIES must be between 0 and 65535."
+#endif
+
+#if ( REDCONF_FINE_LOCKING != 0 ) && ( REDCONF_FINE_LOCKING != 1 )
+    #error "Configuration error: REDCONF_FINE_LOCKING must be either 0 or 1."
+#endif
+
+#if ( REDCONF_FINE_LOCKING == 1 ) && ( ( REDCONF_TASK_COUNT < 2U ) || ( REDCONF_API_POSIX == 0 ) )
+    #error "Configuration error: REDCONF_FINE_LOCKING requires REDCONF_TASK_COUNT > 1 and REDCONF_API_POSIX == 1."
+#endif
+
+#if ( REDCONF_TRANSACT_BACKGROUND != 0 ) && ( REDCONF_TRANSACT_BACKGROUND != 1 )
+    #error "Configuration error: REDCONF_TRANSACT_BACKGROUND must be either 0 or 1."
+#endif
+
+#if ( REDCONF_TRANSACT_BACKGROUND == 1 ) && ( ( REDCONF_READ_ONLY == 1 ) || ( REDCONF_TASK_COUNT < 2U ) || ( REDCONF_API_POSIX == 0 ) )
+    #error "Configuration error: REDCONF_TRANSACT_BACKGROUND requires REDCONF_READ_ONLY == 0, REDCONF_TASK_COUNT > 1, and REDCONF_API_POSIX == 1."
+#endif
+
+#if REDCONF_TRANSACT_WATERMARK < 0
+    #error "Configuration error: REDCONF_TRANSACT_WATERMARK must not be negative."
+#endif
+
+#if ( REDCONF_CRC_BENCHMARK != 0 ) && ( REDCONF_CRC_BENCHMARK != 1 )
+    #error "Configuration error: REDCONF_CRC_BENCHMARK must be either 0 or 1."
+#endif
+
+#if ( REDCONF_READ_LEASES < 0 ) || ( REDCONF_READ_LEASES > 16U )
+    #error "Configuration error: REDCONF_READ_LEASES must be between 0 and 16."
+#endif
+
+#if ( REDCONF_READ_LEASES > 0U ) && ( REDCONF_API_POSIX == 0 )
+    #error "Configuration error: REDCONF_READ_LEASES requires REDCONF_API_POSIX == 1."
+#endif
+
+#if ( REDCONF_DISCARD_EXTENTS < 0 ) || ( REDCONF_DISCARD_EXTENTS > 255U )
+    #error "Configuration error: REDCONF_DISCARD_EXTENTS must be between 0 and 255."
+#endif
+
+#if ( REDCONF_DISCARD_EXTENTS > 0U ) && ( REDCONF_READ_ONLY == 1 )
+    #error "Configuration error: REDCONF_DISCARD_EXTENTS must be 0 when REDCONF_READ_ONLY is 1."
+#endif
+
+#if ( REDCONF_STATISTICS != 0 ) && ( REDCONF_STATISTICS != 1 )
+    #error "Configuration error: REDCONF_STATISTICS must be either 0 or 1."
+#endif
+
+#if ( REDCONF_STATISTICS == 1 ) && ( REDCONF_API_POSIX == 0 )
+    #error "Configuration error: REDCONF_STATISTICS requires REDCONF_API_POSIX == 1."
+#endif
+
+#if ( REDCONF_FAST_MOUNT != 0 ) && ( REDCONF_FAST_MOUNT != 1 )
+    #error "Configuration error: REDCONF_FAST_MOUNT must be either 0 or 1."
+#endif
+
+#if ( REDCONF_FAST_MOUNT == 1 ) && ( REDCONF_READ_ONLY == 1 )
+    #error "Configuration error: REDCONF_FAST_MOUNT must be 0 when REDCONF_READ_ONLY is 1."
+#endif
+
+#if ( REDCONF_INODE_INLINE_DATA != 0 ) && ( REDCONF_INODE_INLINE_DATA != 1 )
+    #error "Configuration error: REDCONF_INODE_INLINE_DATA must be either 0 or 1."
+#endif
+
+#if ( REDCONF_SNAPSHOTS < 0 ) || ( REDCONF_SNAPSHOTS > 255U )
+    #error "Configuration error: REDCONF_SNAPSHOTS must be between 0 and 255."
+#endif
+
+#if ( REDCONF_SNAPSHOTS > 0U ) && ( ( REDCONF_FINE_LOCKING == 0 ) || ( REDCONF_READ_ONLY == 1 ) )
+    #error "Configuration error: REDCONF_SNAPSHOTS requires REDCONF_FINE_LOCKING == 1 and REDCONF_READ_ONLY == 0."
+#endif
+
+#if ( REDCONF_SNAPSHOTS > 0U ) && ( ( REDCONF_SNAPSHOT_EXTENTS < 1 ) || ( REDCONF_SNAPSHOT_EXTENTS > 255U ) )
+    #error "Configuration error: REDCONF_SNAPSHOT_EXTENTS must be between 1 and 255."
+#endif
+
 #if ( REDCONF_IMAGE_BUILDER != 0 ) && ( REDCONF_IMAGE_BUILDER != 1 )
     #error "Configuration error: REDCONF_IMAGE_BUILDER must be either 0 or 1."
 #endif
@@ -31,6 +31,7 @@
 
 
 #include <redstat.h>
+#include <rediovec.h>
 
 
 REDSTATUS RedCoreInit( void );
@@ -48,10 +49,26 @@ REDSTATUS RedCoreVolMount( void );
 REDSTATUS RedCoreVolUnmount( void );
 #if REDCONF_READ_ONLY == 0
     REDSTATUS RedCoreVolTransact( void );
+    REDSTATUS RedCoreVolTransactAuto( void );
+#endif
+#if REDCONF_TRANSACT_BACKGROUND == 1
+    REDSTATUS RedCoreVolTransactPending( void );
 #endif
 #if REDCONF_API_POSIX == 1
     REDSTATUS RedCoreVolStat( REDSTATFS * pStatFS );
 #endif
+REDSTATUS RedCoreBufferStat( REDBUFSTAT * pStat,
+                             bool fReset );
+#if REDCONF_STATISTICS == 1
+    void RedCoreStatOp( uint8_t bOp,
+                        REDTIMESTAMP tsStart,
+                        REDSTATUS iResult );
+    REDSTATUS RedCoreStats( REDSTATS * pStats,
+                            bool fReset );
+#endif
+#if REDCONF_FINE_LOCKING == 1
+    void RedCoreUnlockedReads( bool fEnable );
+#endif
 
 #if ( REDCONF_READ_ONLY == 0 ) && ( ( REDCONF_API_POSIX == 1 ) || ( REDCONF_API_FSE_TRANSMASKSET == 1 ) )
     REDSTATUS RedCoreTransMaskSet( uint32_t ulEventMask );
@@ -99,16 +116,48 @@ REDSTATUS RedCoreFileRead( uint32_t ulInode,
                            uint64_t ullStart,
                            uint32_t * pulLen,
                            void * pBuffer );
+REDSTATUS RedCoreFileReadv( uint32_t ulInode,
+                            uint64_t ullStart,
+                            const REDIOVEC * paIov,
+                            uint32_t ulIovCount,
+                            uint32_t * pulLen );
+#if REDCONF_READ_LEASES > 0U
+    REDSTATUS RedCoreFileLease( uint32_t ulInode,
+                                uint64_t ullStart,
+                                uint32_t * pulLen,
+                                const void ** ppData );
+    REDSTATUS RedCoreLeaseRelease( const void * pData );
+#endif
 #if REDCONF_READ_ONLY == 0
     REDSTATUS RedCoreFileWrite( uint32_t ulInode,
                                 uint64_t ullStart,
                                 uint32_t * pulLen,
                                 const void * pBuffer );
+    REDSTATUS RedCoreFileWritev( uint32_t ulInode,
+                                 uint64_t ullStart,
+                                 const REDIOVEC * paIov,
+                                 uint32_t ulIovCount,
+                                 uint32_t * pulLen );
 #endif
 #if TRUNCATE_SUPPORTED
     REDSTATUS RedCoreFileTruncate( uint32_t ulInode,
                                    uint64_t ullSize );
 #endif
+#if REDCONF_READ_ONLY == 0
+    REDSTATUS RedCoreFileAllocate( uint32_t ulInode,
+                                   uint64_t ullStart,
+                                   uint64_t ullLen );
+#endif
+#if REDCONF_SNAPSHOTS > 0U
+    REDSTATUS RedCoreSnapOpen( uint32_t ulInode,
+                               uint32_t * pulSnap,
+                               uint64_t * pullSequence );
+    REDSTATUS RedCoreSnapRead( uint32_t ulSnap,
+                               uint64_t ullStart,
+                               uint32_t * pulLen,
+                               void * pBuffer );
+    REDSTATUS RedCoreSnapClose( uint32_t ulSnap );
+#endif
 
 #if ( REDCONF_API_POSIX == 1 ) && ( REDCONF_API_POSIX_READDIR == 1 )
     REDSTATUS RedCoreDirRead( uint32_t ulInode,
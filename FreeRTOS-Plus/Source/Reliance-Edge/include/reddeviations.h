@@ -132,7 +132,7 @@
 #define CAST_VOID_PTR_PTR( PTRPTR )    ( ( void ** ) ( PTRPTR ) )
 
 
-/** @brief Create a two-dimensional byte array which is safely aligned.
+/** @brief Create a byte array which is safely aligned.
  *
  *  Usages of this macro deviate from MISRA C:2012 Rule 19.2 (advisory).
  *  A union is required to force alignment of the block buffers, which are used
@@ -142,12 +142,12 @@
  *  and the PC-Lint error inhibition option are the only records of the
  *  deviation.
  */
-#define ALIGNED_2D_BYTE_ARRAY( un, nam, size1, size2 ) \
-    union                                              \
-    {                                                  \
-        uint8_t nam[ size1 ][ size2 ];                 \
-        uint64_t DummyAlign;                           \
-    }                                                  \
+#define ALIGNED_BYTE_ARRAY( un, nam, size ) \
+    union                                   \
+    {                                       \
+        uint8_t nam[ size ];                \
+        uint64_t DummyAlign;                \
+    }                                       \
     un
 
 
@@ -193,8 +193,8 @@
  *  A pointer is aligned if its address is an even multiple of
  *  ::REDCONF_ALIGNMENT_SIZE.
  *
- *  This is used in the slice-by-8 RedCrc32Update() function, which needs to
- *  know whether a pointer is aligned, since the slice-by-8 algorithm needs to
+ *  This is used in the slice-by-8, slice-by-16, and hardware CRC functions,
+ *  which need to know whether a pointer is aligned, since those algorithms
  *  access the memory in an aligned fashion, and if the pointer is not aligned,
  *  this can result in faults or suboptimal performance (depending on platform).
  *
@@ -223,4 +223,121 @@
 #define IS_ALIGNED_PTR( ptr )    ( ( ( uintptr_t ) ( ptr ) & ( REDCONF_ALIGNMENT_SIZE - 1U ) ) == 0U )
 
 
+/** @brief Compute the distance in bytes from one pointer to another.
+ *
+ *  This is used by the block buffer module, when the buffer hash index is
+ *  enabled and when a read lease is released, to derive the index of a buffer
+ *  from its address in constant time rather than comparing the pointer against
+ *  every buffer in turn.
+ *
+ *  Usages of this macro deviate from MISRA C:2012 Rule 11.4 (advisory), for
+ *  the reasons given in the description of IS_ALIGNED_PTR().  The difference
+ *  is only used as a candidate index (and, for a lease, offset), which is then
+ *  confirmed by comparing the original pointer for equality with the address
+ *  it gives, so an implementation-defined result cannot cause the wrong buffer
+ *  to be used.
+ *
+ *  As Rule 11.4 is advisory, a deviation record is not required.  This notice
+ *  and the PC-Lint error inhibition option are the only records of the
+ *  deviation.
+ */
+#define PTR_BYTE_DISTANCE( ptr, base )    ( ( uintptr_t ) ( ptr ) - ( uintptr_t ) ( base ) )
+
+
+/** @brief The machine word used by the default memory functions.
+ *
+ *  The default memory functions copy, fill, and compare a word at a time when
+ *  the buffers are aligned with each other.  The buffers hold objects of any
+ *  type, and accessing an object through an lvalue of an incompatible type,
+ *  such as uintptr_t, is undefined behavior (C99 6.5p7): an optimizing
+ *  compiler may reorder or remove such accesses.  A word type is used only
+ *  where the compiler is known to let it alias other types:
+ *
+ *  - GCC and compatible compilers (such as Clang): uintptr_t with the
+ *    may_alias attribute, which exempts it from type-based alias analysis just
+ *    like a character type.
+ *  - Microsoft Visual C: plain uintptr_t, since that compiler does not perform
+ *    type-based alias analysis.
+ *
+ *  Elsewhere the word is a uint8_t, and the memory functions work a byte at a
+ *  time.
+ *
+ *  Usages of the attribute deviate from MISRA C:2012 Rule 1.2 (advisory),
+ *  which prohibits language extensions.  As Rule 1.2 is advisory, a deviation
+ *  record is not required.  This notice is the only record of the deviation.
+ */
+#if defined( __GNUC__ )
+    typedef uintptr_t __attribute__( ( __may_alias__ ) ) REDMEMWORD;
+#elif defined( _MSC_VER )
+    typedef uintptr_t REDMEMWORD;
+#else
+    typedef uint8_t REDMEMWORD;
+#endif
+
+
+/** @brief Compute how far a pointer is past the last machine word boundary.
+ *
+ *  This is used by the default memory functions, which copy, fill, and compare
+ *  a machine word (a ::REDMEMWORD) at a time when the pointers are aligned, or
+ *  can be made aligned, with each other.
+ *
+ *  Usages of this macro deviate from MISRA C:2012 Rule 11.4 (advisory), for
+ *  the reasons given in the description of IS_ALIGNED_PTR().
+ *
+ *  As Rule 11.4 is advisory, a deviation record is not required.  This notice
+ *  and the PC-Lint error inhibition option are the only records of the
+ *  deviation.
+ */
+#define PTR_WORD_OFFSET( ptr )    ( ( uintptr_t ) ( ptr ) & ( sizeof( REDMEMWORD ) - 1U ) )
+
+
+/** @brief Compute how many bytes a pointer must be advanced to align it.
+ *
+ *  This is used by the block buffer module to align the block buffers to
+ *  REDCONF_BUFFER_ALIGNMENT, which may exceed any alignment that can be
+ *  portably requested of the compiler.  @p align must be a power of two.
+ *
+ *  Usages of this macro deviate from MISRA C:2012 Rule 11.4 (advisory), for
+ *  the reasons given in the description of IS_ALIGNED_PTR().
+ *
+ *  As Rule 11.4 is advisory, a deviation record is not required.  This notice
+ *  and the PC-Lint error inhibition option are the only records of the
+ *  deviation.
+ */
+#define PTR_ALIGN_PAD( ptr, align )    ( ( ( uintptr_t ) 0U - ( uintptr_t ) ( ptr ) ) & ( ( uintptr_t ) ( align ) - 1U ) )
+
+
+/** @brief Cast a byte pointer to a ::REDMEMWORD pointer.
+ *
+ *  Usages of this macro deviate from MISRA C:2012 Rule 11.5 (advisory), for
+ *  the reasons given in the description of CAST_VOID_PTR_TO_UINT8_PTR().  As
+ *  Rule 11.5 is advisory, a deviation record is not required.
+ *
+ *  Usages of this macro also deviate from MISRA C:2012 Rule 11.3 (required),
+ *  which prohibits casts between pointers to different object types.  As Rule
+ *  11.3 is required, this is the deviation record:
+ *
+ *  - Scope: the default memory functions in util/memory.c, and no other code.
+ *  - Reason: copying, filling, and comparing a word at a time is several times
+ *    faster than a byte at a time, and the block buffers are always aligned
+ *    with each other.
+ *  - Alignment: the cast is only applied to pointers which PTR_WORD_OFFSET()
+ *    has shown to be aligned for a ::REDMEMWORD.
+ *  - Aliasing: ::REDMEMWORD is only wider than a byte where the compiler lets
+ *    it alias objects of other types, so the accesses through it are well
+ *    defined.
+ *  - Mitigation: the memory functions can be replaced by defining
+ *    RedMemCpyUnchecked and its siblings in redconf.h, in which case this
+ *    macro is unused.
+ */
+#define CAST_MEMWORD_PTR( PTR )    ( ( REDMEMWORD * ) ( void * ) ( PTR ) )
+
+
+/** @brief Cast a const byte pointer to a const ::REDMEMWORD pointer.
+ *
+ *  See CAST_MEMWORD_PTR(), which includes the deviation record for both.
+ */
+#define CAST_CONST_MEMWORD_PTR( PTR )    ( ( const REDMEMWORD * ) ( const void * ) ( PTR ) )
+
+
 #endif /* ifndef REDDEVIATIONS_H */
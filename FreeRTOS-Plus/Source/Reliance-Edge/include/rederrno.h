@@ -108,6 +108,9 @@ typedef int32_t REDSTATUS;
 /** Too many users. */
 #define RED_EUSERS          87
 
+/** Stale file handle. */
+#define RED_ESTALE          116
+
 /** Nothing will be okay ever again. */
 #define RED_EFUBAR          RED_EINVAL
 
@@ -54,6 +54,7 @@
         #include <redtypes.h>
         #include "redapimacs.h"
         #include "rederrno.h"
+        #include "rediovec.h"
 
 
 /** @brief First valid file number.
@@ -83,18 +84,34 @@
                             uint64_t ullFileOffset,
                             uint32_t ulLength,
                             void * pBuffer );
+        int32_t RedFseReadv( uint8_t bVolNum,
+                             uint32_t ulFileNum,
+                             uint64_t ullFileOffset,
+                             const REDIOVEC * paIov,
+                             uint32_t ulIovCount );
         #if REDCONF_READ_ONLY == 0
             int32_t RedFseWrite( uint8_t bVolNum,
                                  uint32_t ulFileNum,
                                  uint64_t ullFileOffset,
                                  uint32_t ulLength,
                                  const void * pBuffer );
+            int32_t RedFseWritev( uint8_t bVolNum,
+                                  uint32_t ulFileNum,
+                                  uint64_t ullFileOffset,
+                                  const REDIOVEC * paIov,
+                                  uint32_t ulIovCount );
         #endif
         #if ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_API_FSE_TRUNCATE == 1 )
             REDSTATUS RedFseTruncate( uint8_t bVolNum,
                                       uint32_t ulFileNum,
                                       uint64_t ullNewFileSize );
         #endif
+        #if REDCONF_READ_ONLY == 0
+            REDSTATUS RedFseReserve( uint8_t bVolNum,
+                                     uint32_t ulFileNum,
+                                     uint64_t ullFileOffset,
+                                     uint64_t ullLength );
+        #endif
         int64_t RedFseSizeGet( uint8_t bVolNum,
                                uint32_t ulFileNum );
         #if ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_API_FSE_TRANSMASKSET == 1 )
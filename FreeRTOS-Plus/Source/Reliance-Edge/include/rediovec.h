@@ -0,0 +1,47 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Defines the buffer descriptor used by the vectored I/O functions.
+ */
+#ifndef REDIOVEC_H
+#define REDIOVEC_H
+
+
+/** @brief One buffer of a vectored read or write.
+ *
+ *  An array of these describes the buffers of red_readv(), red_writev(),
+ *  RedFseReadv(), or RedFseWritev(), which are filled or drained in order as
+ *  if they were one contiguous buffer.
+ */
+typedef struct
+{
+    void * iov_base;   /**< Start of the buffer.  May be `NULL` only if iov_len is zero. */
+    uint32_t iov_len;  /**< Length of the buffer, in bytes. */
+} REDIOVEC;
+
+
+#endif /* ifndef REDIOVEC_H */
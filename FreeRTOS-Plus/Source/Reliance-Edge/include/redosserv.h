@@ -57,6 +57,11 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
                               const void * pBuffer );
     REDSTATUS RedOsBDevFlush( uint8_t bVolNum );
 #endif
+#if REDCONF_DISCARD_EXTENTS > 0U
+    REDSTATUS RedOsBDevDiscard( uint8_t bVolNum,
+                                uint64_t ullSectorStart,
+                                uint32_t ulSectorCount );
+#endif
 
 /*  Non-standard API: for host machines only.
  */
@@ -74,6 +79,42 @@ REDSTATUS RedOsBDevConfig( uint8_t bVolNum,
     uint32_t RedOsTaskId( void );
 #endif
 
+#if REDCONF_FINE_LOCKING == 1
+
+/*  Semaphores used for fine-grained locking.  RED_SEM_IO_SLOT and
+ *  RED_SEM_IO_DONE coordinate a block device read which is waited on with the
+ *  FS mutex released.  Reader/writer lock number n, where n is a volume number
+ *  or REDCONF_VOLUME_COUNT for the driver as a whole, is built from a pair of
+ *  semaphores: one holding a token for each task which can share the lock, and
+ *  one serializing the tasks which acquire the lock exclusively.
+ *  RED_SEM_STATS protects the block device statistics, since such a read is
+ *  counted without the FS mutex.
+ */
+    #define RED_SEM_IO_SLOT               0U
+    #define RED_SEM_IO_DONE               1U
+    #define RED_SEM_LOCK_TOKENS( n )      ( ( uint8_t ) ( 2U + ( ( uint32_t ) ( n ) * 2U ) ) )
+    #define RED_SEM_LOCK_WRITER( n )      ( ( uint8_t ) ( 3U + ( ( uint32_t ) ( n ) * 2U ) ) )
+    #if REDCONF_STATISTICS == 1
+        #define RED_SEM_STATS             ( ( uint8_t ) ( 2U + ( ( REDCONF_VOLUME_COUNT + 1U ) * 2U ) ) )
+        #define RED_SEM_COUNT             ( 3U + ( ( REDCONF_VOLUME_COUNT + 1U ) * 2U ) )
+    #else
+        #define RED_SEM_COUNT             ( 2U + ( ( REDCONF_VOLUME_COUNT + 1U ) * 2U ) )
+    #endif
+
+    REDSTATUS RedOsSemaphoreInit( uint8_t bSem,
+                                  uint32_t ulCount );
+    REDSTATUS RedOsSemaphoreUninit( uint8_t bSem );
+    bool RedOsSemaphoreTake( uint8_t bSem,
+                             bool fWait );
+    void RedOsSemaphoreGive( uint8_t bSem );
+#endif /* REDCONF_FINE_LOCKING == 1 */
+
+#if REDCONF_TRANSACT_BACKGROUND == 1
+    REDSTATUS RedOsCommitTaskStart( void ( * pfnCommit )( void ) );
+    void RedOsCommitTaskStop( void );
+    void RedOsCommitTaskWake( void );
+#endif
+
 REDSTATUS RedOsClockInit( void );
 REDSTATUS RedOsClockUninit( void );
 uint32_t RedOsClockGetTime( void );
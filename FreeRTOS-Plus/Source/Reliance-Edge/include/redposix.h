@@ -53,6 +53,7 @@
         #include "redapimacs.h"
         #include "rederrno.h"
         #include "redstat.h"
+        #include "rediovec.h"
 
 /** Open for reading only. */
         #define RED_O_RDONLY    0x00000001U
@@ -146,6 +147,9 @@
         #if REDCONF_READ_ONLY == 0
             int32_t red_transact( const char * pszVolume );
         #endif
+        #if REDCONF_TRANSACT_BACKGROUND == 1
+            int32_t red_transactwait( const char * pszVolume );
+        #endif
         #if REDCONF_READ_ONLY == 0
             int32_t red_settransmask( const char * pszVolume,
                                       uint32_t ulEventMask );
@@ -154,6 +158,10 @@
                                   uint32_t * pulEventMask );
         int32_t red_statvfs( const char * pszVolume,
                              REDSTATFS * pStatvfs );
+        #if REDCONF_STATISTICS == 1
+            int32_t red_getstats( REDSTATS * pStats,
+                                  bool fReset );
+        #endif
         int32_t red_open( const char * pszPath,
                           uint32_t ulOpenMode );
         #if ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_API_POSIX_UNLINK == 1 )
@@ -177,10 +185,31 @@
         int32_t red_read( int32_t iFildes,
                           void * pBuffer,
                           uint32_t ulLength );
+        int32_t red_readv( int32_t iFildes,
+                           const REDIOVEC * paIov,
+                           uint32_t ulIovCount );
+        #if REDCONF_READ_LEASES > 0U
+            int32_t red_readlease( int32_t iFildes,
+                                   uint32_t ulLength,
+                                   const void ** ppData );
+            int32_t red_leaserelease( const void * pData );
+        #endif
+        #if REDCONF_SNAPSHOTS > 0U
+            int32_t red_snapopen( const char * pszPath,
+                                  uint64_t * pullSequence );
+            int32_t red_snapread( int32_t iSnap,
+                                  uint64_t ullOffset,
+                                  void * pBuffer,
+                                  uint32_t ulLength );
+            int32_t red_snapclose( int32_t iSnap );
+        #endif
         #if REDCONF_READ_ONLY == 0
             int32_t red_write( int32_t iFildes,
                                const void * pBuffer,
                                uint32_t ulLength );
+            int32_t red_writev( int32_t iFildes,
+                                const REDIOVEC * paIov,
+                                uint32_t ulIovCount );
         #endif
         #if REDCONF_READ_ONLY == 0
             int32_t red_fsync( int32_t iFildes );
@@ -192,6 +221,11 @@
             int32_t red_ftruncate( int32_t iFildes,
                                    uint64_t ullSize );
         #endif
+        #if REDCONF_READ_ONLY == 0
+            int32_t red_fallocate( int32_t iFildes,
+                                   uint64_t ullOffset,
+                                   uint64_t ullLen );
+        #endif
         int32_t red_fstat( int32_t iFildes,
                            REDSTAT * pStat );
         #if REDCONF_API_POSIX_READDIR == 1
@@ -92,4 +92,106 @@ typedef struct
 } REDSTATFS;
 
 
+/** @brief Block buffer cache statistics.
+ *
+ *  A hit is a request for a block which was already buffered; a miss is a
+ *  request which required the block to be read from disk.  Requests for newly
+ *  allocated blocks, which are zeroed rather than read, are neither.
+ */
+typedef struct
+{
+    uint32_t ulMetaHits;        /**< Metadata block requests satisfied from the cache. */
+    uint32_t ulMetaMisses;      /**< Metadata block requests which read the disk. */
+    uint32_t ulDataHits;        /**< File data block requests satisfied from the cache. */
+    uint32_t ulDataMisses;      /**< File data block requests which read the disk. */
+    uint32_t ulEvictions;       /**< Valid blocks evicted to make room for another block. */
+    uint32_t ulWritebacks;      /**< Evictions which required a dirty block to be written. */
+    uint32_t ulFlushWrites;     /**< Write requests issued to flush dirty blocks, as at a transaction point. */
+    uint32_t ulFlushBlocks;     /**< Dirty blocks written by those requests. */
+    uint32_t ulReadAheadBlocks; /**< Blocks read into the cache ahead of a sequential reader. */
+} REDBUFSTAT;
+
+
+/** Number of buckets in a latency histogram. */
+#define RED_STAT_HIST_BUCKETS    20U
+
+/** @brief Latency statistics for one kind of operation.
+ *
+ *  Bucket zero of the histogram counts operations which took less than one
+ *  microsecond; bucket n counts those which took at least 2^(n-1) but less than
+ *  2^n microseconds; and the last bucket also counts anything longer.  The
+ *  latencies are only as precise as RedOsTimestamp(), which may count ticks of
+ *  the OS clock.
+ */
+typedef struct
+{
+    uint32_t ulCount;                          /**< Number of operations. */
+    uint32_t ulErrors;                         /**< Operations which failed. */
+    uint64_t ullTotalUsecs;                    /**< Total time taken, in microseconds. */
+    uint32_t ulMaxUsecs;                       /**< Longest time taken, in microseconds. */
+    uint32_t aulHist[ RED_STAT_HIST_BUCKETS ]; /**< Histogram of the time taken. */
+} REDLATSTAT;
+
+
+/** @brief Block device request statistics.
+ *
+ *  Requests are counted once, no matter how many times they are retried.
+ */
+typedef struct
+{
+    uint32_t ulReads;         /**< Read requests. */
+    uint64_t ullReadBytes;    /**< Bytes read. */
+    uint32_t ulWrites;        /**< Write requests. */
+    uint64_t ullWriteBytes;   /**< Bytes written. */
+    uint32_t ulFlushes;       /**< Flush requests. */
+    uint32_t ulDiscards;      /**< Discard requests. */
+    uint64_t ullDiscardBytes; /**< Bytes discarded. */
+} REDIOSTAT;
+
+
+/*  Operations timed by the statistics, indexing REDSTATS::aOp.  Vectored and
+ *  leased reads and vectored writes count with their plain counterparts.
+ */
+#define RED_STATOP_MOUNT        0U  /**< red_mount() */
+#define RED_STATOP_UMOUNT       1U  /**< red_umount() */
+#define RED_STATOP_FORMAT       2U  /**< red_format() */
+#define RED_STATOP_TRANSACT     3U  /**< red_transact() */
+#define RED_STATOP_STATVFS      4U  /**< red_statvfs() */
+#define RED_STATOP_OPEN         5U  /**< red_open() */
+#define RED_STATOP_UNLINK       6U  /**< red_unlink() */
+#define RED_STATOP_MKDIR        7U  /**< red_mkdir() */
+#define RED_STATOP_RMDIR        8U  /**< red_rmdir() */
+#define RED_STATOP_RENAME       9U  /**< red_rename() */
+#define RED_STATOP_LINK         10U /**< red_link() */
+#define RED_STATOP_CLOSE        11U /**< red_close() */
+#define RED_STATOP_READ         12U /**< red_read(), red_readv(), red_readlease() */
+#define RED_STATOP_WRITE        13U /**< red_write(), red_writev() */
+#define RED_STATOP_FSYNC        14U /**< red_fsync() */
+#define RED_STATOP_LSEEK        15U /**< red_lseek() */
+#define RED_STATOP_FTRUNCATE    16U /**< red_ftruncate() */
+#define RED_STATOP_FSTAT        17U /**< red_fstat() */
+#define RED_STATOP_OPENDIR      18U /**< red_opendir() */
+#define RED_STATOP_READDIR      19U /**< red_readdir() */
+#define RED_STATOP_CLOSEDIR     20U /**< red_closedir() */
+#define RED_STATOP_FALLOCATE    21U /**< red_fallocate() */
+#define RED_STATOP_COUNT        22U /**< Number of timed operations. */
+
+
+/** @brief File system statistics, from red_getstats().
+ *
+ *  An API call is only counted if it gets as far as entering the file system
+ *  driver; calls rejected for invalid parameters beforehand are not.  The
+ *  statistics are driver-wide, not specific to any volume.
+ */
+typedef struct
+{
+    REDLATSTAT aOp[ RED_STATOP_COUNT ]; /**< API calls, indexed by RED_STATOP_* value. */
+    REDLATSTAT transact;                /**< Transaction points, including automatic ones. */
+    REDIOSTAT io;                       /**< Block device requests. */
+    REDBUFSTAT buf;                     /**< Block buffer cache. */
+    uint32_t ulLastMountUsecs;          /**< Time taken by the last successful red_mount(), in microseconds. */
+    uint32_t ulSummaryMounts;           /**< Mounts which loaded the allocation summary saved by REDCONF_FAST_MOUNT. */
+} REDSTATS;
+
+
 #endif /* ifndef REDSTAT_H */
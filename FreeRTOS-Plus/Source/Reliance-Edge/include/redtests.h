@@ -47,6 +47,30 @@
       && ( REDCONF_API_POSIX_RMDIR == 1 ) && ( REDCONF_API_POSIX_RENAME == 1 ) && ( REDCONF_API_POSIX_LINK == 1 ) \
       && ( REDCONF_API_POSIX_FTRUNCATE == 1 ) && ( REDCONF_API_POSIX_READDIR == 1 ) )
 
+#define MTBENCH_SUPPORTED                                                                    \
+    ( ( ( RED_KIT == RED_KIT_GPL ) || ( RED_KIT == RED_KIT_SANDBOX ) )                       \
+      && ( REDCONF_OUTPUT == 1 ) && ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_API_POSIX == 1 ) \
+      && ( REDCONF_API_POSIX_UNLINK == 1 ) && ( REDCONF_TASK_COUNT > 1U ) )
+
+#define TRANSTEST_SUPPORTED                                                                  \
+    ( ( ( RED_KIT == RED_KIT_GPL ) || ( RED_KIT == RED_KIT_SANDBOX ) )                       \
+      && ( REDCONF_OUTPUT == 1 ) && ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_API_POSIX == 1 ) \
+      && ( REDCONF_API_POSIX_UNLINK == 1 ) && ( REDCONF_API_POSIX_FTRUNCATE == 1 ) )
+
+#define SNAPTEST_SUPPORTED                                                                   \
+    ( ( ( RED_KIT == RED_KIT_GPL ) || ( RED_KIT == RED_KIT_SANDBOX ) )                       \
+      && ( REDCONF_OUTPUT == 1 ) && ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_API_POSIX == 1 ) \
+      && ( REDCONF_API_POSIX_UNLINK == 1 ) && ( REDCONF_API_POSIX_FTRUNCATE == 1 )           \
+      && ( REDCONF_SNAPSHOTS > 0U ) )
+
+#define CRCBENCH_SUPPORTED                                             \
+    ( ( ( RED_KIT == RED_KIT_GPL ) || ( RED_KIT == RED_KIT_SANDBOX ) ) \
+      && ( REDCONF_OUTPUT == 1 ) && ( REDCONF_CRC_BENCHMARK == 1 ) )
+
+#define MEMBENCH_SUPPORTED                                             \
+    ( ( ( RED_KIT == RED_KIT_GPL ) || ( RED_KIT == RED_KIT_SANDBOX ) ) \
+      && ( REDCONF_OUTPUT == 1 ) )
+
 #define FSE_STRESS_TEST_SUPPORTED                                                                                          \
     ( ( ( RED_KIT == RED_KIT_COMMERCIAL ) || ( RED_KIT == RED_KIT_SANDBOX ) )                                              \
       && ( REDCONF_OUTPUT == 1 ) && ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_API_FSE == 1 )                                 \
@@ -93,14 +117,24 @@ typedef enum
 
 
 #if FSSTRESS_SUPPORTED
+
+/*  Values for FSSTRESSPARAM::bBench.
+ */
+    #define FSSTRESS_BENCH_NONE        0U /* Stress test, not a benchmark. */
+    #define FSSTRESS_BENCH_METADATA    1U /* Small-file metadata churn. */
+    #define FSSTRESS_BENCH_SEQWRITE    2U /* Large sequential writes. */
+    #define FSSTRESS_BENCH_RANDREAD    3U /* Random reads of existing files. */
+
     typedef struct
     {
-        bool fNoCleanup;  /**< --no-cleanup */
-        uint32_t ulLoops; /**< --loops */
-        uint32_t ulNops;  /**< --nops */
-        bool fNamePad;    /**< --namepad */
-        uint32_t ulSeed;  /**< --seed */
-        bool fVerbose;    /**< --verbose */
+        bool fNoCleanup;   /**< --no-cleanup */
+        uint32_t ulLoops;  /**< --loops */
+        uint32_t ulNops;   /**< --nops */
+        bool fNamePad;     /**< --namepad */
+        uint32_t ulSeed;   /**< --seed */
+        bool fVerbose;     /**< --verbose */
+        uint8_t bBench;    /**< --bench, one of the FSSTRESS_BENCH_* values */
+        uint32_t ulWarmup; /**< --warmup */
     } FSSTRESSPARAM;
 
     PARAMSTATUS FsstressParseParams( int argc,
@@ -112,6 +146,95 @@ typedef enum
     int FsstressStart( const FSSTRESSPARAM * pParam );
 #endif /* if FSSTRESS_SUPPORTED */
 
+#if MTBENCH_SUPPORTED
+    typedef struct
+    {
+        uint32_t ulTasks;    /**< --tasks */
+        uint32_t ulWriters;  /**< --writers */
+        uint32_t ulOps;      /**< --ops */
+        uint32_t ulFileSize; /**< --filesize */
+        uint32_t ulIoSize;   /**< --iosize */
+        uint32_t ulSeed;     /**< --seed */
+    } MTBENCHPARAM;
+
+    PARAMSTATUS MtBenchParseParams( int argc,
+                                    char * argv[],
+                                    MTBENCHPARAM * pParam,
+                                    uint8_t * pbVolNum,
+                                    const char ** ppszDevice );
+    void MtBenchDefaultParams( MTBENCHPARAM * pParam );
+    int MtBenchPrepare( const MTBENCHPARAM * pParam,
+                        uint8_t bVolNum );
+    void MtBenchTask( uint32_t ulTaskIdx );
+    int MtBenchFinish( void );
+#endif /* if MTBENCH_SUPPORTED */
+
+#if TRANSTEST_SUPPORTED
+    typedef struct
+    {
+        const char * pszVolume; /**< Volume path prefix. */
+        uint32_t ulOps;         /**< --ops */
+        uint32_t ulSeed;        /**< --seed */
+    } TRANSTESTPARAM;
+
+    PARAMSTATUS TransTestParseParams( int argc,
+                                      char * argv[],
+                                      TRANSTESTPARAM * pParam,
+                                      uint8_t * pbVolNum,
+                                      const char ** ppszDevice );
+    void TransTestDefaultParams( TRANSTESTPARAM * pParam );
+    int TransTestStart( const TRANSTESTPARAM * pParam );
+#endif /* if TRANSTEST_SUPPORTED */
+
+#if SNAPTEST_SUPPORTED
+    typedef struct
+    {
+        const char * pszVolume; /**< Volume path prefix. */
+        uint32_t ulSeed;        /**< --seed */
+    } SNAPTESTPARAM;
+
+    PARAMSTATUS SnapTestParseParams( int argc,
+                                     char * argv[],
+                                     SNAPTESTPARAM * pParam,
+                                     uint8_t * pbVolNum,
+                                     const char ** ppszDevice );
+    void SnapTestDefaultParams( SNAPTESTPARAM * pParam );
+    int SnapTestStart( const SNAPTESTPARAM * pParam );
+#endif /* if SNAPTEST_SUPPORTED */
+
+#if CRCBENCH_SUPPORTED
+    typedef struct
+    {
+        uint32_t ulMinSize; /**< --min */
+        uint32_t ulMaxSize; /**< --max */
+        uint32_t ulMsecs;   /**< --msecs */
+        uint32_t ulOffset;  /**< --offset */
+    } CRCBENCHPARAM;
+
+    PARAMSTATUS CrcBenchParseParams( int argc,
+                                     char * argv[],
+                                     CRCBENCHPARAM * pParam );
+    void CrcBenchDefaultParams( CRCBENCHPARAM * pParam );
+    int CrcBenchStart( const CRCBENCHPARAM * pParam );
+#endif /* if CRCBENCH_SUPPORTED */
+
+#if MEMBENCH_SUPPORTED
+    typedef struct
+    {
+        uint32_t ulSize;   /**< --size */
+        uint32_t ulOffset; /**< --offset */
+        uint32_t ulSkew;   /**< --skew */
+        uint32_t ulMsecs;  /**< --msecs */
+        uint32_t ulMhz;    /**< --mhz */
+    } MEMBENCHPARAM;
+
+    PARAMSTATUS MemBenchParseParams( int argc,
+                                     char * argv[],
+                                     MEMBENCHPARAM * pParam );
+    void MemBenchDefaultParams( MEMBENCHPARAM * pParam );
+    int MemBenchStart( const MEMBENCHPARAM * pParam );
+#endif /* if MEMBENCH_SUPPORTED */
+
 #if STOCH_POSIX_TEST_SUPPORTED
     typedef struct
     {
@@ -203,4 +203,26 @@ void ImgcopyMkdir( const char * pszDir );
 void ImgcopyRecursiveRmdir( const char * pszDir );
 
 
+/*  For the parallel image checker tool
+ */
+
+typedef struct
+{
+    const char * pszImage;  /* Path of the volume image to check. */
+    const char * pszReport; /* Path of the report file; NULL for stdout. */
+    uint32_t ulThreads;     /* Number of worker threads. */
+    uint32_t ulMaxProblems; /* Most problems to list in the report. */
+    bool fProgress;         /* If true, report progress on stderr. */
+} CHKPARAM;
+
+
+/*  Implemented in tools/redchk.c.  ChkParseParams() prints an error message and
+ *  exits on failure; ChkStart() returns the exit code of the tool.
+ */
+void ChkParseParams( int argc,
+                     char * argv[],
+                     CHKPARAM * pParam );
+int ChkStart( const CHKPARAM * pParam );
+
+
 #endif /* REDTOOLS_H */
@@ -62,13 +62,30 @@ void RedStrNCpy( char * pszDst,
                  const char * pszSrc,
                  uint32_t ulLen );
 
+/*  Values for REDCONF_CRC_ALGORITHM.
+ */
+#define CRC_BITWISE      ( 0U )
+#define CRC_SARWATE      ( 1U )
+#define CRC_SLICEBY8     ( 2U )
+#define CRC_SLICEBY16    ( 3U )
+#define CRC_HARDWARE     ( 4U )
+
 uint32_t RedCrc32Update( uint32_t ulInitCrc32,
                          const void * pBuffer,
                          uint32_t ulLength );
 uint32_t RedCrcNode( const void * pBuffer );
+#if REDCONF_CRC_BENCHMARK == 1
+    uint32_t RedCrc32UpdateAlgorithm( uint8_t bAlgorithm,
+                                      uint32_t ulInitCrc32,
+                                      const void * pBuffer,
+                                      uint32_t ulLength );
+    bool RedCrcHardwareAvailable( void );
+#endif
 
 #if REDCONF_API_POSIX == 1
     uint32_t RedNameLen( const char * pszName );
+    uint32_t RedNameHash( const char * pszName,
+                          uint32_t ulNameLen );
 #endif
 
 bool RedBitGet( const uint8_t * pbBitmap,
@@ -77,6 +94,10 @@ void RedBitSet( uint8_t * pbBitmap,
                 uint32_t ulBit );
 void RedBitClear( uint8_t * pbBitmap,
                   uint32_t ulBit );
+uint32_t RedBitFindClear( const uint8_t * pbBitmap1,
+                          const uint8_t * pbBitmap2,
+                          uint32_t ulStart,
+                          uint32_t ulEnd );
 
 #ifdef REDCONF_ENDIAN_SWAP
     uint64_t RedRev64( uint64_t ullToRev );
@@ -104,6 +104,21 @@
  */
 #define BDEV_RAM_DISK                  ( 4U )
 
+/** @brief The memory-mapped image file example implementation.
+ *
+ *  This implementation is for FreeRTOS simulator builds on Linux and other
+ *  POSIX hosts.  Each volume is an image file which is mapped into memory with
+ *  mmap(); unlike the RAM disk, its contents survive the process, and volumes
+ *  can be as large as the host address space allows.  A flush is an msync().
+ *  Killing the process at any point leaves the image as it would be after a
+ *  power loss on a device which completes writes in order, which makes this
+ *  backend suitable for power interruption testing.  A latency can be added
+ *  to each command to approximate the timing of real storage; see
+ *  #BDEV_MMAP_READ_LATENCY_US and related macros for the defaults, and
+ *  RedOsBDevMmapLatencySet() to change them while running.
+ */
+#define BDEV_MMAP_FILE                 ( 5U )
+
 /** @brief Pick which example implementation is compiled.
  *
  *  Must be one of:
@@ -112,8 +127,11 @@
  *  - #BDEV_ATMEL_SDMMC
  *  - #BDEV_STM32_SDIO
  *  - #BDEV_RAM_DISK
+ *  - #BDEV_MMAP_FILE
  */
-#define BDEV_EXAMPLE_IMPLEMENTATION    BDEV_RAM_DISK
+#ifndef BDEV_EXAMPLE_IMPLEMENTATION
+    #define BDEV_EXAMPLE_IMPLEMENTATION    BDEV_RAM_DISK
+#endif
 
 
 static REDSTATUS DiskOpen( uint8_t bVolNum,
@@ -130,6 +148,11 @@ static REDSTATUS DiskRead( uint8_t bVolNum,
                                 const void * pBuffer );
     static REDSTATUS DiskFlush( uint8_t bVolNum );
 #endif
+#if REDCONF_DISCARD_EXTENTS > 0U
+    static REDSTATUS DiskDiscard( uint8_t bVolNum,
+                                  uint64_t ullSectorStart,
+                                  uint32_t ulSectorCount );
+#endif
 
 
 /** @brief Initialize a block device.
@@ -333,6 +356,57 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
 #endif /* REDCONF_READ_ONLY == 0 */
 
 
+#if REDCONF_DISCARD_EXTENTS > 0U
+
+/** @brief Tell the block device that a range of sectors is no longer in use.
+ *
+ *  This is called after a transaction point which frees blocks has been
+ *  committed, so that media with a flash translation layer (eMMC, SD, managed
+ *  NAND) can stop preserving their contents.  The file system never reads
+ *  discarded sectors before writing them again, so their contents afterward
+ *  do not matter.
+ *
+ *  Discarding is advisory: if the block device cannot discard sectors, the
+ *  implementation of this function can do nothing and return success.
+ *
+ *  The behavior of calling this function is undefined if the block device is
+ *  closed or if it was opened with ::BDEV_O_RDONLY.
+ *
+ *  @param bVolNum          The volume number of the volume whose block device
+ *                          is being discarded from.
+ *  @param ullSectorStart   The starting sector number.
+ *  @param ulSectorCount    The number of sectors to discard.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL @p bVolNum is an invalid volume number, or
+ *                      @p ullStartSector and/or @p ulSectorCount refer to an
+ *                      invalid range of sectors.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+    REDSTATUS RedOsBDevDiscard( uint8_t bVolNum,
+                                uint64_t ullSectorStart,
+                                uint32_t ulSectorCount )
+    {
+        REDSTATUS ret;
+
+        if( ( bVolNum >= REDCONF_VOLUME_COUNT ) ||
+            ( ullSectorStart >= gaRedVolConf[ bVolNum ].ullSectorCount ) ||
+            ( ( gaRedVolConf[ bVolNum ].ullSectorCount - ullSectorStart ) < ulSectorCount ) )
+        {
+            ret = -RED_EINVAL;
+        }
+        else
+        {
+            ret = DiskDiscard( bVolNum, ullSectorStart, ulSectorCount );
+        }
+
+        return ret;
+    }
+#endif /* REDCONF_DISCARD_EXTENTS > 0U */
+
+
 #if BDEV_EXAMPLE_IMPLEMENTATION == BDEV_F_DRIVER
 
     #include <api_mdriver.h>
@@ -580,6 +654,46 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
     #endif /* REDCONF_READ_ONLY == 0 */
 
 
+    #if REDCONF_DISCARD_EXTENTS > 0U
+
+/** @brief Discard sectors of a disk.
+ *
+ *  The F_DRIVER interface does not include a discard function, so this does
+ *  nothing.
+ *
+ *  @param bVolNum          The volume number of the volume whose block device
+ *                          is being discarded from.
+ *  @param ullSectorStart   The starting sector number.
+ *  @param ulSectorCount    The number of sectors to discard.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The disk is not open.
+ */
+        static REDSTATUS DiskDiscard( uint8_t bVolNum,
+                                      uint64_t ullSectorStart,
+                                      uint32_t ulSectorCount )
+        {
+            REDSTATUS ret;
+
+            ( void ) ullSectorStart;
+            ( void ) ulSectorCount;
+
+            if( gapFDriver[ bVolNum ] == NULL )
+            {
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                ret = 0;
+            }
+
+            return ret;
+        }
+    #endif /* REDCONF_DISCARD_EXTENTS > 0U */
+
+
 #elif BDEV_EXAMPLE_IMPLEMENTATION == BDEV_FATFS
 
     #include <task.h>
@@ -809,6 +923,66 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
     #endif /* REDCONF_READ_ONLY == 0 */
 
 
+    #if REDCONF_DISCARD_EXTENTS > 0U
+
+/** @brief Discard sectors of a disk.
+ *
+ *  Uses the CTRL_TRIM disk_ioctl() command (CTRL_ERASE_SECTOR in FatFs
+ *  versions before R0.12), which a disk driver that does not support it
+ *  fails with RES_PARERR; that is not treated as an error.
+ *
+ *  @param bVolNum          The volume number of the volume whose block device
+ *                          is being discarded from.
+ *  @param ullSectorStart   The starting sector number.
+ *  @param ulSectorCount    The number of sectors to discard.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+        static REDSTATUS DiskDiscard( uint8_t bVolNum,
+                                      uint64_t ullSectorStart,
+                                      uint32_t ulSectorCount )
+        {
+            REDSTATUS ret;
+
+            #if defined( CTRL_TRIM ) || defined( CTRL_ERASE_SECTOR )
+                DRESULT result;
+                DWORD adwRange[ 2U ];
+
+                /*  The range is of the first and last sectors, inclusive.
+                 */
+                adwRange[ 0U ] = ( DWORD ) ullSectorStart;
+                adwRange[ 1U ] = ( DWORD ) ( ( ullSectorStart + ulSectorCount ) - 1U );
+
+                #ifdef CTRL_TRIM
+                    result = disk_ioctl( bVolNum, CTRL_TRIM, adwRange );
+                #else
+                    result = disk_ioctl( bVolNum, CTRL_ERASE_SECTOR, adwRange );
+                #endif
+
+                if( ( result == RES_OK ) || ( result == RES_PARERR ) )
+                {
+                    ret = 0;
+                }
+                else
+                {
+                    ret = -RED_EIO;
+                }
+            #else /* if defined( CTRL_TRIM ) || defined( CTRL_ERASE_SECTOR ) */
+                ( void ) bVolNum;
+                ( void ) ullSectorStart;
+                ( void ) ulSectorCount;
+
+                ret = 0;
+            #endif /* if defined( CTRL_TRIM ) || defined( CTRL_ERASE_SECTOR ) */
+
+            return ret;
+        }
+    #endif /* REDCONF_DISCARD_EXTENTS > 0U */
+
+
 #elif BDEV_EXAMPLE_IMPLEMENTATION == BDEV_ATMEL_SDMMC
 
     #include <task.h>
@@ -1043,6 +1217,34 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
         }
     #endif /* REDCONF_READ_ONLY == 0 */
 
+
+    #if REDCONF_DISCARD_EXTENTS > 0U
+
+/** @brief Discard sectors of a disk.
+ *
+ *  The ASF SD/MMC driver has no erase command, so this does nothing.
+ *
+ *  @param bVolNum          The volume number of the volume whose block device
+ *                          is being discarded from.
+ *  @param ullSectorStart   The starting sector number.
+ *  @param ulSectorCount    The number of sectors to discard.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0   Operation was successful.
+ */
+        static REDSTATUS DiskDiscard( uint8_t bVolNum,
+                                      uint64_t ullSectorStart,
+                                      uint32_t ulSectorCount )
+        {
+            ( void ) bVolNum;
+            ( void ) ullSectorStart;
+            ( void ) ulSectorCount;
+
+            return 0;
+        }
+    #endif /* REDCONF_DISCARD_EXTENTS > 0U */
+
 #elif BDEV_EXAMPLE_IMPLEMENTATION == BDEV_STM32_SDIO
 
     #ifdef USE_STM324xG_EVAL
@@ -1081,11 +1283,38 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
  */
     #define SD_STATUS_TIMEOUT    ( 100000U )
 
+/** @brief Number of sectors in the bounce buffer.
+ *
+ *  The SD DMA requires 4-byte aligned buffers.  Buffers from the block buffer
+ *  cache are always aligned (see REDCONF_BUFFER_ALIGNMENT), but file data is
+ *  transferred directly to and from the caller's buffer, which need not be.
+ *  Unaligned requests are transferred through the bounce buffer with one
+ *  multi-block command for every SD_BOUNCE_SECTORS sectors.
+ */
+    #ifndef SD_BOUNCE_SECTORS
+        #define SD_BOUNCE_SECTORS    ( 8U )
+    #endif
+
 /** @brief 4-byte aligned buffer to use for DMA transfers when passed in
  *         an unaligned buffer.
  */
-    static uint32_t gaulAlignedBuffer[ 512U / sizeof( uint32_t ) ];
+    static uint32_t gaulBounceBuffer[ ( SD_BOUNCE_SECTORS * 512U ) / sizeof( uint32_t ) ];
+
+    #if REDCONF_FINE_LOCKING == 1
+        #include <semphr.h>
+
+/*  With fine-grained locking, one task may read from the block device while
+ *  another holds the file system mutex and issues requests of its own.  This
+ *  mutex serializes access to the SD card and to the bounce buffer.
+ */
+        static SemaphoreHandle_t gxSdMutex;
+        #if defined( configSUPPORT_STATIC_ALLOCATION ) && ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            static StaticSemaphore_t gxSdMutexBuffer;
+        #endif
 
+        static void SdAcquire( void );
+        static void SdRelease( void );
+    #endif /* if REDCONF_FINE_LOCKING == 1 */
 
     #if SD_STATUS_TIMEOUT > 0U
         static REDSTATUS CheckStatus( void );
@@ -1107,6 +1336,8 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
  *                      enough for the volume; or the volume size is above
  *                      4GiB, meaning that part of it cannot be accessed
  *                      through the STM32 SDIO driver.
+ *  @retval -RED_ENOMEM With REDCONF_FINE_LOCKING, the mutex which serializes
+ *                      access to the SD card could not be created.
  */
     static REDSTATUS DiskOpen( uint8_t bVolNum,
                                BDEVOPENMODE mode )
@@ -1116,7 +1347,23 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
 
         ( void ) mode;
 
-        if( !fSdInitted )
+        #if REDCONF_FINE_LOCKING == 1
+            if( gxSdMutex == NULL )
+            {
+                #if defined( configSUPPORT_STATIC_ALLOCATION ) && ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                    gxSdMutex = xSemaphoreCreateMutexStatic( &gxSdMutexBuffer );
+                #else
+                    gxSdMutex = xSemaphoreCreateMutex();
+                #endif
+
+                if( gxSdMutex == NULL )
+                {
+                    ret = -RED_ENOMEM;
+                }
+            }
+        #endif /* if REDCONF_FINE_LOCKING == 1 */
+
+        if( ( ret == 0 ) && !fSdInitted )
         {
             if( BSP_SD_Init() == MSD_OK )
             {
@@ -1124,7 +1371,12 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
             }
         }
 
-        if( !fSdInitted )
+        if( ret != 0 )
+        {
+            /*  The SD mutex could not be created.
+             */
+        }
+        else if( !fSdInitted )
         {
             /*  Above initialization attempt failed.
              */
@@ -1195,6 +1447,10 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
         uint32_t ulSectorSize = gaRedVolConf[ bVolNum ].ulSectorSize;
         uint8_t bSdError;
 
+        #if REDCONF_FINE_LOCKING == 1
+            SdAcquire();
+        #endif
+
         if( IS_UINT32_ALIGNED_PTR( pBuffer ) )
         {
             bSdError = BSP_SD_ReadBlocks_DMA( CAST_UINT32_PTR( pBuffer ), ullSectorStart * ulSectorSize, ulSectorSize, ulSectorCount );
@@ -1213,11 +1469,14 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
         }
         else
         {
-            uint32_t ulSectorIdx;
+            uint8_t * pbBuffer = CAST_VOID_PTR_TO_UINT8_PTR( pBuffer );
+            uint32_t ulSectorIdx = 0U;
 
-            for( ulSectorIdx = 0U; ulSectorIdx < ulSectorCount; ulSectorIdx++ )
+            while( ( redStat == 0 ) && ( ulSectorIdx < ulSectorCount ) )
             {
-                bSdError = BSP_SD_ReadBlocks_DMA( gaulAlignedBuffer, ( ullSectorStart + ulSectorIdx ) * ulSectorSize, ulSectorSize, 1U );
+                uint32_t ulChunk = REDMIN( ulSectorCount - ulSectorIdx, SD_BOUNCE_SECTORS );
+
+                bSdError = BSP_SD_ReadBlocks_DMA( gaulBounceBuffer, ( ullSectorStart + ulSectorIdx ) * ulSectorSize, ulSectorSize, ulChunk );
 
                 if( bSdError != MSD_OK )
                 {
@@ -1233,17 +1492,16 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
 
                 if( redStat == 0 )
                 {
-                    uint8_t * pbBuffer = CAST_VOID_PTR_TO_UINT8_PTR( pBuffer );
-
-                    RedMemCpy( &pbBuffer[ ulSectorIdx * ulSectorSize ], gaulAlignedBuffer, ulSectorSize );
-                }
-                else
-                {
-                    break;
+                    RedMemCpy( &pbBuffer[ ulSectorIdx * ulSectorSize ], gaulBounceBuffer, ulChunk * ulSectorSize );
+                    ulSectorIdx += ulChunk;
                 }
             }
         }
 
+        #if REDCONF_FINE_LOCKING == 1
+            SdRelease();
+        #endif
+
         return redStat;
     }
 
@@ -1272,6 +1530,10 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
             uint32_t ulSectorSize = gaRedVolConf[ bVolNum ].ulSectorSize;
             uint8_t bSdError;
 
+            #if REDCONF_FINE_LOCKING == 1
+                SdAcquire();
+            #endif
+
             if( IS_UINT32_ALIGNED_PTR( pBuffer ) )
             {
                 bSdError = BSP_SD_WriteBlocks_DMA( CAST_UINT32_PTR( CAST_AWAY_CONST( void, pBuffer ) ), ullSectorStart * ulSectorSize,
@@ -1291,15 +1553,16 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
             }
             else
             {
-                uint32_t ulSectorIdx;
+                const uint8_t * pbBuffer = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pBuffer );
+                uint32_t ulSectorIdx = 0U;
 
-                for( ulSectorIdx = 0U; ulSectorIdx < ulSectorCount; ulSectorIdx++ )
+                while( ( redStat == 0 ) && ( ulSectorIdx < ulSectorCount ) )
                 {
-                    const uint8_t * pbBuffer = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pBuffer );
+                    uint32_t ulChunk = REDMIN( ulSectorCount - ulSectorIdx, SD_BOUNCE_SECTORS );
 
-                    RedMemCpy( gaulAlignedBuffer, &pbBuffer[ ulSectorIdx * ulSectorSize ], ulSectorSize );
+                    RedMemCpy( gaulBounceBuffer, &pbBuffer[ ulSectorIdx * ulSectorSize ], ulChunk * ulSectorSize );
 
-                    bSdError = BSP_SD_WriteBlocks_DMA( gaulAlignedBuffer, ( ullSectorStart + ulSectorIdx ) * ulSectorSize, ulSectorSize, 1U );
+                    bSdError = BSP_SD_WriteBlocks_DMA( gaulBounceBuffer, ( ullSectorStart + ulSectorIdx ) * ulSectorSize, ulSectorSize, ulChunk );
 
                     if( bSdError != MSD_OK )
                     {
@@ -1313,13 +1576,14 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
                         }
                     #endif
 
-                    if( redStat != 0 )
-                    {
-                        break;
-                    }
+                    ulSectorIdx += ulChunk;
                 }
             }
 
+            #if REDCONF_FINE_LOCKING == 1
+                SdRelease();
+            #endif
+
             return redStat;
         }
 
@@ -1340,9 +1604,89 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
             ( void ) bVolNum;
             return 0;
         }
+    #endif /* REDCONF_READ_ONLY == 0 */
+
+
+    #if REDCONF_DISCARD_EXTENTS > 0U
+
+/** @brief Discard sectors of a disk.
+ *
+ *  Erases the range of blocks on the SD card, which is how an SD card is told
+ *  that their contents are no longer needed.
+ *
+ *  @param bVolNum          The volume number of the volume whose block device
+ *                          is being discarded from.
+ *  @param ullSectorStart   The starting sector number.
+ *  @param ulSectorCount    The number of sectors to discard.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    A disk I/O error occurred.
+ */
+        static REDSTATUS DiskDiscard( uint8_t bVolNum,
+                                      uint64_t ullSectorStart,
+                                      uint32_t ulSectorCount )
+        {
+            REDSTATUS redStat = 0;
+            uint32_t ulSectorSize = gaRedVolConf[ bVolNum ].ulSectorSize;
+            uint8_t bSdError;
+
+            #if REDCONF_FINE_LOCKING == 1
+                SdAcquire();
+            #endif
+
+            /*  The end address is that of the last block to erase.
+             */
+            bSdError = BSP_SD_Erase( ullSectorStart * ulSectorSize, ( ( ullSectorStart + ulSectorCount ) - 1U ) * ulSectorSize );
+
+            if( bSdError != MSD_OK )
+            {
+                redStat = -RED_EIO;
+            }
+
+            #if SD_STATUS_TIMEOUT > 0U
+                else
+                {
+                    redStat = CheckStatus();
+                }
+            #endif
+
+            #if REDCONF_FINE_LOCKING == 1
+                SdRelease();
+            #endif
+
+            return redStat;
+        }
+    #endif /* REDCONF_DISCARD_EXTENTS > 0U */
 
 
-        #if SD_STATUS_TIMEOUT > 0U
+    #if REDCONF_FINE_LOCKING == 1
+
+/** @brief Acquire exclusive access to the SD card and the bounce buffer.
+ */
+        static void SdAcquire( void )
+        {
+            while( xSemaphoreTake( gxSdMutex, portMAX_DELAY ) != pdTRUE )
+            {
+            }
+        }
+
+
+/** @brief Release the SD card and the bounce buffer.
+ */
+        static void SdRelease( void )
+        {
+            BaseType_t xSuccess;
+
+            xSuccess = xSemaphoreGive( gxSdMutex );
+            REDASSERT( xSuccess == pdTRUE );
+            IGNORE_ERRORS( xSuccess );
+        }
+    #endif /* REDCONF_FINE_LOCKING == 1 */
+
+
+    #if SD_STATUS_TIMEOUT > 0U
 
 /** @brief Wait until BSP_SD_GetStatus returns SD_TRANSFER_OK.
  *
@@ -1355,28 +1699,26 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
  *  @retval -RED_EIO    SD_TRANSFER_ERROR received, or timed out waiting for
  *                      SD_TRANSFER_OK.
  */
-            static REDSTATUS CheckStatus( void )
-            {
-                REDSTATUS redStat = 0;
-                uint32_t ulTimeout = SD_STATUS_TIMEOUT;
-                HAL_SD_TransferStateTypedef transferState;
-
-                do
-                {
-                    transferState = BSP_SD_GetStatus();
-                    ulTimeout--;
-                } while( ( transferState == SD_TRANSFER_BUSY ) && ( ulTimeout > 0U ) );
+        static REDSTATUS CheckStatus( void )
+        {
+            REDSTATUS redStat = 0;
+            uint32_t ulTimeout = SD_STATUS_TIMEOUT;
+            HAL_SD_TransferStateTypedef transferState;
 
-                if( transferState != SD_TRANSFER_OK )
-                {
-                    redStat = -RED_EIO;
-                }
+            do
+            {
+                transferState = BSP_SD_GetStatus();
+                ulTimeout--;
+            } while( ( transferState == SD_TRANSFER_BUSY ) && ( ulTimeout > 0U ) );
 
-                return redStat;
+            if( transferState != SD_TRANSFER_OK )
+            {
+                redStat = -RED_EIO;
             }
-        #endif /* if SD_STATUS_TIMEOUT > 0U */
 
-    #endif /* REDCONF_READ_ONLY == 0 */
+            return redStat;
+        }
+    #endif /* if SD_STATUS_TIMEOUT > 0U */
 
 #elif BDEV_EXAMPLE_IMPLEMENTATION == BDEV_RAM_DISK
 
@@ -1551,6 +1893,514 @@ REDSTATUS RedOsBDevRead( uint8_t bVolNum,
         }
     #endif /* REDCONF_READ_ONLY == 0 */
 
+
+    #if REDCONF_DISCARD_EXTENTS > 0U
+
+/** @brief Discard sectors of a disk.
+ *
+ *  RAM has no use for discards, so this does nothing.
+ *
+ *  @param bVolNum          The volume number of the volume whose block device
+ *                          is being discarded from.
+ *  @param ullSectorStart   The starting sector number.
+ *  @param ulSectorCount    The number of sectors to discard.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The disk is not open.
+ */
+        static REDSTATUS DiskDiscard( uint8_t bVolNum,
+                                      uint64_t ullSectorStart,
+                                      uint32_t ulSectorCount )
+        {
+            REDSTATUS ret;
+
+            ( void ) ullSectorStart;
+            ( void ) ulSectorCount;
+
+            if( gapbRamDisk[ bVolNum ] == NULL )
+            {
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                ret = 0;
+            }
+
+            return ret;
+        }
+    #endif /* REDCONF_DISCARD_EXTENTS > 0U */
+
+#elif BDEV_EXAMPLE_IMPLEMENTATION == BDEV_MMAP_FILE
+
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <stdint.h>
+    #include <stdio.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <time.h>
+    #include <unistd.h>
+    #include <redosbdev.h>
+
+
+/** @brief Format of the path of each volume's image file, given the volume
+ *         number as an unsigned int.
+ *
+ *  A missing image file is created, and an image file which is too small for
+ *  the volume is extended with zeroes.
+ */
+    #ifndef BDEV_MMAP_PATH_FORMAT
+        #define BDEV_MMAP_PATH_FORMAT    "redvol%u.img"
+    #endif
+
+/** @brief Default microseconds of simulated latency added to each read
+ *         command.
+ */
+    #ifndef BDEV_MMAP_READ_LATENCY_US
+        #define BDEV_MMAP_READ_LATENCY_US    ( 0U )
+    #endif
+
+/** @brief Default microseconds of simulated latency added to each write
+ *         command.
+ */
+    #ifndef BDEV_MMAP_WRITE_LATENCY_US
+        #define BDEV_MMAP_WRITE_LATENCY_US    ( 0U )
+    #endif
+
+/** @brief Default microseconds of simulated latency added to each flush
+ *         command, in addition to the time taken by msync().
+ */
+    #ifndef BDEV_MMAP_FLUSH_LATENCY_US
+        #define BDEV_MMAP_FLUSH_LATENCY_US    ( 0U )
+    #endif
+
+
+/** @brief Simulated latencies of a volume, in microseconds.
+ */
+    typedef struct
+    {
+        uint32_t ulReadUs;  /**< Added to each read command. */
+        uint32_t ulWriteUs; /**< Added to each write command. */
+        uint32_t ulFlushUs; /**< Added to each flush command. */
+    } MMAPLATENCY;
+
+
+    static void MmapLatencyInit( void );
+    static void MmapLatency( uint32_t ulUsecs );
+
+
+    static uint8_t * gapbMmapDisk[ REDCONF_VOLUME_COUNT ];
+    static size_t gaMmapSize[ REDCONF_VOLUME_COUNT ];
+    static MMAPLATENCY gaMmapLatency[ REDCONF_VOLUME_COUNT ];
+    static bool gfMmapLatencyInited;
+
+
+/** @brief Set the simulated latencies of a volume's image.
+ *
+ *  Takes effect with the next command; may be called whether or not the
+ *  volume is open.
+ *
+ *  @param bVolNum      The volume number.
+ *  @param ulReadUs     Microseconds added to each read command.
+ *  @param ulWriteUs    Microseconds added to each write command.
+ *  @param ulFlushUs    Microseconds added to each flush command.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL @p bVolNum is an invalid volume number.
+ */
+    REDSTATUS RedOsBDevMmapLatencySet( uint8_t bVolNum,
+                                       uint32_t ulReadUs,
+                                       uint32_t ulWriteUs,
+                                       uint32_t ulFlushUs )
+    {
+        REDSTATUS ret;
+
+        if( bVolNum >= REDCONF_VOLUME_COUNT )
+        {
+            ret = -RED_EINVAL;
+        }
+        else
+        {
+            MmapLatencyInit();
+
+            gaMmapLatency[ bVolNum ].ulReadUs = ulReadUs;
+            gaMmapLatency[ bVolNum ].ulWriteUs = ulWriteUs;
+            gaMmapLatency[ bVolNum ].ulFlushUs = ulFlushUs;
+
+            ret = 0;
+        }
+
+        return ret;
+    }
+
+
+/** @brief Initialize a disk.
+ *
+ *  @param bVolNum  The volume number of the volume whose block device is being
+ *                  initialized.
+ *  @param mode     The open mode, indicating the type of access required.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EIO    The image file could not be opened, created, extended,
+ *                      or mapped.
+ *  @retval -RED_EINVAL The volume is too large to map; or @p mode is
+ *                      #BDEV_O_RDONLY and the image file is smaller than the
+ *                      volume.
+ */
+    static REDSTATUS DiskOpen( uint8_t bVolNum,
+                               BDEVOPENMODE mode )
+    {
+        REDSTATUS ret = 0;
+
+        MmapLatencyInit();
+
+        if( gapbMmapDisk[ bVolNum ] == NULL )
+        {
+            uint64_t ullSize = gaRedVolConf[ bVolNum ].ullSectorCount * gaRedVolConf[ bVolNum ].ulSectorSize;
+            bool fReadOnly = ( REDCONF_READ_ONLY == 1 ) || ( mode == BDEV_O_RDONLY );
+            char szPath[ 256U ];
+            struct stat st;
+            int fd = -1;
+
+            ( void ) snprintf( szPath, sizeof( szPath ), BDEV_MMAP_PATH_FORMAT, ( unsigned ) bVolNum );
+
+            /*  Check the size before opening the image, so that there is
+             *  nothing to clean up if it cannot be mapped.
+             */
+            if( ullSize > SIZE_MAX )
+            {
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                fd = open( szPath, fReadOnly ? O_RDONLY : ( O_RDWR | O_CREAT ), 0644 );
+            }
+
+            if( ret != 0 )
+            {
+                /*  The volume is too large to map.
+                 */
+            }
+            else if( fd == -1 )
+            {
+                ret = -RED_EIO;
+            }
+            else if( fstat( fd, &st ) != 0 )
+            {
+                ret = -RED_EIO;
+            }
+            else if( ( uint64_t ) st.st_size >= ullSize )
+            {
+                /*  The image is already large enough.
+                 */
+            }
+            else if( fReadOnly )
+            {
+                ret = -RED_EINVAL;
+            }
+            else if( ftruncate( fd, ( off_t ) ullSize ) != 0 )
+            {
+                ret = -RED_EIO;
+            }
+            else
+            {
+                /*  Extended the image; the new sectors read as zeroes.
+                 */
+            }
+
+            if( ret == 0 )
+            {
+                void * pMap = mmap( NULL, ( size_t ) ullSize, fReadOnly ? PROT_READ : ( PROT_READ | PROT_WRITE ), MAP_SHARED, fd, 0 );
+
+                if( pMap == MAP_FAILED )
+                {
+                    ret = -RED_EIO;
+                }
+                else
+                {
+                    gapbMmapDisk[ bVolNum ] = CAST_VOID_PTR_TO_UINT8_PTR( pMap );
+                    gaMmapSize[ bVolNum ] = ( size_t ) ullSize;
+                }
+            }
+
+            /*  The mapping holds its own reference to the file.
+             */
+            if( fd != -1 )
+            {
+                ( void ) close( fd );
+            }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Uninitialize a disk.
+ *
+ *  Unmapping the image does not discard any data written to it, so there is
+ *  no need to msync() here: the data remains in the host's page cache until
+ *  the host writes it back.
+ *
+ *  @param bVolNum  The volume number of the volume whose block device is being
+ *                  uninitialized.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The disk is not open.
+ *  @retval -RED_EIO    The image could not be unmapped.
+ */
+    static REDSTATUS DiskClose( uint8_t bVolNum )
+    {
+        REDSTATUS ret;
+
+        if( gapbMmapDisk[ bVolNum ] == NULL )
+        {
+            ret = -RED_EINVAL;
+        }
+        else if( munmap( gapbMmapDisk[ bVolNum ], gaMmapSize[ bVolNum ] ) != 0 )
+        {
+            ret = -RED_EIO;
+        }
+        else
+        {
+            gapbMmapDisk[ bVolNum ] = NULL;
+            ret = 0;
+        }
+
+        return ret;
+    }
+
+
+/** @brief Read sectors from a disk.
+ *
+ *  @param bVolNum          The volume number of the volume whose block device
+ *                          is being read from.
+ *  @param ullSectorStart   The starting sector number.
+ *  @param ulSectorCount    The number of sectors to read.
+ *  @param pBuffer          The buffer into which to read the sector data.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The disk is not open.
+ */
+    static REDSTATUS DiskRead( uint8_t bVolNum,
+                               uint64_t ullSectorStart,
+                               uint32_t ulSectorCount,
+                               void * pBuffer )
+    {
+        REDSTATUS ret;
+
+        if( gapbMmapDisk[ bVolNum ] == NULL )
+        {
+            ret = -RED_EINVAL;
+        }
+        else
+        {
+            uint64_t ullByteOffset = ullSectorStart * gaRedVolConf[ bVolNum ].ulSectorSize;
+            uint32_t ulByteCount = ulSectorCount * gaRedVolConf[ bVolNum ].ulSectorSize;
+
+            MmapLatency( gaMmapLatency[ bVolNum ].ulReadUs );
+
+            RedMemCpy( pBuffer, &gapbMmapDisk[ bVolNum ][ ullByteOffset ], ulByteCount );
+
+            ret = 0;
+        }
+
+        return ret;
+    }
+
+
+    #if REDCONF_READ_ONLY == 0
+
+/** @brief Write sectors to a disk.
+ *
+ *  @param bVolNum          The volume number of the volume whose block device
+ *                          is being written to.
+ *  @param ullSectorStart   The starting sector number.
+ *  @param ulSectorCount    The number of sectors to write.
+ *  @param pBuffer          The buffer from which to write the sector data.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The disk is not open.
+ */
+        static REDSTATUS DiskWrite( uint8_t bVolNum,
+                                    uint64_t ullSectorStart,
+                                    uint32_t ulSectorCount,
+                                    const void * pBuffer )
+        {
+            REDSTATUS ret;
+
+            if( gapbMmapDisk[ bVolNum ] == NULL )
+            {
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                uint64_t ullByteOffset = ullSectorStart * gaRedVolConf[ bVolNum ].ulSectorSize;
+                uint32_t ulByteCount = ulSectorCount * gaRedVolConf[ bVolNum ].ulSectorSize;
+
+                MmapLatency( gaMmapLatency[ bVolNum ].ulWriteUs );
+
+                RedMemCpy( &gapbMmapDisk[ bVolNum ][ ullByteOffset ], pBuffer, ulByteCount );
+
+                ret = 0;
+            }
+
+            return ret;
+        }
+
+
+/** @brief Flush any caches beneath the file system.
+ *
+ *  Writes the dirty pages of the image back to the image file and waits for
+ *  them to reach the host's storage.
+ *
+ *  @param bVolNum  The volume number of the volume whose block device is being
+ *                  flushed.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The disk is not open.
+ *  @retval -RED_EIO    msync() failed.
+ */
+        static REDSTATUS DiskFlush( uint8_t bVolNum )
+        {
+            REDSTATUS ret;
+
+            if( gapbMmapDisk[ bVolNum ] == NULL )
+            {
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                MmapLatency( gaMmapLatency[ bVolNum ].ulFlushUs );
+
+                if( msync( gapbMmapDisk[ bVolNum ], gaMmapSize[ bVolNum ], MS_SYNC ) != 0 )
+                {
+                    ret = -RED_EIO;
+                }
+                else
+                {
+                    ret = 0;
+                }
+            }
+
+            return ret;
+        }
+    #endif /* REDCONF_READ_ONLY == 0 */
+
+
+    #if REDCONF_DISCARD_EXTENTS > 0U
+
+/** @brief Discard sectors of a disk.
+ *
+ *  Frees the host storage behind the whole pages within the range, so that
+ *  the image file becomes sparse, like a thinly provisioned disk; they read as
+ *  zeroes afterward.  Host file systems which cannot do this are left as is.
+ *
+ *  @param bVolNum          The volume number of the volume whose block device
+ *                          is being discarded from.
+ *  @param ullSectorStart   The starting sector number.
+ *  @param ulSectorCount    The number of sectors to discard.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The disk is not open.
+ */
+        static REDSTATUS DiskDiscard( uint8_t bVolNum,
+                                      uint64_t ullSectorStart,
+                                      uint32_t ulSectorCount )
+        {
+            REDSTATUS ret;
+
+            if( gapbMmapDisk[ bVolNum ] == NULL )
+            {
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                uint64_t ullPageSize = ( uint64_t ) sysconf( _SC_PAGESIZE );
+                uint64_t ullByteStart = ullSectorStart * gaRedVolConf[ bVolNum ].ulSectorSize;
+                uint64_t ullByteEnd = ullByteStart + ( ( uint64_t ) ulSectorCount * gaRedVolConf[ bVolNum ].ulSectorSize );
+
+                /*  Round inward to whole pages.  The mapping itself is page
+                 *  aligned.
+                 */
+                ullByteStart = ( ullByteStart + ullPageSize - 1U ) & ~( ullPageSize - 1U );
+                ullByteEnd &= ~( ullPageSize - 1U );
+
+                if( ullByteEnd > ullByteStart )
+                {
+                    ( void ) madvise( &gapbMmapDisk[ bVolNum ][ ullByteStart ], ( size_t ) ( ullByteEnd - ullByteStart ), MADV_REMOVE );
+                }
+
+                ret = 0;
+            }
+
+            return ret;
+        }
+    #endif /* REDCONF_DISCARD_EXTENTS > 0U */
+
+
+/** @brief Set every volume's latencies to the compile-time defaults, if not
+ *         already done.
+ */
+    static void MmapLatencyInit( void )
+    {
+        if( !gfMmapLatencyInited )
+        {
+            uint8_t bVolNum;
+
+            for( bVolNum = 0U; bVolNum < REDCONF_VOLUME_COUNT; bVolNum++ )
+            {
+                gaMmapLatency[ bVolNum ].ulReadUs = BDEV_MMAP_READ_LATENCY_US;
+                gaMmapLatency[ bVolNum ].ulWriteUs = BDEV_MMAP_WRITE_LATENCY_US;
+                gaMmapLatency[ bVolNum ].ulFlushUs = BDEV_MMAP_FLUSH_LATENCY_US;
+            }
+
+            gfMmapLatencyInited = true;
+        }
+    }
+
+
+/** @brief Delay the calling task to simulate the latency of a command.
+ *
+ *  The delay is a host sleep rather than a FreeRTOS delay, since the tick is
+ *  too coarse for typical storage latencies.  Like a driver which polls its
+ *  hardware, it does not yield to other tasks.
+ *
+ *  @param ulUsecs  The number of microseconds to delay.
+ */
+    static void MmapLatency( uint32_t ulUsecs )
+    {
+        if( ulUsecs > 0U )
+        {
+            struct timespec ts;
+
+            ts.tv_sec = ( time_t ) ( ulUsecs / 1000000U );
+            ts.tv_nsec = ( long ) ( ulUsecs % 1000000U ) * 1000L;
+
+            /*  The simulator's tick signal can interrupt the sleep; continue
+             *  sleeping for the remainder.
+             */
+            while( ( nanosleep( &ts, &ts ) != 0 ) && ( errno == EINTR ) )
+            {
+            }
+        }
+    }
+
 #else /* if BDEV_EXAMPLE_IMPLEMENTATION == BDEV_F_DRIVER */
 
     #error "Invalid BDEV_EXAMPLE_IMPLEMENTATION value"
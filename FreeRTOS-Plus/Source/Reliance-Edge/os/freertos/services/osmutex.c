@@ -132,4 +132,141 @@
         IGNORE_ERRORS( xSuccess );
     }
 
+
+
+    #if REDCONF_FINE_LOCKING == 1
+
+        static SemaphoreHandle_t axSem[ RED_SEM_COUNT ];
+        #if defined( configSUPPORT_STATIC_ALLOCATION ) && ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            static StaticSemaphore_t axSemBuffer[ RED_SEM_COUNT ];
+        #endif
+
+
+/** @brief Initialize a counting semaphore.
+ *
+ *  Each semaphore can count up to REDCONF_TASK_COUNT.  The FreeRTOS
+ *  configuration must define configUSE_COUNTING_SEMAPHORES to 1.
+ *
+ *  @param bSem     The semaphore to initialize: one of the RED_SEM_* values.
+ *  @param ulCount  The initial count of the semaphore.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL @p bSem is invalid or @p ulCount is too large.
+ *  @retval -RED_ENOMEM The semaphore could not be allocated.
+ */
+        REDSTATUS RedOsSemaphoreInit( uint8_t bSem,
+                                      uint32_t ulCount )
+        {
+            REDSTATUS ret = 0;
+
+            if( ( bSem >= RED_SEM_COUNT ) || ( ulCount > REDCONF_TASK_COUNT ) )
+            {
+                REDERROR();
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                #if defined( configSUPPORT_STATIC_ALLOCATION ) && ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                    axSem[ bSem ] = xSemaphoreCreateCountingStatic( REDCONF_TASK_COUNT, ulCount, &axSemBuffer[ bSem ] );
+
+                    if( axSem[ bSem ] == NULL )
+                    {
+                        REDERROR();
+                        ret = -RED_ENOMEM;
+                    }
+                #else
+                    axSem[ bSem ] = xSemaphoreCreateCounting( REDCONF_TASK_COUNT, ulCount );
+
+                    if( axSem[ bSem ] == NULL )
+                    {
+                        ret = -RED_ENOMEM;
+                    }
+                #endif
+            }
+
+            return ret;
+        }
+
+
+/** @brief Uninitialize a counting semaphore.
+ *
+ *  @param bSem The semaphore to uninitialize.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL @p bSem is invalid.
+ */
+        REDSTATUS RedOsSemaphoreUninit( uint8_t bSem )
+        {
+            REDSTATUS ret = 0;
+
+            if( bSem >= RED_SEM_COUNT )
+            {
+                REDERROR();
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                vSemaphoreDelete( axSem[ bSem ] );
+                axSem[ bSem ] = NULL;
+            }
+
+            return ret;
+        }
+
+
+/** @brief Take (decrement) a counting semaphore.
+ *
+ *  @param bSem     The semaphore to take.
+ *  @param fWait    Whether to wait for the semaphore to become available, if
+ *                  its count is zero.
+ *
+ *  @return Whether the semaphore was taken.  Always true if @p fWait is true.
+ */
+        bool RedOsSemaphoreTake( uint8_t bSem,
+                                 bool fWait )
+        {
+            bool fTaken;
+
+            REDASSERT( bSem < RED_SEM_COUNT );
+
+            if( fWait )
+            {
+                while( xSemaphoreTake( axSem[ bSem ], portMAX_DELAY ) != pdTRUE )
+                {
+                }
+
+                fTaken = true;
+            }
+            else
+            {
+                fTaken = ( xSemaphoreTake( axSem[ bSem ], 0U ) == pdTRUE );
+            }
+
+            return fTaken;
+        }
+
+
+/** @brief Give (increment) a counting semaphore.
+ *
+ *  Unlike a mutex, a semaphore may be given by a task other than the one which
+ *  took it.
+ *
+ *  @param bSem The semaphore to give.
+ */
+        void RedOsSemaphoreGive( uint8_t bSem )
+        {
+            BaseType_t xSuccess;
+
+            REDASSERT( bSem < RED_SEM_COUNT );
+
+            xSuccess = xSemaphoreGive( axSem[ bSem ] );
+            REDASSERT( xSuccess == pdTRUE );
+            IGNORE_ERRORS( xSuccess );
+        }
+    #endif /* REDCONF_FINE_LOCKING == 1 */
+
 #endif /* if REDCONF_TASK_COUNT > 1U */
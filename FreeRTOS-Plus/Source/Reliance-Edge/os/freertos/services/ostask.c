@@ -66,4 +66,165 @@
         return ulTaskPtr + 1U;
     }
 
+
+    #if REDCONF_TRANSACT_BACKGROUND == 1
+
+        #include <semphr.h>
+
+        #if configUSE_TASK_NOTIFICATIONS != 1
+            #error "configUSE_TASK_NOTIFICATIONS must be 1 when REDCONF_TRANSACT_BACKGROUND is 1"
+        #endif
+
+/*  Priority and stack depth of the background commit task.  The task should
+ *  usually run below the tasks which write files, so that it commits while
+ *  they are idle.
+ */
+        #ifndef RED_COMMIT_TASK_PRIORITY
+            #define RED_COMMIT_TASK_PRIORITY    ( tskIDLE_PRIORITY + 1U )
+        #endif
+        #ifndef RED_COMMIT_TASK_STACK
+            #define RED_COMMIT_TASK_STACK       ( configMINIMAL_STACK_SIZE * 4U )
+        #endif
+
+
+        static void CommitTask( void * pvParameters );
+
+
+        static TaskHandle_t xCommitTask;
+        static SemaphoreHandle_t xCommitStopped;
+        static void ( * pfnCommitWork )( void );
+        static volatile bool fCommitStop;
+        #if defined( configSUPPORT_STATIC_ALLOCATION ) && ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            static StaticTask_t xCommitTaskBuffer;
+            static StackType_t axCommitTaskStack[ RED_COMMIT_TASK_STACK ];
+            static StaticSemaphore_t xCommitStoppedBuffer;
+        #endif
+
+
+/** @brief Start the background commit task.
+ *
+ *  @param pfnCommit    The function which the task calls each time it is woken
+ *                      by RedOsCommitTaskWake().  It is responsible for its own
+ *                      locking.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL @p pfnCommit is `NULL`.
+ *  @retval -RED_ENOMEM The task could not be created.
+ */
+        REDSTATUS RedOsCommitTaskStart( void ( * pfnCommit )( void ) )
+        {
+            REDSTATUS ret = 0;
+
+            if( pfnCommit == NULL )
+            {
+                REDERROR();
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                pfnCommitWork = pfnCommit;
+                fCommitStop = false;
+
+                #if defined( configSUPPORT_STATIC_ALLOCATION ) && ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                    xCommitStopped = xSemaphoreCreateBinaryStatic( &xCommitStoppedBuffer );
+                #else
+                    xCommitStopped = xSemaphoreCreateBinary();
+                #endif
+
+                if( xCommitStopped == NULL )
+                {
+                    ret = -RED_ENOMEM;
+                }
+                else
+                {
+                    #if defined( configSUPPORT_STATIC_ALLOCATION ) && ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                        xCommitTask = xTaskCreateStatic( CommitTask, "RedCommit", RED_COMMIT_TASK_STACK, NULL, RED_COMMIT_TASK_PRIORITY, axCommitTaskStack, &xCommitTaskBuffer );
+                    #else
+                        if( xTaskCreate( CommitTask, "RedCommit", RED_COMMIT_TASK_STACK, NULL, RED_COMMIT_TASK_PRIORITY, &xCommitTask ) != pdPASS )
+                        {
+                            xCommitTask = NULL;
+                        }
+                    #endif
+
+                    if( xCommitTask == NULL )
+                    {
+                        vSemaphoreDelete( xCommitStopped );
+                        ret = -RED_ENOMEM;
+                    }
+                }
+            }
+
+            return ret;
+        }
+
+
+/** @brief Stop the background commit task.
+ *
+ *  Waits for the task to finish any commit in progress and exit.  Must not be
+ *  called with the FS mutex held.
+ */
+        void RedOsCommitTaskStop( void )
+        {
+            fCommitStop = true;
+            ( void ) xTaskNotifyGive( xCommitTask );
+
+            while( xSemaphoreTake( xCommitStopped, portMAX_DELAY ) != pdTRUE )
+            {
+            }
+
+            /*  The task is deleted from here, rather than deleting itself, so
+             *  that FreeRTOS is done with its memory, which may be static and
+             *  reused by the next RedOsCommitTaskStart(), before this returns.
+             */
+            vTaskDelete( xCommitTask );
+            vSemaphoreDelete( xCommitStopped );
+            xCommitTask = NULL;
+        }
+
+
+/** @brief Wake the background commit task.
+ *
+ *  Does not block.  Wakeups are not counted: several requests made before the
+ *  task runs result in one call to its commit function.
+ */
+        void RedOsCommitTaskWake( void )
+        {
+            if( xCommitTask != NULL )
+            {
+                ( void ) xTaskNotifyGive( xCommitTask );
+            }
+        }
+
+
+/** @brief Body of the background commit task.
+ *
+ *  @param pvParameters Unused.
+ */
+        static void CommitTask( void * pvParameters )
+        {
+            ( void ) pvParameters;
+
+            while( !fCommitStop )
+            {
+                ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+                if( !fCommitStop )
+                {
+                    pfnCommitWork();
+                }
+            }
+
+            ( void ) xSemaphoreGive( xCommitStopped );
+
+            /*  Wait to be deleted by RedOsCommitTaskStop().
+             */
+            while( true )
+            {
+                ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            }
+        }
+    #endif /* REDCONF_TRANSACT_BACKGROUND == 1 */
+
 #endif /* if ( REDCONF_TASK_COUNT > 1U ) && ( REDCONF_API_POSIX == 1 ) */
@@ -87,6 +87,7 @@
     #define HFLAG_READABLE     0x02U /* Handle is readable. */
     #define HFLAG_WRITEABLE    0x04U /* Handle is writeable. */
     #define HFLAG_APPENDING    0x08U /* Handle was opened in append mode. */
+    #define HFLAG_OFFSETBUSY   0x10U /* A shared operation is using the offset. */
 
 /*  @brief Handle structure, used to implement file descriptors and directory
  *         streams.
@@ -117,6 +118,15 @@
         } TASKSLOT;
     #endif
 
+/*  Whether red_read() can share its volume with other readers.  Not when access
+ *  times are updated, since then reading a file modifies its inode.
+ */
+    #if ( REDCONF_ATIME == 0 ) || ( REDCONF_READ_ONLY == 1 )
+        #define READ_LOCK_SHARED    true
+    #else
+        #define READ_LOCK_SHARED    false
+    #endif
+
 /*-------------------------------------------------------------------
  *   Local Prototypes
  *  -------------------------------------------------------------------*/
@@ -144,6 +154,29 @@
     #endif
     static REDSTATUS PosixEnter( void );
     static void PosixLeave( void );
+    static REDSTATUS PosixEnterFildes( int32_t iFildes,
+                                       bool fShared );
+    static void PosixLeaveFildes( int32_t iFildes,
+                                  bool fShared );
+    static REDSTATUS PosixEnterOffset( int32_t iFildes,
+                                       bool * pfShared );
+    static void PosixLeaveOffset( int32_t iFildes,
+                                  bool fShared );
+    #if REDCONF_FINE_LOCKING == 1
+        static REDSTATUS PosixEnterVol( uint8_t bVolNum,
+                                        bool fShared );
+        static void PosixLeaveVol( uint8_t bVolNum,
+                                   bool fShared );
+        static void PosixLock( uint8_t bVolNum,
+                               bool fShared );
+        static void PosixUnlock( uint8_t bVolNum,
+                                 bool fShared );
+        static void RwLockAcquire( uint8_t bLock,
+                                   bool fShared );
+        static void RwLockRelease( uint8_t bLock,
+                                   bool fShared );
+        static uint8_t FildesVolume( int32_t iFildes );
+    #endif
     static REDSTATUS ModeTypeCheck( uint16_t uMode,
                                     FTYPE expectedType );
     #if ( REDCONF_READ_ONLY == 0 ) && ( ( REDCONF_API_POSIX_UNLINK == 1 ) || ( REDCONF_API_POSIX_RMDIR == 1 ) || ( ( REDCONF_API_POSIX_RENAME == 1 ) && ( REDCONF_RENAME_ATOMIC == 1 ) ) )
@@ -152,6 +185,9 @@
     #if REDCONF_TASK_COUNT > 1U
         static REDSTATUS TaskRegister( uint32_t * pulTaskIdx );
     #endif
+    #if REDCONF_TRANSACT_BACKGROUND == 1
+        static void PosixCommit( void );
+    #endif
     static int32_t PosixReturn( REDSTATUS iError );
 
 /*-------------------------------------------------------------------
@@ -172,6 +208,14 @@
  */
     static uint16_t gauGeneration[ REDCONF_VOLUME_COUNT ];
 
+    #if REDCONF_FINE_LOCKING == 1
+
+/*  Number of tasks waiting to acquire each reader/writer lock exclusively,
+ *  indexed like RwLockAcquire()'s bLock.  Protected by the FS mutex.
+ */
+        static uint32_t gaulWritersWaiting[ REDCONF_VOLUME_COUNT + 1U ];
+    #endif
+
 
 /*-------------------------------------------------------------------
  *   Public API
@@ -216,6 +260,16 @@
                 #endif
 
                 gfPosixInited = true;
+
+                #if REDCONF_TRANSACT_BACKGROUND == 1
+                    ret = RedOsCommitTaskStart( PosixCommit );
+
+                    if( ret != 0 )
+                    {
+                        gfPosixInited = false;
+                        ( void ) RedCoreUninit();
+                    }
+                #endif
             }
         }
 
@@ -247,6 +301,15 @@
 
         if( gfPosixInited )
         {
+            #if REDCONF_TRANSACT_BACKGROUND == 1
+
+                /*  Stop the commit task before entering the driver, so that it
+                 *  cannot be waiting to enter when the driver is marked
+                 *  uninitialized.  It is restarted below if uninit fails.
+                 */
+                RedOsCommitTaskStop();
+            #endif
+
             ret = PosixEnter();
 
             if( ret == 0 )
@@ -281,6 +344,9 @@
                 #if REDCONF_TASK_COUNT > 1U
                     RedOsMutexRelease();
                 #endif
+                #if REDCONF_FINE_LOCKING == 1
+                    PosixUnlock( REDCONF_VOLUME_COUNT, false );
+                #endif
             }
 
             if( ret == 0 )
@@ -293,6 +359,21 @@
                  */
                 REDASSERT( ret == 0 );
             }
+
+            #if REDCONF_TRANSACT_BACKGROUND == 1
+                else if( gfPosixInited )
+                {
+                    /*  The driver is still initialized: resume background
+                     *  commits.
+                     */
+                    ( void ) RedOsCommitTaskStart( PosixCommit );
+                }
+                else
+                {
+                    /*  Nothing to restart.
+                     */
+                }
+            #endif
         }
         else
         {
@@ -326,6 +407,9 @@
     int32_t red_mount( const char * pszVolume )
     {
         REDSTATUS ret;
+        #if REDCONF_STATISTICS == 1
+            REDTIMESTAMP tsStart = RedOsTimestamp();
+        #endif
 
         ret = PosixEnter();
 
@@ -378,6 +462,10 @@
                 }
             }
 
+            #if REDCONF_STATISTICS == 1
+                RedCoreStatOp( RED_STATOP_MOUNT, tsStart, ret );
+            #endif
+
             PosixLeave();
         }
 
@@ -411,7 +499,8 @@
  #red_errno is set appropriately.
  *
  *  <b>Errno values</b>
- *  - #RED_EBUSY: There are still open handles for this file system volume.
+ *  - #RED_EBUSY: There are still open handles for this file system volume; or
+ *    data leased from the volume by red_readlease() has not been released.
  *  - #RED_EINVAL: @p pszVolume is `NULL`; or the driver is uninitialized; or
  *    the volume is already unmounted.
  *  - #RED_EIO: I/O error during unmount automatic transaction point.
@@ -421,6 +510,9 @@
     int32_t red_umount( const char * pszVolume )
     {
         REDSTATUS ret;
+        #if REDCONF_STATISTICS == 1
+            REDTIMESTAMP tsStart = RedOsTimestamp();
+        #endif
 
         ret = PosixEnter();
 
@@ -468,6 +560,10 @@
                 ret = RedCoreVolUnmount();
             }
 
+            #if REDCONF_STATISTICS == 1
+                RedCoreStatOp( RED_STATOP_UMOUNT, tsStart, ret );
+            #endif
+
             PosixLeave();
         }
 
@@ -499,6 +595,9 @@
         int32_t red_format( const char * pszVolume )
         {
             REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
             ret = PosixEnter();
 
@@ -520,6 +619,10 @@
                     ret = RedCoreVolFormat();
                 }
 
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_FORMAT, tsStart, ret );
+                #endif
+
                 PosixLeave();
             }
 
@@ -554,6 +657,9 @@
         int32_t red_transact( const char * pszVolume )
         {
             REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
             ret = PosixEnter();
 
@@ -575,6 +681,10 @@
                     ret = RedCoreVolTransact();
                 }
 
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_TRANSACT, tsStart, ret );
+                #endif
+
                 PosixLeave();
             }
 
@@ -583,6 +693,65 @@
     #endif /* if REDCONF_READ_ONLY == 0 */
 
 
+    #if REDCONF_TRANSACT_BACKGROUND == 1
+
+/** @brief Wait for automatic transaction points to be durable.
+ *
+ *  With background transactions, automatic transaction events only request a
+ *  transaction point from the commit task.  This function makes sure that every
+ *  such event which has already occurred on the volume is durable: if the
+ *  commit task has not yet committed the transaction point, the calling task
+ *  commits it.  Working state changes which were not followed by an automatic
+ *  transaction event are not committed; use red_transact() for that.
+ *
+ *  The commit task does not retry a transaction point that fails, and has no
+ *  way to report the error: the transaction point stays pending until this
+ *  function (or red_transact()) commits it, so call this function to learn
+ *  whether background transaction points are failing.
+ *
+ *  @param pszVolume    A path prefix identifying the volume.
+ *
+ *  @return On success, zero is returned.  On error, -1 is returned and
+ #red_errno is set appropriately.
+ *
+ *  <b>Errno values</b>
+ *  - #RED_EINVAL: Volume is not mounted; or @p pszVolume is `NULL`.
+ *  - #RED_EIO: I/O error during the transaction point.
+ *  - #RED_ENOENT: @p pszVolume is not a valid volume path prefix.
+ *  - #RED_EUSERS: Cannot become a file system user: too many users.
+ */
+        int32_t red_transactwait( const char * pszVolume )
+        {
+            REDSTATUS ret;
+
+            ret = PosixEnter();
+
+            if( ret == 0 )
+            {
+                uint8_t bVolNum;
+
+                ret = RedPathSplit( pszVolume, &bVolNum, NULL );
+
+                #if REDCONF_VOLUME_COUNT > 1U
+                    if( ret == 0 )
+                    {
+                        ret = RedCoreVolSetCurrent( bVolNum );
+                    }
+                #endif
+
+                if( ret == 0 )
+                {
+                    ret = RedCoreVolTransactPending();
+                }
+
+                PosixLeave();
+            }
+
+            return PosixReturn( ret );
+        }
+    #endif /* REDCONF_TRANSACT_BACKGROUND == 1 */
+
+
     #if REDCONF_READ_ONLY == 0
 
 /** @brief Update the transaction mask.
@@ -729,6 +898,9 @@
                          REDSTATFS * pStatvfs )
     {
         REDSTATUS ret;
+        #if REDCONF_STATISTICS == 1
+            REDTIMESTAMP tsStart = RedOsTimestamp();
+        #endif
 
         ret = PosixEnter();
 
@@ -750,6 +922,10 @@
                 ret = RedCoreVolStat( pStatvfs );
             }
 
+            #if REDCONF_STATISTICS == 1
+                RedCoreStatOp( RED_STATOP_STATVFS, tsStart, ret );
+            #endif
+
             PosixLeave();
         }
 
@@ -757,6 +933,46 @@
     }
 
 
+    #if REDCONF_STATISTICS == 1
+
+/** @brief Retrieve file system statistics.
+ *
+ *  The statistics cover every volume: the number and latency of each kind of
+ *  API call, block buffer cache hits and misses, block device requests, and
+ *  the duration of transaction points.  See ::REDSTATS for the details.
+ *
+ *  @param pStats   The buffer to populate with the statistics.
+ *  @param fReset   Whether to reset the statistics to zero after they have
+ *                  been retrieved, so that the next call reports only what
+ *                  happened in between.
+ *
+ *  @return On success, zero is returned.  On error, -1 is returned and
+ #red_errno is set appropriately.
+ *
+ *  <b>Errno values</b>
+ *  - #RED_EINVAL: @p pStats is `NULL`; or the file system driver is
+ *    uninitialized.
+ *  - #RED_EUSERS: Cannot become a file system user: too many users.
+ */
+        int32_t red_getstats( REDSTATS * pStats,
+                              bool fReset )
+        {
+            REDSTATUS ret;
+
+            ret = PosixEnter();
+
+            if( ret == 0 )
+            {
+                ret = RedCoreStats( pStats, fReset );
+
+                PosixLeave();
+            }
+
+            return PosixReturn( ret );
+        }
+    #endif /* REDCONF_STATISTICS == 1 */
+
+
 /** @brief Open a file or directory.
  *
  *  Exactly one file access mode must be specified:
@@ -829,6 +1045,9 @@
     {
         int32_t iFildes = -1; /* Init'd to quiet warnings. */
         REDSTATUS ret;
+        #if REDCONF_STATISTICS == 1
+            REDTIMESTAMP tsStart = RedOsTimestamp();
+        #endif
 
         #if REDCONF_READ_ONLY == 1
             if( ulOpenMode != RED_O_RDONLY )
@@ -863,6 +1082,10 @@
         {
             ret = FildesOpen( pszPath, ulOpenMode, FTYPE_EITHER, &iFildes );
 
+            #if REDCONF_STATISTICS == 1
+                RedCoreStatOp( RED_STATOP_OPEN, tsStart, ret );
+            #endif
+
             PosixLeave();
         }
 
@@ -923,6 +1146,9 @@
         int32_t red_unlink( const char * pszPath )
         {
             REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
             ret = PosixEnter();
 
@@ -930,6 +1156,10 @@
             {
                 ret = UnlinkSub( pszPath, FTYPE_EITHER );
 
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_UNLINK, tsStart, ret );
+                #endif
+
                 PosixLeave();
             }
 
@@ -969,6 +1199,9 @@
         int32_t red_mkdir( const char * pszPath )
         {
             REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
             ret = PosixEnter();
 
@@ -1001,6 +1234,10 @@
                     }
                 }
 
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_MKDIR, tsStart, ret );
+                #endif
+
                 PosixLeave();
             }
 
@@ -1061,6 +1298,9 @@
         int32_t red_rmdir( const char * pszPath )
         {
             REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
             ret = PosixEnter();
 
@@ -1068,6 +1308,10 @@
             {
                 ret = UnlinkSub( pszPath, FTYPE_DIR );
 
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_RMDIR, tsStart, ret );
+                #endif
+
                 PosixLeave();
             }
 
@@ -1141,6 +1385,9 @@
                             const char * pszNewPath )
         {
             REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
             ret = PosixEnter();
 
@@ -1215,6 +1462,10 @@
                     }
                 }
 
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_RENAME, tsStart, ret );
+                #endif
+
                 PosixLeave();
             }
 
@@ -1269,6 +1520,9 @@
                           const char * pszHardLink )
         {
             REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
             ret = PosixEnter();
 
@@ -1319,6 +1573,10 @@
                     }
                 }
 
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_LINK, tsStart, ret );
+                #endif
+
                 PosixLeave();
             }
 
@@ -1342,14 +1600,21 @@
     int32_t red_close( int32_t iFildes )
     {
         REDSTATUS ret;
+        #if REDCONF_STATISTICS == 1
+            REDTIMESTAMP tsStart = RedOsTimestamp();
+        #endif
 
-        ret = PosixEnter();
+        ret = PosixEnterFildes( iFildes, false );
 
         if( ret == 0 )
         {
             ret = FildesClose( iFildes );
 
-            PosixLeave();
+            #if REDCONF_STATISTICS == 1
+                RedCoreStatOp( RED_STATOP_CLOSE, tsStart, ret );
+            #endif
+
+            PosixLeaveFildes( iFildes, false );
         }
 
         return PosixReturn( ret );
@@ -1389,8 +1654,12 @@
                       uint32_t ulLength )
     {
         uint32_t ulLenRead = 0U;
+        bool fShared = READ_LOCK_SHARED;
         REDSTATUS ret;
         int32_t iReturn;
+        #if REDCONF_STATISTICS == 1
+            REDTIMESTAMP tsStart = RedOsTimestamp();
+        #endif
 
         if( ulLength > ( uint32_t ) INT32_MAX )
         {
@@ -1398,7 +1667,7 @@
         }
         else
         {
-            ret = PosixEnter();
+            ret = PosixEnterOffset( iFildes, &fShared );
         }
 
         if( ret == 0 )
@@ -1432,7 +1701,11 @@
                 pHandle->ullOffset += ulLenRead;
             }
 
-            PosixLeave();
+            #if REDCONF_STATISTICS == 1
+                RedCoreStatOp( RED_STATOP_READ, tsStart, ret );
+            #endif
+
+            PosixLeaveOffset( iFildes, fShared );
         }
 
         if( ret == 0 )
@@ -1448,63 +1721,153 @@
     }
 
 
-    #if REDCONF_READ_ONLY == 0
+/** @brief Read from an open file into several buffers.
+ *
+ *  Like red_read(), except that the data is scattered into the buffers of
+ *  @p paIov, in order, filling each one before moving on to the next.  The
+ *  whole request is a single file system operation: the file descriptor is
+ *  resolved once, and no other operation on the file can intervene between
+ *  the buffers.
+ *
+ *  @param iFildes      The file descriptor from which to read.
+ *  @param paIov        The buffers to populate with data read.
+ *  @param ulIovCount   The number of elements in @p paIov.
+ *
+ *  @return On success, returns a nonnegative value indicating the number of
+ *          bytes actually read.  On error, -1 is returned and #red_errno is
+ *          set appropriately.
+ *
+ *  <b>Errno values</b>
+ *  - #RED_EBADF: The @p iFildes argument is not a valid file descriptor open
+ *    for reading.
+ *  - #RED_EINVAL: @p paIov is `NULL`; or @p ulIovCount is zero; or a buffer
+ *    with a nonzero length is `NULL`; or the total length of the buffers
+ *    exceeds INT32_MAX and cannot be returned properly.
+ *  - #RED_EIO: A disk I/O error occurred.
+ *  - #RED_EISDIR: The @p iFildes is a file descriptor for a directory.
+ *  - #RED_EUSERS: Cannot become a file system user: too many users.
+ */
+    int32_t red_readv( int32_t iFildes,
+                       const REDIOVEC * paIov,
+                       uint32_t ulIovCount )
+    {
+        uint32_t ulLenRead = 0U;
+        bool fShared = READ_LOCK_SHARED;
+        REDSTATUS ret;
+        int32_t iReturn;
+        #if REDCONF_STATISTICS == 1
+            REDTIMESTAMP tsStart = RedOsTimestamp();
+        #endif
 
-/** @brief Write to an open file.
+        ret = PosixEnterOffset( iFildes, &fShared );
+
+        if( ret == 0 )
+        {
+            REDHANDLE * pHandle;
+
+            ret = FildesToHandle( iFildes, FTYPE_FILE, &pHandle );
+
+            if( ( ret == 0 ) && ( ( pHandle->bFlags & HFLAG_READABLE ) == 0U ) )
+            {
+                ret = -RED_EBADF;
+            }
+
+            #if REDCONF_VOLUME_COUNT > 1U
+                if( ret == 0 )
+                {
+                    ret = RedCoreVolSetCurrent( pHandle->bVolNum );
+                }
+            #endif
+
+            if( ret == 0 )
+            {
+                ret = RedCoreFileReadv( pHandle->ulInode, pHandle->ullOffset, paIov, ulIovCount, &ulLenRead );
+            }
+
+            if( ret == 0 )
+            {
+                pHandle->ullOffset += ulLenRead;
+            }
+
+            #if REDCONF_STATISTICS == 1
+                RedCoreStatOp( RED_STATOP_READ, tsStart, ret );
+            #endif
+
+            PosixLeaveOffset( iFildes, fShared );
+        }
+
+        if( ret == 0 )
+        {
+            iReturn = ( int32_t ) ulLenRead;
+        }
+        else
+        {
+            iReturn = PosixReturn( ret );
+        }
+
+        return iReturn;
+    }
+
+
+    #if REDCONF_READ_LEASES > 0U
+
+/** @brief Read from an open file without copying the data.
  *
- *  The write takes place at the file offset associated with @p iFildes and
- *  advances the file offset by the number of bytes actually written.
- *  Alternatively, if @p iFildes was opened with #RED_O_APPEND, the file offset
- *  is set to the end-of-file before the write begins, and likewise advances by
- *  the number of bytes actually written.
+ *  Rather than copying the data into a buffer supplied by the caller, this
+ *  lends the caller the block buffer which holds the data, so that it can be
+ *  consumed in place; for example, transmitted by a network stack.  The lease
+ *  starts at the file offset associated with @p iFildes, and advances the file
+ *  offset by the number of bytes leased.
  *
- *  A short write -- where the number of bytes written is less than requested
- *  -- indicates either that the file system ran out of space but was still
- *  able to write some of the request; or that the request would have caused
- *  the file to exceed the maximum file size, but some of the data could be
- *  written prior to the file size limit.
+ *  At most the remainder of one file system block is leased at a time, so the
+ *  number of bytes leased may be less than requested even before the
+ *  end-of-file; zero bytes are leased only at or beyond the end-of-file.
  *
- *  If an error is returned (-1), either none of the data was written or a
- *  critical error occurred (like an I/O error) and the file system volume will
- *  be read-only.
+ *  The leased data must not be modified, and it must be returned with
+ *  red_leaserelease(): until then, it occupies a buffer which the file system
+ *  cannot use.  The data is a snapshot of the file at the time of the lease,
+ *  unaffected by later writes.  At most #REDCONF_READ_LEASES leases may be
+ *  outstanding at once, and a volume cannot be unmounted while any of its
+ *  leases are outstanding.  Closing @p iFildes does not release its leases.
  *
- *  @param iFildes  The file descriptor to write to.
- *  @param pBuffer  The buffer containing the data to be written.  Must be at
- *                  least @p ulLength bytes in size.
- *  @param ulLength Number of bytes to attempt to write.
+ *  @param iFildes  The file descriptor from which to read.
+ *  @param ulLength Maximum number of bytes to lease.
+ *  @param ppData   On success, when the returned length is nonzero, populated
+ *                  with a pointer to the leased data.
  *
  *  @return On success, returns a nonnegative value indicating the number of
- *          bytes actually written.  On error, -1 is returned and #red_errno is
- *          set appropriately.
+ *          bytes leased.  On error, -1 is returned and #red_errno is set
+ *          appropriately.
  *
  *  <b>Errno values</b>
  *  - #RED_EBADF: The @p iFildes argument is not a valid file descriptor open
- *    for writing.  This includes the case where the file descriptor is for a
- *    directory.
- *  - #RED_EFBIG: No data can be written to the current file offset since the
- *    resulting file size would exceed the maximum file size.
- *  - #RED_EINVAL: @p pBuffer is `NULL`; or @p ulLength exceeds INT32_MAX and
+ *    for reading.
+ *  - #RED_EBUSY: #REDCONF_READ_LEASES leases are already outstanding.
+ *  - #RED_EINVAL: @p ppData is `NULL`; or @p ulLength exceeds INT32_MAX and
  *    cannot be returned properly.
  *  - #RED_EIO: A disk I/O error occurred.
- *  - #RED_ENOSPC: No data can be written because there is insufficient free
- *    space.
+ *  - #RED_EISDIR: The @p iFildes is a file descriptor for a directory.
  *  - #RED_EUSERS: Cannot become a file system user: too many users.
  */
-        int32_t red_write( int32_t iFildes,
-                           const void * pBuffer,
-                           uint32_t ulLength )
+        int32_t red_readlease( int32_t iFildes,
+                               uint32_t ulLength,
+                               const void ** ppData )
         {
-            uint32_t ulLenWrote = 0U;
+            uint32_t ulLenLeased = 0U;
+            bool fShared = READ_LOCK_SHARED;
             REDSTATUS ret;
             int32_t iReturn;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
-            if( ulLength > ( uint32_t ) INT32_MAX )
+            if( ( ulLength > ( uint32_t ) INT32_MAX ) || ( ppData == NULL ) )
             {
                 ret = -RED_EINVAL;
             }
             else
             {
-                ret = PosixEnter();
+                ret = PosixEnterOffset( iFildes, &fShared );
             }
 
             if( ret == 0 )
@@ -1513,18 +1876,7 @@
 
                 ret = FildesToHandle( iFildes, FTYPE_FILE, &pHandle );
 
-                if( ret == -RED_EISDIR )
-                {
-                    /*  POSIX says that if a file descriptor is not writable, the
-                     *  errno should be -RED_EBADF.  Directory file descriptors are
-                     *  never writable, and unlike for read(), the spec does not
-                     *  list -RED_EISDIR as an allowed errno.  Therefore -RED_EBADF
-                     *  takes precedence.
-                     */
-                    ret = -RED_EBADF;
-                }
-
-                if( ( ret == 0 ) && ( ( pHandle->bFlags & HFLAG_WRITEABLE ) == 0U ) )
+                if( ( ret == 0 ) && ( ( pHandle->bFlags & HFLAG_READABLE ) == 0U ) )
                 {
                     ret = -RED_EBADF;
                 }
@@ -1536,9 +1888,364 @@
                     }
                 #endif
 
-                if( ( ret == 0 ) && ( ( pHandle->bFlags & HFLAG_APPENDING ) != 0U ) )
+                if( ret == 0 )
                 {
-                    REDSTAT s;
+                    ulLenLeased = ulLength;
+                    ret = RedCoreFileLease( pHandle->ulInode, pHandle->ullOffset, &ulLenLeased, ppData );
+                }
+
+                if( ret == 0 )
+                {
+                    REDASSERT( ulLenLeased <= ulLength );
+
+                    pHandle->ullOffset += ulLenLeased;
+                }
+
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_READ, tsStart, ret );
+                #endif
+
+                PosixLeaveOffset( iFildes, fShared );
+            }
+
+            if( ret == 0 )
+            {
+                iReturn = ( int32_t ) ulLenLeased;
+            }
+            else
+            {
+                iReturn = PosixReturn( ret );
+            }
+
+            return iReturn;
+        }
+
+
+/** @brief Release data leased by red_readlease().
+ *
+ *  The file descriptor used to lease the data need not still be open.
+ *
+ *  @param pData    The pointer populated by red_readlease().
+ *
+ *  @return On success, zero is returned.  On error, -1 is returned and
+ *          #red_errno is set appropriately.
+ *
+ *  <b>Errno values</b>
+ *  - #RED_EINVAL: @p pData is not a pointer to leased data which has yet to
+ *    be released; or the driver is uninitialized.
+ *  - #RED_EUSERS: Cannot become a file system user: too many users.
+ */
+        int32_t red_leaserelease( const void * pData )
+        {
+            REDSTATUS ret;
+
+            ret = PosixEnter();
+
+            if( ret == 0 )
+            {
+                ret = RedCoreLeaseRelease( pData );
+
+                PosixLeave();
+            }
+
+            return PosixReturn( ret );
+        }
+    #endif /* REDCONF_READ_LEASES > 0U */
+
+
+    #if REDCONF_SNAPSHOTS > 0U
+
+/** @brief Open a read-only snapshot of a file.
+ *
+ *  The snapshot is the file as of the last transaction point.  If the file has
+ *  been modified since then, a transaction point is committed first.  The
+ *  snapshot is read with red_snapread(), which does not hold the file system
+ *  lock: a backup task can stream the snapshot while other tasks modify the
+ *  file.  Writes, truncations and deletions after the snapshot is opened do
+ *  not change what it reads.
+ *
+ *  Snapshots opened with the same committed sequence number see the same
+ *  committed state.  To get a consistent view of several files, open a
+ *  snapshot of each, and if the sequence numbers differ, close them and try
+ *  again.
+ *
+ *  Blocks which the file frees while a snapshot of it is open are not reused
+ *  until every snapshot of the volume is closed, so overwriting or deleting a
+ *  file with an open snapshot does not free space right away.  At most
+ *  #REDCONF_SNAPSHOT_EXTENTS extents of blocks can be held this way; beyond
+ *  that, the snapshots of the volume become stale and reads from them fail
+ *  with #RED_ESTALE.  A volume cannot be unmounted while any of its snapshots
+ *  are open.
+ *
+ *  @param pszPath      The path to the file.
+ *  @param pullSequence If non-NULL, populated with the sequence number of the
+ *                      committed metaroot which the snapshot was taken from.
+ *
+ *  @return On success, a nonnegative snapshot descriptor is returned.  On
+ *          error, -1 is returned and #red_errno is set appropriately.
+ *
+ *  <b>Errno values</b>
+ *  - #RED_EINVAL: @p pszPath is `NULL`; or the volume containing the path is
+ *    not mounted.
+ *  - #RED_EIO: A disk I/O error occurred.
+ *  - #RED_EISDIR: The path names a directory.
+ *  - #RED_EMFILE: #REDCONF_SNAPSHOTS snapshots are already open.
+ *  - #RED_ENAMETOOLONG: The length of a component of @p pszPath is longer than
+ #REDCONF_NAME_MAX.
+ *  - #RED_ENOENT: The path does not name an existing file; or the @p pszPath
+ *    argument, after removing the volume prefix, points to an empty string.
+ *  - #RED_ENOSPC: The file was modified and there is not enough space to
+ *    commit a transaction point.
+ *  - #RED_ENOTDIR: A component of the path prefix is not a directory.
+ *  - #RED_EUSERS: Cannot become a file system user: too many users.
+ */
+        int32_t red_snapopen( const char * pszPath,
+                              uint64_t * pullSequence )
+        {
+            uint32_t ulSnap = 0U;
+            REDSTATUS ret;
+            int32_t iReturn;
+
+            ret = PosixEnter();
+
+            if( ret == 0 )
+            {
+                const char * pszLocalPath;
+                uint8_t bVolNum;
+
+                ret = RedPathSplit( pszPath, &bVolNum, &pszLocalPath );
+
+                #if REDCONF_VOLUME_COUNT > 1U
+                    if( ret == 0 )
+                    {
+                        ret = RedCoreVolSetCurrent( bVolNum );
+                    }
+                #endif
+
+                if( ret == 0 )
+                {
+                    uint32_t ulInode;
+
+                    ret = RedPathLookup( pszLocalPath, &ulInode );
+
+                    if( ret == 0 )
+                    {
+                        ret = RedCoreSnapOpen( ulInode, &ulSnap, pullSequence );
+                    }
+                }
+
+                PosixLeave();
+            }
+
+            if( ret == 0 )
+            {
+                iReturn = ( int32_t ) ulSnap;
+            }
+            else
+            {
+                iReturn = PosixReturn( ret );
+            }
+
+            return iReturn;
+        }
+
+
+/** @brief Read from a snapshot opened with red_snapopen().
+ *
+ *  Like a positional read: there is no file offset.  The data is read from
+ *  the block device without the file system lock, so the block device must
+ *  allow reads concurrent with the file system's own I/O.  A snapshot must
+ *  not be read by more than one task at a time, but different snapshots can
+ *  be read concurrently.
+ *
+ *  @param iSnap        The snapshot descriptor.
+ *  @param ullOffset    The file offset to read from.
+ *  @param pBuffer      The buffer to read into.
+ *  @param ulLength     The number of bytes to read.
+ *
+ *  @return On success, the number of bytes read is returned, which is less
+ *          than @p ulLength only at the end-of-file.  On error, -1 is returned
+ *          and #red_errno is set appropriately.
+ *
+ *  <b>Errno values</b>
+ *  - #RED_EBADF: @p iSnap is not an open snapshot descriptor.
+ *  - #RED_EINVAL: @p pBuffer is `NULL`; or @p ulLength exceeds INT32_MAX and
+ *    cannot be returned properly; or the driver is uninitialized.
+ *  - #RED_EIO: A disk I/O error occurred.
+ *  - #RED_ESTALE: Too many blocks were freed while the snapshot was open, and
+ *    its data may have been overwritten.  The snapshot must be closed.
+ */
+        int32_t red_snapread( int32_t iSnap,
+                              uint64_t ullOffset,
+                              void * pBuffer,
+                              uint32_t ulLength )
+        {
+            uint32_t ulLenRead = ulLength;
+            REDSTATUS ret;
+            int32_t iReturn;
+
+            if( !gfPosixInited || ( ulLength > ( uint32_t ) INT32_MAX ) )
+            {
+                ret = -RED_EINVAL;
+            }
+            else if( iSnap < 0 )
+            {
+                ret = -RED_EBADF;
+            }
+            else
+            {
+                /*  Deliberately without PosixEnter(): see RedCoreSnapRead().
+                 */
+                ret = RedCoreSnapRead( ( uint32_t ) iSnap, ullOffset, &ulLenRead, pBuffer );
+            }
+
+            if( ret == 0 )
+            {
+                iReturn = ( int32_t ) ulLenRead;
+            }
+            else
+            {
+                iReturn = PosixReturn( ret );
+            }
+
+            return iReturn;
+        }
+
+
+/** @brief Close a snapshot opened with red_snapopen().
+ *
+ *  Once no snapshot of the volume is open, the blocks held for the snapshots
+ *  become free for reuse.
+ *
+ *  @param iSnap    The snapshot descriptor.
+ *
+ *  @return On success, zero is returned.  On error, -1 is returned and
+ *          #red_errno is set appropriately.
+ *
+ *  <b>Errno values</b>
+ *  - #RED_EBADF: @p iSnap is not an open snapshot descriptor.
+ *  - #RED_EINVAL: The driver is uninitialized.
+ *  - #RED_EUSERS: Cannot become a file system user: too many users.
+ */
+        int32_t red_snapclose( int32_t iSnap )
+        {
+            REDSTATUS ret;
+
+            ret = PosixEnter();
+
+            if( ret == 0 )
+            {
+                if( iSnap < 0 )
+                {
+                    ret = -RED_EBADF;
+                }
+                else
+                {
+                    ret = RedCoreSnapClose( ( uint32_t ) iSnap );
+                }
+
+                PosixLeave();
+            }
+
+            return PosixReturn( ret );
+        }
+    #endif /* REDCONF_SNAPSHOTS > 0U */
+
+
+    #if REDCONF_READ_ONLY == 0
+
+/** @brief Write to an open file.
+ *
+ *  The write takes place at the file offset associated with @p iFildes and
+ *  advances the file offset by the number of bytes actually written.
+ *  Alternatively, if @p iFildes was opened with #RED_O_APPEND, the file offset
+ *  is set to the end-of-file before the write begins, and likewise advances by
+ *  the number of bytes actually written.
+ *
+ *  A short write -- where the number of bytes written is less than requested
+ *  -- indicates either that the file system ran out of space but was still
+ *  able to write some of the request; or that the request would have caused
+ *  the file to exceed the maximum file size, but some of the data could be
+ *  written prior to the file size limit.
+ *
+ *  If an error is returned (-1), either none of the data was written or a
+ *  critical error occurred (like an I/O error) and the file system volume will
+ *  be read-only.
+ *
+ *  @param iFildes  The file descriptor to write to.
+ *  @param pBuffer  The buffer containing the data to be written.  Must be at
+ *                  least @p ulLength bytes in size.
+ *  @param ulLength Number of bytes to attempt to write.
+ *
+ *  @return On success, returns a nonnegative value indicating the number of
+ *          bytes actually written.  On error, -1 is returned and #red_errno is
+ *          set appropriately.
+ *
+ *  <b>Errno values</b>
+ *  - #RED_EBADF: The @p iFildes argument is not a valid file descriptor open
+ *    for writing.  This includes the case where the file descriptor is for a
+ *    directory.
+ *  - #RED_EFBIG: No data can be written to the current file offset since the
+ *    resulting file size would exceed the maximum file size.
+ *  - #RED_EINVAL: @p pBuffer is `NULL`; or @p ulLength exceeds INT32_MAX and
+ *    cannot be returned properly.
+ *  - #RED_EIO: A disk I/O error occurred.
+ *  - #RED_ENOSPC: No data can be written because there is insufficient free
+ *    space.
+ *  - #RED_EUSERS: Cannot become a file system user: too many users.
+ */
+        int32_t red_write( int32_t iFildes,
+                           const void * pBuffer,
+                           uint32_t ulLength )
+        {
+            uint32_t ulLenWrote = 0U;
+            REDSTATUS ret;
+            int32_t iReturn;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
+
+            if( ulLength > ( uint32_t ) INT32_MAX )
+            {
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                ret = PosixEnterFildes( iFildes, false );
+            }
+
+            if( ret == 0 )
+            {
+                REDHANDLE * pHandle;
+
+                ret = FildesToHandle( iFildes, FTYPE_FILE, &pHandle );
+
+                if( ret == -RED_EISDIR )
+                {
+                    /*  POSIX says that if a file descriptor is not writable, the
+                     *  errno should be -RED_EBADF.  Directory file descriptors are
+                     *  never writable, and unlike for read(), the spec does not
+                     *  list -RED_EISDIR as an allowed errno.  Therefore -RED_EBADF
+                     *  takes precedence.
+                     */
+                    ret = -RED_EBADF;
+                }
+
+                if( ( ret == 0 ) && ( ( pHandle->bFlags & HFLAG_WRITEABLE ) == 0U ) )
+                {
+                    ret = -RED_EBADF;
+                }
+
+                #if REDCONF_VOLUME_COUNT > 1U
+                    if( ret == 0 )
+                    {
+                        ret = RedCoreVolSetCurrent( pHandle->bVolNum );
+                    }
+                #endif
+
+                if( ( ret == 0 ) && ( ( pHandle->bFlags & HFLAG_APPENDING ) != 0U ) )
+                {
+                    REDSTAT s;
 
                     ret = RedCoreStat( pHandle->ulInode, &s );
 
@@ -1561,7 +2268,121 @@
                     pHandle->ullOffset += ulLenWrote;
                 }
 
-                PosixLeave();
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_WRITE, tsStart, ret );
+                #endif
+
+                PosixLeaveFildes( iFildes, false );
+            }
+
+            if( ret == 0 )
+            {
+                iReturn = ( int32_t ) ulLenWrote;
+            }
+            else
+            {
+                iReturn = PosixReturn( ret );
+            }
+
+            return iReturn;
+        }
+
+
+/** @brief Write to an open file from several buffers.
+ *
+ *  Like red_write(), except that the data is gathered from the buffers of
+ *  @p paIov, in order.  The whole request is a single file system operation:
+ *  the file descriptor is resolved once, no other operation on the file can
+ *  intervene between the buffers, and a #RED_TRANSACT_WRITE automatic
+ *  transaction point, if enabled, happens once for the whole request.
+ *
+ *  @param iFildes      The file descriptor to write to.
+ *  @param paIov        The buffers containing the data to be written.
+ *  @param ulIovCount   The number of elements in @p paIov.
+ *
+ *  @return On success, returns a nonnegative value indicating the number of
+ *          bytes actually written.  On error, -1 is returned and #red_errno is
+ *          set appropriately.
+ *
+ *  <b>Errno values</b>
+ *  - #RED_EBADF: The @p iFildes argument is not a valid file descriptor open
+ *    for writing.  This includes the case where the file descriptor is for a
+ *    directory.
+ *  - #RED_EFBIG: No data can be written to the current file offset since the
+ *    resulting file size would exceed the maximum file size.
+ *  - #RED_EINVAL: @p paIov is `NULL`; or @p ulIovCount is zero; or a buffer
+ *    with a nonzero length is `NULL`; or the total length of the buffers
+ *    exceeds INT32_MAX and cannot be returned properly.
+ *  - #RED_EIO: A disk I/O error occurred.
+ *  - #RED_ENOSPC: No data can be written because there is insufficient free
+ *    space.
+ *  - #RED_EUSERS: Cannot become a file system user: too many users.
+ */
+        int32_t red_writev( int32_t iFildes,
+                            const REDIOVEC * paIov,
+                            uint32_t ulIovCount )
+        {
+            uint32_t ulLenWrote = 0U;
+            REDSTATUS ret;
+            int32_t iReturn;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
+
+            ret = PosixEnterFildes( iFildes, false );
+
+            if( ret == 0 )
+            {
+                REDHANDLE * pHandle;
+
+                ret = FildesToHandle( iFildes, FTYPE_FILE, &pHandle );
+
+                if( ret == -RED_EISDIR )
+                {
+                    /*  As in red_write(), -RED_EBADF takes precedence.
+                     */
+                    ret = -RED_EBADF;
+                }
+
+                if( ( ret == 0 ) && ( ( pHandle->bFlags & HFLAG_WRITEABLE ) == 0U ) )
+                {
+                    ret = -RED_EBADF;
+                }
+
+                #if REDCONF_VOLUME_COUNT > 1U
+                    if( ret == 0 )
+                    {
+                        ret = RedCoreVolSetCurrent( pHandle->bVolNum );
+                    }
+                #endif
+
+                if( ( ret == 0 ) && ( ( pHandle->bFlags & HFLAG_APPENDING ) != 0U ) )
+                {
+                    REDSTAT s;
+
+                    ret = RedCoreStat( pHandle->ulInode, &s );
+
+                    if( ret == 0 )
+                    {
+                        pHandle->ullOffset = s.st_size;
+                    }
+                }
+
+                if( ret == 0 )
+                {
+                    ret = RedCoreFileWritev( pHandle->ulInode, pHandle->ullOffset, paIov, ulIovCount, &ulLenWrote );
+                }
+
+                if( ret == 0 )
+                {
+                    pHandle->ullOffset += ulLenWrote;
+                }
+
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_WRITE, tsStart, ret );
+                #endif
+
+                PosixLeaveFildes( iFildes, false );
             }
 
             if( ret == 0 )
@@ -1615,8 +2436,11 @@
         int32_t red_fsync( int32_t iFildes )
         {
             REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
-            ret = PosixEnter();
+            ret = PosixEnterFildes( iFildes, false );
 
             if( ret == 0 )
             {
@@ -1646,7 +2470,11 @@
                     }
                 }
 
-                PosixLeave();
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_FSYNC, tsStart, ret );
+                #endif
+
+                PosixLeaveFildes( iFildes, false );
             }
 
             return PosixReturn( ret );
@@ -1697,8 +2525,12 @@
     {
         REDSTATUS ret;
         int64_t llReturn = -1; /* Init'd to quiet warnings. */
+        bool fShared = true;
+        #if REDCONF_STATISTICS == 1
+            REDTIMESTAMP tsStart = RedOsTimestamp();
+        #endif
 
-        ret = PosixEnter();
+        ret = PosixEnterOffset( iFildes, &fShared );
 
         if( ret == 0 )
         {
@@ -1786,7 +2618,11 @@
                 }
             }
 
-            PosixLeave();
+            #if REDCONF_STATISTICS == 1
+                RedCoreStatOp( RED_STATOP_LSEEK, tsStart, ret );
+            #endif
+
+            PosixLeaveOffset( iFildes, fShared );
         }
 
         if( ret != 0 )
@@ -1836,8 +2672,11 @@
                                uint64_t ullSize )
         {
             REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
-            ret = PosixEnter();
+            ret = PosixEnterFildes( iFildes, false );
 
             if( ret == 0 )
             {
@@ -1870,7 +2709,11 @@
                     ret = RedCoreFileTruncate( pHandle->ulInode, ullSize );
                 }
 
-                PosixLeave();
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_FTRUNCATE, tsStart, ret );
+                #endif
+
+                PosixLeaveFildes( iFildes, false );
             }
 
             return PosixReturn( ret );
@@ -1878,6 +2721,107 @@
     #endif /* if ( REDCONF_READ_ONLY == 0 ) && ( REDCONF_API_POSIX_FTRUNCATE == 1 ) */
 
 
+    #if REDCONF_READ_ONLY == 0
+
+/** @brief Allocate space for a range of a file.
+ *
+ *  Similar to POSIX posix_fallocate.  Blocks in the range which are sparse are
+ *  allocated and filled with zeroes, taking contiguous extents of free space
+ *  where possible, so that the file reads back sequentially from the disk.
+ *  Existing data in the range is not changed.  If the range ends beyond the
+ *  end of the file, the file size is increased to the end of the range.
+ *
+ *  Reliance Edge never overwrites data which is part of the committed state,
+ *  so the allocated blocks can only be written in place until the next
+ *  transaction point; writes into the range after that are relocated, as
+ *  usual.  To benefit from the allocation, the application should write the
+ *  range with automatic transactions which do not occur on every write (see
+ *  red_settransmask()), transacting with red_fsync() once the range has been
+ *  written.  This function does not trigger an automatic transaction point.
+ *
+ *  The value of the file offset is not modified by this function.
+ *
+ *  @param iFildes      The file descriptor of the file.
+ *  @param ullOffset    The file offset at which the range starts.
+ *  @param ullLen       The length of the range, in bytes.
+ *
+ *  @return On success, zero is returned.  On error, -1 is returned and
+ #red_errno is set appropriately.
+ *
+ *  <b>Errno values</b>
+ *  - #RED_EBADF: The @p iFildes argument is not a valid file descriptor open
+ *    for writing.  This includes the case where the file descriptor is for a
+ *    directory.
+ *  - #RED_EFBIG: The range extends beyond the maximum file size.
+ *  - #RED_EINVAL: @p ullLen is zero.
+ *  - #RED_EIO: A disk I/O error occurred.
+ *  - #RED_ENOSPC: Insufficient free space to allocate the whole range.  The
+ *    blocks which could be allocated remain allocated, and the file size covers
+ *    them.
+ *  - #RED_EUSERS: Cannot become a file system user: too many users.
+ */
+        int32_t red_fallocate( int32_t iFildes,
+                               uint64_t ullOffset,
+                               uint64_t ullLen )
+        {
+            REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
+
+            if( ullLen == 0U )
+            {
+                ret = -RED_EINVAL;
+            }
+            else
+            {
+                ret = PosixEnterFildes( iFildes, false );
+
+                if( ret == 0 )
+                {
+                    REDHANDLE * pHandle;
+
+                    ret = FildesToHandle( iFildes, FTYPE_FILE, &pHandle );
+
+                    if( ret == -RED_EISDIR )
+                    {
+                        /*  Similar to red_write() (see comment there), the RED_EBADF
+                         *  error for a non-writable file descriptor takes
+                         *  precedence.
+                         */
+                        ret = -RED_EBADF;
+                    }
+
+                    if( ( ret == 0 ) && ( ( pHandle->bFlags & HFLAG_WRITEABLE ) == 0U ) )
+                    {
+                        ret = -RED_EBADF;
+                    }
+
+                    #if REDCONF_VOLUME_COUNT > 1U
+                        if( ret == 0 )
+                        {
+                            ret = RedCoreVolSetCurrent( pHandle->bVolNum );
+                        }
+                    #endif
+
+                    if( ret == 0 )
+                    {
+                        ret = RedCoreFileAllocate( pHandle->ulInode, ullOffset, ullLen );
+                    }
+
+                    #if REDCONF_STATISTICS == 1
+                        RedCoreStatOp( RED_STATOP_FALLOCATE, tsStart, ret );
+                    #endif
+
+                    PosixLeaveFildes( iFildes, false );
+                }
+            }
+
+            return PosixReturn( ret );
+        }
+    #endif /* REDCONF_READ_ONLY == 0 */
+
+
 /** @brief Get the status of a file or directory.
  *
  *  See the ::REDSTAT type for the details of the information returned.
@@ -1899,8 +2843,11 @@
                        REDSTAT * pStat )
     {
         REDSTATUS ret;
+        #if REDCONF_STATISTICS == 1
+            REDTIMESTAMP tsStart = RedOsTimestamp();
+        #endif
 
-        ret = PosixEnter();
+        ret = PosixEnterFildes( iFildes, true );
 
         if( ret == 0 )
         {
@@ -1920,7 +2867,11 @@
                 ret = RedCoreStat( pHandle->ulInode, pStat );
             }
 
-            PosixLeave();
+            #if REDCONF_STATISTICS == 1
+                RedCoreStatOp( RED_STATOP_FSTAT, tsStart, ret );
+            #endif
+
+            PosixLeaveFildes( iFildes, true );
         }
 
         return PosixReturn( ret );
@@ -1952,6 +2903,9 @@
             int32_t iFildes;
             REDSTATUS ret;
             REDDIR * pDir = NULL;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
             ret = PosixEnter();
 
@@ -1967,6 +2921,10 @@
                     pDir = &gaHandle[ uHandleIdx ];
                 }
 
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_OPENDIR, tsStart, ret );
+                #endif
+
                 PosixLeave();
             }
 
@@ -2015,6 +2973,9 @@
         {
             REDSTATUS ret;
             REDDIRENT * pDirEnt = NULL;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
             ret = PosixEnter();
 
@@ -2072,6 +3033,10 @@
                     }
                 }
 
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_READDIR, tsStart, ret );
+                #endif
+
                 PosixLeave();
             }
 
@@ -2127,6 +3092,9 @@
         int32_t red_closedir( REDDIR * pDirStream )
         {
             REDSTATUS ret;
+            #if REDCONF_STATISTICS == 1
+                REDTIMESTAMP tsStart = RedOsTimestamp();
+            #endif
 
             ret = PosixEnter();
 
@@ -2143,6 +3111,10 @@
                     ret = -RED_EBADF;
                 }
 
+                #if REDCONF_STATISTICS == 1
+                    RedCoreStatOp( RED_STATOP_CLOSEDIR, tsStart, ret );
+                #endif
+
                 PosixLeave();
             }
 
@@ -2625,7 +3597,7 @@
 
                 if( ( ret == 0 ) && ( ( ulTransMask & RED_TRANSACT_CLOSE ) != 0U ) )
                 {
-                    ret = RedCoreVolTransact();
+                    ret = RedCoreVolTransactAuto();
                 }
             }
         #endif /* if REDCONF_READ_ONLY == 0 */
@@ -2705,208 +3677,581 @@
                 *ppHandle = &gaHandle[ uHandleIdx ];
                 ret = 0;
             }
-        }
+        }
+
+        return ret;
+    }
+
+
+/** @brief Pack a file descriptor.
+ *
+ *  @param uHandleIdx   The index of the file handle that will be associated
+ *                      with this file descriptor.
+ *  @param bVolNum      The volume which contains the file or directory this
+ *                      file descriptor was opened against.
+ *
+ *  @return The packed file descriptor.
+ */
+    static int32_t FildesPack( uint16_t uHandleIdx,
+                               uint8_t bVolNum )
+    {
+        int32_t iFildes;
+
+        if( ( uHandleIdx >= REDCONF_HANDLE_COUNT ) || ( bVolNum >= REDCONF_VOLUME_COUNT ) )
+        {
+            REDERROR();
+            iFildes = -1;
+        }
+        else
+        {
+            uint32_t ulFdBits;
+
+            REDASSERT( gauGeneration[ bVolNum ] <= FD_GEN_MAX );
+            REDASSERT( gauGeneration[ bVolNum ] != 0U );
+
+            ulFdBits = gauGeneration[ bVolNum ];
+            ulFdBits <<= FD_VOL_BITS;
+            ulFdBits |= bVolNum;
+            ulFdBits <<= FD_IDX_BITS;
+            ulFdBits |= uHandleIdx;
+
+            iFildes = ( int32_t ) ulFdBits;
+
+            if( iFildes < FD_MIN )
+            {
+                REDERROR();
+                iFildes = -1;
+            }
+        }
+
+        return iFildes;
+    }
+
+
+/** @brief Unpack a file descriptor.
+ *
+ *  @param iFildes      The file descriptor to unpack.
+ *  @param puHandleIdx  If non-NULL, populated with the handle index extracted
+ *                      from the file descriptor.
+ *  @param pbVolNum     If non-NULL, populated with the volume number extracted
+ *                      from the file descriptor.
+ *  @param puGeneration If non-NULL, populated with the generation number
+ *                      extracted from the file descriptor.
+ */
+    static void FildesUnpack( int32_t iFildes,
+                              uint16_t * puHandleIdx,
+                              uint8_t * pbVolNum,
+                              uint16_t * puGeneration )
+    {
+        uint32_t ulFdBits = ( uint32_t ) iFildes;
+
+        REDASSERT( iFildes >= FD_MIN );
+
+        if( puHandleIdx != NULL )
+        {
+            *puHandleIdx = ( uint16_t ) ( ulFdBits & FD_IDX_MAX );
+        }
+
+        ulFdBits >>= FD_IDX_BITS;
+
+        if( pbVolNum != NULL )
+        {
+            *pbVolNum = ( uint8_t ) ( ulFdBits & FD_VOL_MAX );
+        }
+
+        ulFdBits >>= FD_VOL_BITS;
+
+        if( puGeneration != NULL )
+        {
+            *puGeneration = ( uint16_t ) ( ulFdBits & FD_GEN_MAX );
+        }
+    }
+
+
+    #if REDCONF_API_POSIX_READDIR == 1
+
+/** @brief Validate a directory stream object.
+ *
+ *  @param pDirStream   The directory stream to validate.
+ *
+ *  @return Whether the directory stream is valid.
+ *
+ *  @retval true    The directory stream object appears valid.
+ *  @retval false   The directory stream object is invalid.
+ */
+        static bool DirStreamIsValid( const REDDIR * pDirStream )
+        {
+            bool fRet = true;
+
+            if( pDirStream == NULL )
+            {
+                fRet = false;
+            }
+            else
+            {
+                uint16_t uHandleIdx;
+
+                /*  pDirStream should be a pointer to one of the handles.
+                 *
+                 *  A good compiler will optimize this loop into a bounds check and an
+                 *  alignment check.
+                 */
+                for( uHandleIdx = 0U; uHandleIdx < REDCONF_HANDLE_COUNT; uHandleIdx++ )
+                {
+                    if( pDirStream == &gaHandle[ uHandleIdx ] )
+                    {
+                        break;
+                    }
+                }
+
+                if( uHandleIdx < REDCONF_HANDLE_COUNT )
+                {
+                    /*  The handle must be in use, have a valid volume number, and be a
+                     *  directory handle.
+                     */
+                    if( ( pDirStream->ulInode == INODE_INVALID ) ||
+                        ( pDirStream->bVolNum >= REDCONF_VOLUME_COUNT ) ||
+                        ( ( pDirStream->bFlags & HFLAG_DIRECTORY ) == 0U ) )
+                    {
+                        fRet = false;
+                    }
+                }
+                else
+                {
+                    /*  pDirStream is a non-null pointer, but it is not a pointer to one
+                     *  of our handles.
+                     */
+                    fRet = false;
+                }
+            }
+
+            return fRet;
+        }
+    #endif /* if REDCONF_API_POSIX_READDIR == 1 */
+
+
+/** @brief Enter the file system driver.
+ *
+ *  With fine-grained locking, this excludes every other file system user,
+ *  including those operating on file descriptors of any volume.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The file system driver is uninitialized.
+ *  @retval -RED_EUSERS Cannot become a file system user: too many users.
+ */
+    static REDSTATUS PosixEnter( void )
+    {
+        REDSTATUS ret;
+
+        #if REDCONF_FINE_LOCKING == 1
+            ret = PosixEnterVol( REDCONF_VOLUME_COUNT, false );
+        #else
+            if( gfPosixInited )
+            {
+                #if REDCONF_TASK_COUNT > 1U
+                    RedOsMutexAcquire();
+
+                    ret = TaskRegister( NULL );
+
+                    if( ret != 0 )
+                    {
+                        RedOsMutexRelease();
+                    }
+                #else
+                    ret = 0;
+                #endif
+            }
+            else
+            {
+                ret = -RED_EINVAL;
+            }
+        #endif /* if REDCONF_FINE_LOCKING == 1 */
+
+        return ret;
+    }
+
+
+/** @brief Leave the file system driver.
+ */
+    static void PosixLeave( void )
+    {
+        #if REDCONF_FINE_LOCKING == 1
+            PosixLeaveVol( REDCONF_VOLUME_COUNT, false );
+        #else
+            /*  If the driver was uninitialized, PosixEnter() should have failed and we
+             *  should not be calling PosixLeave().
+             */
+            REDASSERT( gfPosixInited );
+
+            #if REDCONF_TASK_COUNT > 1U
+                RedOsMutexRelease();
+            #endif
+        #endif
+    }
+
+
+/** @brief Enter the file system driver to operate on a file descriptor.
+ *
+ *  Without fine-grained locking, this is the same as PosixEnter().
+ *
+ *  @param iFildes  The file descriptor which will be operated upon.
+ *  @param fShared  Whether the operation can run concurrently with other
+ *                  shared operations on the same volume.  Only operations
+ *                  which do not modify the volume may be shared.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The file system driver is uninitialized.
+ *  @retval -RED_EUSERS Cannot become a file system user: too many users.
+ */
+    static REDSTATUS PosixEnterFildes( int32_t iFildes,
+                                       bool fShared )
+    {
+        REDSTATUS ret;
+
+        #if REDCONF_FINE_LOCKING == 1
+            ret = PosixEnterVol( FildesVolume( iFildes ), fShared );
+        #else
+            ( void ) iFildes;
+            ( void ) fShared;
+
+            ret = PosixEnter();
+        #endif
+
+        return ret;
+    }
+
+
+/** @brief Leave the file system driver after operating on a file descriptor.
+ *
+ *  @param iFildes  The file descriptor given to PosixEnterFildes().
+ *  @param fShared  The @p fShared value given to PosixEnterFildes().
+ */
+    static void PosixLeaveFildes( int32_t iFildes,
+                                  bool fShared )
+    {
+        #if REDCONF_FINE_LOCKING == 1
+            PosixLeaveVol( FildesVolume( iFildes ), fShared );
+        #else
+            ( void ) iFildes;
+            ( void ) fShared;
+
+            PosixLeave();
+        #endif
+    }
+
+
+/** @brief Enter the file system driver for an operation which uses the file
+ *         offset of a file descriptor.
+ *
+ *  Like PosixEnterFildes(), except that a shared operation also claims the
+ *  offset of @p iFildes.  Shared operations release the FS mutex while waiting
+ *  on the block device, so two of them using the same file descriptor could
+ *  otherwise start at the same offset.  If another shared operation already
+ *  holds the offset, the volume is locked exclusive instead, which waits for
+ *  that operation to finish.
+ *
+ *  @param iFildes  The file descriptor which will be operated upon.
+ *  @param pfShared On entry, whether the operation can be shared.  On return,
+ *                  the value to give to PosixLeaveOffset().
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The file system driver is uninitialized.
+ *  @retval -RED_EUSERS Cannot become a file system user: too many users.
+ */
+    static REDSTATUS PosixEnterOffset( int32_t iFildes,
+                                       bool * pfShared )
+    {
+        REDSTATUS ret;
+
+        ret = PosixEnterFildes( iFildes, *pfShared );
+
+        #if REDCONF_FINE_LOCKING == 1
+            if( ( ret == 0 ) && *pfShared )
+            {
+                REDHANDLE * pHandle;
+
+                if( FildesToHandle( iFildes, FTYPE_EITHER, &pHandle ) != 0 )
+                {
+                    /*  The caller will report the bad file descriptor.
+                     */
+                }
+                else if( ( pHandle->bFlags & HFLAG_OFFSETBUSY ) == 0U )
+                {
+                    pHandle->bFlags |= HFLAG_OFFSETBUSY;
+                }
+                else
+                {
+                    PosixLeaveFildes( iFildes, true );
+
+                    *pfShared = false;
+                    ret = PosixEnterFildes( iFildes, false );
+                }
+            }
+        #endif
 
         return ret;
     }
 
 
-/** @brief Pack a file descriptor.
- *
- *  @param uHandleIdx   The index of the file handle that will be associated
- *                      with this file descriptor.
- *  @param bVolNum      The volume which contains the file or directory this
- *                      file descriptor was opened against.
+/** @brief Leave the file system driver after an operation which used the file
+ *         offset of a file descriptor.
  *
- *  @return The packed file descriptor.
+ *  @param iFildes  The file descriptor given to PosixEnterOffset().
+ *  @param fShared  The value PosixEnterOffset() returned in its @p pfShared
+ *                  parameter.
  */
-    static int32_t FildesPack( uint16_t uHandleIdx,
-                               uint8_t bVolNum )
+    static void PosixLeaveOffset( int32_t iFildes,
+                                  bool fShared )
     {
-        int32_t iFildes;
+        #if REDCONF_FINE_LOCKING == 1
+            if( fShared )
+            {
+                REDHANDLE * pHandle;
 
-        if( ( uHandleIdx >= REDCONF_HANDLE_COUNT ) || ( bVolNum >= REDCONF_VOLUME_COUNT ) )
-        {
-            REDERROR();
-            iFildes = -1;
-        }
-        else
+                /*  The file descriptor cannot have been closed, since that
+                 *  requires the volume to be locked exclusive.
+                 */
+                if( FildesToHandle( iFildes, FTYPE_EITHER, &pHandle ) == 0 )
+                {
+                    pHandle->bFlags &= ( uint8_t ) ~HFLAG_OFFSETBUSY;
+                }
+            }
+        #endif
+
+        PosixLeaveFildes( iFildes, fShared );
+    }
+
+
+    #if REDCONF_FINE_LOCKING == 1
+
+/** @brief Enter the file system driver with the locks for a volume.
+ *
+ *  Operations on a volume hold the driver-wide lock shared and the volume lock
+ *  shared or exclusive; operations which are not confined to one volume hold
+ *  the driver-wide lock exclusive.  The locks are always taken before the FS
+ *  mutex.
+ *
+ *  While a shared holder owns the FS mutex, the buffer cache is allowed to
+ *  release it across a block device read, so that other tasks can service
+ *  their requests from the cache in the meantime.
+ *
+ *  @param bVolNum  The volume to lock; or #REDCONF_VOLUME_COUNT to lock the
+ *                  whole driver.
+ *  @param fShared  Whether to lock the volume shared or exclusive.  Ignored
+ *                  when locking the whole driver.
+ *
+ *  @return A negated ::REDSTATUS code indicating the operation result.
+ *
+ *  @retval 0           Operation was successful.
+ *  @retval -RED_EINVAL The file system driver is uninitialized.
+ *  @retval -RED_EUSERS Cannot become a file system user: too many users.
+ */
+        static REDSTATUS PosixEnterVol( uint8_t bVolNum,
+                                        bool fShared )
         {
-            uint32_t ulFdBits;
+            REDSTATUS ret;
 
-            REDASSERT( gauGeneration[ bVolNum ] <= FD_GEN_MAX );
-            REDASSERT( gauGeneration[ bVolNum ] != 0U );
+            if( gfPosixInited )
+            {
+                bool fSharedVol = fShared && ( bVolNum < REDCONF_VOLUME_COUNT );
 
-            ulFdBits = gauGeneration[ bVolNum ];
-            ulFdBits <<= FD_VOL_BITS;
-            ulFdBits |= bVolNum;
-            ulFdBits <<= FD_IDX_BITS;
-            ulFdBits |= uHandleIdx;
+                PosixLock( bVolNum, fSharedVol );
 
-            iFildes = ( int32_t ) ulFdBits;
+                RedOsMutexAcquire();
 
-            if( iFildes < FD_MIN )
+                ret = TaskRegister( NULL );
+
+                if( ret == 0 )
+                {
+                    RedCoreUnlockedReads( fSharedVol );
+                }
+                else
+                {
+                    RedOsMutexRelease();
+
+                    PosixUnlock( bVolNum, fSharedVol );
+                }
+            }
+            else
             {
-                REDERROR();
-                iFildes = -1;
+                ret = -RED_EINVAL;
             }
-        }
 
-        return iFildes;
-    }
+            return ret;
+        }
 
 
-/** @brief Unpack a file descriptor.
+/** @brief Leave the file system driver and release the locks for a volume.
  *
- *  @param iFildes      The file descriptor to unpack.
- *  @param puHandleIdx  If non-NULL, populated with the handle index extracted
- *                      from the file descriptor.
- *  @param pbVolNum     If non-NULL, populated with the volume number extracted
- *                      from the file descriptor.
- *  @param puGeneration If non-NULL, populated with the generation number
- *                      extracted from the file descriptor.
+ *  @param bVolNum  The @p bVolNum value given to PosixEnterVol().
+ *  @param fShared  The @p fShared value given to PosixEnterVol().
  */
-    static void FildesUnpack( int32_t iFildes,
-                              uint16_t * puHandleIdx,
-                              uint8_t * pbVolNum,
-                              uint16_t * puGeneration )
-    {
-        uint32_t ulFdBits = ( uint32_t ) iFildes;
+        static void PosixLeaveVol( uint8_t bVolNum,
+                                   bool fShared )
+        {
+            REDASSERT( gfPosixInited );
 
-        REDASSERT( iFildes >= FD_MIN );
+            RedCoreUnlockedReads( false );
 
-        if( puHandleIdx != NULL )
-        {
-            *puHandleIdx = ( uint16_t ) ( ulFdBits & FD_IDX_MAX );
+            RedOsMutexRelease();
+
+            PosixUnlock( bVolNum, fShared && ( bVolNum < REDCONF_VOLUME_COUNT ) );
         }
 
-        ulFdBits >>= FD_IDX_BITS;
 
-        if( pbVolNum != NULL )
+/** @brief Acquire the locks for a volume, or for the whole driver.
+ *
+ *  @param bVolNum  The volume to lock; or #REDCONF_VOLUME_COUNT to lock the
+ *                  whole driver exclusively.
+ *  @param fShared  Whether to lock the volume shared or exclusive.
+ */
+        static void PosixLock( uint8_t bVolNum,
+                               bool fShared )
         {
-            *pbVolNum = ( uint8_t ) ( ulFdBits & FD_VOL_MAX );
+            if( bVolNum < REDCONF_VOLUME_COUNT )
+            {
+                RwLockAcquire( REDCONF_VOLUME_COUNT, true );
+                RwLockAcquire( bVolNum, fShared );
+            }
+            else
+            {
+                RwLockAcquire( REDCONF_VOLUME_COUNT, false );
+            }
         }
 
-        ulFdBits >>= FD_VOL_BITS;
 
-        if( puGeneration != NULL )
+/** @brief Release the locks acquired by PosixLock().
+ *
+ *  @param bVolNum  The @p bVolNum value given to PosixLock().
+ *  @param fShared  The @p fShared value given to PosixLock().
+ */
+        static void PosixUnlock( uint8_t bVolNum,
+                                 bool fShared )
         {
-            *puGeneration = ( uint16_t ) ( ulFdBits & FD_GEN_MAX );
+            if( bVolNum < REDCONF_VOLUME_COUNT )
+            {
+                RwLockRelease( bVolNum, fShared );
+                RwLockRelease( REDCONF_VOLUME_COUNT, true );
+            }
+            else
+            {
+                RwLockRelease( REDCONF_VOLUME_COUNT, false );
+            }
         }
-    }
 
 
-    #if REDCONF_API_POSIX_READDIR == 1
-
-/** @brief Validate a directory stream object.
- *
- *  @param pDirStream   The directory stream to validate.
+/** @brief Acquire a reader/writer lock.
  *
- *  @return Whether the directory stream is valid.
+ *  Each lock is a pair of semaphores: a counting semaphore with one token per
+ *  task, and a binary semaphore which serializes writers.  A reader takes one
+ *  token; a writer takes all of them, which waits out existing readers and
+ *  keeps new ones out.  So that a steady stream of readers cannot starve a
+ *  writer which is still taking tokens, a new reader first waits on the
+ *  writer semaphore whenever a writer is waiting.
  *
- *  @retval true    The directory stream object appears valid.
- *  @retval false   The directory stream object is invalid.
+ *  @param bLock    The lock to acquire: a volume number, or
+ *                  #REDCONF_VOLUME_COUNT for the driver-wide lock.
+ *  @param fShared  Whether to acquire the lock shared or exclusive.
  */
-        static bool DirStreamIsValid( const REDDIR * pDirStream )
+        static void RwLockAcquire( uint8_t bLock,
+                                   bool fShared )
         {
-            bool fRet = true;
-
-            if( pDirStream == NULL )
+            if( fShared )
             {
-                fRet = false;
+                bool fWriterWaiting;
+
+                RedOsMutexAcquire();
+                fWriterWaiting = gaulWritersWaiting[ bLock ] > 0U;
+                RedOsMutexRelease();
+
+                if( fWriterWaiting )
+                {
+                    ( void ) RedOsSemaphoreTake( RED_SEM_LOCK_WRITER( bLock ), true );
+                    RedOsSemaphoreGive( RED_SEM_LOCK_WRITER( bLock ) );
+                }
+
+                ( void ) RedOsSemaphoreTake( RED_SEM_LOCK_TOKENS( bLock ), true );
             }
             else
             {
-                uint16_t uHandleIdx;
+                uint32_t ulToken;
 
-                /*  pDirStream should be a pointer to one of the handles.
-                 *
-                 *  A good compiler will optimize this loop into a bounds check and an
-                 *  alignment check.
-                 */
-                for( uHandleIdx = 0U; uHandleIdx < REDCONF_HANDLE_COUNT; uHandleIdx++ )
-                {
-                    if( pDirStream == &gaHandle[ uHandleIdx ] )
-                    {
-                        break;
-                    }
-                }
+                RedOsMutexAcquire();
+                gaulWritersWaiting[ bLock ]++;
+                RedOsMutexRelease();
 
-                if( uHandleIdx < REDCONF_HANDLE_COUNT )
-                {
-                    /*  The handle must be in use, have a valid volume number, and be a
-                     *  directory handle.
-                     */
-                    if( ( pDirStream->ulInode == INODE_INVALID ) ||
-                        ( pDirStream->bVolNum >= REDCONF_VOLUME_COUNT ) ||
-                        ( ( pDirStream->bFlags & HFLAG_DIRECTORY ) == 0U ) )
-                    {
-                        fRet = false;
-                    }
-                }
-                else
+                ( void ) RedOsSemaphoreTake( RED_SEM_LOCK_WRITER( bLock ), true );
+
+                for( ulToken = 0U; ulToken < REDCONF_TASK_COUNT; ulToken++ )
                 {
-                    /*  pDirStream is a non-null pointer, but it is not a pointer to one
-                     *  of our handles.
-                     */
-                    fRet = false;
+                    ( void ) RedOsSemaphoreTake( RED_SEM_LOCK_TOKENS( bLock ), true );
                 }
+
+                RedOsMutexAcquire();
+                REDASSERT( gaulWritersWaiting[ bLock ] > 0U );
+                gaulWritersWaiting[ bLock ]--;
+                RedOsMutexRelease();
+
+                RedOsSemaphoreGive( RED_SEM_LOCK_WRITER( bLock ) );
             }
+        }
 
-            return fRet;
+
+/** @brief Release a reader/writer lock.
+ *
+ *  @param bLock    The lock to release.
+ *  @param fShared  Whether the lock was acquired shared or exclusive.
+ */
+        static void RwLockRelease( uint8_t bLock,
+                                   bool fShared )
+        {
+            uint32_t ulTokens = fShared ? 1U : REDCONF_TASK_COUNT;
+            uint32_t ulToken;
+
+            for( ulToken = 0U; ulToken < ulTokens; ulToken++ )
+            {
+                RedOsSemaphoreGive( RED_SEM_LOCK_TOKENS( bLock ) );
+            }
         }
-    #endif /* if REDCONF_API_POSIX_READDIR == 1 */
 
 
-/** @brief Enter the file system driver.
+/** @brief Determine which volume a file descriptor belongs to.
  *
- *  @return A negated ::REDSTATUS code indicating the operation result.
+ *  The file descriptor is not validated beyond its volume number; that is left
+ *  to FildesToHandle(), once the locks are held.
  *
- *  @retval 0           Operation was successful.
- *  @retval -RED_EINVAL The file system driver is uninitialized.
- *  @retval -RED_EUSERS Cannot become a file system user: too many users.
+ *  @param iFildes  The file descriptor.
+ *
+ *  @return The volume number encoded in @p iFildes; or #REDCONF_VOLUME_COUNT if
+ *          @p iFildes does not encode a valid volume number.
  */
-    static REDSTATUS PosixEnter( void )
-    {
-        REDSTATUS ret;
-
-        if( gfPosixInited )
+        static uint8_t FildesVolume( int32_t iFildes )
         {
-            #if REDCONF_TASK_COUNT > 1U
-                RedOsMutexAcquire();
+            uint8_t bVolNum;
 
-                ret = TaskRegister( NULL );
+            if( iFildes < FD_MIN )
+            {
+                bVolNum = REDCONF_VOLUME_COUNT;
+            }
+            else
+            {
+                FildesUnpack( iFildes, NULL, &bVolNum, NULL );
 
-                if( ret != 0 )
+                if( bVolNum > REDCONF_VOLUME_COUNT )
                 {
-                    RedOsMutexRelease();
+                    bVolNum = REDCONF_VOLUME_COUNT;
                 }
-            #else
-                ret = 0;
-            #endif
-        }
-        else
-        {
-            ret = -RED_EINVAL;
-        }
-
-        return ret;
-    }
-
-
-/** @brief Leave the file system driver.
- */
-    static void PosixLeave( void )
-    {
-        /*  If the driver was uninitialized, PosixEnter() should have failed and we
-         *  should not be calling PosixLeave().
-         */
-        REDASSERT( gfPosixInited );
+            }
 
-        #if REDCONF_TASK_COUNT > 1U
-            RedOsMutexRelease();
-        #endif
-    }
+            return bVolNum;
+        }
+    #endif /* if REDCONF_FINE_LOCKING == 1 */
 
 
 /** @brief Check that a mode is consistent with the given expected type.
@@ -3079,6 +4424,42 @@
     #endif /* REDCONF_TASK_COUNT > 1U */
 
 
+    #if REDCONF_TRANSACT_BACKGROUND == 1
+
+/** @brief Commit the deferred transaction points of all mounted volumes.
+ *
+ *  Called by the background commit task each time it is woken.
+ */
+        static void PosixCommit( void )
+        {
+            if( PosixEnter() == 0 )
+            {
+                uint8_t bVolNum;
+
+                for( bVolNum = 0U; bVolNum < REDCONF_VOLUME_COUNT; bVolNum++ )
+                {
+                    if( gaRedVolume[ bVolNum ].fMounted )
+                    {
+                        #if REDCONF_VOLUME_COUNT > 1U
+                            ( void ) RedCoreVolSetCurrent( bVolNum );
+                        #endif
+
+                        /*  There is nobody to report an error to.  A failed
+                         *  transaction point stays pending, but is not retried
+                         *  here: further events do not wake this task again
+                         *  while it is pending.  red_transactwait() retries it
+                         *  and reports the error.
+                         */
+                        ( void ) RedCoreVolTransactPending();
+                    }
+                }
+
+                PosixLeave();
+            }
+        }
+    #endif /* REDCONF_TRANSACT_BACKGROUND == 1 */
+
+
 /** @brief Convert an error value into a simple 0 or -1 return.
  *
  *  This function is simple, but what it does is needed in many places.  It
@@ -459,6 +459,8 @@
         OP_TRUNCATE,
         OP_UNLINK,
         OP_WRITE,
+        OP_APPEND,
+        OP_RANDREAD,
         #if REDCONF_CHECKER == 1
             OP_CHECK,
         #endif
@@ -543,6 +545,10 @@
                           long r );
     static void write_f( int opno,
                          long r );
+    static void append_f( int opno,
+                          long r );
+    static void randread_f( int opno,
+                            long r );
     #if REDCONF_CHECKER == 1
         static void check_f( int opno,
                              long r );
@@ -563,11 +569,90 @@
         { OP_TRUNCATE,  "truncate",  truncate_f,  2, 1 },
         { OP_UNLINK,    "unlink",    unlink_f,    1, 1 },
         { OP_WRITE,     "write",     write_f,     4, 1 },
+
+        /*  Only used by the benchmark profiles.
+         */
+        { OP_APPEND,    "append",    append_f,    0, 1 },
+        { OP_RANDREAD,  "randread",  randread_f,  0, 0 },
         #if REDCONF_CHECKER == 1
         { OP_CHECK,     "check",     check_f,     1, 1 },
         #endif
     }, * ops_end;
 
+/*  Benchmark mode (--bench) replaces the random operation mix with the fixed
+ *  mix of a profile.  The warm-up operations run first and are not measured;
+ *  the measured operations are then timed individually.
+ */
+    typedef struct benchmix
+    {
+        opty_t op;
+        int freq;
+    } benchmix_t;
+
+    typedef struct benchprof
+    {
+        const char * name;
+        uint32_t iosize;            /* Bytes per append or randread. */
+        uint32_t filesize;          /* Size at which append starts a file over. */
+        const benchmix_t * warmup;  /* Mix for the warm-up operations. */
+        const benchmix_t * measure; /* Mix for the measured operations. */
+    } benchprof_t;
+
+    typedef struct benchsample
+    {
+        opty_t op;
+        uint32_t usecs;
+    } benchsample_t;
+
+    #define BENCH_SEED    1U /* Seed used by --bench unless --seed is given. */
+
+    static const benchmix_t mix_metadata[] =
+    {
+        { OP_CREAT,    4 },
+        { OP_APPEND,   4 },
+        { OP_FSYNC,    1 },
+        { OP_GETDENTS, 1 },
+        { OP_LINK,     1 },
+        { OP_MKDIR,    1 },
+        { OP_RENAME,   2 },
+        { OP_RMDIR,    1 },
+        { OP_STAT,     4 },
+        { OP_UNLINK,   5 },
+        { OP_LAST,     0 }
+    };
+
+    static const benchmix_t mix_seqwrite[] =
+    {
+        { OP_CREAT,     1  },
+        { OP_APPEND,    32 },
+        { OP_FDATASYNC, 1  },
+        { OP_UNLINK,    2  },
+        { OP_LAST,      0  }
+    };
+
+    static const benchmix_t mix_fill[] =
+    {
+        { OP_CREAT,  1  },
+        { OP_APPEND, 16 },
+        { OP_LAST,   0  }
+    };
+
+    static const benchmix_t mix_randread[] =
+    {
+        { OP_RANDREAD, 1 },
+        { OP_LAST,     0 }
+    };
+
+/*  Indexed by FSSTRESS_BENCH_* value less one.  Unlinks outnumber creates in
+ *  the mixes which write, so that the volume does not fill up.
+ */
+    static const benchprof_t benchprofs[] =
+    {
+        { "metadata", 512U,         4096U,          mix_metadata, mix_metadata },
+        { "seqwrite", 32U * 1024U,  1024U * 1024U,  mix_seqwrite, mix_seqwrite },
+        { "randread", 4096U,        256U * 1024U,   mix_fill,     mix_randread }
+    };
+
     static flist_t flist[ FT_nft ] =
     {
         { 0, 0, 'd', NULL },
@@ -593,6 +678,10 @@
     static unsigned long seed = 0;
     static ino_t top_ino;
     static int verbose = 0;
+    static const benchprof_t * bench;
+    static char * benchbuf;
+    static uint64_t benchbytes;
+    static int warmup;
 
     static int delete_tree( const char * path );
     static void add_to_flist( int fd,
@@ -611,6 +700,13 @@
     static void del_from_flist( int ft,
                                 int slot );
     static void doproc( void );
+    static void dobench( void );
+    static void bench_freq_table( const benchmix_t * mix );
+    static void bench_sync( void );
+    static int bench_compare( const void * a,
+                              const void * b );
+    static void bench_report( benchsample_t * samples,
+                              uint64_t usecs );
     static void fent_to_name( pathname_t * name,
                               flist_t * flp,
                               fent_t * fep );
@@ -677,12 +773,14 @@
         uint8_t bVolNum;
         const REDOPTION aLongopts[] =
         {
+            { "bench",      red_required_argument, NULL, 'b' },
             { "no-cleanup", red_no_argument,       NULL, 'c' },
             { "loops",      red_required_argument, NULL, 'l' },
             { "nops",       red_required_argument, NULL, 'n' },
             { "namepad",    red_no_argument,       NULL, 'r' },
             { "seed",       red_required_argument, NULL, 's' },
             { "verbose",    red_no_argument,       NULL, 'v' },
+            { "warmup",     red_required_argument, NULL, 'w' },
             { "dev",        red_required_argument, NULL, 'D' },
             { "help",       red_no_argument,       NULL, 'H' },
             { NULL }
@@ -706,10 +804,33 @@
          */
         FsstressDefaultParams( pParam );
 
-        while( ( c = RedGetoptLong( argc, argv, "cl:n:rs:vD:H", aLongopts, NULL ) ) != -1 )
+        while( ( c = RedGetoptLong( argc, argv, "b:cl:n:rs:vw:D:H", aLongopts, NULL ) ) != -1 )
         {
             switch( c )
             {
+                case 'b': /* --bench */
+                {
+                    uint8_t bProf;
+
+                    pParam->bBench = FSSTRESS_BENCH_NONE;
+
+                    for( bProf = 0U; bProf < ( sizeof( benchprofs ) / sizeof( benchprofs[ 0 ] ) ); bProf++ )
+                    {
+                        if( strcmp( red_optarg, benchprofs[ bProf ].name ) == 0 )
+                        {
+                            pParam->bBench = bProf + 1U;
+                        }
+                    }
+
+                    if( pParam->bBench == FSSTRESS_BENCH_NONE )
+                    {
+                        RedPrintf( "Error: \"%s\" is not a benchmark profile.\n", red_optarg );
+                        goto BadOpt;
+                    }
+
+                    break;
+                }
+
                 case 'c': /* --no-cleanup */
                     pParam->fNoCleanup = true;
                     break;
@@ -734,6 +855,10 @@
                     pParam->fVerbose = true;
                     break;
 
+                case 'w': /* --warmup */
+                    pParam->ulWarmup = RedAtoI( red_optarg );
+                    break;
+
                 case 'D': /* --dev */
 
                     if( ppszDevice != NULL )
@@ -813,6 +938,7 @@ Help:
         RedMemSet( pParam, 0U, sizeof( *pParam ) );
         pParam->ulLoops = 1U;
         pParam->ulNops = 10000U;
+        pParam->ulWarmup = 1000U;
     }
 
 
@@ -843,9 +969,34 @@ Help:
         namerand = pParam->fNamePad ? 1 : 0;
         seed = pParam->ulSeed;
         verbose = pParam->fVerbose ? 1 : 0;
+        warmup = pParam->ulWarmup;
+        bench = NULL;
 
         make_freq_table();
 
+        if( pParam->bBench != FSSTRESS_BENCH_NONE )
+        {
+            bench = &benchprofs[ pParam->bBench - 1U ];
+
+            /*  Results are only comparable if every run does the same
+             *  operations.
+             */
+            if( !seed )
+            {
+                seed = BENCH_SEED;
+            }
+
+            benchbuf = malloc( bench->iosize );
+
+            if( benchbuf == NULL )
+            {
+                RedPrintf( "fsstress: out of memory\n" );
+                return 1;
+            }
+
+            memset( benchbuf, 0xA5, bench->iosize );
+        }
+
         while( ( loopcntr <= loops ) || ( loops == 0 ) )
         {
             RedSNPrintf( buf, sizeof( buf ), "fss%x", getpid() );
@@ -880,6 +1031,9 @@ Help:
             loopcntr++;
         }
 
+        free( benchbuf );
+        benchbuf = NULL;
+
         return 0;
     }
 
@@ -1146,19 +1300,223 @@ Help:
             namerand = random();
         }
 
+        if( bench != NULL )
+        {
+            dobench();
+        }
+        else
+        {
+            for( opno = 0; opno < operations; opno++ )
+            {
+                p = &ops[ freq_table[ random() % freq_table_size ] ];
+
+                if( ( unsigned long ) p->func < 4096 )
+                {
+                    abort();
+                }
+
+                p->func( opno, random() );
+            }
+        }
+
+        free( homedir );
+    }
+
+/** @brief Run the warm-up and measured operations of a benchmark profile and
+ *         report the results.
+ */
+    static void dobench( void )
+    {
+        benchsample_t * samples;
+        REDTIMESTAMP ts;
+        uint64_t usecs;
+        int opno;
+        opdesc_t * p;
+
+        #if REDCONF_STATISTICS == 1
+            REDSTATS before;
+            REDSTATS after;
+        #endif
+
+        samples = malloc( MAX( operations, 1 ) * sizeof( *samples ) );
+
+        if( samples == NULL )
+        {
+            RedPrintf( "fsstress: out of memory\n" );
+            return;
+        }
+
+        bench_freq_table( bench->warmup );
+
+        for( opno = 0; opno < warmup; opno++ )
+        {
+            p = &ops[ freq_table[ random() % freq_table_size ] ];
+            p->func( opno, random() );
+        }
+
+        /*  Start measuring at a transaction point, so that the measured
+         *  operations do not pay for committing the warm-up.
+         */
+        bench_sync();
+        bench_freq_table( bench->measure );
+        benchbytes = 0U;
+
+        #if REDCONF_STATISTICS == 1
+            ( void ) red_getstats( &before, false );
+        #endif
+
+        ts = RedOsTimestamp();
+
         for( opno = 0; opno < operations; opno++ )
         {
+            REDTIMESTAMP tsop;
+            long r;
+
             p = &ops[ freq_table[ random() % freq_table_size ] ];
+            r = random();
+
+            tsop = RedOsTimestamp();
+            p->func( opno, r );
+            samples[ opno ].op = p->op;
+            samples[ opno ].usecs = ( uint32_t ) MIN( RedOsTimePassed( tsop ), UINT32_MAX );
+        }
+
+        /*  The measured work is not done until it is committed.
+         */
+        bench_sync();
+        usecs = RedOsTimePassed( ts );
+
+        bench_report( samples, usecs );
+
+        #if REDCONF_STATISTICS == 1
+            ( void ) red_getstats( &after, false );
+
+            RedPrintf( "block device: %u reads (%llu KB), %u writes (%llu KB), %u flushes, %u discards; %u transaction points\n",
+                       ( unsigned ) ( after.io.ulReads - before.io.ulReads ),
+                       ( unsigned long long ) ( ( after.io.ullReadBytes - before.io.ullReadBytes ) / 1024U ),
+                       ( unsigned ) ( after.io.ulWrites - before.io.ulWrites ),
+                       ( unsigned long long ) ( ( after.io.ullWriteBytes - before.io.ullWriteBytes ) / 1024U ),
+                       ( unsigned ) ( after.io.ulFlushes - before.io.ulFlushes ),
+                       ( unsigned ) ( after.io.ulDiscards - before.io.ulDiscards ),
+                       ( unsigned ) ( after.transact.ulCount - before.transact.ulCount ) );
+        #else
+            RedPrintf( "block device: command counts need REDCONF_STATISTICS\n" );
+        #endif
+
+        free( samples );
+    }
+
+/** @brief Replace the operation frequency table with one for a benchmark mix.
+ */
+    static void bench_freq_table( const benchmix_t * mix )
+    {
+        const benchmix_t * m;
+        int f;
+        int i;
 
-            if( ( unsigned long ) p->func < 4096 )
+        for( m = mix, f = 0; m->op != OP_LAST; m++ )
+        {
+            f += m->freq;
+        }
+
+        free( freq_table );
+        freq_table = malloc( f * sizeof( *freq_table ) );
+        freq_table_size = f;
+
+        for( m = mix, i = 0; m->op != OP_LAST; m++ )
+        {
+            for( f = 0; f < m->freq; f++, i++ )
             {
-                abort();
+                freq_table[ i ] = m->op;
             }
+        }
+    }
 
-            p->func( opno, random() );
+/** @brief Commit the benchmark's changes to the volume.
+ */
+    static void bench_sync( void )
+    {
+        int fd;
+
+        fd = open( ".", O_RDONLY );
+
+        if( fd >= 0 )
+        {
+            ( void ) fsync( fd );
+            close( fd );
         }
+    }
 
-        free( homedir );
+/** @brief qsort() comparison for benchmark samples: by operation, then by
+ *         latency.
+ */
+    static int bench_compare( const void * a,
+                              const void * b )
+    {
+        const benchsample_t * sa = a;
+        const benchsample_t * sb = b;
+
+        if( sa->op != sb->op )
+        {
+            return ( sa->op < sb->op ) ? -1 : 1;
+        }
+
+        if( sa->usecs != sb->usecs )
+        {
+            return ( sa->usecs < sb->usecs ) ? -1 : 1;
+        }
+
+        return 0;
+    }
+
+/** @brief Print the throughput and per-operation latencies of a benchmark.
+ *
+ *  @param samples  The latency of each measured operation; sorted by this
+ *                  function.
+ *  @param usecs    Time taken by the measured operations, in microseconds.
+ */
+    static void bench_report( benchsample_t * samples,
+                              uint64_t usecs )
+    {
+        uint64_t hundredths;
+        int i;
+        int j;
+
+        if( usecs == 0U )
+        {
+            usecs = 1U;
+        }
+
+        /*  One byte per microsecond is one MB (10^6 bytes) per second.
+         */
+        hundredths = ( benchbytes * 100U ) / usecs;
+
+        RedPrintf( "bench %s: seed %lu, %d warm-up ops, %d measured ops in %llu ms\n",
+                   bench->name, seed, warmup, operations, ( unsigned long long ) ( usecs / 1000U ) );
+        RedPrintf( "throughput: %llu ops/sec, %llu.%02llu MB/s\n",
+                   ( unsigned long long ) ( ( ( uint64_t ) operations * 1000000U ) / usecs ),
+                   ( unsigned long long ) ( hundredths / 100U ), ( unsigned long long ) ( hundredths % 100U ) );
+
+        qsort( samples, operations, sizeof( *samples ), bench_compare );
+
+        RedPrintf( "%-10s %8s %10s %10s\n", "op", "count", "p50 us", "p99 us" );
+
+        for( i = 0; i < operations; i = j )
+        {
+            int n;
+
+            j = i + 1;
+
+            while( ( j < operations ) && ( samples[ j ].op == samples[ i ].op ) )
+            {
+                j++;
+            }
+
+            n = j - i;
+            RedPrintf( "%-10s %8d %10u %10u\n", ops[ samples[ i ].op ].name, n,
+                       ( unsigned ) samples[ i + ( ( ( n - 1 ) * 50 ) / 100 ) ].usecs,
+                       ( unsigned ) samples[ i + ( ( ( n - 1 ) * 99 ) / 100 ) ].usecs );
+        }
     }
 
     static void fent_to_name( pathname_t * name,
@@ -1839,6 +2197,17 @@ Help:
         RedPrintf( "      A volume number (e.g., 2) or a volume path prefix (e.g., VOL1: or /data)\n" );
         RedPrintf( "      of the volume to test.\n" );
         RedPrintf( "And 'Options' are any of the following:\n" );
+        RedPrintf( "  --bench=profile, -b profile\n" );
+        RedPrintf( "      Instead of a random mix of operations, run a fixed mix and report ops/sec,\n" );
+        RedPrintf( "      MB/s, the p50 and p99 latency of each operation, and (with\n" );
+        RedPrintf( "      REDCONF_STATISTICS) block device command counts.  The seed defaults to\n" );
+        RedPrintf( "      %u.  The profile is one of:\n", ( unsigned ) BENCH_SEED );
+        RedPrintf( "        metadata: create, rename, link and unlink small files and directories\n" );
+        RedPrintf( "        seqwrite: large sequential writes\n" );
+        RedPrintf( "        randread: random reads of files written during the warm-up\n" );
+        RedPrintf( "  --warmup=count, -w count\n" );
+        RedPrintf( "      With --bench, the number of operations to run before measuring (default\n" );
+        RedPrintf( "      1000).  --nops is the number measured.\n" );
         RedPrintf( "  --no-cleanup, -c\n" );
         RedPrintf( "      Specifies not to remove files (cleanup) after execution\n" );
         RedPrintf( "  --loops=count, -l count\n" );
@@ -2593,6 +2962,172 @@ Help:
         close( fd );
     }
 
+/*  Write the next bench->iosize bytes of a file, starting it over once it
+ *  reaches bench->filesize.
+ */
+    static void append_f( int opno,
+                          long r )
+    {
+        int e;
+        pathname_t f;
+        int fd;
+        int32_t len;
+        off64_t off;
+        REDSTAT stb;
+        int v;
+
+        init_pathname( &f );
+
+        if( !get_fname( FT_REGm, r, &f, NULL, NULL, &v ) )
+        {
+            if( v )
+            {
+                RedPrintf( "%d/%d: append - no filename\n", procid, opno );
+            }
+
+            free_pathname( &f );
+            return;
+        }
+
+        fd = open_path( &f, O_WRONLY );
+        e = fd < 0 ? errno : 0;
+        check_cwd();
+
+        if( fd < 0 )
+        {
+            if( v )
+            {
+                RedPrintf( "%d/%d: append - open %s failed %d\n",
+                           procid, opno, f.path, e );
+            }
+
+            free_pathname( &f );
+            return;
+        }
+
+        if( fstat64( fd, &stb ) < 0 )
+        {
+            if( v )
+            {
+                RedPrintf( "%d/%d: append - fstat64 %s failed %d\n",
+                           procid, opno, f.path, errno );
+            }
+
+            free_pathname( &f );
+            close( fd );
+            return;
+        }
+
+        off = ( off64_t ) stb.st_size;
+
+        if( ( uint64_t ) off + bench->iosize > bench->filesize )
+        {
+            off = 0;
+            ( void ) ftruncate( fd, 0 );
+        }
+
+        lseek64( fd, off, SEEK_SET );
+        len = write( fd, benchbuf, bench->iosize );
+        e = len < 0 ? errno : 0;
+
+        if( len > 0 )
+        {
+            benchbytes += ( uint64_t ) len;
+        }
+
+        if( v )
+        {
+            RedPrintf( "%d/%d: append %s [%lld,%ld] %d\n",
+                       procid, opno, f.path, ( long long ) off, ( long int ) bench->iosize, e );
+        }
+
+        free_pathname( &f );
+        close( fd );
+    }
+
+/*  Read bench->iosize bytes from a random offset in a file.
+ */
+    static void randread_f( int opno,
+                            long r )
+    {
+        int e;
+        pathname_t f;
+        int fd;
+        int32_t len;
+        __int64_t lr;
+        off64_t off;
+        REDSTAT stb;
+        int v;
+
+        init_pathname( &f );
+
+        if( !get_fname( FT_REGFILE, r, &f, NULL, NULL, &v ) )
+        {
+            if( v )
+            {
+                RedPrintf( "%d/%d: randread - no filename\n", procid, opno );
+            }
+
+            free_pathname( &f );
+            return;
+        }
+
+        fd = open_path( &f, O_RDONLY );
+        e = fd < 0 ? errno : 0;
+        check_cwd();
+
+        if( fd < 0 )
+        {
+            if( v )
+            {
+                RedPrintf( "%d/%d: randread - open %s failed %d\n",
+                           procid, opno, f.path, e );
+            }
+
+            free_pathname( &f );
+            return;
+        }
+
+        if( fstat64( fd, &stb ) < 0 )
+        {
+            if( v )
+            {
+                RedPrintf( "%d/%d: randread - fstat64 %s failed %d\n",
+                           procid, opno, f.path, errno );
+            }
+
+            free_pathname( &f );
+            close( fd );
+            return;
+        }
+
+        off = 0;
+
+        if( stb.st_size > ( off64_t ) bench->iosize )
+        {
+            lr = ( ( __int64_t ) random() << 32 ) + random();
+            off = ( off64_t ) ( lr % ( stb.st_size - bench->iosize + 1 ) );
+        }
+
+        lseek64( fd, off, SEEK_SET );
+        len = read( fd, benchbuf, bench->iosize );
+        e = len < 0 ? errno : 0;
+
+        if( len > 0 )
+        {
+            benchbytes += ( uint64_t ) len;
+        }
+
+        if( v )
+        {
+            RedPrintf( "%d/%d: randread %s [%lld,%ld] %d\n",
+                       procid, opno, f.path, ( long long ) off, ( long int ) bench->iosize, e );
+        }
+
+        free_pathname( &f );
+        close( fd );
+    }
+
 
     #if REDCONF_CHECKER == 1
         static void check_f( int opno,
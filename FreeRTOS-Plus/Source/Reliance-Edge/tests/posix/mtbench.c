@@ -0,0 +1,511 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Multi-task throughput benchmark for the POSIX-like API.
+ *
+ *  Several tasks hammer the same volume at once: most of them read small
+ *  random ranges from a shared file which fits in the buffer cache, and the
+ *  rest write small random ranges to files of their own.  The aggregate
+ *  operations per second show how well the file system lets tasks proceed in
+ *  parallel, e.g. with and without REDCONF_FINE_LOCKING.
+ *
+ *  The test does not create tasks itself, since there is no portable way to do
+ *  so.  The host calls MtBenchPrepare(), then runs MtBenchTask() from the given
+ *  number of tasks, then calls MtBenchFinish() once all of those tasks have
+ *  returned.
+ */
+#include <redfs.h>
+#include <redposix.h>
+#include <redtests.h>
+
+#if MTBENCH_SUPPORTED
+
+    #include <redvolume.h>
+    #include <redgetopt.h>
+    #include <redtoolcmn.h>
+
+
+/*  Largest supported I/O size.
+ */
+    #define MTBENCH_IO_MAX    REDCONF_BLOCK_SIZE
+
+/*  Longest path name used by the benchmark, including the volume prefix.
+ */
+    #define MTBENCH_PATH_MAX    ( REDCONF_NAME_MAX + 32U )
+
+
+/*  Per-task results.
+ */
+    typedef struct
+    {
+        uint32_t ulOps;     /* Number of operations completed. */
+        uint64_t ullUsecs;  /* Microseconds spent on them. */
+        REDSTATUS iErrno;   /* Error which stopped the task; zero if none. */
+    } MTBENCHRESULT;
+
+
+    static void MtBenchPath( uint32_t ulTaskIdx,
+                             char * pszPath );
+    static void usage( const char * pszProgName );
+
+
+    static MTBENCHPARAM gParam;
+    static uint8_t gbVolNum;
+    static MTBENCHRESULT gaResult[ REDCONF_TASK_COUNT ];
+    static uint8_t gaabBuffer[ REDCONF_TASK_COUNT ][ MTBENCH_IO_MAX ];
+
+
+/** @brief Parse parameters for the multi-task benchmark.
+ *
+ *  @param argc         The number of arguments from main().
+ *  @param argv         The vector of arguments from main().
+ *  @param pParam       Populated with the benchmark parameters.
+ *  @param pbVolNum     If non-NULL, populated with the volume number.
+ *  @param ppszDevice   If non-NULL, populated with the device name argument or
+ *                      NULL if no device argument is provided.
+ *
+ *  @return The result of parsing the parameters.
+ */
+    PARAMSTATUS MtBenchParseParams( int argc,
+                                    char * argv[],
+                                    MTBENCHPARAM * pParam,
+                                    uint8_t * pbVolNum,
+                                    const char ** ppszDevice )
+    {
+        int c;
+        uint8_t bVolNum;
+        const REDOPTION aLongopts[] =
+        {
+            { "tasks",    red_required_argument, NULL, 't' },
+            { "writers",  red_required_argument, NULL, 'w' },
+            { "ops",      red_required_argument, NULL, 'n' },
+            { "filesize", red_required_argument, NULL, 'f' },
+            { "iosize",   red_required_argument, NULL, 'i' },
+            { "seed",     red_required_argument, NULL, 's' },
+            { "dev",      red_required_argument, NULL, 'D' },
+            { "help",     red_no_argument,       NULL, 'H' },
+            { NULL }
+        };
+
+        /*  If run without parameters, treat as a help request.
+         */
+        if( argc <= 1 )
+        {
+            goto Help;
+        }
+
+        /*  Assume no device argument to start with.
+         */
+        if( ppszDevice != NULL )
+        {
+            *ppszDevice = NULL;
+        }
+
+        /*  Set default parameters.
+         */
+        MtBenchDefaultParams( pParam );
+
+        while( ( c = RedGetoptLong( argc, argv, "t:w:n:f:i:s:D:H", aLongopts, NULL ) ) != -1 )
+        {
+            switch( c )
+            {
+                case 't': /* --tasks */
+                    pParam->ulTasks = RedAtoI( red_optarg );
+                    break;
+
+                case 'w': /* --writers */
+                    pParam->ulWriters = RedAtoI( red_optarg );
+                    break;
+
+                case 'n': /* --ops */
+                    pParam->ulOps = RedAtoI( red_optarg );
+                    break;
+
+                case 'f': /* --filesize */
+                    pParam->ulFileSize = RedAtoI( red_optarg );
+                    break;
+
+                case 'i': /* --iosize */
+                    pParam->ulIoSize = RedAtoI( red_optarg );
+                    break;
+
+                case 's': /* --seed */
+                    pParam->ulSeed = RedAtoI( red_optarg );
+                    break;
+
+                case 'D': /* --dev */
+
+                    if( ppszDevice != NULL )
+                    {
+                        *ppszDevice = red_optarg;
+                    }
+
+                    break;
+
+                case 'H': /* --help */
+                    goto Help;
+
+                case '?': /* Unknown or ambiguous option */
+                case ':': /* Option missing required argument */
+                default:
+                    goto BadOpt;
+            }
+        }
+
+        if( ( pParam->ulTasks == 0U ) || ( pParam->ulTasks > REDCONF_TASK_COUNT ) )
+        {
+            RedPrintf( "Error: --tasks must be between 1 and %u.\n", ( unsigned ) REDCONF_TASK_COUNT );
+            goto BadOpt;
+        }
+
+        if( pParam->ulWriters > pParam->ulTasks )
+        {
+            RedPrintf( "Error: --writers cannot exceed --tasks.\n" );
+            goto BadOpt;
+        }
+
+        if( ( pParam->ulIoSize == 0U ) || ( pParam->ulIoSize > MTBENCH_IO_MAX ) || ( pParam->ulIoSize > pParam->ulFileSize ) )
+        {
+            RedPrintf( "Error: --iosize must be between 1 and %u, and no larger than --filesize.\n", ( unsigned ) MTBENCH_IO_MAX );
+            goto BadOpt;
+        }
+
+        /*  RedGetoptLong() has permuted argv to move all non-option arguments to
+         *  the end.  We expect to find a volume identifier.
+         */
+        if( red_optind >= argc )
+        {
+            RedPrintf( "Missing volume argument\n" );
+            goto BadOpt;
+        }
+
+        bVolNum = RedFindVolumeNumber( argv[ red_optind ] );
+
+        if( bVolNum == REDCONF_VOLUME_COUNT )
+        {
+            RedPrintf( "Error: \"%s\" is not a valid volume identifier.\n", argv[ red_optind ] );
+            goto BadOpt;
+        }
+
+        if( pbVolNum != NULL )
+        {
+            *pbVolNum = bVolNum;
+        }
+
+        red_optind++; /* Move past volume parameter. */
+
+        if( red_optind < argc )
+        {
+            int32_t ii;
+
+            for( ii = red_optind; ii < argc; ii++ )
+            {
+                RedPrintf( "Error: Unexpected command-line argument \"%s\".\n", argv[ ii ] );
+            }
+
+            goto BadOpt;
+        }
+
+        return PARAMSTATUS_OK;
+
+BadOpt:
+
+        RedPrintf( "%s - invalid parameters\n", argv[ 0U ] );
+        usage( argv[ 0U ] );
+        return PARAMSTATUS_BAD;
+
+Help:
+
+        usage( argv[ 0U ] );
+        return PARAMSTATUS_HELP;
+    }
+
+
+/** @brief Set default multi-task benchmark parameters.
+ *
+ *  @param pParam   Populated with the default benchmark parameters.
+ */
+    void MtBenchDefaultParams( MTBENCHPARAM * pParam )
+    {
+        RedMemSet( pParam, 0U, sizeof( *pParam ) );
+        pParam->ulTasks = ( REDCONF_TASK_COUNT < 4U ) ? REDCONF_TASK_COUNT : 4U;
+        pParam->ulWriters = 1U;
+        pParam->ulOps = 10000U;
+
+        /*  Small enough that the shared file stays in the buffer cache.
+         */
+        pParam->ulFileSize = ( REDCONF_BUFFER_COUNT / 2U ) * REDCONF_BLOCK_SIZE;
+        pParam->ulIoSize = REDCONF_BLOCK_SIZE / 4U;
+        pParam->ulSeed = 1U;
+    }
+
+
+/** @brief Create the files used by the multi-task benchmark.
+ *
+ *  The volume must be mounted.
+ *
+ *  @param pParam   Benchmark parameters, either from MtBenchParseParams() or
+ *                  constructed programatically.
+ *  @param bVolNum  The volume to run the benchmark on.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    int MtBenchPrepare( const MTBENCHPARAM * pParam,
+                        uint8_t bVolNum )
+    {
+        int iRet = 0;
+        uint32_t ulTaskIdx;
+
+        gParam = *pParam;
+        gbVolNum = bVolNum;
+        RedMemSet( gaResult, 0U, sizeof( gaResult ) );
+
+        /*  Task zero is always a reader, and its path names the shared file.
+         *  Writers are the last tasks, and each has a file of its own.
+         */
+        for( ulTaskIdx = 0U; ulTaskIdx < gParam.ulTasks; ulTaskIdx++ )
+        {
+            if( ( ulTaskIdx == 0U ) || ( ulTaskIdx >= ( gParam.ulTasks - gParam.ulWriters ) ) )
+            {
+                char szPath[ MTBENCH_PATH_MAX ];
+                int32_t iFildes;
+                uint32_t ulOffset;
+
+                MtBenchPath( ulTaskIdx, szPath );
+
+                iFildes = red_open( szPath, RED_O_WRONLY | RED_O_CREAT | RED_O_TRUNC );
+
+                if( iFildes < 0 )
+                {
+                    RedPrintf( "Error %d creating %s\n", ( int ) red_errno, szPath );
+                    iRet = 1;
+                    break;
+                }
+
+                RedMemSet( gaabBuffer[ 0U ], ( uint8_t ) ulTaskIdx, sizeof( gaabBuffer[ 0U ] ) );
+
+                for( ulOffset = 0U; ulOffset < gParam.ulFileSize; ulOffset += MTBENCH_IO_MAX )
+                {
+                    uint32_t ulLen = REDMIN( MTBENCH_IO_MAX, gParam.ulFileSize - ulOffset );
+
+                    if( red_write( iFildes, gaabBuffer[ 0U ], ulLen ) != ( int32_t ) ulLen )
+                    {
+                        RedPrintf( "Error %d writing %s\n", ( int ) red_errno, szPath );
+                        iRet = 1;
+                        break;
+                    }
+                }
+
+                if( red_close( iFildes ) != 0 )
+                {
+                    iRet = 1;
+                }
+
+                if( iRet != 0 )
+                {
+                    break;
+                }
+            }
+        }
+
+        return iRet;
+    }
+
+
+/** @brief Run one task's share of the multi-task benchmark.
+ *
+ *  Must be called from @p ulTaskIdx distinct tasks, concurrently, after
+ *  MtBenchPrepare() has succeeded.
+ *
+ *  @param ulTaskIdx    The index of the calling task: from zero up to the
+ *                      number of tasks minus one.
+ */
+    void MtBenchTask( uint32_t ulTaskIdx )
+    {
+        MTBENCHRESULT * pResult = &gaResult[ ulTaskIdx ];
+        bool fWriter = ulTaskIdx >= ( gParam.ulTasks - gParam.ulWriters );
+        uint32_t ulSeed = gParam.ulSeed + ulTaskIdx;
+        char szPath[ MTBENCH_PATH_MAX ];
+        int32_t iFildes;
+
+        REDASSERT( ulTaskIdx < gParam.ulTasks );
+
+        MtBenchPath( fWriter ? ulTaskIdx : 0U, szPath );
+
+        iFildes = red_open( szPath, fWriter ? RED_O_WRONLY : RED_O_RDONLY );
+
+        if( iFildes < 0 )
+        {
+            pResult->iErrno = red_errno;
+        }
+        else
+        {
+            uint32_t ulRange = gParam.ulFileSize - gParam.ulIoSize + 1U;
+            REDTIMESTAMP ts = RedOsTimestamp();
+            uint32_t ulOp;
+
+            for( ulOp = 0U; ulOp < gParam.ulOps; ulOp++ )
+            {
+                int64_t llOffset = ( int64_t ) ( RedRand32( &ulSeed ) % ulRange );
+                int32_t iLen;
+
+                if( red_lseek( iFildes, llOffset, RED_SEEK_SET ) != llOffset )
+                {
+                    pResult->iErrno = red_errno;
+                    break;
+                }
+
+                if( fWriter )
+                {
+                    iLen = red_write( iFildes, gaabBuffer[ ulTaskIdx ], gParam.ulIoSize );
+                }
+                else
+                {
+                    iLen = red_read( iFildes, gaabBuffer[ ulTaskIdx ], gParam.ulIoSize );
+                }
+
+                if( iLen != ( int32_t ) gParam.ulIoSize )
+                {
+                    pResult->iErrno = ( iLen < 0 ) ? red_errno : -RED_EIO;
+                    break;
+                }
+
+                pResult->ulOps++;
+            }
+
+            pResult->ullUsecs = RedOsTimePassed( ts );
+
+            ( void ) red_close( iFildes );
+        }
+    }
+
+
+/** @brief Report the results of the multi-task benchmark and remove its files.
+ *
+ *  Must only be called once every MtBenchTask() call has returned.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    int MtBenchFinish( void )
+    {
+        int iRet = 0;
+        uint32_t ulTotalOps = 0U;
+        uint64_t ullMaxUsecs = 0U;
+        uint32_t ulTaskIdx;
+
+        for( ulTaskIdx = 0U; ulTaskIdx < gParam.ulTasks; ulTaskIdx++ )
+        {
+            const MTBENCHRESULT * pResult = &gaResult[ ulTaskIdx ];
+            bool fWriter = ulTaskIdx >= ( gParam.ulTasks - gParam.ulWriters );
+            char szPath[ MTBENCH_PATH_MAX ];
+
+            RedPrintf( "task %2u (%s): %8u ops in %8u ms", ( unsigned ) ulTaskIdx, fWriter ? "write" : "read ",
+                       ( unsigned ) pResult->ulOps, ( unsigned ) ( pResult->ullUsecs / 1000U ) );
+
+            if( pResult->iErrno != 0 )
+            {
+                RedPrintf( ", stopped by error %d", ( int ) pResult->iErrno );
+                iRet = 1;
+            }
+
+            RedPrintf( "\n" );
+
+            ulTotalOps += pResult->ulOps;
+
+            if( pResult->ullUsecs > ullMaxUsecs )
+            {
+                ullMaxUsecs = pResult->ullUsecs;
+            }
+
+            if( ( ulTaskIdx == 0U ) || fWriter )
+            {
+                MtBenchPath( ulTaskIdx, szPath );
+                ( void ) red_unlink( szPath );
+            }
+        }
+
+        if( ullMaxUsecs == 0U )
+        {
+            ullMaxUsecs = 1U;
+        }
+
+        RedPrintf( "aggregate: %u ops/sec\n", ( unsigned ) ( ( ( uint64_t ) ulTotalOps * 1000000U ) / ullMaxUsecs ) );
+
+        return iRet;
+    }
+
+
+/** @brief Build the path of the file used by a benchmark task.
+ *
+ *  @param ulTaskIdx    The task index.  Index zero names the shared file.
+ *  @param pszPath      Populated with the path; must be at least
+ *                      MTBENCH_PATH_MAX bytes.
+ */
+    static void MtBenchPath( uint32_t ulTaskIdx,
+                             char * pszPath )
+    {
+        ( void ) RedSNPrintf( pszPath, MTBENCH_PATH_MAX, "%s%cmtb%u.dat", gaRedVolConf[ gbVolNum ].pszPathPrefix,
+                              REDCONF_PATH_SEPARATOR, ( unsigned ) ulTaskIdx );
+    }
+
+
+/** @brief Print usage information.
+ *
+ *  @param pszProgName  Name of the program.
+ */
+    static void usage( const char * pszProgName )
+    {
+        RedPrintf( "usage: %s VolumeID [Options]\n", pszProgName );
+        RedPrintf( "Measure aggregate throughput of several tasks using one volume at once.\n\n" );
+        RedPrintf( "Where:\n" );
+        RedPrintf( "  VolumeID\n" );
+        RedPrintf( "      A volume number (e.g., 2) or a volume path prefix (e.g., VOL1: or /data)\n" );
+        RedPrintf( "      of the volume to test.\n" );
+        RedPrintf( "And 'Options' are any of the following:\n" );
+        RedPrintf( "  --tasks=count, -t count\n" );
+        RedPrintf( "      Number of tasks which will call MtBenchTask() (default 4).\n" );
+        RedPrintf( "  --writers=count, -w count\n" );
+        RedPrintf( "      How many of those tasks write rather than read (default 1).\n" );
+        RedPrintf( "  --ops=count, -n count\n" );
+        RedPrintf( "      Operations per task (default 10000).\n" );
+        RedPrintf( "  --filesize=bytes, -f bytes\n" );
+        RedPrintf( "      Size of each file (default half the buffer cache).\n" );
+        RedPrintf( "  --iosize=bytes, -i bytes\n" );
+        RedPrintf( "      Size of each read or write (default a quarter block).\n" );
+        RedPrintf( "  --seed=value, -s value\n" );
+        RedPrintf( "      Base random number seed (default 1).\n" );
+        RedPrintf( "  --dev=devname, -D devname\n" );
+        RedPrintf( "      Specifies the device name.  This is typically only meaningful when\n" );
+        RedPrintf( "      running the test on a host machine.  This can be \"ram\" to test on a RAM\n" );
+        RedPrintf( "      disk, the path and name of a file disk (e.g., red.bin); or an OS-specific\n" );
+        RedPrintf( "      reference to a device (on Windows, a drive letter like G: or a device name\n" );
+        RedPrintf( "      like \\\\.\\PhysicalDrive7).\n" );
+        RedPrintf( "  --help, -H\n" );
+        RedPrintf( "      Prints this usage text and exits.\n\n" );
+    }
+
+#endif /* MTBENCH_SUPPORTED */
@@ -0,0 +1,763 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Snapshot test for the POSIX-like API.
+ *
+ *  A snapshot of a file is opened, and the file is then extended with
+ *  red_fallocate(), overwritten, and truncated, committing after each change.
+ *  Another file is written over most of the free space, so that any block the
+ *  file system failed to hold for the snapshot gets reallocated, before the
+ *  snapshot is checked against the data the file held when it was opened.
+ *  Once the snapshot is closed, the free block count must be what it was
+ *  before.
+ *
+ *  The test also checks that a snapshot goes stale, rather than returning
+ *  wrong data, when more fragments are freed than can be held.
+ */
+#include <redfs.h>
+#include <redposix.h>
+#include <redtests.h>
+
+#if SNAPTEST_SUPPORTED
+
+    #include <redvolume.h>
+    #include <redgetopt.h>
+    #include <redtoolcmn.h>
+
+
+/*  Size of the file whose snapshot is checked.  Large enough to need indirect
+ *  nodes, and not a whole number of blocks.
+ */
+    #define SNAPTEST_FILE_SIZE    ( ( 64U * REDCONF_BLOCK_SIZE ) + 100U )
+
+/*  Number of blocks in the file which is made to fragment the held blocks.
+ *  One in two blocks is rewritten, one per transaction point, until the
+ *  extents of held blocks run out.
+ */
+    #define SNAPTEST_FRAG_BLOCKS  ( ( REDCONF_SNAPSHOT_EXTENTS + 2U ) * 2U )
+
+/*  Size of the I/O buffer.
+ */
+    #define SNAPTEST_IO_MAX       ( 2U * REDCONF_BLOCK_SIZE )
+
+/*  Longest path name used by the test, including the volume prefix.
+ */
+    #define SNAPTEST_PATH_MAX     ( REDCONF_NAME_MAX + 32U )
+
+
+    static int SnapTestModify( const SNAPTESTPARAM * pParam );
+    static int SnapTestStale( const SNAPTESTPARAM * pParam );
+    static int SnapTestFill( const char * pszVolume,
+                             const char * pszPath );
+    static int SnapTestWrite( const char * pszVolume,
+                              int32_t iFildes,
+                              uint32_t ulSeed,
+                              uint32_t ulSize );
+    static int SnapTestVerify( int32_t iSnap,
+                               uint32_t ulSeed,
+                               uint32_t ulSize );
+    static int FreeBlocks( const char * pszVolume,
+                           uint32_t * pulFree );
+    static void Pattern( uint32_t ulSeed,
+                         uint32_t ulOffset,
+                         uint32_t ulLen );
+    static void usage( const char * pszProgName );
+
+
+    static uint8_t gabBuffer[ SNAPTEST_IO_MAX ];
+    static uint8_t gabExpect[ SNAPTEST_IO_MAX ];
+
+
+/** @brief Parse parameters for the snapshot test.
+ *
+ *  @param argc         The number of arguments from main().
+ *  @param argv         The vector of arguments from main().
+ *  @param pParam       Populated with the test parameters.
+ *  @param pbVolNum     If non-NULL, populated with the volume number.
+ *  @param ppszDevice   If non-NULL, populated with the device name argument or
+ *                      NULL if no device argument is provided.
+ *
+ *  @return The result of parsing the parameters.
+ */
+    PARAMSTATUS SnapTestParseParams( int argc,
+                                     char * argv[],
+                                     SNAPTESTPARAM * pParam,
+                                     uint8_t * pbVolNum,
+                                     const char ** ppszDevice )
+    {
+        int c;
+        uint8_t bVolNum;
+        const REDOPTION aLongopts[] =
+        {
+            { "seed", red_required_argument, NULL, 's' },
+            { "dev",  red_required_argument, NULL, 'D' },
+            { "help", red_no_argument,       NULL, 'H' },
+            { NULL }
+        };
+
+        /*  If run without parameters, treat as a help request.
+         */
+        if( argc <= 1 )
+        {
+            goto Help;
+        }
+
+        /*  Assume no device argument to start with.
+         */
+        if( ppszDevice != NULL )
+        {
+            *ppszDevice = NULL;
+        }
+
+        /*  Set default parameters.
+         */
+        SnapTestDefaultParams( pParam );
+
+        while( ( c = RedGetoptLong( argc, argv, "s:D:H", aLongopts, NULL ) ) != -1 )
+        {
+            switch( c )
+            {
+                case 's': /* --seed */
+                    pParam->ulSeed = RedAtoI( red_optarg );
+                    break;
+
+                case 'D': /* --dev */
+
+                    if( ppszDevice != NULL )
+                    {
+                        *ppszDevice = red_optarg;
+                    }
+
+                    break;
+
+                case 'H': /* --help */
+                    goto Help;
+
+                case '?': /* Unknown or ambiguous option */
+                case ':': /* Option missing required argument */
+                default:
+                    goto BadOpt;
+            }
+        }
+
+        /*  RedGetoptLong() has permuted argv to move all non-option arguments to
+         *  the end.  We expect to find a volume identifier.
+         */
+        if( red_optind >= argc )
+        {
+            RedPrintf( "Missing volume argument\n" );
+            goto BadOpt;
+        }
+
+        bVolNum = RedFindVolumeNumber( argv[ red_optind ] );
+
+        if( bVolNum == REDCONF_VOLUME_COUNT )
+        {
+            RedPrintf( "Error: \"%s\" is not a valid volume identifier.\n", argv[ red_optind ] );
+            goto BadOpt;
+        }
+
+        if( pbVolNum != NULL )
+        {
+            *pbVolNum = bVolNum;
+        }
+
+        pParam->pszVolume = gaRedVolConf[ bVolNum ].pszPathPrefix;
+
+        red_optind++; /* Move past volume parameter. */
+
+        if( red_optind < argc )
+        {
+            int32_t ii;
+
+            for( ii = red_optind; ii < argc; ii++ )
+            {
+                RedPrintf( "Error: Unexpected command-line argument \"%s\".\n", argv[ ii ] );
+            }
+
+            goto BadOpt;
+        }
+
+        return PARAMSTATUS_OK;
+
+BadOpt:
+
+        RedPrintf( "%s - invalid parameters\n", argv[ 0U ] );
+        usage( argv[ 0U ] );
+        return PARAMSTATUS_BAD;
+
+Help:
+
+        usage( argv[ 0U ] );
+        return PARAMSTATUS_HELP;
+    }
+
+
+/** @brief Set default snapshot test parameters.
+ *
+ *  @param pParam   Populated with the default test parameters.
+ */
+    void SnapTestDefaultParams( SNAPTESTPARAM * pParam )
+    {
+        RedMemSet( pParam, 0U, sizeof( *pParam ) );
+        pParam->pszVolume = gaRedVolConf[ 0U ].pszPathPrefix;
+        pParam->ulSeed = 1U;
+    }
+
+
+/** @brief Run the snapshot test.
+ *
+ *  The volume must be mounted, with no snapshots of it open.
+ *
+ *  @param pParam   Test parameters, either from SnapTestParseParams() or
+ *                  constructed programatically.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    int SnapTestStart( const SNAPTESTPARAM * pParam )
+    {
+        int iRet;
+
+        iRet = SnapTestModify( pParam );
+
+        if( iRet == 0 )
+        {
+            iRet = SnapTestStale( pParam );
+        }
+
+        if( iRet == 0 )
+        {
+            RedPrintf( "snaptest: OK\n" );
+        }
+
+        return iRet;
+    }
+
+
+/** @brief Check that a snapshot reads the committed data across
+ *         red_fallocate(), overwrite, and truncate, and that closing it gives
+ *         back the blocks held for it.
+ *
+ *  @param pParam   Test parameters.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    static int SnapTestModify( const SNAPTESTPARAM * pParam )
+    {
+        int iRet = 0;
+        char szPath[ SNAPTEST_PATH_MAX ];
+        char szFill[ SNAPTEST_PATH_MAX ];
+        int32_t iFildes;
+        int32_t iSnap = -1;
+        uint32_t ulFreeEmpty = 0U;
+        uint32_t ulFreeHeld = 0U;
+        uint32_t ulFree = 0U;
+
+        ( void ) RedSNPrintf( szPath, sizeof( szPath ), "%s%csnaptest.dat", pParam->pszVolume, REDCONF_PATH_SEPARATOR );
+        ( void ) RedSNPrintf( szFill, sizeof( szFill ), "%s%csnaptest.tmp", pParam->pszVolume, REDCONF_PATH_SEPARATOR );
+
+        /*  Both files exist, empty, when the free block count is first taken,
+         *  so that their directory entries are not counted as a difference.
+         */
+        iFildes = red_open( szFill, RED_O_RDWR | RED_O_CREAT | RED_O_TRUNC );
+
+        if( ( iFildes < 0 ) || ( red_close( iFildes ) != 0 ) )
+        {
+            RedPrintf( "Error %d creating %s\n", ( int ) red_errno, szFill );
+            iRet = 1;
+        }
+
+        if( iRet == 0 )
+        {
+            iFildes = red_open( szPath, RED_O_RDWR | RED_O_CREAT | RED_O_TRUNC );
+
+            if( iFildes < 0 )
+            {
+                RedPrintf( "Error %d creating %s\n", ( int ) red_errno, szPath );
+                iRet = 1;
+            }
+        }
+
+        if( iRet == 0 )
+        {
+            iRet = FreeBlocks( pParam->pszVolume, &ulFreeEmpty );
+        }
+
+        if( iRet == 0 )
+        {
+            iRet = SnapTestWrite( pParam->pszVolume, iFildes, pParam->ulSeed, SNAPTEST_FILE_SIZE );
+        }
+
+        if( iRet == 0 )
+        {
+            iSnap = red_snapopen( szPath, NULL );
+
+            if( iSnap < 0 )
+            {
+                RedPrintf( "Error %d from red_snapopen()\n", ( int ) red_errno );
+                iRet = 1;
+            }
+        }
+
+        /*  Allocating from the end of the file zeroes the rest of its partial
+         *  last block, which the snapshot still reads, in a new block.
+         */
+        if( ( iRet == 0 ) && ( ( red_fallocate( iFildes, SNAPTEST_FILE_SIZE, SNAPTEST_FILE_SIZE ) != 0 ) || ( red_transact( pParam->pszVolume ) != 0 ) ) )
+        {
+            RedPrintf( "Error %d from red_fallocate()\n", ( int ) red_errno );
+            iRet = 1;
+        }
+
+        if( iRet == 0 )
+        {
+            iRet = SnapTestWrite( pParam->pszVolume, iFildes, pParam->ulSeed + 1U, SNAPTEST_FILE_SIZE );
+        }
+
+        if( ( iRet == 0 ) && ( ( red_ftruncate( iFildes, 1U ) != 0 ) || ( red_transact( pParam->pszVolume ) != 0 ) ) )
+        {
+            RedPrintf( "Error %d truncating\n", ( int ) red_errno );
+            iRet = 1;
+        }
+
+        if( iRet == 0 )
+        {
+            iRet = SnapTestFill( pParam->pszVolume, szFill );
+        }
+
+        if( iRet == 0 )
+        {
+            iRet = SnapTestVerify( iSnap, pParam->ulSeed, SNAPTEST_FILE_SIZE );
+        }
+
+        if( ( iRet == 0 ) && ( ( red_ftruncate( iFildes, 0U ) != 0 ) || ( red_transact( pParam->pszVolume ) != 0 ) ) )
+        {
+            RedPrintf( "Error %d truncating\n", ( int ) red_errno );
+            iRet = 1;
+        }
+
+        /*  The blocks of the original file are still held for the snapshot.
+         */
+        if( iRet == 0 )
+        {
+            iRet = FreeBlocks( pParam->pszVolume, &ulFreeHeld );
+        }
+
+        if( ( iRet == 0 ) && ( ( ulFreeHeld + ( SNAPTEST_FILE_SIZE / REDCONF_BLOCK_SIZE ) ) > ulFreeEmpty ) )
+        {
+            RedPrintf( "Only %u of %u blocks in use with the snapshot open\n", ( unsigned ) ( ulFreeEmpty - ulFreeHeld ), ( unsigned ) ( SNAPTEST_FILE_SIZE / REDCONF_BLOCK_SIZE ) );
+            iRet = 1;
+        }
+
+        if( iSnap >= 0 )
+        {
+            if( ( red_snapclose( iSnap ) != 0 ) && ( iRet == 0 ) )
+            {
+                RedPrintf( "Error %d from red_snapclose()\n", ( int ) red_errno );
+                iRet = 1;
+            }
+        }
+
+        /*  Closing the snapshot gives back every held block.
+         */
+        if( iRet == 0 )
+        {
+            iRet = FreeBlocks( pParam->pszVolume, &ulFree );
+        }
+
+        if( ( iRet == 0 ) && ( ulFree != ulFreeEmpty ) )
+        {
+            RedPrintf( "%u blocks free after closing the snapshot, expected %u\n", ( unsigned ) ulFree, ( unsigned ) ulFreeEmpty );
+            iRet = 1;
+        }
+
+        if( iFildes >= 0 )
+        {
+            ( void ) red_close( iFildes );
+        }
+
+        ( void ) red_unlink( szPath );
+        ( void ) red_unlink( szFill );
+        ( void ) red_transact( pParam->pszVolume );
+
+        return iRet;
+    }
+
+
+/** @brief Check that a snapshot goes stale when the blocks freed from its file
+ *         cannot all be held.
+ *
+ *  @param pParam   Test parameters.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    static int SnapTestStale( const SNAPTESTPARAM * pParam )
+    {
+        int iRet = 0;
+        char szPath[ SNAPTEST_PATH_MAX ];
+        int32_t iFildes;
+        int32_t iSnap = -1;
+        uint32_t ulBlock;
+        bool fStale = false;
+
+        ( void ) RedSNPrintf( szPath, sizeof( szPath ), "%s%csnaptest.frg", pParam->pszVolume, REDCONF_PATH_SEPARATOR );
+
+        iFildes = red_open( szPath, RED_O_RDWR | RED_O_CREAT | RED_O_TRUNC );
+
+        if( iFildes < 0 )
+        {
+            RedPrintf( "Error %d creating %s\n", ( int ) red_errno, szPath );
+            iRet = 1;
+        }
+        else
+        {
+            iRet = SnapTestWrite( pParam->pszVolume, iFildes, pParam->ulSeed, SNAPTEST_FRAG_BLOCKS * REDCONF_BLOCK_SIZE );
+        }
+
+        if( iRet == 0 )
+        {
+            iSnap = red_snapopen( szPath, NULL );
+
+            if( iSnap < 0 )
+            {
+                RedPrintf( "Error %d from red_snapopen()\n", ( int ) red_errno );
+                iRet = 1;
+            }
+        }
+
+        /*  Rewriting every other block frees blocks which are not adjacent, so
+         *  each takes an extent of its own.
+         */
+        for( ulBlock = 0U; ( iRet == 0 ) && !fStale && ( ulBlock < SNAPTEST_FRAG_BLOCKS ); ulBlock += 2U )
+        {
+            int64_t llOffset = ( int64_t ) ulBlock * REDCONF_BLOCK_SIZE;
+
+            if( ( red_lseek( iFildes, llOffset, RED_SEEK_SET ) != llOffset ) ||
+                ( red_write( iFildes, gabBuffer, 1U ) != 1 ) ||
+                ( red_transact( pParam->pszVolume ) != 0 ) )
+            {
+                RedPrintf( "Error %d rewriting block %u\n", ( int ) red_errno, ( unsigned ) ulBlock );
+                iRet = 1;
+            }
+            else if( red_snapread( iSnap, 0U, gabBuffer, 1U ) < 0 )
+            {
+                if( red_errno == RED_ESTALE )
+                {
+                    fStale = true;
+                }
+                else
+                {
+                    RedPrintf( "Error %d from red_snapread()\n", ( int ) red_errno );
+                    iRet = 1;
+                }
+            }
+            else
+            {
+                /*  The snapshot can still be read.
+                 */
+            }
+        }
+
+        if( ( iRet == 0 ) && !fStale )
+        {
+            RedPrintf( "Snapshot not stale after %u blocks were freed apart\n", ( unsigned ) ( SNAPTEST_FRAG_BLOCKS / 2U ) );
+            iRet = 1;
+        }
+
+        if( ( iRet == 0 ) && ( ( red_snapread( iSnap, REDCONF_BLOCK_SIZE, gabBuffer, 1U ) != -1 ) || ( red_errno != RED_ESTALE ) ) )
+        {
+            RedPrintf( "A stale snapshot could be read\n" );
+            iRet = 1;
+        }
+
+        if( iSnap >= 0 )
+        {
+            if( ( red_snapclose( iSnap ) != 0 ) && ( iRet == 0 ) )
+            {
+                RedPrintf( "Error %d from red_snapclose()\n", ( int ) red_errno );
+                iRet = 1;
+            }
+        }
+
+        if( iFildes >= 0 )
+        {
+            ( void ) red_close( iFildes );
+        }
+
+        ( void ) red_unlink( szPath );
+        ( void ) red_transact( pParam->pszVolume );
+
+        return iRet;
+    }
+
+
+/** @brief Write a file over most of the free space, so that free blocks are
+ *         reallocated, and then truncate it.
+ *
+ *  @param pszVolume    The volume path prefix.
+ *  @param pszPath      The path of the file, which exists.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    static int SnapTestFill( const char * pszVolume,
+                             const char * pszPath )
+    {
+        int iRet = 0;
+        uint32_t ulPass;
+
+        /*  Blocks are allocated from where the last allocation left off, so
+         *  two passes reach every free block.
+         */
+        for( ulPass = 0U; ( iRet == 0 ) && ( ulPass < 2U ); ulPass++ )
+        {
+            uint32_t ulFree = 0U;
+            int32_t iFildes = -1;
+
+            iRet = FreeBlocks( pszVolume, &ulFree );
+
+            if( iRet == 0 )
+            {
+                iFildes = red_open( pszPath, RED_O_RDWR );
+
+                if( iFildes < 0 )
+                {
+                    RedPrintf( "Error %d opening %s\n", ( int ) red_errno, pszPath );
+                    iRet = 1;
+                }
+            }
+
+            if( iRet == 0 )
+            {
+                /*  Leave room for the indirect nodes.
+                 */
+                uint32_t ulBlocks = ulFree - REDMIN( ulFree, ( ulFree / 32U ) + 16U );
+
+                iRet = SnapTestWrite( pszVolume, iFildes, ulPass, ulBlocks * REDCONF_BLOCK_SIZE );
+            }
+
+            if( ( iRet == 0 ) && ( ( red_ftruncate( iFildes, 0U ) != 0 ) || ( red_transact( pszVolume ) != 0 ) ) )
+            {
+                RedPrintf( "Error %d truncating %s\n", ( int ) red_errno, pszPath );
+                iRet = 1;
+            }
+
+            if( iFildes >= 0 )
+            {
+                ( void ) red_close( iFildes );
+            }
+        }
+
+        return iRet;
+    }
+
+
+/** @brief Write a file from the start with a data pattern and commit it.
+ *
+ *  @param pszVolume    The volume path prefix.
+ *  @param iFildes      The open file descriptor.
+ *  @param ulSeed       The seed of the data pattern.
+ *  @param ulSize       The number of bytes to write.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    static int SnapTestWrite( const char * pszVolume,
+                              int32_t iFildes,
+                              uint32_t ulSeed,
+                              uint32_t ulSize )
+    {
+        int iRet = 0;
+        uint32_t ulOffset = 0U;
+
+        if( red_lseek( iFildes, 0, RED_SEEK_SET ) != 0 )
+        {
+            RedPrintf( "Error %d seeking\n", ( int ) red_errno );
+            iRet = 1;
+        }
+
+        while( ( iRet == 0 ) && ( ulOffset < ulSize ) )
+        {
+            uint32_t ulLen = REDMIN( ulSize - ulOffset, SNAPTEST_IO_MAX );
+
+            Pattern( ulSeed, ulOffset, ulLen );
+
+            if( red_write( iFildes, gabExpect, ulLen ) != ( int32_t ) ulLen )
+            {
+                RedPrintf( "Error %d writing at offset %u\n", ( int ) red_errno, ( unsigned ) ulOffset );
+                iRet = 1;
+            }
+            else
+            {
+                ulOffset += ulLen;
+            }
+        }
+
+        if( ( iRet == 0 ) && ( red_transact( pszVolume ) != 0 ) )
+        {
+            RedPrintf( "Error %d from red_transact()\n", ( int ) red_errno );
+            iRet = 1;
+        }
+
+        return iRet;
+    }
+
+
+/** @brief Read a snapshot, in pieces of varying size, and check it against a
+ *         data pattern.
+ *
+ *  @param iSnap    The snapshot descriptor.
+ *  @param ulSeed   The seed of the data pattern.
+ *  @param ulSize   The expected size of the snapshot.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    static int SnapTestVerify( int32_t iSnap,
+                               uint32_t ulSeed,
+                               uint32_t ulSize )
+    {
+        int iRet = 0;
+        uint32_t ulOffset = 0U;
+        uint32_t ulRead = 0U;
+        int32_t iLen;
+
+        do
+        {
+            /*  Alternate reads of whole blocks with reads which are not.
+             */
+            uint32_t ulLen = ( ( ulRead & 1U ) == 0U ) ? SNAPTEST_IO_MAX : ( ( REDCONF_BLOCK_SIZE / 2U ) + 3U );
+
+            iLen = red_snapread( iSnap, ulOffset, gabBuffer, ulLen );
+            ulRead++;
+
+            if( iLen < 0 )
+            {
+                RedPrintf( "Error %d from red_snapread() at offset %u\n", ( int ) red_errno, ( unsigned ) ulOffset );
+                iRet = 1;
+            }
+            else if( ( ulOffset + ( uint32_t ) iLen ) > ulSize )
+            {
+                RedPrintf( "Snapshot longer than %u bytes\n", ( unsigned ) ulSize );
+                iRet = 1;
+            }
+            else
+            {
+                Pattern( ulSeed, ulOffset, ( uint32_t ) iLen );
+
+                if( RedMemCmp( gabBuffer, gabExpect, ( uint32_t ) iLen ) != 0 )
+                {
+                    RedPrintf( "Snapshot differs near offset %u\n", ( unsigned ) ulOffset );
+                    iRet = 1;
+                }
+                else
+                {
+                    ulOffset += ( uint32_t ) iLen;
+                }
+            }
+        } while( ( iRet == 0 ) && ( iLen > 0 ) );
+
+        if( ( iRet == 0 ) && ( ulOffset != ulSize ) )
+        {
+            RedPrintf( "Snapshot size %u, expected %u\n", ( unsigned ) ulOffset, ( unsigned ) ulSize );
+            iRet = 1;
+        }
+
+        return iRet;
+    }
+
+
+/** @brief Get the number of free blocks on a volume.
+ *
+ *  @param pszVolume    The volume path prefix.
+ *  @param pulFree      Populated with the number of free blocks.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    static int FreeBlocks( const char * pszVolume,
+                           uint32_t * pulFree )
+    {
+        int iRet = 0;
+        REDSTATFS statfs;
+
+        if( red_statvfs( pszVolume, &statfs ) != 0 )
+        {
+            RedPrintf( "Error %d from red_statvfs()\n", ( int ) red_errno );
+            iRet = 1;
+        }
+        else
+        {
+            *pulFree = statfs.f_bfree;
+        }
+
+        return iRet;
+    }
+
+
+/** @brief Generate the expected data for a range of a file in gabExpect.
+ *
+ *  @param ulSeed   The seed of the data pattern.
+ *  @param ulOffset The file offset of the range.
+ *  @param ulLen    The length of the range; at most #SNAPTEST_IO_MAX.
+ */
+    static void Pattern( uint32_t ulSeed,
+                         uint32_t ulOffset,
+                         uint32_t ulLen )
+    {
+        uint32_t ulIdx;
+
+        for( ulIdx = 0U; ulIdx < ulLen; ulIdx++ )
+        {
+            uint32_t ulPos = ulOffset + ulIdx;
+
+            gabExpect[ ulIdx ] = ( uint8_t ) ( ( ulPos * 31U ) + ( ulPos / REDCONF_BLOCK_SIZE ) + ( ulSeed * 101U ) );
+        }
+    }
+
+
+/** @brief Print usage information.
+ *
+ *  @param pszProgName  Name of the program.
+ */
+    static void usage( const char * pszProgName )
+    {
+        RedPrintf( "usage: %s VolumeID [Options]\n", pszProgName );
+        RedPrintf( "Check that file snapshots read the data committed when they were opened.\n\n" );
+        RedPrintf( "Where:\n" );
+        RedPrintf( "  VolumeID\n" );
+        RedPrintf( "      A volume number (e.g., 2) or a volume path prefix (e.g., VOL1: or /data)\n" );
+        RedPrintf( "      of the volume to test.\n" );
+        RedPrintf( "And 'Options' are any of the following:\n" );
+        RedPrintf( "  --seed=value, -s value\n" );
+        RedPrintf( "      Seed of the data pattern (default 1).\n" );
+        RedPrintf( "  --dev=devname, -D devname\n" );
+        RedPrintf( "      Specifies the device name.  This is typically only meaningful when\n" );
+        RedPrintf( "      running the test on a host machine.  This can be \"ram\" to test on a RAM\n" );
+        RedPrintf( "      disk, the path and name of a file disk (e.g., red.bin); or an OS-specific\n" );
+        RedPrintf( "      reference to a device (on Windows, a drive letter like G: or a device name\n" );
+        RedPrintf( "      like \\\\.\\PhysicalDrive7).\n" );
+        RedPrintf( "  --help, -H\n" );
+        RedPrintf( "      Prints this usage text and exits.\n\n" );
+    }
+
+#endif /* SNAPTEST_SUPPORTED */
@@ -0,0 +1,478 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Manual transaction model test for the POSIX-like API.
+ *
+ *  With the transaction mask set to #RED_TRANSACT_MANUAL, only red_transact()
+ *  may commit.  The test makes random writes and truncations to a file,
+ *  keeping a model of both the working state and the state as of the last
+ *  red_transact().  Every so often it simulates a power loss by unmounting
+ *  without a transaction point, which discards the working state, and checks
+ *  that the remounted file matches the committed model.  Any transaction point
+ *  the file system committed by itself, such as one from the background
+ *  commit task, shows up as a mismatch.
+ */
+#include <redfs.h>
+#include <redposix.h>
+#include <redtests.h>
+
+#if TRANSTEST_SUPPORTED
+
+    #include <redvolume.h>
+    #include <redgetopt.h>
+    #include <redtoolcmn.h>
+
+
+/*  Largest size of the test file.  Large enough that the writes between two
+ *  transaction points dirty more buffers than the buffer cache holds.
+ */
+    #define TRANSTEST_FILE_MAX    ( 32U * REDCONF_BLOCK_SIZE )
+
+/*  Largest single write.
+ */
+    #define TRANSTEST_IO_MAX      ( 4U * REDCONF_BLOCK_SIZE )
+
+/*  Longest path name used by the test, including the volume prefix.
+ */
+    #define TRANSTEST_PATH_MAX    ( REDCONF_NAME_MAX + 32U )
+
+
+/*  A model of the test file's contents.
+ */
+    typedef struct
+    {
+        uint32_t ulSize;                       /* File size, in bytes. */
+        uint8_t abData[ TRANSTEST_FILE_MAX ];  /* File data; zero beyond ulSize. */
+    } TRANSMODEL;
+
+
+    static int TransTestCheck( const char * pszVolume,
+                               const char * pszPath,
+                               uint32_t ulOp,
+                               int32_t * piFildes );
+    static void usage( const char * pszProgName );
+
+
+    static TRANSMODEL gWorking;
+    static TRANSMODEL gCommitted;
+    static uint8_t gabBuffer[ TRANSTEST_IO_MAX ];
+
+
+/** @brief Parse parameters for the manual transaction model test.
+ *
+ *  @param argc         The number of arguments from main().
+ *  @param argv         The vector of arguments from main().
+ *  @param pParam       Populated with the test parameters.
+ *  @param pbVolNum     If non-NULL, populated with the volume number.
+ *  @param ppszDevice   If non-NULL, populated with the device name argument or
+ *                      NULL if no device argument is provided.
+ *
+ *  @return The result of parsing the parameters.
+ */
+    PARAMSTATUS TransTestParseParams( int argc,
+                                      char * argv[],
+                                      TRANSTESTPARAM * pParam,
+                                      uint8_t * pbVolNum,
+                                      const char ** ppszDevice )
+    {
+        int c;
+        uint8_t bVolNum;
+        const REDOPTION aLongopts[] =
+        {
+            { "ops",  red_required_argument, NULL, 'n' },
+            { "seed", red_required_argument, NULL, 's' },
+            { "dev",  red_required_argument, NULL, 'D' },
+            { "help", red_no_argument,       NULL, 'H' },
+            { NULL }
+        };
+
+        /*  If run without parameters, treat as a help request.
+         */
+        if( argc <= 1 )
+        {
+            goto Help;
+        }
+
+        /*  Assume no device argument to start with.
+         */
+        if( ppszDevice != NULL )
+        {
+            *ppszDevice = NULL;
+        }
+
+        /*  Set default parameters.
+         */
+        TransTestDefaultParams( pParam );
+
+        while( ( c = RedGetoptLong( argc, argv, "n:s:D:H", aLongopts, NULL ) ) != -1 )
+        {
+            switch( c )
+            {
+                case 'n': /* --ops */
+                    pParam->ulOps = RedAtoI( red_optarg );
+                    break;
+
+                case 's': /* --seed */
+                    pParam->ulSeed = RedAtoI( red_optarg );
+                    break;
+
+                case 'D': /* --dev */
+
+                    if( ppszDevice != NULL )
+                    {
+                        *ppszDevice = red_optarg;
+                    }
+
+                    break;
+
+                case 'H': /* --help */
+                    goto Help;
+
+                case '?': /* Unknown or ambiguous option */
+                case ':': /* Option missing required argument */
+                default:
+                    goto BadOpt;
+            }
+        }
+
+        /*  RedGetoptLong() has permuted argv to move all non-option arguments to
+         *  the end.  We expect to find a volume identifier.
+         */
+        if( red_optind >= argc )
+        {
+            RedPrintf( "Missing volume argument\n" );
+            goto BadOpt;
+        }
+
+        bVolNum = RedFindVolumeNumber( argv[ red_optind ] );
+
+        if( bVolNum == REDCONF_VOLUME_COUNT )
+        {
+            RedPrintf( "Error: \"%s\" is not a valid volume identifier.\n", argv[ red_optind ] );
+            goto BadOpt;
+        }
+
+        if( pbVolNum != NULL )
+        {
+            *pbVolNum = bVolNum;
+        }
+
+        pParam->pszVolume = gaRedVolConf[ bVolNum ].pszPathPrefix;
+
+        red_optind++; /* Move past volume parameter. */
+
+        if( red_optind < argc )
+        {
+            int32_t ii;
+
+            for( ii = red_optind; ii < argc; ii++ )
+            {
+                RedPrintf( "Error: Unexpected command-line argument \"%s\".\n", argv[ ii ] );
+            }
+
+            goto BadOpt;
+        }
+
+        return PARAMSTATUS_OK;
+
+BadOpt:
+
+        RedPrintf( "%s - invalid parameters\n", argv[ 0U ] );
+        usage( argv[ 0U ] );
+        return PARAMSTATUS_BAD;
+
+Help:
+
+        usage( argv[ 0U ] );
+        return PARAMSTATUS_HELP;
+    }
+
+
+/** @brief Set default manual transaction model test parameters.
+ *
+ *  @param pParam   Populated with the default test parameters.
+ */
+    void TransTestDefaultParams( TRANSTESTPARAM * pParam )
+    {
+        RedMemSet( pParam, 0U, sizeof( *pParam ) );
+        pParam->pszVolume = gaRedVolConf[ 0U ].pszPathPrefix;
+        pParam->ulOps = 5000U;
+        pParam->ulSeed = 1U;
+    }
+
+
+/** @brief Run the manual transaction model test.
+ *
+ *  The volume must be mounted.  Its transaction mask is restored afterward.
+ *
+ *  @param pParam   Test parameters, either from TransTestParseParams() or
+ *                  constructed programatically.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    int TransTestStart( const TRANSTESTPARAM * pParam )
+    {
+        int iRet = 0;
+        uint32_t ulSeed = pParam->ulSeed;
+        uint32_t ulOrigMask;
+        char szPath[ TRANSTEST_PATH_MAX ];
+        int32_t iFildes = -1;
+        uint32_t ulOp;
+
+        ( void ) RedSNPrintf( szPath, sizeof( szPath ), "%s%ctranstest.dat", pParam->pszVolume, REDCONF_PATH_SEPARATOR );
+
+        RedMemSet( &gWorking, 0U, sizeof( gWorking ) );
+        RedMemSet( &gCommitted, 0U, sizeof( gCommitted ) );
+
+        if( ( red_gettransmask( pParam->pszVolume, &ulOrigMask ) != 0 ) ||
+            ( red_settransmask( pParam->pszVolume, RED_TRANSACT_MANUAL ) != 0 ) )
+        {
+            RedPrintf( "Error %d setting the transaction mask\n", ( int ) red_errno );
+            iRet = 1;
+        }
+        else
+        {
+            iFildes = red_open( szPath, RED_O_RDWR | RED_O_CREAT | RED_O_TRUNC );
+
+            if( ( iFildes < 0 ) || ( red_transact( pParam->pszVolume ) != 0 ) )
+            {
+                RedPrintf( "Error %d creating %s\n", ( int ) red_errno, szPath );
+                iRet = 1;
+            }
+        }
+
+        for( ulOp = 0U; ( iRet == 0 ) && ( ulOp < pParam->ulOps ); ulOp++ )
+        {
+            uint32_t ulChoice = RedRand32( &ulSeed ) % 100U;
+
+            if( ulChoice < 75U )
+            {
+                uint32_t ulLen = ( RedRand32( &ulSeed ) % TRANSTEST_IO_MAX ) + 1U;
+                uint32_t ulOffset = RedRand32( &ulSeed ) % ( ( TRANSTEST_FILE_MAX - ulLen ) + 1U );
+                uint32_t ulIdx;
+
+                for( ulIdx = 0U; ulIdx < ulLen; ulIdx++ )
+                {
+                    gabBuffer[ ulIdx ] = ( uint8_t ) RedRand32( &ulSeed );
+                }
+
+                if( ( red_lseek( iFildes, ( int64_t ) ulOffset, RED_SEEK_SET ) != ( int64_t ) ulOffset ) ||
+                    ( red_write( iFildes, gabBuffer, ulLen ) != ( int32_t ) ulLen ) )
+                {
+                    RedPrintf( "op %u: error %d writing\n", ( unsigned ) ulOp, ( int ) red_errno );
+                    iRet = 1;
+                }
+                else
+                {
+                    RedMemCpy( &gWorking.abData[ ulOffset ], gabBuffer, ulLen );
+
+                    if( ( ulOffset + ulLen ) > gWorking.ulSize )
+                    {
+                        gWorking.ulSize = ulOffset + ulLen;
+                    }
+                }
+            }
+            else if( ulChoice < 88U )
+            {
+                uint32_t ulSize = RedRand32( &ulSeed ) % ( TRANSTEST_FILE_MAX + 1U );
+
+                if( red_ftruncate( iFildes, ulSize ) != 0 )
+                {
+                    RedPrintf( "op %u: error %d truncating\n", ( unsigned ) ulOp, ( int ) red_errno );
+                    iRet = 1;
+                }
+                else
+                {
+                    if( ulSize < gWorking.ulSize )
+                    {
+                        RedMemSet( &gWorking.abData[ ulSize ], 0U, gWorking.ulSize - ulSize );
+                    }
+
+                    gWorking.ulSize = ulSize;
+                }
+            }
+            else if( ulChoice < 97U )
+            {
+                if( red_transact( pParam->pszVolume ) != 0 )
+                {
+                    RedPrintf( "op %u: error %d from red_transact()\n", ( unsigned ) ulOp, ( int ) red_errno );
+                    iRet = 1;
+                }
+                else
+                {
+                    gCommitted = gWorking;
+                }
+            }
+            else
+            {
+                iRet = TransTestCheck( pParam->pszVolume, szPath, ulOp, &iFildes );
+            }
+        }
+
+        if( iRet == 0 )
+        {
+            iRet = TransTestCheck( pParam->pszVolume, szPath, ulOp, &iFildes );
+        }
+
+        if( iFildes >= 0 )
+        {
+            ( void ) red_close( iFildes );
+        }
+
+        ( void ) red_unlink( szPath );
+        ( void ) red_transact( pParam->pszVolume );
+        ( void ) red_settransmask( pParam->pszVolume, ulOrigMask );
+
+        if( iRet == 0 )
+        {
+            RedPrintf( "transtest: %u operations OK\n", ( unsigned ) pParam->ulOps );
+        }
+
+        return iRet;
+    }
+
+
+/** @brief Simulate a power loss and check the file against the committed
+ *         model.
+ *
+ *  The volume is unmounted without a transaction point, discarding the working
+ *  state, and mounted again.  Afterward, both models are the committed state.
+ *
+ *  @param pszVolume    The volume path prefix.
+ *  @param pszPath      The path of the test file.
+ *  @param ulOp         The operation number, for error messages.
+ *  @param piFildes     On entry, the open file descriptor of the test file.  On
+ *                      return, a new file descriptor for it, or -1.
+ *
+ *  @return Zero on success, otherwise nonzero.
+ */
+    static int TransTestCheck( const char * pszVolume,
+                               const char * pszPath,
+                               uint32_t ulOp,
+                               int32_t * piFildes )
+    {
+        int iRet = 0;
+
+        #if REDCONF_TRANSACT_BACKGROUND == 1
+
+            /*  Commits any transaction point the file system deferred, which
+             *  in manual mode must be none.
+             */
+            if( red_transactwait( pszVolume ) != 0 )
+            {
+                RedPrintf( "op %u: error %d from red_transactwait()\n", ( unsigned ) ulOp, ( int ) red_errno );
+                iRet = 1;
+            }
+        #endif
+
+        ( void ) red_close( *piFildes );
+        *piFildes = -1;
+
+        if( ( iRet == 0 ) && ( ( red_umount( pszVolume ) != 0 ) || ( red_mount( pszVolume ) != 0 ) ) )
+        {
+            RedPrintf( "op %u: error %d remounting\n", ( unsigned ) ulOp, ( int ) red_errno );
+            iRet = 1;
+        }
+
+        if( iRet == 0 )
+        {
+            *piFildes = red_open( pszPath, RED_O_RDWR );
+
+            if( *piFildes < 0 )
+            {
+                RedPrintf( "op %u: error %d reopening\n", ( unsigned ) ulOp, ( int ) red_errno );
+                iRet = 1;
+            }
+        }
+
+        if( iRet == 0 )
+        {
+            uint32_t ulOffset = 0U;
+            int32_t iLen;
+
+            do
+            {
+                iLen = red_read( *piFildes, gabBuffer, sizeof( gabBuffer ) );
+
+                if( iLen < 0 )
+                {
+                    RedPrintf( "op %u: error %d reading\n", ( unsigned ) ulOp, ( int ) red_errno );
+                    iRet = 1;
+                }
+                else if( ( ( ulOffset + ( uint32_t ) iLen ) > gCommitted.ulSize ) ||
+                         ( RedMemCmp( gabBuffer, &gCommitted.abData[ ulOffset ], ( uint32_t ) iLen ) != 0 ) )
+                {
+                    RedPrintf( "op %u: file differs from the last red_transact() near offset %u\n", ( unsigned ) ulOp, ( unsigned ) ulOffset );
+                    iRet = 1;
+                }
+                else
+                {
+                    ulOffset += ( uint32_t ) iLen;
+                }
+            } while( ( iRet == 0 ) && ( iLen > 0 ) );
+
+            if( ( iRet == 0 ) && ( ulOffset != gCommitted.ulSize ) )
+            {
+                RedPrintf( "op %u: file size %u, expected %u\n", ( unsigned ) ulOp, ( unsigned ) ulOffset, ( unsigned ) gCommitted.ulSize );
+                iRet = 1;
+            }
+        }
+
+        gWorking = gCommitted;
+
+        return iRet;
+    }
+
+
+/** @brief Print usage information.
+ *
+ *  @param pszProgName  Name of the program.
+ */
+    static void usage( const char * pszProgName )
+    {
+        RedPrintf( "usage: %s VolumeID [Options]\n", pszProgName );
+        RedPrintf( "Check that with manual transactions, only red_transact() commits.\n\n" );
+        RedPrintf( "Where:\n" );
+        RedPrintf( "  VolumeID\n" );
+        RedPrintf( "      A volume number (e.g., 2) or a volume path prefix (e.g., VOL1: or /data)\n" );
+        RedPrintf( "      of the volume to test.\n" );
+        RedPrintf( "And 'Options' are any of the following:\n" );
+        RedPrintf( "  --ops=count, -n count\n" );
+        RedPrintf( "      Number of random operations (default 5000).\n" );
+        RedPrintf( "  --seed=value, -s value\n" );
+        RedPrintf( "      Random number seed (default 1).\n" );
+        RedPrintf( "  --dev=devname, -D devname\n" );
+        RedPrintf( "      Specifies the device name.  This is typically only meaningful when\n" );
+        RedPrintf( "      running the test on a host machine.  This can be \"ram\" to test on a RAM\n" );
+        RedPrintf( "      disk, the path and name of a file disk (e.g., red.bin); or an OS-specific\n" );
+        RedPrintf( "      reference to a device (on Windows, a drive letter like G: or a device name\n" );
+        RedPrintf( "      like \\\\.\\PhysicalDrive7).\n" );
+        RedPrintf( "  --help, -H\n" );
+        RedPrintf( "      Prints this usage text and exits.\n\n" );
+    }
+
+#endif /* TRANSTEST_SUPPORTED */
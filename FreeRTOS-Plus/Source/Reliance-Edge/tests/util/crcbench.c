@@ -0,0 +1,307 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Micro-benchmark for the CRC-32 algorithms.
+ *
+ *  Computes the CRC of buffers of each power-of-two size in a range with every
+ *  CRC algorithm, checks that all algorithms agree, and prints the throughput
+ *  of each.  Requires REDCONF_CRC_BENCHMARK, so that all of the algorithms are
+ *  compiled.
+ */
+#include <redfs.h>
+#include <redtests.h>
+
+#if CRCBENCH_SUPPORTED
+
+    #include <redgetopt.h>
+
+
+/*  Largest supported buffer size.
+ */
+    #define CRCBENCH_SIZE_MAX    65536U
+
+/*  Number of CRC algorithms.
+ */
+    #define CRCBENCH_ALG_COUNT    5U
+
+
+    static bool CrcBenchIsPow2( uint32_t ulValue );
+    static void usage( const char * pszProgName );
+
+
+    static const char * const gapszAlgName[ CRCBENCH_ALG_COUNT ] =
+    {
+        "bitwise", "sarwate", "slice-by-8", "slice-by-16", "hardware"
+    };
+
+/*  One extra alignment unit, to allow for --offset.
+ */
+    static uint8_t gabBuffer[ CRCBENCH_SIZE_MAX + REDCONF_ALIGNMENT_SIZE ];
+
+/*  Receives each chained CRC, so that the compiler cannot discard the work.
+ */
+    static volatile uint32_t gulCrcSink;
+
+
+/** @brief Parse parameters for the CRC benchmark.
+ *
+ *  @param argc     The number of arguments from main().
+ *  @param argv     The vector of arguments from main().
+ *  @param pParam   Populated with the benchmark parameters.
+ *
+ *  @return The result of parsing the parameters.
+ */
+    PARAMSTATUS CrcBenchParseParams( int argc,
+                                     char * argv[],
+                                     CRCBENCHPARAM * pParam )
+    {
+        int c;
+        const REDOPTION aLongopts[] =
+        {
+            { "min",    red_required_argument, NULL, 'm' },
+            { "max",    red_required_argument, NULL, 'x' },
+            { "msecs",  red_required_argument, NULL, 't' },
+            { "offset", red_required_argument, NULL, 'o' },
+            { "help",   red_no_argument,       NULL, 'H' },
+            { NULL }
+        };
+
+        /*  Set default parameters.
+         */
+        CrcBenchDefaultParams( pParam );
+
+        while( ( c = RedGetoptLong( argc, argv, "m:x:t:o:H", aLongopts, NULL ) ) != -1 )
+        {
+            switch( c )
+            {
+                case 'm': /* --min */
+                    pParam->ulMinSize = RedAtoI( red_optarg );
+                    break;
+
+                case 'x': /* --max */
+                    pParam->ulMaxSize = RedAtoI( red_optarg );
+                    break;
+
+                case 't': /* --msecs */
+                    pParam->ulMsecs = RedAtoI( red_optarg );
+                    break;
+
+                case 'o': /* --offset */
+                    pParam->ulOffset = RedAtoI( red_optarg );
+                    break;
+
+                case 'H': /* --help */
+                    goto Help;
+
+                case '?': /* Unknown or ambiguous option */
+                case ':': /* Option missing required argument */
+                default:
+                    goto BadOpt;
+            }
+        }
+
+        if( !CrcBenchIsPow2( pParam->ulMinSize ) || !CrcBenchIsPow2( pParam->ulMaxSize ) ||
+            ( pParam->ulMinSize > pParam->ulMaxSize ) || ( pParam->ulMaxSize > CRCBENCH_SIZE_MAX ) )
+        {
+            RedPrintf( "Error: --min and --max must be powers of two, with --min <= --max <= %u.\n", ( unsigned ) CRCBENCH_SIZE_MAX );
+            goto BadOpt;
+        }
+
+        if( pParam->ulMsecs == 0U )
+        {
+            RedPrintf( "Error: --msecs must be nonzero.\n" );
+            goto BadOpt;
+        }
+
+        if( pParam->ulOffset >= REDCONF_ALIGNMENT_SIZE )
+        {
+            RedPrintf( "Error: --offset must be less than %u.\n", ( unsigned ) REDCONF_ALIGNMENT_SIZE );
+            goto BadOpt;
+        }
+
+        if( red_optind < argc )
+        {
+            int32_t ii;
+
+            for( ii = red_optind; ii < argc; ii++ )
+            {
+                RedPrintf( "Error: Unexpected command-line argument \"%s\".\n", argv[ ii ] );
+            }
+
+            goto BadOpt;
+        }
+
+        return PARAMSTATUS_OK;
+
+BadOpt:
+
+        RedPrintf( "%s - invalid parameters\n", argv[ 0U ] );
+        usage( argv[ 0U ] );
+        return PARAMSTATUS_BAD;
+
+Help:
+
+        usage( argv[ 0U ] );
+        return PARAMSTATUS_HELP;
+    }
+
+
+/** @brief Set default CRC benchmark parameters.
+ *
+ *  @param pParam   Populated with the default benchmark parameters.
+ */
+    void CrcBenchDefaultParams( CRCBENCHPARAM * pParam )
+    {
+        RedMemSet( pParam, 0U, sizeof( *pParam ) );
+        pParam->ulMinSize = 512U;
+        pParam->ulMaxSize = CRCBENCH_SIZE_MAX;
+        pParam->ulMsecs = 250U;
+        pParam->ulOffset = 0U;
+    }
+
+
+/** @brief Run the CRC benchmark.
+ *
+ *  @param pParam   Benchmark parameters, either from CrcBenchParseParams() or
+ *                  constructed programatically.
+ *
+ *  @return Zero on success, or nonzero if the algorithms disagree.
+ */
+    int CrcBenchStart( const CRCBENCHPARAM * pParam )
+    {
+        int iRet = 0;
+        const uint8_t * pbData = &gabBuffer[ pParam->ulOffset ];
+        uint32_t ulSeed = 1U;
+        uint32_t ulIdx;
+        uint32_t ulSize;
+        uint8_t bAlg;
+
+        for( ulIdx = 0U; ulIdx < sizeof( gabBuffer ); ulIdx++ )
+        {
+            gabBuffer[ ulIdx ] = ( uint8_t ) RedRand32( &ulSeed );
+        }
+
+        RedPrintf( "CRC-32 throughput in MB/s; hardware CRC %s\n",
+                   RedCrcHardwareAvailable() ? "uses CPU instructions" : "falls back to slice-by-16" );
+        RedPrintf( "%8s", "size" );
+
+        for( bAlg = 0U; bAlg < CRCBENCH_ALG_COUNT; bAlg++ )
+        {
+            RedPrintf( " %12s", gapszAlgName[ bAlg ] );
+        }
+
+        RedPrintf( "\n" );
+
+        for( ulSize = pParam->ulMinSize; ulSize <= pParam->ulMaxSize; ulSize <<= 1U )
+        {
+            uint32_t ulBatch = CRCBENCH_SIZE_MAX / ulSize;
+            uint32_t ulExpected = RedCrc32UpdateAlgorithm( CRC_BITWISE, 0U, pbData, ulSize );
+
+            RedPrintf( "%8u", ( unsigned ) ulSize );
+
+            for( bAlg = 0U; bAlg < CRCBENCH_ALG_COUNT; bAlg++ )
+            {
+                REDTIMESTAMP ts;
+                uint64_t ullUsecs = 0U;
+                uint64_t ullBytes = 0U;
+                uint32_t ulCrc = 0U;
+
+                if( RedCrc32UpdateAlgorithm( bAlg, 0U, pbData, ulSize ) != ulExpected )
+                {
+                    RedPrintf( "\nError: %s CRC mismatch for %u bytes\n", gapszAlgName[ bAlg ], ( unsigned ) ulSize );
+                    iRet = 1;
+                }
+
+                ts = RedOsTimestamp();
+
+                /*  The timestamp may be as coarse as the OS tick, so run batches
+                 *  of CRCs until enough time has passed for an accurate result.
+                 */
+                while( ullUsecs < ( ( uint64_t ) pParam->ulMsecs * 1000U ) )
+                {
+                    uint32_t ulIter;
+
+                    /*  Chain the CRCs, so that no iteration can be optimized
+                     *  away.
+                     */
+                    for( ulIter = 0U; ulIter < ulBatch; ulIter++ )
+                    {
+                        ulCrc = RedCrc32UpdateAlgorithm( bAlg, ulCrc, pbData, ulSize );
+                    }
+
+                    ullBytes += ( uint64_t ) ulBatch * ulSize;
+                    ullUsecs = RedOsTimePassed( ts );
+                }
+
+                gulCrcSink = ulCrc;
+
+                /*  Bytes per microsecond is (decimal) megabytes per second.
+                 */
+                RedPrintf( " %12u", ( unsigned ) ( ullBytes / ullUsecs ) );
+            }
+
+            RedPrintf( "\n" );
+        }
+
+        return iRet;
+    }
+
+
+/** @brief Determine whether a value is a nonzero power of two.
+ *
+ *  @param ulValue  The value to examine.
+ *
+ *  @return Whether @p ulValue is a power of two.
+ */
+    static bool CrcBenchIsPow2( uint32_t ulValue )
+    {
+        return ( ulValue != 0U ) && ( ( ulValue & ( ulValue - 1U ) ) == 0U );
+    }
+
+
+/** @brief Print usage information.
+ *
+ *  @param pszProgName  Name of the program.
+ */
+    static void usage( const char * pszProgName )
+    {
+        RedPrintf( "usage: %s [Options]\n", pszProgName );
+        RedPrintf( "Compare the throughput of the CRC-32 algorithms.\n\n" );
+        RedPrintf( "Where 'Options' are any of the following:\n" );
+        RedPrintf( "  --min=bytes, -m bytes\n" );
+        RedPrintf( "      Smallest buffer size, a power of two (default 512).\n" );
+        RedPrintf( "  --max=bytes, -x bytes\n" );
+        RedPrintf( "      Largest buffer size, a power of two (default %u).\n", ( unsigned ) CRCBENCH_SIZE_MAX );
+        RedPrintf( "  --msecs=count, -t count\n" );
+        RedPrintf( "      Minimum time to spend on each size and algorithm (default 250).\n" );
+        RedPrintf( "  --offset=bytes, -o bytes\n" );
+        RedPrintf( "      Misalign the buffer by this many bytes (default 0).\n" );
+        RedPrintf( "  --help, -H\n" );
+        RedPrintf( "      Prints this usage text and exits.\n\n" );
+    }
+
+#endif /* CRCBENCH_SUPPORTED */
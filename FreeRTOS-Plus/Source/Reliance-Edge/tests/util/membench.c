@@ -0,0 +1,553 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Micro-benchmark for the memory manipulation functions.
+ *
+ *  Measures the throughput of RedMemCpy(), RedMemMove(), RedMemSet(), and
+ *  RedMemCmp() on block sized buffers, next to that of plain byte loops.  The
+ *  RedMem functions are measured as configured: the default implementations in
+ *  util/memory.c, or whatever redconf.h maps the RedMem*Unchecked() macros to.
+ */
+#include <redfs.h>
+#include <redtests.h>
+
+#if MEMBENCH_SUPPORTED
+
+    #include <redgetopt.h>
+
+
+/*  Largest supported buffer size.
+ */
+    #define MEMBENCH_SIZE_MAX    ( REDCONF_BLOCK_SIZE * 2U )
+
+/*  Number of operations measured.
+ */
+    #define MEMBENCH_OP_COUNT    4U
+
+
+/*  An operation to measure.  Returns a value which depends on the work done, so
+ *  that the work cannot be optimized away.
+ */
+    typedef uint32_t ( * MEMBENCHFN )( uint8_t * pbDest,
+                                       const uint8_t * pbSrc,
+                                       uint32_t ulLen );
+
+    typedef struct
+    {
+        const char * pszName;
+        MEMBENCHFN pfnByte; /* Byte loop. */
+        MEMBENCHFN pfnRed;  /* The RedMem function. */
+    } MEMBENCHOP;
+
+
+    static uint32_t ByteCpy( uint8_t * pbDest,
+                             const uint8_t * pbSrc,
+                             uint32_t ulLen );
+    static uint32_t ByteMove( uint8_t * pbDest,
+                              const uint8_t * pbSrc,
+                              uint32_t ulLen );
+    static uint32_t ByteSet( uint8_t * pbDest,
+                             const uint8_t * pbSrc,
+                             uint32_t ulLen );
+    static uint32_t ByteCmp( uint8_t * pbDest,
+                             const uint8_t * pbSrc,
+                             uint32_t ulLen );
+    static uint32_t RedCpy( uint8_t * pbDest,
+                            const uint8_t * pbSrc,
+                            uint32_t ulLen );
+    static uint32_t RedMove( uint8_t * pbDest,
+                             const uint8_t * pbSrc,
+                             uint32_t ulLen );
+    static uint32_t RedSet( uint8_t * pbDest,
+                            const uint8_t * pbSrc,
+                            uint32_t ulLen );
+    static uint32_t RedCmp( uint8_t * pbDest,
+                            const uint8_t * pbSrc,
+                            uint32_t ulLen );
+    static uint32_t MemBenchRate( MEMBENCHFN pfnOp,
+                                  uint32_t ulMsecs,
+                                  uint8_t * pbDest,
+                                  const uint8_t * pbSrc,
+                                  uint32_t ulLen );
+    static void MemBenchPrintRate( uint32_t ulRate,
+                                   uint32_t ulMhz );
+    static void usage( const char * pszProgName );
+
+
+    static const MEMBENCHOP gaOp[ MEMBENCH_OP_COUNT ] =
+    {
+        { "copy",    ByteCpy,  RedCpy  },
+        { "move",    ByteMove, RedMove },
+        { "set",     ByteSet,  RedSet  },
+        { "compare", ByteCmp,  RedCmp  }
+    };
+
+/*  Extra words, to allow for --offset and --skew.
+ */
+    static uint8_t gabSrc[ MEMBENCH_SIZE_MAX + ( 2U * sizeof( uintptr_t ) ) ];
+    static uint8_t gabDest[ MEMBENCH_SIZE_MAX + sizeof( uintptr_t ) ];
+
+/*  Receives the result of each operation, so that the compiler cannot discard
+ *  the work.
+ */
+    static volatile uint32_t gulSink;
+
+
+/** @brief Parse parameters for the memory benchmark.
+ *
+ *  @param argc     The number of arguments from main().
+ *  @param argv     The vector of arguments from main().
+ *  @param pParam   Populated with the benchmark parameters.
+ *
+ *  @return The result of parsing the parameters.
+ */
+    PARAMSTATUS MemBenchParseParams( int argc,
+                                     char * argv[],
+                                     MEMBENCHPARAM * pParam )
+    {
+        int c;
+        const REDOPTION aLongopts[] =
+        {
+            { "size",   red_required_argument, NULL, 'z' },
+            { "offset", red_required_argument, NULL, 'o' },
+            { "skew",   red_required_argument, NULL, 'k' },
+            { "msecs",  red_required_argument, NULL, 't' },
+            { "mhz",    red_required_argument, NULL, 'c' },
+            { "help",   red_no_argument,       NULL, 'H' },
+            { NULL }
+        };
+
+        /*  Set default parameters.
+         */
+        MemBenchDefaultParams( pParam );
+
+        while( ( c = RedGetoptLong( argc, argv, "z:o:k:t:c:H", aLongopts, NULL ) ) != -1 )
+        {
+            switch( c )
+            {
+                case 'z': /* --size */
+                    pParam->ulSize = RedAtoI( red_optarg );
+                    break;
+
+                case 'o': /* --offset */
+                    pParam->ulOffset = RedAtoI( red_optarg );
+                    break;
+
+                case 'k': /* --skew */
+                    pParam->ulSkew = RedAtoI( red_optarg );
+                    break;
+
+                case 't': /* --msecs */
+                    pParam->ulMsecs = RedAtoI( red_optarg );
+                    break;
+
+                case 'c': /* --mhz */
+                    pParam->ulMhz = RedAtoI( red_optarg );
+                    break;
+
+                case 'H': /* --help */
+                    goto Help;
+
+                case '?': /* Unknown or ambiguous option */
+                case ':': /* Option missing required argument */
+                default:
+                    goto BadOpt;
+            }
+        }
+
+        if( ( pParam->ulSize == 0U ) || ( pParam->ulSize > MEMBENCH_SIZE_MAX ) )
+        {
+            RedPrintf( "Error: --size must be between 1 and %u.\n", ( unsigned ) MEMBENCH_SIZE_MAX );
+            goto BadOpt;
+        }
+
+        if( ( pParam->ulOffset >= sizeof( uintptr_t ) ) || ( pParam->ulSkew >= sizeof( uintptr_t ) ) )
+        {
+            RedPrintf( "Error: --offset and --skew must be less than %u.\n", ( unsigned ) sizeof( uintptr_t ) );
+            goto BadOpt;
+        }
+
+        if( pParam->ulMsecs == 0U )
+        {
+            RedPrintf( "Error: --msecs must be nonzero.\n" );
+            goto BadOpt;
+        }
+
+        if( red_optind < argc )
+        {
+            int32_t ii;
+
+            for( ii = red_optind; ii < argc; ii++ )
+            {
+                RedPrintf( "Error: Unexpected command-line argument \"%s\".\n", argv[ ii ] );
+            }
+
+            goto BadOpt;
+        }
+
+        return PARAMSTATUS_OK;
+
+BadOpt:
+
+        RedPrintf( "%s - invalid parameters\n", argv[ 0U ] );
+        usage( argv[ 0U ] );
+        return PARAMSTATUS_BAD;
+
+Help:
+
+        usage( argv[ 0U ] );
+        return PARAMSTATUS_HELP;
+    }
+
+
+/** @brief Set default memory benchmark parameters.
+ *
+ *  @param pParam   Populated with the default benchmark parameters.
+ */
+    void MemBenchDefaultParams( MEMBENCHPARAM * pParam )
+    {
+        RedMemSet( pParam, 0U, sizeof( *pParam ) );
+        pParam->ulSize = REDCONF_BLOCK_SIZE;
+        pParam->ulOffset = 0U;
+        pParam->ulSkew = 0U;
+        pParam->ulMsecs = 250U;
+        pParam->ulMhz = 0U;
+    }
+
+
+/** @brief Run the memory benchmark.
+ *
+ *  @param pParam   Benchmark parameters, either from MemBenchParseParams() or
+ *                  constructed programatically.
+ *
+ *  @return Zero on success, or nonzero if a RedMem function gave the wrong
+ *          result.
+ */
+    int MemBenchStart( const MEMBENCHPARAM * pParam )
+    {
+        int iRet = 0;
+        uint8_t * pbDest = &gabDest[ pParam->ulOffset ];
+        const uint8_t * pbSrc = &gabSrc[ pParam->ulOffset + pParam->ulSkew ];
+        uint32_t ulSeed = 1U;
+        uint32_t ulIdx;
+        uint8_t bOp;
+
+        for( ulIdx = 0U; ulIdx < sizeof( gabSrc ); ulIdx++ )
+        {
+            gabSrc[ ulIdx ] = ( uint8_t ) RedRand32( &ulSeed );
+        }
+
+        /*  Sanity check the RedMem functions before timing them.
+         */
+        RedMemCpy( pbDest, pbSrc, pParam->ulSize );
+
+        if( RedMemCmp( pbDest, pbSrc, pParam->ulSize ) != 0 )
+        {
+            RedPrintf( "Error: RedMemCpy() or RedMemCmp() gave the wrong result\n" );
+            iRet = 1;
+        }
+
+        RedPrintf( "%u byte buffers, destination offset %u, source offset %u; rates in MB/s%s\n",
+                   ( unsigned ) pParam->ulSize, ( unsigned ) pParam->ulOffset, ( unsigned ) ( pParam->ulOffset + pParam->ulSkew ),
+                   ( pParam->ulMhz == 0U ) ? "" : " (bytes/cycle)" );
+        RedPrintf( "%-8s %20s %20s\n", "", "byte loop", "RedMem" );
+
+        for( bOp = 0U; bOp < MEMBENCH_OP_COUNT; bOp++ )
+        {
+            /*  Make the buffers equal, so that comparisons run the full length.
+             */
+            RedMemCpy( pbDest, pbSrc, pParam->ulSize );
+
+            RedPrintf( "%-8s", gaOp[ bOp ].pszName );
+            MemBenchPrintRate( MemBenchRate( gaOp[ bOp ].pfnByte, pParam->ulMsecs, pbDest, pbSrc, pParam->ulSize ), pParam->ulMhz );
+            MemBenchPrintRate( MemBenchRate( gaOp[ bOp ].pfnRed, pParam->ulMsecs, pbDest, pbSrc, pParam->ulSize ), pParam->ulMhz );
+            RedPrintf( "\n" );
+        }
+
+        return iRet;
+    }
+
+
+/** @brief Measure the throughput of an operation.
+ *
+ *  @param pfnOp    The operation to measure.
+ *  @param ulMsecs  Minimum time to spend measuring.
+ *  @param pbDest   The destination buffer.
+ *  @param pbSrc    The source buffer.
+ *  @param ulLen    The buffer size.
+ *
+ *  @return The throughput in bytes per microsecond (decimal megabytes per
+ *          second).
+ */
+    static uint32_t MemBenchRate( MEMBENCHFN pfnOp,
+                                  uint32_t ulMsecs,
+                                  uint8_t * pbDest,
+                                  const uint8_t * pbSrc,
+                                  uint32_t ulLen )
+    {
+        /*  Enough operations per batch to make the cost of reading the
+         *  timestamp negligible.
+         */
+        uint32_t ulBatch = ( ( 64U * 1024U ) / ulLen ) + 1U;
+        REDTIMESTAMP ts = RedOsTimestamp();
+        uint64_t ullUsecs = 0U;
+        uint64_t ullBytes = 0U;
+        uint32_t ulResult = 0U;
+
+        /*  The timestamp may be as coarse as the OS tick, so run batches until
+         *  enough time has passed for an accurate result.
+         */
+        while( ullUsecs < ( ( uint64_t ) ulMsecs * 1000U ) )
+        {
+            uint32_t ulIter;
+
+            for( ulIter = 0U; ulIter < ulBatch; ulIter++ )
+            {
+                ulResult += pfnOp( pbDest, pbSrc, ulLen );
+            }
+
+            ullBytes += ( uint64_t ) ulBatch * ulLen;
+            ullUsecs = RedOsTimePassed( ts );
+        }
+
+        gulSink = ulResult;
+
+        return ( uint32_t ) ( ullBytes / ullUsecs );
+    }
+
+
+/** @brief Print a throughput, and the bytes per cycle if the clock is known.
+ *
+ *  @param ulRate   The throughput in MB/s.
+ *  @param ulMhz    The CPU clock rate in MHz, or zero if unknown.
+ */
+    static void MemBenchPrintRate( uint32_t ulRate,
+                                   uint32_t ulMhz )
+    {
+        if( ulMhz == 0U )
+        {
+            RedPrintf( " %20u", ( unsigned ) ulRate );
+        }
+        else
+        {
+            uint32_t ulHundredths = ( uint32_t ) ( ( ( uint64_t ) ulRate * 100U ) / ulMhz );
+
+            RedPrintf( " %10u (%3u.%02u)", ( unsigned ) ulRate, ( unsigned ) ( ulHundredths / 100U ), ( unsigned ) ( ulHundredths % 100U ) );
+        }
+    }
+
+
+/** @brief Copy with a byte loop.
+ *
+ *  @param pbDest   The destination buffer.
+ *  @param pbSrc    The source buffer.
+ *  @param ulLen    The buffer size.
+ *
+ *  @return A value which depends on the result.
+ */
+    static uint32_t ByteCpy( uint8_t * pbDest,
+                             const uint8_t * pbSrc,
+                             uint32_t ulLen )
+    {
+        uint32_t ulIdx;
+
+        for( ulIdx = 0U; ulIdx < ulLen; ulIdx++ )
+        {
+            pbDest[ ulIdx ] = pbSrc[ ulIdx ];
+        }
+
+        return pbDest[ 0U ];
+    }
+
+
+/** @brief Copy backward with a byte loop.
+ *
+ *  @param pbDest   The destination buffer.
+ *  @param pbSrc    The source buffer.
+ *  @param ulLen    The buffer size.
+ *
+ *  @return A value which depends on the result.
+ */
+    static uint32_t ByteMove( uint8_t * pbDest,
+                              const uint8_t * pbSrc,
+                              uint32_t ulLen )
+    {
+        uint32_t ulIdx = ulLen;
+
+        /*  The buffers do not overlap, but copy backward, as memmove() does
+         *  when the destination is above the source.
+         */
+        while( ulIdx > 0U )
+        {
+            ulIdx--;
+            pbDest[ ulIdx ] = pbSrc[ ulIdx ];
+        }
+
+        return pbDest[ 0U ];
+    }
+
+
+/** @brief Fill with a byte loop.
+ *
+ *  @param pbDest   The destination buffer.
+ *  @param pbSrc    The source buffer.
+ *  @param ulLen    The buffer size.
+ *
+ *  @return A value which depends on the result.
+ */
+    static uint32_t ByteSet( uint8_t * pbDest,
+                             const uint8_t * pbSrc,
+                             uint32_t ulLen )
+    {
+        uint32_t ulIdx;
+
+        for( ulIdx = 0U; ulIdx < ulLen; ulIdx++ )
+        {
+            pbDest[ ulIdx ] = pbSrc[ 0U ];
+        }
+
+        return pbDest[ 0U ];
+    }
+
+
+/** @brief Compare with a byte loop.
+ *
+ *  @param pbDest   The destination buffer.
+ *  @param pbSrc    The source buffer.
+ *  @param ulLen    The buffer size.
+ *
+ *  @return A value which depends on the result.
+ */
+    static uint32_t ByteCmp( uint8_t * pbDest,
+                             const uint8_t * pbSrc,
+                             uint32_t ulLen )
+    {
+        uint32_t ulIdx = 0U;
+
+        while( ( ulIdx < ulLen ) && ( pbDest[ ulIdx ] == pbSrc[ ulIdx ] ) )
+        {
+            ulIdx++;
+        }
+
+        return ulIdx;
+    }
+
+
+/** @brief Copy with RedMemCpy().
+ *
+ *  @param pbDest   The destination buffer.
+ *  @param pbSrc    The source buffer.
+ *  @param ulLen    The buffer size.
+ *
+ *  @return A value which depends on the result.
+ */
+    static uint32_t RedCpy( uint8_t * pbDest,
+                            const uint8_t * pbSrc,
+                            uint32_t ulLen )
+    {
+        RedMemCpy( pbDest, pbSrc, ulLen );
+
+        return pbDest[ 0U ];
+    }
+
+
+/** @brief Copy with RedMemMove().
+ *
+ *  @param pbDest   The destination buffer.
+ *  @param pbSrc    The source buffer.
+ *  @param ulLen    The buffer size.
+ *
+ *  @return A value which depends on the result.
+ */
+    static uint32_t RedMove( uint8_t * pbDest,
+                             const uint8_t * pbSrc,
+                             uint32_t ulLen )
+    {
+        RedMemMove( pbDest, pbSrc, ulLen );
+
+        return pbDest[ 0U ];
+    }
+
+
+/** @brief Fill with RedMemSet().
+ *
+ *  @param pbDest   The destination buffer.
+ *  @param pbSrc    The source buffer.
+ *  @param ulLen    The buffer size.
+ *
+ *  @return A value which depends on the result.
+ */
+    static uint32_t RedSet( uint8_t * pbDest,
+                            const uint8_t * pbSrc,
+                            uint32_t ulLen )
+    {
+        RedMemSet( pbDest, pbSrc[ 0U ], ulLen );
+
+        return pbDest[ 0U ];
+    }
+
+
+/** @brief Compare with RedMemCmp().
+ *
+ *  @param pbDest   The destination buffer.
+ *  @param pbSrc    The source buffer.
+ *  @param ulLen    The buffer size.
+ *
+ *  @return A value which depends on the result.
+ */
+    static uint32_t RedCmp( uint8_t * pbDest,
+                            const uint8_t * pbSrc,
+                            uint32_t ulLen )
+    {
+        return ( uint32_t ) RedMemCmp( pbDest, pbSrc, ulLen );
+    }
+
+
+/** @brief Print usage information.
+ *
+ *  @param pszProgName  Name of the program.
+ */
+    static void usage( const char * pszProgName )
+    {
+        RedPrintf( "usage: %s [Options]\n", pszProgName );
+        RedPrintf( "Compare the throughput of the memory functions with byte loops.\n\n" );
+        RedPrintf( "Where 'Options' are any of the following:\n" );
+        RedPrintf( "  --size=bytes, -z bytes\n" );
+        RedPrintf( "      Buffer size, up to %u (default %u, the block size).\n", ( unsigned ) MEMBENCH_SIZE_MAX, ( unsigned ) REDCONF_BLOCK_SIZE );
+        RedPrintf( "  --offset=bytes, -o bytes\n" );
+        RedPrintf( "      Misalign both buffers by this many bytes (default 0).\n" );
+        RedPrintf( "  --skew=bytes, -k bytes\n" );
+        RedPrintf( "      Misalign the source by this many more bytes (default 0).\n" );
+        RedPrintf( "  --msecs=count, -t count\n" );
+        RedPrintf( "      Minimum time to spend on each measurement (default 250).\n" );
+        RedPrintf( "  --mhz=rate, -c rate\n" );
+        RedPrintf( "      CPU clock rate in MHz; if given, bytes per cycle are also shown.\n" );
+        RedPrintf( "  --help, -H\n" );
+        RedPrintf( "      Prints this usage text and exits.\n\n" );
+    }
+
+#endif /* MEMBENCH_SUPPORTED */
@@ -0,0 +1,1968 @@
+/*             ----> DO NOT REMOVE THE FOLLOWING NOTICE <----
+ *
+ *                 Copyright (c) 2014-2015 Datalight, Inc.
+ *                     All Rights Reserved Worldwide.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; use version 2 of the License.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but "AS-IS," WITHOUT ANY WARRANTY; without even the implied warranty
+ *  of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*  Businesses and individuals that for commercial or other reasons cannot
+ *  comply with the terms of the GPLv2 license may obtain a commercial license
+ *  before incorporating Reliance Edge into proprietary software for
+ *  distribution in any form.  Visit http://www.datalight.com/reliance-edge for
+ *  more information.
+ */
+
+/** @file
+ *  @brief Host tool which checks a volume image offline, using several
+ *         threads.
+ *
+ *  The image file is mapped into memory and its on-disk structures are
+ *  examined directly, rather than through the driver, so that the work can be
+ *  split between threads.  The tool must be built with the same redconf.h as
+ *  the driver which wrote the image, since that determines the on-disk layout;
+ *  the master block is checked against it.  Images are little-endian, so the
+ *  tool only runs on little-endian hosts (whatever REDCONF_ENDIAN_SWAP says
+ *  about the target).
+ *
+ *  The check runs in phases.  The calling thread checks the master block and
+ *  picks the metaroot, as mount would.  Worker threads then check the imap
+ *  nodes, and then the inodes: each inode's block pointers, indirect nodes and,
+ *  for directories, directory entries.  What the workers find is recorded in
+ *  shared tables with atomic operations.  Last, the calling thread compares
+ *  those tables with the imap and the metaroot counts, and checks the names
+ *  and parents of every inode.
+ *
+ *  The report, on stdout or in a file, is a JSON object which lists up to a
+ *  given number of the problems found.  The exit code is 0 if the volume is
+ *  consistent, 1 if it is not, and 2 if it could not be checked.
+ *
+ *  The tool is built from this file, toolcmn/getopt.c and util/crc.c, and needs
+ *  POSIX threads and a compiler with the GCC __atomic built-ins.
+ */
+#include <redfs.h>
+#include <redcore.h>
+#include <redgetopt.h>
+#include <redtools.h>
+
+/*  The host headers come after the Reliance Edge headers, since <sys/stat.h>
+ *  may define macros which clash with the REDSTAT member names.
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/*  Exit codes.
+ */
+#define CHK_EXIT_CLEAN      0
+#define CHK_EXIT_CORRUPT    1
+#define CHK_EXIT_FAILED     2
+
+/*  Number of inodes which a worker thread claims at a time.
+ */
+#define CHK_INODE_BATCH     64U
+
+/*  Interval between progress reports, in milliseconds.
+ */
+#define CHK_PROGRESS_MS     250U
+
+/*  Interval at which the calling thread checks whether a phase has finished,
+ *  in milliseconds.
+ */
+#define CHK_POLL_MS         5U
+
+#define CHK_THREADS_MAX     256U
+
+/*  What an inode slot turned out to hold.
+ */
+#define CHKINO_FREE         0U
+#define CHKINO_FILE         1U
+#define CHKINO_DIR          2U
+#define CHKINO_BAD          3U /* Allocated, but not a valid inode. */
+
+/*  Whether a directory can be reached from the root.
+ */
+#define CHKREACH_UNKNOWN    0U
+#define CHKREACH_YES        1U
+#define CHKREACH_NO         2U
+#define CHKREACH_VISITING   3U
+
+
+/*  A problem found in the volume.
+ */
+typedef struct
+{
+    const char * pszKind; /* Short machine-readable name of the problem. */
+    uint32_t ulInode;     /* Inode concerned; INODE_INVALID if none. */
+    uint32_t ulBlock;     /* Block concerned; zero if none. */
+    char szDetail[ 96U ]; /* Human-readable description. */
+} CHKPROBLEM;
+
+
+/*  What was found about one inode.  The worker which checks the inode fills in
+ *  all but ulNames and ulNamedBy, which are updated atomically by the workers
+ *  which check directories.
+ */
+typedef struct
+{
+    uint32_t ulNLink;   /* Link count stored in the inode. */
+    uint32_t ulPInode;  /* Parent inode stored in the inode. */
+    uint32_t ulNames;   /* Number of directory entries which name the inode. */
+    uint32_t ulNamedBy; /* A directory which names the inode; INODE_INVALID if none. */
+    uint8_t bType;      /* One of the CHKINO_* values. */
+    uint8_t bReach;     /* One of the CHKREACH_* values (directories only). */
+} CHKINODE;
+
+
+typedef struct sCHECKER CHECKER;
+
+/*  State private to one worker thread.
+ */
+typedef struct
+{
+    CHECKER * pChk;
+    pthread_t thread;
+    #if REDCONF_API_POSIX == 1
+        const DIRENT ** ppNames; /* Entries of the directory being checked. */
+        uint32_t ulNameCount;
+        uint32_t ulNameCap;
+    #endif
+} CHKWORKER;
+
+typedef void (* CHKWORKFN)( CHKWORKER * pWorker,
+                            uint32_t ulItem );
+
+/*  The state of a check.
+ */
+struct sCHECKER
+{
+    const CHKPARAM * pParam;
+
+    const uint8_t * pbImage;  /* The mapped image. */
+    size_t nImageSize;        /* Size of the mapped image, in bytes. */
+
+    uint32_t ulBlockCount;    /* From the master block. */
+    uint32_t ulInodeCount;    /* From the master block. */
+    uint64_t ullSeqMax;       /* Highest sequence number of a valid node. */
+    uint8_t bCurMR;           /* Which metaroot is current. */
+    bool fOtherMRValid;       /* Whether the other metaroot is valid too. */
+    METAROOT mr;              /* Copy of the current metaroot. */
+
+    bool fImapInline;
+    uint32_t ulImapStartBN;
+    uint32_t ulImapNodeCount;
+    uint32_t ulInodeTableStartBN;
+    uint32_t ulFirstAllocableBN;
+
+    /*  The committed imap, a bit per block starting at ulInodeTableStartBN.
+     */
+    uint8_t * pbImap;
+
+    /*  A bit per block, which is set when the block is found to be used by an
+     *  inode.
+     */
+    uint8_t * pbFound;
+
+    CHKINODE * pInodes;       /* Indexed by inode number less INODE_FIRST_VALID. */
+
+    /*  The current phase, shared with the worker threads.
+     */
+    const char * pszPhase;
+    CHKWORKFN pfnWork;
+    uint32_t ulItems;
+    uint32_t ulBatch;
+    uint32_t ulNextItem;
+    uint32_t ulItemsDone;
+    CHKWORKER aWorker[ CHK_THREADS_MAX ];
+
+    /*  Set when an imap node is invalid, so which blocks and inodes are in use
+     *  is unknown.
+     */
+    bool fImapBad;
+
+    /*  Set when something prevented part of the check from being done.
+     */
+    bool fIncomplete;
+
+    pthread_mutex_t problemMutex;
+    CHKPROBLEM * pProblems;
+    uint32_t ulProblemCount;
+
+    uint32_t ulFiles;
+    uint32_t ulDirs;
+    uint32_t ulBadInodes;
+    uint32_t ulFreeInodes;
+    uint32_t ulFreeBlocks;
+    uint64_t ullDataBlocks;
+};
+
+
+static void ChkRunPhase( CHECKER * pChk,
+                         const char * pszPhase,
+                         CHKWORKFN pfnWork,
+                         uint32_t ulItems,
+                         uint32_t ulBatch );
+static void * ChkWorkerThread( void * pArg );
+static bool ChkMaster( CHECKER * pChk );
+static bool ChkMetaroot( CHECKER * pChk );
+static bool ChkGeometry( CHECKER * pChk );
+static bool ChkImap( CHECKER * pChk );
+#if REDCONF_IMAP_EXTERNAL == 1
+    static void ChkImapNode( CHKWORKER * pWorker,
+                             uint32_t ulItem );
+#endif
+static void ChkInode( CHKWORKER * pWorker,
+                      uint32_t ulItem );
+static uint32_t ChkInodeData( CHKWORKER * pWorker,
+                              uint32_t ulInode,
+                              const INODE * pInode,
+                              bool fDir );
+#if REDCONF_INODE_INLINE_DATA == 1
+    static void ChkInodeInline( CHECKER * pChk,
+                                uint32_t ulInode,
+                                const INODE * pInode,
+                                bool fDir );
+#endif
+#if DINDIR_POINTERS > 0U
+    static void ChkDindir( CHKWORKER * pWorker,
+                           uint32_t ulInode,
+                           uint32_t ulBlock,
+                           uint64_t ullFirst,
+                           uint64_t ullSize,
+                           bool fDir,
+                           uint32_t * pulCount );
+#endif
+#if REDCONF_DIRECT_POINTERS < INODE_ENTRIES
+    static void ChkIndir( CHKWORKER * pWorker,
+                          uint32_t ulInode,
+                          uint32_t ulBlock,
+                          uint64_t ullFirst,
+                          uint64_t ullSize,
+                          bool fDir,
+                          uint32_t * pulCount );
+#endif
+static void ChkDataBlock( CHKWORKER * pWorker,
+                          uint32_t ulInode,
+                          uint32_t ulBlock,
+                          uint64_t ullFileBlock,
+                          uint64_t ullSize,
+                          bool fDir,
+                          uint32_t * pulCount );
+static bool ChkClaimBlock( CHECKER * pChk,
+                           uint32_t ulInode,
+                           uint32_t ulBlock );
+#if REDCONF_API_POSIX == 1
+    static void ChkDirBlock( CHKWORKER * pWorker,
+                             uint32_t ulPInode,
+                             const uint8_t * pbBlock,
+                             uint64_t ullFileBlock,
+                             uint64_t ullSize );
+    static void ChkDirNames( CHKWORKER * pWorker,
+                             uint32_t ulPInode );
+    static int ChkDirentCompare( const void * pA,
+                                 const void * pB );
+    static uint8_t ChkReach( CHECKER * pChk,
+                             uint32_t ulInode );
+#endif
+static void ChkSummarize( CHECKER * pChk );
+static const char * ChkNodeProblem( const CHECKER * pChk,
+                                    const void * pNode,
+                                    uint32_t ulSignature );
+static const uint8_t * ChkBlock( const CHECKER * pChk,
+                                 uint32_t ulBlock );
+static bool ChkImapBit( const CHECKER * pChk,
+                        uint32_t ulBlock );
+static void ChkProblem( CHECKER * pChk,
+                        const char * pszKind,
+                        uint32_t ulInode,
+                        uint32_t ulBlock,
+                        const char * pszFormat,
+                        ... );
+static void ChkReport( const CHECKER * pChk,
+                       FILE * pFile,
+                       const char * pszResult,
+                       uint64_t ullElapsedMs );
+static void ChkJsonString( FILE * pFile,
+                           const char * psz );
+static uint64_t ChkMsec( void );
+static void usage( const char * pszProgName );
+
+
+/** @brief Parse parameters for the image checker.
+ *
+ *  @param argc     The number of arguments from main().
+ *  @param argv     The vector of arguments from main().
+ *  @param pParam   Populated with the checker parameters.
+ */
+void ChkParseParams( int argc,
+                     char * argv[],
+                     CHKPARAM * pParam )
+{
+    int32_t c;
+    long lCpus;
+    const REDOPTION aLongopts[] =
+    {
+        { "threads",      red_required_argument, NULL, 't' },
+        { "output",       red_required_argument, NULL, 'o' },
+        { "max-problems", red_required_argument, NULL, 'm' },
+        { "progress",     red_no_argument,       NULL, 'p' },
+        { "help",         red_no_argument,       NULL, 'H' },
+        { NULL }
+    };
+
+    memset( pParam, 0, sizeof( *pParam ) );
+
+    lCpus = sysconf( _SC_NPROCESSORS_ONLN );
+    pParam->ulThreads = ( lCpus < 1 ) ? 1U : ( ( lCpus > ( long ) CHK_THREADS_MAX ) ? CHK_THREADS_MAX : ( uint32_t ) lCpus );
+    pParam->ulMaxProblems = 100U;
+
+    while( ( c = RedGetoptLong( argc, argv, "t:o:m:pH", aLongopts, NULL ) ) != -1 )
+    {
+        switch( c )
+        {
+            case 't': /* --threads */
+                pParam->ulThreads = ( uint32_t ) strtoul( red_optarg, NULL, 10 );
+
+                if( ( pParam->ulThreads == 0U ) || ( pParam->ulThreads > CHK_THREADS_MAX ) )
+                {
+                    fprintf( stderr, "Error: --threads must be between 1 and %u.\n", ( unsigned ) CHK_THREADS_MAX );
+                    exit( CHK_EXIT_FAILED );
+                }
+
+                break;
+
+            case 'o': /* --output */
+                pParam->pszReport = red_optarg;
+                break;
+
+            case 'm': /* --max-problems */
+                pParam->ulMaxProblems = ( uint32_t ) strtoul( red_optarg, NULL, 10 );
+                break;
+
+            case 'p': /* --progress */
+                pParam->fProgress = true;
+                break;
+
+            case 'H': /* --help */
+                usage( argv[ 0U ] );
+                exit( CHK_EXIT_CLEAN );
+
+            case '?': /* Unknown or ambiguous option */
+            case ':': /* Option missing required argument */
+            default:
+                fprintf( stderr, "%s - invalid parameters\n", argv[ 0U ] );
+                usage( argv[ 0U ] );
+                exit( CHK_EXIT_FAILED );
+        }
+    }
+
+    /*  RedGetoptLong() has permuted argv to move all non-option arguments to
+     *  the end.  We expect to find exactly one: the image path.
+     */
+    if( ( red_optind + 1 ) != argc )
+    {
+        fprintf( stderr, "%s - expected one image file argument\n", argv[ 0U ] );
+        usage( argv[ 0U ] );
+        exit( CHK_EXIT_FAILED );
+    }
+
+    pParam->pszImage = argv[ red_optind ];
+}
+
+
+/** @brief Check a volume image.
+ *
+ *  @param pParam   The checker parameters.
+ *
+ *  @return The exit code of the tool: CHK_EXIT_CLEAN if the volume is
+ *          consistent, CHK_EXIT_CORRUPT if problems were found, or
+ *          CHK_EXIT_FAILED if the volume could not be checked.
+ */
+int ChkStart( const CHKPARAM * pParam )
+{
+    static CHECKER chk;
+    CHECKER * pChk = &chk;
+    const uint16_t uEndianProbe = 1U;
+    uint64_t ullStartMs = ChkMsec();
+    FILE * pReport = stdout;
+    const char * pszResult;
+    int iExit = CHK_EXIT_FAILED;
+    int iFd = -1;
+    void * pMap = MAP_FAILED;
+    struct stat st;
+
+    memset( pChk, 0, sizeof( *pChk ) );
+    pChk->pParam = pParam;
+    ( void ) pthread_mutex_init( &pChk->problemMutex, NULL );
+
+    if( pParam->pszReport != NULL )
+    {
+        pReport = fopen( pParam->pszReport, "w" );
+
+        if( pReport == NULL )
+        {
+            fprintf( stderr, "Error: cannot create \"%s\": %s\n", pParam->pszReport, strerror( errno ) );
+            goto Out;
+        }
+    }
+
+    if( *( const uint8_t * ) &uEndianProbe != 1U )
+    {
+        fprintf( stderr, "Error: the checker only runs on little-endian hosts.\n" );
+        goto Out;
+    }
+
+    pChk->pProblems = calloc( ( pParam->ulMaxProblems == 0U ) ? 1U : pParam->ulMaxProblems, sizeof( CHKPROBLEM ) );
+
+    if( pChk->pProblems == NULL )
+    {
+        fprintf( stderr, "Error: out of memory\n" );
+        goto Out;
+    }
+
+    iFd = open( pParam->pszImage, O_RDONLY );
+
+    if( ( iFd == -1 ) || ( fstat( iFd, &st ) != 0 ) )
+    {
+        fprintf( stderr, "Error: cannot open \"%s\": %s\n", pParam->pszImage, strerror( errno ) );
+        goto Out;
+    }
+
+    if( st.st_size < ( off_t ) REDCONF_BLOCK_SIZE )
+    {
+        fprintf( stderr, "Error: \"%s\" is too small to be a volume image.\n", pParam->pszImage );
+        goto Out;
+    }
+
+    pChk->nImageSize = ( size_t ) st.st_size;
+    pMap = mmap( NULL, pChk->nImageSize, PROT_READ, MAP_SHARED, iFd, 0 );
+
+    if( pMap == MAP_FAILED )
+    {
+        fprintf( stderr, "Error: cannot map \"%s\": %s\n", pParam->pszImage, strerror( errno ) );
+        goto Out;
+    }
+
+    pChk->pbImage = pMap;
+
+    /*  Blocks are mostly visited once, in no particular order.
+     */
+    ( void ) madvise( pMap, pChk->nImageSize, MADV_WILLNEED );
+
+    if( ChkMaster( pChk ) && ChkMetaroot( pChk ) && ChkGeometry( pChk ) && ChkImap( pChk ) )
+    {
+        ChkRunPhase( pChk, "inodes", ChkInode, pChk->ulInodeCount, CHK_INODE_BATCH );
+        ChkSummarize( pChk );
+    }
+    else
+    {
+        pChk->fIncomplete = true;
+    }
+
+    if( pChk->ulProblemCount != 0U )
+    {
+        pszResult = "corrupt";
+        iExit = CHK_EXIT_CORRUPT;
+    }
+    else if( pChk->fIncomplete )
+    {
+        pszResult = "incomplete";
+        iExit = CHK_EXIT_FAILED;
+    }
+    else
+    {
+        pszResult = "clean";
+        iExit = CHK_EXIT_CLEAN;
+    }
+
+    ChkReport( pChk, pReport, pszResult, ChkMsec() - ullStartMs );
+
+  Out:
+
+    if( pMap != MAP_FAILED )
+    {
+        ( void ) munmap( pMap, pChk->nImageSize );
+    }
+
+    if( iFd != -1 )
+    {
+        ( void ) close( iFd );
+    }
+
+    if( ( pReport != NULL ) && ( pReport != stdout ) )
+    {
+        if( fclose( pReport ) != 0 )
+        {
+            fprintf( stderr, "Error: cannot write \"%s\"\n", pParam->pszReport );
+            iExit = CHK_EXIT_FAILED;
+        }
+    }
+
+    free( pChk->pProblems );
+    free( pChk->pbImap );
+    free( pChk->pbFound );
+    free( pChk->pInodes );
+    ( void ) pthread_mutex_destroy( &pChk->problemMutex );
+
+    return iExit;
+}
+
+
+/** @brief Run one phase of the check on the worker threads.
+ *
+ *  The calling thread reports progress until the workers have finished.
+ *
+ *  @param pChk     The checker state.
+ *  @param pszPhase Name of the phase, for progress reports.
+ *  @param pfnWork  Function which checks one item.
+ *  @param ulItems  Number of items to check.
+ *  @param ulBatch  Number of items which a worker claims at a time.
+ */
+static void ChkRunPhase( CHECKER * pChk,
+                         const char * pszPhase,
+                         CHKWORKFN pfnWork,
+                         uint32_t ulItems,
+                         uint32_t ulBatch )
+{
+    uint32_t ulThreads = pChk->pParam->ulThreads;
+    uint32_t ulStarted = 0U;
+    uint32_t ulIdx;
+
+    pChk->pszPhase = pszPhase;
+    pChk->pfnWork = pfnWork;
+    pChk->ulItems = ulItems;
+    pChk->ulBatch = ulBatch;
+    pChk->ulNextItem = 0U;
+    pChk->ulItemsDone = 0U;
+
+    if( ulThreads > ( ( ulItems + ulBatch - 1U ) / ulBatch ) )
+    {
+        ulThreads = ( ulItems + ulBatch - 1U ) / ulBatch;
+    }
+
+    for( ulIdx = 0U; ulIdx < ulThreads; ulIdx++ )
+    {
+        pChk->aWorker[ ulIdx ].pChk = pChk;
+
+        if( pthread_create( &pChk->aWorker[ ulIdx ].thread, NULL, ChkWorkerThread, &pChk->aWorker[ ulIdx ] ) != 0 )
+        {
+            break;
+        }
+
+        ulStarted++;
+    }
+
+    if( ulStarted == 0U )
+    {
+        /*  No threads could be created: do the work here instead.
+         */
+        pChk->aWorker[ 0U ].pChk = pChk;
+        ( void ) ChkWorkerThread( &pChk->aWorker[ 0U ] );
+    }
+    else
+    {
+        uint64_t ullNextReportMs = ChkMsec() + CHK_PROGRESS_MS;
+
+        while( __atomic_load_n( &pChk->ulItemsDone, __ATOMIC_RELAXED ) < ulItems )
+        {
+            struct timespec ts;
+
+            /*  Poll often enough that a short phase does not wait out a whole
+             *  reporting interval.
+             */
+            ts.tv_sec = 0;
+            ts.tv_nsec = ( long ) CHK_POLL_MS * 1000000L;
+            ( void ) nanosleep( &ts, NULL );
+
+            if( pChk->pParam->fProgress && ( ChkMsec() >= ullNextReportMs ) )
+            {
+                ullNextReportMs += CHK_PROGRESS_MS;
+                fprintf( stderr, "progress: %s %u/%u\n", pszPhase,
+                         ( unsigned ) __atomic_load_n( &pChk->ulItemsDone, __ATOMIC_RELAXED ), ( unsigned ) ulItems );
+            }
+        }
+
+        for( ulIdx = 0U; ulIdx < ulStarted; ulIdx++ )
+        {
+            ( void ) pthread_join( pChk->aWorker[ ulIdx ].thread, NULL );
+        }
+    }
+
+    if( pChk->pParam->fProgress )
+    {
+        fprintf( stderr, "progress: %s %u/%u done\n", pszPhase, ( unsigned ) ulItems, ( unsigned ) ulItems );
+    }
+}
+
+
+/** @brief Worker thread: check items of the current phase until there are no
+ *         more.
+ *
+ *  @param pArg The CHKWORKER for the thread.
+ *
+ *  @return NULL.
+ */
+static void * ChkWorkerThread( void * pArg )
+{
+    CHKWORKER * pWorker = pArg;
+    CHECKER * pChk = pWorker->pChk;
+
+    while( true )
+    {
+        uint32_t ulFirst = __atomic_fetch_add( &pChk->ulNextItem, pChk->ulBatch, __ATOMIC_RELAXED );
+        uint32_t ulLast;
+        uint32_t ulItem;
+
+        if( ulFirst >= pChk->ulItems )
+        {
+            break;
+        }
+
+        ulLast = ( ( pChk->ulItems - ulFirst ) > pChk->ulBatch ) ? ( ulFirst + pChk->ulBatch ) : pChk->ulItems;
+
+        for( ulItem = ulFirst; ulItem < ulLast; ulItem++ )
+        {
+            pChk->pfnWork( pWorker, ulItem );
+        }
+
+        ( void ) __atomic_fetch_add( &pChk->ulItemsDone, ulLast - ulFirst, __ATOMIC_RELAXED );
+    }
+
+    #if REDCONF_API_POSIX == 1
+        free( pWorker->ppNames );
+        pWorker->ppNames = NULL;
+        pWorker->ulNameCap = 0U;
+    #endif
+
+    return NULL;
+}
+
+
+/** @brief Check the master block against the configuration of the tool.
+ *
+ *  @param pChk The checker state.
+ *
+ *  @return Whether the master block is valid.
+ */
+static bool ChkMaster( CHECKER * pChk )
+{
+    const MASTERBLOCK * pMB = ( const MASTERBLOCK * ) pChk->pbImage;
+    const char * pszNodeProblem;
+    uint8_t bFlags = 0U;
+    bool fValid = false;
+
+    #if REDCONF_API_POSIX == 1
+        bFlags |= MBFLAG_API_POSIX;
+    #endif
+    #if REDCONF_INODE_TIMESTAMPS == 1
+        bFlags |= MBFLAG_INODE_TIMESTAMPS;
+    #endif
+    #if REDCONF_INODE_BLOCKS == 1
+        bFlags |= MBFLAG_INODE_BLOCKS;
+    #endif
+    #if ( REDCONF_API_POSIX == 1 ) && ( REDCONF_API_POSIX_LINK == 1 )
+        bFlags |= MBFLAG_INODE_NLINK;
+    #endif
+    #if REDCONF_INODE_INLINE_DATA == 1
+        bFlags |= MBFLAG_INODE_INLINE;
+    #endif
+
+    /*  The sequence number is not known yet, so it is not checked.
+     */
+    pChk->ullSeqMax = UINT64_MAX;
+    pszNodeProblem = ChkNodeProblem( pChk, pMB, META_SIG_MASTER );
+
+    if( pszNodeProblem != NULL )
+    {
+        ChkProblem( pChk, "master_invalid", INODE_INVALID, BLOCK_NUM_MASTER, "master block has %s", pszNodeProblem );
+    }
+    else if( ( pMB->ulVersion != RED_DISK_LAYOUT_VERSION ) ||
+             ( pMB->uMaxNameLen != REDCONF_NAME_MAX ) ||
+             ( pMB->uDirectPointers != REDCONF_DIRECT_POINTERS ) ||
+             ( pMB->uIndirectPointers != REDCONF_INDIRECT_POINTERS ) ||
+             ( pMB->bBlockSizeP2 != BLOCK_SIZE_P2 ) ||
+             ( pMB->bFlags != bFlags ) )
+    {
+        ChkProblem( pChk, "master_config", INODE_INVALID, BLOCK_NUM_MASTER,
+                    "volume was formatted with a different configuration than the checker was built with" );
+    }
+    else if( ( pMB->ulBlockCount < 4U ) || ( pMB->ulInodeCount == 0U ) )
+    {
+        ChkProblem( pChk, "master_geometry", INODE_INVALID, BLOCK_NUM_MASTER,
+                    "master block has %u blocks and %u inodes", ( unsigned ) pMB->ulBlockCount, ( unsigned ) pMB->ulInodeCount );
+    }
+    else if( ( ( uint64_t ) pMB->ulBlockCount << BLOCK_SIZE_P2 ) > pChk->nImageSize )
+    {
+        ChkProblem( pChk, "image_truncated", INODE_INVALID, BLOCK_NUM_MASTER,
+                    "volume has %u blocks, but the image holds only %llu", ( unsigned ) pMB->ulBlockCount,
+                    ( unsigned long long ) ( pChk->nImageSize >> BLOCK_SIZE_P2 ) );
+    }
+    else
+    {
+        pChk->ulBlockCount = pMB->ulBlockCount;
+        pChk->ulInodeCount = pMB->ulInodeCount;
+        pChk->ullSeqMax = pMB->hdr.ullSequence;
+        fValid = true;
+    }
+
+    return fValid;
+}
+
+
+/** @brief Find the current metaroot, as mount would.
+ *
+ *  @param pChk The checker state.
+ *
+ *  @return Whether a valid metaroot was found.
+ */
+static bool ChkMetaroot( CHECKER * pChk )
+{
+    bool afValid[ 2U ];
+    METAROOT aMR[ 2U ];
+    uint8_t bMR;
+    bool fValid = false;
+
+    for( bMR = 0U; bMR < 2U; bMR++ )
+    {
+        uint32_t ulSectorCRC;
+
+        memcpy( &aMR[ bMR ], ChkBlock( pChk, BLOCK_NUM_FIRST_METAROOT + bMR ), sizeof( aMR[ bMR ] ) );
+
+        /*  The sector CRC field was zero when the metaroot CRC was computed.
+         *  The sector CRC itself is not checked, since the metaroot CRC covers
+         *  the same bytes and the sector size is unknown here.
+         */
+        ulSectorCRC = aMR[ bMR ].ulSectorCRC;
+        aMR[ bMR ].ulSectorCRC = 0U;
+        afValid[ bMR ] = ( aMR[ bMR ].hdr.ulSignature == META_SIG_METAROOT ) &&
+                         ( RedCrc32Update( 0U, &( ( const uint8_t * ) &aMR[ bMR ] )[ 8U ], REDCONF_BLOCK_SIZE - 8U ) == aMR[ bMR ].hdr.ulCRC );
+        aMR[ bMR ].ulSectorCRC = ulSectorCRC;
+    }
+
+    if( !afValid[ 0U ] && !afValid[ 1U ] )
+    {
+        ChkProblem( pChk, "metaroot_invalid", INODE_INVALID, BLOCK_NUM_FIRST_METAROOT, "neither metaroot is valid" );
+    }
+    else
+    {
+        bMR = ( afValid[ 1U ] && ( !afValid[ 0U ] || ( aMR[ 1U ].hdr.ullSequence > aMR[ 0U ].hdr.ullSequence ) ) ) ? 1U : 0U;
+
+        pChk->bCurMR = bMR;
+        pChk->fOtherMRValid = afValid[ 1U - bMR ];
+        pChk->mr = aMR[ bMR ];
+
+        if( pChk->mr.hdr.ullSequence > pChk->ullSeqMax )
+        {
+            pChk->ullSeqMax = pChk->mr.hdr.ullSequence;
+        }
+
+        fValid = true;
+    }
+
+    return fValid;
+}
+
+
+/** @brief Compute where things are on the volume, as RedCoreInit() does.
+ *
+ *  @param pChk The checker state.
+ *
+ *  @return Whether the geometry is usable.
+ */
+static bool ChkGeometry( CHECKER * pChk )
+{
+    bool fValid = true;
+
+    pChk->fImapInline = ( pChk->ulBlockCount - 3U ) <= METAROOT_ENTRIES;
+
+    if( pChk->fImapInline )
+    {
+        #if REDCONF_IMAP_INLINE == 1
+            pChk->ulInodeTableStartBN = 3U;
+        #else
+            fValid = false;
+        #endif
+    }
+    else
+    {
+        #if REDCONF_IMAP_EXTERNAL == 1
+            pChk->ulImapStartBN = 3U;
+            pChk->ulImapNodeCount = ( ( pChk->ulBlockCount - 3U ) + ( ( IMAPNODE_ENTRIES + 2U ) - 1U ) ) / ( IMAPNODE_ENTRIES + 2U );
+            pChk->ulInodeTableStartBN = pChk->ulImapStartBN + ( pChk->ulImapNodeCount * 2U );
+        #else
+            fValid = false;
+        #endif
+    }
+
+    if( !fValid )
+    {
+        ChkProblem( pChk, "master_config", INODE_INVALID, BLOCK_NUM_MASTER,
+                    "the checker was built without support for the %s imap", pChk->fImapInline ? "inline" : "external" );
+    }
+    else if( ( ( ( uint64_t ) pChk->ulInodeCount * 2U ) + pChk->ulInodeTableStartBN ) > pChk->ulBlockCount )
+    {
+        ChkProblem( pChk, "master_geometry", INODE_INVALID, BLOCK_NUM_MASTER, "the inode table does not fit on the volume" );
+        fValid = false;
+    }
+    else
+    {
+        pChk->ulFirstAllocableBN = pChk->ulInodeTableStartBN + ( pChk->ulInodeCount * 2U );
+
+        if( pChk->mr.ulFreeBlocks > ( pChk->ulBlockCount - pChk->ulFirstAllocableBN ) )
+        {
+            ChkProblem( pChk, "free_block_count", INODE_INVALID, BLOCK_NUM_FIRST_METAROOT + pChk->bCurMR,
+                        "metaroot claims %u free blocks, more than the volume has", ( unsigned ) pChk->mr.ulFreeBlocks );
+        }
+
+        if( ( pChk->mr.ulAllocNextBlock < pChk->ulFirstAllocableBN ) || ( pChk->mr.ulAllocNextBlock >= pChk->ulBlockCount ) )
+        {
+            ChkProblem( pChk, "metaroot_alloc_next", INODE_INVALID, BLOCK_NUM_FIRST_METAROOT + pChk->bCurMR,
+                        "allocation pointer %u is not an allocable block", ( unsigned ) pChk->mr.ulAllocNextBlock );
+        }
+
+        pChk->pbFound = calloc( ( pChk->ulBlockCount + 7U ) / 8U, 1U );
+        pChk->pInodes = calloc( pChk->ulInodeCount, sizeof( CHKINODE ) );
+
+        if( ( pChk->pbFound == NULL ) || ( pChk->pInodes == NULL ) )
+        {
+            fprintf( stderr, "Error: out of memory\n" );
+            fValid = false;
+        }
+    }
+
+    return fValid;
+}
+
+
+/** @brief Load and check the committed imap.
+ *
+ *  @param pChk The checker state.
+ *
+ *  @return Whether the imap is usable.
+ */
+static bool ChkImap( CHECKER * pChk )
+{
+    bool fValid = false;
+
+    #if REDCONF_IMAP_INLINE == 1
+        if( pChk->fImapInline )
+        {
+            pChk->pbImap = malloc( METAROOT_ENTRY_BYTES );
+
+            if( pChk->pbImap != NULL )
+            {
+                memcpy( pChk->pbImap, pChk->mr.abEntries, METAROOT_ENTRY_BYTES );
+                fValid = true;
+            }
+        }
+    #endif
+
+    #if REDCONF_IMAP_EXTERNAL == 1
+        if( !pChk->fImapInline )
+        {
+            /*  Each imap node covers a whole number of bytes of the bitmap, so
+             *  the workers can copy the nodes into it side by side.
+             */
+            pChk->pbImap = malloc( ( size_t ) pChk->ulImapNodeCount * IMAPNODE_ENTRY_BYTES );
+
+            if( pChk->pbImap != NULL )
+            {
+                ChkRunPhase( pChk, "imap", ChkImapNode, pChk->ulImapNodeCount, 1U );
+                fValid = !pChk->fImapBad;
+            }
+        }
+    #endif
+
+    if( pChk->pbImap == NULL )
+    {
+        fprintf( stderr, "Error: out of memory\n" );
+    }
+
+    return fValid;
+}
+
+
+#if REDCONF_IMAP_EXTERNAL == 1
+
+/** @brief Check one imap node and copy it into the imap bitmap.
+ *
+ *  @param pWorker  The worker thread state.
+ *  @param ulItem   The imap node number.
+ */
+    static void ChkImapNode( CHKWORKER * pWorker,
+                             uint32_t ulItem )
+    {
+        CHECKER * pChk = pWorker->pChk;
+        uint32_t ulBlock = pChk->ulImapStartBN + ( ulItem * 2U );
+        const IMAPNODE * pImap;
+        const char * pszNodeProblem;
+
+        if( ( pChk->mr.abEntries[ ulItem >> 3U ] & ( 0x80U >> ( ulItem & 7U ) ) ) != 0U )
+        {
+            ulBlock++;
+        }
+
+        pImap = ( const IMAPNODE * ) ChkBlock( pChk, ulBlock );
+        pszNodeProblem = ChkNodeProblem( pChk, pImap, META_SIG_IMAP );
+
+        if( pszNodeProblem != NULL )
+        {
+            ChkProblem( pChk, "imap_invalid", INODE_INVALID, ulBlock, "imap node %u has %s", ( unsigned ) ulItem, pszNodeProblem );
+            pChk->fImapBad = true;
+        }
+        else
+        {
+            memcpy( &pChk->pbImap[ ( size_t ) ulItem * IMAPNODE_ENTRY_BYTES ], pImap->abEntries, IMAPNODE_ENTRY_BYTES );
+        }
+    }
+#endif /* REDCONF_IMAP_EXTERNAL == 1 */
+
+
+/** @brief Check one inode, along with the blocks and names it uses.
+ *
+ *  @param pWorker  The worker thread state.
+ *  @param ulItem   The inode number less INODE_FIRST_VALID.
+ */
+static void ChkInode( CHKWORKER * pWorker,
+                      uint32_t ulItem )
+{
+    CHECKER * pChk = pWorker->pChk;
+    CHKINODE * pInfo = &pChk->pInodes[ ulItem ];
+    uint32_t ulInode = INODE_FIRST_VALID + ulItem;
+    uint32_t ulBlock = pChk->ulInodeTableStartBN + ( ulItem * 2U );
+    bool fSlot0 = ChkImapBit( pChk, ulBlock );
+    bool fSlot1 = ChkImapBit( pChk, ulBlock + 1U );
+
+    if( !fSlot0 && !fSlot1 )
+    {
+        pInfo->bType = CHKINO_FREE;
+    }
+    else if( fSlot0 && fSlot1 )
+    {
+        ChkProblem( pChk, "inode_both_copies", ulInode, ulBlock, "both copies of the inode are allocated" );
+        pInfo->bType = CHKINO_BAD;
+    }
+    else
+    {
+        const INODE * pInode;
+        const char * pszNodeProblem;
+
+        if( fSlot1 )
+        {
+            ulBlock++;
+        }
+
+        pInode = ( const INODE * ) ChkBlock( pChk, ulBlock );
+        pszNodeProblem = ChkNodeProblem( pChk, pInode, META_SIG_INODE );
+
+        if( pszNodeProblem != NULL )
+        {
+            ChkProblem( pChk, "inode_invalid", ulInode, ulBlock, "inode has %s", pszNodeProblem );
+            pInfo->bType = CHKINO_BAD;
+        }
+        else if( RED_S_ISDIR( pInode->uMode ) == RED_S_ISREG( pInode->uMode ) )
+        {
+            ChkProblem( pChk, "inode_mode", ulInode, ulBlock, "inode has mode 0x%04x", ( unsigned ) pInode->uMode );
+            pInfo->bType = CHKINO_BAD;
+        }
+
+        #if REDCONF_API_POSIX == 0
+            else if( RED_S_ISDIR( pInode->uMode ) )
+            {
+                ChkProblem( pChk, "inode_mode", ulInode, ulBlock, "directory on a volume without directories" );
+                pInfo->bType = CHKINO_BAD;
+            }
+        #endif
+        else
+        {
+            bool fDir = RED_S_ISDIR( pInode->uMode );
+            uint32_t ulDataBlocks;
+
+            pInfo->bType = fDir ? CHKINO_DIR : CHKINO_FILE;
+
+            #if ( REDCONF_API_POSIX == 1 ) && ( REDCONF_API_POSIX_LINK == 1 )
+                pInfo->ulNLink = pInode->uNLink;
+            #else
+                pInfo->ulNLink = 1U;
+            #endif
+
+            #if REDCONF_API_POSIX == 1
+                pInfo->ulPInode = pInode->ulPInode;
+            #endif
+
+            #if REDCONF_INODE_INLINE_DATA == 1
+                if( INODE_IS_INLINE( pInode ) )
+                {
+                    ChkInodeInline( pChk, ulInode, pInode, fDir );
+                    ulDataBlocks = 0U;
+                }
+                else
+            #endif
+            {
+                ulDataBlocks = ChkInodeData( pWorker, ulInode, pInode, fDir );
+            }
+
+            #if REDCONF_INODE_BLOCKS == 1
+                if( pInode->ulBlocks != ulDataBlocks )
+                {
+                    ChkProblem( pChk, "inode_block_count", ulInode, ulBlock, "inode claims %u data blocks, but uses %u",
+                                ( unsigned ) pInode->ulBlocks, ( unsigned ) ulDataBlocks );
+                }
+            #endif
+
+            ( void ) __atomic_fetch_add( fDir ? &pChk->ulDirs : &pChk->ulFiles, 1U, __ATOMIC_RELAXED );
+            ( void ) __atomic_fetch_add( &pChk->ullDataBlocks, ulDataBlocks, __ATOMIC_RELAXED );
+        }
+    }
+}
+
+
+#if REDCONF_INODE_INLINE_DATA == 1
+
+/** @brief Check an inode whose file data is stored inline.
+ *
+ *  @param pChk     The checker state.
+ *  @param ulInode  The inode number.
+ *  @param pInode   The inode.
+ *  @param fDir     Whether the inode is a directory.
+ */
+    static void ChkInodeInline( CHECKER * pChk,
+                                uint32_t ulInode,
+                                const INODE * pInode,
+                                bool fDir )
+    {
+        const uint8_t * pbData = ( const uint8_t * ) pInode->aulEntries;
+
+        if( fDir )
+        {
+            ChkProblem( pChk, "inode_inline", ulInode, 0U, "directory has inline data" );
+        }
+        else if( pInode->ullSize > INODE_INLINE_MAX )
+        {
+            ChkProblem( pChk, "inode_size", ulInode, 0U, "inline file size %llu is larger than the maximum",
+                        ( unsigned long long ) pInode->ullSize );
+        }
+        else
+        {
+            uint32_t ulIdx = ( uint32_t ) pInode->ullSize;
+
+            while( ( ulIdx < INODE_INLINE_MAX ) && ( pbData[ ulIdx ] == 0U ) )
+            {
+                ulIdx++;
+            }
+
+            if( ulIdx < INODE_INLINE_MAX )
+            {
+                ChkProblem( pChk, "inode_inline", ulInode, 0U, "inline data beyond the end of file is not zeroed" );
+            }
+        }
+    }
+#endif /* REDCONF_INODE_INLINE_DATA == 1 */
+
+
+/** @brief Check the block pointers of an inode, and what they point at.
+ *
+ *  @param pWorker  The worker thread state.
+ *  @param ulInode  The inode number.
+ *  @param pInode   The inode.
+ *  @param fDir     Whether the inode is a directory.
+ *
+ *  @return The number of data blocks used by the inode.
+ */
+static uint32_t ChkInodeData( CHKWORKER * pWorker,
+                              uint32_t ulInode,
+                              const INODE * pInode,
+                              bool fDir )
+{
+    CHECKER * pChk = pWorker->pChk;
+    uint64_t ullSize = pInode->ullSize;
+    uint32_t ulCount = 0U;
+    uint32_t ulIdx;
+
+    if( ullSize > INODE_SIZE_MAX )
+    {
+        ChkProblem( pChk, "inode_size", ulInode, 0U, "inode size %llu is larger than the maximum", ( unsigned long long ) ullSize );
+        ullSize = INODE_SIZE_MAX;
+    }
+
+    #if REDCONF_API_POSIX == 1
+        if( fDir )
+        {
+            if( ( ( uint32_t ) ( ullSize & ( REDCONF_BLOCK_SIZE - 1U ) ) % DIRENT_SIZE ) != 0U )
+            {
+                ChkProblem( pChk, "dir_size", ulInode, 0U, "directory size %llu is not a whole number of entries",
+                            ( unsigned long long ) ullSize );
+            }
+
+            pWorker->ulNameCount = 0U;
+        }
+    #endif
+
+    for( ulIdx = 0U; ulIdx < REDCONF_DIRECT_POINTERS; ulIdx++ )
+    {
+        ChkDataBlock( pWorker, ulInode, pInode->aulEntries[ ulIdx ], ulIdx, ullSize, fDir, &ulCount );
+    }
+
+    #if REDCONF_INDIRECT_POINTERS > 0U
+        for( ulIdx = 0U; ulIdx < REDCONF_INDIRECT_POINTERS; ulIdx++ )
+        {
+            ChkIndir( pWorker, ulInode, pInode->aulEntries[ REDCONF_DIRECT_POINTERS + ulIdx ],
+                      REDCONF_DIRECT_POINTERS + ( ( uint64_t ) ulIdx * INDIR_ENTRIES ), ullSize, fDir, &ulCount );
+        }
+    #endif
+
+    #if DINDIR_POINTERS > 0U
+        for( ulIdx = 0U; ulIdx < DINDIR_POINTERS; ulIdx++ )
+        {
+            ChkDindir( pWorker, ulInode, pInode->aulEntries[ REDCONF_DIRECT_POINTERS + REDCONF_INDIRECT_POINTERS + ulIdx ],
+                       REDCONF_DIRECT_POINTERS + ( uint64_t ) INODE_INDIR_BLOCKS + ( ( uint64_t ) ulIdx * DINDIR_DATA_BLOCKS ),
+                       ullSize, fDir, &ulCount );
+        }
+    #endif
+
+    #if REDCONF_API_POSIX == 1
+        if( fDir )
+        {
+            ChkDirNames( pWorker, ulInode );
+        }
+    #endif
+
+    return ulCount;
+}
+
+
+#if DINDIR_POINTERS > 0U
+
+/** @brief Check a double indirect node and the indirect nodes it points at.
+ *
+ *  @param pWorker  The worker thread state.
+ *  @param ulInode  The inode which owns the node.
+ *  @param ulBlock  The block number of the node; zero if sparse.
+ *  @param ullFirst The first file block covered by the node.
+ *  @param ullSize  The size of the inode, in bytes.
+ *  @param fDir     Whether the inode is a directory.
+ *  @param pulCount Incremented for each data block used.
+ */
+    static void ChkDindir( CHKWORKER * pWorker,
+                           uint32_t ulInode,
+                           uint32_t ulBlock,
+                           uint64_t ullFirst,
+                           uint64_t ullSize,
+                           bool fDir,
+                           uint32_t * pulCount )
+    {
+        CHECKER * pChk = pWorker->pChk;
+
+        if( ulBlock != BLOCK_SPARSE )
+        {
+            if( ( ullFirst << BLOCK_SIZE_P2 ) >= ullSize )
+            {
+                ChkProblem( pChk, "pointer_beyond_eof", ulInode, ulBlock, "double indirect node is beyond the end of the inode" );
+            }
+
+            if( ChkClaimBlock( pChk, ulInode, ulBlock ) )
+            {
+                const DINDIR * pDindir = ( const DINDIR * ) ChkBlock( pChk, ulBlock );
+                const char * pszNodeProblem = ChkNodeProblem( pChk, pDindir, META_SIG_DINDIR );
+
+                if( pszNodeProblem != NULL )
+                {
+                    ChkProblem( pChk, "dindir_invalid", ulInode, ulBlock, "double indirect node has %s", pszNodeProblem );
+                }
+                else
+                {
+                    uint32_t ulIdx;
+
+                    if( pDindir->ulInode != ulInode )
+                    {
+                        ChkProblem( pChk, "dindir_owner", ulInode, ulBlock, "double indirect node belongs to inode %u",
+                                    ( unsigned ) pDindir->ulInode );
+                    }
+
+                    for( ulIdx = 0U; ulIdx < INDIR_ENTRIES; ulIdx++ )
+                    {
+                        ChkIndir( pWorker, ulInode, pDindir->aulEntries[ ulIdx ], ullFirst + ( ( uint64_t ) ulIdx * INDIR_ENTRIES ),
+                                  ullSize, fDir, pulCount );
+                    }
+                }
+            }
+        }
+    }
+#endif /* DINDIR_POINTERS > 0U */
+
+
+#if REDCONF_DIRECT_POINTERS < INODE_ENTRIES
+
+/** @brief Check an indirect node and the data blocks it points at.
+ *
+ *  @param pWorker  The worker thread state.
+ *  @param ulInode  The inode which owns the node.
+ *  @param ulBlock  The block number of the node; zero if sparse.
+ *  @param ullFirst The first file block covered by the node.
+ *  @param ullSize  The size of the inode, in bytes.
+ *  @param fDir     Whether the inode is a directory.
+ *  @param pulCount Incremented for each data block used.
+ */
+    static void ChkIndir( CHKWORKER * pWorker,
+                          uint32_t ulInode,
+                          uint32_t ulBlock,
+                          uint64_t ullFirst,
+                          uint64_t ullSize,
+                          bool fDir,
+                          uint32_t * pulCount )
+    {
+        CHECKER * pChk = pWorker->pChk;
+        uint32_t ulIdx;
+
+        if( ulBlock == BLOCK_SPARSE )
+        {
+            #if REDCONF_API_POSIX == 1
+
+                /*  Directories are never sparse.
+                 */
+                if( fDir && ( ( ullFirst << BLOCK_SIZE_P2 ) < ullSize ) )
+                {
+                    ChkProblem( pChk, "dir_sparse", ulInode, 0U, "directory block %llu is sparse", ( unsigned long long ) ullFirst );
+                }
+            #endif
+        }
+        else
+        {
+            if( ( ullFirst << BLOCK_SIZE_P2 ) >= ullSize )
+            {
+                ChkProblem( pChk, "pointer_beyond_eof", ulInode, ulBlock, "indirect node is beyond the end of the inode" );
+            }
+
+            if( ChkClaimBlock( pChk, ulInode, ulBlock ) )
+            {
+                const INDIR * pIndir = ( const INDIR * ) ChkBlock( pChk, ulBlock );
+                const char * pszNodeProblem = ChkNodeProblem( pChk, pIndir, META_SIG_INDIR );
+
+                if( pszNodeProblem != NULL )
+                {
+                    ChkProblem( pChk, "indir_invalid", ulInode, ulBlock, "indirect node has %s", pszNodeProblem );
+                }
+                else
+                {
+                    if( pIndir->ulInode != ulInode )
+                    {
+                        ChkProblem( pChk, "indir_owner", ulInode, ulBlock, "indirect node belongs to inode %u", ( unsigned ) pIndir->ulInode );
+                    }
+
+                    for( ulIdx = 0U; ulIdx < INDIR_ENTRIES; ulIdx++ )
+                    {
+                        ChkDataBlock( pWorker, ulInode, pIndir->aulEntries[ ulIdx ], ullFirst + ulIdx, ullSize, fDir, pulCount );
+                    }
+                }
+            }
+        }
+    }
+#endif /* REDCONF_DIRECT_POINTERS < INODE_ENTRIES */
+
+
+/** @brief Check a data block pointer.
+ *
+ *  @param pWorker      The worker thread state.
+ *  @param ulInode      The inode which owns the block.
+ *  @param ulBlock      The data block number; zero if sparse.
+ *  @param ullFileBlock The file block which the pointer is for.
+ *  @param ullSize      The size of the inode, in bytes.
+ *  @param fDir         Whether the inode is a directory.
+ *  @param pulCount     Incremented if the block is used.
+ */
+static void ChkDataBlock( CHKWORKER * pWorker,
+                          uint32_t ulInode,
+                          uint32_t ulBlock,
+                          uint64_t ullFileBlock,
+                          uint64_t ullSize,
+                          bool fDir,
+                          uint32_t * pulCount )
+{
+    CHECKER * pChk = pWorker->pChk;
+    bool fInFile = ( ullFileBlock << BLOCK_SIZE_P2 ) < ullSize;
+
+    if( ulBlock == BLOCK_SPARSE )
+    {
+        #if REDCONF_API_POSIX == 1
+            if( fDir && fInFile )
+            {
+                ChkProblem( pChk, "dir_sparse", ulInode, 0U, "directory block %llu is sparse", ( unsigned long long ) ullFileBlock );
+            }
+        #endif
+    }
+    else
+    {
+        if( !fInFile )
+        {
+            ChkProblem( pChk, "pointer_beyond_eof", ulInode, ulBlock, "data block %llu is beyond the end of the inode",
+                        ( unsigned long long ) ullFileBlock );
+        }
+
+        if( ChkClaimBlock( pChk, ulInode, ulBlock ) )
+        {
+            ( *pulCount )++;
+
+            #if REDCONF_API_POSIX == 1
+                if( fDir && fInFile )
+                {
+                    ChkDirBlock( pWorker, ulInode, ChkBlock( pChk, ulBlock ), ullFileBlock, ullSize );
+                }
+            #endif
+        }
+    }
+
+    ( void ) fDir;
+}
+
+
+/** @brief Record that an inode uses a block.
+ *
+ *  @param pChk     The checker state.
+ *  @param ulInode  The inode which uses the block.
+ *  @param ulBlock  The block number.
+ *
+ *  @return Whether the block number is in range, so that the block can be
+ *          examined.
+ */
+static bool ChkClaimBlock( CHECKER * pChk,
+                           uint32_t ulInode,
+                           uint32_t ulBlock )
+{
+    bool fInRange = ( ulBlock >= pChk->ulFirstAllocableBN ) && ( ulBlock < pChk->ulBlockCount );
+
+    if( !fInRange )
+    {
+        ChkProblem( pChk, "block_out_of_range", ulInode, ulBlock, "block %u is not an allocable block", ( unsigned ) ulBlock );
+    }
+    else
+    {
+        uint8_t bMask = ( uint8_t ) ( 0x80U >> ( ulBlock & 7U ) );
+
+        if( !ChkImapBit( pChk, ulBlock ) )
+        {
+            ChkProblem( pChk, "block_not_allocated", ulInode, ulBlock, "block %u is in use but free in the imap", ( unsigned ) ulBlock );
+        }
+
+        if( ( __atomic_fetch_or( &pChk->pbFound[ ulBlock >> 3U ], bMask, __ATOMIC_RELAXED ) & bMask ) != 0U )
+        {
+            ChkProblem( pChk, "block_cross_linked", ulInode, ulBlock, "block %u is used more than once", ( unsigned ) ulBlock );
+        }
+    }
+
+    return fInRange;
+}
+
+
+#if REDCONF_API_POSIX == 1
+
+/** @brief Check the directory entries in one block of a directory.
+ *
+ *  @param pWorker      The worker thread state.
+ *  @param ulPInode     The directory inode number.
+ *  @param pbBlock      The directory data block.
+ *  @param ullFileBlock Which block of the directory it is.
+ *  @param ullSize      The size of the directory, in bytes.
+ */
+    static void ChkDirBlock( CHKWORKER * pWorker,
+                             uint32_t ulPInode,
+                             const uint8_t * pbBlock,
+                             uint64_t ullFileBlock,
+                             uint64_t ullSize )
+    {
+        CHECKER * pChk = pWorker->pChk;
+        uint64_t ullLeft = ullSize - ( ullFileBlock << BLOCK_SIZE_P2 );
+        uint32_t ulEntries = ( ullLeft >= REDCONF_BLOCK_SIZE ) ? DIRENTS_PER_BLOCK : ( ( uint32_t ) ullLeft / DIRENT_SIZE );
+        uint32_t ulIdx;
+
+        for( ulIdx = 0U; ulIdx < ulEntries; ulIdx++ )
+        {
+            const DIRENT * pDirent = ( const DIRENT * ) &pbBlock[ ulIdx * DIRENT_SIZE ];
+            uint32_t ulNameLen = ( uint32_t ) strnlen( pDirent->acName, REDCONF_NAME_MAX );
+            uint32_t ulByte;
+            bool fPadded = true;
+
+            for( ulByte = ulNameLen; ulByte < REDCONF_NAME_MAX; ulByte++ )
+            {
+                if( pDirent->acName[ ulByte ] != '\0' )
+                {
+                    fPadded = false;
+                }
+            }
+
+            if( pDirent->ulInode == INODE_INVALID )
+            {
+                if( ( ulNameLen != 0U ) || !fPadded )
+                {
+                    ChkProblem( pChk, "dirent_unused_name", ulPInode, 0U, "unused entry %llu has a name",
+                                ( unsigned long long ) ( ( ullFileBlock * DIRENTS_PER_BLOCK ) + ulIdx ) );
+                }
+            }
+            else if( ( pDirent->ulInode < INODE_FIRST_VALID ) || ( ( pDirent->ulInode - INODE_FIRST_VALID ) >= pChk->ulInodeCount ) )
+            {
+                ChkProblem( pChk, "dirent_bad_inode", ulPInode, 0U, "entry \"%.*s\" names inode %u, which does not exist",
+                            ( int ) ulNameLen, pDirent->acName, ( unsigned ) pDirent->ulInode );
+            }
+            else
+            {
+                CHKINODE * pInfo = &pChk->pInodes[ pDirent->ulInode - INODE_FIRST_VALID ];
+                uint32_t ulNone = INODE_INVALID;
+
+                if( ( ulNameLen == 0U ) || !fPadded || ( memchr( pDirent->acName, REDCONF_PATH_SEPARATOR, ulNameLen ) != NULL ) )
+                {
+                    ChkProblem( pChk, "dirent_bad_name", ulPInode, 0U, "entry for inode %u has an invalid name",
+                                ( unsigned ) pDirent->ulInode );
+                }
+
+                ( void ) __atomic_fetch_add( &pInfo->ulNames, 1U, __ATOMIC_RELAXED );
+                ( void ) __atomic_compare_exchange_n( &pInfo->ulNamedBy, &ulNone, ulPInode, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED );
+
+                if( pWorker->ulNameCount == pWorker->ulNameCap )
+                {
+                    uint32_t ulCap = ( pWorker->ulNameCap == 0U ) ? 256U : ( pWorker->ulNameCap * 2U );
+                    const DIRENT ** ppNames = realloc( pWorker->ppNames, ulCap * sizeof( *ppNames ) );
+
+                    if( ppNames == NULL )
+                    {
+                        /*  Without room, duplicate names are not looked for.
+                         */
+                        pChk->fIncomplete = true;
+                    }
+                    else
+                    {
+                        pWorker->ppNames = ppNames;
+                        pWorker->ulNameCap = ulCap;
+                    }
+                }
+
+                if( pWorker->ulNameCount < pWorker->ulNameCap )
+                {
+                    pWorker->ppNames[ pWorker->ulNameCount ] = pDirent;
+                    pWorker->ulNameCount++;
+                }
+            }
+        }
+    }
+
+
+/** @brief Look for duplicate names in the directory just checked.
+ *
+ *  @param pWorker  The worker thread state, holding the directory entries.
+ *  @param ulPInode The directory inode number.
+ */
+    static void ChkDirNames( CHKWORKER * pWorker,
+                             uint32_t ulPInode )
+    {
+        uint32_t ulIdx;
+
+        if( pWorker->ulNameCount > 1U )
+        {
+            qsort( pWorker->ppNames, pWorker->ulNameCount, sizeof( pWorker->ppNames[ 0U ] ), ChkDirentCompare );
+
+            for( ulIdx = 1U; ulIdx < pWorker->ulNameCount; ulIdx++ )
+            {
+                if( ChkDirentCompare( &pWorker->ppNames[ ulIdx - 1U ], &pWorker->ppNames[ ulIdx ] ) == 0 )
+                {
+                    ChkProblem( pWorker->pChk, "dirent_duplicate", ulPInode, 0U, "name \"%.*s\" appears more than once",
+                                ( int ) strnlen( pWorker->ppNames[ ulIdx ]->acName, REDCONF_NAME_MAX ), pWorker->ppNames[ ulIdx ]->acName );
+                }
+            }
+        }
+
+        pWorker->ulNameCount = 0U;
+    }
+
+
+/** @brief qsort() comparison function for directory entry pointers, by name.
+ */
+    static int ChkDirentCompare( const void * pA,
+                                 const void * pB )
+    {
+        const DIRENT * pDirentA = *( const DIRENT * const * ) pA;
+        const DIRENT * pDirentB = *( const DIRENT * const * ) pB;
+
+        return strncmp( pDirentA->acName, pDirentB->acName, REDCONF_NAME_MAX );
+    }
+
+
+/** @brief Determine whether a directory can be reached from the root.
+ *
+ *  Follows the chain of directories which name the directory until it reaches
+ *  the root, a directory already known to be reachable or not, or a loop.  The
+ *  result is recorded for every directory on the chain.
+ *
+ *  @param pChk     The checker state.
+ *  @param ulInode  The directory inode number.
+ *
+ *  @return CHKREACH_YES or CHKREACH_NO.
+ */
+    static uint8_t ChkReach( CHECKER * pChk,
+                             uint32_t ulInode )
+    {
+        uint32_t ulCur = ulInode;
+        uint8_t bResult;
+
+        while( true )
+        {
+            CHKINODE * pInfo = &pChk->pInodes[ ulCur - INODE_FIRST_VALID ];
+
+            if( ulCur == INODE_ROOTDIR )
+            {
+                bResult = CHKREACH_YES;
+                break;
+            }
+
+            if( ( pInfo->bReach == CHKREACH_YES ) || ( pInfo->bReach == CHKREACH_NO ) )
+            {
+                bResult = pInfo->bReach;
+                break;
+            }
+
+            if( ( pInfo->bReach == CHKREACH_VISITING ) || ( pInfo->ulNamedBy == INODE_INVALID ) ||
+                ( pChk->pInodes[ pInfo->ulNamedBy - INODE_FIRST_VALID ].bType != CHKINO_DIR ) )
+            {
+                bResult = CHKREACH_NO;
+                break;
+            }
+
+            pInfo->bReach = CHKREACH_VISITING;
+            ulCur = pInfo->ulNamedBy;
+        }
+
+        /*  Record the result along the chain.
+         */
+        ulCur = ulInode;
+
+        while( ( ulCur != INODE_ROOTDIR ) && ( pChk->pInodes[ ulCur - INODE_FIRST_VALID ].bReach == CHKREACH_VISITING ) )
+        {
+            pChk->pInodes[ ulCur - INODE_FIRST_VALID ].bReach = bResult;
+            ulCur = pChk->pInodes[ ulCur - INODE_FIRST_VALID ].ulNamedBy;
+        }
+
+        if( ulInode != INODE_ROOTDIR )
+        {
+            pChk->pInodes[ ulInode - INODE_FIRST_VALID ].bReach = bResult;
+        }
+
+        return bResult;
+    }
+#endif /* REDCONF_API_POSIX == 1 */
+
+
+/** @brief Compare what the workers found with the imap, the metaroot, and the
+ *         names of each inode.
+ *
+ *  @param pChk The checker state.
+ */
+static void ChkSummarize( CHECKER * pChk )
+{
+    uint32_t ulIdx;
+    uint32_t ulBlock;
+
+    for( ulIdx = 0U; ulIdx < pChk->ulInodeCount; ulIdx++ )
+    {
+        CHKINODE * pInfo = &pChk->pInodes[ ulIdx ];
+        uint32_t ulInode = INODE_FIRST_VALID + ulIdx;
+
+        if( pInfo->bType == CHKINO_FREE )
+        {
+            pChk->ulFreeInodes++;
+
+            if( pInfo->ulNames != 0U )
+            {
+                ChkProblem( pChk, "dirent_free_inode", ulInode, 0U, "free inode is named by directory %u", ( unsigned ) pInfo->ulNamedBy );
+            }
+        }
+        else if( pInfo->bType == CHKINO_BAD )
+        {
+            pChk->ulBadInodes++;
+        }
+
+        #if REDCONF_API_POSIX == 1
+            else if( ulInode == INODE_ROOTDIR )
+            {
+                if( pInfo->bType != CHKINO_DIR )
+                {
+                    ChkProblem( pChk, "root_not_dir", ulInode, 0U, "root directory is not a directory" );
+                }
+
+                if( pInfo->ulNames != 0U )
+                {
+                    ChkProblem( pChk, "root_named", ulInode, 0U, "root directory is named by directory %u", ( unsigned ) pInfo->ulNamedBy );
+                }
+
+                if( pInfo->ulPInode != INODE_INVALID )
+                {
+                    ChkProblem( pChk, "dir_parent", ulInode, 0U, "root directory has parent %u", ( unsigned ) pInfo->ulPInode );
+                }
+            }
+            else if( pInfo->ulNames == 0U )
+            {
+                ChkProblem( pChk, "inode_orphan", ulInode, 0U, "%s is not named by any directory",
+                            ( pInfo->bType == CHKINO_DIR ) ? "directory" : "file" );
+            }
+            else if( pInfo->bType == CHKINO_DIR )
+            {
+                if( ( pInfo->ulNames != 1U ) || ( pInfo->ulNLink != 1U ) )
+                {
+                    ChkProblem( pChk, "dir_links", ulInode, 0U, "directory has link count %u and %u names",
+                                ( unsigned ) pInfo->ulNLink, ( unsigned ) pInfo->ulNames );
+                }
+                else if( pInfo->ulPInode != pInfo->ulNamedBy )
+                {
+                    ChkProblem( pChk, "dir_parent", ulInode, 0U, "directory has parent %u, but is named by directory %u",
+                                ( unsigned ) pInfo->ulPInode, ( unsigned ) pInfo->ulNamedBy );
+                }
+                else if( ChkReach( pChk, ulInode ) != CHKREACH_YES )
+                {
+                    ChkProblem( pChk, "dir_unreachable", ulInode, 0U, "directory cannot be reached from the root" );
+                }
+                else
+                {
+                    /*  Directory is consistent.
+                     */
+                }
+            }
+            else
+            {
+                if( pInfo->ulNLink != pInfo->ulNames )
+                {
+                    ChkProblem( pChk, "file_links", ulInode, 0U, "file has link count %u, but %u names",
+                                ( unsigned ) pInfo->ulNLink, ( unsigned ) pInfo->ulNames );
+                }
+
+                if( ( pChk->pInodes[ pInfo->ulNamedBy - INODE_FIRST_VALID ].bType != CHKINO_DIR ) ||
+                    ( ChkReach( pChk, pInfo->ulNamedBy ) != CHKREACH_YES ) )
+                {
+                    ChkProblem( pChk, "file_unreachable", ulInode, 0U, "file is named by directory %u, which cannot be reached from the root",
+                                ( unsigned ) pInfo->ulNamedBy );
+                }
+            }
+        #else /* REDCONF_API_POSIX == 1 */
+            else
+            {
+                /*  With the FSE API, every inode is an unnamed file.
+                 */
+            }
+        #endif /* REDCONF_API_POSIX == 1 */
+    }
+
+    /*  Blocks used by invalid inodes were never found, so they would all look
+     *  leaked.
+     */
+    if( pChk->ulBadInodes != 0U )
+    {
+        pChk->fIncomplete = true;
+    }
+
+    for( ulBlock = pChk->ulFirstAllocableBN; ulBlock < pChk->ulBlockCount; ulBlock++ )
+    {
+        if( !ChkImapBit( pChk, ulBlock ) )
+        {
+            pChk->ulFreeBlocks++;
+        }
+        else if( ( pChk->ulBadInodes == 0U ) && ( ( pChk->pbFound[ ulBlock >> 3U ] & ( 0x80U >> ( ulBlock & 7U ) ) ) == 0U ) )
+        {
+            ChkProblem( pChk, "block_leaked", INODE_INVALID, ulBlock, "block %u is allocated but not used", ( unsigned ) ulBlock );
+        }
+        else
+        {
+            /*  Block is in use.
+             */
+        }
+    }
+
+    if( pChk->ulFreeBlocks != pChk->mr.ulFreeBlocks )
+    {
+        ChkProblem( pChk, "free_block_count", INODE_INVALID, BLOCK_NUM_FIRST_METAROOT + pChk->bCurMR,
+                    "metaroot claims %u free blocks, but the imap has %u", ( unsigned ) pChk->mr.ulFreeBlocks, ( unsigned ) pChk->ulFreeBlocks );
+    }
+
+    #if REDCONF_API_POSIX == 1
+        if( pChk->ulFreeInodes != pChk->mr.ulFreeInodes )
+        {
+            ChkProblem( pChk, "free_inode_count", INODE_INVALID, BLOCK_NUM_FIRST_METAROOT + pChk->bCurMR,
+                        "metaroot claims %u free inodes, but the imap has %u", ( unsigned ) pChk->mr.ulFreeInodes, ( unsigned ) pChk->ulFreeInodes );
+        }
+    #endif
+}
+
+
+/** @brief Determine what, if anything, is wrong with a metadata node.
+ *
+ *  @param pChk         The checker state.
+ *  @param pNode        The node.
+ *  @param ulSignature  The signature which the node should have.
+ *
+ *  @return A description of the problem, or NULL if the node is valid.
+ */
+static const char * ChkNodeProblem( const CHECKER * pChk,
+                                    const void * pNode,
+                                    uint32_t ulSignature )
+{
+    const NODEHEADER * pHdr = pNode;
+    const char * pszProblem = NULL;
+
+    if( pHdr->ulSignature != ulSignature )
+    {
+        pszProblem = "the wrong signature";
+    }
+    else if( pHdr->ulCRC != RedCrcNode( pNode ) )
+    {
+        pszProblem = "a bad CRC";
+    }
+    else if( pHdr->ullSequence > pChk->ullSeqMax )
+    {
+        /*  Same as the driver: the node was written after the last transaction
+         *  point, or by an earlier format.
+         */
+        pszProblem = "a sequence number newer than the metaroot";
+    }
+    else
+    {
+        /*  Node is valid.
+         */
+    }
+
+    return pszProblem;
+}
+
+
+/** @brief Get a pointer to a block of the image.
+ *
+ *  @param pChk     The checker state.
+ *  @param ulBlock  The block number, which must be less than the block count.
+ *
+ *  @return Pointer to the block.
+ */
+static const uint8_t * ChkBlock( const CHECKER * pChk,
+                                 uint32_t ulBlock )
+{
+    return &pChk->pbImage[ ( size_t ) ulBlock << BLOCK_SIZE_P2 ];
+}
+
+
+/** @brief Get whether a block is allocated in the committed imap.
+ *
+ *  @param pChk     The checker state.
+ *  @param ulBlock  The block number, which must be in the inode table or
+ *                  allocable.
+ *
+ *  @return Whether the block is allocated.
+ */
+static bool ChkImapBit( const CHECKER * pChk,
+                        uint32_t ulBlock )
+{
+    uint32_t ulBit = ulBlock - pChk->ulInodeTableStartBN;
+
+    return ( pChk->pbImap[ ulBit >> 3U ] & ( 0x80U >> ( ulBit & 7U ) ) ) != 0U;
+}
+
+
+/** @brief Record a problem with the volume.
+ *
+ *  May be called from any thread.  Every problem is counted, but only the
+ *  first few are kept for the report.
+ *
+ *  @param pChk         The checker state.
+ *  @param pszKind      Short machine-readable name of the problem.
+ *  @param ulInode      Inode concerned; INODE_INVALID if none.
+ *  @param ulBlock      Block concerned; zero if none.
+ *  @param pszFormat    printf()-style format for the description.
+ */
+static void ChkProblem( CHECKER * pChk,
+                        const char * pszKind,
+                        uint32_t ulInode,
+                        uint32_t ulBlock,
+                        const char * pszFormat,
+                        ... )
+{
+    ( void ) pthread_mutex_lock( &pChk->problemMutex );
+
+    if( pChk->ulProblemCount < pChk->pParam->ulMaxProblems )
+    {
+        CHKPROBLEM * pProblem = &pChk->pProblems[ pChk->ulProblemCount ];
+        va_list args;
+
+        pProblem->pszKind = pszKind;
+        pProblem->ulInode = ulInode;
+        pProblem->ulBlock = ulBlock;
+
+        va_start( args, pszFormat );
+        ( void ) vsnprintf( pProblem->szDetail, sizeof( pProblem->szDetail ), pszFormat, args );
+        va_end( args );
+    }
+
+    pChk->ulProblemCount++;
+
+    ( void ) pthread_mutex_unlock( &pChk->problemMutex );
+}
+
+
+/** @brief Write the report.
+ *
+ *  @param pChk             The checker state.
+ *  @param pFile            Where to write the report.
+ *  @param pszResult        The overall result.
+ *  @param ullElapsedMs     How long the check took, in milliseconds.
+ */
+static void ChkReport( const CHECKER * pChk,
+                       FILE * pFile,
+                       const char * pszResult,
+                       uint64_t ullElapsedMs )
+{
+    uint32_t ulShown = ( pChk->ulProblemCount < pChk->pParam->ulMaxProblems ) ? pChk->ulProblemCount : pChk->pParam->ulMaxProblems;
+    uint32_t ulIdx;
+
+    fprintf( pFile, "{\n  \"image\": " );
+    ChkJsonString( pFile, pChk->pParam->pszImage );
+    fprintf( pFile, ",\n  \"result\": \"%s\",\n", pszResult );
+    fprintf( pFile, "  \"complete\": %s,\n", pChk->fIncomplete ? "false" : "true" );
+    fprintf( pFile, "  \"threads\": %u,\n", ( unsigned ) pChk->pParam->ulThreads );
+    fprintf( pFile, "  \"elapsed_ms\": %llu,\n", ( unsigned long long ) ullElapsedMs );
+    fprintf( pFile, "  \"metaroot\": %u,\n", ( unsigned ) pChk->bCurMR );
+    fprintf( pFile, "  \"other_metaroot_valid\": %s,\n", pChk->fOtherMRValid ? "true" : "false" );
+    fprintf( pFile, "  \"sequence\": %llu,\n", ( unsigned long long ) pChk->mr.hdr.ullSequence );
+    fprintf( pFile, "  \"blocks\": %u,\n", ( unsigned ) pChk->ulBlockCount );
+    fprintf( pFile, "  \"blocks_free\": %u,\n", ( unsigned ) pChk->ulFreeBlocks );
+    fprintf( pFile, "  \"inodes\": %u,\n", ( unsigned ) pChk->ulInodeCount );
+    fprintf( pFile, "  \"inodes_free\": %u,\n", ( unsigned ) pChk->ulFreeInodes );
+    fprintf( pFile, "  \"files\": %u,\n", ( unsigned ) pChk->ulFiles );
+    fprintf( pFile, "  \"directories\": %u,\n", ( unsigned ) pChk->ulDirs );
+    fprintf( pFile, "  \"data_blocks\": %llu,\n", ( unsigned long long ) pChk->ullDataBlocks );
+    fprintf( pFile, "  \"problem_count\": %u,\n", ( unsigned ) pChk->ulProblemCount );
+    fprintf( pFile, "  \"problems\": [" );
+
+    for( ulIdx = 0U; ulIdx < ulShown; ulIdx++ )
+    {
+        const CHKPROBLEM * pProblem = &pChk->pProblems[ ulIdx ];
+
+        fprintf( pFile, "%s\n    { \"kind\": \"%s\", \"inode\": %u, \"block\": %u, \"detail\": ", ( ulIdx == 0U ) ? "" : ",",
+                 pProblem->pszKind, ( unsigned ) pProblem->ulInode, ( unsigned ) pProblem->ulBlock );
+        ChkJsonString( pFile, pProblem->szDetail );
+        fprintf( pFile, " }" );
+    }
+
+    fprintf( pFile, "%s]\n}\n", ( ulShown == 0U ) ? "" : "\n  " );
+}
+
+
+/** @brief Write a string as a JSON string literal.
+ *
+ *  @param pFile    Where to write the string.
+ *  @param psz      The string.
+ */
+static void ChkJsonString( FILE * pFile,
+                           const char * psz )
+{
+    const unsigned char * pbChar;
+
+    fputc( '"', pFile );
+
+    for( pbChar = ( const unsigned char * ) psz; *pbChar != 0U; pbChar++ )
+    {
+        if( ( *pbChar == '"' ) || ( *pbChar == '\\' ) )
+        {
+            fprintf( pFile, "\\%c", *pbChar );
+        }
+        else if( ( *pbChar < 0x20U ) || ( *pbChar >= 0x7FU ) )
+        {
+            /*  Names on the volume are not necessarily UTF-8, so anything
+             *  outside of ASCII is escaped byte by byte.
+             */
+            fprintf( pFile, "\\u%04x", ( unsigned ) *pbChar );
+        }
+        else
+        {
+            fputc( *pbChar, pFile );
+        }
+    }
+
+    fputc( '"', pFile );
+}
+
+
+/** @brief Get a monotonic time in milliseconds.
+ */
+static uint64_t ChkMsec( void )
+{
+    struct timespec ts;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( ( uint64_t ) ts.tv_sec * 1000U ) + ( ( uint64_t ) ts.tv_nsec / 1000000U );
+}
+
+
+/** @brief Print usage information.
+ *
+ *  @param pszProgName  The name of the program.
+ */
+static void usage( const char * pszProgName )
+{
+    fprintf( stderr,
+             "usage: %s [options] <image>\n"
+             "Check a Reliance Edge volume image, using several threads.\n"
+             "\n"
+             "Where:\n"
+             "  <image>\n"
+             "      Path of the volume image file.\n"
+             "  --threads=count, -t count\n"
+             "      Number of worker threads (default: number of CPUs).\n"
+             "  --output=file, -o file\n"
+             "      Write the JSON report to a file instead of stdout.\n"
+             "  --max-problems=count, -m count\n"
+             "      Most problems to list in the report (default: 100).  All of\n"
+             "      them are counted.\n"
+             "  --progress, -p\n"
+             "      Print progress lines to stderr.\n"
+             "  --help, -H\n"
+             "      Prints this usage text and exits.\n"
+             "\n"
+             "Exit code: 0 if the volume is consistent, 1 if problems were found,\n"
+             "2 if the volume could not be checked.\n",
+             pszProgName );
+}
+
+
+#if REDCONF_ASSERTS == 1
+
+/** @brief Assertion handler for the utility code linked into the tool.
+ */
+    void RedOsAssertFail( const char * pszFileName,
+                          uint32_t ulLineNum )
+    {
+        fprintf( stderr, "Assertion failed in \"%s\" at line %u\n", pszFileName, ( unsigned ) ulLineNum );
+        abort();
+    }
+#endif
+
+
+int main( int argc,
+          char * argv[] )
+{
+    CHKPARAM param;
+
+    ChkParseParams( argc, argv, &param );
+
+    return ChkStart( &param );
+}
@@ -97,3 +97,79 @@ void RedBitClear( uint8_t * pbBitmap,
         pbBitmap[ ulBit >> 3U ] &= ~( 0x80U >> ( ulBit & 7U ) );
     }
 }
+
+
+/** @brief Find the first bit in a range which is clear in both of two bitmaps.
+ *
+ *  Bits are counted from most significant to least significant, as with
+ *  RedBitGet().  Runs of set bits are skipped 32 bits at a time.  The bitmaps
+ *  need not be aligned.
+ *
+ *  @param pbBitmap1    Pointer to the first bitmap.
+ *  @param pbBitmap2    Pointer to the second bitmap.  May be the same as
+ *                      @p pbBitmap1.
+ *  @param ulStart      The first bit to examine.
+ *  @param ulEnd        The bit after the last bit to examine.
+ *
+ *  @return The first bit in the range [@p ulStart, @p ulEnd) which is clear in
+ *          both bitmaps, or @p ulEnd if there is no such bit.
+ */
+uint32_t RedBitFindClear( const uint8_t * pbBitmap1,
+                          const uint8_t * pbBitmap2,
+                          uint32_t ulStart,
+                          uint32_t ulEnd )
+{
+    uint32_t ulBit = ulStart;
+
+    if( ( pbBitmap1 == NULL ) || ( pbBitmap2 == NULL ) )
+    {
+        REDERROR();
+        ulBit = ulEnd;
+    }
+    else
+    {
+        /*  Examine single bits until reaching a byte boundary.
+         */
+        while( ( ulBit < ulEnd ) && ( ( ulBit & 7U ) != 0U ) &&
+               ( ( ( pbBitmap1[ ulBit >> 3U ] | pbBitmap2[ ulBit >> 3U ] ) & ( 0x80U >> ( ulBit & 7U ) ) ) != 0U ) )
+        {
+            ulBit++;
+        }
+
+        if( ( ulBit < ulEnd ) && ( ( ulBit & 7U ) == 0U ) )
+        {
+            /*  Skip whole words in which every bit is set in either bitmap.
+             *  The words are copied since they may not be aligned; whether a
+             *  word is all ones does not depend on byte order.
+             */
+            while( ( ulEnd - ulBit ) >= 32U )
+            {
+                uint32_t ulWord1;
+                uint32_t ulWord2;
+
+                RedMemCpy( &ulWord1, &pbBitmap1[ ulBit >> 3U ], sizeof( ulWord1 ) );
+                RedMemCpy( &ulWord2, &pbBitmap2[ ulBit >> 3U ], sizeof( ulWord2 ) );
+
+                if( ( ulWord1 | ulWord2 ) != UINT32_MAX )
+                {
+                    break;
+                }
+
+                ulBit += 32U;
+            }
+
+            while( ( ( ulEnd - ulBit ) >= 8U ) && ( ( pbBitmap1[ ulBit >> 3U ] | pbBitmap2[ ulBit >> 3U ] ) == UINT8_MAX ) )
+            {
+                ulBit += 8U;
+            }
+
+            while( ( ulBit < ulEnd ) &&
+                   ( ( ( pbBitmap1[ ulBit >> 3U ] | pbBitmap2[ ulBit >> 3U ] ) & ( 0x80U >> ( ulBit & 7U ) ) ) != 0U ) )
+            {
+                ulBit++;
+            }
+        }
+    }
+
+    return ulBit;
+}
@@ -26,6 +26,13 @@
 
 /** @file
  *  @brief Implements utilities for calculating CRC-32 checksums.
+ *
+ *  Each CRC algorithm is implemented by a static function which operates on the
+ *  inverted CRC value, so that algorithms can be chained: the hardware
+ *  algorithm, for example, hands any bytes it cannot process to slice-by-16.
+ *  Normally only the algorithm selected by REDCONF_CRC_ALGORITHM is compiled;
+ *  when REDCONF_CRC_BENCHMARK is enabled, all of them are, so that they can be
+ *  compared with RedCrc32UpdateAlgorithm().
  */
 #include <redfs.h>
 
@@ -38,22 +45,99 @@
  */
 #define SUSPICIOUS_CRC_VALUE    ( 0xBAADC0DEU )
 
-#define CRC_BITWISE             ( 0U )
-#define CRC_SARWATE             ( 1U )
-#define CRC_SLICEBY8            ( 2U )
+#if ( REDCONF_CRC_ALGORITHM != CRC_BITWISE ) && ( REDCONF_CRC_ALGORITHM != CRC_SARWATE ) && ( REDCONF_CRC_ALGORITHM != CRC_SLICEBY8 ) \
+    && ( REDCONF_CRC_ALGORITHM != CRC_SLICEBY16 ) && ( REDCONF_CRC_ALGORITHM != CRC_HARDWARE )
+    #error "REDCONF_CRC_ALGORITHM must be set to CRC_BITWISE, CRC_SARWATE, CRC_SLICEBY8, CRC_SLICEBY16, or CRC_HARDWARE"
+#endif
 
+/*  Whether the given algorithm is compiled.
+ */
+#if REDCONF_CRC_BENCHMARK == 1
+    #define CRC_ENABLED( alg )    ( 1 )
+#else
+    #define CRC_ENABLED( alg )    ( REDCONF_CRC_ALGORITHM == ( alg ) )
+#endif
 
-#if REDCONF_CRC_ALGORITHM == CRC_BITWISE
+/*  The hardware algorithm needs slice-by-16 for the data it does not handle,
+ *  and when the instructions it needs are not available.
+ */
+#define CRC_SLICEBY16_ENABLED    ( CRC_ENABLED( CRC_SLICEBY16 ) || CRC_ENABLED( CRC_HARDWARE ) )
 
-/*  The following is representative of the polynomial accepted by CCITT 32-bit
- *  and in IEEE 802.3, Ethernet 2 specification.
+/*  Select the instructions used by CRC_HARDWARE.  Both of these are only used
+ *  for little-endian targets, since they consume the data in whole words.
  *
- *  x^32+x^26+x^23+x^22+x^16+x^12+x^11+x^10+x^8+x^7+x^5+x^4+x^2+x+1
- *     (reverse order)
- *  1110 1101 1011 1000 1000 0011 0010 0000 1
- *   (E)  (D)  (B)  (8)  (8)  (3)  (2)  (0)
+ *  CRC_HW_ARM: the ARMv8 CRC32 instructions, which implement the same
+ *  (IEEE 802.3) polynomial as the rest of this file.  Available whenever the
+ *  compiler targets them, so no run-time check is needed.
+ *
+ *  CRC_HW_CLMUL: folding with the x86-64 carry-less multiply instruction.  The
+ *  SSE4.2 CRC32 instruction cannot be used, because it implements the
+ *  Castagnoli polynomial.  Unless the compiler already targets PCLMULQDQ, the
+ *  CPU is checked at run time, which allows a generic host build to use it.
  */
-    #define CCITT_32_POLYNOMIAL    ( 0xEDB88320U )
+#if CRC_ENABLED( CRC_HARDWARE ) && ( REDCONF_ENDIAN_BIG == 0 )
+    #if defined( __ARM_FEATURE_CRC32 )
+        #include <arm_acle.h>
+        #define CRC_HW_ARM    1
+    #elif defined( __GNUC__ ) && defined( __x86_64__ )
+        #include <emmintrin.h>
+        #include <wmmintrin.h>
+        #define CRC_HW_CLMUL        1
+        #define CRC_CLMUL_TARGET    __attribute__( ( target( "pclmul" ) ) )
+    #elif defined( _MSC_VER ) && defined( _M_X64 )
+        #include <intrin.h>
+        #define CRC_HW_CLMUL        1
+        #define CRC_CLMUL_TARGET
+    #endif
+#endif
+
+#ifndef CRC_HW_ARM
+    #define CRC_HW_ARM    0
+#endif
+#ifndef CRC_HW_CLMUL
+    #define CRC_HW_CLMUL    0
+#endif
+
+#if CRC_HW_CLMUL == 1
+
+/*  Smallest length for which carry-less multiply folding is used.  Shorter
+ *  lengths are faster with slice-by-16.
+ */
+    #define CLMUL_MIN_LENGTH    64U
+#endif
+
+
+#if CRC_ENABLED( CRC_BITWISE )
+    static uint32_t CrcBitwise( uint32_t ulCrc32,
+                                const uint8_t * pbBuffer,
+                                uint32_t ulLength );
+#endif
+#if CRC_ENABLED( CRC_SARWATE )
+    static uint32_t CrcSarwate( uint32_t ulCrc32,
+                                const uint8_t * pbBuffer,
+                                uint32_t ulLength );
+#endif
+#if CRC_ENABLED( CRC_SLICEBY8 )
+    static uint32_t CrcSliceBy8( uint32_t ulCrc32,
+                                 const uint8_t * pbBuffer,
+                                 uint32_t ulLength );
+#endif
+#if CRC_SLICEBY16_ENABLED
+    static uint32_t CrcSliceBy16( uint32_t ulCrc32,
+                                  const uint8_t * pbBuffer,
+                                  uint32_t ulLength );
+#endif
+#if CRC_ENABLED( CRC_HARDWARE )
+    static uint32_t CrcHardware( uint32_t ulCrc32,
+                                 const uint8_t * pbBuffer,
+                                 uint32_t ulLength );
+#endif
+#if CRC_HW_CLMUL == 1
+    static bool CrcClmulSupported( void );
+    static CRC_CLMUL_TARGET uint32_t CrcClmul( uint32_t ulCrc32,
+                                               const uint8_t * pbBuffer,
+                                               uint32_t ulLength );
+#endif
 
 
 /** @brief Compute a CRC32 for the given data buffer.
@@ -67,9 +151,59 @@
  *
  *  @return The updated CRC value.
  */
-    uint32_t RedCrc32Update( uint32_t ulInitCrc32,
-                             const void * pBuffer,
-                             uint32_t ulLength )
+uint32_t RedCrc32Update( uint32_t ulInitCrc32,
+                         const void * pBuffer,
+                         uint32_t ulLength )
+{
+    uint32_t ulCrc32;
+
+    if( pBuffer == NULL )
+    {
+        REDERROR();
+        ulCrc32 = SUSPICIOUS_CRC_VALUE;
+    }
+    else
+    {
+        const uint8_t * pbBuffer = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pBuffer );
+
+        #if REDCONF_CRC_ALGORITHM == CRC_BITWISE
+            ulCrc32 = CrcBitwise( ~ulInitCrc32, pbBuffer, ulLength );
+        #elif REDCONF_CRC_ALGORITHM == CRC_SARWATE
+            ulCrc32 = CrcSarwate( ~ulInitCrc32, pbBuffer, ulLength );
+        #elif REDCONF_CRC_ALGORITHM == CRC_SLICEBY8
+            ulCrc32 = CrcSliceBy8( ~ulInitCrc32, pbBuffer, ulLength );
+        #elif REDCONF_CRC_ALGORITHM == CRC_SLICEBY16
+            ulCrc32 = CrcSliceBy16( ~ulInitCrc32, pbBuffer, ulLength );
+        #else
+            ulCrc32 = CrcHardware( ~ulInitCrc32, pbBuffer, ulLength );
+        #endif
+
+        ulCrc32 = ~ulCrc32;
+    }
+
+    return ulCrc32;
+}
+
+
+#if REDCONF_CRC_BENCHMARK == 1
+
+/** @brief Compute a CRC32 for the given data buffer with a specific algorithm.
+ *
+ *  Allows the CRC algorithms to be compared with each other; the file system
+ *  always uses RedCrc32Update().
+ *
+ *  @param bAlgorithm   The algorithm to use: one of the values allowed for
+ *                      REDCONF_CRC_ALGORITHM.
+ *  @param ulInitCrc32  Starting CRC value.
+ *  @param pBuffer      Data buffer to calculate the CRC from.
+ *  @param ulLength     Number of bytes of data in the given buffer.
+ *
+ *  @return The updated CRC value.
+ */
+    uint32_t RedCrc32UpdateAlgorithm( uint8_t bAlgorithm,
+                                      uint32_t ulInitCrc32,
+                                      const void * pBuffer,
+                                      uint32_t ulLength )
     {
         uint32_t ulCrc32;
 
@@ -81,46 +215,147 @@
         else
         {
             const uint8_t * pbBuffer = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pBuffer );
-            uint32_t ulIdx;
 
-            ulCrc32 = ~ulInitCrc32;
-
-            for( ulIdx = 0U; ulIdx < ulLength; ++ulIdx )
+            switch( bAlgorithm )
             {
-                uint32_t ulBit;
+                case CRC_BITWISE:
+                    ulCrc32 = ~CrcBitwise( ~ulInitCrc32, pbBuffer, ulLength );
+                    break;
+                case CRC_SARWATE:
+                    ulCrc32 = ~CrcSarwate( ~ulInitCrc32, pbBuffer, ulLength );
+                    break;
+                case CRC_SLICEBY8:
+                    ulCrc32 = ~CrcSliceBy8( ~ulInitCrc32, pbBuffer, ulLength );
+                    break;
+                case CRC_SLICEBY16:
+                    ulCrc32 = ~CrcSliceBy16( ~ulInitCrc32, pbBuffer, ulLength );
+                    break;
+                case CRC_HARDWARE:
+                    ulCrc32 = ~CrcHardware( ~ulInitCrc32, pbBuffer, ulLength );
+                    break;
+                default:
+                    REDERROR();
+                    ulCrc32 = SUSPICIOUS_CRC_VALUE;
+                    break;
+            }
+        }
 
-                ulCrc32 ^= pbBuffer[ ulIdx ];
+        return ulCrc32;
+    }
 
-                /*  Branchless inner loop (greatly improves performance).
-                 */
-                for( ulBit = 0U; ulBit < 8U; ulBit++ )
-                {
-                    ulCrc32 = ( ( ulCrc32 & 1U ) * CCITT_32_POLYNOMIAL ) ^ ( ulCrc32 >> 1U );
-                }
-            }
 
-            ulCrc32 = ~ulCrc32;
+/** @brief Determine whether the hardware CRC algorithm uses CPU instructions.
+ *
+ *  @return Whether CRC_HARDWARE uses CRC or carry-less multiply instructions,
+ *          rather than falling back to slice-by-16.
+ */
+    bool RedCrcHardwareAvailable( void )
+    {
+        bool fAvailable;
+
+        #if CRC_HW_ARM == 1
+            fAvailable = true;
+        #elif CRC_HW_CLMUL == 1
+            fAvailable = CrcClmulSupported();
+        #else
+            fAvailable = false;
+        #endif
+
+        return fAvailable;
+    }
+#endif /* REDCONF_CRC_BENCHMARK == 1 */
+
+
+/** @brief Compute a CRC32 for a metadata node buffer.
+ *
+ *  @param pBuffer  The metadata node buffer for which to compute a CRC.  Must
+ *                  be a block sized buffer.
+ *
+ *  @return The CRC of the buffer.
+ */
+uint32_t RedCrcNode( const void * pBuffer )
+{
+    uint32_t ulCrc;
+
+    if( pBuffer == NULL )
+    {
+        REDERROR();
+        ulCrc = SUSPICIOUS_CRC_VALUE;
+    }
+    else
+    {
+        const uint8_t * pbBuffer = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pBuffer );
+
+        /*  The first eight bytes of a metadata node contain the signature and
+         *  the CRC.  There is little value in CRCing the signature, and the
+         *  CRC cannot be CRC'd, so skip over that part of the buffer.
+         */
+        ulCrc = RedCrc32Update( 0U, &pbBuffer[ 8U ], REDCONF_BLOCK_SIZE - 8U );
+    }
+
+    return ulCrc;
+}
+
+
+#if CRC_ENABLED( CRC_BITWISE )
+
+/*  The following is representative of the polynomial accepted by CCITT 32-bit
+ *  and in IEEE 802.3, Ethernet 2 specification.
+ *
+ *  x^32+x^26+x^23+x^22+x^16+x^12+x^11+x^10+x^8+x^7+x^5+x^4+x^2+x+1
+ *     (reverse order)
+ *  1110 1101 1011 1000 1000 0011 0010 0000 1
+ *   (E)  (D)  (B)  (8)  (8)  (3)  (2)  (0)
+ */
+    #define CCITT_32_POLYNOMIAL    ( 0xEDB88320U )
+
+
+/** @brief Update an inverted CRC32 one bit at a time.
+ *
+ *  @param ulCrc32      Starting CRC value, inverted.
+ *  @param pbBuffer     Data buffer to calculate the CRC from.
+ *  @param ulLength     Number of bytes of data in the given buffer.
+ *
+ *  @return The updated CRC value, inverted.
+ */
+    static uint32_t CrcBitwise( uint32_t ulCrc32,
+                                const uint8_t * pbBuffer,
+                                uint32_t ulLength )
+    {
+        uint32_t ulIdx;
+
+        for( ulIdx = 0U; ulIdx < ulLength; ++ulIdx )
+        {
+            uint32_t ulBit;
+
+            ulCrc32 ^= pbBuffer[ ulIdx ];
+
+            /*  Branchless inner loop (greatly improves performance).
+             */
+            for( ulBit = 0U; ulBit < 8U; ulBit++ )
+            {
+                ulCrc32 = ( ( ulCrc32 & 1U ) * CCITT_32_POLYNOMIAL ) ^ ( ulCrc32 >> 1U );
+            }
         }
 
         return ulCrc32;
     }
+#endif /* CRC_ENABLED( CRC_BITWISE ) */
 
-#elif REDCONF_CRC_ALGORITHM == CRC_SARWATE
 
-/** @brief Compute a CRC32 for the given data buffer.
- *
- *  For CCITT-32 compliance, the initial CRC must be set to 0.  To CRC multiple
- *  buffers, call this function with the previously returned CRC value.
+#if CRC_ENABLED( CRC_SARWATE )
+
+/** @brief Update an inverted CRC32 one byte at a time (Sarwate algorithm).
  *
- *  @param ulInitCrc32  Starting CRC value.
- *  @param pBuffer      Data buffer to calculate the CRC from.
+ *  @param ulCrc32      Starting CRC value, inverted.
+ *  @param pbBuffer     Data buffer to calculate the CRC from.
  *  @param ulLength     Number of bytes of data in the given buffer.
  *
- *  @return The updated CRC value.
+ *  @return The updated CRC value, inverted.
  */
-    uint32_t RedCrc32Update( uint32_t ulInitCrc32,
-                             const void * pBuffer,
-                             uint32_t ulLength )
+    static uint32_t CrcSarwate( uint32_t ulCrc32,
+                                const uint8_t * pbBuffer,
+                                uint32_t ulLength )
     {
         static const uint32_t aulCrc32Table[] =
         {
@@ -158,48 +393,31 @@
             0xB3667A2EU, 0xC4614AB8U, 0x5D681B02U, 0x2A6F2B94U, 0xB40BBE37U, 0xC30C8EA1U, 0x5A05DF1BU, 0x2D02EF8DU,
         };
 
-        uint32_t ulCrc32;
+        uint32_t ulIdx;
 
-        if( pBuffer == NULL )
-        {
-            REDERROR();
-            ulCrc32 = SUSPICIOUS_CRC_VALUE;
-        }
-        else
+        for( ulIdx = 0U; ulIdx < ulLength; ++ulIdx )
         {
-            const uint8_t * pbBuffer = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pBuffer );
-            uint32_t ulIdx;
-
-            ulCrc32 = ~ulInitCrc32;
-
-            for( ulIdx = 0U; ulIdx < ulLength; ++ulIdx )
-            {
-                ulCrc32 = ( ulCrc32 >> 8U ) ^ aulCrc32Table[ ( ulCrc32 ^ pbBuffer[ ulIdx ] ) & 0xFFU ];
-            }
-
-            ulCrc32 = ~ulCrc32;
+            ulCrc32 = ( ulCrc32 >> 8U ) ^ aulCrc32Table[ ( ulCrc32 ^ pbBuffer[ ulIdx ] ) & 0xFFU ];
         }
 
         return ulCrc32;
     }
+#endif /* CRC_ENABLED( CRC_SARWATE ) */
 
-#elif REDCONF_CRC_ALGORITHM == CRC_SLICEBY8
 
+#if CRC_ENABLED( CRC_SLICEBY8 )
 
-/** @brief Compute a CRC32 for the given data buffer.
+/** @brief Update an inverted CRC32 eight bytes at a time (slice-by-8).
  *
- *  For CCITT-32 compliance, the initial CRC must be set to 0.  To CRC multiple
- *  buffers, call this function with the previously returned CRC value.
- *
- *  @param ulInitCrc32  Starting CRC value.
- *  @param pBuffer      Data buffer to calculate the CRC from.
+ *  @param ulCrc32      Starting CRC value, inverted.
+ *  @param pbBuffer     Data buffer to calculate the CRC from.
  *  @param ulLength     Number of bytes of data in the given buffer.
  *
- *  @return The updated CRC value.
+ *  @return The updated CRC value, inverted.
  */
-    uint32_t RedCrc32Update( uint32_t ulInitCrc32,
-                             const void * pBuffer,
-                             uint32_t ulLength )
+    static uint32_t CrcSliceBy8( uint32_t ulCrc32,
+                                 const uint8_t * pbBuffer,
+                                 uint32_t ulLength )
     {
         /*  CRC32 XOR table, with slicing-by-8 extensions.
          *
@@ -478,118 +696,864 @@
             0x2D02EF8DU, 0x9324FD72U, 0xBE9834EDU, 0xDE0506F1U, 0xCA64C78CU, 0xE4C4ABCCU, 0x92364A30U, 0x264B06E6U,
         };
 
-        uint32_t ulCrc32;
+        uint32_t ulIdx = 0U;
+        const uint32_t * pulXorCrc0 = &aulCrc32Table[ 7U ];
+        const uint32_t * pulXorCrc1 = &aulCrc32Table[ 6U ];
+        const uint32_t * pulXorCrc2 = &aulCrc32Table[ 5U ];
+        const uint32_t * pulXorCrc3 = &aulCrc32Table[ 4U ];
+        const uint32_t * pulXorData4 = &aulCrc32Table[ 3U ];
+        const uint32_t * pulXorData5 = &aulCrc32Table[ 2U ];
+        const uint32_t * pulXorData6 = &aulCrc32Table[ 1U ];
+        const uint32_t * pulXorData7 = &aulCrc32Table[ 0U ];
+        uint32_t ulSliceLen;
 
-        if( pBuffer == NULL )
+        /*  Aligned memory access is used below.  To avoid suboptimal
+         *  performance and faults (depending on platform), handle the
+         *  unaligned initial bytes (if any) using the Sarwate algorithm.
+         */
+        while( ( ulIdx < ulLength ) && !IS_ALIGNED_PTR( &pbBuffer[ ulIdx ] ) )
         {
-            REDERROR();
-            ulCrc32 = SUSPICIOUS_CRC_VALUE;
+            ulCrc32 = ( ulCrc32 >> 8U ) ^ aulCrc32Table[ ( ( ulCrc32 ^ pbBuffer[ ulIdx ] ) & 0xFFU ) << 3U ];
+
+            ulIdx++;
         }
-        else
-        {
-            const uint8_t * pbBuffer = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pBuffer );
-            uint32_t ulIdx = 0U;
-            const uint32_t * pulXorCrc0 = &aulCrc32Table[ 7U ];
-            const uint32_t * pulXorCrc1 = &aulCrc32Table[ 6U ];
-            const uint32_t * pulXorCrc2 = &aulCrc32Table[ 5U ];
-            const uint32_t * pulXorCrc3 = &aulCrc32Table[ 4U ];
-            const uint32_t * pulXorData4 = &aulCrc32Table[ 3U ];
-            const uint32_t * pulXorData5 = &aulCrc32Table[ 2U ];
-            const uint32_t * pulXorData6 = &aulCrc32Table[ 1U ];
-            const uint32_t * pulXorData7 = &aulCrc32Table[ 0U ];
-            uint32_t ulSliceLen;
-
-            ulCrc32 = ~ulInitCrc32;
-
-            /*  Aligned memory access is used below.  To avoid suboptimal
-             *  performance and faults (depending on platform), handle the
-             *  unaligned initial bytes (if any) using the Sarwate algorithm.
-             */
-            while( ( ulIdx < ulLength ) && !IS_ALIGNED_PTR( &pbBuffer[ ulIdx ] ) )
-            {
-                ulCrc32 = ( ulCrc32 >> 8U ) ^ aulCrc32Table[ ( ( ulCrc32 ^ pbBuffer[ ulIdx ] ) & 0xFFU ) << 3U ];
 
-                ulIdx++;
-            }
+        /*  Round down the length to the nearest multiple of eight.
+         */
+        ulSliceLen = ( ( ( ulLength - ulIdx ) >> 3U ) << 3U ) + ulIdx;
 
-            /*  Round down the length to the nearest multiple of eight.
-             */
-            ulSliceLen = ( ( ( ulLength - ulIdx ) >> 3U ) << 3U ) + ulIdx;
+        /*  Compute the CRC in eight byte "slices".  Takes advantage of
+         *  modern processors which can load in parallel from multiple
+         *  memory locations.
+         */
+        while( ulIdx < ulSliceLen )
+        {
+            #if REDCONF_ENDIAN_BIG == 1
+                ulCrc32 ^= pbBuffer[ ulIdx ] | ( ( uint32_t ) pbBuffer[ ulIdx + 1U ] << 8U ) |
+                           ( ( uint32_t ) pbBuffer[ ulIdx + 2U ] << 16U ) | ( ( uint32_t ) pbBuffer[ ulIdx + 3U ] << 24U );
+            #else
+                ulCrc32 ^= *CAST_CONST_UINT32_PTR( &pbBuffer[ ulIdx ] );
+            #endif
 
-            /*  Compute the CRC in eight byte "slices".  Takes advantage of
-             *  modern processors which can load in parallel from multiple
-             *  memory locations.
-             */
-            while( ulIdx < ulSliceLen )
-            {
-                #if REDCONF_ENDIAN_BIG == 1
-                    ulCrc32 ^= pbBuffer[ ulIdx ] | ( ( uint32_t ) pbBuffer[ ulIdx + 1U ] << 8U ) |
-                               ( ( uint32_t ) pbBuffer[ ulIdx + 2U ] << 16U ) | ( ( uint32_t ) pbBuffer[ ulIdx + 3U ] << 24U );
-                #else
-                    ulCrc32 ^= *CAST_CONST_UINT32_PTR( &pbBuffer[ ulIdx ] );
-                #endif
-
-                ulCrc32 =
-                    pulXorCrc3[ ( ( ulCrc32 >> 24U ) & 0xFFU ) << 3U ] ^
-                    pulXorCrc2[ ( ( ulCrc32 >> 16U ) & 0xFFU ) << 3U ] ^
-                    pulXorCrc1[ ( ( ulCrc32 >> 8U ) & 0xFFU ) << 3U ] ^
-                    pulXorCrc0[ ( ulCrc32 & 0xFFU ) << 3U ] ^
-                    pulXorData7[ pbBuffer[ ulIdx + 7U ] << 3U ] ^
-                    pulXorData6[ pbBuffer[ ulIdx + 6U ] << 3U ] ^
-                    pulXorData5[ pbBuffer[ ulIdx + 5U ] << 3U ] ^
-                    pulXorData4[ pbBuffer[ ulIdx + 4U ] << 3U ];
-
-                ulIdx += 8U;
-            }
+            ulCrc32 =
+                pulXorCrc3[ ( ( ulCrc32 >> 24U ) & 0xFFU ) << 3U ] ^
+                pulXorCrc2[ ( ( ulCrc32 >> 16U ) & 0xFFU ) << 3U ] ^
+                pulXorCrc1[ ( ( ulCrc32 >> 8U ) & 0xFFU ) << 3U ] ^
+                pulXorCrc0[ ( ulCrc32 & 0xFFU ) << 3U ] ^
+                pulXorData7[ pbBuffer[ ulIdx + 7U ] << 3U ] ^
+                pulXorData6[ pbBuffer[ ulIdx + 6U ] << 3U ] ^
+                pulXorData5[ pbBuffer[ ulIdx + 5U ] << 3U ] ^
+                pulXorData4[ pbBuffer[ ulIdx + 4U ] << 3U ];
 
-            /*  Compute the remaining bytes with the Sarwate algorithm.
-             */
-            while( ulIdx < ulLength )
-            {
-                ulCrc32 = ( ulCrc32 >> 8U ) ^ aulCrc32Table[ ( ( ulCrc32 ^ pbBuffer[ ulIdx ] ) & 0xFFU ) << 3U ];
+            ulIdx += 8U;
+        }
 
-                ulIdx++;
-            }
+        /*  Compute the remaining bytes with the Sarwate algorithm.
+         */
+        while( ulIdx < ulLength )
+        {
+            ulCrc32 = ( ulCrc32 >> 8U ) ^ aulCrc32Table[ ( ( ulCrc32 ^ pbBuffer[ ulIdx ] ) & 0xFFU ) << 3U ];
 
-            ulCrc32 = ~ulCrc32;
+            ulIdx++;
         }
 
         return ulCrc32;
     }
+#endif /* CRC_ENABLED( CRC_SLICEBY8 ) */
 
-#else /* if REDCONF_CRC_ALGORITHM == CRC_BITWISE */
-
-    #error "REDCONF_CRC_ALGORITHM must be set to CRC_BITWISE, CRC_SARWATE, or CRC_SLICEBY8"
 
-#endif /* if REDCONF_CRC_ALGORITHM == CRC_BITWISE */
+#if CRC_SLICEBY16_ENABLED
 
-
-/** @brief Compute a CRC32 for a metadata node buffer.
+/** @brief Update an inverted CRC32 sixteen bytes at a time (slice-by-16).
  *
- *  @param pBuffer  The metadata node buffer for which to compute a CRC.  Must
- *                  be a block sized buffer.
+ *  Works like slice-by-8, with twice as many independent table lookups per
+ *  iteration; this suits processors with several load units and a data cache
+ *  large enough for the 16 KB table.
  *
- *  @return The CRC of the buffer.
+ *  @param ulCrc32      Starting CRC value, inverted.
+ *  @param pbBuffer     Data buffer to calculate the CRC from.
+ *  @param ulLength     Number of bytes of data in the given buffer.
+ *
+ *  @return The updated CRC value, inverted.
  */
-uint32_t RedCrcNode( const void * pBuffer )
-{
-    uint32_t ulCrc;
-
-    if( pBuffer == NULL )
+    static uint32_t CrcSliceBy16( uint32_t ulCrc32,
+                                  const uint8_t * pbBuffer,
+                                  uint32_t ulLength )
     {
-        REDERROR();
-        ulCrc = SUSPICIOUS_CRC_VALUE;
-    }
-    else
-    {
-        const uint8_t * pbBuffer = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pBuffer );
-
-        /*  The first eight bytes of a metadata node contain the signature and
-         *  the CRC.  There is little value in CRCing the signature, and the
-         *  CRC cannot be CRC'd, so skip over that part of the buffer.
+        /*  CRC32 XOR table, with slicing-by-16 extensions.  Column N holds the
+         *  CRC of each byte value followed by N zero bytes; column zero is the
+         *  Sarwate table.  Columns are interleaved for the same reason as in
+         *  the slice-by-8 table.
          */
-        ulCrc = RedCrc32Update( 0U, &pbBuffer[ 8U ], REDCONF_BLOCK_SIZE - 8U );
-    }
-
-    return ulCrc;
-}
+        static const uint32_t aulCrc32Table[] =
+        {
+            0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U,
+            0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U,
+            0x77073096U, 0x191B3141U, 0x01C26A37U, 0xB8BC6765U, 0x3D6029B0U, 0xCB5CD3A5U, 0xA6770BB4U, 0xCCAA009EU,
+            0x177B1443U, 0xEFC26B3EU, 0xC18EDFC0U, 0x9BA54C6FU, 0xDD96D985U, 0x9D0FE176U, 0xB9FBDBE8U, 0xAE689191U,
+            0xEE0E612CU, 0x32366282U, 0x0384D46EU, 0xAA09C88BU, 0x7AC05360U, 0x4DC8A10BU, 0x979F1129U, 0x4225077DU,
+            0x2EF62886U, 0x04F5D03DU, 0x586CB9C1U, 0xEC3B9E9FU, 0x605CB54BU, 0xE16EC4ADU, 0xA886B191U, 0x87A02563U,
+            0x990951BAU, 0x2B2D53C3U, 0x0246BE59U, 0x12B5AFEEU, 0x47A07AD0U, 0x869472AEU, 0x31E81A9DU, 0x8E8F07E3U,
+            0x398D3CC5U, 0xEB37BB03U, 0x99E26601U, 0x779ED2F0U, 0xBDCA6CCEU, 0x7C6125DBU, 0x117D6A79U, 0x29C8B4F2U,
+            0x076DC419U, 0x646CC504U, 0x0709A8DCU, 0x8F629757U, 0xF580A6C0U, 0x9B914216U, 0xF44F2413U, 0x844A0EFAU,
+            0x5DEC510CU, 0x09EBA07AU, 0xB0D97382U, 0x03063B7FU, 0xC0B96A96U, 0x19AC8F1BU, 0x8A7C6563U, 0xD4314C87U,
+            0x706AF48FU, 0x7D77F445U, 0x06CBC2EBU, 0x37DEF032U, 0xC8E08F70U, 0x50CD91B3U, 0x52382FA7U, 0x48E00E64U,
+            0x4A97454FU, 0xE629CB44U, 0x7157AC42U, 0x98A37710U, 0x1D2FB313U, 0x84A36E6DU, 0x3387BE8BU, 0x7A59DD16U,
+            0xE963A535U, 0x565AA786U, 0x048D7CB2U, 0x256B5FDCU, 0x8F40F5A0U, 0xD659E31DU, 0x63D0353AU, 0xC66F0987U,
+            0x731A798AU, 0x0D1E7047U, 0xE8B5CA43U, 0xEF3DA5E0U, 0xA0E5DFDDU, 0xF8C24BB6U, 0x22FAD4F2U, 0x539169E4U,
+            0x9E6495A3U, 0x4F4196C7U, 0x054F1685U, 0x9DD738B9U, 0xB220DC10U, 0x1D0530B8U, 0xC5A73E8EU, 0x0AC50919U,
+            0x64616DC9U, 0xE2DC1B79U, 0x293B1583U, 0x7498E98FU, 0x7D730658U, 0x65CDAAC0U, 0x9B010F1AU, 0xFDF9F875U,
+            0x0EDB8832U, 0xC8D98A08U, 0x0E1351B8U, 0xC5B428EFU, 0x30704BC1U, 0xEC53826DU, 0x33EF4E67U, 0xD3E51BB5U,
+            0xBBD8A218U, 0x13D740F4U, 0xBAC3E145U, 0x060C76FEU, 0x5A03D36DU, 0x33591E36U, 0xCF89CC87U, 0x73139F4FU,
+            0x79DCB8A4U, 0xD1C2BB49U, 0x0FD13B8FU, 0x7D084F8AU, 0x0D106271U, 0x270F51C8U, 0x959845D3U, 0x1F4F1B2BU,
+            0xACA3B65BU, 0xFC152BCAU, 0x7B4D3E85U, 0x9DA93A91U, 0x87950AE8U, 0xAE56FF40U, 0x7672176FU, 0xDD7B0EDEU,
+            0xE0D5E91EU, 0xFAEFE88AU, 0x0D9785D6U, 0x6FBDE064U, 0x4AB018A1U, 0xA19B2366U, 0xA4705F4EU, 0x91C01CC8U,
+            0x952E8A9EU, 0x172290C9U, 0xE2AF5884U, 0xEA37E861U, 0x3A5F6626U, 0xD237DA9BU, 0x670F7D16U, 0xF4B3BA2CU,
+            0x97D2D988U, 0xE3F4D9CBU, 0x0C55EFE1U, 0xD7018701U, 0x77D03111U, 0x6AC7F0C3U, 0x020754FAU, 0x5D6A1C56U,
+            0x82559EDDU, 0xF8E0FBF7U, 0x23218744U, 0x7192A40EU, 0xE7C9BFA3U, 0x4F383BEDU, 0xDEF4A6FEU, 0x5ADB2BBDU,
+            0x09B64C2BU, 0xACB54F0CU, 0x091AF964U, 0x4AD6BFB8U, 0xC5F0ED01U, 0x77C2C07BU, 0xC7A06A74U, 0x57AF154FU,
+            0xE634F314U, 0x1A3CE08EU, 0x0A1A92C7U, 0x050A4D81U, 0x9ABAB9FBU, 0x2AF5912DU, 0x45F5A9E4U, 0xA722D3C8U,
+            0x7EB17CBDU, 0xB5AE7E4DU, 0x08D89353U, 0xF26AD8DDU, 0xF890C4B1U, 0xBC9E13DEU, 0x61D761C0U, 0x9B0515D1U,
+            0xF14FE757U, 0xF5FE8BB0U, 0xCB944D07U, 0x9EAF01EEU, 0x472C607EU, 0xB7FA705BU, 0xFC0E720CU, 0x094A4259U,
+            0xE7B82D07U, 0x9E832D8EU, 0x0A9E2D0AU, 0xE0DF7733U, 0xBF30BE61U, 0x3A0A6170U, 0x503F7B5DU, 0x158A1232U,
+            0xC8C2DB92U, 0x1EC930B3U, 0x52762B06U, 0xE931D31EU, 0xFAE60CB0U, 0xCB9B5580U, 0xED731875U, 0x2082F6ABU,
+            0x90BF1D91U, 0x87981CCFU, 0x0B5C473DU, 0x58631056U, 0x825097D1U, 0xF156B2D5U, 0xF64870E9U, 0xD92012ACU,
+            0xDFB9CFD1U, 0xF10B5B8DU, 0x93F8F4C6U, 0x72949F71U, 0x2770D535U, 0x5694B4F6U, 0x5488C39DU, 0x8EEA673AU,
+            0x1DB71064U, 0x4AC21251U, 0x1C26A370U, 0x5019579FU, 0x60E09782U, 0x03D6029BU, 0x67DE9CCEU, 0x7CBB312BU,
+            0xACC04271U, 0x27AE81E8U, 0xAEF6C4CBU, 0x0C18EDFCU, 0xB407A6DAU, 0x66B23C6CU, 0x44629F4FU, 0xE6273E9EU,
+            0x6AB020F2U, 0x53D92310U, 0x1DE4C947U, 0xE8A530FAU, 0x5D80BE32U, 0xC88AD13EU, 0xC1A9977AU, 0xB01131B5U,
+            0xBBBB5632U, 0xC86CEAD6U, 0x6F781B0BU, 0x97BDA193U, 0x69917F5FU, 0xFBBDDD1AU, 0xFD9944A7U, 0x484FAF0FU,
+            0xF3B97148U, 0x78F470D3U, 0x1FA2771EU, 0xFA109F14U, 0x1A20C4E2U, 0x4E1EA390U, 0xF0418DE7U, 0x3E9E3656U,
+            0x82366AF7U, 0x235B51D5U, 0xF69A7D0AU, 0xE0237363U, 0xD45B1391U, 0x87DCF8C1U, 0xECE42EDEU, 0x61871BFDU,
+            0x84BE41DEU, 0x61EF4192U, 0x1E601D29U, 0x42ACF871U, 0x2740ED52U, 0x85427035U, 0x56368653U, 0xF23436C8U,
+            0x954D7EB4U, 0xCC993AEBU, 0x3714A2CAU, 0x7B863F0CU, 0x09CDCA14U, 0x1AD319B7U, 0x551FF536U, 0xCFEF8A6CU,
+            0x1ADAD47DU, 0x2EAED755U, 0x1B2F0BACU, 0xDF7BC0C8U, 0x95603142U, 0x9847408DU, 0x9391B8DDU, 0xF8F13FD1U,
+            0xF12C137DU, 0x2E452192U, 0x1E2FB749U, 0x0F1ED683U, 0x74BECC4CU, 0x7F1EB377U, 0xCE1EFA2CU, 0x32167219U,
+            0x6DDDE4EBU, 0x37B5E614U, 0x1AED619BU, 0x67C7A7ADU, 0xA80018F2U, 0x531B9328U, 0x35E6B369U, 0x345B3F4FU,
+            0xE657073EU, 0xC1874AACU, 0xDFA16889U, 0x94BB9AECU, 0xA92815C9U, 0xE2115201U, 0x77E521C4U, 0x9C7EE388U,
+            0xF4D4B551U, 0x1C98B5D7U, 0x18ABDFC2U, 0x75720843U, 0xEFA06222U, 0xD58FE186U, 0x040EA9F4U, 0xBAD438ACU,
+            0xDFDA3BFBU, 0x2AB0F1AFU, 0x46430E88U, 0xE325481CU, 0x14E27907U, 0x9E7077DAU, 0x66984BBDU, 0xB5B6577AU,
+            0x83D385C7U, 0x05838496U, 0x1969B5F5U, 0xCDCE6F26U, 0xD2C04B92U, 0x1ED33223U, 0xA279A240U, 0x767E3832U,
+            0xC8A12FB8U, 0xC5729A91U, 0x87CDD148U, 0x78800473U, 0xC974A082U, 0x037F96ACU, 0xDF639055U, 0x1BDEC6EBU,
+            0x136C9856U, 0x821B9859U, 0x1235F2C8U, 0x95AD7F70U, 0x5090DC43U, 0xEF8580F6U, 0x5431D2A9U, 0xAF5E2A9EU,
+            0x1718E069U, 0x3479C11CU, 0x1435258EU, 0x0A149B02U, 0xEE0475B7U, 0x55EB225AU, 0x8BEB53C8U, 0x9534A1D1U,
+            0x646BA8C0U, 0x9B00A918U, 0x13F798FFU, 0x2D111815U, 0x6DF0F5F3U, 0x24D95353U, 0xF246D91DU, 0x63F42A00U,
+            0x0063F42AU, 0xDBBBAA22U, 0xD5BBFA4EU, 0x91B1D76DU, 0x3392AC32U, 0xC8E4C32CU, 0x32108820U, 0x3B5C3040U,
+            0xFD62F97AU, 0xB02DFADBU, 0x11B126A6U, 0x3FA4B7FBU, 0x2A508F23U, 0xA24D21FDU, 0xC3AEC380U, 0xED7B2DE3U,
+            0x39EEC8EFU, 0x308C1121U, 0x4C599C4FU, 0xE62F059DU, 0x8E58C0FCU, 0xB485E6F7U, 0x236DE259U, 0x129484B2U,
+            0x8A65C9ECU, 0xA936CB9AU, 0x10734C91U, 0x8718D09EU, 0x1730A693U, 0x6911F258U, 0x65D9C834U, 0x21D12D7DU,
+            0x2E95DCACU, 0xDF4E7A1FU, 0x8DD7438FU, 0x7D8A49F2U, 0x53CE1979U, 0x298A0781U, 0x9A9639B1U, 0xBCFC1523U,
+            0x14015C4FU, 0xE6775D5DU, 0x153C5A14U, 0x1ACFE827U, 0xA5107A83U, 0x7414C2E0U, 0xA07EF6BAU, 0x2B142464U,
+            0x4AF4B165U, 0x3D926166U, 0xA4EC560CU, 0x0912A07DU, 0x2EBD1F21U, 0x4C47AD41U, 0x019736ABU, 0x4105ED56U,
+            0x63066CD9U, 0xFF6C6C1CU, 0x14FE3023U, 0xA2738F42U, 0x98705333U, 0xBF481145U, 0x0609FD0EU, 0xE7BE24FAU,
+            0x5D8FA526U, 0xD2500A58U, 0x656289CCU, 0x92B7EC12U, 0xF32BC6A4U, 0xD1484C37U, 0xB86CED43U, 0xEF6D7CC7U,
+            0xFA0F3D63U, 0xD4413FDFU, 0x16B88E7AU, 0xB0C620ACU, 0xDFD029E3U, 0x39DC63EBU, 0x37E1E793U, 0x69312319U,
+            0x640299E3U, 0x3967B15BU, 0xFC80EFCDU, 0xE5293EE2U, 0x4EE1AA6AU, 0xAD2969ECU, 0xA911873AU, 0xC6A5C835U,
+            0x8D080DF5U, 0xCD5A0E9EU, 0x177AE44DU, 0x087A47C9U, 0xE2B00053U, 0xF280B04EU, 0x9196EC27U, 0xA59B2387U,
+            0x73798DA0U, 0xD6A5DA65U, 0x3D0E300DU, 0x7E8C728DU, 0x937773EFU, 0x3026889AU, 0x10EA5CD2U, 0x68CD59A4U,
+            0x3B6E20C8U, 0x958424A2U, 0x384D46E0U, 0xA032AF3EU, 0xC1C12F04U, 0x07AC0536U, 0xCFBD399CU, 0xF9766256U,
+            0x82F182A3U, 0x4F5D03D0U, 0x869C8FD7U, 0x1831DBF8U, 0xB37E4BF5U, 0xCD6478D8U, 0x88C53E9EU, 0x173F7B7DU,
+            0x4C69105EU, 0x8C9F15E3U, 0x398F2CD7U, 0x188EC85BU, 0xFCA106B4U, 0xCCF0D693U, 0x69CA3228U, 0x35DC62C8U,
+            0x958A96E0U, 0xA09F68EEU, 0x47125017U, 0x83949797U, 0x6EE89270U, 0x506B99AEU, 0x313EE576U, 0xB957EAECU,
+            0xD56041E4U, 0xA7B24620U, 0x3BC9928EU, 0x0A3B67B5U, 0xBB017C64U, 0x4A64A43DU, 0x582228B5U, 0xBB53652BU,
+            0xAC07AA25U, 0x4BA8D3EDU, 0xDEF03616U, 0xF40A4567U, 0xD322FEBEU, 0x2C0ABC75U, 0x20438F0FU, 0x909F5E1EU,
+            0xA2677172U, 0xBEA97761U, 0x3A0BF8B9U, 0xB28700D0U, 0x866155D4U, 0x81387798U, 0xFE552301U, 0x77F965B5U,
+            0xBB7CBE66U, 0xA46AB8D3U, 0x1F7EE9D6U, 0x6FAF0908U, 0x0EB4273BU, 0xB1055D03U, 0x99B854E7U, 0x3EF7CF8FU,
+            0x3C03E4D1U, 0xF1E8E1A6U, 0x3F44EE3CU, 0x2F503869U, 0x344189C4U, 0x9C3D4720U, 0x3BF21D8FU, 0x7D3C6CACU,
+            0xDF1DD3AFU, 0x46B6A3AAU, 0x3645FC55U, 0x1B37E087U, 0x73C72163U, 0xD4C8F7C3U, 0x02B95BFDU, 0xC30E37FAU,
+            0x4B04D447U, 0xE8F3D0E7U, 0x3E86840BU, 0x97EC5F0CU, 0x0921A074U, 0x57619485U, 0x9D85163BU, 0xB1966C32U,
+            0xC866C7ECU, 0xA974C894U, 0xF7CB2395U, 0x8092ACE8U, 0xAE51F8E6U, 0x49C716B5U, 0xBB428015U, 0x6D66A66BU,
+            0xD20D85FDU, 0xC3DE8324U, 0x3CC03A52U, 0x8559F0E2U, 0x4E81DAA4U, 0xD1F5E62BU, 0xAC6D0CA6U, 0x3F196BD1U,
+            0xF1EBFB29U, 0x42437397U, 0x6E294594U, 0xF70C7E18U, 0x139B9428U, 0x35A6336EU, 0xAA3FEA6CU, 0x44AE1299U,
+            0xA50AB56BU, 0xDAC5B265U, 0x3D025065U, 0x3DE59787U, 0x73E1F314U, 0x1AA9358EU, 0x0A1A0712U, 0xF3B36B4FU,
+            0xE690EF6AU, 0xAD8118A9U, 0xAFA79A54U, 0x6CA93277U, 0xCE0D4DADU, 0xA8A9D218U, 0x13C43184U, 0xEAC68308U,
+            0x35B5A8FAU, 0x5D5DAEAAU, 0x365E1758U, 0x658687D1U, 0xF1B164C5U, 0xEBFF875BU, 0xFC5277FBU, 0x2A9379E3U,
+            0x392920BBU, 0x5C8A4324U, 0x3C5F6E92U, 0x1E3DAD06U, 0xE97D9898U, 0xFE3D66EEU, 0x474CF219U, 0x642CE432U,
+            0x42B2986CU, 0x44469FEBU, 0x379C7D6FU, 0xDD3AE0B4U, 0xCCD14D75U, 0x20A354FEU, 0x5A257C4FU, 0xE639797DU,
+            0x2E5234F8U, 0xB348281AU, 0xFDD1B152U, 0x8598E169U, 0x34EB411DU, 0x63328798U, 0xFEB729F1U, 0xCA4475A3U,
+            0xDBBBC9D6U, 0x6F6BCC28U, 0x35DAC336U, 0xCF8F4F5AU, 0x8B7137A5U, 0xA6372650U, 0x6BCD66D2U, 0x68B67E9EU,
+            0x17DF083DU, 0x587F9319U, 0x6433D753U, 0xF2063399U, 0x89212DD3U, 0x1F53A243U, 0xEFCA4388U, 0xE38CC151U,
+            0xACBCF940U, 0x7670FD69U, 0x3418A901U, 0x7733283FU, 0xB6111E15U, 0x6D6BF5F5U, 0xCDBA6D66U, 0xA41C7E00U,
+            0x00A41C7EU, 0xB7BDF827U, 0xA5BD0893U, 0x69A37FF6U, 0x54B7F456U, 0x825C4335U, 0x56319860U, 0x4DE450C0U,
+            0x32D86CE3U, 0x39316BAEU, 0x3157BF84U, 0xEAE41086U, 0x0431C205U, 0x706EC54DU, 0x081D53E8U, 0xAED97719U,
+            0x64C571B7U, 0x5561E35EU, 0x8C861D10U, 0x1D3B9679U, 0x29C4F20EU, 0xE791E9F5U, 0xCD30977AU, 0xB01DA8B5U,
+            0x45DF5C75U, 0x202A5AEFU, 0x3095D5B3U, 0x525877E3U, 0x3951EBB5U, 0xBB3216E8U, 0xAE6A585CU, 0x62737787U,
+            0x73BE65F4U, 0xBAA38860U, 0x4D08C2D0U, 0x869EDA16U, 0xF4522B8BU, 0x7A9E0883U, 0x74CB4C92U, 0x1E753924U,
+            0xDCD60DCFU, 0x0B07092CU, 0x32D36BEAU, 0x40EDD80DU, 0x7EF19165U, 0x3DA66446U, 0x9F8242C1U, 0xECFC7064U,
+            0x4A335931U, 0x51943363U, 0xD4EAA4D1U, 0xF10008E6U, 0x49984745U, 0x06FF2D58U, 0x65B626EBU, 0x37BD8DD6U,
+            0xABD13D59U, 0x121C386DU, 0x331101DDU, 0xF851BF68U, 0x4391B8D5U, 0xF6FAB7E3U, 0x39F54975U, 0x205670FAU,
+            0x5D484D72U, 0xBE56585DU, 0x15647B11U, 0x6AA54489U, 0x940E9EC0U, 0x9BF0CC2EU, 0xDC4DFD03U, 0x99D51C47U,
+            0x26D930ACU, 0xDF4636F3U, 0x246BE590U, 0xF02BF8A1U, 0xA121B886U, 0x047A07ADU, 0xA863A552U, 0x85CD537DU,
+            0x2E31C0D2U, 0x68F38238U, 0x286A4B1CU, 0x14293604U, 0x0779ED2FU, 0xABD644B4U, 0xCCA7A1D1U, 0xF11845E3U,
+            0x51DE003AU, 0xC65D07B2U, 0x25A98FA7U, 0x48979FC4U, 0x9C419136U, 0xCF26D408U, 0x0E14AEE6U, 0x496753E3U,
+            0x394AD491U, 0x8731E906U, 0xE9E494DCU, 0x8F8C7A6BU, 0xDAEF34AAU, 0x36D9A5C2U, 0x755C7A39U, 0x5F70D472U,
+            0xC8D75180U, 0xED705471U, 0x27EF31FEU, 0x5A22302AU, 0xDBE1EBE6U, 0x49B2A6A6U, 0x3FFCB47BU, 0xC7E85400U,
+            0x00C7E854U, 0x6C065205U, 0x7006F2DDU, 0xF812A89BU, 0x67255864U, 0x4AB88019U, 0x64211040U, 0x76B86080U,
+            0xBFD06116U, 0xF46B6530U, 0x262D5BC9U, 0xE29E574FU, 0xE681C256U, 0x82EE7503U, 0x998BBFCFU, 0x0B42549EU,
+            0x17BCFC17U, 0x83C4393BU, 0xB1882D1DU, 0x63B7E4F4U, 0xBAB381E1U, 0xD7B7616FU, 0xDDDACBA8U, 0xD8D0F111U,
+            0x21B4F4B5U, 0xBB2AF3F7U, 0x23624D4CU, 0x7F496FF6U, 0x54A11E46U, 0x9FEB45BBU, 0x5C2C8141U, 0x01875D87U,
+            0x73DD91DEU, 0x61182242U, 0x98B3389EU, 0x172F0D7BU, 0xC7C087B9U, 0xB27ACBAFU, 0x46DBC4B2U, 0x25290964U,
+            0x56B3C423U, 0xA231C2B6U, 0x22A0277BU, 0xC7F50893U, 0x69C137F6U, 0x54B7961EU, 0xFA5B8AF5U, 0xCD2D5D19U,
+            0x64A6859DU, 0x8EDA497CU, 0x593DE75EU, 0x8C8A4114U, 0x1A565E3CU, 0x2F752AD9U, 0xFF201F5AU, 0x8B4198F5U,
+            0xCFBA9599U, 0x891C9175U, 0x20E69922U, 0xD540A77DU, 0x2E614D26U, 0xD223E4B0U, 0xCBB39068U, 0x43A25AFAU,
+            0x5D2BB958U, 0x65EDF27FU, 0xC0DF815FU, 0xFB1493E4U, 0xA79C32F2U, 0x53140F02U, 0xEE5D7523U, 0xA2892C07U,
+            0xB8BDA50FU, 0x9007A034U, 0x2124F315U, 0x6DFCC018U, 0x13016496U, 0x197F3715U, 0x6DC49BDCU, 0x8F085A64U,
+            0x4A50AD1BU, 0x8A2F9941U, 0x01515E9FU, 0x60B1DF8BU, 0x7A0AEB77U, 0xCE1BEE74U, 0x57A6AECBU, 0x0CE1BD96U,
+            0x2802B89EU, 0x179FBCFBU, 0x2A78B428U, 0x359FD04EU, 0x9151F347U, 0xE82985C0U, 0x9B8CEB35U, 0x562848C8U,
+            0x95E962CAU, 0x7B24C2CCU, 0x92A9AA59U, 0x122540FAU, 0x5D7A3E42U, 0x988F5A82U, 0x032E6D56U, 0x820BDAACU,
+            0x5F058808U, 0x0E848DBAU, 0x2BBADE1FU, 0x8D23B72BU, 0xAC31DAF7U, 0x23755665U, 0x3DFBE081U, 0x9A824856U,
+            0x82927689U, 0x94E6A9F2U, 0x53277599U, 0x89800C95U, 0x80ECE7C7U, 0x0580BBF4U, 0xBAD5B6BEU, 0x2C634B3DU,
+            0xC60CD9B2U, 0x25A9DE79U, 0x29FC6046U, 0x9F9618C5U, 0xEB91A027U, 0xA5E124CBU, 0x0C13FA1CU, 0x140D4FB5U,
+            0xBB1F4A4CU, 0x7FD112F1U, 0xCAC51398U, 0xFE1EDE65U, 0x3D268B09U, 0x79E19E2FU, 0xABA8DCC7U, 0x05ABFFCFU,
+            0xB10BE924U, 0x3CB2EF38U, 0x283E0A71U, 0x272A7FA0U, 0xD6F18997U, 0x6EBDF76EU, 0xAA64F1A8U, 0xD8A74F2BU,
+            0xAC645E0FU, 0x901379CFU, 0x0B4BCC58U, 0x65BB920AU, 0xE0B0528CU, 0xE4EE7F59U, 0x1253072FU, 0xABC36E5EU,
+            0x2F6F7C87U, 0x73F379FFU, 0x2D711CF4U, 0xBAFD4719U, 0x64D15587U, 0x73B8C7D6U, 0x6FC3CF26U, 0xD2624632U,
+            0xC80533C6U, 0x72CF62B6U, 0x2270D9DBU, 0x11237B85U, 0x9DC354D4U, 0x8123D599U, 0x89520835U, 0x563A962BU,
+            0x58684C11U, 0x6AE848BEU, 0x2CB376C3U, 0x0241207CU, 0x59B17C37U, 0xB8E41473U, 0xC9B4C492U, 0x1EC846ACU,
+            0xDF7E2785U, 0x9D0D0988U, 0xE3FE061BU, 0x8A8637EAU, 0x40558D51U, 0x1C2C34EFU, 0x30A9D3DDU, 0xF85207BAU,
+            0xC1611DABU, 0x41C51B7DU, 0x2EF5C89AU, 0x10F48F92U, 0x1E1106E7U, 0x3E7066DDU, 0xF85CDE0FU, 0x9047414FU,
+            0xE6F31B40U, 0x763AB28BU, 0x7A1C601AU, 0xFD18E51AU, 0xFD9FE19FU, 0x604D1134U, 0x21D4B9A4U, 0xD19AB348U,
+            0xB6662D3DU, 0x58DE2A3CU, 0x2F37A2ADU, 0xA848E8F7U, 0x23712F57U, 0xF52CB578U, 0x5E2BD5BBU, 0x5CED41D1U,
+            0xF1880F03U, 0x99F8D9B5U, 0xBB92BFDAU, 0x66BDA975U, 0x2009381AU, 0xFD42F042U, 0x982F624CU, 0x7FF222D9U,
+            0x76DC4190U, 0xF0794F05U, 0x709A8DC0U, 0x9B14583DU, 0x58F35849U, 0x0F580A6CU, 0x440B7579U, 0x299DC2EDU,
+            0xDE920307U, 0x9EBA07A0U, 0xD64819EFU, 0x3063B7F0U, 0xBD8D91ABU, 0x41B9F7F1U, 0xCAFB7B7DU, 0x2E7EF6FAU,
+            0x01DB7106U, 0xE9627E44U, 0x7158E7F7U, 0x23A83F58U, 0x659371F9U, 0xC404D9C9U, 0xE27C7ECDU, 0xE537C273U,
+            0xC9E91744U, 0x71786C9EU, 0x17C6C62FU, 0xABC6FB9FU, 0x601B482EU, 0xDCB61687U, 0x7300A095U, 0x8016676BU,
+            0x98D220BCU, 0xC24F2D87U, 0x731E59AEU, 0x311D90B6U, 0x22330B29U, 0x4290AB67U, 0xD3946450U, 0x6BB8C590U,
+            0xF0642B81U, 0x9A4FD79DU, 0x8E24A02EU, 0xDC58296FU, 0xDDD124E0U, 0xA0D7335CU, 0x627DCAECU, 0xA9DED399U,
+            0xEFD5102AU, 0xDB541CC6U, 0x72DC3399U, 0x89A1F7D3U, 0x1F532299U, 0x89CC78C2U, 0x75E36FE4U, 0xA712C50EU,
+            0xE71F3FC2U, 0x758DBCA3U, 0x4FAA7FEEU, 0x47FD6500U, 0x0047FD65U, 0x3DD8D22AU, 0xDB861104U, 0x07B64208U,
+            0x71B18589U, 0x94158A01U, 0x7793251CU, 0x1476CF6AU, 0xAD73FE89U, 0x94C9487AU, 0xB044516AU, 0xADD7CC17U,
+            0x837E520BU, 0x9751A7DAU, 0x66916A6DU, 0x33658C8FU, 0x7D34FB3DU, 0x581578EAU, 0x40871E1EU, 0xFA4FBA7DU,
+            0x06B6B51FU, 0x8D0EBB40U, 0x76514F2BU, 0xACCAA80FU, 0x9013D739U, 0x5F959BDFU, 0x16335ADEU, 0x617DCC89U,
+            0x94054648U, 0x7893CCE4U, 0xA71FB5ADU, 0xA8C0C0E0U, 0xA0A222B8U, 0xC51A999CU, 0xF97CC5F6U, 0x54272BECU,
+            0x9FBFE4A5U, 0xA623E883U, 0x7417F172U, 0xBE7F07E1U, 0xD7B3ADE9U, 0xD901E971U, 0x27DB4043U, 0xEFF2CB6AU,
+            0xAD887A8DU, 0x93A477E7U, 0x3EFDD3ACU, 0xDF5E1210U, 0x1D684E76U, 0xB97BBC47U, 0xE801AF8FU, 0x7DEF9F1EU,
+            0xE8B8D433U, 0xBF38D9C2U, 0x75D59B45U, 0x06C36084U, 0xEAD38459U, 0x125D3AD4U, 0x81AC4BF7U, 0x2358CBF4U,
+            0xBAF36ECEU, 0x7C661CD9U, 0xFF730C6CU, 0x44FB5E7FU, 0xC0FE97F3U, 0x24745D31U, 0x51FA7467U, 0xD3870E8FU,
+            0x7807C9A2U, 0x38A0C50DU, 0x7E89DC78U, 0x5EA070D2U, 0x68831388U, 0xE30B8801U, 0x77E43B1EU, 0xFA78D958U,
+            0x654AA11FU, 0x8D6D4754U, 0x6C8BF8AAU, 0x366FC10EU, 0xE78E42C6U, 0x72E0E9C7U, 0x0572B7FAU, 0x5D6D69B5U,
+            0x0F00F934U, 0x21BBF44CU, 0x7F4BB64FU, 0xE61C17B7U, 0x55E33A38U, 0x28575BA4U, 0xD19330AAU, 0x36D2D9C6U,
+            0x7231B55CU, 0x62AF2C6AU, 0xAD05276AU, 0xADCA8D61U, 0x3A189B43U, 0xEFEF08B1U, 0xBC896C12U, 0xF305F824U,
+            0x9609A88EU, 0x0A96A78FU, 0x7D0D0816U, 0xF4A9B859U, 0x124340E8U, 0xAEC3290AU, 0xE07B2A37U, 0xB85DDE25U,
+            0x4BBC8999U, 0x89989769U, 0x34E7416BU, 0xDA545F91U, 0x87D2F78DU, 0x938E2D6AU, 0xADF4066BU, 0xDACD4CD6U,
+            0xE10E9818U, 0x138D96CEU, 0x7CCF6221U, 0x4C15DF3CU, 0x2F236958U, 0x659FFAAFU, 0x460C2183U, 0x74F7DEBBU,
+            0x5CC79DDAU, 0x665AFC57U, 0xF5699EABU, 0x41F113FEU, 0x5A442E08U, 0x0E81CC1CU, 0x140FDD83U, 0x74A5DD47U,
+            0x7F6A0DBBU, 0x5CCC0009U, 0x798074A4U, 0xD1C2E785U, 0x9D03B548U, 0x789ACA17U, 0x83AB1F0DU, 0x7E32D7A2U,
+            0x38A6F013U, 0x8486E72EU, 0xDC528B28U, 0x3569FA71U, 0x27372850U, 0x6B4C66DCU, 0x8F0ED299U, 0x895C2532U,
+            0x086D3D2DU, 0x45D73148U, 0x78421E93U, 0x697E80E0U, 0xA0639CF8U, 0xB3C619B2U, 0x25DC14B9U, 0xB298D73CU,
+            0x2FDDE450U, 0x6B448C10U, 0x1DDC54E8U, 0xAECCB61EU, 0xFAA1F1D5U, 0xF64387AAU, 0x36F50971U, 0x2734B4A3U,
+            0x91646C97U, 0x6EFA628BU, 0x7A04A0CAU, 0x7BCB2F0EU, 0xE7C3E628U, 0x35526B1CU, 0x14340E24U, 0x3C17D0DFU,
+            0x1650D895U, 0x80733713U, 0x843E32E9U, 0xD95264EEU, 0x476B9D1BU, 0x8A22A271U, 0x27886308U, 0x0EFC0051U,
+            0xE6635C01U, 0x77E153CAU, 0x7BC6CAFDU, 0xC377486BU, 0xDAA3CF98U, 0xFE0EB8B9U, 0xB2430590U, 0xF0BDD041U,
+            0x012BCCD6U, 0x6FB15C2DU, 0x45B0ED29U, 0x42F72881U, 0x9AFD449EU, 0x172D4307U, 0x9E73B8E0U, 0xA09491C0U,
+            0x6B6B51F4U, 0xBABB5D54U, 0x6CBC2EB0U, 0xCB0D0FA2U, 0x3813CFCBU, 0x0C8E08F7U, 0x23D5E9B7U, 0x5526F3C6U,
+            0x72524176U, 0xB9148648U, 0x78BEDD24U, 0x3C7B5A0CU, 0x098A3771U, 0x270BCB9DU, 0x8E99E432U, 0xC859C864U,
+            0x1C6C6162U, 0xA3A06C15U, 0x6D7E4487U, 0x73B168C7U, 0x0573E67BU, 0xC7D2DB52U, 0x85A2E203U, 0x998CF358U,
+            0x65295535U, 0x56D6ED76U, 0xB93002E4U, 0xA7DE1663U, 0xD41CEEF4U, 0xBA042AEBU, 0x37623FDAU, 0x663159F5U,
+            0x856530D8U, 0x888D3FD6U, 0x6F38FADEU, 0x6104C729U, 0x42D39CABU, 0x4146A9FCU, 0xB44AF89EU, 0x1703F4BBU,
+            0x5CA469F0U, 0xBDE15675U, 0x20D264E5U, 0xD040C493U, 0x69D6823AU, 0xC6650F30U, 0x261F55A3U, 0x4FF9ED07U,
+            0xF262004EU, 0x91960E97U, 0x6EFA90E9U, 0xD9B8A04CU, 0x7FB3B51BU, 0x8A1A7A59U, 0x123DF32AU, 0xDBA9F425U,
+            0x4BDF7DB3U, 0x52233D4BU, 0xE15CBB25U, 0x4BE588FCU, 0xB4405BBFU, 0x5B6AEE46U, 0x9FE48E4BU, 0xE1917C96U,
+            0x6C0695EDU, 0xDED79850U, 0x6BB5866CU, 0x446F98F5U, 0xCD93690BU, 0x971F4AE1U, 0xD79ACDA4U, 0xD16CFD3CU,
+            0x2FBE107AU, 0xB0FF2632U, 0xC867AEA6U, 0x3F7D6173U, 0xC9335DE7U, 0x3EA74486U, 0x04E58151U, 0x1C6884E3U,
+            0x1B01A57BU, 0xC7CCA911U, 0x6A77EC5BU, 0xFCD3FF90U, 0xF0F340BBU, 0x5C439944U, 0x71EDC610U, 0x1DC6FDA2U,
+            0x38C50439U, 0x5F3D4D0CU, 0x09E97166U, 0xA4D82D1CU, 0x14A58462U, 0xA3A8A5F0U, 0xBD1E5AB9U, 0xB2001572U,
+            0x8208F4C1U, 0xECE1FAD2U, 0x68315202U, 0xEE66507EU, 0xB7533A6BU, 0xDAD7EBEAU, 0x4005DC8DU, 0x9349FA41U,
+            0x014838FCU, 0xB40AF60FU, 0x900B1767U, 0xD346FFECU, 0xA96FE8ACU, 0xDFC9802BU, 0xAC6330C0U, 0x9BC8A180U,
+            0xF50FC457U, 0xF5FACB93U, 0x69F33835U, 0x56DA371BU, 0x8A3313DBU, 0x118B384FU, 0xE672D739U, 0x5FE3FADFU,
+            0x16332CBFU, 0x5BC89D31U, 0x5185C8A7U, 0x48E3B383U, 0x74F93129U, 0x42C6615DU, 0x1598EB28U, 0x35A03011U,
+            0x65B0D9C6U, 0x7262D75CU, 0x62AF7F08U, 0x0EB9274DU, 0x0863840AU, 0xE0DD8A9AU, 0x103AA7D0U, 0x86C3E873U,
+            0xC98AE36EU, 0xAAC3C6BCU, 0xC27D3C61U, 0x3A772CF2U, 0x5389E41CU, 0x1452D5ABU, 0x411028B5U, 0xBB4A572BU,
+            0x12B7E950U, 0x6B79E61DU, 0x636D153FU, 0xB6054028U, 0x3503ADBAU, 0x2B81593FU, 0xB64DAC64U, 0x4A69E8EDU,
+            0xDEF1F72DU, 0x4501AD82U, 0x03F3E3A1U, 0xA1D2609DU, 0x8E1F3D99U, 0x895D34DDU, 0xF8EBF35DU, 0x1522C6BAU,
+            0x8BBEB8EAU, 0x4054B5DEU, 0x612BAB66U, 0xA4B0EFC6U, 0x72A3D76AU, 0xAD152B91U, 0x87A5B6F9U, 0xC4E6EF0EU,
+            0xE77CCBE8U, 0xAE361681U, 0x9A1185A0U, 0xD64CB26DU, 0x33D55157U, 0xF53C1106U, 0xE9969924U, 0x3CEA7248U,
+            0xFCB9887CU, 0x594F849FU, 0x60E9C151U, 0x1C0C88A3U, 0x4FC3FEDAU, 0x6649F834U, 0x21D2BD4DU, 0x084CEF90U,
+            0xF007DFABU, 0x41F47DBFU, 0x5B9F5A60U, 0x4DE9FE02U, 0xEE4388D2U, 0x6833F070U, 0x506D42CCU, 0x9282E3D9U,
+            0x62DD1DDFU, 0x160E1258U, 0x65A6D7D4U, 0x81DBB01AU, 0xFDE322CAU, 0x7B4CC88CU, 0xE47583C3U, 0x0289E689U,
+            0x9466B262U, 0xA32866C6U, 0x72A44FE3U, 0x3971178DU, 0x93308E8AU, 0x0DFE5AB0U, 0xCB6C4DD6U, 0x6F7B1BACU,
+            0x15DA2D49U, 0x0F152319U, 0x6464BDE3U, 0x3967D77FU, 0xC0830B7AU, 0xB0101B29U, 0x42028877U, 0xCE23E617U,
+            0x831DA621U, 0x4CEA0DF8U, 0xB32A9023U, 0xA2D45BE2U, 0x4EA6570FU, 0x90F1BBC6U, 0x7297963EU, 0xC1138A3DU,
+            0x8CD37CF3U, 0x243870DAU, 0x662203BAU, 0x2BD27891U, 0x872371AAU, 0x36846987U, 0x73EA92EAU, 0x40ACE1F4U,
+            0xBA909AE4U, 0xA7DDB6FBU, 0x2AC8F622U, 0xD54A8912U, 0xF36C3BC1U, 0xEC909E1DU, 0x63EAFC47U, 0xE8DB3ECFU,
+            0xFBD44C65U, 0x3D23419BU, 0x67E0698DU, 0x936E1FF4U, 0xBA43581AU, 0xFDD8BA22U, 0xD59D995EU, 0x8C06E16AU,
+            0xADEB8EA7U, 0x481FDDC5U, 0xEB4629E2U, 0x4EEFC57DU, 0x2EFAE244U, 0x719F7F6BU, 0xDA1127AFU, 0x46B3AF5EU,
+            0x4DB26158U, 0x65FD6BA7U, 0x48D7CB20U, 0x3B26F703U, 0x9932774DU, 0x08F40F5AU, 0x8BB64CE5U, 0xD0EBA0BBU,
+            0x5C6381A4U, 0xD1E70470U, 0x50D49638U, 0x28526C08U, 0x0EF3DA5EU, 0x8CDD8F29U, 0x423E45E3U, 0x39418D87U,
+            0x3AB551CEU, 0x7CE65AE6U, 0x4915A117U, 0x839A9066U, 0xA4525EFDU, 0xC3A8DCFFU, 0x2DC14751U, 0x1C41A025U,
+            0x4B1895E7U, 0x3E256F4EU, 0x915A49F8U, 0xB3F72067U, 0xD36503DBU, 0x11D26E5FU, 0xFBC59E0BU, 0x97291C16U,
+            0xA3BC0074U, 0x57CB0925U, 0x4B531F4EU, 0x912F3F88U, 0xE3F2242DU, 0x453CAE51U, 0x1C295DCCU, 0x92CEA7C6U,
+            0x7295A922U, 0xD512D44DU, 0x08B82FF9U, 0xC469F297U, 0x6EAF6F15U, 0x6DB34B84U, 0xEAB8F472U, 0xBEE1A8E4U,
+            0xD4BB30E2U, 0x4ED03864U, 0x4A917579U, 0x299358EDU, 0xDE920D9DU, 0x8E607DF4U, 0xBA5E5678U, 0x5E64A758U,
+            0x65EEBD61U, 0x3AD0BF73U, 0xC936F039U, 0x5FCCBEF8U, 0xB339B690U, 0xF0BCAAF2U, 0x53432F9AU, 0x10893975U,
+            0x4ADFA541U, 0x0191AEA3U, 0x4FDE63FCU, 0xB4446054U, 0x6CB2D18DU, 0x93654D4CU, 0x7FF968F6U, 0x54A1AE41U,
+            0x018FD0A8U, 0xD80CA40AU, 0xE00DE5BAU, 0x2B545777U, 0xCE4AB0C8U, 0x95710032U, 0xC8422080U, 0xED70C100U,
+            0x3DD895D7U, 0x188A9FE2U, 0x4E1C09CBU, 0x0CF80731U, 0x51D2F83DU, 0x58399EE9U, 0xD98E6342U, 0x980BAEDFU,
+            0x16F4C4EBU, 0x37CECF34U, 0x21833A7AU, 0xB0F11B18U, 0x13DC694DU, 0x087EE144U, 0x71B9FB68U, 0x43185091U,
+            0xA4D1C46DU, 0x33A7CC21U, 0x4C5AB792U, 0x1E4DA8DFU, 0x167282EDU, 0xDEADEC47U, 0xE86679DFU, 0x1684A93CU,
+            0x2F79F82EU, 0xDCF97437U, 0xB8615C7BU, 0xC76FC9E8U, 0xAE160583U, 0x741FC49FU, 0x60C49111U, 0x6AD0E463U,
+            0xD3D6F4FBU, 0x2ABCFD60U, 0x4D98DDA5U, 0xA6F1CFBAU, 0x2B12AB5DU, 0x15F13FE2U, 0x4E11726BU, 0xDA2EA9A2U,
+            0x3802EC6DU, 0x333B1F09U, 0x79EF83BBU, 0x5CCA8587U, 0x7380DC06U, 0xE91025E9U, 0xD93F4AF9U, 0xC4B875F2U,
+            0x4369E96AU, 0xAD24E1AFU, 0x46C49A98U, 0xFE92DFECU, 0xA9423C8CU, 0xE4A78D37U, 0xB8590282U, 0x030EBB0EU,
+            0xE7BB23BCU, 0xC2304484U, 0xEA17777DU, 0x2E5E1AF6U, 0x54F00933U, 0xBF84911FU, 0x8DB78964U, 0x4A5212C8U,
+            0x346ED9FCU, 0xB43FD0EEU, 0x4706F0AFU, 0x462EB889U, 0x9422153CU, 0x2FFB5E92U, 0x1E2E0936U, 0xCFA4BB90U,
+            0xF0C037FFU, 0x2DF22FBAU, 0x2B99A8BDU, 0xB5FB5699U, 0x8966D0B6U, 0x228B7069U, 0x344C528CU, 0xE43A8359U,
+            0xAD678846U, 0x9F12832DU, 0x45404EF6U, 0x549B1767U, 0xD3826FECU, 0xA96F2C3CU, 0x2FC613ABU, 0x412BBC73U,
+            0xC94D0B3AU, 0xC6C594B9U, 0xB27BCEBCU, 0xC2658469U, 0x34ACBC78U, 0x5EEA55B2U, 0x253138F5U, 0xCDF237ABU,
+            0xDA60B8D0U, 0x8609B26CU, 0x448224C1U, 0xEC277002U, 0xEEE2465CU, 0x6233FF99U, 0x89B1181FU, 0x8D81BCEDU,
+            0xDE361F79U, 0x2907FF87U, 0x73F5117CU, 0x59C0C806U, 0xE93A65FDU, 0xC3E5B4C4U, 0x9CCAE31DU, 0x639AA63AU,
+            0x44042D73U, 0xC94824ABU, 0x41CD3244U, 0x71F048BBU, 0x5CC29A4CU, 0x7F36CF21U, 0x4C162691U, 0x8744B5F4U,
+            0xBA5772B0U, 0xCBDBE4FEU, 0x5ACE04FFU, 0x2D582189U, 0x944963A5U, 0xA6281E04U, 0x07CBEC07U, 0x9E635E4FU,
+            0x33031DE5U, 0xD05315EAU, 0x400F5873U, 0xC94C2FDEU, 0x61A2B3FCU, 0xB46A1C84U, 0xEA612D25U, 0x4BEEB56AU,
+            0xAD2C66F3U, 0x24198FC0U, 0x9B40DB3FU, 0xB6FD6DE6U, 0x49DFBA20U, 0x3B27FF72U, 0xBE3037EFU, 0x300BCFDEU,
+            0xAA0A4C5FU, 0xFB7E4629U, 0x4249E62AU, 0xDBF98030U, 0x2602C92CU, 0x32FE6E2AU, 0xDB8937B8U, 0xC561B289U,
+            0x94A15A36U, 0xCF2E34C3U, 0x02A2BD3EU, 0xC163BF16U, 0xF415D6EEU, 0x4746DAA9U, 0xAF4D5D96U, 0x19C37B2CU,
+            0xDD0D7CC9U, 0xE2657768U, 0x438B8C1DU, 0x6345E755U, 0x1B62E09CU, 0xF9A2BD8FU, 0x7DFE3C0CU, 0x09CBB217U,
+            0x83DA4E75U, 0x20EC5FFDU, 0xC32C62FEU, 0x5AC6F379U, 0x29830F6BU, 0xDA493BDFU, 0x16B6867EU, 0xB7ABEABDU,
+            0x5005713CU, 0x2F3F79F6U, 0x54F16850U, 0x6B3FA09CU, 0xF9D2E0CFU, 0x0B220DC1U, 0xEC68D02BU, 0xAC509190U,
+            0xF0A3C3D5U, 0xF6498598U, 0xFE2252F3U, 0x244A81F4U, 0xBAF47C84U, 0xEA6FB345U, 0x065CDAACU, 0xDF66B319U,
+            0x270241AAU, 0x362448B7U, 0x55330267U, 0xD383C7F9U, 0xC4B2C97FU, 0xC07EDE64U, 0x4A1FDB9FU, 0x60FA910EU,
+            0xE7D8D796U, 0x198BEEA6U, 0x3FAC8D33U, 0xBFEFCD9BU, 0x6762A501U, 0x77605233U, 0xBFA70144U, 0x710E2288U,
+            0xBE0B1010U, 0x1D091B74U, 0x5775BC3EU, 0xC1366817U, 0x8312B3AFU, 0x46EAACCAU, 0x7BF7C102U, 0xEE7596EDU,
+            0xDE55EB53U, 0xF2BC55A5U, 0xA64EEB32U, 0xC8711F6BU, 0xDAA8C9CFU, 0x0B0177E8U, 0xAEDA6B3DU, 0x58C6967AU,
+            0xC90C2086U, 0x04122A35U, 0x56B7D609U, 0x798A0F72U, 0xBE729A1FU, 0x8DB67F6FU, 0xDD80CAB6U, 0x22DF9673U,
+            0xC92EFF10U, 0x1D7E3E9BU, 0x67C034F2U, 0x53D45304U, 0x073E104AU, 0x960E969EU, 0x1721B0D5U, 0xF6AE07EBU,
+            0x5768B525U, 0x4B53BCF2U, 0x53F8C08CU, 0xE45D37CBU, 0x0C52460FU, 0x90B34FD7U, 0x1827F438U, 0x281A9F6AU,
+            0xAD4F92D9U, 0xFFA225E2U, 0x4EFB2171U, 0x274CBA8BU, 0x7A4D1612U, 0xF3C33C5EU, 0x8C20BFCFU, 0x0B57FF9EU,
+            0x206F85B3U, 0x52488DB3U, 0x523AAABBU, 0x5CE150AEU, 0x31326FBFU, 0x5BEF9C72U, 0xBE50FF8CU, 0xE4B09FF4U,
+            0xBA34869AU, 0x10604EDCU, 0x8F75FEB1U, 0xBCE9F6E4U, 0xA7DBCF97U, 0x6ECCDD28U, 0x35DB6427U, 0xA53F6E0FU,
+            0xB966D409U, 0x7965DE70U, 0x507C14E2U, 0x4E54FF40U, 0x7692156FU, 0xDD7BEEDCU, 0x8FB8E511U, 0x6A3F9817U,
+            0x83B9BA5FU, 0xFB57F5DFU, 0x169798B0U, 0xCB772414U, 0x1A11A359U, 0x12ADF8F3U, 0x24A60E5EU, 0x8CF7DAFDU,
+            0xCE61E49FU, 0x607EEF31U, 0x51BE7ED5U, 0xF6E89825U, 0x4BF23CDFU, 0x16273D79U, 0x29CFEEA5U, 0xA6959889U,
+            0x94C2AE1CU, 0x14959EE1U, 0xD7194770U, 0x50D2687BU, 0xC7877ADCU, 0x8FA21985U, 0x9D5DD5B6U, 0x229F4B6CU,
+            0x5EDEF90EU, 0xE7E6F3FEU, 0x5AE239E8U, 0xAE8B8873U, 0xC9A2AB0EU, 0xE7718FACU, 0xDF879E4CU, 0x7FB58A25U,
+            0x4B7B61CDU, 0xE59EC56CU, 0x44E1B3B6U, 0x2246F70AU, 0xE0F7AFE9U, 0xD936AD73U, 0xC9D5162BU, 0xAC752C56U,
+            0x29D9C998U, 0xFEFDC2BFU, 0x5B2053DFU, 0x1637EF16U, 0xF4C282BEU, 0x2C2D5C09U, 0x79F095F8U, 0xB31F8ABBU,
+            0x5C00758EU, 0x0A5CAE52U, 0x856F6C76U, 0xB9E3BB65U, 0x3D61766CU, 0x44394C05U, 0x702ECDC3U, 0x021DBDC7U,
+            0xB0D09822U, 0xD5D0917CU, 0x5966ED86U, 0x048240F8U, 0xB362F86EU, 0xAAB92EA7U, 0x48188F65U, 0x3D908D58U,
+            0x658D494BU, 0xE16B1551U, 0x1C8D0A77U, 0xCE7D6995U, 0x80AB1AA2U, 0x385869DEU, 0x6153A7BAU, 0x2BD50935U,
+            0xC7D7A8B4U, 0xCCCBA03DU, 0x58A487B1U, 0xBC3E279DU, 0x8E02D1DEU, 0x61E5FD02U, 0xEE6F84D1U, 0xF13A8DC6U,
+            0x72F65D08U, 0x0EA97E6FU, 0xDD03D5B7U, 0x55D825FAU, 0x5D3DC327U, 0xA55788A8U, 0xD8A87C52U, 0x85BD98A4U,
+            0x59B33D17U, 0x838A36FAU, 0x5DEB9134U, 0x21E91F24U, 0x3C220DCEU, 0x7CE0CDBAU, 0x2BC8BA5FU, 0xFBFF84DFU,
+            0x169730C1U, 0xEC756516U, 0xF438C034U, 0x2140CC75U, 0x204EC57FU, 0xC09A2268U, 0x43A97348U, 0x784460D1U,
+            0x2EB40D81U, 0x9A9107BBU, 0x5C29FB03U, 0x99557841U, 0x0142247EU, 0xB7BC1E1FU, 0x8DBFB1EBU, 0x37558441U,
+            0x01EC2482U, 0x03B70E28U, 0x35B61FF4U, 0xBAE5801AU, 0xFDD81CFAU, 0x5D95C31EU, 0xFA52A8A0U, 0xD62CF140U,
+            0xB7BD5C3BU, 0xB1BC5478U, 0x5E6F455AU, 0x8BE0D7AFU, 0x46E25EAEU, 0x31286CB1U, 0xBC57AB76U, 0xB9DA83A2U,
+            0x38611847U, 0xE880B52BU, 0xAC5479F5U, 0xCD7B52EAU, 0x40127034U, 0x21F4E6C5U, 0xEB2FC2D9U, 0xFFE445B2U,
+            0xC0BA6CADU, 0xA8A76539U, 0x5FAD2F6DU, 0x335CB0CAU, 0x7B82771EU, 0xFA74BF14U, 0x1A20A0C2U, 0x7570833CU,
+            0x2F1A0C04U, 0x0742DE15U, 0x6DDAA635U, 0x56DE1E85U, 0x9D84A9B1U, 0xBCFB07B3U, 0x52D41931U, 0x518CD423U,
+            0xEDB88320U, 0x3B83984BU, 0xE1351B80U, 0xED59B63BU, 0xB1E6B092U, 0x1EB014D8U, 0x8816EAF2U, 0x533B85DAU,
+            0x6655004FU, 0xE6050901U, 0x77E1359FU, 0x60C76FE0U, 0xA06A2517U, 0x8373EFE2U, 0x4E87F0BBU, 0x5CFDEDF4U,
+            0x9ABFB3B6U, 0x2298A90AU, 0xE0F771B7U, 0x55E5D15EU, 0x8C869922U, 0xD5ECC77DU, 0x2E61E146U, 0x9F918544U,
+            0x712E140CU, 0x09C7623FU, 0xB66FEA5FU, 0xFB62238FU, 0x7DFCFC92U, 0x1E7C0E94U, 0xF77C2B53U, 0xF2957C65U,
+            0x03B6E20CU, 0x09B5FAC9U, 0xE2B1CFEEU, 0x47507EB0U, 0xCB26E3F2U, 0x5378B5D3U, 0x1F89FBDBU, 0x111E82A7U,
+            0x48A328C9U, 0xE2F0D93CU, 0x2F8D8C5EU, 0x8CFCF17FU, 0xC036905CU, 0x621D2B4FU, 0xE601412AU, 0xDB5DC897U,
+            0x74B1D29AU, 0x10AECB88U, 0xE373A5D9U, 0xFFEC19D5U, 0xF646CA42U, 0x98246676U, 0xB9FEF06FU, 0xDDB48239U,
+            0x5FD83C8AU, 0x0D32B202U, 0xEE03539EU, 0x1759BD10U, 0x1DA049D9U, 0xFF12CA39U, 0x5FFA9AC2U, 0x75355906U,
+            0xEAD54739U, 0x5FEF5D4FU, 0xE63CB35CU, 0x623B216CU, 0x44661652U, 0x852156CEU, 0x7C59CEE1U, 0xD7718B20U,
+            0x3BB95143U, 0xEFEEA97BU, 0xC738461DU, 0x63C1549FU, 0x60D34F81U, 0x9ADF60F9U, 0xC4FB95D8U, 0x88CCA173U,
+            0x9DD277AFU, 0x46F46C0EU, 0xE7FED96BU, 0xDA874609U, 0x79063FE2U, 0x4E7D856BU, 0xDA2EC555U, 0x1BDB8BBEU,
+            0x2CC24500U, 0x002CC245U, 0x06B699DDU, 0xF86418F0U, 0xBD459604U, 0x07D0818FU, 0x7D004E30U, 0x26A430E2U,
+            0x04DB2615U, 0x6DD93FCDU, 0xE5B86732U, 0xC832E9E7U, 0x3EA64532U, 0xC8E9F7C5U, 0xEBC6DFC8U, 0x95548C5DU,
+            0x154F79C5U, 0xEB1B7946U, 0x9F54FFDCU, 0x8FFACA00U, 0x008FFACAU, 0x7BB1A454U, 0x6C7D2449U, 0x0F6C8410U,
+            0x73DC1683U, 0x74C20E8CU, 0xE47A0D05U, 0x708E8E82U, 0x03C66C82U, 0x03B52460U, 0x4DB1D47CU, 0x59FE8CC3U,
+            0x02346D86U, 0x04D91278U, 0x5EDA201CU, 0x145F866FU, 0xDD19234FU, 0xE6BE4522U, 0xD586FFA1U, 0xA1041581U,
+            0xE3630B12U, 0xF35A1243U, 0xEF264A38U, 0x28ED9ED4U, 0x8196FB53U, 0xF2E396B5U, 0xBBF9A495U, 0x80DE9E6FU,
+            0xDD8DA257U, 0xF5D249F5U, 0xCD22D4DAU, 0x66CB191EU, 0xFA69F67AU, 0xB02AF1D4U, 0x810E3C3CU, 0x2FEE72BBU,
+            0x94643B84U, 0xEA412302U, 0xEEE4200FU, 0x9051F9B1U, 0xBCF6D2E3U, 0x39BF4510U, 0x1D8EAF21U, 0x4C749EF1U,
+            0xCAF6B614U, 0x1A1022CBU, 0x0CAC0B1AU, 0xFD6E5571U, 0x27FF2FFFU, 0x2D2510A2U, 0x38F5E7D4U, 0x8186E32AU,
+            0x0D6D6A3EU, 0xC16C70C1U, 0xECA29E56U, 0x82E4565FU, 0xFB56A833U, 0xBF2B37BEU, 0x2C66B5BCU, 0xC2FB9912U,
+            0xF37B8AD1U, 0xF12799C8U, 0x954E6D1BU, 0x8AF08781U, 0x9A354331U, 0x51443579U, 0x29888DADU, 0xA84E57D8U,
+            0x7A6A5AA8U, 0xD8774180U, 0xED60F461U, 0x3A58313AU, 0xC6368183U, 0x7477E41BU, 0x8A11BE08U, 0x0E51998CU,
+            0xE4009E92U, 0x1EE5F2F6U, 0x54C0B2DBU, 0x1155CBEEU, 0x47A39AB4U, 0xCC4BD40FU, 0x90735645U, 0x0626C649U,
+            0xE40ECF0BU, 0x9736D747U, 0xE82FE2E4U, 0xA78F0983U, 0x74165D93U, 0x6972D4A3U, 0x4FB68086U, 0x04949095U,
+            0x8061F35BU, 0xFC39E98FU, 0x7DFBA758U, 0x65CD2261U, 0x3AD09CECU, 0xA9867ECFU, 0x0B72595FU, 0xFBDF3E3CU,
+            0x9309FF9DU, 0x8E2DE606U, 0xE9ED88D3U, 0x1F336EE6U, 0x49767423U, 0xA22E0706U, 0xE9C18B32U, 0xC83E900BU,
+            0x971AE718U, 0x13FB82B1U, 0xBC757898U, 0xFE686E0EU, 0xE7464569U, 0x34899FB9U, 0xB28982B7U, 0x55B7AFADU,
+            0x0A00AE27U, 0xA500B5C5U, 0xEBAB368AU, 0x0D86C108U, 0x0ED60EF3U, 0x24BA75A8U, 0xD82991AFU, 0x46B197E8U,
+            0xAE97DBDDU, 0xF8CC39B2U, 0x25971E99U, 0x89F6BCFEU, 0x5A8C29A7U, 0x48E8BA62U, 0xA3F4E8CEU, 0x7C7F1B5FU,
+            0x7D079EB1U, 0xBC1B8484U, 0xEA695CBDU, 0xB53AA66DU, 0x33B62743U, 0xEFE6A60DU, 0x7E5E9A1BU, 0x8A1B9776U,
+            0xB9ECCF9EU, 0x170E528CU, 0xE419C159U, 0x1253F091U, 0x871AF022U, 0xD5E75B14U, 0x1A0F3326U, 0xD2178ACEU,
+            0xF00F9344U, 0x71418A1AU, 0xFD13B8F0U, 0xBD40E1A4U, 0xD1062710U, 0x1D661643U, 0xEFC8763CU, 0x2F80B4F1U,
+            0xCA95423EU, 0xC1AB88E9U, 0xD917F154U, 0x6CDF821CU, 0x146D83CDU, 0xE5C1D38EU, 0x0AE56FF4U, 0xBADAD36AU,
+            0x8708A3D2U, 0x685ABB5BU, 0xFCD1D2C7U, 0x05FC86C1U, 0xEC660EA0U, 0xD63AC5E6U, 0x49BF7D88U, 0xE32AB46FU,
+            0xDDEE567DU, 0x2E69E3D7U, 0x18992E94U, 0xF77ACE73U, 0xC9FB5A48U, 0x78CE32F8U, 0xB31EB41CU, 0x14B242FBU,
+            0x1E01F268U, 0x4377E898U, 0xFE976C9EU, 0x1749292FU, 0xABC67470U, 0x50AEB748U, 0x78576715U, 0x6DA5B38CU,
+            0xE4636AB8U, 0xC55E58D4U, 0x817B4895U, 0x80E41C83U, 0x74313686U, 0x04AF1723U, 0xA263DE65U, 0x3D7AF609U,
+            0x6906C2FEU, 0x5A6CD9D9U, 0xFF5506A9U, 0xAFF54E4AU, 0x96A65DC0U, 0x9BF264EDU, 0xDE206CA1U, 0xA10FB312U,
+            0xF3187EFBU, 0x2A9C33EAU, 0x40F59755U, 0x1B4150ECU, 0xA9A7EF03U, 0x99A0F655U, 0x1B98058DU, 0x93126798U,
+            0xF762575DU, 0x152D4F1EU, 0xFA1A102CU, 0x322276F3U, 0x248681D0U, 0x86F75455U, 0x1B87522FU, 0xABCABA0BU,
+            0x97791332U, 0xC8402893U, 0x69CE82D6U, 0x6FD9B963U, 0xD4D4E95BU, 0xFC6D5C95U, 0x80990A97U, 0x6EEB9FEDU,
+            0x806567CBU, 0x0C367E5FU, 0xFBD87A1BU, 0x8A9E1196U, 0x19E6A860U, 0x4DAB87F0U, 0xBDF0599BU, 0x6760BA95U,
+            0x80020771U, 0x278243ADU, 0xA8405D16U, 0xF47CF50CU, 0x094230DEU, 0x6162BDE3U, 0x3962D17FU, 0xC0830E7CU,
+            0x196C3671U, 0x271B2D9CU, 0xF99EC442U, 0x982BBE78U, 0x5E46D2B0U, 0xCB3FF55EU, 0x8C184306U, 0xE9EFBD76U,
+            0xB98F3BB4U, 0xCCB5F8AEU, 0x31A23B17U, 0x83E227FCU, 0xB4885C10U, 0x1D039838U, 0x281FBB06U, 0xE94BBA8EU,
+            0x6E6B06E7U, 0x3E001CDDU, 0xF85CAE75U, 0x2097D91DU, 0x6326FB00U, 0x006326FBU, 0x2A6F48B2U, 0x2545BDE8U,
+            0xAEF42FF7U, 0x23779390U, 0xF02CE4D7U, 0x18476B93U, 0x691E8595U, 0x800C794EU, 0x91E460EEU, 0x47232B1FU,
+            0xFED41B76U, 0xB9980012U, 0xF300E948U, 0x78F4C94BU, 0xE1766CD1U, 0xF135942EU, 0xDC27385BU, 0xFC65AF44U,
+            0x714DE026U, 0xD27CC81DU, 0x63D41011U, 0x6AD3F4E2U, 0x4E6E50A0U, 0xD698CDB8U, 0xC56CA373U, 0xC9C94C25U,
+            0x89D32BE0U, 0xA0833153U, 0xF2C2837FU, 0xC048AE2EU, 0xDC164561U, 0x3A69478BU, 0x7A5033EFU, 0x30CFAFDAU,
+            0x6636F465U, 0x3DBEA323U, 0xA25ACFD1U, 0xF176B88DU, 0x93F88925U, 0x4B972CCEU, 0x7C97789BU, 0x67A1DDB4U,
+            0x10DA7A5AU, 0x8BAE6290U, 0xF0843D26U, 0xD2FD01C0U, 0x9BB63FB1U, 0xBCFD3525U, 0x4BB82972U, 0xBE40A839U,
+            0x5FBBC8A0U, 0xD6891820U, 0x3BB8A9D0U, 0x86E86A7DU, 0x2E32E5EBU, 0x37F60915U, 0x6DEA12E2U, 0x4E696946U,
+            0x67DD4ACCU, 0x92B553D1U, 0xF1465711U, 0x6A4166A5U, 0xA6D61601U, 0x77A1E680U, 0xEDCF22C6U, 0x72EAA8A7U,
+            0x48C0DCE3U, 0x394B731EU, 0xFA367610U, 0x1D4D2612U, 0xF3A43C6EU, 0xAAF9E863U, 0xD411C90AU, 0xE001F8D7U,
+            0xF9B9DF6FU, 0xDDF4C516U, 0xF4094194U, 0xF7965E1CU, 0x14F6CA11U, 0x6AA4D638U, 0x28681C48U, 0x782FA1BEU,
+            0x2CA1B12AU, 0xDB976867U, 0xD30D6393U, 0x69D5CF9DU, 0x8ED73A36U, 0xCF3442A3U, 0x4F10C610U, 0x1DF800A2U,
+            0x8EBEEFF9U, 0xC4EFF457U, 0xF5CB2BA3U, 0x4F2A3979U, 0x2996E3A1U, 0xA1F8059DU, 0x8E1F17FCU, 0xB485A120U,
+            0x3BDAA569U, 0x34550359U, 0x1283BC53U, 0xF27083F2U, 0x5341E3B3U, 0x523BA3D5U, 0xF6EB1DF8U, 0xB3909133U,
+            0x17B7BE43U, 0xEFC2A794U, 0xF78D95FAU, 0x5D9F9697U, 0x6E369971U, 0x276C7733U, 0xBFF70D61U, 0x3A0AA6C3U,
+            0x025799ACU, 0xDF62B85AU, 0x8B61DA52U, 0x85EE5102U, 0xEE8B8F7DU, 0x2E5A860EU, 0xE7967781U, 0x9A5825C1U,
+            0x60B08ED5U, 0xF6D996D5U, 0xF64FFFCDU, 0xE523F1F2U, 0x5356B0C1U, 0xEC30A496U, 0x198006D5U, 0xF6A0A65DU,
+            0x152C8DEFU, 0x30A0D364U, 0x4AEF0592U, 0x1E4B1D6DU, 0x331D56F8U, 0xB3556778U, 0x5E6DAC69U, 0x3430B450U,
+            0xD6D6A3E8U, 0xAE07BCE9U, 0xD9785D60U, 0x4D6B1905U, 0x70279F96U, 0x191C11EEU, 0x47ABD36EU, 0xAA4DE78CU,
+            0xE4A482ECU, 0xA9580AD1U, 0xF17DBA48U, 0x78F6B418U, 0x13146EE2U, 0x4E17973AU, 0xC642CE25U, 0x4BC29689U,
+            0xA1D1937EU, 0xB71C8DA8U, 0xD8BA3757U, 0xF5D77E60U, 0x4D47B626U, 0xD240C24BU, 0xE1DCD8DAU, 0x66E7E712U,
+            0xF3DF96AFU, 0x469A61EFU, 0x30F36588U, 0xE353F877U, 0xCE82B767U, 0xD318764CU, 0x7FB915CDU, 0xE5AA0718U,
+            0x38D8C2C4U, 0x9C31DE6BU, 0xDAFC890EU, 0xE762D18EU, 0x0AE7CCF6U, 0x54D4B0E5U, 0xD034C247U, 0xE868E0F1U,
+            0xCA52AA6AU, 0xADADDAECU, 0xA9110389U, 0x94CD2A87U, 0x7348DBA9U, 0xAF795397U, 0x6EC47FB4U, 0xCC62B3EAU,
+            0x4FDFF252U, 0x852AEF2AU, 0xDB3EE339U, 0x5FDEB6EBU, 0x3787E546U, 0x9F886340U, 0x7643C9F3U, 0x24C2E06FU,
+            0xDD29BE29U, 0x426FB1D2U, 0x689FDC49U, 0x0F6866E8U, 0xAEDE022CU, 0x3276B2E1U, 0xD73FA45CU, 0x620A227BU,
+            0xD1BB67F1U, 0xCA6B79EDU, 0xDE71F5BCU, 0xC2098E52U, 0x85A73956U, 0x828D53F8U, 0xB3E4F77DU, 0x2E07E976U,
+            0xB948D3E0U, 0xA0B3AAABU, 0x41A4C9CAU, 0x7BF08F67U, 0xD3AD0474U, 0x57BB1821U, 0x4C3EAB46U, 0x9FF3DA0EU,
+            0xA6BC5767U, 0xD37048ACU, 0xDFB39F8BU, 0x7AB5E937U, 0xB8C710E6U, 0x49D1805DU, 0x1593FCC9U, 0xE2ADE9E8U,
+            0xAE33C7A3U, 0x4F71C195U, 0x802A160AU, 0xE055C308U, 0x0E3BDDF1U, 0xCAB4F957U, 0xF5C570AEU, 0x319B4B9FU,
+            0x3FB506DDU, 0xF85D1B6FU, 0xDDF521D2U, 0x680046D9U, 0xFF676A36U, 0xCF45F2F3U, 0x247BE654U, 0x6C22EE0BU,
+            0x97BEFB66U, 0xA4467A96U, 0x19C8700BU, 0x97CB11F8U, 0xB3F1B13FU, 0xB6D5DC8CU, 0xE4B81AD7U, 0x1853FF6DU,
+            0x48B2364BU, 0xE1462A2EU, 0xDC374BE5U, 0xD0BC21BCU, 0xC2074386U, 0x04192156U, 0x820CEDE0U, 0xA088EE95U,
+            0x80C5EF25U, 0x4B8411A8U, 0xD846AFCBU, 0x0C6E5D97U, 0x6E6768BAU, 0x2BDA3DFAU, 0x5D43C13FU, 0xB63B6EFCU,
+            0xD80D2BDAU, 0x66DE36E1U, 0xD76B0CD8U, 0x88DF31EAU, 0x4057D457U, 0xF54F9383U, 0x74449D09U, 0x79A8FC39U,
+            0x5F7C20F4U, 0xBA8F4A25U, 0x4BBE5B0DU, 0x7EFAC2E6U, 0x4917BD8FU, 0x7D4E890CU, 0x09CB02A2U, 0x38D109C6U,
+            0xAF0A1B4CU, 0x7FC507A0U, 0xD6A966EFU, 0x3063568FU, 0x7D37FDE7U, 0x3E134026U, 0xD23396BDU, 0xB502FCA7U,
+            0x480734B7U, 0x554D211BU, 0x8A3084CDU, 0xE55F8E89U, 0x9481640AU, 0xE041687AU, 0xB030D94AU, 0x96B99857U,
+            0x36034AF6U, 0x54E85463U, 0xD4EFD8B6U, 0x22D6F961U, 0x3A978737U, 0xB8873288U, 0xE3DB8C20U, 0x3B8DFB44U,
+            0x718A0872U, 0xBE7A9A18U, 0x13D2E2CCU, 0x92C15C79U, 0x294B08C4U, 0x9C204DA1U, 0xA14DB333U, 0xBF712CA5U,
+            0x41047A60U, 0x4DF36522U, 0xD52DB281U, 0x9A6A9E04U, 0x07F7AE87U, 0x73DBE12DU, 0x45AC8794U, 0xF727FBDAU,
+            0x66F11C31U, 0x51B8F126U, 0xD25C3D0CU, 0x09641016U, 0xF4DDD141U, 0x012FACD7U, 0x18B668DBU, 0x1119BD34U,
+            0xDF60EFC3U, 0x02B2F3E5U, 0xD062A404U, 0x07BDA6BDU, 0xB5D77297U, 0x6EDED195U, 0x800BB91AU, 0xFDE2F2C3U,
+            0x029071F8U, 0xB364EA5FU, 0xFB67288FU, 0x7DFCF999U, 0x89AED719U, 0x64E20617U, 0x83B767C1U, 0xECE04541U,
+            0xA867DF55U, 0x1BA9C2A4U, 0xD1A0CE33U, 0xBF01C1D8U, 0x88B75B27U, 0xA5820230U, 0x267CB2AEU, 0x3148F25DU,
+            0x15EB65BBU, 0x5CA68161U, 0x3AE9F74FU, 0xE659B5F6U, 0x54380E9CU, 0xF9EDE761U, 0x3A4CBC29U, 0x4288D4D0U,
+            0x316E8EEFU, 0x30849167U, 0xD3E6706AU, 0xADB46E36U, 0xCF1721F7U, 0x2316709EU, 0x1794A833U, 0xBFC7F5BEU,
+            0x2C66597EU, 0xB7913A62U, 0xA30B914EU, 0x91C76706U, 0xE9F26252U, 0x858CC2BAU, 0x2B31D650U, 0x6B406022U,
+            0x4669BE79U, 0x299FA026U, 0xD2241A5DU, 0x15080953U, 0xF2770847U, 0xE84AA33BU, 0xB1E3A387U, 0x736DF520U,
+            0x3B1D4D3DU, 0x5853515CU, 0x62854E8EU, 0x0A622B69U, 0x3464BBD7U, 0x188323CCU, 0x92CA0DB8U, 0xC528F1B3U,
+            0xCB61B38CU, 0xE4C5AEB8U, 0xC55EFE10U, 0x1D724E9AU, 0x10C70814U, 0x1ACA1375U, 0x20754FA0U, 0xD6F6D6A7U,
+            0x4864C09DU, 0x8EF68B39U, 0x5F8B7E83U, 0x74EE59E4U, 0xA713C838U, 0x28A5AB56U, 0x8220516AU, 0xADE5A817U,
+            0xBC66831AU, 0xFDDE9FF9U, 0xC49C9427U, 0xA5CE29FFU, 0x2DA721A4U, 0xD196C0D0U, 0x86024414U, 0x1A5CD639U,
+            0x5F1FD4DEU, 0x6134E007U, 0x9E05A143U, 0xEF4B158BU, 0x7A8511BDU, 0xB5AA4A20U, 0x3BDB8A82U, 0x038D3986U,
+            0x256FD2A0U, 0xD6F3CC3AU, 0xC6DA2A7EU, 0xB77B8611U, 0x6A075B74U, 0x5702B27EU, 0xB7EA5E89U, 0x94D3D1DAU,
+            0x6692E81BU, 0x8A035B04U, 0x07E7C742U, 0x98D5C77BU, 0xC74F7D73U, 0xC9CB6FFBU, 0x2AA6E0FBU, 0x2A458D74U,
+            0x5268E236U, 0xCFE8FD7BU, 0xC7184049U, 0x0FC7E174U, 0x576772C4U, 0x9C5E61DBU, 0x119D553DU, 0x5879D144U,
+            0x71E9FC58U, 0x65C1303AU, 0xC6691882U, 0x03708B14U, 0x1AD9A4F6U, 0x54C48E8DU, 0x935D3B13U, 0x842D1CE5U,
+            0xCC0C7795U, 0x80A96BBCU, 0xC25756CCU, 0x9210D9CDU, 0xE547AED4U, 0x815B5163U, 0xD43A6BB3U, 0x52BCD85DU,
+            0x15889191U, 0x871D2B43U, 0xEF520D01U, 0x77E8629BU, 0x67AAA2AEU, 0x3109244DU, 0x085C3409U, 0x79D4E490U,
+            0xBB0B4703U, 0x99B25AFDU, 0xC3953CFBU, 0x2AACBEA8U, 0xD8278764U, 0x4A0782C6U, 0x724D6007U, 0x9E16D8C3U,
+            0x02F385D2U, 0x68DF407DU, 0x2EDCD2C1U, 0xEC4D2EF4U, 0xBA3C7B2BU, 0xAC06C53BU, 0xB1A7EFE1U, 0xD7BC7501U,
+            0x220216B9U, 0xB29F093EU, 0xC1D382A2U, 0x38191146U, 0x9F87FDB4U, 0xCC93F068U, 0x43A57A9AU, 0x1099DF20U,
+            0x3B7EB917U, 0x83E8FB7EU, 0xB73EB4C0U, 0x9BD3FC04U, 0x07F617E5U, 0xD067E0E0U, 0xA0DA8598U, 0xFE74C1F3U,
+            0x5505262FU, 0xAB84387FU, 0xC011E895U, 0x80A57623U, 0xA2E7D404U, 0x07CF23CDU, 0xE5D2712EU, 0xDC33DFBEU,
+            0x2C05AD54U, 0x6C2A9040U, 0x76B06B00U, 0x0076B06BU, 0xDA60CE60U, 0x4D680196U, 0x19215E70U, 0x501C5062U,
+            0xC5BA3BBEU, 0x2C1C24B0U, 0xCB4DAFA8U, 0xD8C66675U, 0x20B743D5U, 0xF6999118U, 0x139A01C7U, 0x0513CD12U,
+            0xF3BC6285U, 0x9D21CBCDU, 0xE5489FC6U, 0x72E22F1AU, 0xFD101B55U, 0x1BFCB560U, 0x4DA99DEDU, 0xDEF63758U,
+            0xB2BD0B28U, 0x350715F1U, 0xCA8FC59FU, 0x607A0110U, 0x1DD76A65U, 0x3DC542BDU, 0xB5ED0A73U, 0xC9B9CD8CU,
+            0xE4C776C6U, 0x72E3A0F3U, 0x24C64006U, 0xE9476375U, 0x2086C2D0U, 0x86F35416U, 0xF4524605U, 0x709EA6C9U,
+            0x2BB45A92U, 0x1E2A4632U, 0xC8C97BC6U, 0x72CFAEFEU, 0x5A7710B5U, 0xBB513013U, 0x840510EEU, 0x4736CA6FU,
+            0xDD4A4A03U, 0x99D41BF0U, 0xBD242607U, 0x9ED9B185U, 0x9D4CAE1EU, 0xFA9271CDU, 0xE52F2C7CU, 0x5956123BU,
+            0x5CB36A04U, 0x07317773U, 0xC90B11F1U, 0xCA73C99BU, 0x67173905U, 0x700DE3B6U, 0x22721B5AU, 0x8B9CCAF1U,
+            0xCA315E40U, 0x761670CEU, 0x7CAAF9C7U, 0x057CFDEAU, 0x40DA779BU, 0x679D90BBU, 0x5CD4F794U, 0xF73E83AAU,
+            0xC2D7FFA7U, 0x4870E1B4U, 0xCC440774U, 0x57A4F122U, 0xD537E515U, 0x6D08D30EU, 0xE7D525D4U, 0x8159C3E8U,
+            0xAE503389U, 0x94CA6BB7U, 0x5591EC44U, 0x71E41465U, 0x3DA971C3U, 0x02503A7BU, 0xC7D5F88EU, 0x0AC77BDFU,
+            0xB5D0CF31U, 0x516BD0F5U, 0xCD866D43U, 0xEF189647U, 0xE857CCA5U, 0xA65400ABU, 0x41A22E60U, 0x4DF3C376U,
+            0xB92B27CAU, 0x7B080089U, 0x941F3384U, 0xEA41580AU, 0xE03FA846U, 0x9F5FDB0DU, 0x7E2E2366U, 0xA4AFEA4EU,
+            0x2CD99E8BU, 0x7A468336U, 0xCFC0D31AU, 0xFDAD39A9U, 0xAFF7B675U, 0x20C07205U, 0x704A34FDU, 0xC37CC495U,
+            0x80A61B0FU, 0x903FBB8AU, 0x0DFD5585U, 0x9DDF8AFAU, 0x5DF5C488U, 0xE33EFED6U, 0x6F53491FU, 0x8D675EBCU,
+            0x5BDEAE1DU, 0x635DB277U, 0xCE02B92DU, 0x45115ECCU, 0x92979FC5U, 0xEB9CA1A0U, 0xD63D3F49U, 0x0FD6C40BU,
+            0x97DD0F4CU, 0x7FFDD0B4U, 0xCC738A45U, 0x067AC695U, 0x80631D0DU, 0x7E311FA0U, 0xD6A892F7U, 0x230FCF2DU,
+            0x9B64C2B0U, 0xCBFAD74EU, 0x91AF9640U, 0x764DEE06U, 0xE915E8DBU, 0x11E81EB4U, 0xCC1D9F8BU, 0x7AA64737U,
+            0xB8C70348U, 0x78BF0EA1U, 0xA1A92C70U, 0x50A4D810U, 0x1DE7B4BCU, 0xC2CA1813U, 0x847C8BC6U, 0x72831B0EU,
+            0xEC63F226U, 0xD2E1E60FU, 0x906DFC77U, 0xCEF18963U, 0xD475C16BU, 0xDAB4CD11U, 0x6A6A943FU, 0xB60C47A9U,
+            0xAFBC170BU, 0x977D659FU, 0x6027F3B0U, 0xCB01947FU, 0xC0716D39U, 0x5FC5F965U, 0x3D87502EU, 0xDCEB8A9FU,
+            0x756AA39CU, 0xF9CCB5CCU, 0x922B422EU, 0xDC44268DU, 0x93D5BBBBU, 0x5C20BFBFU, 0x5B828EA2U, 0x3883404AU,
+            0x96312BCEU, 0x7C4ADE9CU, 0xF9C595B1U, 0xBC9F468FU, 0x7DBB01F7U, 0x23A4DCBEU, 0x2CFA3A57U, 0xF5233E6DU,
+            0x026D930AU, 0xE0D7848DU, 0x93E92819U, 0x64F841E8U, 0xAEB5920BU, 0x977C6C1AU, 0xFDF58516U, 0xF42940D4U,
+            0x814A3F8DU, 0x9388B5A2U, 0x384B4A71U, 0x273A0AE0U, 0xA02DD872U, 0xBEAB3DC8U, 0x9501E1BFU, 0x5B4BAFFCU,
+            0x9C0906A9U, 0xAF96124AU, 0x96A63E9CU, 0xF92F7951U, 0x1C954E1BU, 0x8A795CA2U, 0x3852BB98U, 0xFEEC49CDU,
+            0xE52B5244U, 0x7154AEDBU, 0x11705FF2U, 0x53A2E36FU, 0xDD5EDE2AU, 0xDB669708U, 0x0E00EEA5U, 0xA6B25789U,
+            0xEB0E363FU, 0xB68D230BU, 0x976454ABU, 0x41931E34U, 0x21F567ABU, 0x41258F07U, 0x9E25B02CU, 0x32464953U,
+            0xF2504607U, 0x9E96C5E5U, 0xD0FE8032U, 0xC807AF00U, 0x00C807AFU, 0x4669767EU, 0xB7FB354DU, 0x08DAC618U,
+            0x72076785U, 0x9DA070C8U, 0x9522EAF2U, 0x5326B1DAU, 0x66551D7BU, 0xC7B1FDA9U, 0xAFCDAAB1U, 0xBCC94EB0U,
+            0xCBDD7AC2U, 0x75A17EE6U, 0x491CE633U, 0xBF997DF0U, 0xBD026B61U, 0x3A0853A5U, 0xA6865F34U, 0x211272EAU,
+            0x05005713U, 0x84BB4189U, 0x94E080C5U, 0xEB9AD6BFU, 0x5B3534CBU, 0x0CED2E0CU, 0x09BAA105U, 0x70634E2EU,
+            0xDCA66E81U, 0x9A6315D8U, 0x889239F3U, 0x243C319FU, 0x6094B2E4U, 0xA707B2D3U, 0x1F7D84DCU, 0x8F7AE37BU,
+            0x95BF4A82U, 0x03235D46U, 0x9FBCC7F8U, 0xB3F9C6E9U, 0xD965A31AU, 0xFDBB9CD9U, 0xFFF2D1ECU, 0xA9435C82U,
+            0x031FA150U, 0x6B684E55U, 0x1B6ACD35U, 0x56A8AEEEU, 0x47E467D1U, 0xF1930625U, 0x4BF54741U, 0x01908441U,
+            0xE2B87A14U, 0x1A386C07U, 0x9E7EADCFU, 0x0B45A18CU, 0xE4058AAAU, 0x36E74F7CU, 0x5985DA58U, 0x65E95C1CU,
+            0x1464B513U, 0x84AA256BU, 0xDAE412F5U, 0xCD0DE281U, 0x9A72BE54U, 0x6C9CE753U, 0xF20E9CA9U, 0xAFF815D0U,
+            0x7BB12BAEU, 0x31153FC4U, 0x9C381396U, 0x19F00E62U, 0xA3A5F07AU, 0xB0733DD2U, 0x686DC0C5U, 0xEB665BFFU,
+            0x2DE989D6U, 0x6F9D9E68U, 0x430674F4U, 0xBA933071U, 0x27B8D29AU, 0x10FDC288U, 0xE373F6D0U, 0x8630A122U,
+            0x0CB61B38U, 0x280E0E85U, 0x9DFA79A1U, 0xA14C6907U, 0x9EC5D9CAU, 0x7B2FEE77U, 0xCE1ACB71U, 0x27CC5B61U,
+            0x3A929D95U, 0x805FF556U, 0x8288AB34U, 0x21367C1EU, 0xFA2E0B1FU, 0x8DF223FEU, 0x5A882D38U, 0x285830B3U,
+            0x92D28E9BU, 0x674F9842U, 0x98B56F24U, 0x3C9B51BEU, 0x2CE505DAU, 0x662ADECFU, 0x0BBDF5FFU, 0x2D095278U,
+            0x5EF3F05CU, 0x6283EE2FU, 0xABB3BEB7U, 0x55AE9591U, 0x875D0D47U, 0xE83F893EU, 0xC1892222U, 0xD5A1C8C6U,
+            0xE5D5BE0DU, 0x7E54A903U, 0x99770513U, 0x842736DBU, 0x11852C6AU, 0xAD760D6AU, 0xADCAFE4BU, 0xE1A352E6U,
+            0x4988E41FU, 0x8D418511U, 0x6A3D6177U, 0xCE0BD9FEU, 0x5ACBD4C2U, 0x75306848U, 0x7872F9CAU, 0x7BC95957U,
+            0x7CDCEFB7U, 0x5579FAC0U, 0x9B31BB4AU, 0x96929935U, 0x562556BAU, 0x2BE27FC4U, 0x9C22E4D6U, 0x6F2C5505U,
+            0x7005D8DAU, 0x66763E12U, 0xF3DF0776U, 0xB9950B0EU, 0xE701B80CU, 0x09514D93U, 0x690F93B3U, 0x5201EDA5U,
+            0x0BDBDF21U, 0x4C62CB81U, 0x9AF3D17DU, 0x2E2EFE50U, 0x6B457F0AU, 0xE0BEAC61U, 0x3A55EF62U, 0xA386559BU,
+            0x677ECC99U, 0x89B4552CU, 0x3251D8B6U, 0x22304761U, 0x3A976189U, 0x945EACE5U, 0xD0F4485BU, 0xFC697C34U,
+            0x86D3D2D4U, 0x8138C51FU, 0x8D893530U, 0x2654B999U, 0x89F57F59U, 0x123E1C2FU, 0xABC30345U, 0x061D761CU,
+            0x14074139U, 0x5F118F49U, 0x0F5FE8BBU, 0x5CBC35ECU, 0xA9E01266U, 0xA478247FU, 0xC01E1489U, 0x94A42590U,
+            0xF1D4E242U, 0x9823F45EU, 0x8C4B5F07U, 0x9EE8DEFCU, 0xB49556E9U, 0xD962CF8AU, 0x0DB408F1U, 0xCAB77682U,
+            0x037C557AU, 0xB0D3E477U, 0xCED1377BU, 0xC7197983U, 0x7476CBE3U, 0x3977C509U, 0x79E5CF61U, 0x3ACCB401U,
+            0x68DDB3F8U, 0xB30EA79DU, 0x8E0DE15EU, 0x8C5D7112U, 0xF3352C39U, 0x5FF6BD24U, 0x3C5C126CU, 0x44387161U,
+            0x3AF169BFU, 0x5BE45F74U, 0x5733517AU, 0xB087AB73U, 0xC9BCA72DU, 0x4516E0D2U, 0x6898A518U, 0x130400F3U,
+            0x1FDA836EU, 0xAA1596DCU, 0x8FCF8B69U, 0x34E11677U, 0xCE550589U, 0x94AA6E81U, 0x9A2B19D8U, 0x889271FFU,
+            0x2D8A7DFCU, 0xB426344AU, 0x96BD8EBAU, 0x2B22E71CU, 0x142A7EA8U, 0xD81901A4U, 0xD1637EF0U, 0xBD6C9162U,
+            0x81BE16CDU, 0xE554001BU, 0x8A809DECU, 0xA9362ECEU, 0x7C75D999U, 0x89AF5E39U, 0x5F8C2756U, 0x825778E6U,
+            0x49EB1035U, 0x56FA2F33U, 0xBF869B39U, 0x5FBA0E93U, 0x695978F0U, 0xBDD4AB64U, 0x4A6271EAU, 0x40956917U,
+            0xF6B9265BU, 0xFC4F315AU, 0x8B42F7DBU, 0x118A49ABU, 0x4115F029U, 0x42F38D9CU, 0xF9FB2CE2U, 0x4EFD7878U,
+            0x5E900476U, 0xB938440DU, 0x7E0844F9U, 0xC41F42FCU, 0xB4CFA175U, 0x20DB4A12U, 0xF399AA02U, 0xEEFDF886U,
+            0x6FB077E1U, 0xD7626299U, 0x89044982U, 0x033FE645U, 0x06B58AF9U, 0xC467FF32U, 0xC813367FU, 0xC0727F9BU,
+            0x671D38B3U, 0x520FFF0EU, 0xE7EA22F8U, 0xB381900CU, 0x0905CDBBU, 0x5CBA6FC9U, 0xE2E4C07BU, 0xC7354C74U,
+            0x18B74777U, 0xCE7953D8U, 0x88C623B5U, 0xBB838120U, 0x3BD5A349U, 0x0F3B2C97U, 0x6E643DCBU, 0x0CD87F05U,
+            0x70662CF0U, 0xBDCD9430U, 0x2664FD38U, 0x2824DC63U, 0xD493143EU, 0xC1B58EBFU, 0x5B1F1B93U, 0x695DDDE5U,
+            0x88085AE6U, 0x49E14F17U, 0x839A6488U, 0xE3E09176U, 0xB9853498U, 0xFE6D9E42U, 0x982C4D22U, 0xD5F86DA9U,
+            0xAFDFE321U, 0x4CC6CFBDU, 0xB59C09FEU, 0x5AB04312U, 0xF3E3C10BU, 0x97213A49U, 0x0F97D80EU, 0xE7B7BADFU,
+            0xFF0F6A70U, 0x50FA7E56U, 0x82580EBFU, 0x5B5CF613U, 0x84E51D28U, 0x35314DE7U, 0x3E5B4696U, 0x19526D37U,
+            0xB8A4F762U, 0xA304A483U, 0x7412D63EU, 0xC1150F7DU, 0x2E75188EU, 0x0A2EDB3FU, 0xB66C03E6U, 0x49DF2B4EU,
+            0x66063BCAU, 0x7BD72D95U, 0x801EB0E6U, 0x49E959FDU, 0xC34567F8U, 0xB3A53F49U, 0x0FB35C0BU, 0x97DD6AD4U,
+            0x8129CBA7U, 0x48331F80U, 0xEDF0B03FU, 0xB68BDD8DU, 0x93BF7440U, 0x764FFEE4U, 0xA711699FU, 0x60179FBCU,
+            0x11010B5CU, 0x62CC1CD4U, 0x81DCDAD1U, 0xF1553E98U, 0xFE254E48U, 0x78F9ECECU, 0xA9C457BFU, 0x5B776A4AU,
+            0x9652DFE4U, 0xA7F174BEU, 0x2C7E6FFFU, 0x2D2E91E2U, 0x4E29ADC5U, 0xEB401F92U, 0x1EEAB277U, 0xCE7F0E2DU,
+            0x8F659EFFU, 0x2D8D8A13U, 0x8493CC54U, 0x6C820621U, 0x4C059258U, 0x65FCDC54U, 0x6C636931U, 0x51B26353U,
+            0xF233B22DU, 0x452D6FC7U, 0x05457A7CU, 0x59B6786DU, 0x335AAB9DU, 0x8E8DB552U, 0x85EBBD6DU, 0x3386F658U,
+            0xF862AE69U, 0x3496BB52U, 0x8551A663U, 0xD43E6144U, 0x7165BBE8U, 0xAEA00FF1U, 0xCA146285U, 0x9D1863CDU,
+            0xE548A66EU, 0xAAEF04F9U, 0xC4CBA5BCU, 0xC2133402U, 0xEECC7218U, 0x13825424U, 0x3C106685U, 0x9DEE67C9U,
+            0x616BFFD3U, 0x1FBBE891U, 0x8717183AU, 0xC68BCEAAU, 0x36C5C138U, 0x28347D5FU, 0xFBFC7818U, 0x1397642EU,
+            0xDCC59AABU, 0x41D8BFFAU, 0x5D29C3BDU, 0xB58DE6F2U, 0x53061ED6U, 0x6FE371FFU, 0x2D6D0CFCU, 0xB426D33BU,
+            0x166CCF45U, 0x06A0D9D0U, 0x86D5720DU, 0x7E37A9CFU, 0x0BA5E888U, 0xE368AEFAU, 0x5D8B73ACU, 0xDF3D64B0U,
+            0xCBBE8EE8U, 0xAE1AD4C4U, 0x9CA71C7DU, 0x2E28AA9DU, 0x8E90C753U, 0xF2EC9089U, 0x9496D714U, 0x1A4E42AAU,
+            0xA00AE278U, 0x5E7EF3ECU, 0xA9E2D0A0U, 0xD67F4138U, 0x28D4C7DFU, 0x16441B82U, 0x03A0A617U, 0x83D02561U,
+            0x3A3681EBU, 0x37E20D71U, 0x2735A3A7U, 0x489503E8U, 0xAE99FF49U, 0x0FAE60CBU, 0x0CB9B558U, 0x65BC6073U,
+            0xD70DD2EEU, 0x4765C2ADU, 0xA820BA97U, 0x6EC3265DU, 0x15B4EE6FU, 0xDD18C827U, 0xA5D7ADA3U, 0x4F7A25FFU,
+            0x2D4D95A8U, 0xD820664FU, 0xE6BB7C67U, 0xD3304F87U, 0x730F26CCU, 0x92A181BDU, 0xB5426EB0U, 0xCBD4F1E2U,
+            0x4E048354U, 0x6C48916EU, 0xAA6604CEU, 0x7C7689B3U, 0x521494BFU, 0x5B8CBA89U, 0x943FB73EU, 0xC1F5221CU,
+            0x14C0A96DU, 0x3317DD4CU, 0x7F591A66U, 0xA4AE9D77U, 0xCEC54A02U, 0xEEC0A466U, 0xA43F04C9U, 0xE21C4510U,
+            0x3903B3C2U, 0x7553A02FU, 0xABA46EF9U, 0xC4CAEED6U, 0x6F74BD0FU, 0x90D0692CU, 0x3248BC8AU, 0x0D5F2282U,
+            0x03BBBD2EU, 0xDCD5B672U, 0xBED7C5A6U, 0x3F0BD118U, 0x13539387U, 0x73CF4510U, 0x1DC4DF21U, 0x4C74D481U,
+            0xA7672661U, 0x3A1236E8U, 0xAEEB787CU, 0x591DD66FU, 0xDD54611FU, 0x8DD55994U, 0xF7EF8204U, 0x079A2B9BU,
+            0x67DAD0E7U, 0x3E09AD0BU, 0x97ECD025U, 0x4B933897U, 0x6E2095DFU, 0x1602EFD0U, 0x86C5D03BU, 0xB18D2CF4U,
+            0xD06016F7U, 0x230907A9U, 0xAF29124BU, 0xE1A1B10AU, 0xE03448AFU, 0x46898A31U, 0x519889B0U, 0xCB302B05U,
+            0x70A1C4A4U, 0xD1CBC635U, 0x56620FE5U, 0xD03674F8U, 0xB3B64C5AU, 0x8B0D0EA6U, 0x3F3E0BD3U, 0x1FE5BD65U,
+            0x4969474DU, 0x0824546AU, 0xAD6FAC12U, 0xF3141EE4U, 0xA794327FU, 0xC01DF89FU, 0x6070932DU, 0x45BF2CE6U,
+            0x492CF861U, 0x3AFC7D36U, 0xCF8069E4U, 0xA7A8A608U, 0x0E7C2094U, 0xF76C2B7DU, 0x2E4361AAU, 0x362D0997U,
+            0x3E6E77DBU, 0x113F652BU, 0xACADC625U, 0x4BA87981U, 0x9AF41BCFU, 0x0B412B3AU, 0xC6079899U, 0x89152C78U,
+            0x5E57EC22U, 0xD53E1608U, 0x0E0EB624U, 0x3C0DEA67U, 0xD3EAF911U, 0x6A63CA0BU, 0x97B8BA42U, 0x98459806U,
+            0xAED16A4AU, 0x96A779E4U, 0xA7F18118U, 0x13CB69D7U, 0x18A48C1EU, 0xFA1799EFU, 0x304FE870U, 0x50353ED4U,
+            0x81EE23F3U, 0x24354D85U, 0x9DF642E2U, 0x4E997516U, 0xF49A2C24U, 0x3CF77EFDU, 0xC33079DFU, 0x16AFFF3CU,
+            0xD9D65ADCU, 0x8FBC48A5U, 0xA633EB2FU, 0xAB770EB2U, 0x25C4A5AEU, 0x314B4A4AU, 0x9638E3C4U, 0x9C9F3E4AU,
+            0x969537B0U, 0xCBF726BBU, 0x5C789D22U, 0xD53C3979U, 0x290CF5A1U, 0xA1F89F8BU, 0x7ACBA237U, 0xB8C76EADU,
+            0x40DF0B66U, 0xA4911B66U, 0xA4755576U, 0xB9C2A15CU, 0x6264DF7EU, 0xB7DF38E4U, 0xA7D0F959U, 0x121039A9U,
+            0xAF180B75U, 0x20C09DB8U, 0xC59AFB23U, 0xA2A2EB89U, 0x94C6996FU, 0xDD99BA50U, 0x6BB6C84EU, 0x910FDA5FU,
+            0x37D83BF0U, 0xBD8A2A27U, 0xA5B73F41U, 0x017EC639U, 0x5F04F6CEU, 0x7C83EB41U, 0x01A7F2EDU, 0xDEBA3937U,
+            0xB8631F36U, 0xCF02F686U, 0x041424E3U, 0x3907A7E6U, 0x495040EAU, 0x40965B26U, 0xD24D13A6U, 0x3F674BCEU,
+            0xA9BCAE53U, 0xF2CBBCE0U, 0xA0F829C4U, 0x9CA9FE80U, 0xED242ADEU, 0x6186DBF9U, 0xC400CC63U, 0xD47F302EU,
+            0xDC0272FFU, 0x2DDEEDFFU, 0x2D2F3160U, 0x4D9F4E69U, 0x342346B2U, 0x255BF1E6U, 0x494C1CBCU, 0xC29EB3BBU,
+            0xDEBB9EC5U, 0xEBD08DA1U, 0xA13A43F3U, 0x241599E5U, 0xD044036EU, 0xAADA085CU, 0x6277C7D7U, 0x18D530B0U,
+            0xCB7966BCU, 0xC21C86C1U, 0xECA1EEA0U, 0xD63A0206U, 0xE9B59F37U, 0xB8541090U, 0xF0B7C754U, 0x6CF6222AU,
+            0x47B2CF7FU, 0xC0FDDE62U, 0xA37CFDAAU, 0x36A0360BU, 0x97E479BEU, 0x2C4E7AF2U, 0x539FDD4AU, 0x965A3753U,
+            0xF2F45A79U, 0x292B3DC2U, 0x754388A1U, 0xA1A4D0F6U, 0x547FF3F9U, 0xC435354BU, 0xE1CAAD2DU, 0x453E96D8U,
+            0x30B5FFE9U, 0xD9E6EF23U, 0xA2BE979DU, 0x8E1C516EU, 0xAA84500EU, 0xE712A957U, 0xF5E8D6FEU, 0x5AF037CDU,
+            0xE58F4E3AU, 0xC6E956FCU, 0xB4CD5761U, 0x3A019C99U, 0x89E92A7CU, 0x593AD43DU, 0x583176C5U, 0xEB560749U,
+            0xBDBDF21CU, 0x14BCE1BDU, 0xB5C473D0U, 0x866616A7U, 0x4834505DU, 0x15921919U, 0x647E3AD9U, 0xFF6B144AU,
+            0x96F6C39AU, 0x104C8C99U, 0x89C3676CU, 0x448DEE14U, 0x1A9E5993U, 0x691C5CA7U, 0x48DB2A17U, 0x839B5EEDU,
+            0xCABAC28AU, 0x0DA7D0FCU, 0xB40619E7U, 0x3EDA71C2U, 0x755479EDU, 0xDECECABCU, 0xC209316DU, 0x33C114D4U,
+            0x818DD7D9U, 0xFF8EE7A7U, 0x484DB8ACU, 0xDF28A27BU, 0xC7088016U, 0xF413BDD1U, 0xF120F1FFU, 0x2DF3CF7CU,
+            0x53B39330U, 0x268A833FU, 0xB640A7BEU, 0x2C6FDE2CU, 0x32F4033DU, 0x585AB812U, 0xF3E12BF0U, 0xBD4E1337U,
+            0xB800EB1CU, 0x14B95CA4U, 0xD1AFDEADU, 0xA8B6708BU, 0x7AC2ECD8U, 0x8872980AU, 0xE05D9B86U, 0x043B7B8EU,
+            0x24B4A3A6U, 0x3F91B27EU, 0xB782CD89U, 0x94D3B949U, 0x0F942A8DU, 0x93066BB7U, 0x55962044U, 0x71E413A9U,
+            0xAF7BFF5FU, 0xFB7B379AU, 0x1021016DU, 0x33133CE4U, 0xA754355DU, 0x157D797CU, 0x59A6406EU, 0xAA53EA1FU,
+            0xBAD03605U, 0x70D024B9U, 0xB2CDDB0CU, 0x090481F0U, 0xBDB4F69DU, 0x8E035B0FU, 0x90311ECAU, 0x7B211AB0U,
+            0xCB1A9296U, 0x19A72CE3U, 0x391A14EEU, 0x478BD56BU, 0xDA273305U, 0x70B0D3BCU, 0xC2A74F74U, 0x57AA126AU,
+            0xCDD70693U, 0x69CB15F8U, 0xB30FB13BU, 0xB1B8E695U, 0x80D4DF2DU, 0x455F88AAU, 0x3646157EU, 0xB78B1A2EU,
+            0xDC6186D5U, 0xF66547DDU, 0xF894CB2EU, 0xDC2E9904U, 0x07B1EA80U, 0xEDBF32CAU, 0x7B5C949CU, 0xF9C283FBU,
+            0x54DE5729U, 0x42E6463BU, 0xB1490F62U, 0xA30D497BU, 0xC774A5FDU, 0xC3CBFA04U, 0x07AE0FE3U, 0x39041DCDU,
+            0xE5ECBA10U, 0x1D52FCDEU, 0x6176AD2FU, 0xABB04BF4U, 0xBA7B864EU, 0x91DE1711U, 0x6A21FEE5U, 0xD00A3709U,
+            0x23D967BFU, 0x5BFD777AU, 0xB08B6555U, 0x1BB12E1EU, 0xFA148C4DU, 0x089729A1U, 0xA1D90457U, 0xF5AE1D53U,
+            0xF297AE53U, 0xF29097E0U, 0xA0F872EFU, 0x3015079BU, 0x67ED5FCBU, 0x0CD1F667U, 0xD3DA250DU, 0x7E62A698U,
+            0xB3667A2EU, 0xDC656BB5U, 0xBBD72268U, 0x43D23E48U, 0x78441B9CU, 0xF9C19B74U, 0x579174BEU, 0x2C8E0FFFU,
+            0x2D2E6182U, 0x039BCC6DU, 0x33008629U, 0x428198EAU, 0x409D8AFEU, 0x5A454291U, 0x8752E690U, 0xF088C1A2U,
+            0xC4614AB8U, 0xC57E5AF4U, 0xBA15485FU, 0xFB6E592DU, 0x4524322CU, 0x329D48D1U, 0xF1E67F0AU, 0xE0240F61U,
+            0x3A5575C1U, 0xEC59A753U, 0xF28E59E9U, 0xD924D485U, 0x9D0B537BU, 0xC74AA3E7U, 0x3EA93D78U, 0x5EE05033U,
+            0x5D681B02U, 0xEE530937U, 0xB853F606U, 0xE9DBF6C3U, 0x028448FCU, 0xB4093A7FU, 0xC00E6597U, 0x6EAB0882U,
+            0x03D84904U, 0x076E1C50U, 0x6B6C3FE8U, 0xAEBA0675U, 0x20C13FB5U, 0xBB2B863CU, 0x2FD45701U, 0x7728E4C1U,
+            0x2A6F2B94U, 0xF7483876U, 0xB9919C31U, 0x516791A6U, 0x3FE4614CU, 0x7F55E9DAU, 0x66796E23U, 0xA201081CU,
+            0x14A35D47U, 0xE8AC776EU, 0xAAE2E028U, 0x351F4A1AU, 0xFD57E630U, 0x2624674AU, 0x962F8CE9U, 0xD9407550U,
+            0xB40BBE37U, 0xB809AEB1U, 0xBCDE8AB4U, 0xCCB0A91FU, 0x8DC4BD5CU, 0x6250D962U, 0xA3DE50ADU, 0xA8C40105U,
+            0x70C2308EU, 0x0A706C17U, 0x83D9F5ABU, 0x4187A395U, 0x8024E068U, 0x43E9CD8AU, 0x0D2E83F3U, 0x24B98D25U,
+            0xC30C8EA1U, 0xA1129FF0U, 0xBD1CE083U, 0x740CCE7AU, 0xB0A494ECU, 0xA90C0AC7U, 0x05A95B19U, 0x646E019BU,
+            0x67B924CDU, 0xE5B20729U, 0x42572A6BU, 0xDA22EFFAU, 0x5DB239EDU, 0xDEE62CFCU, 0xB4D5581BU, 0x8AD11CB4U,
+            0x5A05DF1BU, 0x8A3FCC33U, 0xBF5A5EDAU, 0x66B96194U, 0xF704EE3CU, 0x2F987869U, 0x34414184U, 0xEAE10678U,
+            0x5E341808U, 0x0E85BC2AU, 0xDBB54C6AU, 0xADBC3D0AU, 0xE0785523U, 0xA2870927U, 0xA5A83262U, 0xA319A846U,
+            0x2D02EF8DU, 0x9324FD72U, 0xBE9834EDU, 0xDE0506F1U, 0xCA64C78CU, 0xE4C4ABCCU, 0x92364A30U, 0x264B06E6U,
+            0x494F0C4BU, 0xE147D714U, 0x1A3B93AAU, 0x36197165U, 0x3DEE8CA6U, 0x3F88E851U, 0x1C53E98AU, 0x0D7139D7U,
+        };
+
+        uint32_t ulIdx = 0U;
+        uint32_t ulSliceLen;
+
+        /*  Handle the unaligned initial bytes (if any) using the Sarwate
+         *  algorithm, as with slice-by-8.
+         */
+        while( ( ulIdx < ulLength ) && !IS_ALIGNED_PTR( &pbBuffer[ ulIdx ] ) )
+        {
+            ulCrc32 = ( ulCrc32 >> 8U ) ^ aulCrc32Table[ ( ( ulCrc32 ^ pbBuffer[ ulIdx ] ) & 0xFFU ) << 4U ];
+
+            ulIdx++;
+        }
+
+        /*  Round down the length to the nearest multiple of sixteen.
+         */
+        ulSliceLen = ( ( ( ulLength - ulIdx ) >> 4U ) << 4U ) + ulIdx;
+
+        while( ulIdx < ulSliceLen )
+        {
+            #if REDCONF_ENDIAN_BIG == 1
+                ulCrc32 ^= pbBuffer[ ulIdx ] | ( ( uint32_t ) pbBuffer[ ulIdx + 1U ] << 8U ) |
+                           ( ( uint32_t ) pbBuffer[ ulIdx + 2U ] << 16U ) | ( ( uint32_t ) pbBuffer[ ulIdx + 3U ] << 24U );
+            #else
+                ulCrc32 ^= *CAST_CONST_UINT32_PTR( &pbBuffer[ ulIdx ] );
+            #endif
+
+            ulCrc32 =
+                aulCrc32Table[ ( ( ulCrc32 & 0xFFU ) << 4U ) + 15U ] ^
+                aulCrc32Table[ ( ( ( ulCrc32 >> 8U ) & 0xFFU ) << 4U ) + 14U ] ^
+                aulCrc32Table[ ( ( ( ulCrc32 >> 16U ) & 0xFFU ) << 4U ) + 13U ] ^
+                aulCrc32Table[ ( ( ( ulCrc32 >> 24U ) & 0xFFU ) << 4U ) + 12U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 4U ] << 4U ) + 11U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 5U ] << 4U ) + 10U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 6U ] << 4U ) + 9U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 7U ] << 4U ) + 8U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 8U ] << 4U ) + 7U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 9U ] << 4U ) + 6U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 10U ] << 4U ) + 5U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 11U ] << 4U ) + 4U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 12U ] << 4U ) + 3U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 13U ] << 4U ) + 2U ] ^
+                aulCrc32Table[ ( ( uint32_t ) pbBuffer[ ulIdx + 14U ] << 4U ) + 1U ] ^
+                aulCrc32Table[ ( uint32_t ) pbBuffer[ ulIdx + 15U ] << 4U ];
+
+            ulIdx += 16U;
+        }
+
+        /*  Compute the remaining bytes with the Sarwate algorithm.
+         */
+        while( ulIdx < ulLength )
+        {
+            ulCrc32 = ( ulCrc32 >> 8U ) ^ aulCrc32Table[ ( ( ulCrc32 ^ pbBuffer[ ulIdx ] ) & 0xFFU ) << 4U ];
+
+            ulIdx++;
+        }
+
+        return ulCrc32;
+    }
+#endif /* CRC_SLICEBY16_ENABLED */
+
+
+#if CRC_ENABLED( CRC_HARDWARE )
+
+/** @brief Update an inverted CRC32 using CPU instructions, if available.
+ *
+ *  Falls back to slice-by-16 for targets without suitable instructions.
+ *
+ *  @param ulCrc32      Starting CRC value, inverted.
+ *  @param pbBuffer     Data buffer to calculate the CRC from.
+ *  @param ulLength     Number of bytes of data in the given buffer.
+ *
+ *  @return The updated CRC value, inverted.
+ */
+    static uint32_t CrcHardware( uint32_t ulCrc32,
+                                 const uint8_t * pbBuffer,
+                                 uint32_t ulLength )
+    {
+        uint32_t ulIdx = 0U;
+
+        #if CRC_HW_ARM == 1
+            uint32_t ulWordLen;
+
+            while( ( ulIdx < ulLength ) && !IS_ALIGNED_PTR( &pbBuffer[ ulIdx ] ) )
+            {
+                ulCrc32 = __crc32b( ulCrc32, pbBuffer[ ulIdx ] );
+                ulIdx++;
+            }
+
+            /*  Round down the length to the nearest multiple of four.
+             */
+            ulWordLen = ( ( ( ulLength - ulIdx ) >> 2U ) << 2U ) + ulIdx;
+
+            while( ulIdx < ulWordLen )
+            {
+                ulCrc32 = __crc32w( ulCrc32, *CAST_CONST_UINT32_PTR( &pbBuffer[ ulIdx ] ) );
+                ulIdx += 4U;
+            }
+
+            while( ulIdx < ulLength )
+            {
+                ulCrc32 = __crc32b( ulCrc32, pbBuffer[ ulIdx ] );
+                ulIdx++;
+            }
+        #else /* CRC_HW_ARM == 1 */
+            #if CRC_HW_CLMUL == 1
+                if( ( ulLength >= CLMUL_MIN_LENGTH ) && CrcClmulSupported() )
+                {
+                    /*  Fold whole 16-byte chunks; slice-by-16 handles the rest.
+                     */
+                    ulIdx = ulLength & ~15U;
+                    ulCrc32 = CrcClmul( ulCrc32, pbBuffer, ulIdx );
+                }
+            #endif
+
+            ulCrc32 = CrcSliceBy16( ulCrc32, &pbBuffer[ ulIdx ], ulLength - ulIdx );
+        #endif /* CRC_HW_ARM == 1 */
+
+        return ulCrc32;
+    }
+#endif /* CRC_ENABLED( CRC_HARDWARE ) */
+
+
+#if CRC_HW_CLMUL == 1
+
+/** @brief Determine whether the CPU supports the carry-less multiply
+ *         instruction.
+ *
+ *  @return Whether PCLMULQDQ is supported.
+ */
+    static bool CrcClmulSupported( void )
+    {
+        bool fSupported;
+
+        #if defined( __PCLMUL__ )
+            fSupported = true;
+        #elif defined( _MSC_VER )
+            /*  The result does not change, so caching it without
+             *  synchronization is harmless.
+             */
+            static int8_t cSupported = -1;
+
+            if( cSupported < 0 )
+            {
+                int aiCpuInfo[ 4U ];
+
+                __cpuid( aiCpuInfo, 1 );
+
+                /*  PCLMULQDQ is ECX bit 1.
+                 */
+                cSupported = ( ( aiCpuInfo[ 2U ] & 2 ) != 0 ) ? 1 : 0;
+            }
+
+            fSupported = ( cSupported == 1 );
+        #else
+            fSupported = ( __builtin_cpu_supports( "pclmul" ) != 0 );
+        #endif
+
+        return fSupported;
+    }
+
+
+/** @brief Update an inverted CRC32 by folding with carry-less multiplication.
+ *
+ *  This is the folding algorithm from Intel's white paper "Fast CRC
+ *  Computation for Generic Polynomials Using PCLMULQDQ Instruction", with the
+ *  constants for the reflected IEEE 802.3 polynomial: four 128-bit lanes are
+ *  folded 64 bytes at a time, then combined into one lane, which is reduced to
+ *  32 bits by Barrett reduction.
+ *
+ *  @param ulCrc32      Starting CRC value, inverted.
+ *  @param pbBuffer     Data buffer to calculate the CRC from.
+ *  @param ulLength     Number of bytes of data in the given buffer.  Must be a
+ *                      multiple of 16 and at least CLMUL_MIN_LENGTH.
+ *
+ *  @return The updated CRC value, inverted.
+ */
+    static CRC_CLMUL_TARGET uint32_t CrcClmul( uint32_t ulCrc32,
+                                               const uint8_t * pbBuffer,
+                                               uint32_t ulLength )
+    {
+        const __m128i xK1K2 = _mm_set_epi64x( 0x01C6E41596LL, 0x0154442BD4LL );
+        const __m128i xK3K4 = _mm_set_epi64x( 0x00CCAA009ELL, 0x01751997D0LL );
+        const __m128i xK5K0 = _mm_set_epi64x( 0LL, 0x0163CD6124LL );
+        const __m128i xPoly = _mm_set_epi64x( 0x01F7011641LL, 0x01DB710641LL );
+        const __m128i xMask32 = _mm_setr_epi32( -1, 0, -1, 0 );
+        __m128i x1;
+        __m128i x2;
+        __m128i x3;
+        __m128i x4;
+        __m128i xTmp;
+        uint32_t ulIdx;
+
+        REDASSERT( ( ulLength >= CLMUL_MIN_LENGTH ) && ( ( ulLength & 15U ) == 0U ) );
+
+        x1 = _mm_loadu_si128( ( const __m128i * ) &pbBuffer[ 0U ] );
+        x2 = _mm_loadu_si128( ( const __m128i * ) &pbBuffer[ 16U ] );
+        x3 = _mm_loadu_si128( ( const __m128i * ) &pbBuffer[ 32U ] );
+        x4 = _mm_loadu_si128( ( const __m128i * ) &pbBuffer[ 48U ] );
+        x1 = _mm_xor_si128( x1, _mm_cvtsi32_si128( ( int ) ulCrc32 ) );
+
+        /*  Fold 64 bytes at a time into four lanes.
+         */
+        for( ulIdx = 64U; ( ulLength - ulIdx ) >= 64U; ulIdx += 64U )
+        {
+            xTmp = _mm_clmulepi64_si128( x1, xK1K2, 0x00 );
+            x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, xK1K2, 0x11 ), xTmp ),
+                                _mm_loadu_si128( ( const __m128i * ) &pbBuffer[ ulIdx ] ) );
+            xTmp = _mm_clmulepi64_si128( x2, xK1K2, 0x00 );
+            x2 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x2, xK1K2, 0x11 ), xTmp ),
+                                _mm_loadu_si128( ( const __m128i * ) &pbBuffer[ ulIdx + 16U ] ) );
+            xTmp = _mm_clmulepi64_si128( x3, xK1K2, 0x00 );
+            x3 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x3, xK1K2, 0x11 ), xTmp ),
+                                _mm_loadu_si128( ( const __m128i * ) &pbBuffer[ ulIdx + 32U ] ) );
+            xTmp = _mm_clmulepi64_si128( x4, xK1K2, 0x00 );
+            x4 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x4, xK1K2, 0x11 ), xTmp ),
+                                _mm_loadu_si128( ( const __m128i * ) &pbBuffer[ ulIdx + 48U ] ) );
+        }
+
+        /*  Fold the four lanes into one.
+         */
+        xTmp = _mm_clmulepi64_si128( x1, xK3K4, 0x00 );
+        x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, xK3K4, 0x11 ), xTmp ), x2 );
+        xTmp = _mm_clmulepi64_si128( x1, xK3K4, 0x00 );
+        x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, xK3K4, 0x11 ), xTmp ), x3 );
+        xTmp = _mm_clmulepi64_si128( x1, xK3K4, 0x00 );
+        x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, xK3K4, 0x11 ), xTmp ), x4 );
+
+        /*  Fold any remaining 16-byte chunks.
+         */
+        while( ulIdx < ulLength )
+        {
+            xTmp = _mm_clmulepi64_si128( x1, xK3K4, 0x00 );
+            x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, xK3K4, 0x11 ), xTmp ),
+                                _mm_loadu_si128( ( const __m128i * ) &pbBuffer[ ulIdx ] ) );
+            ulIdx += 16U;
+        }
+
+        /*  Fold 128 bits to 64 bits.
+         */
+        x2 = _mm_clmulepi64_si128( x1, xK3K4, 0x10 );
+        x1 = _mm_xor_si128( _mm_srli_si128( x1, 8 ), x2 );
+        x2 = _mm_srli_si128( x1, 4 );
+        x1 = _mm_and_si128( x1, xMask32 );
+        x1 = _mm_xor_si128( _mm_clmulepi64_si128( x1, xK5K0, 0x00 ), x2 );
+
+        /*  Barrett reduction to 32 bits.
+         */
+        x2 = _mm_and_si128( x1, xMask32 );
+        x2 = _mm_clmulepi64_si128( x2, xPoly, 0x10 );
+        x2 = _mm_and_si128( x2, xMask32 );
+        x2 = _mm_clmulepi64_si128( x2, xPoly, 0x00 );
+        x1 = _mm_xor_si128( x1, x2 );
+
+        return ( uint32_t ) _mm_cvtsi128_si32( _mm_srli_si128( x1, 4 ) );
+    }
+#endif /* CRC_HW_CLMUL == 1 */
@@ -27,10 +27,14 @@
 /** @file
  *  @brief Default implementations of memory manipulation functions.
  *
- *  These implementations are intended to be small and simple, and thus forego
- *  all optimizations.  If the C library is available, or if there are better
+ *  These implementations are intended to be small and simple.  The only
+ *  optimization they make is to work a machine word at a time, rather than a
+ *  byte at a time, when the buffers are aligned with each other, as block
+ *  buffers always are.  If the C library is available, or if there are better
  *  third-party implementations available in the system, those can be used
- *  instead by defining the appropriate macros in redconf.h.
+ *  instead by defining the appropriate macros in redconf.h; for example:
+ *
+ *      #define RedMemCpyUnchecked      memcpy
  *
  *  These functions are not intended to be completely 100% ANSI C compatible
  *  implementations, but rather are designed to meet the needs of Reliance Edge.
@@ -40,6 +44,17 @@
 #include <redfs.h>
 
 
+/*  Word-at-a-time copies go through ::REDMEMWORD, which may alias other types;
+ *  see the deviation record for CAST_MEMWORD_PTR() in reddeviations.h.
+ */
+#define WORD_SIZE    ( ( uint32_t ) sizeof( REDMEMWORD ) )
+
+
+#if !defined( RedMemCpyUnchecked ) || !defined( RedMemMoveUnchecked )
+    static void MemCopyForward( uint8_t * pbDest,
+                                const uint8_t * pbSrc,
+                                uint32_t ulLen );
+#endif
 #ifndef RedMemCpyUnchecked
     static void RedMemCpyUnchecked( void * pDest,
                                     const void * pSrc,
@@ -100,14 +115,7 @@ void RedMemCpy( void * pDest,
                                     const void * pSrc,
                                     uint32_t ulLen )
     {
-        uint8_t * pbDest = CAST_VOID_PTR_TO_UINT8_PTR( pDest );
-        const uint8_t * pbSrc = CAST_VOID_PTR_TO_CONST_UINT8_PTR( pSrc );
-        uint32_t ulIdx;
-
-        for( ulIdx = 0U; ulIdx < ulLen; ulIdx++ )
-        {
-            pbDest[ ulIdx ] = pbSrc[ ulIdx ];
-        }
+        MemCopyForward( CAST_VOID_PTR_TO_UINT8_PTR( pDest ), CAST_VOID_PTR_TO_CONST_UINT8_PTR( pSrc ), ulLen );
     }
 #endif /* ifndef RedMemCpyUnchecked */
 
@@ -158,22 +166,35 @@ void RedMemMove( void * pDest,
         {
             /*  If the destination is lower than the source with overlapping memory
              *  regions, we must copy from start to end in order to copy the memory
-             *  correctly.
+             *  correctly.  Each word is read before any part of it is written, so
+             *  copying by words is as safe as copying by bytes.
              *
              *  Don't use RedMemCpy() to do this.  It is possible that RedMemCpy()
              *  has been replaced (even though this function has not been replaced)
              *  with an implementation that cannot handle any kind of buffer
              *  overlap.
              */
-            for( ulIdx = 0U; ulIdx < ulLen; ulIdx++ )
-            {
-                pbDest[ ulIdx ] = pbSrc[ ulIdx ];
-            }
+            MemCopyForward( pbDest, pbSrc, ulLen );
         }
         else
         {
             ulIdx = ulLen;
 
+            if( PTR_WORD_OFFSET( pbDest ) == PTR_WORD_OFFSET( pbSrc ) )
+            {
+                while( ( ulIdx > 0U ) && ( PTR_WORD_OFFSET( &pbDest[ ulIdx ] ) != 0U ) )
+                {
+                    ulIdx--;
+                    pbDest[ ulIdx ] = pbSrc[ ulIdx ];
+                }
+
+                while( ulIdx >= WORD_SIZE )
+                {
+                    ulIdx -= WORD_SIZE;
+                    *CAST_MEMWORD_PTR( &pbDest[ ulIdx ] ) = *CAST_CONST_MEMWORD_PTR( &pbSrc[ ulIdx ] );
+                }
+            }
+
             while( ulIdx > 0U )
             {
                 ulIdx--;
@@ -220,11 +241,31 @@ void RedMemSet( void * pDest,
                                     uint32_t ulLen )
     {
         uint8_t * pbDest = CAST_VOID_PTR_TO_UINT8_PTR( pDest );
-        uint32_t ulIdx;
+        uint32_t ulIdx = 0U;
+        uint32_t ulWordEnd;
+
+        /*  Every byte of the word is bVal.
+         */
+        REDMEMWORD ulPattern = ( REDMEMWORD ) ( ( ~( uintptr_t ) 0U / 0xFFU ) * bVal );
+
+        while( ( ulIdx < ulLen ) && ( PTR_WORD_OFFSET( &pbDest[ ulIdx ] ) != 0U ) )
+        {
+            pbDest[ ulIdx ] = bVal;
+            ulIdx++;
+        }
+
+        ulWordEnd = ulIdx + ( ( ulLen - ulIdx ) & ~( WORD_SIZE - 1U ) );
+
+        while( ulIdx < ulWordEnd )
+        {
+            *CAST_MEMWORD_PTR( &pbDest[ ulIdx ] ) = ulPattern;
+            ulIdx += WORD_SIZE;
+        }
 
-        for( ulIdx = 0U; ulIdx < ulLen; ulIdx++ )
+        while( ulIdx < ulLen )
         {
             pbDest[ ulIdx ] = bVal;
+            ulIdx++;
         }
     }
 #endif /* ifndef RedMemSetUnchecked */
@@ -283,6 +324,26 @@ int32_t RedMemCmp( const void * pMem1,
         uint32_t ulIdx = 0U;
         int32_t lResult;
 
+        if( PTR_WORD_OFFSET( pbMem1 ) == PTR_WORD_OFFSET( pbMem2 ) )
+        {
+            while( ( ulIdx < ulLen ) && ( PTR_WORD_OFFSET( &pbMem1[ ulIdx ] ) != 0U ) && ( pbMem1[ ulIdx ] == pbMem2[ ulIdx ] ) )
+            {
+                ulIdx++;
+            }
+
+            /*  Skip over equal words.  The byte loop below finds the first
+             *  difference within the word which differs, if any.
+             */
+            if( PTR_WORD_OFFSET( &pbMem1[ ulIdx ] ) == 0U )
+            {
+                while( ( ( ulLen - ulIdx ) >= WORD_SIZE ) &&
+                       ( *CAST_CONST_MEMWORD_PTR( &pbMem1[ ulIdx ] ) == *CAST_CONST_MEMWORD_PTR( &pbMem2[ ulIdx ] ) ) )
+                {
+                    ulIdx += WORD_SIZE;
+                }
+            }
+        }
+
         while( ( ulIdx < ulLen ) && ( pbMem1[ ulIdx ] == pbMem2[ ulIdx ] ) )
         {
             ulIdx++;
@@ -304,3 +365,50 @@ int32_t RedMemCmp( const void * pMem1,
         return lResult;
     }
 #endif /* ifndef RedMemCmpUnchecked */
+
+
+#if !defined( RedMemCpyUnchecked ) || !defined( RedMemMoveUnchecked )
+
+/** @brief Copy memory from start to end.
+ *
+ *  Safe for overlapping buffers only if @p pbDest is lower than @p pbSrc.
+ *
+ *  @param pbDest   The destination buffer.
+ *  @param pbSrc    The source buffer.
+ *  @param ulLen    The number of bytes to copy.
+ */
+    static void MemCopyForward( uint8_t * pbDest,
+                                const uint8_t * pbSrc,
+                                uint32_t ulLen )
+    {
+        uint32_t ulIdx = 0U;
+
+        /*  Words can only be copied if the buffers are equally far from a word
+         *  boundary: copy bytes until both are on one.
+         */
+        if( PTR_WORD_OFFSET( pbDest ) == PTR_WORD_OFFSET( pbSrc ) )
+        {
+            uint32_t ulWordEnd;
+
+            while( ( ulIdx < ulLen ) && ( PTR_WORD_OFFSET( &pbDest[ ulIdx ] ) != 0U ) )
+            {
+                pbDest[ ulIdx ] = pbSrc[ ulIdx ];
+                ulIdx++;
+            }
+
+            ulWordEnd = ulIdx + ( ( ulLen - ulIdx ) & ~( WORD_SIZE - 1U ) );
+
+            while( ulIdx < ulWordEnd )
+            {
+                *CAST_MEMWORD_PTR( &pbDest[ ulIdx ] ) = *CAST_CONST_MEMWORD_PTR( &pbSrc[ ulIdx ] );
+                ulIdx += WORD_SIZE;
+            }
+        }
+
+        while( ulIdx < ulLen )
+        {
+            pbDest[ ulIdx ] = pbSrc[ ulIdx ];
+            ulIdx++;
+        }
+    }
+#endif /* if !defined( RedMemCpyUnchecked ) || !defined( RedMemMoveUnchecked ) */
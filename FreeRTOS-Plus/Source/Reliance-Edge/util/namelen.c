@@ -25,7 +25,7 @@
  */
 
 /** @file
- *  @brief Implements a utility to find the length of a name.
+ *  @brief Implements utilities to find the length and the hash of a name.
  */
 #include <redfs.h>
 
@@ -58,4 +58,36 @@
         return ulIdx;
     }
 
+
+/** @brief Compute the hash of a name, using the FNV-1a algorithm.
+ *
+ *  @param pszName      The name to hash, terminated either by a null or by its
+ *                      length.
+ *  @param ulNameLen    The maximum length of @p pszName.
+ *
+ *  @return The hash of the name.
+ */
+    uint32_t RedNameHash( const char * pszName,
+                          uint32_t ulNameLen )
+    {
+        uint32_t ulHash = 2166136261U;
+
+        if( pszName == NULL )
+        {
+            REDERROR();
+        }
+        else
+        {
+            uint32_t ulIdx;
+
+            for( ulIdx = 0U; ( ulIdx < ulNameLen ) && ( pszName[ ulIdx ] != '\0' ); ulIdx++ )
+            {
+                ulHash ^= ( uint8_t ) pszName[ ulIdx ];
+                ulHash *= 16777619U;
+            }
+        }
+
+        return ulHash;
+    }
+
 #endif /* if REDCONF_API_POSIX == 1 */